@@ -18,6 +18,8 @@ namespace osc::mow
         InMemoryMesh() = default;
         explicit InMemoryMesh(const Mesh& mesh_) : m_OscMesh{mesh_} {}
 
+        const Mesh& getMesh() const { return m_OscMesh; }
+
         void implementCreateDecorativeGeometry(SimTK::Array_<SimTK::DecorativeGeometry>&) const override
         {
             // do nothing: OpenSim Creator will detect `ICustomDecorationDecorator` and use that
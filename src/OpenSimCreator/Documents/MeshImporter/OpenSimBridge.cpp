@@ -559,7 +559,7 @@ namespace
             osc::Mesh meshData;
             try
             {
-                meshData = LoadMeshViaSimTK(realLocation.string());
+                meshData = LoadMeshFile(realLocation);
             }
             catch (const std::exception& ex)
             {
@@ -204,7 +204,7 @@ void osc::ActionLoadMeshFile(
         return;  // user didn't select anything
     }
 
-    ActionLoadMesh(doc, LoadMeshViaSimTK(*maybeMeshPath), which);
+    ActionLoadMesh(doc, LoadMeshFile(*maybeMeshPath), which);
 }
 
 void osc::ActionLoadLandmarksFromCSV(
@@ -7,6 +7,7 @@
 #include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulation.h>
 #include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
 #include <OpenSimCreator/Documents/Simulation/Simulation.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationCheckpoint.h>
 #include <OpenSimCreator/Documents/Simulation/StoFileSimulation.h>
 #include <OpenSimCreator/Graphics/OpenSimDecorationGenerator.h>
 #include <OpenSimCreator/Graphics/OpenSimDecorationOptions.h>
@@ -63,9 +64,11 @@
 #include <algorithm>
 #include <chrono>
 #include <exception>
+#include <fstream>
 #include <memory>
 #include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <typeinfo>
@@ -443,6 +446,39 @@ bool osc::ActionStartSimulatingModel(
     return true;
 }
 
+bool osc::ActionResumeSimulationFromCheckpoint(
+    const ParentPtr<IMainUIStateAPI>& parent,
+    const UndoableModelStatePair& uim,
+    const std::filesystem::path& checkpointPath)
+{
+    try
+    {
+        std::ifstream fin{checkpointPath};
+        if (not fin) {
+            throw std::runtime_error{"cannot open the checkpoint file for reading"};
+        }
+        const SimulationCheckpoint checkpoint = ReadSimulationCheckpoint(fin);
+
+        OpenSim::Model model{uim.getModel()};
+        InitializeModel(model);
+        SimTK::State& state = InitializeState(model);
+        ApplySimulationCheckpoint(checkpoint, model, state);
+
+        BasicModelStatePair modelState{model, state};
+        modelState.setFixupScaleFactor(uim.getFixupScaleFactor());
+
+        auto simulation = std::make_shared<Simulation>(ForwardDynamicSimulation{std::move(modelState), checkpoint.params});
+        parent->add_and_select_tab<SimulationTab>(parent, std::move(simulation));
+
+        return true;
+    }
+    catch (const std::exception& ex)
+    {
+        log_error("%s: error detected while trying to resume a simulation from a checkpoint: %s", checkpointPath.string().c_str(), ex.what());
+        return false;
+    }
+}
+
 bool osc::ActionUpdateModelFromBackingFile(UndoableModelStatePair& uim)
 {
     if (!uim.hasFilesystemLocation())
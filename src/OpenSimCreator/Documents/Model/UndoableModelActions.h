@@ -108,6 +108,14 @@ namespace osc
         const UndoableModelStatePair&
     );
 
+    // resumes a forward-dynamic simulation of the current model from a checkpoint file (as
+    // written by `WriteSimulationCheckpoint`) and opens it in a new tab
+    bool ActionResumeSimulationFromCheckpoint(
+        const ParentPtr<IMainUIStateAPI>&,
+        const UndoableModelStatePair&,
+        const std::filesystem::path& checkpointPath
+    );
+
     // reload the given model from its backing file (if applicable)
     bool ActionUpdateModelFromBackingFile(
         UndoableModelStatePair&
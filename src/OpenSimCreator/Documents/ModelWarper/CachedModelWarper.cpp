@@ -3,10 +3,14 @@
 #include <OpenSimCreator/Graphics/OpenSimDecorationGenerator.h>
 #include <OpenSimCreator/Utils/OpenSimHelpers.h>
 
+#include <OpenSim/Simulation/Model/Frame.h>
 #include <OpenSim/Simulation/Model/Geometry.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/PathPoint.h>
+#include <OpenSim/Simulation/Model/Station.h>
 #include <OpenSimCreator/Documents/CustomComponents/InMemoryMesh.h>
 #include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/ModelWarper/IPointWarper.h>
 #include <OpenSimCreator/Documents/ModelWarper/IPointWarperFactory.h>
 #include <OpenSimCreator/Documents/ModelWarper/WarpableModel.h>
 #include <oscar/Formats/OBJ.h>
@@ -14,76 +18,139 @@
 #include <oscar/Utils/Assertions.h>
 #include <oscar_simbody/SimTKHelpers.h>
 
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace osc;
 using namespace osc::mow;
 
 namespace
 {
-    std::unique_ptr<OpenSim::Geometry> WarpMesh(
+    // returns `true` if both meshes contain the same vertex+index data (e.g. because they
+    // were loaded from the same mesh file)
+    bool HasSameVerticesAndIndices(const Mesh& a, const Mesh& b)
+    {
+        return
+            a == b ||
+            (a.topology() == b.topology() && a.vertices() == b.vertices() && std::ranges::equal(a.indices(), b.indices()));
+    }
+
+    // a compiled `IPointWarper`, plus the inputs that it was compiled from
+    struct CompiledPointWarper final {
+        std::unique_ptr<IPointWarperFactory> factory;  // (a clone, so that it outlives the document)
+        float blendingFactor;
+        double maxAbsoluteWarpError;
+        std::shared_ptr<const IPointWarper> pointWarper;
+    };
+
+    // a warped mesh, plus the inputs that it was warped from
+    struct WarpedMesh final {
+        Mesh sourceMesh;
+        std::shared_ptr<const IPointWarper> pointWarper;
+        Mesh warpedMesh;
+        std::optional<std::filesystem::path> writtenTo;  // where `warpedMesh` was last written, if it was
+    };
+
+    // a warped point (e.g. an `OpenSim::PathPoint`), plus the inputs that it was warped from
+    struct WarpedPoint final {
+        std::shared_ptr<const IPointWarper> pointWarper;
+        SimTK::Vec3 sourceLocation;        // in the point's parent frame
+        Vec3 sourceLocationInMeshFrame;
+        SimTK::Vec3 warpedLocation;
+    };
+
+    // a geometry in the warped model that should be replaced by a warped geometry
+    struct GeometryReplacement final {
+        const OpenSim::Geometry* oldGeometry;
+        std::unique_ptr<OpenSim::Geometry> newGeometry;
+    };
+
+    // writes the warped mesh to disk in an appropriate mesh file format (if it wasn't
+    // already written there) and returns its absolute path
+    std::filesystem::path WriteWarpedMesh(
         const WarpableModel& document,
-        const OpenSim::Model& model,
-        const SimTK::State& state,
         const OpenSim::Mesh& inputMesh,
-        const IPointWarperFactory& warper)
+        WarpedMesh& warpedMesh)
     {
-        // TODO: this ignores scale factors
-        Mesh mesh = ToOscMesh(model, state, inputMesh);
-        auto vertices = mesh.vertices();
-        auto compiled = warper.tryCreatePointWarper(document);
-        compiled->warpInPlace(vertices);
-        mesh.set_vertices(vertices);
-        mesh.recalculate_normals();
+        // figure out and prepare where the mesh data should be written
+        const auto warpedMeshesDir = document.getWarpedMeshesOutputDirectory();
+        OSC_ASSERT(warpedMeshesDir && "cannot figure out where to write warped mesh data: this will only work if the osim file was loaded from disk");
+        const auto meshLocationAbsPath = std::filesystem::weakly_canonical(*warpedMeshesDir / GetMeshFileName(inputMesh));
+        if (warpedMesh.writtenTo == meshLocationAbsPath && std::filesystem::exists(meshLocationAbsPath)) {
+            return meshLocationAbsPath;  // the (unchanged) warped mesh was already written there
+        }
+        std::filesystem::create_directories(meshLocationAbsPath.parent_path());  // ensure parent directories are created
 
-        if (document.getShouldWriteWarpedMeshesToDisk()) {
-            // the mesh should be written to disk in an appropriate mesh file format
-            // and the resulting warped `OpenSim::Model` should link to the on-disk
-            // data via an `OpenSim::Mesh`
-
-            // figure out and prepare where the mesh data should be written
-            const auto warpedMeshesDir = document.getWarpedMeshesOutputDirectory();
-            OSC_ASSERT(warpedMeshesDir && "cannot figure out where to write warped mesh data: this will only work if the osim file was loaded from disk");
-            const auto meshLocationAbsPath = std::filesystem::weakly_canonical(*warpedMeshesDir / GetMeshFileName(inputMesh));
-            std::filesystem::create_directories(meshLocationAbsPath.parent_path());  // ensure parent directories are created
-
-            // write mesh data to disk as a Wavefront OBJ file
-            {
-                std::ofstream objStream{meshLocationAbsPath, std::ios::trunc};
-                objStream.exceptions(std::ios::badbit | std::ios::failbit);
-                write_as_obj(objStream, mesh, ObjMetadata{"osc-model-warper"});
-            }
+        // write mesh data to disk as a Wavefront OBJ file
+        {
+            std::ofstream objStream{meshLocationAbsPath, std::ios::trunc};
+            objStream.exceptions(std::ios::badbit | std::ios::failbit);
+            write_as_obj(objStream, warpedMesh.warpedMesh, ObjMetadata{"osc-model-warper"});
+        }
+        warpedMesh.writtenTo = meshLocationAbsPath;
 
-            // return an `OpenSim::Mesh` thank refers to the OBJ file
+        return meshLocationAbsPath;
+    }
+
+    std::unique_ptr<OpenSim::Geometry> CreateWarpedGeometry(
+        const WarpableModel& document,
+        const OpenSim::Mesh& inputMesh,
+        WarpedMesh& warpedMesh)
+    {
+        if (document.getShouldWriteWarpedMeshesToDisk()) {
+            // the mesh should be written to disk and the resulting warped `OpenSim::Model`
+            // should link to the on-disk data via an `OpenSim::Mesh`
             auto rv = std::make_unique<OpenSim::Mesh>();
-            rv->set_mesh_file(meshLocationAbsPath.string());  // TODO: should be relative-ized, where reasonable
+            rv->set_mesh_file(WriteWarpedMesh(document, inputMesh, warpedMesh).string());  // TODO: should be relative-ized, where reasonable
             return rv;
         }
         else {
-            return std::make_unique<InMemoryMesh>(mesh);
+            return std::make_unique<InMemoryMesh>(warpedMesh.warpedMesh);
         }
     }
 
-    void OverwriteGeometry(
-        OpenSim::Model& model,
-        OpenSim::Geometry& oldGeometry,
-        std::unique_ptr<OpenSim::Geometry> newGeometry)
+    // overwrites geometry that's attached to the given frame with their replacements
+    //
+    // this only edits the frame's `attached_geometry` property, so that all geometry in the
+    // model can be overwritten before the model is (re)initialized once, rather than once
+    // per overwritten geometry
+    void OverwriteAttachedGeometry(
+        OpenSim::Frame& frame,
+        std::span<const GeometryReplacement> replacements)
     {
-        newGeometry->set_scale_factors(oldGeometry.get_scale_factors());
-        newGeometry->set_Appearance(oldGeometry.get_Appearance());
-        newGeometry->connectSocket_frame(oldGeometry.getConnectee("frame"));
-        newGeometry->setName(oldGeometry.getName());
-        OpenSim::Component* owner = UpdOwner(model, oldGeometry);
-        OSC_ASSERT_ALWAYS(owner && "the mesh being replaced has no owner? cannot overwrite a root component");
-        OSC_ASSERT_ALWAYS(TryDeleteComponentFromModel(model, oldGeometry) && "cannot delete old mesh from model during warping");
-        InitializeModel(model);
-        InitializeState(model);
-        owner->addComponent(newGeometry.release());
-        FinalizeConnections(model);
+        auto& prop = dynamic_cast<OpenSim::ObjectProperty<OpenSim::Geometry>&>(frame.updProperty_attached_geometry());
+        auto copy = Clone(prop);
+        copy->clear();
+
+        for (int i = 0; i < prop.size(); ++i) {
+            const OpenSim::Geometry& oldGeometry = prop[i];
+            const auto it = std::ranges::find(replacements, &oldGeometry, &GeometryReplacement::oldGeometry);
+            if (it == replacements.end()) {
+                Append(*copy, oldGeometry);
+                continue;
+            }
+
+            // (the replacement has the same name and owner, so the old (relative) socket path is still valid)
+            OpenSim::Geometry& newGeometry = *it->newGeometry;
+            newGeometry.set_scale_factors(oldGeometry.get_scale_factors());
+            newGeometry.set_Appearance(oldGeometry.get_Appearance());
+            newGeometry.updSocket("frame").setConnecteePath(oldGeometry.getSocket("frame").getConnecteePath());
+            newGeometry.setName(oldGeometry.getName());
+            Append(*copy, newGeometry);
+        }
+
+        prop.assign(*copy);
     }
 }
 
@@ -100,108 +167,236 @@ public:
 
     std::shared_ptr<const IConstModelStatePair> createWarpedModel(const WarpableModel& document)
     {
+        // the source model's meshes only have to be (re)read if the document's model
+        // changed (e.g. editing the document's warp configuration doesn't change it)
+        const bool sourceModelChanged = !m_PreviousDocument || &m_PreviousDocument->modelstate() != &document.modelstate();
+
+        // start a new generation of caches, which retains entries from the previous generation
+        // only if they're used by this warp
+        auto previousPointWarpers = std::exchange(m_PointWarpers, {});
+        auto previousWarpedMeshes = std::exchange(m_WarpedMeshes, {});
+        auto previousWarpedPoints = std::exchange(m_WarpedPoints, {});
+
         // copy the model into an editable "warped" version
+        //
+        // (it's only finalized, so that its components can be found: the system is only
+        // built once, after everything is warped)
         OpenSim::Model warpedModel{document.model()};
-        InitializeModel(warpedModel);
-        InitializeState(warpedModel);
+        FinalizeFromProperties(warpedModel);
 
         // iterate over each mesh in the model and warp it in-memory
         //
         // additionally, collect a base-frame-to-mesh lookup while doing this
-        std::map<OpenSim::ComponentPath, std::vector<OpenSim::ComponentPath>> baseFrame2meshes;
+        std::map<OpenSim::ComponentPath, std::vector<const OpenSim::Mesh*>> baseFrame2meshes;
+        std::map<OpenSim::Frame*, std::vector<GeometryReplacement>> frame2replacements;
         for (const auto& mesh : document.model().getComponentList<OpenSim::Mesh>()) {
-            // try to warp+overwrite
-            if (const auto* meshWarper = document.findMeshWarp(mesh)) {
-                auto warpedMesh = WarpMesh(document, document.model(), document.modelstate().getState(), mesh, *meshWarper);
-                auto* targetMesh = FindComponentMut<OpenSim::Mesh>(warpedModel, mesh.getAbsolutePath());
-                OSC_ASSERT_ALWAYS(targetMesh && "cannot find target mesh in output model: this should never happen");
-                OverwriteGeometry(warpedModel, *targetMesh, std::move(warpedMesh));
-            }
-            else {
+            // try to warp
+            const IPointWarperFactory* meshWarper = document.findMeshWarp(mesh);
+            if (!meshWarper) {
                 return nullptr;  // no warper for the mesh (not even an identity warp): halt
             }
+            auto pointWarper = getPointWarper(document, *meshWarper, previousPointWarpers);
+            if (!pointWarper) {
+                return nullptr;  // the warper cannot currently warp anything: halt
+            }
+            WarpedMesh& warpedMesh = getWarpedMesh(document, mesh, std::move(pointWarper), sourceModelChanged, previousWarpedMeshes);
+
+            // find where the warped mesh should go in the warped model (the geometry is
+            // overwritten after all meshes are warped, because overwriting it invalidates
+            // pointers into the warped model)
+            auto* targetMesh = FindComponentMut<OpenSim::Mesh>(warpedModel, mesh.getAbsolutePath());
+            OSC_ASSERT_ALWAYS(targetMesh && "cannot find target mesh in output model: this should never happen");
+            auto* owner = dynamic_cast<OpenSim::Frame*>(UpdOwner(warpedModel, *targetMesh));
+            OSC_ASSERT_ALWAYS(owner && "the mesh being replaced isn't attached to a frame: cannot overwrite it");
+            frame2replacements[owner].push_back({targetMesh, CreateWarpedGeometry(document, mesh, warpedMesh)});
 
             // update base-frame-to-mesh lookup
             const auto& [it, inserted] = baseFrame2meshes.try_emplace(mesh.getFrame().findBaseFrame().getAbsolutePath());
-            it->second.push_back(mesh.getAbsolutePath());
+            it->second.push_back(&mesh);
         }
-        InitializeModel(warpedModel);
-        InitializeState(warpedModel);
 
         // iterate over each `PathPoint` in the model (incl. muscle points) and warp them by
         // figuring out how each relates to a mesh in the model
         //
         // TODO: the `osc::mow::WarpableModel` should handle figuring out each point's warper, because
         // there are situations where there isn't a 1:1 relationship between meshes and bodies
-        for (auto& pp : warpedModel.updComponentList<OpenSim::PathPoint>()) {
-            auto baseFramePath = pp.getParentFrame().findBaseFrame().getAbsolutePath();
+        warpPoints<OpenSim::PathPoint>(document, baseFrame2meshes, previousPointWarpers, previousWarpedPoints, warpedModel);
+        warpPoints<OpenSim::Station>(document, baseFrame2meshes, previousPointWarpers, previousWarpedPoints, warpedModel);
+
+        // overwrite the geometry and then (re)initialize the warped model once
+        for (const auto& [frame, replacements] : frame2replacements) {
+            OverwriteAttachedGeometry(*frame, replacements);
+        }
+        InitializeModel(warpedModel);
+        InitializeState(warpedModel);
+
+        return std::make_shared<BasicModelStatePair>(
+            warpedModel.getModel(),
+            warpedModel.getWorkingState()
+        );
+    }
+private:
+    // returns a compiled `IPointWarper` for the given factory, which is shared by all meshes+points
+    // that use an equivalent factory (and is reused between warps, if it's still valid)
+    std::shared_ptr<const IPointWarper> getPointWarper(
+        const WarpableModel& document,
+        const IPointWarperFactory& factory,
+        std::vector<CompiledPointWarper>& previousPointWarpers)
+    {
+        const auto isCompiledFrom = [&document, &factory](const CompiledPointWarper& compiled)
+        {
+            return
+                compiled.blendingFactor == document.getWarpBlendingFactor() &&
+                compiled.maxAbsoluteWarpError == document.getMaxAbsoluteWarpError() &&
+                compiled.factory->isEquivalentTo(factory);
+        };
+
+        if (const auto it = std::ranges::find_if(m_PointWarpers, isCompiledFrom); it != m_PointWarpers.end()) {
+            return it->pointWarper;
+        }
+        if (const auto it = std::ranges::find_if(previousPointWarpers, isCompiledFrom); it != previousPointWarpers.end()) {
+            m_PointWarpers.push_back(std::move(*it));
+            previousPointWarpers.erase(it);
+            return m_PointWarpers.back().pointWarper;
+        }
+
+        std::shared_ptr<const IPointWarper> pointWarper = factory.tryCreatePointWarper(document);
+        if (pointWarper) {
+            m_PointWarpers.push_back({factory.clone(), document.getWarpBlendingFactor(), document.getMaxAbsoluteWarpError(), pointWarper});
+        }
+        return pointWarper;
+    }
+
+    // returns the warped version of the given mesh, which is only (re)warped if its source
+    // mesh data, or its warper, changed since the previous warp
+    WarpedMesh& getWarpedMesh(
+        const WarpableModel& document,
+        const OpenSim::Mesh& mesh,
+        std::shared_ptr<const IPointWarper> pointWarper,
+        bool sourceModelChanged,
+        std::unordered_map<std::string, WarpedMesh>& previousWarpedMeshes)
+    {
+        const std::string meshPath = GetAbsolutePathString(mesh);
+        auto previous = previousWarpedMeshes.extract(meshPath);
+
+        // (re)load the source mesh data, but retain the previous data if it's unchanged, so that
+        // the previous warp's results can be reused
+        //
+        // TODO: this ignores scale factors
+        std::optional<Mesh> sourceMesh;
+        if (previous && !sourceModelChanged) {
+            sourceMesh = previous.mapped().sourceMesh;
+        }
+        else {
+            sourceMesh = ToOscMesh(document.model(), document.modelstate().getState(), mesh);
+            if (previous && HasSameVerticesAndIndices(*sourceMesh, previous.mapped().sourceMesh)) {
+                sourceMesh = previous.mapped().sourceMesh;
+            }
+        }
+
+        if (previous && previous.mapped().sourceMesh == *sourceMesh && previous.mapped().pointWarper == pointWarper) {
+            return m_WarpedMeshes.insert(std::move(previous)).position->second;
+        }
+
+        Mesh warpedMesh = *sourceMesh;
+        auto vertices = warpedMesh.vertices();
+        pointWarper->warpInPlace(vertices);
+        warpedMesh.set_vertices(vertices);
+        warpedMesh.recalculate_normals();
+
+        return m_WarpedMeshes.insert_or_assign(meshPath, WarpedMesh{*sourceMesh, std::move(pointWarper), std::move(warpedMesh), std::nullopt}).first->second;
+    }
+
+    // warps the location of each `Point` (e.g. `OpenSim::PathPoint`) in the model by warping
+    // it with its base frame's mesh's warper
+    //
+    // all points that share a base frame are warped as one batch, and points are only (re)warped
+    // if their location, or their warper, changed since the previous warp
+    template<std::derived_from<OpenSim::Component> Point>
+    void warpPoints(
+        const WarpableModel& document,
+        const std::map<OpenSim::ComponentPath, std::vector<const OpenSim::Mesh*>>& baseFrame2meshes,
+        std::vector<CompiledPointWarper>& previousPointWarpers,
+        std::unordered_map<std::string, WarpedPoint>& previousWarpedPoints,
+        OpenSim::Model& warpedModel)
+    {
+        const SimTK::State& state = document.modelstate().getState();
+
+        // group the points by the mesh that they should follow
+        std::map<OpenSim::ComponentPath, std::vector<const Point*>> baseFrame2points;
+        for (const Point& point : document.model().getComponentList<Point>()) {
+            auto baseFramePath = point.getParentFrame().findBaseFrame().getAbsolutePath();
             if (auto it = baseFrame2meshes.find(baseFramePath); it != baseFrame2meshes.end()) {
                 if (it->second.size() == 1) {
-                    if (const auto* mesh = FindComponent<OpenSim::Mesh>(document.model(), it->second.front())) {
-                        if (const auto meshWarper = document.findMeshWarp(*mesh)) {
-                            // redefine the station's position in the mesh's coordinate system
-                            auto posInMeshFrame = pp.getParentFrame().expressVectorInAnotherFrame(warpedModel.getWorkingState(), pp.get_location(), mesh->getFrame());
-                            auto warpedInMeshFrame = to<SimTK::Vec3>(meshWarper->tryCreatePointWarper(document)->warp(to<Vec3>(posInMeshFrame)));
-                            auto warpedInParentFrame = mesh->getFrame().expressVectorInAnotherFrame(warpedModel.getWorkingState(), warpedInMeshFrame, pp.getParentFrame());
-                            pp.set_location(warpedInParentFrame);
-                        }
-                        else {
-                            log_warn("no warper available for %s", it->second.front().toString().c_str());
-                        }
-                    }
-                    else {
-                        log_error("cannot find %s in the model: this shouldn't happen", it->second.front().toString().c_str());
-                    }
+                    baseFrame2points[std::move(baseFramePath)].push_back(&point);
                 }
                 else {
-                    log_warn("cannot warp %s: there are multiple meshes attached to the same base frame, so it's ambiguous how to warp this point", pp.getName().c_str());
+                    log_warn("cannot warp %s: there are multiple meshes attached to the same base frame, so it's ambiguous how to warp this point", point.getName().c_str());
                 }
             }
             else {
-                log_warn("cannot warp %s: there don't appear to be any meshes attached to the same base frame?", pp.getName().c_str());
+                log_warn("cannot warp %s: there don't appear to be any meshes attached to the same base frame?", point.getName().c_str());
             }
         }
 
-        for (auto& station : warpedModel.updComponentList<OpenSim::Station>()) {
-            auto baseFramePath = station.getParentFrame().findBaseFrame().getAbsolutePath();
-            if (auto it = baseFrame2meshes.find(baseFramePath); it != baseFrame2meshes.end()) {
-                if (it->second.size() == 1) {
-                    if (const auto* mesh = FindComponent<OpenSim::Mesh>(document.model(), it->second.front())) {
-                        if (const auto meshWarper = document.findMeshWarp(*mesh)) {
-                            // redefine the station's position in the mesh's coordinate system
-                            auto posInMeshFrame = station.getParentFrame().expressVectorInAnotherFrame(warpedModel.getWorkingState(), station.get_location(), mesh->getFrame());
-                            auto warpedInMeshFrame = to<SimTK::Vec3>(meshWarper->tryCreatePointWarper(document)->warp(to<Vec3>(posInMeshFrame)));
-                            auto warpedInParentFrame = mesh->getFrame().expressVectorInAnotherFrame(warpedModel.getWorkingState(), warpedInMeshFrame, station.getParentFrame());
-                            station.set_location(warpedInParentFrame);
-                        }
-                        else {
-                            log_warn("no warper available for %s", it->second.front().toString().c_str());
-                        }
-                    }
-                    else {
-                        log_error("cannot find %s in the model: this shouldn't happen", it->second.front().toString().c_str());
-                    }
+        for (const auto& [baseFramePath, points] : baseFrame2points) {
+            const OpenSim::Mesh& mesh = *baseFrame2meshes.at(baseFramePath).front();
+            const IPointWarperFactory* meshWarper = document.findMeshWarp(mesh);
+            auto pointWarper = meshWarper ? getPointWarper(document, *meshWarper, previousPointWarpers) : nullptr;
+            if (!pointWarper) {
+                log_warn("no warper available for %s", GetAbsolutePathString(mesh).c_str());
+                continue;
+            }
+
+            // redefine each (changed) point's position in the mesh's coordinate system
+            //
+            // (the previous warp's result is reused if the point is still at the same location,
+            // even if the source model was reloaded)
+            std::vector<const Point*> changedPoints;
+            std::vector<Vec3> changedSourceLocations;
+            for (const Point* point : points) {
+                const Vec3 locationInMeshFrame = to<Vec3>(point->getParentFrame().expressVectorInAnotherFrame(state, point->get_location(), mesh.getFrame()));
+                auto previous = previousWarpedPoints.extract(GetAbsolutePathString(*point));
+                if (previous &&
+                    previous.mapped().pointWarper == pointWarper &&
+                    previous.mapped().sourceLocation == point->get_location() &&
+                    previous.mapped().sourceLocationInMeshFrame == locationInMeshFrame) {
+
+                    m_WarpedPoints.insert(std::move(previous));
                 }
                 else {
-                    log_warn("cannot warp %s: there are multiple meshes attached to the same base frame, so it's ambiguous how to warp this point", station.getName().c_str());
+                    changedPoints.push_back(point);
+                    changedSourceLocations.push_back(locationInMeshFrame);
                 }
             }
-            else {
-                log_warn("cannot warp %s: there don't appear to be any meshes attached to the same base frame?", station.getName().c_str());
-            }
-        }
 
-        InitializeModel(warpedModel);
-        InitializeState(warpedModel);
+            // warp all (changed) points that share the same warper in one batch
+            std::vector<Vec3> changedLocations = changedSourceLocations;
+            pointWarper->warpInPlace(changedLocations);
+            for (size_t i = 0; i < changedPoints.size(); ++i) {
+                const auto warpedInParentFrame = mesh.getFrame().expressVectorInAnotherFrame(state, to<SimTK::Vec3>(changedLocations[i]), changedPoints[i]->getParentFrame());
+                m_WarpedPoints.insert_or_assign(
+                    GetAbsolutePathString(*changedPoints[i]),
+                    WarpedPoint{pointWarper, changedPoints[i]->get_location(), changedSourceLocations[i], warpedInParentFrame}
+                );
+            }
 
-        return std::make_shared<BasicModelStatePair>(
-            warpedModel.getModel(),
-            warpedModel.getWorkingState()
-        );
+            // write the warped locations into the warped model
+            for (const Point* point : points) {
+                auto* target = FindComponentMut<Point>(warpedModel, point->getAbsolutePath());
+                OSC_ASSERT_ALWAYS(target && "cannot find target point in output model: this should never happen");
+                target->set_location(m_WarpedPoints.at(GetAbsolutePathString(*point)).warpedLocation);
+            }
+        }
     }
-private:
+
     std::optional<WarpableModel> m_PreviousDocument;
     std::shared_ptr<const IConstModelStatePair> m_PreviousResult;
+
+    // caches that are reused between warps
+    std::vector<CompiledPointWarper> m_PointWarpers;
+    std::unordered_map<std::string, WarpedMesh> m_WarpedMeshes;
+    std::unordered_map<std::string, WarpedPoint> m_WarpedPoints;
 };
 
 osc::mow::CachedModelWarper::CachedModelWarper() :
@@ -29,7 +29,16 @@ namespace osc::mow
         virtual ~IPointWarperFactory() = default;
 
         std::unique_ptr<IPointWarper> tryCreatePointWarper(const WarpableModel& document) const { return implTryCreatePointWarper(document); }
+
+        // returns `true` if `other` creates `IPointWarper`s that warp points identically to the
+        // ones that this factory creates, given the same document (e.g. so that callers can reuse
+        // previously-warped data)
+        //
+        // care: callers compare against clones (e.g. of a previous document's factories), so
+        //       implementations should compare the factories' inputs, rather than their addresses
+        bool isEquivalentTo(const IPointWarperFactory& other) const { return implIsEquivalentTo(other); }
     private:
         virtual std::unique_ptr<IPointWarper> implTryCreatePointWarper(const WarpableModel&) const = 0;
+        virtual bool implIsEquivalentTo(const IPointWarperFactory& other) const = 0;
     };
 }
@@ -17,6 +17,9 @@ osc::mow::ModelWarpConfiguration::ModelWarpConfiguration(
             if (auto defaultWarps = globals->get_as<bool>("should_default_missing_frame_warps_to_identity")) {
                 m_ShouldDefaultMissingFrameWarpsToIdentity = defaultWarps->value_or(false);
             }
+            if (auto maxAbsoluteWarpError = globals->get_as<double>("max_absolute_warp_error")) {
+                setMaxAbsoluteWarpError(maxAbsoluteWarpError->value_or(0.0));
+            }
         }
     }
 }
@@ -2,6 +2,7 @@
 
 #include <oscar/Maths/CommonFunctions.h>
 
+#include <algorithm>
 #include <filesystem>
 
 namespace OpenSim { class Model; }
@@ -25,6 +26,12 @@ namespace osc::mow
         bool getShouldDefaultMissingFrameWarpsToIdentity() const { return m_ShouldDefaultMissingFrameWarpsToIdentity; }
         void setShouldDefaultMissingFrameWarpsToIdentity(bool v) { m_ShouldDefaultMissingFrameWarpsToIdentity = v; }
 
+        // the maximum absolute error (per component of each point) that point warpers may trade for
+        // speed (e.g. TPS warpers approximately evaluate warps with many landmarks), where zero means
+        // that points are warped exactly
+        double getMaxAbsoluteWarpError() const { return m_MaxAbsoluteWarpError; }
+        void setMaxAbsoluteWarpError(double v) { m_MaxAbsoluteWarpError = std::max(v, 0.0); }
+
         bool getShouldWriteWarpedMeshesToDisk() const { return m_ShouldWriteWarpedMeshesToDisk; }
         void setShouldWriteWarpedMeshesToDisk(bool v) { m_ShouldWriteWarpedMeshesToDisk = v; }
 
@@ -33,6 +40,7 @@ namespace osc::mow
     private:
         float m_WarpBlendingFactor = 1.0f;
         bool m_ShouldDefaultMissingFrameWarpsToIdentity = false;
+        double m_MaxAbsoluteWarpError = 0.0;
         bool m_ShouldWriteWarpedMeshesToDisk = false;
         std::filesystem::path m_WarpedMeshesOutputDirectory = "WarpedGeometry";
     };
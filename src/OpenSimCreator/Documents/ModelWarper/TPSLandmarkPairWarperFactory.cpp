@@ -323,19 +323,56 @@ std::unique_ptr<IPointWarper> osc::mow::TPSLandmarkPairWarperFactory::implTryCre
 {
     class TPSWarper : public IPointWarper {
     public:
-        TPSWarper(CopyOnUpdPtr<TPSCoefficients3D> coefficients_, float blendingFactor_) :
-            m_Coefficients{std::move(coefficients_)},
+        TPSWarper(const TPSCoefficients3D& coefficients_, float blendingFactor_) :
+            m_Coefficients{coefficients_},
             m_BlendingFactor{blendingFactor_}
         {}
     private:
         void implWarpInPlace(std::span<Vec3> points) const override
         {
-            ApplyThinPlateWarpToPointsInPlace(*m_Coefficients, points, m_BlendingFactor);
+            ApplyThinPlateWarpToPointsInPlace(m_Coefficients, points, m_BlendingFactor);
         }
 
-        CopyOnUpdPtr<TPSCoefficients3D> m_Coefficients;
+        // (converted once, rather than per-call, because callers may warp many small spans)
+        TPSCoefficientsSoA3D m_Coefficients;
         float m_BlendingFactor;
     };
 
-    return std::make_unique<TPSWarper>(m_TPSCoefficients, document.getWarpBlendingFactor());
+    // a `TPSWarper` that trades (bounded) accuracy for speed, which is worth it when warping
+    // with many (e.g. thousands of) landmarks
+    class ApproximateTPSWarper : public IPointWarper {
+    public:
+        ApproximateTPSWarper(const TPSCoefficients3D& coefficients_, double maxAbsoluteError_, float blendingFactor_) :
+            m_Evaluator{coefficients_, {.maxAbsoluteError = maxAbsoluteError_}},
+            m_BlendingFactor{blendingFactor_}
+        {}
+    private:
+        void implWarpInPlace(std::span<Vec3> points) const override
+        {
+            ApplyThinPlateWarpToPointsInPlace(m_Evaluator, points, m_BlendingFactor);
+        }
+
+        TPSApproximateEvaluator3D m_Evaluator;
+        float m_BlendingFactor;
+    };
+
+    if (const double maxAbsoluteError = document.getMaxAbsoluteWarpError(); maxAbsoluteError > 0.0) {
+        return std::make_unique<ApproximateTPSWarper>(*m_TPSCoefficients, maxAbsoluteError, document.getWarpBlendingFactor());
+    }
+    return std::make_unique<TPSWarper>(*m_TPSCoefficients, document.getWarpBlendingFactor());
+}
+
+bool osc::mow::TPSLandmarkPairWarperFactory::implIsEquivalentTo(const IPointWarperFactory& other) const
+{
+    if (&other == this) {
+        return true;
+    }
+    const auto* otherTPS = dynamic_cast<const TPSLandmarkPairWarperFactory*>(&other);
+    if (!otherTPS) {
+        return false;
+    }
+    // (the created warpers only depend on the coefficients, which are usually shared between copies)
+    return
+        otherTPS->m_TPSCoefficients == m_TPSCoefficients ||
+        *otherTPS->m_TPSCoefficients == *m_TPSCoefficients;
 }
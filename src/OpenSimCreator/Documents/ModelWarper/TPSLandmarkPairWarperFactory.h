@@ -67,6 +67,7 @@ namespace osc::mow
         std::vector<WarpDetail> implWarpDetails() const override;
         std::vector<ValidationCheckResult> implValidate(const WarpableModel&) const override;
         std::unique_ptr<IPointWarper> implTryCreatePointWarper(const WarpableModel&) const override;
+        bool implIsEquivalentTo(const IPointWarperFactory&) const override;
 
         std::filesystem::path m_SourceMeshAbsoluteFilepath;
 
@@ -127,6 +127,16 @@ void osc::mow::WarpableModel::setWarpBlendingFactor(float v)
     m_ModelWarpConfig.upd()->setWarpBlendingFactor(v);
 }
 
+double osc::mow::WarpableModel::getMaxAbsoluteWarpError() const
+{
+    return m_ModelWarpConfig->getMaxAbsoluteWarpError();
+}
+
+void osc::mow::WarpableModel::setMaxAbsoluteWarpError(double v)
+{
+    m_ModelWarpConfig.upd()->setMaxAbsoluteWarpError(v);
+}
+
 bool osc::mow::WarpableModel::getShouldWriteWarpedMeshesToDisk() const
 {
     return m_ModelWarpConfig->getShouldWriteWarpedMeshesToDisk();
@@ -57,6 +57,9 @@ namespace osc::mow
         float getWarpBlendingFactor() const;
         void setWarpBlendingFactor(float);
 
+        double getMaxAbsoluteWarpError() const;
+        void setMaxAbsoluteWarpError(double);
+
         bool getShouldWriteWarpedMeshesToDisk() const;
         void setShouldWriteWarpedMeshesToDisk(bool);
 
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <array>
 #include <concepts>
+#include <cstddef>
 #include <memory>
 #include <span>
 #include <sstream>
@@ -110,6 +111,24 @@ public:
         }
     }
 
+    void getValuesFloat(
+        const OpenSim::Component& component,
+        std::span<const SimulationReport> reports,
+        std::span<float> out) const
+    {
+        const OpenSim::AbstractOutput* const ao = FindOutput(component, m_ComponentAbsPath, m_OutputName);
+
+        if (not m_ExtractorFunc or not ao or typeid(*ao) != *m_OutputTypeid) {
+            // not a numeric output, cannot find output, or output has changed
+            std::ranges::fill(out, quiet_nan_v<float>);
+            return;
+        }
+
+        for (size_t i = 0; i < reports.size(); ++i) {
+            out[i] = static_cast<float>(m_ExtractorFunc(*ao, reports[i].getState()));
+        }
+    }
+
     size_t getHash() const
     {
         return hash_of(m_ComponentAbsPath.toString(), m_OutputName, m_Label, m_OutputTypeid, m_ExtractorFunc);
@@ -183,6 +202,14 @@ OutputValueExtractor osc::ComponentOutputExtractor::implGetOutputValueExtractor(
     return m_Impl->getOutputValueExtractor(component);
 }
 
+void osc::ComponentOutputExtractor::implGetValuesFloat(
+    const OpenSim::Component& component,
+    std::span<const SimulationReport> reports,
+    std::span<float> out) const
+{
+    m_Impl->getValuesFloat(component, reports, out);
+}
+
 std::size_t osc::ComponentOutputExtractor::implGetHash() const
 {
     return m_Impl->getHash();
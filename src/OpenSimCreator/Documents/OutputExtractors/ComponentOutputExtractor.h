@@ -8,6 +8,7 @@
 #include <oscar/Utils/ClonePtr.h>
 
 #include <cstddef>
+#include <span>
 
 namespace OpenSim { class AbstractOutput; }
 namespace OpenSim { class ComponentPath; }
@@ -35,6 +36,7 @@ namespace osc
         CStringView implGetDescription() const final;
         OutputExtractorDataType implGetOutputType() const final;
         OutputValueExtractor implGetOutputValueExtractor(const OpenSim::Component&) const final;
+        void implGetValuesFloat(const OpenSim::Component&, std::span<const SimulationReport>, std::span<float>) const final;
         size_t implGetHash() const final;
         bool implEquals(const IOutputExtractor&) const final;
 
@@ -12,7 +12,10 @@
 #include <oscar/Utils/EnumHelpers.h>
 #include <oscar/Utils/HashHelpers.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <span>
 #include <sstream>
 #include <string>
 
@@ -70,7 +73,7 @@ OutputValueExtractor osc::ConcatenatingOutputExtractor::implGetOutputValueExtrac
         auto extractor = [lhs = m_First.getOutputValueExtractor(comp), rhs = m_Second.getOutputValueExtractor(comp)](const SimulationReport& report)
         {
             const auto lv = to<float>(lhs(report));
-            const auto rv = to<float>(lhs(report));
+            const auto rv = to<float>(rhs(report));
 
             return Variant{Vec2{lv, rv}};
         };
@@ -85,6 +88,33 @@ OutputValueExtractor osc::ConcatenatingOutputExtractor::implGetOutputValueExtrac
     }
 }
 
+void osc::ConcatenatingOutputExtractor::implGetValuesVec2(
+    const OpenSim::Component& comp,
+    std::span<const SimulationReport> reports,
+    std::span<Vec2> out) const
+{
+    static_assert(num_options<OutputExtractorDataType>() == 3);
+
+    if (m_OutputType != OutputExtractorDataType::Vec2) {
+        std::ranges::fill(out, Vec2{quiet_nan_v<float>});
+        return;
+    }
+
+    // extract both (float) sides in fixed-size chunks, so that no intermediate
+    // buffers need to be allocated
+    std::array<float, 64> xs{};
+    std::array<float, 64> ys{};
+    for (size_t offset = 0; offset < reports.size(); offset += xs.size()) {
+        const size_t n = std::min(xs.size(), reports.size() - offset);
+        const std::span<const SimulationReport> chunk = reports.subspan(offset, n);
+        m_First.getValuesFloat(comp, chunk, std::span<float>{xs.data(), n});
+        m_Second.getValuesFloat(comp, chunk, std::span<float>{ys.data(), n});
+        for (size_t i = 0; i < n; ++i) {
+            out[offset + i] = Vec2{xs[i], ys[i]};
+        }
+    }
+}
+
 size_t osc::ConcatenatingOutputExtractor::implGetHash() const
 {
     return hash_of(m_First, m_Second);
@@ -2,10 +2,14 @@
 
 #include <OpenSimCreator/Documents/OutputExtractors/OutputValueExtractor.h>
 
+#include <oscar/Maths/Vec2.h>
 #include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/Conversion.h>
 #include <oscar/Utils/HashHelpers.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <span>
 
 using namespace osc;
 
@@ -17,6 +21,22 @@ OutputValueExtractor osc::ConstantOutputExtractor::implGetOutputValueExtractor(c
     }};
 }
 
+void osc::ConstantOutputExtractor::implGetValuesFloat(
+    const OpenSim::Component&,
+    std::span<const SimulationReport>,
+    std::span<float> out) const
+{
+    std::ranges::fill(out, to<float>(m_Value));
+}
+
+void osc::ConstantOutputExtractor::implGetValuesVec2(
+    const OpenSim::Component&,
+    std::span<const SimulationReport>,
+    std::span<Vec2> out) const
+{
+    std::ranges::fill(out, to<Vec2>(m_Value));
+}
+
 size_t osc::ConstantOutputExtractor::implGetHash() const
 {
     return hash_of(m_Name, m_Value);
@@ -8,6 +8,7 @@
 #include <oscar/Variant/Variant.h>
 
 #include <cstddef>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -34,6 +35,8 @@ namespace osc
         CStringView implGetDescription() const override { return {}; }
         OutputExtractorDataType implGetOutputType() const override { return m_Type; }
         OutputValueExtractor implGetOutputValueExtractor(const OpenSim::Component&) const override;
+        void implGetValuesFloat(const OpenSim::Component&, std::span<const SimulationReport>, std::span<float>) const override;
+        void implGetValuesVec2(const OpenSim::Component&, std::span<const SimulationReport>, std::span<Vec2>) const override;
         size_t implGetHash() const override;
         bool implEquals(const IOutputExtractor&) const override;
 
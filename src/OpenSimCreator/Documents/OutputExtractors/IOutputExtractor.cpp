@@ -4,22 +4,52 @@
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 
 #include <oscar/Maths/Constants.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Utils/Assertions.h>
 #include <oscar/Utils/Conversion.h>
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <functional>
 #include <span>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 using namespace osc;
 
+namespace
+{
+    // the number of values that are extracted (onto the stack) at a time when values are
+    // extracted into a callback
+    constexpr size_t c_NumValuesPerChunk = 64;
+
+    // extracts values in fixed-size chunks, so that emitting them to a consumer doesn't
+    // require allocating a buffer for all of them
+    template<typename T, typename Extractor, typename Consumer>
+    void ExtractInChunks(std::span<const SimulationReport> reports, Extractor&& extract, Consumer&& consume)
+    {
+        std::array<T, c_NumValuesPerChunk> buffer{};
+        for (size_t offset = 0; offset < reports.size(); offset += buffer.size()) {
+            const size_t n = std::min(buffer.size(), reports.size() - offset);
+            const std::span<T> chunk{buffer.data(), n};
+            extract(reports.subspan(offset, n), chunk);
+            for (const T& value : chunk) {
+                consume(value);
+            }
+        }
+    }
+}
+
 float osc::IOutputExtractor::getValueFloat(
     const OpenSim::Component& component,
     const SimulationReport& report) const
 {
-    const OutputValueExtractor extractor = getOutputValueExtractor(component);
-    return to<float>(extractor(report));
+    float rv = quiet_nan_v<float>;
+    getValuesFloat(component, std::span<const SimulationReport>{&report, 1}, std::span<float>{&rv, 1});
+    return rv;
 }
 
 void osc::IOutputExtractor::getValuesFloat(
@@ -27,23 +57,28 @@ void osc::IOutputExtractor::getValuesFloat(
     std::span<const SimulationReport> reports,
     const std::function<void(float)>& consumer) const
 {
-    const OutputValueExtractor extractor = getOutputValueExtractor(component);
-    for (const auto& report : reports) {
-        consumer(to<float>(extractor(report)));
-    }
+    ExtractInChunks<float>(
+        reports,
+        [this, &component](std::span<const SimulationReport> chunk, std::span<float> out) { getValuesFloat(component, chunk, out); },
+        consumer
+    );
+}
+
+void osc::IOutputExtractor::getValuesFloat(
+    const OpenSim::Component& component,
+    std::span<const SimulationReport> reports,
+    std::span<float> out) const
+{
+    OSC_ASSERT(reports.size() == out.size());
+    implGetValuesFloat(component, reports, out);
 }
 
 std::vector<float> osc::IOutputExtractor::slurpValuesFloat(
     const OpenSim::Component& component,
     std::span<const SimulationReport> reports) const
 {
-    const OutputValueExtractor extractor = getOutputValueExtractor(component);
-
-    std::vector<float> rv;
-    rv.reserve(reports.size());
-    for (const auto& report : reports) {
-        rv.push_back(to<float>(extractor(report)));
-    }
+    std::vector<float> rv(reports.size());
+    getValuesFloat(component, reports, rv);
     return rv;
 }
 
@@ -51,8 +86,9 @@ Vec2 osc::IOutputExtractor::getValueVec2(
     const OpenSim::Component& component,
     const SimulationReport& report) const
 {
-    const OutputValueExtractor extractor = getOutputValueExtractor(component);
-    return to<Vec2>(extractor(report));
+    Vec2 rv{quiet_nan_v<float>};
+    getValuesVec2(component, std::span<const SimulationReport>{&report, 1}, std::span<Vec2>{&rv, 1});
+    return rv;
 }
 
 void osc::IOutputExtractor::getValuesVec2(
@@ -60,23 +96,28 @@ void osc::IOutputExtractor::getValuesVec2(
     std::span<const SimulationReport> reports,
     const std::function<void(Vec2)>& consumer) const
 {
-    const OutputValueExtractor extractor = getOutputValueExtractor(component);
-    for (const auto& report : reports) {
-        consumer(to<Vec2>(extractor(report)));
-    }
+    ExtractInChunks<Vec2>(
+        reports,
+        [this, &component](std::span<const SimulationReport> chunk, std::span<Vec2> out) { getValuesVec2(component, chunk, out); },
+        consumer
+    );
+}
+
+void osc::IOutputExtractor::getValuesVec2(
+    const OpenSim::Component& component,
+    std::span<const SimulationReport> reports,
+    std::span<Vec2> out) const
+{
+    OSC_ASSERT(reports.size() == out.size());
+    implGetValuesVec2(component, reports, out);
 }
 
 std::vector<Vec2> osc::IOutputExtractor::slurpValuesVec2(
     const OpenSim::Component& component,
     std::span<const SimulationReport> reports) const
 {
-    const OutputValueExtractor extractor = getOutputValueExtractor(component);
-
-    std::vector<Vec2> rv;
-    rv.reserve(reports.size());
-    for (const auto& report : reports) {
-        rv.push_back(to<Vec2>(extractor(report)));
-    }
+    std::vector<Vec2> rv(reports.size());
+    getValuesVec2(component, reports, rv);
     return rv;
 }
 
@@ -86,3 +127,25 @@ std::string osc::IOutputExtractor::getValueString(
 {
     return to<std::string>(getOutputValueExtractor(component)(report));
 }
+
+void osc::IOutputExtractor::implGetValuesFloat(
+    const OpenSim::Component& component,
+    std::span<const SimulationReport> reports,
+    std::span<float> out) const
+{
+    const OutputValueExtractor extractor = getOutputValueExtractor(component);
+    for (size_t i = 0; i < reports.size(); ++i) {
+        out[i] = to<float>(extractor(reports[i]));
+    }
+}
+
+void osc::IOutputExtractor::implGetValuesVec2(
+    const OpenSim::Component& component,
+    std::span<const SimulationReport> reports,
+    std::span<Vec2> out) const
+{
+    const OutputValueExtractor extractor = getOutputValueExtractor(component);
+    for (size_t i = 0; i < reports.size(); ++i) {
+        out[i] = to<Vec2>(extractor(reports[i]));
+    }
+}
@@ -54,6 +54,17 @@ namespace osc
             const std::function<void(float)>& consumer
         ) const;
 
+        // writes the output's value for each report into `out`, which must have the same
+        // size as the reports
+        //
+        // this is the fast path for extracting many values, because implementations can
+        // write typed values directly, rather than going through an `OutputValueExtractor`
+        void getValuesFloat(
+            const OpenSim::Component&,
+            std::span<const SimulationReport>,
+            std::span<float> out
+        ) const;
+
         std::vector<float> slurpValuesFloat(
             const OpenSim::Component&,
             std::span<const SimulationReport>
@@ -70,6 +81,14 @@ namespace osc
             const std::function<void(Vec2)>& consumer
         ) const;
 
+        // writes the output's value for each report into `out`, which must have the same
+        // size as the reports (see the `float` overload)
+        void getValuesVec2(
+            const OpenSim::Component&,
+            std::span<const SimulationReport>,
+            std::span<Vec2> out
+        ) const;
+
         std::vector<Vec2> slurpValuesVec2(
             const OpenSim::Component&,
             std::span<const SimulationReport>
@@ -92,6 +111,11 @@ namespace osc
         virtual CStringView implGetDescription() const = 0;
         virtual OutputExtractorDataType implGetOutputType() const = 0;
         virtual OutputValueExtractor implGetOutputValueExtractor(const OpenSim::Component&) const = 0;
+
+        // by default, these extract values via `implGetOutputValueExtractor`: override them
+        // when the output can be extracted faster
+        virtual void implGetValuesFloat(const OpenSim::Component&, std::span<const SimulationReport>, std::span<float>) const;
+        virtual void implGetValuesVec2(const OpenSim::Component&, std::span<const SimulationReport>, std::span<Vec2>) const;
         virtual size_t implGetHash() const = 0;
         virtual bool implEquals(const IOutputExtractor&) const = 0;
     };
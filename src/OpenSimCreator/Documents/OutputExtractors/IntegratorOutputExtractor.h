@@ -8,10 +8,12 @@
 #include <oscar/Utils/UID.h>
 
 #include <cstddef>
+#include <span>
 #include <string>
 #include <string_view>
 
 namespace OpenSim { class Component; }
+namespace osc { class SimulationReport; }
 namespace SimTK { class Integrator; }
 
 namespace osc
@@ -39,6 +41,7 @@ namespace osc
         CStringView implGetDescription() const final { return m_Description; }
         OutputExtractorDataType implGetOutputType() const override { return OutputExtractorDataType::Float; }
         OutputValueExtractor implGetOutputValueExtractor(const OpenSim::Component&) const final;
+        void implGetValuesFloat(const OpenSim::Component&, std::span<const SimulationReport>, std::span<float>) const final;
         size_t implGetHash() const final;
         bool implEquals(const IOutputExtractor&) const final;
 
@@ -59,6 +59,14 @@ OutputValueExtractor osc::MultiBodySystemOutputExtractor::implGetOutputValueExtr
     }};
 }
 
+void osc::MultiBodySystemOutputExtractor::implGetValuesFloat(
+    const OpenSim::Component&,
+    std::span<const SimulationReport> reports,
+    std::span<float> out) const
+{
+    CopyAuxiliaryValues(reports, m_AuxiliaryDataID, out, quiet_nan_v<float>);
+}
+
 std::size_t osc::MultiBodySystemOutputExtractor::implGetHash() const
 {
     return hash_of(m_AuxiliaryDataID, m_Name, m_Description, m_Extractor);
@@ -53,6 +53,14 @@ namespace osc
             m_Output->getValuesFloat(component, reports, consumer);
         }
 
+        void getValuesFloat(
+            const OpenSim::Component& component,
+            std::span<const SimulationReport> reports,
+            std::span<float> out) const
+        {
+            m_Output->getValuesFloat(component, reports, out);
+        }
+
         std::vector<float> slurpValuesFloat(
             const OpenSim::Component& component,
             std::span<const SimulationReport> reports) const
@@ -75,6 +83,14 @@ namespace osc
             m_Output->getValuesVec2(component, report, consumer);
         }
 
+        void getValuesVec2(
+            const OpenSim::Component& component,
+            std::span<const SimulationReport> reports,
+            std::span<Vec2> out) const
+        {
+            m_Output->getValuesVec2(component, reports, out);
+        }
+
         std::vector<Vec2> slurpValuesVec2(
             const OpenSim::Component& component,
             std::span<const SimulationReport> report) const
@@ -0,0 +1,314 @@
+#include "BatchSimulation.h"
+
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulation.h>
+#include <OpenSimCreator/Documents/Simulation/Simulation.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationHelpers.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Formats/CSV.h>
+#include <oscar/Utils/EnumHelpers.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+namespace rgs = std::ranges;
+
+namespace
+{
+    // returns the model + state that the variant's simulation should start from
+    BasicModelStatePair CreateVariantModelState(
+        const BasicModelStatePair& base,
+        const BatchSimulationVariant& variant)
+    {
+        if (not variant.modelEditor) {
+            return base;
+        }
+
+        OpenSim::Model editedModel{base.getModel()};
+        variant.modelEditor(editedModel);
+        InitializeModel(editedModel);
+        const SimTK::State& editedState = InitializeState(editedModel);
+
+        BasicModelStatePair rv{editedModel, editedState};
+        rv.setFixupScaleFactor(base.getFixupScaleFactor());
+        return rv;
+    }
+}
+
+size_t osc::GetDefaultMaxConcurrentSimulations()
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+class osc::BatchSimulation::Impl final {
+public:
+    Impl(
+        BasicModelStatePair baseModelState,
+        std::vector<BatchSimulationVariant> variants,
+        std::vector<OutputExtractor> sharedOutputs) :
+
+        m_BaseModelState{std::move(baseModelState)},
+        m_Variants{std::move(variants)},
+        m_SharedOutputs{std::move(sharedOutputs)},
+        m_Simulations(m_Variants.size())
+    {}
+
+    size_t getMaxConcurrentSimulations() const
+    {
+        return m_MaxConcurrentSimulations;
+    }
+
+    void setMaxConcurrentSimulations(size_t n)
+    {
+        m_MaxConcurrentSimulations = std::max<size_t>(n, 1);
+    }
+
+    void tick()
+    {
+        // collect reports from all started simulations, so that running simulations
+        // don't wait on their (full) report queues
+        for (const std::shared_ptr<Simulation>& simulation : m_Simulations) {
+            if (simulation) {
+                simulation->pollNewReports();
+            }
+        }
+
+        if (m_StopRequested) {
+            return;
+        }
+
+        size_t numActive = getNumActiveSimulations();
+        while (numActive < m_MaxConcurrentSimulations and m_NumStarted < m_Variants.size()) {
+            const BatchSimulationVariant& variant = m_Variants[m_NumStarted];
+            m_Simulations[m_NumStarted] = std::make_shared<Simulation>(ForwardDynamicSimulation{
+                CreateVariantModelState(m_BaseModelState, variant),
+                variant.params,
+            });
+            ++m_NumStarted;
+            ++numActive;
+        }
+    }
+
+    size_t getNumVariants() const
+    {
+        return m_Variants.size();
+    }
+
+    const BatchSimulationVariant& getVariant(size_t i) const
+    {
+        return m_Variants.at(i);
+    }
+
+    std::shared_ptr<Simulation> getSimulation(size_t i) const
+    {
+        return m_Simulations.at(i);
+    }
+
+    SimulationStatus getStatus(size_t i) const
+    {
+        const std::shared_ptr<Simulation>& simulation = m_Simulations.at(i);
+        if (simulation) {
+            return simulation->getStatus();
+        }
+        return m_StopRequested ? SimulationStatus::Cancelled : SimulationStatus::Initializing;
+    }
+
+    float getProgress(size_t i) const
+    {
+        const std::shared_ptr<Simulation>& simulation = m_Simulations.at(i);
+        return simulation ? simulation->getProgress() : 0.0f;
+    }
+
+    size_t getNumActiveSimulations() const
+    {
+        return static_cast<size_t>(rgs::count_if(m_Simulations, [](const auto& simulation)
+        {
+            return simulation and IsActive(simulation->getStatus());
+        }));
+    }
+
+    bool isDone() const
+    {
+        return (m_NumStarted == m_Variants.size() or m_StopRequested) and getNumActiveSimulations() == 0;
+    }
+
+    std::span<const OutputExtractor> getOutputExtractors() const
+    {
+        return m_SharedOutputs;
+    }
+
+    std::optional<std::vector<float>> getLatestOutputValues(size_t i) const
+    {
+        const std::shared_ptr<Simulation>& simulation = m_Simulations.at(i);
+        if (not simulation or simulation->getNumReports() == 0) {
+            return std::nullopt;
+        }
+
+        // care: the report must be acquired before locking the model, because
+        // acquiring reports may require (briefly) locking the model
+        const SimulationReport latestReport = simulation->getSimulationReport(static_cast<ptrdiff_t>(simulation->getNumReports() - 1));
+        const auto model = simulation->getModel();
+
+        std::vector<float> rv;
+        for (const std::vector<float>& column : ExtractOutputColumns(*model, m_SharedOutputs, {&latestReport, 1})) {
+            rv.push_back(column.front());
+        }
+        return rv;
+    }
+
+    void requestStop()
+    {
+        m_StopRequested = true;
+        for (const std::shared_ptr<Simulation>& simulation : m_Simulations) {
+            if (simulation) {
+                simulation->requestStop();
+            }
+        }
+    }
+
+    void stop()
+    {
+        m_StopRequested = true;
+        for (const std::shared_ptr<Simulation>& simulation : m_Simulations) {
+            if (simulation) {
+                simulation->stop();
+            }
+        }
+    }
+
+private:
+    BasicModelStatePair m_BaseModelState;
+    std::vector<BatchSimulationVariant> m_Variants;
+    std::vector<OutputExtractor> m_SharedOutputs;
+    std::vector<std::shared_ptr<Simulation>> m_Simulations;  // one per variant, `nullptr` until started
+    size_t m_NumStarted = 0;
+    size_t m_MaxConcurrentSimulations = GetDefaultMaxConcurrentSimulations();
+    bool m_StopRequested = false;
+};
+
+
+osc::BatchSimulation::BatchSimulation(
+    BasicModelStatePair baseModelState,
+    std::vector<BatchSimulationVariant> variants,
+    std::vector<OutputExtractor> sharedOutputs) :
+
+    m_Impl{std::make_unique<Impl>(std::move(baseModelState), std::move(variants), std::move(sharedOutputs))}
+{}
+osc::BatchSimulation::BatchSimulation(BatchSimulation&&) noexcept = default;
+osc::BatchSimulation& osc::BatchSimulation::operator=(BatchSimulation&&) noexcept = default;
+osc::BatchSimulation::~BatchSimulation() noexcept = default;
+
+size_t osc::BatchSimulation::getMaxConcurrentSimulations() const
+{
+    return m_Impl->getMaxConcurrentSimulations();
+}
+
+void osc::BatchSimulation::setMaxConcurrentSimulations(size_t n)
+{
+    m_Impl->setMaxConcurrentSimulations(n);
+}
+
+void osc::BatchSimulation::tick()
+{
+    m_Impl->tick();
+}
+
+size_t osc::BatchSimulation::getNumVariants() const
+{
+    return m_Impl->getNumVariants();
+}
+
+const BatchSimulationVariant& osc::BatchSimulation::getVariant(size_t i) const
+{
+    return m_Impl->getVariant(i);
+}
+
+std::shared_ptr<Simulation> osc::BatchSimulation::getSimulation(size_t i) const
+{
+    return m_Impl->getSimulation(i);
+}
+
+SimulationStatus osc::BatchSimulation::getStatus(size_t i) const
+{
+    return m_Impl->getStatus(i);
+}
+
+float osc::BatchSimulation::getProgress(size_t i) const
+{
+    return m_Impl->getProgress(i);
+}
+
+size_t osc::BatchSimulation::getNumActiveSimulations() const
+{
+    return m_Impl->getNumActiveSimulations();
+}
+
+bool osc::BatchSimulation::isDone() const
+{
+    return m_Impl->isDone();
+}
+
+std::span<const OutputExtractor> osc::BatchSimulation::getOutputExtractors() const
+{
+    return m_Impl->getOutputExtractors();
+}
+
+std::optional<std::vector<float>> osc::BatchSimulation::getLatestOutputValues(size_t i) const
+{
+    return m_Impl->getLatestOutputValues(i);
+}
+
+void osc::BatchSimulation::requestStop()
+{
+    m_Impl->requestStop();
+}
+
+void osc::BatchSimulation::stop()
+{
+    m_Impl->stop();
+}
+
+void osc::WriteBatchSummaryAsCSV(const BatchSimulation& batch, std::ostream& out)
+{
+    const std::vector<std::string> outputColumnNames = GetOutputColumnNames(batch.getOutputExtractors());
+
+    // header row
+    std::vector<std::string> row = {"label", "status"};
+    row.insert(row.end(), outputColumnNames.begin(), outputColumnNames.end());
+    write_csv_row(out, row);
+
+    // data rows (labels/names are user-provided, so they're quoted/escaped by `write_csv_row`)
+    for (size_t i = 0; i < batch.getNumVariants(); ++i) {
+        row.clear();
+        row.push_back(batch.getVariant(i).label);
+        row.emplace_back(GetAllSimulationStatusStrings()[to_index(batch.getStatus(i))]);
+
+        const std::optional<std::vector<float>> values = batch.getLatestOutputValues(i);
+        for (size_t column = 0; column < outputColumnNames.size(); ++column) {
+            if (values) {
+                std::stringstream ss;
+                ss << (*values)[column];
+                row.push_back(std::move(ss).str());
+            }
+            else {
+                row.emplace_back();
+            }
+        }
+        write_csv_row(out, row);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace OpenSim { class Model; }
+namespace osc { class Simulation; }
+
+namespace osc
+{
+    // one variant (e.g. of a parameter sweep) in a `BatchSimulation`
+    struct BatchSimulationVariant final {
+
+        // human-readable label for the variant (e.g. "max_isometric_force = 500")
+        std::string label;
+
+        // parameters of the variant's forward-dynamic simulation
+        ForwardDynamicSimulatorParams params;
+
+        // if provided, edits a copy of the base model before the variant's simulation
+        // starts (e.g. to change muscle strengths, or the default values of coordinates,
+        // which then become the variant's initial state)
+        std::function<void(OpenSim::Model&)> modelEditor;
+    };
+
+    // returns the default number of simulations that a `BatchSimulation` runs concurrently
+    // (i.e. the number of hardware threads that the machine has)
+    size_t GetDefaultMaxConcurrentSimulations();
+
+    // a batch of forward-dynamic simulations (one per variant of a base model + parameters)
+    //
+    // the simulations are scheduled over a bounded number of concurrently-running
+    // simulations. Scheduling is driven by `tick`, which should be called regularly (e.g.
+    // once per UI frame). All variants share the same output extractors, so that their
+    // results can be compared with each other
+    class BatchSimulation final {
+    public:
+        BatchSimulation(
+            BasicModelStatePair baseModelState,
+            std::vector<BatchSimulationVariant> variants,
+            std::vector<OutputExtractor> sharedOutputs = {}
+        );
+        BatchSimulation(const BatchSimulation&) = delete;
+        BatchSimulation(BatchSimulation&&) noexcept;
+        BatchSimulation& operator=(const BatchSimulation&) = delete;
+        BatchSimulation& operator=(BatchSimulation&&) noexcept;
+        ~BatchSimulation() noexcept;
+
+        size_t getMaxConcurrentSimulations() const;
+        void setMaxConcurrentSimulations(size_t);
+
+        // collects new reports from started simulations, and starts queued simulations, if
+        // fewer than the maximum number of simulations are running
+        void tick();
+
+        size_t getNumVariants() const;
+        const BatchSimulationVariant& getVariant(size_t) const;
+
+        // returns the variant's simulation, or `nullptr` if it hasn't started yet
+        std::shared_ptr<Simulation> getSimulation(size_t) const;
+
+        // returns `SimulationStatus::Initializing` if the variant hasn't started yet
+        SimulationStatus getStatus(size_t) const;
+        float getProgress(size_t) const;
+
+        size_t getNumActiveSimulations() const;
+
+        // returns `true` if every variant's simulation has started and finished
+        bool isDone() const;
+
+        std::span<const OutputExtractor> getOutputExtractors() const;
+
+        // returns the values of the shared outputs in the variant's latest report (laid
+        // out the same way as `ExtractOutputColumns`), or `std::nullopt` if the variant
+        // hasn't emitted any reports yet
+        std::optional<std::vector<float>> getLatestOutputValues(size_t) const;
+
+        // stops all running simulations, and prevents queued simulations from starting
+        void requestStop();
+        void stop();
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+
+    // writes a CSV containing one row per variant (label, status, and the latest
+    // value of each shared output)
+    void WriteBatchSummaryAsCSV(const BatchSimulation&, std::ostream&);
+}
@@ -0,0 +1,280 @@
+#include "BinaryOutputs.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+namespace rgs = std::ranges;
+
+namespace
+{
+    static_assert(std::endian::native == std::endian::little, "the binary outputs format is only supported on little-endian machines");
+
+    constexpr auto c_Magic = std::to_array<char>({'O', 'S', 'C', 'O', 'U', 'T', 'S', '\0'});
+    constexpr uint32_t c_Version = 1;
+    constexpr uint32_t c_Float64DataType = 0;
+    constexpr uint32_t c_Float32DataType = 1;
+    constexpr std::string_view c_TimeColumnName = "time";
+    constexpr size_t c_Alignment = 8;
+
+    constexpr size_t RoundUpToAlignment(size_t n)
+    {
+        return ((n + c_Alignment - 1) / c_Alignment) * c_Alignment;
+    }
+
+    void WriteBytes(std::ostream& out, const void* data, size_t numBytes)
+    {
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(numBytes));
+    }
+
+    template<typename T>
+    void WriteValue(std::ostream& out, const T& value)
+    {
+        WriteBytes(out, &value, sizeof(T));
+    }
+
+    // writes the given values, followed by padding to the next alignment boundary
+    template<typename T>
+    void WriteAlignedValues(std::ostream& out, std::span<const T> values)
+    {
+        constexpr std::array<char, c_Alignment> c_Zeroes{};
+        WriteBytes(out, values.data(), values.size_bytes());
+        WriteBytes(out, c_Zeroes.data(), RoundUpToAlignment(values.size_bytes()) - values.size_bytes());
+    }
+
+    void WriteColumnDescription(std::ostream& out, uint32_t dataType, std::string_view name)
+    {
+        WriteValue(out, dataType);
+        WriteValue(out, static_cast<uint32_t>(name.size()));
+        WriteBytes(out, name.data(), name.size());
+    }
+
+    // a bounds-checked cursor for parsing values out of the (mapped) file
+    class Cursor final {
+    public:
+        Cursor(const std::filesystem::path& path, std::span<const std::byte> bytes) :
+            m_Path{&path},
+            m_Bytes{bytes}
+        {}
+
+        size_t offset() const { return m_Offset; }
+        size_t remaining() const { return m_Bytes.size() - m_Offset; }
+
+        template<typename T>
+        T read()
+        {
+            T rv;
+            std::memcpy(&rv, readBytes(sizeof(T)).data(), sizeof(T));
+            return rv;
+        }
+
+        std::span<const std::byte> readBytes(size_t n)
+        {
+            if (n > remaining()) {
+                throwError("unexpected end of file");
+            }
+            const auto rv = m_Bytes.subspan(m_Offset, n);
+            m_Offset += n;
+            return rv;
+        }
+
+        void skipToAlignment()
+        {
+            readBytes(RoundUpToAlignment(m_Offset) - m_Offset);
+        }
+
+        [[noreturn]] void throwError(std::string_view message) const
+        {
+            std::stringstream ss;
+            ss << m_Path->string() << ": error reading binary outputs file: " << message;
+            throw std::runtime_error{std::move(ss).str()};
+        }
+
+    private:
+        const std::filesystem::path* m_Path;
+        std::span<const std::byte> m_Bytes;
+        size_t m_Offset = 0;
+    };
+}
+
+osc::BinaryOutputsWriter::BinaryOutputsWriter(
+    std::ostream& out,
+    std::span<const std::string> outputColumnNames) :
+
+    m_Output{&out},
+    m_NumOutputColumns{outputColumnNames.size()}
+{
+    size_t headerSize = 0;
+    const auto countingWrite = [this, &headerSize](uint32_t dataType, std::string_view name)
+    {
+        WriteColumnDescription(*m_Output, dataType, name);
+        headerSize += 2*sizeof(uint32_t) + name.size();
+    };
+
+    WriteBytes(*m_Output, c_Magic.data(), c_Magic.size());
+    WriteValue(*m_Output, c_Version);
+    WriteValue(*m_Output, static_cast<uint32_t>(m_NumOutputColumns + 1));
+    headerSize += c_Magic.size() + 2*sizeof(uint32_t);
+
+    countingWrite(c_Float64DataType, c_TimeColumnName);
+    for (const std::string& name : outputColumnNames) {
+        countingWrite(c_Float32DataType, name);
+    }
+
+    constexpr std::array<char, c_Alignment> c_Zeroes{};
+    WriteBytes(*m_Output, c_Zeroes.data(), RoundUpToAlignment(headerSize) - headerSize);
+}
+
+void osc::BinaryOutputsWriter::writeBlock(
+    std::span<const double> times,
+    std::span<const std::vector<float>> outputColumns)
+{
+    if (outputColumns.size() != m_NumOutputColumns) {
+        throw std::runtime_error{"cannot write a block of outputs: the number of columns does not match the header"};
+    }
+    for (const std::vector<float>& column : outputColumns) {
+        if (column.size() != times.size()) {
+            throw std::runtime_error{"cannot write a block of outputs: a column has a different number of rows from the time column"};
+        }
+    }
+    if (times.empty()) {
+        return;  // don't bother writing empty blocks
+    }
+
+    WriteValue(*m_Output, static_cast<uint64_t>(times.size()));
+    WriteAlignedValues(*m_Output, times);
+    for (const std::vector<float>& column : outputColumns) {
+        WriteAlignedValues(*m_Output, std::span<const float>{column});
+    }
+    m_NumRowsWritten += times.size();
+}
+
+osc::BinaryOutputsFile::BinaryOutputsFile(const std::filesystem::path& path) :
+    m_File{path}
+{
+    Cursor cursor{path, m_File.bytes()};
+
+    // parse header
+    {
+        const std::span<const std::byte> magic = cursor.readBytes(c_Magic.size());
+        if (std::memcmp(magic.data(), c_Magic.data(), c_Magic.size()) != 0) {
+            cursor.throwError("not a binary outputs file (bad magic number)");
+        }
+    }
+    if (const auto version = cursor.read<uint32_t>(); version != c_Version) {
+        cursor.throwError("unsupported version: " + std::to_string(version));
+    }
+    const auto numColumns = cursor.read<uint32_t>();
+    if (numColumns == 0) {
+        cursor.throwError("the file does not contain a time column");
+    }
+    for (uint32_t column = 0; column < numColumns; ++column) {
+        const auto dataType = cursor.read<uint32_t>();
+        const auto nameLength = cursor.read<uint32_t>();
+        const std::span<const std::byte> nameBytes = cursor.readBytes(nameLength);
+        std::string name(reinterpret_cast<const char*>(nameBytes.data()), nameBytes.size());
+
+        const uint32_t expectedDataType = column == 0 ? c_Float64DataType : c_Float32DataType;
+        if (dataType != expectedDataType) {
+            cursor.throwError(name + ": unsupported column data type");
+        }
+        if (column > 0) {
+            m_OutputColumnNames.push_back(std::move(name));
+        }
+    }
+    cursor.skipToAlignment();
+
+    // index blocks (a truncated trailing block is ignored, because it might still be being written)
+    //
+    // care: the number of rows is checked against the remaining bytes before calculating the
+    // block's size, so that a corrupt row count can't overflow the calculation (and, therefore,
+    // yield spans that point outside of the mapped file)
+    while (cursor.remaining() >= sizeof(uint64_t)) {
+        const auto numRows = cursor.read<uint64_t>();
+        if (numRows > cursor.remaining() / sizeof(double)) {
+            break;
+        }
+        const size_t timesBytes = RoundUpToAlignment(static_cast<size_t>(numRows) * sizeof(double));
+        const size_t outputColumnBytes = RoundUpToAlignment(static_cast<size_t>(numRows) * sizeof(float));
+        if (timesBytes > cursor.remaining()) {
+            break;
+        }
+        if (outputColumnBytes > 0 and m_OutputColumnNames.size() > (cursor.remaining() - timesBytes) / outputColumnBytes) {
+            break;
+        }
+        const size_t blockBytes = timesBytes + m_OutputColumnNames.size()*outputColumnBytes;
+
+        const size_t timesOffset = cursor.offset();
+        m_Blocks.push_back(Block{
+            .numRows = static_cast<size_t>(numRows),
+            .timesOffset = timesOffset,
+            .firstOutputColumnOffset = timesOffset + timesBytes,
+        });
+        m_NumRows += static_cast<size_t>(numRows);
+        cursor.readBytes(blockBytes);
+    }
+}
+
+std::optional<size_t> osc::BinaryOutputsFile::findOutputColumn(std::string_view name) const
+{
+    const auto it = rgs::find(m_OutputColumnNames, name);
+    if (it == m_OutputColumnNames.end()) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(std::distance(m_OutputColumnNames.begin(), it));
+}
+
+std::span<const double> osc::BinaryOutputsFile::getTimes(size_t block) const
+{
+    const Block& b = m_Blocks.at(block);
+    const auto* first = reinterpret_cast<const double*>(m_File.bytes().data() + b.timesOffset);
+    return {first, b.numRows};
+}
+
+std::span<const float> osc::BinaryOutputsFile::getOutputColumnValues(size_t block, size_t column) const
+{
+    const Block& b = m_Blocks.at(block);
+    if (column >= m_OutputColumnNames.size()) {
+        throw std::out_of_range{"attempted to access an out-of-bounds output column"};
+    }
+    const size_t offset = b.firstOutputColumnOffset + column*RoundUpToAlignment(b.numRows * sizeof(float));
+    const auto* first = reinterpret_cast<const float*>(m_File.bytes().data() + offset);
+    return {first, b.numRows};
+}
+
+std::vector<double> osc::BinaryOutputsFile::copyTimes() const
+{
+    std::vector<double> rv;
+    rv.reserve(m_NumRows);
+    for (size_t block = 0; block < m_Blocks.size(); ++block) {
+        const std::span<const double> times = getTimes(block);
+        rv.insert(rv.end(), times.begin(), times.end());
+    }
+    return rv;
+}
+
+std::vector<float> osc::BinaryOutputsFile::copyOutputColumnValues(size_t column) const
+{
+    std::vector<float> rv;
+    rv.reserve(m_NumRows);
+    for (size_t block = 0; block < m_Blocks.size(); ++block) {
+        const std::span<const float> values = getOutputColumnValues(block, column);
+        rv.insert(rv.end(), values.begin(), values.end());
+    }
+    return rv;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <oscar/Platform/MemoryMappedFile.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// binary outputs format (`.oscouts`)
+//
+// a columnar format for simulation outputs that can be streamed out incrementally (e.g.
+// while a simulation is running) and memory-mapped back in without any parsing/copying.
+// All values are written in the machine's native byte order (little-endian on all
+// supported platforms):
+//
+//     header:
+//         char[8]    magic (`OSCOUTS\0`)
+//         uint32     version (currently, 1)
+//         uint32     number of columns (the first column is always `time`)
+//         per column:
+//             uint32 data type (0: float64, 1: float32)
+//             uint32 name length, in bytes
+//             char[]  name (not null-terminated)
+//         zero-padding to an 8-byte boundary
+//
+//     blocks (repeated until EOF):
+//         uint64     number of rows in the block
+//         per column:
+//             values (number of rows * sizeof(data type) bytes)
+//             zero-padding to an 8-byte boundary
+//
+// a block that is truncated (e.g. because the file is still being written) is ignored
+// by readers
+//
+// the simulator UI streams files in this format while a simulation is running (see
+// `SimulationOutputsStreamer`) and loads them back as overlays in its output plots
+namespace osc
+{
+    // incrementally writes a time column (float64) + output columns (float32) to an
+    // output stream in the binary outputs format
+    class BinaryOutputsWriter final {
+    public:
+        // immediately writes the header to the stream
+        BinaryOutputsWriter(std::ostream&, std::span<const std::string> outputColumnNames);
+
+        // appends a block of rows to the stream
+        //
+        // throws if the number of columns doesn't match the number of output column
+        // names, or if any column has a different number of rows from `times`
+        void writeBlock(std::span<const double> times, std::span<const std::vector<float>> outputColumns);
+
+        size_t getNumRowsWritten() const { return m_NumRowsWritten; }
+
+    private:
+        std::ostream* m_Output;
+        size_t m_NumOutputColumns;
+        size_t m_NumRowsWritten = 0;
+    };
+
+    // a read-only, memory-mapped, view of a file that was written in the binary outputs format
+    //
+    // the values are not copied out of the file: the spans returned by this class point
+    // directly into the mapped file
+    class BinaryOutputsFile final {
+    public:
+        // throws if the file cannot be mapped, or isn't in the binary outputs format
+        explicit BinaryOutputsFile(const std::filesystem::path&);
+
+        size_t getNumOutputColumns() const { return m_OutputColumnNames.size(); }
+        std::string_view getOutputColumnName(size_t column) const { return m_OutputColumnNames.at(column); }
+
+        // returns the index of the (first) output column that has the given name, if any
+        std::optional<size_t> findOutputColumn(std::string_view name) const;
+
+        size_t getNumRows() const { return m_NumRows; }
+        size_t getNumBlocks() const { return m_Blocks.size(); }
+        std::span<const double> getTimes(size_t block) const;
+        std::span<const float> getOutputColumnValues(size_t block, size_t column) const;
+
+        // returns copies of all of the values of a column, concatenated across blocks
+        std::vector<double> copyTimes() const;
+        std::vector<float> copyOutputColumnValues(size_t column) const;
+
+    private:
+        struct Block final {
+            size_t numRows;
+            size_t timesOffset;  // byte offset of the time column in the file
+
+            // byte offset of the first output column (subsequent columns are
+            // each `RoundUpTo8(numRows * sizeof(float))` bytes further along)
+            size_t firstOutputColumnOffset;
+        };
+
+        MemoryMappedFile m_File;
+        std::vector<std::string> m_OutputColumnNames;
+        std::vector<Block> m_Blocks;
+        size_t m_NumRows = 0;
+    };
+}
@@ -4,8 +4,10 @@
 #include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
 #include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulator.h>
 #include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationCheckpoint.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReportSequence.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
 #include <OpenSimCreator/Utils/ParamBlock.h>
 
@@ -13,35 +15,61 @@
 #include <oscar/Utils/Algorithms.h>
 #include <oscar/Utils/SynchronizedValue.h>
 #include <oscar/Utils/SynchronizedValueGuard.h>
+#include <oscar/Utils/UID.h>
 
 #include <algorithm>
 #include <chrono>
 #include <cstddef>
-#include <functional>
+#include <limits>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
+#include <stdexcept>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 using namespace osc;
+namespace rgs = std::ranges;
 
 // helpers
 namespace
 {
-    // creates a simulator that's hooked up to the reports vector
+    // the maximum number of rebuilt + realized reports that the simulation caches
+    //
+    // this should be large enough to hold the reports that the UI is likely to ask for
+    // each frame (e.g. the scrubbed report + its neighbours), so that the same report
+    // (i.e. the same state version) is returned across frames
+    constexpr size_t c_MaxRealizedReportsCached = 32;
+
+    // the maximum number of reports that can be waiting in the queue between the
+    // simulator thread and the UI thread before the simulator thread has to wait
+    // for the UI thread to collect them
+    //
+    // the UI thread collects reports once per frame, so this should be large enough
+    // to absorb (e.g.) a few frames' worth of reports from a fast simulation
+    constexpr size_t c_ReportQueueCapacity = 1024;
+
+    // how long `join` waits between collecting reports from a still-running simulation
+    constexpr std::chrono::milliseconds c_JoinPollingInterval{1};
+
+    size_t ToNumFullPrecisionReports(const ForwardDynamicSimulatorParams& params)
+    {
+        return params.numFullPrecisionReports >= 0 ?
+            static_cast<size_t>(params.numFullPrecisionReports) :
+            std::numeric_limits<size_t>::max();
+    }
+
+    // creates a simulator that's hooked up to the report queue
     ForwardDynamicSimulator MakeSimulation(
         BasicModelStatePair p,
         const ForwardDynamicSimulatorParams& params,
-        SynchronizedValue<std::vector<SimulationReport>>& reportQueue)
+        std::shared_ptr<SimulationReportQueue> reportQueue)
     {
-        auto callback = [&](SimulationReport r)
-        {
-            auto reportsGuard = reportQueue.lock();
-            reportsGuard->push_back(std::move(r));
-        };
-        return ForwardDynamicSimulator{std::move(p), params, std::move(callback)};
+        return ForwardDynamicSimulator{std::move(p), params, std::move(reportQueue)};
     }
 
     std::vector<OutputExtractor> GetFdSimulatorOutputExtractorsAsVector()
@@ -62,6 +90,7 @@ public:
 
     Impl(BasicModelStatePair p, const ForwardDynamicSimulatorParams& params) :
         m_ModelState{std::move(p)},
+        m_Reports{ToNumFullPrecisionReports(params)},
         m_Simulation{MakeSimulation(*m_ModelState.lock(), params, m_ReportQueue)},
         m_Params{params},
         m_ParamsAsParamBlock{ToParamBlock(params)},
@@ -70,7 +99,14 @@ public:
 
     void join()
     {
+        // keep collecting reports while waiting, so that the simulator thread
+        // can't end up waiting on a full report queue forever
+        while (IsActive(m_Simulation.getStatus())) {
+            popReportsHACK();
+            std::this_thread::sleep_for(c_JoinPollingInterval);
+        }
         m_Simulation.join();
+        popReportsHACK();
     }
 
     SynchronizedValueGuard<const OpenSim::Model> getModel() const
@@ -78,22 +114,96 @@ public:
         return m_ModelState.lock_child<OpenSim::Model>([](const BasicModelStatePair& p) -> decltype(auto) { return p.getModel(); });
     }
 
+    size_t pollNewReports()
+    {
+        return popReportsHACK();
+    }
+
     ptrdiff_t getNumReports() const
     {
         popReportsHACK();
         return m_Reports.size();
     }
 
+    UID getReportsGeneration() const
+    {
+        // (the reports are only ever truncated by this (UI) thread, so this doesn't need to lock them)
+        return m_Reports.getGeneration();
+    }
+
     SimulationReport getSimulationReport(ptrdiff_t reportIndex) const
     {
         popReportsHACK();
-        return m_Reports.at(reportIndex);
+
+        const auto i = static_cast<size_t>(reportIndex);
+
+        // if it's already cached, move it to the back (most-recently used) and return it
+        if (const auto it = rgs::find_if(m_RealizedReportCache, [i](const auto& p) { return p.first == i; }); it != m_RealizedReportCache.end()) {
+            std::rotate(it, std::next(it), m_RealizedReportCache.end());
+            return m_RealizedReportCache.back().second;
+        }
+
+        // else: rebuild it from the report store, realize it, and cache it
+        SimulationReport report = m_Reports.getReport(i);
+        m_ModelState.lock()->getModel().realizeReport(report.updStateHACK());
+
+        if (m_RealizedReportCache.size() >= c_MaxRealizedReportsCached) {
+            m_RealizedReportCache.erase(m_RealizedReportCache.begin());
+        }
+        m_RealizedReportCache.emplace_back(i, report);
+
+        return report;
+    }
+
+    SimulationReport getUnrealizedSimulationReport(ptrdiff_t reportIndex) const
+    {
+        // care: this may be called from other threads, so it can't collect reports
+        const std::lock_guard lock{m_ReportsMutex};
+        if (reportIndex < 0) {
+            throw std::out_of_range{"invalid report index passed to a forward-dynamic simulation"};
+        }
+        return m_Reports.getReport(static_cast<size_t>(reportIndex));
+    }
+
+    std::vector<SimulationReport> getSimulationReports(ptrdiff_t first, ptrdiff_t last) const
+    {
+        popReportsHACK();
+
+        if (first < 0 or last < first or static_cast<size_t>(last) > m_Reports.size()) {
+            throw std::out_of_range{"attempted to access a range of reports that is out of bounds"};
+        }
+        const auto begin = static_cast<size_t>(first);
+        const auto end = static_cast<size_t>(last);
+
+        std::vector<SimulationReport> rv;
+        rv.reserve(end - begin);
+
+        // care: this doesn't insert anything into the realized report cache, so that
+        // extracting values from many reports doesn't evict the reports that the UI is
+        // showing (and would have to rebuild + realize again next frame)
+        const auto modelLock = m_ModelState.lock();
+        for (size_t i = begin; i < end; ++i) {
+            const auto cached = rgs::find_if(m_RealizedReportCache, [i](const auto& p) { return p.first == i; });
+            if (cached != m_RealizedReportCache.end()) {
+                rv.push_back(cached->second);
+            }
+            else {
+                SimulationReport& report = rv.emplace_back(m_Reports.getReport(i));
+                modelLock->getModel().realizeReport(report.updStateHACK());
+            }
+        }
+        return rv;
     }
 
     std::vector<SimulationReport> getAllSimulationReports() const
+    {
+        return getSimulationReports(0, getNumReports());
+    }
+
+    SimulationClock::time_point getSimulationReportTime(ptrdiff_t reportIndex) const
     {
         popReportsHACK();
-        return m_Reports;
+        return m_Reports.getTime(static_cast<size_t>(reportIndex));
     }
 
     SimulationStatus getStatus() const
@@ -111,7 +221,7 @@ public:
         popReportsHACK();
 
         if (not m_Reports.empty()) {
-            return SimulationClock::start() + SimulationClock::duration{m_Reports.back().getState().getTime()};
+            return m_Reports.getTime(m_Reports.size() - 1);
         }
         else {
             return getStartTime();
@@ -152,13 +262,11 @@ public:
 
         // if necessary, truncate any dangling reports
         if (new_end_time < old_end_time and not m_Reports.empty()) {
-
-            const auto reportBeforeOrEqualToNewEndTime = [new_end_time](const SimulationReport& r)
-            {
-                return r.getTime() <= new_end_time;
-            };
-            const auto it = find_if(m_Reports.rbegin(), m_Reports.rend(), reportBeforeOrEqualToNewEndTime);
-            m_Reports.erase(it.base(), m_Reports.end());
+            size_t newSize = m_Reports.size();
+            while (newSize > 0 and m_Reports.getTime(newSize - 1) > new_end_time) {
+                --newSize;
+            }
+            truncateReports(newSize);
         }
 
         // update the simulation parameters to reflect the new end-time
@@ -169,26 +277,16 @@ public:
 
         // edge-case: if the latest available report has an end-time equal to `t`, then
         // our work is complete
-        if (not m_Reports.empty() and m_Reports.back().getTime() == new_end_time) {
+        if (not m_Reports.empty() and m_Reports.getTime(m_Reports.size() - 1) == new_end_time) {
             return;
         }
 
-        // otherwise, create a new simulator with the new parameters
-        {
-            const auto guard = m_ModelState.lock();
-            const SimTK::State& latestState = m_Reports.empty() ?
-                guard->getState() :
-                m_Reports.back().getState();
-
-            m_Simulation = MakeSimulation(
-                BasicModelStatePair{guard->getModel(), latestState},
-                m_Params,
-                m_ReportQueue
-            );
-
-            // note: the report collection method should ensure that double-reports
-            // aren't collected
-        }
+        // otherwise, create a new simulator with the new parameters that continues
+        // from the latest report
+        //
+        // note: the report collection method should ensure that double-reports
+        // aren't collected
+        startSimulatorFromLatestReport();
     }
 
     void requestStop()
@@ -201,6 +299,32 @@ public:
         m_Simulation.stop();
     }
 
+    bool canResume() const
+    {
+        return m_Simulation.getStatus() == SimulationStatus::Cancelled and getCurTime() < m_Params.finalTime;
+    }
+
+    void resume()
+    {
+        if (not canResume()) {
+            return;
+        }
+
+        stop();
+        popReportsHACK();
+        startSimulatorFromLatestReport();
+    }
+
+    std::optional<SimulationCheckpoint> getLatestCheckpoint() const
+    {
+        // care: get the report before locking the model
+        const std::optional<SimulationReport> latestReport = getLatestReport();
+        if (not latestReport) {
+            return std::nullopt;
+        }
+        return CreateSimulationCheckpoint(m_ModelState.lock()->getModel(), latestReport->getState(), m_Params);
+    }
+
     float getFixupScaleFactor() const
     {
         return m_ModelState.lock()->getFixupScaleFactor();
@@ -212,54 +336,99 @@ public:
     }
 
 private:
+    void truncateReports(size_t newSize)
+    {
+        {
+            const std::lock_guard lock{m_ReportsMutex};
+            m_Reports.truncate(newSize);
+        }
+        std::erase_if(m_RealizedReportCache, [newSize](const auto& p) { return p.first >= newSize; });
+        if (m_Reports.empty() or (m_LatestReport and m_LatestReport->getTime() != m_Reports.getTime(m_Reports.size() - 1))) {
+            m_LatestReport.reset();
+        }
+    }
+
+    // returns the latest report, if any
+    //
+    // where possible, this returns the report exactly as it was emitted by the simulator
+    // (i.e. with its full-precision state, including non-continuous state variables), so
+    // that restarting a simulation from it is equivalent to never having stopped it
+    std::optional<SimulationReport> getLatestReport() const
+    {
+        popReportsHACK();
+
+        if (m_LatestReport) {
+            return m_LatestReport;
+        }
+        else if (not m_Reports.empty()) {
+            return m_Reports.getReport(m_Reports.size() - 1);
+        }
+        else {
+            return std::nullopt;
+        }
+    }
+
+    // (re)starts the simulator from the latest report (or the initial state, if there
+    // are no reports) with the current simulation parameters
+    //
+    // the current simulator must be stopped before calling this
+    void startSimulatorFromLatestReport()
+    {
+        // care: get the report before locking the model
+        const std::optional<SimulationReport> latestReport = getLatestReport();
+
+        const auto guard = m_ModelState.lock();
+        const SimTK::State& latestState = latestReport ?
+            latestReport->getState() :
+            guard->getState();
+
+        m_Simulation = MakeSimulation(
+            BasicModelStatePair{guard->getModel(), latestState},
+            m_Params,
+            m_ReportQueue
+        );
+    }
+
     // MUST be done from the UI thread
     //
     // the reason this insane hack is necessary is because the background thread
     // requires access to the UI thread's copy of the model in order to perform
     // the realization step
-    void popReportsHACK() const
+    //
+    // note: reports aren't realized here: they're realized (on the UI model) when
+    // they are rebuilt from the report store by `getSimulationReport`
+    //
+    // returns the number of reports that were popped from the report queue
+    size_t popReportsHACK() const
     {
-        auto& reports = const_cast<std::vector<SimulationReport>&>(m_Reports);
+        auto& reports = const_cast<SimulationReportSequence&>(m_Reports);
 
         // handle double-reporting (e.g. due to `requestNewEndTime`) by checking
         // the time of each incoming reports against the latest already collected
         std::optional<SimulationClock::time_point> latestReportTime;
         if (not reports.empty()) {
-            latestReportTime = reports.back().getTime();
+            latestReportTime = reports.getTime(reports.size() - 1);
         }
 
-        const size_t nReportsBefore = reports.size();
-        size_t nAdded = 0;
-
-        // pop them onto the local reports queue
+        // drain them, in one batch, onto the local (columnar) report store, while
+        // keeping the latest report at full precision
+        const std::lock_guard lock{m_ReportsMutex};
+        return m_ReportQueue->drain([this, &reports, &latestReportTime](SimulationReport&& report)
         {
-            auto guard = const_cast<SynchronizedValue<std::vector<SimulationReport>>&>(m_ReportQueue).lock();
-            reports.reserve(reports.size() + guard->size());
-            for (SimulationReport& report : *guard) {
-                if (report.getTime() == latestReportTime) {
-                    continue;  // filter out duplicate reports (e.g. due to `requestNewEndTime`)
-                }
-
-                reports.push_back(std::move(report));
-                ++nAdded;
+            if (report.getTime() == latestReportTime) {
+                return;  // filter out duplicate reports (e.g. due to `requestNewEndTime`)
             }
-            guard->clear();
-        }
-
-        if (nAdded <= 0) {
-            return;
-        }
-
-        // ensure all reports are realized on the UI model
-        auto modelLock = m_ModelState.lock();
-        for (auto it = reports.begin() + nReportsBefore; it != reports.end(); ++it) {
-            modelLock->getModel().realizeReport(it->updStateHACK());
-        }
+            reports.push_back(report);
+            m_LatestReport = std::move(report);
+        });
     }
 
     SynchronizedValue<BasicModelStatePair> m_ModelState;
-    SynchronizedValue<std::vector<SimulationReport>> m_ReportQueue;
-    std::vector<SimulationReport> m_Reports;
+    std::shared_ptr<SimulationReportQueue> m_ReportQueue = std::make_shared<SimulationReportQueue>(c_ReportQueueCapacity);
+    SimulationReportSequence m_Reports;  // only written by the UI thread, under `m_ReportsMutex`
+    mutable std::mutex m_ReportsMutex;  // guards `m_Reports` against readers on other threads (see `getUnrealizedSimulationReport`)
+    mutable std::vector<std::pair<size_t, SimulationReport>> m_RealizedReportCache;  // LRU (back == most recently used)
+    mutable std::optional<SimulationReport> m_LatestReport;  // latest collected report, as emitted by the simulator
     ForwardDynamicSimulator m_Simulation;
     ForwardDynamicSimulatorParams m_Params;
     ParamBlock m_ParamsAsParamBlock;
@@ -279,6 +448,11 @@ void osc::ForwardDynamicSimulation::join()
     m_Impl->join();
 }
 
+size_t osc::ForwardDynamicSimulation::implPollNewReports()
+{
+    return m_Impl->pollNewReports();
+}
+
 SynchronizedValueGuard<const OpenSim::Model> osc::ForwardDynamicSimulation::implGetModel() const
 {
     return m_Impl->getModel();
@@ -289,16 +463,36 @@ ptrdiff_t osc::ForwardDynamicSimulation::implGetNumReports() const
     return m_Impl->getNumReports();
 }
 
+UID osc::ForwardDynamicSimulation::implGetReportsGeneration() const
+{
+    return m_Impl->getReportsGeneration();
+}
+
 SimulationReport osc::ForwardDynamicSimulation::implGetSimulationReport(ptrdiff_t reportIndex) const
 {
     return m_Impl->getSimulationReport(reportIndex);
 }
 
+SimulationReport osc::ForwardDynamicSimulation::implGetUnrealizedSimulationReport(ptrdiff_t reportIndex) const
+{
+    return m_Impl->getUnrealizedSimulationReport(reportIndex);
+}
+
+std::vector<SimulationReport> osc::ForwardDynamicSimulation::implGetSimulationReports(ptrdiff_t first, ptrdiff_t last) const
+{
+    return m_Impl->getSimulationReports(first, last);
+}
+
 std::vector<SimulationReport> osc::ForwardDynamicSimulation::implGetAllSimulationReports() const
 {
     return m_Impl->getAllSimulationReports();
 }
 
+SimulationClock::time_point osc::ForwardDynamicSimulation::implGetSimulationReportTime(ptrdiff_t reportIndex) const
+{
+    return m_Impl->getSimulationReportTime(reportIndex);
+}
+
 SimulationStatus osc::ForwardDynamicSimulation::implGetStatus() const
 {
     return m_Impl->getStatus();
@@ -334,6 +528,21 @@ void osc::ForwardDynamicSimulation::implStop()
     return m_Impl->stop();
 }
 
+bool osc::ForwardDynamicSimulation::implCanResume() const
+{
+    return m_Impl->canResume();
+}
+
+void osc::ForwardDynamicSimulation::implResume()
+{
+    m_Impl->resume();
+}
+
+std::optional<SimulationCheckpoint> osc::ForwardDynamicSimulation::implGetLatestCheckpoint() const
+{
+    return m_Impl->getLatestCheckpoint();
+}
+
 float osc::ForwardDynamicSimulation::implGetFixupScaleFactor() const
 {
     return m_Impl->getFixupScaleFactor();
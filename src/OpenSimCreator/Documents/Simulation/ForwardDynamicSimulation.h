@@ -2,14 +2,17 @@
 
 #include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
 #include <OpenSimCreator/Documents/Simulation/ISimulation.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationCheckpoint.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
 
 #include <oscar/Utils/SynchronizedValueGuard.h>
+#include <oscar/Utils/UID.h>
 
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <span>
 #include <vector>
 
@@ -32,13 +35,21 @@ namespace osc
         ~ForwardDynamicSimulation() noexcept;
 
         // blocks the current thread until the simulator thread finishes its execution
+        //
+        // reports are collected from the simulator thread while waiting
         void join();
     private:
         SynchronizedValueGuard<const OpenSim::Model> implGetModel() const final;
 
+        size_t implPollNewReports() final;
+
         ptrdiff_t implGetNumReports() const final;
+        UID implGetReportsGeneration() const final;
         SimulationReport implGetSimulationReport(ptrdiff_t) const final;
+        SimulationReport implGetUnrealizedSimulationReport(ptrdiff_t) const final;
+        std::vector<SimulationReport> implGetSimulationReports(ptrdiff_t, ptrdiff_t) const final;
         std::vector<SimulationReport> implGetAllSimulationReports() const final;
+        SimulationClock::time_point implGetSimulationReportTime(ptrdiff_t) const final;
 
         SimulationStatus implGetStatus() const final;
         SimulationClocks implGetClocks() const final;
@@ -50,6 +61,9 @@ namespace osc
 
         void implRequestStop() final;
         void implStop() final;
+        bool implCanResume() const final;
+        void implResume() final;
+        std::optional<SimulationCheckpoint> implGetLatestCheckpoint() const final;
 
         float implGetFixupScaleFactor() const final;
         void implSetFixupScaleFactor(float) final;
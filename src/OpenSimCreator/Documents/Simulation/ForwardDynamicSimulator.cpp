@@ -17,6 +17,7 @@
 #include <oscar/Shims/Cpp20/stop_token.h>
 #include <oscar/Shims/Cpp20/thread.h>
 #include <oscar/Utils/HashHelpers.h>
+#include <oscar/Utils/SpscRingBuffer.h>
 #include <oscar/Utils/UID.h>
 #include <simmath/Integrator.h>
 #include <simmath/TimeStepper.h>
@@ -26,12 +27,11 @@
 #include <chrono>
 #include <cstddef>
 #include <exception>
-#include <functional>
 #include <memory>
 #include <optional>
 #include <span>
 #include <string>
-#include <unordered_map>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -54,27 +54,84 @@ namespace
         return s_StepDurationUID;
     }
 
+    UID GetReportQueueDepthUID()
+    {
+        static const UID s_ReportQueueDepthUID;
+        return s_ReportQueueDepthUID;
+    }
+
+    UID GetReportQueueStallTimeUID()
+    {
+        static const UID s_ReportQueueStallTimeUID;
+        return s_ReportQueueStallTimeUID;
+    }
+
+    UID GetReportCreationTimeUID()
+    {
+        static const UID s_ReportCreationTimeUID;
+        return s_ReportCreationTimeUID;
+    }
+
+    // how long the simulator thread sleeps between attempts to push a report into a full report queue
+    constexpr std::chrono::microseconds c_ReportQueueFullBackoff{200};
+
+    // instrumentation of the simulator thread (e.g. its report queue)
+    struct SimulatorThreadStats final {
+        size_t reportQueueDepth = 0;
+        std::chrono::duration<float> totalReportQueueStallTime{};
+        std::chrono::duration<float> totalReportCreationTime{};
+    };
+
     // exclusively owned input data
     class SimulatorThreadInput final {
     public:
         SimulatorThreadInput(BasicModelStatePair modelState,
                              const ForwardDynamicSimulatorParams& params,
-                             std::function<void(SimulationReport)> onReportFromBgThread) :
+                             std::shared_ptr<SimulationReportQueue> reportQueue) :
             m_ModelState{std::move(modelState)},
             m_Params{params},
-            m_ReportCallback{std::move(onReportFromBgThread)}
+            m_ReportQueue{std::move(reportQueue)}
         {
         }
 
         const SimTK::MultibodySystem& getMultiBodySystem() const { return m_ModelState.getModel().getMultibodySystem(); }
         const SimTK::State& getState() const { return m_ModelState.getState(); }
         const ForwardDynamicSimulatorParams& getParams() const { return m_Params; }
-        void emitReport(SimulationReport report) { m_ReportCallback(std::move(report)); }
+
+        SimulatorThreadStats getStats() const
+        {
+            return SimulatorThreadStats{m_ReportQueue->size_approx(), m_TotalStallTime, m_TotalReportCreationTime};
+        }
+
+        void addReportCreationTime(std::chrono::duration<float> duration)
+        {
+            m_TotalReportCreationTime += duration;
+        }
+
+        // pushes the report into the report queue, waiting for the consumer to make space
+        // in the queue if it's full (backpressure)
+        //
+        // the report is dropped if a stop is requested while waiting
+        void emitReport(const cpp20::stop_token& stopToken, SimulationReport report)
+        {
+            // note: `try_push` doesn't move from the report if the queue is full
+            if (m_ReportQueue->try_push(std::move(report))) {
+                return;  // fast path: there was space in the queue
+            }
+
+            const auto tStallStart = std::chrono::high_resolution_clock::now();
+            while (not m_ReportQueue->try_push(std::move(report)) and not stopToken.stop_requested()) {  // NOLINT(bugprone-use-after-move)
+                std::this_thread::sleep_for(c_ReportQueueFullBackoff);
+            }
+            m_TotalStallTime += std::chrono::high_resolution_clock::now() - tStallStart;
+        }
 
     private:
         BasicModelStatePair m_ModelState;
         ForwardDynamicSimulatorParams m_Params;
-        std::function<void(SimulationReport)> m_ReportCallback;
+        std::shared_ptr<SimulationReportQueue> m_ReportQueue;
+        std::chrono::duration<float> m_TotalStallTime{};
+        std::chrono::duration<float> m_TotalReportCreationTime{};
     };
 
     // data that's shared with the UI thread
@@ -93,6 +150,9 @@ namespace
         std::atomic<int> m_Status = static_cast<int>(SimulationStatus::Initializing);
     };
 
+    // the value that's emitted for an auxiliary variable that a report doesn't have
+    constexpr float c_MissingAuxiliaryValue = -1337.0f;
+
     class AuxiliaryVariableOutputExtractor final : public IOutputExtractor {
     public:
         AuxiliaryVariableOutputExtractor(std::string name, std::string description, UID uid) :
@@ -121,10 +181,18 @@ namespace
         {
             return OutputValueExtractor{[id = m_UID](const SimulationReport& report)
             {
-                return Variant{report.getAuxiliaryValue(id).value_or(-1337.0f)};
+                return Variant{report.getAuxiliaryValue(id).value_or(c_MissingAuxiliaryValue)};
             }};
         }
 
+        void implGetValuesFloat(
+            const OpenSim::Component&,
+            std::span<const SimulationReport> reports,
+            std::span<float> out) const final
+        {
+            CopyAuxiliaryValues(reports, m_UID, out, c_MissingAuxiliaryValue);
+        }
+
         std::size_t implGetHash() const final
         {
             return hash_of(m_Name, m_Description, m_UID);
@@ -157,7 +225,7 @@ namespace
     std::vector<OutputExtractor> CreateSimulatorOutputExtractors()
     {
         std::vector<OutputExtractor> rv;
-        rv.reserve(static_cast<size_t>(2) + GetNumIntegratorOutputExtractors() + GetNumMultiBodySystemOutputExtractors());
+        rv.reserve(static_cast<size_t>(5) + GetNumIntegratorOutputExtractors() + GetNumMultiBodySystemOutputExtractors());
 
         {
             OutputExtractor out{AuxiliaryVariableOutputExtractor{
@@ -173,6 +241,27 @@ namespace
                 GetStepDurationUID(),
             }};
             rv.push_back(out2);
+
+            OutputExtractor out3{AuxiliaryVariableOutputExtractor{
+                "Report Queue Depth",
+                "How many reports were waiting in the simulator's report queue (i.e. not yet collected by the UI) when this report was emitted",
+                GetReportQueueDepthUID(),
+            }};
+            rv.push_back(out3);
+
+            OutputExtractor out4{AuxiliaryVariableOutputExtractor{
+                "Report Queue Stall Time",
+                "Total cumulative time that the simulator spent waiting for space in a full report queue",
+                GetReportQueueStallTimeUID(),
+            }};
+            rv.push_back(out4);
+
+            OutputExtractor out5{AuxiliaryVariableOutputExtractor{
+                "Report Creation Time",
+                "Total cumulative time that the simulator spent creating reports (e.g. copying the state), excluding the report that this value is in",
+                GetReportCreationTimeUID(),
+            }};
+            rv.push_back(out5);
         }
 
         for (int i = 0, len = GetNumIntegratorOutputExtractors(); i < len; ++i)
@@ -215,52 +304,81 @@ namespace
         return SimulationClock::time_point(SimulationClock::duration(integ.getTime()));
     }
 
+    // returns the `UID` of each auxiliary value in a report that's emitted by the simulator
+    //
+    // all emitted reports share this (immutable) layout, so that each report only has to
+    // store a dense array of auxiliary values
+    std::shared_ptr<const std::vector<UID>> CreateSimulationReportAuxiliaryValueIDs()
+    {
+        std::vector<UID> rv;
+        rv.reserve(static_cast<size_t>(5) + GetNumIntegratorOutputExtractors() + GetNumMultiBodySystemOutputExtractors());
+
+        // forward dynamic simulator outputs
+        rv.push_back(GetWalltimeUID());
+        rv.push_back(GetStepDurationUID());
+        rv.push_back(GetReportQueueDepthUID());
+        rv.push_back(GetReportQueueStallTimeUID());
+        rv.push_back(GetReportCreationTimeUID());
+
+        // integrator outputs
+        for (int i = 0, len = GetNumIntegratorOutputExtractors(); i < len; ++i) {
+            rv.push_back(GetIntegratorOutputExtractor(i).getAuxiliaryDataID());
+        }
+
+        // mbs outputs
+        for (int i = 0, len = GetNumMultiBodySystemOutputExtractors(); i < len; ++i) {
+            rv.push_back(GetMultiBodySystemOutputExtractor(i).getAuxiliaryDataID());
+        }
+
+        return std::make_shared<const std::vector<UID>>(std::move(rv));
+    }
+
+    const std::shared_ptr<const std::vector<UID>>& GetSimulationReportAuxiliaryValueIDs()
+    {
+        static const std::shared_ptr<const std::vector<UID>> s_IDs = CreateSimulationReportAuxiliaryValueIDs();
+        return s_IDs;
+    }
+
     SimulationReport CreateSimulationReport(
         std::chrono::duration<float> wallTime,
         std::chrono::duration<float> stepDuration,
+        const SimulatorThreadStats& stats,
         const SimTK::MultibodySystem& sys,
         const SimTK::Integrator& integrator)
     {
         SimTK::State st = integrator.getState();
-        std::unordered_map<UID, float> auxValues;
 
         // care: state needs to be realized on the simulator thread
         st.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
 
+        // care: must be populated in the same order as `CreateSimulationReportAuxiliaryValueIDs`
+        const std::shared_ptr<const std::vector<UID>>& ids = GetSimulationReportAuxiliaryValueIDs();
+        std::vector<float> auxValues;
+        auxValues.reserve(ids->size());
+
         // populate forward dynamic simulator outputs
-        {
-            auxValues.emplace(GetWalltimeUID(), wallTime.count());
-            auxValues.emplace(GetStepDurationUID(), stepDuration.count());
-        }
+        auxValues.push_back(wallTime.count());
+        auxValues.push_back(stepDuration.count());
+        auxValues.push_back(static_cast<float>(stats.reportQueueDepth));
+        auxValues.push_back(stats.totalReportQueueStallTime.count());
+        auxValues.push_back(stats.totalReportCreationTime.count());
 
         // populate integrator outputs
-        {
-            int numOutputs = GetNumIntegratorOutputExtractors();
-            auxValues.reserve(auxValues.size() + numOutputs);
-            for (int i = 0; i < numOutputs; ++i)
-            {
-                const IntegratorOutputExtractor& o = GetIntegratorOutputExtractor(i);
-                auxValues.emplace(o.getAuxiliaryDataID(), o.getExtractorFunction()(integrator));
-            }
+        for (int i = 0, len = GetNumIntegratorOutputExtractors(); i < len; ++i) {
+            auxValues.push_back(GetIntegratorOutputExtractor(i).getExtractorFunction()(integrator));
         }
 
         // populate mbs outputs
-        {
-            int numOutputs = GetNumMultiBodySystemOutputExtractors();
-            auxValues.reserve(auxValues.size() + numOutputs);
-            for (int i = 0; i < numOutputs; ++i)
-            {
-                const MultiBodySystemOutputExtractor& o = GetMultiBodySystemOutputExtractor(i);
-                auxValues.emplace(o.getAuxiliaryDataID(), o.getExtractorFunction()(sys));
-            }
+        for (int i = 0, len = GetNumMultiBodySystemOutputExtractors(); i < len; ++i) {
+            auxValues.push_back(GetMultiBodySystemOutputExtractor(i).getExtractorFunction()(sys));
         }
 
-        return SimulationReport{std::move(st), std::move(auxValues)};
+        return SimulationReport{std::move(st), ids, std::move(auxValues)};
     }
 
     // this is the main function that the simulator thread works through (unguarded against exceptions)
     SimulationStatus FdSimulationMainUnguarded(
-        cpp20::stop_token stopToken,
+        const cpp20::stop_token& stopToken,
         SimulatorThreadInput& input,
         SharedState& shared)
     {
@@ -276,13 +394,22 @@ namespace
         ts.initialize(integ->getState());
         ts.setReportAllSignificantStates(true);  // so that cancellations/interrupts work
 
+        // creates + emits a report, keeping track of how long creating it took
+        const auto emitReport = [&stopToken, &input, &integ](std::chrono::duration<float> wallDur, std::chrono::duration<float> stepDur)
+        {
+            const auto tCreationStart = std::chrono::high_resolution_clock::now();
+            SimulationReport report = CreateSimulationReport(wallDur, stepDur, input.getStats(), input.getMultiBodySystem(), *integ);
+            input.addReportCreationTime(std::chrono::high_resolution_clock::now() - tCreationStart);
+            input.emitReport(stopToken, std::move(report));
+        };
+
         // inform observers that everything has been initialized and the sim is now running
         shared.setStatus(SimulationStatus::Running);
 
         // immediately report t = start
         {
             std::chrono::duration<float> wallDur = std::chrono::high_resolution_clock::now() - tSimStart;
-            input.emitReport(CreateSimulationReport(wallDur, {}, input.getMultiBodySystem(), *integ));
+            emitReport(wallDur, {});
         }
 
         // integrate (t0..tfinal]
@@ -318,7 +445,7 @@ namespace
                 // report the step and continue
                 std::chrono::duration<float> wallDur = tStepEnd - tSimStart;
                 std::chrono::duration<float> stepDur = tStepEnd - tStepStart;
-                input.emitReport(CreateSimulationReport(wallDur, stepDur, input.getMultiBodySystem(), *integ));
+                emitReport(wallDur, stepDur);
                 tLastReport = GetSimulationTime(*integ);
                 ++step;
                 continue;
@@ -333,7 +460,7 @@ namespace
                 {
                     std::chrono::duration<float> wallDur = tStepEnd - tSimStart;
                     std::chrono::duration<float> stepDur = tStepEnd - tStepStart;
-                    input.emitReport(CreateSimulationReport(wallDur, stepDur, input.getMultiBodySystem(), *integ));
+                    emitReport(wallDur, stepDur);
                     tLastReport = t;
                 }
                 break;
@@ -359,7 +486,7 @@ namespace
 
         try
         {
-            status = FdSimulationMainUnguarded(std::move(stopToken), *input, *shared);
+            status = FdSimulationMainUnguarded(stopToken, *input, *shared);
         }
         catch (const OpenSim::Exception& ex)
         {
@@ -384,7 +511,7 @@ class osc::ForwardDynamicSimulator::Impl final {
 public:
     Impl(BasicModelStatePair modelState,
         const ForwardDynamicSimulatorParams& params,
-        std::function<void(SimulationReport)> onReportFromBgThread) :
+        std::shared_ptr<SimulationReportQueue> reportQueue) :
 
         m_SimulationParams{params},
         m_Shared{std::make_shared<SharedState>()},
@@ -393,7 +520,7 @@ public:
             FdSimulationMain,
             std::make_unique<SimulatorThreadInput>(std::move(modelState),
                                                    params,
-                                                   std::move(onReportFromBgThread)),
+                                                   std::move(reportQueue)),
             m_Shared
         }
     {
@@ -451,9 +578,9 @@ OutputExtractor osc::GetFdSimulatorOutputExtractor(int idx)
 osc::ForwardDynamicSimulator::ForwardDynamicSimulator(
     BasicModelStatePair msp,
     const ForwardDynamicSimulatorParams& params,
-    std::function<void(SimulationReport)> onReportFromBgThread) :
+    std::shared_ptr<SimulationReportQueue> reportQueue) :
 
-    m_Impl{std::make_unique<Impl>(std::move(msp), params, std::move(onReportFromBgThread))}
+    m_Impl{std::make_unique<Impl>(std::move(msp), params, std::move(reportQueue))}
 {}
 osc::ForwardDynamicSimulator::ForwardDynamicSimulator(ForwardDynamicSimulator&&) noexcept = default;
 osc::ForwardDynamicSimulator& osc::ForwardDynamicSimulator::operator=(ForwardDynamicSimulator&&) noexcept = default;
@@ -2,13 +2,14 @@
 
 #include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
 #include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
 
-#include <functional>
+#include <oscar/Utils/SpscRingBuffer.h>
+
 #include <memory>
 
 namespace osc { struct ForwardDynamicSimulatorParams; }
-namespace osc { class SimulationReport; }
 
 namespace osc
 {
@@ -17,17 +18,21 @@ namespace osc
     int GetNumFdSimulatorOutputExtractors();
     OutputExtractor GetFdSimulatorOutputExtractor(int);
 
+    // a bounded, lock-free, queue that a `ForwardDynamicSimulator` pushes its reports into
+    using SimulationReportQueue = SpscRingBuffer<SimulationReport>;
+
     // a forward-dynamic simulation that immediately starts running on a background thread
     class ForwardDynamicSimulator final {
     public:
         // immediately starts the simulation upon construction
         //
-        // care: the callback is called *on the bg thread* - you should know how
-        //       to handle it (e.g. mutexes) appropriately
+        // reports are pushed into `reportQueue` from the bg thread, so the caller should
+        // be the queue's only consumer. If the queue is full, the simulator waits until
+        // the consumer pops reports from it (backpressure), or until a stop is requested
         ForwardDynamicSimulator(
             BasicModelStatePair,
             const ForwardDynamicSimulatorParams&,
-            std::function<void(SimulationReport)> onReportFromBgThread
+            std::shared_ptr<SimulationReportQueue> reportQueue
         );
         ForwardDynamicSimulator(const ForwardDynamicSimulator&) = delete;
         ForwardDynamicSimulator(ForwardDynamicSimulator&&) noexcept;
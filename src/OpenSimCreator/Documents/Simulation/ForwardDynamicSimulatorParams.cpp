@@ -26,6 +26,8 @@ namespace
     constexpr CStringView c_IntegratorMaximumStepSizeDesc = "The maximum step size, in seconds, that the integrator must take during the simulation. Note: this is mostly only relevant for error-correct integrators that change their step size dynamically as the simulation runs";
     constexpr CStringView c_IntegratorAccuracyTitle = "Accuracy";
     constexpr CStringView c_IntegratorAccuracyDesc = "Target accuracy for the integrator. Mostly only relevant for error-controlled integrators that change their step size by comparing this accuracy value to measured integration error";
+    constexpr CStringView c_NumFullPrecisionReportsTitle = "Full-Precision Reports";
+    constexpr CStringView c_NumFullPrecisionReportsDesc = "The number of most-recent simulation reports that are kept in memory at full precision. Older reports are compacted into a slightly lossy, but much smaller, representation, which lets long-running simulations with small reporting intervals fit in memory.";
 }
 
 
@@ -35,7 +37,8 @@ osc::ForwardDynamicSimulatorParams::ForwardDynamicSimulatorParams() :
     integratorStepLimit{20000},
     integratorMinimumStepSize{1.0e-8},
     integratorMaximumStepSize{1.0},
-    integratorAccuracy{1.0e-5}
+    integratorAccuracy{1.0e-5},
+    numFullPrecisionReports{10000}
 {}
 
 ParamBlock osc::ToParamBlock(const ForwardDynamicSimulatorParams& p)
@@ -48,6 +51,7 @@ ParamBlock osc::ToParamBlock(const ForwardDynamicSimulatorParams& p)
     rv.pushParam(c_IntegratorMinimumStepSizeTitle, c_IntegratorMinimumStepSizeDesc, p.integratorMinimumStepSize.count());
     rv.pushParam(c_IntegratorMaximumStepSizeTitle, c_IntegratorMaximumStepSizeDesc, p.integratorMaximumStepSize.count());
     rv.pushParam(c_IntegratorAccuracyTitle, c_IntegratorAccuracyDesc, p.integratorAccuracy);
+    rv.pushParam(c_NumFullPrecisionReportsTitle, c_NumFullPrecisionReportsDesc, p.numFullPrecisionReports);
     return rv;
 }
 
@@ -82,5 +86,9 @@ ForwardDynamicSimulatorParams osc::FromParamBlock(const ParamBlock& b)
     {
         rv.integratorAccuracy = std::get<double>(*acc);
     }
+    if (auto numFull = b.findValue(c_NumFullPrecisionReportsTitle); numFull && std::holds_alternative<int>(*numFull))
+    {
+        rv.numFullPrecisionReports = std::get<int>(*numFull);
+    }
     return rv;
 }
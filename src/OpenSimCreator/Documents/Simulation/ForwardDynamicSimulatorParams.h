@@ -46,6 +46,12 @@ namespace osc
         // to improve accuracy (e.g. by taking many more steps)
         double integratorAccuracy;
 
+        // the number of (most-recent) reports that the simulation keeps at full precision
+        //
+        // older reports are compacted into a lossy, but much smaller, representation, so
+        // that long-running simulations with small reporting intervals can still fit in memory
+        int numFullPrecisionReports;
+
         friend bool operator==(const ForwardDynamicSimulatorParams&, const ForwardDynamicSimulatorParams&) = default;
     };
 
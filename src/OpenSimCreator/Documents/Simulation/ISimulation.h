@@ -1,13 +1,16 @@
 #pragma once
 
+#include <OpenSimCreator/Documents/Simulation/SimulationCheckpoint.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationClocks.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
 
 #include <oscar/Utils/SynchronizedValueGuard.h>
+#include <oscar/Utils/UID.h>
 
 #include <cstddef>
+#include <optional>
 #include <span>
 #include <vector>
 
@@ -45,21 +48,69 @@ namespace osc
             return implGetModel();
         }
 
+        // collects any reports that were produced (e.g. by a background thread) since the
+        // last call into the simulation, returning how many new reports were collected
+        //
+        // "live" simulations may stall if their reports aren't collected, so UI code
+        // should call this once per frame, even when the simulation isn't being shown
+        size_t pollNewReports()
+        {
+            return implPollNewReports();
+        }
+
         size_t getNumReports() const
         {
             return implGetNumReports();
         }
 
+        // returns an ID that changes whenever any of the simulation's existing reports are
+        // removed or replaced (e.g. because the simulation was truncated by changing its end
+        // time), but not when new reports are appended
+        //
+        // IDs are unique across simulations, so callers that cache values that were extracted
+        // from the first N reports can key their cache on `(getReportsGeneration(), N)`
+        UID getReportsGeneration() const
+        {
+            return implGetReportsGeneration();
+        }
+
         SimulationReport getSimulationReport(ptrdiff_t reportIndex) const
         {
             return implGetSimulationReport(reportIndex);
         }
 
+        // returns the (realized) reports in the range `[first, last)`
+        //
+        // unlike calling `getSimulationReport` for each report, this realizes each report
+        // once and doesn't go through (or evict) the reports that the simulation caches for
+        // the UI, so it's the preferred way of extracting values from many reports
+        std::vector<SimulationReport> getSimulationReports(ptrdiff_t first, ptrdiff_t last) const
+        {
+            return implGetSimulationReports(first, last);
+        }
+
+        // returns a new, *unrealized*, report that's rebuilt from the simulation's reports
+        //
+        // unlike `getSimulationReport`, this doesn't lock (or use) the simulation's model and
+        // doesn't collect new reports, so it can be called from any thread, including while
+        // the caller holds the guard that's returned by `getModel`. It's intended for workers
+        // that realize reports against their own copy of the model (e.g. when exporting)
+        SimulationReport getUnrealizedSimulationReport(ptrdiff_t reportIndex) const
+        {
+            return implGetUnrealizedSimulationReport(reportIndex);
+        }
+
         std::vector<SimulationReport> getAllSimulationReports() const
         {
             return implGetAllSimulationReports();
         }
 
+        // returns the time of the given report (can be cheaper than `getSimulationReport(i).getTime()`)
+        SimulationClock::time_point getSimulationReportTime(ptrdiff_t reportIndex) const
+        {
+            return implGetSimulationReportTime(reportIndex);
+        }
+
         SimulationStatus getStatus() const
         {
             return implGetStatus();
@@ -115,6 +166,26 @@ namespace osc
             implStop();
         }
 
+        // returns `true` if the simulation was stopped before reaching its end time and
+        // can be resumed from its latest report
+        bool canResume() const
+        {
+            return implCanResume();
+        }
+
+        void resume()
+        {
+            implResume();
+        }
+
+        // returns a checkpoint of the simulation's latest report, if the simulation supports it
+        //
+        // the checkpoint can be used to resume the simulation later (e.g. in another session)
+        std::optional<SimulationCheckpoint> getLatestCheckpoint() const
+        {
+            return implGetLatestCheckpoint();
+        }
+
         float getFixupScaleFactor() const
         {
             return implGetFixupScaleFactor();
@@ -128,9 +199,26 @@ namespace osc
     private:
         virtual SynchronizedValueGuard<const OpenSim::Model> implGetModel() const = 0;
 
+        virtual size_t implPollNewReports() { return 0; }  // only applicable for "live" simulations
+
         virtual ptrdiff_t implGetNumReports() const = 0;
+        virtual UID implGetReportsGeneration() const = 0;
         virtual SimulationReport implGetSimulationReport(ptrdiff_t) const = 0;
+        virtual SimulationReport implGetUnrealizedSimulationReport(ptrdiff_t) const = 0;
+        virtual std::vector<SimulationReport> implGetSimulationReports(ptrdiff_t first, ptrdiff_t last) const
+        {
+            std::vector<SimulationReport> rv;
+            rv.reserve(last > first ? static_cast<size_t>(last - first) : 0);
+            for (ptrdiff_t i = first; i < last; ++i) {
+                rv.push_back(implGetSimulationReport(i));
+            }
+            return rv;
+        }
         virtual std::vector<SimulationReport> implGetAllSimulationReports() const = 0;
+        virtual SimulationClock::time_point implGetSimulationReportTime(ptrdiff_t reportIndex) const
+        {
+            return implGetSimulationReport(reportIndex).getTime();
+        }
 
         virtual SimulationStatus implGetStatus() const = 0;
         virtual SimulationClocks implGetClocks() const = 0;
@@ -142,6 +230,9 @@ namespace osc
 
         virtual void implRequestStop() {}  // only applicable for "live" simulations
         virtual void implStop() {}  // only applicable for "live" simulations
+        virtual bool implCanResume() const { return false; }  // only applicable for "live" simulations
+        virtual void implResume() {}  // only applicable for "live" simulations
+        virtual std::optional<SimulationCheckpoint> implGetLatestCheckpoint() const { return std::nullopt; }  // only applicable for "live" simulations
 
         virtual float implGetFixupScaleFactor() const = 0;
         virtual void implSetFixupScaleFactor(float) = 0;
@@ -1,15 +1,18 @@
 #pragma once
 
 #include <OpenSimCreator/Documents/Simulation/ISimulation.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationCheckpoint.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
 
 #include <oscar/Utils/SynchronizedValueGuard.h>
+#include <oscar/Utils/UID.h>
 
 #include <concepts>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <span>
 #include <vector>
 
@@ -33,9 +36,14 @@ namespace osc
 
         SynchronizedValueGuard<const OpenSim::Model> getModel() const { return m_Simulation->getModel(); }
 
+        size_t pollNewReports() { return m_Simulation->pollNewReports(); }
         size_t getNumReports() const { return m_Simulation->getNumReports(); }
+        UID getReportsGeneration() const { return m_Simulation->getReportsGeneration(); }
         SimulationReport getSimulationReport(ptrdiff_t reportIndex) const { return m_Simulation->getSimulationReport(std::move(reportIndex)); }
+        std::vector<SimulationReport> getSimulationReports(ptrdiff_t first, ptrdiff_t last) const { return m_Simulation->getSimulationReports(first, last); }
+        SimulationReport getUnrealizedSimulationReport(ptrdiff_t reportIndex) const { return m_Simulation->getUnrealizedSimulationReport(reportIndex); }
         std::vector<SimulationReport> getAllSimulationReports() const { return m_Simulation->getAllSimulationReports(); }
+        SimulationClock::time_point getSimulationReportTime(ptrdiff_t reportIndex) const { return m_Simulation->getSimulationReportTime(reportIndex); }
 
         SimulationStatus getStatus() const { return m_Simulation->getStatus(); }
         SimulationClock::time_point getCurTime() { return m_Simulation->getCurTime(); }
@@ -50,6 +58,9 @@ namespace osc
 
         void requestStop() { m_Simulation->requestStop(); }
         void stop() { m_Simulation->stop(); }
+        bool canResume() const { return m_Simulation->canResume(); }
+        void resume() { m_Simulation->resume(); }
+        std::optional<SimulationCheckpoint> getLatestCheckpoint() const { return m_Simulation->getLatestCheckpoint(); }
 
         float getFixupScaleFactor() const { return m_Simulation->getFixupScaleFactor(); }
         void setFixupScaleFactor(float v) { m_Simulation->setFixupScaleFactor(v); }
@@ -0,0 +1,300 @@
+#include "SimulationCheckpoint.h"
+
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/IntegratorMethod.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+
+#include <OpenSim/Common/Array.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <SimTKcommon.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <ios>
+#include <istream>
+#include <limits>
+#include <locale>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // checkpoint files start with this line (magic + version)
+    constexpr std::string_view c_CheckpointHeader = "OSCCHECKPOINT 1";
+
+    // the key of the line that precedes the state variable lines
+    constexpr std::string_view c_StateVariablesKey = "stateVariables";
+
+    // splits `line` at its first space, into (key, rest of line)
+    std::pair<std::string_view, std::string_view> SplitAtFirstSpace(std::string_view line)
+    {
+        const auto pos = line.find(' ');
+        if (pos == std::string_view::npos) {
+            return {line, std::string_view{}};
+        }
+        return {line.substr(0, pos), line.substr(pos + 1)};
+    }
+
+    // the tokens that non-finite floating-point numbers are written as
+    //
+    // (written explicitly, because how a stream formats them is implementation-defined, and
+    // streams can't parse them back)
+    constexpr std::string_view c_NaNToken = "nan";
+    constexpr std::string_view c_PositiveInfinityToken = "inf";
+    constexpr std::string_view c_NegativeInfinityToken = "-inf";
+
+    // writes `v` to `out` such that `ParseNumber<double>` can parse it back
+    void WriteNumber(std::ostream& out, double v)
+    {
+        if (std::isnan(v)) {
+            out << c_NaNToken;
+        }
+        else if (std::isinf(v)) {
+            out << (v > 0.0 ? c_PositiveInfinityToken : c_NegativeInfinityToken);
+        }
+        else {
+            out << v;
+        }
+    }
+
+    // parses `str` as a number (locale-independent), or throws
+    template<typename T>
+    T ParseNumber(std::string_view str)
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (str == c_NaNToken) {
+                return std::numeric_limits<T>::quiet_NaN();
+            }
+            if (str == c_PositiveInfinityToken) {
+                return std::numeric_limits<T>::infinity();
+            }
+            if (str == c_NegativeInfinityToken) {
+                return -std::numeric_limits<T>::infinity();
+            }
+        }
+
+        std::istringstream ss{std::string{str}};
+        ss.imbue(std::locale::classic());
+        T rv{};
+        if (not (ss >> rv) or not (ss >> std::ws).eof()) {
+            std::stringstream msg;
+            msg << "cannot parse '" << str << "' as a number in a simulation checkpoint";
+            throw std::runtime_error{std::move(msg).str()};
+        }
+        return rv;
+    }
+
+    IntegratorMethod ParseIntegratorMethod(std::string_view label)
+    {
+        for (const IntegratorMethod method : IntegratorMethod::all()) {
+            if (std::string_view{method.label()} == label) {
+                return method;
+            }
+        }
+        std::stringstream msg;
+        msg << "'" << label << "' is not a known integrator method";
+        throw std::runtime_error{std::move(msg).str()};
+    }
+
+    // returns the value of the given key, or throws
+    std::string_view GetValue(const std::unordered_map<std::string, std::string>& kvs, std::string_view key)
+    {
+        if (const auto it = kvs.find(std::string{key}); it != kvs.end()) {
+            return it->second;
+        }
+        std::stringstream msg;
+        msg << "the simulation checkpoint doesn't contain a '" << key << "' entry";
+        throw std::runtime_error{std::move(msg).str()};
+    }
+
+    // the shortest possible state variable line is `0 x` (a value, a space, and a one-character name)
+    constexpr size_t c_MinStateVariableLineLength = 3;
+
+    // the maximum number of state variables that are reserved up-front when the size of
+    // the input can't be determined (e.g. because it isn't seekable)
+    constexpr size_t c_MaxStateVariablesReservedForUnsizedInputs = 1024;
+
+    // returns the number of bytes remaining in the input, or `std::nullopt` if the input
+    // isn't seekable
+    std::optional<size_t> TryGetNumRemainingBytes(std::istream& in)
+    {
+        const std::istream::pos_type current = in.tellg();
+        if (current == std::istream::pos_type(-1)) {
+            return std::nullopt;
+        }
+        in.seekg(0, std::ios::end);
+        const std::istream::pos_type end = in.tellg();
+        in.seekg(current);
+        if (end == std::istream::pos_type(-1) or end < current or not in) {
+            in.clear();
+            in.seekg(current);
+            return std::nullopt;
+        }
+        return static_cast<size_t>(end - current);
+    }
+}
+
+SimulationCheckpoint osc::CreateSimulationCheckpoint(
+    const OpenSim::Model& model,
+    const SimTK::State& state,
+    const ForwardDynamicSimulatorParams& params)
+{
+    SimulationCheckpoint rv;
+    rv.time = SimulationClock::start() + SimulationClock::duration{state.getTime()};
+    rv.params = params;
+
+    const OpenSim::Array<std::string> names = model.getStateVariableNames();
+    const SimTK::Vector values = model.getStateVariableValues(state);
+
+    rv.stateVariableNames.reserve(names.size());
+    rv.stateVariableValues.reserve(names.size());
+    for (int i = 0; i < names.size(); ++i) {
+        rv.stateVariableNames.push_back(names[i]);
+        rv.stateVariableValues.push_back(values[i]);
+    }
+    return rv;
+}
+
+void osc::ApplySimulationCheckpoint(
+    const SimulationCheckpoint& checkpoint,
+    const OpenSim::Model& model,
+    SimTK::State& state)
+{
+    if (checkpoint.stateVariableNames.size() != checkpoint.stateVariableValues.size()) {
+        throw std::runtime_error{"the simulation checkpoint has a different number of state variable names and values"};
+    }
+
+    // map the checkpoint's state variables onto the model's
+    const OpenSim::Array<std::string> modelNames = model.getStateVariableNames();
+    std::unordered_map<std::string, int> modelIndices;
+    modelIndices.reserve(modelNames.size());
+    for (int i = 0; i < modelNames.size(); ++i) {
+        modelIndices.try_emplace(modelNames[i], i);
+    }
+
+    SimTK::Vector values = model.getStateVariableValues(state);
+    for (size_t i = 0; i < checkpoint.stateVariableNames.size(); ++i) {
+        const auto it = modelIndices.find(checkpoint.stateVariableNames[i]);
+        if (it == modelIndices.end()) {
+            std::stringstream msg;
+            msg << "the simulation checkpoint contains a state variable, '" << checkpoint.stateVariableNames[i] << "', that isn't in the model: was the checkpoint taken from a different model?";
+            throw std::runtime_error{std::move(msg).str()};
+        }
+        values[it->second] = checkpoint.stateVariableValues[i];
+    }
+
+    state.setTime(checkpoint.time.time_since_epoch().count());
+    model.setStateVariableValues(state, values);
+}
+
+void osc::WriteSimulationCheckpoint(std::ostream& out, const SimulationCheckpoint& checkpoint)
+{
+    if (checkpoint.stateVariableNames.size() != checkpoint.stateVariableValues.size()) {
+        throw std::runtime_error{"the simulation checkpoint has a different number of state variable names and values"};
+    }
+
+    // write into a (locale-independent, full-precision) buffer first, so that the
+    // caller's stream settings aren't affected
+    std::ostringstream ss;
+    ss.imbue(std::locale::classic());
+    ss.precision(std::numeric_limits<double>::max_digits10);
+
+    const ForwardDynamicSimulatorParams& p = checkpoint.params;
+    ss << c_CheckpointHeader << '\n';
+    const auto writeNumberLine = [&ss](std::string_view key, double v)
+    {
+        ss << key << ' ';
+        WriteNumber(ss, v);
+        ss << '\n';
+    };
+    writeNumberLine("time", checkpoint.time.time_since_epoch().count());
+    writeNumberLine("finalTime", p.finalTime.time_since_epoch().count());
+    ss << "integratorMethod " << p.integratorMethodUsed.label() << '\n';
+    writeNumberLine("reportingInterval", p.reportingInterval.count());
+    ss << "integratorStepLimit " << p.integratorStepLimit << '\n';
+    writeNumberLine("integratorMinimumStepSize", p.integratorMinimumStepSize.count());
+    writeNumberLine("integratorMaximumStepSize", p.integratorMaximumStepSize.count());
+    writeNumberLine("integratorAccuracy", p.integratorAccuracy);
+    ss << "numFullPrecisionReports " << p.numFullPrecisionReports << '\n';
+    ss << c_StateVariablesKey << ' ' << checkpoint.stateVariableNames.size() << '\n';
+    for (size_t i = 0; i < checkpoint.stateVariableNames.size(); ++i) {
+        WriteNumber(ss, checkpoint.stateVariableValues[i]);
+        ss << ' ' << checkpoint.stateVariableNames[i] << '\n';
+    }
+
+    out << std::move(ss).str();
+    if (not out) {
+        throw std::runtime_error{"error writing a simulation checkpoint to the output stream"};
+    }
+}
+
+SimulationCheckpoint osc::ReadSimulationCheckpoint(std::istream& in)
+{
+    std::string line;
+    if (not std::getline(in, line) or line != c_CheckpointHeader) {
+        throw std::runtime_error{"the input is not a (supported) simulation checkpoint: it has an unrecognized header"};
+    }
+
+    // read `key value` lines up to (and including) the state variables line
+    std::unordered_map<std::string, std::string> kvs;
+    std::optional<size_t> numStateVariables;
+    while (not numStateVariables and std::getline(in, line)) {
+        const auto [key, value] = SplitAtFirstSpace(line);
+        if (key == c_StateVariablesKey) {
+            numStateVariables = ParseNumber<size_t>(value);
+        }
+        else if (not key.empty()) {
+            kvs.insert_or_assign(std::string{key}, std::string{value});
+        }
+    }
+    if (not numStateVariables) {
+        throw std::runtime_error{"the simulation checkpoint ended before its state variables"};
+    }
+
+    SimulationCheckpoint rv;
+    rv.time = SimulationClock::start() + SimulationClock::duration{ParseNumber<double>(GetValue(kvs, "time"))};
+    rv.params.finalTime = SimulationClock::start() + SimulationClock::duration{ParseNumber<double>(GetValue(kvs, "finalTime"))};
+    rv.params.integratorMethodUsed = ParseIntegratorMethod(GetValue(kvs, "integratorMethod"));
+    rv.params.reportingInterval = SimulationClock::duration{ParseNumber<double>(GetValue(kvs, "reportingInterval"))};
+    rv.params.integratorStepLimit = ParseNumber<int>(GetValue(kvs, "integratorStepLimit"));
+    rv.params.integratorMinimumStepSize = SimulationClock::duration{ParseNumber<double>(GetValue(kvs, "integratorMinimumStepSize"))};
+    rv.params.integratorMaximumStepSize = SimulationClock::duration{ParseNumber<double>(GetValue(kvs, "integratorMaximumStepSize"))};
+    rv.params.integratorAccuracy = ParseNumber<double>(GetValue(kvs, "integratorAccuracy"));
+    rv.params.numFullPrecisionReports = ParseNumber<int>(GetValue(kvs, "numFullPrecisionReports"));
+
+    // care: the number of state variables comes from the input, so it's checked against
+    // the size of the remaining input before anything is reserved
+    size_t numToReserve = std::min(*numStateVariables, c_MaxStateVariablesReservedForUnsizedInputs);
+    if (const std::optional<size_t> numRemainingBytes = TryGetNumRemainingBytes(in)) {
+        // (+1, because the last line might not have a trailing newline)
+        if (*numStateVariables > (*numRemainingBytes + 1) / (c_MinStateVariableLineLength + 1)) {
+            throw std::runtime_error{"the simulation checkpoint contains fewer state variables than it says it does: is it truncated or corrupt?"};
+        }
+        numToReserve = *numStateVariables;
+    }
+    rv.stateVariableNames.reserve(numToReserve);
+    rv.stateVariableValues.reserve(numToReserve);
+    for (size_t i = 0; i < *numStateVariables; ++i) {
+        if (not std::getline(in, line)) {
+            throw std::runtime_error{"the simulation checkpoint ended before all of its state variables were read"};
+        }
+        const auto [value, name] = SplitAtFirstSpace(line);
+        if (name.empty()) {
+            throw std::runtime_error{"the simulation checkpoint contains a state variable without a name"};
+        }
+        rv.stateVariableValues.push_back(ParseNumber<double>(value));
+        rv.stateVariableNames.emplace_back(name);
+    }
+    return rv;
+}
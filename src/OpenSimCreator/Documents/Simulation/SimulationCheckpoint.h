@@ -0,0 +1,57 @@
+#pragma once
+
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace OpenSim { class Model; }
+namespace SimTK { class State; }
+
+namespace osc
+{
+    // a full-precision snapshot of a forward-dynamic simulation at one point in time
+    //
+    // a checkpoint holds enough information to resume a simulation against the same
+    // model from where the checkpoint was taken (the time, all named state variable
+    // values, and the simulation's parameters). It does *not* hold the model itself,
+    // or any reports that were produced before the checkpoint was taken.
+    //
+    // state variables are stored by name (rather than by their index in the state), so
+    // that checkpoints can be written to disk and resumed in a later session
+    struct SimulationCheckpoint final {
+        SimulationClock::time_point time = SimulationClock::start();
+        ForwardDynamicSimulatorParams params;
+        std::vector<std::string> stateVariableNames;
+        std::vector<double> stateVariableValues;  // ordered the same as `stateVariableNames`
+
+        friend bool operator==(const SimulationCheckpoint&, const SimulationCheckpoint&) = default;
+    };
+
+    // returns a checkpoint of `state`, which must be a state of `model`
+    SimulationCheckpoint CreateSimulationCheckpoint(
+        const OpenSim::Model& model,
+        const SimTK::State& state,
+        const ForwardDynamicSimulatorParams&
+    );
+
+    // writes the checkpoint's time + state variable values into `state`, which must be a
+    // state of `model`
+    //
+    // throws if `model` doesn't have one of the checkpoint's state variables. State
+    // variables in the model that aren't in the checkpoint are left untouched
+    void ApplySimulationCheckpoint(
+        const SimulationCheckpoint&,
+        const OpenSim::Model& model,
+        SimTK::State& state
+    );
+
+    // writes/reads a checkpoint to/from a (line-based, human-readable) checkpoint file
+    //
+    // values are written with enough precision to be read back losslessly. Reading throws
+    // if the input isn't a checkpoint, or is malformed
+    void WriteSimulationCheckpoint(std::ostream&, const SimulationCheckpoint&);
+    SimulationCheckpoint ReadSimulationCheckpoint(std::istream&);
+}
@@ -1,50 +1,414 @@
 #include "SimulationHelpers.h"
 
 #include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/BinaryOutputs.h>
 #include <OpenSimCreator/Documents/Simulation/ISimulation.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
 
 #include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Maths/Vec2.h>
 #include <oscar/Utils/EnumHelpers.h>
+#include <oscar/Utils/ThreadPool.h>
+#include <oscar/Utils/UID.h>
 #include <Simbody.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <functional>
+#include <memory>
 #include <ostream>
 #include <span>
+#include <string>
+#include <utility>
+#include <vector>
 
-void osc::WriteOutputsAsCSV(
-    const OpenSim::Component& root,
-    std::span<const OutputExtractor> outputs,
-    std::span<const SimulationReport> reports,
-    std::ostream& out)
+using namespace osc;
+
+namespace
+{
+    // the minimum number of reports that each worker thread should extract
+    //
+    // parallelizing has a fixed up-front cost (each worker copies + initializes
+    // the model), so it's only worth it when there are many reports
+    constexpr size_t c_MinReportsPerWorker = 256;
+
+    // the maximum number of rows that are written per block of a binary outputs file
+    constexpr size_t c_MaxRowsPerBinaryBlock = 4096;
+
+    size_t NumColumnsFor(OutputExtractorDataType type)
+    {
+        static_assert(num_options<OutputExtractorDataType>() == 3);
+        return type == OutputExtractorDataType::Vec2 ? 2 : 1;
+    }
+
+    // the number of reports that a worker thread copies + realizes before extracting
+    // their outputs (column-by-column)
+    constexpr size_t c_NumReportsPerWorkerBatch = 256;
+
+    // writes the values of each output for `reports` into rows `[firstRow, firstRow + reports.size())`
+    // of `columns`, column-by-column, via the (typed) output extraction fast path
+    void ExtractRows(
+        const OpenSim::Model& model,
+        std::span<const OutputExtractor> outputs,
+        std::span<const SimulationReport> reports,
+        size_t firstRow,
+        std::span<std::vector<float>> columns)
+    {
+        size_t column = 0;
+        for (const OutputExtractor& output : outputs) {
+            if (output.getOutputType() == OutputExtractorDataType::Vec2) {
+                // extract in fixed-size chunks, which are then split into the two columns
+                std::array<Vec2, 64> buffer{};
+                for (size_t offset = 0; offset < reports.size(); offset += buffer.size()) {
+                    const size_t n = std::min(buffer.size(), reports.size() - offset);
+                    output.getValuesVec2(model, reports.subspan(offset, n), std::span<Vec2>{buffer.data(), n});
+                    for (size_t i = 0; i < n; ++i) {
+                        columns[column][firstRow + offset + i] = buffer[i].x;
+                        columns[column+1][firstRow + offset + i] = buffer[i].y;
+                    }
+                }
+                column += 2;
+            }
+            else {
+                output.getValuesFloat(model, reports, std::span<float>{columns[column]}.subspan(firstRow, reports.size()));
+                column += 1;
+            }
+        }
+    }
+
+    // returns a copy of `report` that has its own (independent) state, so that it
+    // can be realized against a different (but equivalent) model
+    SimulationReport CopyReportWithIndependentState(const SimulationReport& report)
+    {
+        const std::span<const UID> ids = report.getAuxiliaryValueIDs();
+        const std::span<const float> values = report.getAuxiliaryValues();
+        return SimulationReport{
+            SimTK::State{report.getState()},
+            std::make_shared<const std::vector<UID>>(ids.begin(), ids.end()),
+            std::vector<float>(values.begin(), values.end()),
+        };
+    }
+
+    // extracts rows `[begin, end)` on a worker thread, using the worker's own copy of the model
+    //
+    // `getUnrealizedReport` should return an unrealized report (with its own, independent, state)
+    // for the given row, which the worker then realizes against its copy of the model
+    void ExtractRowsWithModelCopy(
+        OpenSim::Model& modelCopy,
+        std::span<const OutputExtractor> outputs,
+        const std::function<SimulationReport(size_t)>& getUnrealizedReport,
+        size_t begin,
+        size_t end,
+        std::span<std::vector<float>> columns)
+    {
+        InitializeModel(modelCopy);
+        InitializeState(modelCopy);
+
+        std::vector<SimulationReport> batch;
+        batch.reserve(c_NumReportsPerWorkerBatch);
+        for (size_t batchBegin = begin; batchBegin < end; batchBegin += c_NumReportsPerWorkerBatch) {
+            const size_t batchEnd = std::min(batchBegin + c_NumReportsPerWorkerBatch, end);
+
+            batch.clear();
+            for (size_t row = batchBegin; row < batchEnd; ++row) {
+                SimulationReport& local = batch.emplace_back(getUnrealizedReport(row));
+                local.updStateHACK().invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+                modelCopy.realizeReport(local.updStateHACK());
+            }
+            ExtractRows(modelCopy, outputs, batch, batchBegin, columns);
+        }
+    }
+
+    // returns preallocated (zeroed) output columns for the given number of rows, so that
+    // workers only have to write into disjoint rows
+    std::vector<std::vector<float>> AllocateOutputColumns(std::span<const OutputExtractor> outputs, size_t numRows)
+    {
+        size_t numColumns = 0;
+        for (const OutputExtractor& output : outputs) {
+            numColumns += NumColumnsFor(output.getOutputType());
+        }
+        return std::vector<std::vector<float>>(numColumns, std::vector<float>(numRows));
+    }
+
+    size_t NumExtractionWorkersFor(size_t numReports)
+    {
+        return std::min<size_t>(
+            ThreadPool::global().num_workers() + 1,  // the calling thread also runs workers
+            numReports / c_MinReportsPerWorker
+        );
+    }
+
+    // runs `extractRows(workerIndex, begin, end)` for each worker's (contiguous) slice of
+    // `[0, numReports)` on the global thread pool (and the calling thread), and waits for
+    // all of them to finish
+    void RunExtractionWorkers(
+        size_t numWorkers,
+        size_t numReports,
+        const std::function<void(size_t, size_t, size_t)>& extractRows)
+    {
+        const size_t chunkSize = numReports / numWorkers;
+        ThreadPool::global().for_each_chunk(numWorkers, 1, [&](size_t firstWorker, size_t lastWorker)
+        {
+            for (size_t i = firstWorker; i < lastWorker; ++i) {
+                const size_t begin = i * chunkSize;
+                const size_t end = i == numWorkers-1 ? numReports : (i+1) * chunkSize;  // last worker handles the remainder
+                extractRows(i, begin, end);
+            }
+        });
+    }
+
+    void WriteColumnsAsCSV(
+        std::span<const OutputExtractor> outputs,
+        std::span<const double> times,
+        std::span<const std::vector<float>> columns,
+        std::ostream& out)
+    {
+        // header line
+        out << "time";
+        for (const std::string& columnName : GetOutputColumnNames(outputs)) {
+            out << ',' << columnName;
+        }
+        out << '\n';
+
+        // data lines
+        for (size_t row = 0; row < times.size(); ++row) {
+            out << times[row];  // time column
+            for (const std::vector<float>& column : columns) {
+                out << ',' << column[row];
+            }
+            out << '\n';
+        }
+    }
+
+    // writes the given rows as (one or more) blocks
+    //
+    // the columns are extracted in one pass (extraction has a fixed per-call cost), but
+    // written in bounded-size blocks
+    void WriteColumnsAsBinaryBlocks(
+        BinaryOutputsWriter& writer,
+        std::span<const double> times,
+        std::span<const std::vector<float>> columns)
+    {
+        std::vector<std::vector<float>> blockColumns(columns.size());
+        for (size_t begin = 0; begin < times.size(); begin += c_MaxRowsPerBinaryBlock) {
+            const size_t end = std::min(begin + c_MaxRowsPerBinaryBlock, times.size());
+            for (size_t column = 0; column < columns.size(); ++column) {
+                blockColumns[column].assign(columns[column].begin() + begin, columns[column].begin() + end);
+            }
+            writer.writeBlock(times.subspan(begin, end - begin), blockColumns);
+        }
+    }
+
+    void WriteColumnsAsBinary(
+        std::span<const OutputExtractor> outputs,
+        std::span<const double> times,
+        std::span<const std::vector<float>> columns,
+        std::ostream& out)
+    {
+        BinaryOutputsWriter writer{out, GetOutputColumnNames(outputs)};
+        WriteColumnsAsBinaryBlocks(writer, times, columns);
+    }
+
+    std::vector<double> GetReportTimes(std::span<const SimulationReport> reports)
+    {
+        std::vector<double> rv;
+        rv.reserve(reports.size());
+        for (const SimulationReport& report : reports) {
+            rv.push_back(report.getState().getTime());
+        }
+        return rv;
+    }
+
+    double GetReportTime(const ISimulation& simulation, size_t reportIndex)
+    {
+        return simulation.getSimulationReportTime(static_cast<ptrdiff_t>(reportIndex)).time_since_epoch().count();
+    }
+
+    // returns the times of the simulation's reports `[first, last)`
+    std::vector<double> GetReportTimes(const ISimulation& simulation, size_t first, size_t last)
+    {
+        std::vector<double> rv;
+        rv.reserve(last - first);
+        for (size_t i = first; i < last; ++i) {
+            rv.push_back(GetReportTime(simulation, i));
+        }
+        return rv;
+    }
+
+    // extracts the output columns of the simulation's reports `[first, last)`
+    //
+    // (a live simulation may collect more reports while this is running, so the caller
+    // decides which reports are extracted)
+    std::vector<std::vector<float>> ExtractOutputColumnsOfReports(
+        const ISimulation& simulation,
+        std::span<const OutputExtractor> outputs,
+        size_t first,
+        size_t last)
+    {
+        const size_t numReports = last - first;
+        std::vector<std::vector<float>> columns = AllocateOutputColumns(outputs, numReports);
+
+        const size_t numWorkers = NumExtractionWorkersFor(numReports);
+        if (numWorkers <= 1) {
+            // too few reports to be worth parallelizing: realize + extract them on this thread
+            //
+            // care: the reports must be acquired before locking the model, because acquiring
+            // reports may require (briefly) locking the model
+            const std::vector<SimulationReport> reports = simulation.getSimulationReports(static_cast<ptrdiff_t>(first), static_cast<ptrdiff_t>(last));
+            const auto model = simulation.getModel();
+            ExtractRows(*model, outputs, reports, 0, columns);
+            return columns;
+        }
+
+        // workers are only handed report indices: each worker copies the model itself (only
+        // locking the simulation's model while copying it), then rebuilds + realizes its own
+        // slice of the reports against its copy, so that none of that happens on this thread
+        const auto getUnrealizedReport = [&simulation, first](size_t row)
+        {
+            return simulation.getUnrealizedSimulationReport(static_cast<ptrdiff_t>(first + row));
+        };
+        RunExtractionWorkers(numWorkers, numReports, [&](size_t, size_t begin, size_t end)
+        {
+            const std::unique_ptr<OpenSim::Model> modelCopy = [&simulation]()
+            {
+                const auto guard = simulation.getModel();
+                return std::make_unique<OpenSim::Model>(*guard);
+            }();
+            ExtractRowsWithModelCopy(*modelCopy, outputs, getUnrealizedReport, begin, end, columns);
+        });
+        return columns;
+    }
+}
+
+std::vector<std::string> osc::GetOutputColumnNames(std::span<const OutputExtractor> outputs)
 {
-    // header line
-    out << "time";
+    std::vector<std::string> rv;
     for (const OutputExtractor& o : outputs) {
         static_assert(num_options<OutputExtractorDataType>() == 3);
         if (o.getOutputType() == OutputExtractorDataType::Vec2) {
-            out << ',' << o.getName() << "/0";
-            out << ',' << o.getName() << "/1";
+            rv.push_back(std::string{o.getName()} + "/0");
+            rv.push_back(std::string{o.getName()} + "/1");
         }
         else {
-            out << ',' << o.getName();
+            rv.emplace_back(o.getName());
         }
     }
-    out << '\n';
+    return rv;
+}
 
-    // data lines
-    for (const SimulationReport& report : reports) {
-        out << report.getState().getTime();  // time column
-        for (const OutputExtractor& o : outputs) {
-            static_assert(num_options<OutputExtractorDataType>() == 3);
-            if (o.getOutputType() == OutputExtractorDataType::Vec2) {
-                const Vec2 v = o.getValueVec2(root, report);
-                out << ',' << v.x << ',' << v.y;
-            }
-            else {
-                out << ',' << o.getValueFloat(root, report);
-            }
+std::vector<std::vector<float>> osc::ExtractOutputColumns(
+    const OpenSim::Model& model,
+    std::span<const OutputExtractor> outputs,
+    std::span<const SimulationReport> reports)
+{
+    std::vector<std::vector<float>> columns = AllocateOutputColumns(outputs, reports.size());
+
+    const size_t numWorkers = NumExtractionWorkersFor(reports.size());
+    if (numWorkers <= 1) {
+        // too few reports to be worth parallelizing: extract them sequentially from
+        // the caller's model, which avoids having to copy/initialize it
+        ExtractRows(model, outputs, reports, 0, columns);
+        return columns;
+    }
+
+    // each worker gets its own copy of the model, because evaluating an OpenSim output
+    // isn't thread-safe (e.g. `OpenSim::Output<T>` writes its value into a member). The
+    // copies are made up-front on this thread, so that workers never touch `model`
+    std::vector<std::unique_ptr<OpenSim::Model>> modelCopies;
+    modelCopies.reserve(numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        modelCopies.push_back(std::make_unique<OpenSim::Model>(model));
+    }
+
+    const auto getUnrealizedReport = [reports](size_t row) { return CopyReportWithIndependentState(reports[row]); };
+    RunExtractionWorkers(numWorkers, reports.size(), [&](size_t workerIndex, size_t begin, size_t end)
+    {
+        ExtractRowsWithModelCopy(*modelCopies[workerIndex], outputs, getUnrealizedReport, begin, end, columns);
+    });
+    return columns;
+}
+
+std::vector<std::vector<float>> osc::ExtractOutputColumns(
+    const ISimulation& simulation,
+    std::span<const OutputExtractor> outputs)
+{
+    return ExtractOutputColumnsOfReports(simulation, outputs, 0, simulation.getNumReports());
+}
+
+void osc::WriteOutputsAsCSV(
+    const OpenSim::Model& model,
+    std::span<const OutputExtractor> outputs,
+    std::span<const SimulationReport> reports,
+    std::ostream& out)
+{
+    WriteColumnsAsCSV(outputs, GetReportTimes(reports), ExtractOutputColumns(model, outputs, reports), out);
+}
+
+void osc::WriteOutputsAsCSV(
+    const ISimulation& simulation,
+    std::span<const OutputExtractor> outputs,
+    std::ostream& out)
+{
+    const size_t numReports = simulation.getNumReports();
+    WriteColumnsAsCSV(outputs, GetReportTimes(simulation, 0, numReports), ExtractOutputColumnsOfReports(simulation, outputs, 0, numReports), out);
+}
+
+void osc::WriteOutputsAsBinary(
+    const OpenSim::Model& model,
+    std::span<const OutputExtractor> outputs,
+    std::span<const SimulationReport> reports,
+    std::ostream& out)
+{
+    WriteColumnsAsBinary(outputs, GetReportTimes(reports), ExtractOutputColumns(model, outputs, reports), out);
+}
+
+void osc::WriteOutputsAsBinary(
+    const ISimulation& simulation,
+    std::span<const OutputExtractor> outputs,
+    std::ostream& out)
+{
+    const size_t numReports = simulation.getNumReports();
+    WriteColumnsAsBinary(outputs, GetReportTimes(simulation, 0, numReports), ExtractOutputColumnsOfReports(simulation, outputs, 0, numReports), out);
+}
+
+osc::SimulationOutputsStreamer::SimulationOutputsStreamer(
+    std::ostream& out,
+    std::vector<OutputExtractor> outputs) :
+
+    m_Output{&out},
+    m_Outputs{std::move(outputs)},
+    m_Writer{out, GetOutputColumnNames(m_Outputs)}
+{
+    m_Output->flush();
+}
+
+size_t osc::SimulationOutputsStreamer::writeNewReports(const ISimulation& simulation)
+{
+    const size_t numReports = simulation.getNumReports();
+
+    if (const UID generation = simulation.getReportsGeneration(); generation != m_ReportsGeneration) {
+        // the simulation's reports were truncated/replaced since the last call (or this is the
+        // first call): rows can't be un-written, so continue from the first report that comes
+        // after the latest row that was written
+        m_ReportsGeneration = generation;
+        m_NumReportsHandled = 0;
+        while (m_LatestWrittenTime and m_NumReportsHandled < numReports and GetReportTime(simulation, m_NumReportsHandled) <= *m_LatestWrittenTime) {
+            ++m_NumReportsHandled;
         }
-        out << '\n';
     }
+
+    if (m_NumReportsHandled >= numReports) {
+        return 0;  // nothing new to write
+    }
+
+    const size_t first = m_NumReportsHandled;
+    const std::vector<double> times = GetReportTimes(simulation, first, numReports);
+    WriteColumnsAsBinaryBlocks(m_Writer, times, ExtractOutputColumnsOfReports(simulation, m_Outputs, first, numReports));
+    m_Output->flush();  // so that readers (e.g. other processes) see whole blocks as soon as possible
+
+    m_NumReportsHandled = numReports;
+    m_LatestWrittenTime = times.back();
+    return times.size();
 }
@@ -1,18 +1,110 @@
 #pragma once
 
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/BinaryOutputs.h>
+
+#include <oscar/Utils/UID.h>
+
+#include <cstddef>
 #include <iosfwd>
+#include <optional>
 #include <span>
+#include <string>
+#include <vector>
 
-namespace OpenSim { class Component; }
-namespace osc { class OutputExtractor; }
+namespace OpenSim { class Model; }
+namespace osc { class ISimulation; }
 namespace osc { class SimulationReport; }
 
 namespace osc
 {
+    // returns the names of the columns that `ExtractOutputColumns` returns for the given
+    // outputs (e.g. a `Vec2` output named `com` produces `com/0` and `com/1`)
+    std::vector<std::string> GetOutputColumnNames(std::span<const OutputExtractor>);
+
+    // returns the values of each of the given outputs for each of the given reports as
+    // columns, where each column contains one value per report
+    //
+    // - `Vec2` outputs produce two adjacent columns (x, then y)
+    // - all other outputs produce one column of `float`s
+    //
+    // each output is only resolved against the model once per worker, and large numbers
+    // of reports are split across multiple threads, where each thread evaluates outputs
+    // against its own (independently-initialized) copy of the model
+    std::vector<std::vector<float>> ExtractOutputColumns(
+        const OpenSim::Model&,
+        std::span<const OutputExtractor>,
+        std::span<const SimulationReport>
+    );
+
+    // returns the values of each of the given outputs for each of the simulation's reports
+    // as columns (see above)
+    //
+    // large numbers of reports are split across multiple threads by report index: each
+    // thread copies (+ initializes) its own model, then rebuilds and realizes its own slice
+    // of the simulation's reports against it, so the calling thread never has to realize
+    // the reports
+    std::vector<std::vector<float>> ExtractOutputColumns(
+        const ISimulation&,
+        std::span<const OutputExtractor>
+    );
+
+    void WriteOutputsAsCSV(
+        const OpenSim::Model&,
+        std::span<const OutputExtractor>,
+        std::span<const SimulationReport>,
+        std::ostream&
+    );
+
+    // writes the outputs for each of the simulation's reports as CSV (see `ExtractOutputColumns`)
     void WriteOutputsAsCSV(
-        const OpenSim::Component&,
+        const ISimulation&,
+        std::span<const OutputExtractor>,
+        std::ostream&
+    );
+
+    // writes the outputs in the binary outputs format (see `BinaryOutputs.h`)
+    void WriteOutputsAsBinary(
+        const OpenSim::Model&,
         std::span<const OutputExtractor>,
         std::span<const SimulationReport>,
         std::ostream&
     );
+
+    // writes the outputs for each of the simulation's reports in the binary outputs format
+    void WriteOutputsAsBinary(
+        const ISimulation&,
+        std::span<const OutputExtractor>,
+        std::ostream&
+    );
+
+    // incrementally writes the outputs of a (possibly, still-running) simulation's reports
+    // to an output stream in the binary outputs format
+    //
+    // each call to `writeNewReports` appends the reports that the simulation collected since
+    // the previous call as new blocks, and flushes the stream, so that (e.g.) the UI can call
+    // it once per frame while the simulation runs and other processes can read the file
+    // while it's being written
+    class SimulationOutputsStreamer final {
+    public:
+        // immediately writes the header to the stream
+        SimulationOutputsStreamer(std::ostream&, std::vector<OutputExtractor>);
+
+        // writes the simulation's new reports, returning the number of rows that were written
+        //
+        // rows can't be un-written, so if the simulation's reports are truncated (see
+        // `ISimulation::getReportsGeneration`) then streaming continues from the first
+        // report that's after the latest row that was written
+        size_t writeNewReports(const ISimulation&);
+
+        size_t getNumRowsWritten() const { return m_Writer.getNumRowsWritten(); }
+
+    private:
+        std::ostream* m_Output;
+        std::vector<OutputExtractor> m_Outputs;
+        BinaryOutputsWriter m_Writer;
+        UID m_ReportsGeneration = UID::empty();
+        size_t m_NumReportsHandled = 0;
+        std::optional<double> m_LatestWrittenTime;
+    };
 }
@@ -2,15 +2,38 @@
 
 #include <SimTKcommon.h>
 
-#include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/Assertions.h>
 
 #include <chrono>
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 using namespace osc;
 
+namespace
+{
+    // returns the index of `id` in `ids`, trying `hint` first
+    std::optional<size_t> FindAuxiliaryValueIndex(std::span<const UID> ids, UID id, size_t hint = 0)
+    {
+        if (hint < ids.size() and ids[hint] == id) {
+            return hint;
+        }
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (ids[i] == id) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+}
+
 class osc::SimulationReport::Impl final {
 public:
     Impl() = default;
@@ -19,10 +42,32 @@ public:
         m_State{std::move(st)}
     {}
 
-    Impl(SimTK::State&& st, std::unordered_map<UID, float> auxiliaryValues) :
+    Impl(SimTK::State&& st, const std::unordered_map<UID, float>& auxiliaryValues) :
+        m_State{std::move(st)}
+    {
+        auto ids = std::make_shared<std::vector<UID>>();
+        ids->reserve(auxiliaryValues.size());
+        m_AuxiliaryValues.reserve(auxiliaryValues.size());
+        for (const auto& [id, value] : auxiliaryValues) {
+            ids->push_back(id);
+            m_AuxiliaryValues.push_back(value);
+        }
+        m_AuxiliaryValueIDs = std::move(ids);
+    }
+
+    Impl(
+        SimTK::State&& st,
+        std::shared_ptr<const std::vector<UID>> auxiliaryValueIDs,
+        std::vector<float> auxiliaryValues) :
+
         m_State{std::move(st)},
+        m_AuxiliaryValueIDs{std::move(auxiliaryValueIDs)},
         m_AuxiliaryValues{std::move(auxiliaryValues)}
-    {}
+    {
+        if (getAuxiliaryValueIDs().size() != m_AuxiliaryValues.size()) {
+            throw std::invalid_argument{"a simulation report must have the same number of auxiliary value IDs and auxiliary values"};
+        }
+    }
 
     std::unique_ptr<Impl> clone() const
     {
@@ -46,12 +91,34 @@ public:
 
     std::optional<float> getAuxiliaryValue(UID id) const
     {
-        return lookup_or_nullopt(m_AuxiliaryValues, id);
+        if (const auto i = FindAuxiliaryValueIndex(getAuxiliaryValueIDs(), id)) {
+            return m_AuxiliaryValues[*i];
+        }
+        return std::nullopt;
+    }
+
+    void forEachAuxiliaryValue(const std::function<void(UID, float)>& callback) const
+    {
+        const std::span<const UID> ids = getAuxiliaryValueIDs();
+        for (size_t i = 0; i < ids.size(); ++i) {
+            callback(ids[i], m_AuxiliaryValues[i]);
+        }
+    }
+
+    std::span<const UID> getAuxiliaryValueIDs() const
+    {
+        return m_AuxiliaryValueIDs ? std::span<const UID>{*m_AuxiliaryValueIDs} : std::span<const UID>{};
+    }
+
+    std::span<const float> getAuxiliaryValues() const
+    {
+        return m_AuxiliaryValues;
     }
 
 private:
     SimTK::State m_State;
-    std::unordered_map<UID, float> m_AuxiliaryValues;
+    std::shared_ptr<const std::vector<UID>> m_AuxiliaryValueIDs;
+    std::vector<float> m_AuxiliaryValues;
 };
 
 
@@ -62,7 +129,14 @@ osc::SimulationReport::SimulationReport(SimTK::State&& st) :
     m_Impl{std::make_shared<Impl>(std::move(st))}
 {}
 osc::SimulationReport::SimulationReport(SimTK::State&& st, std::unordered_map<UID, float> auxiliaryValues) :
-    m_Impl{std::make_shared<Impl>(std::move(st), std::move(auxiliaryValues))}
+    m_Impl{std::make_shared<Impl>(std::move(st), auxiliaryValues)}
+{}
+osc::SimulationReport::SimulationReport(
+    SimTK::State&& st,
+    std::shared_ptr<const std::vector<UID>> auxiliaryValueIDs,
+    std::vector<float> auxiliaryValues) :
+
+    m_Impl{std::make_shared<Impl>(std::move(st), std::move(auxiliaryValueIDs), std::move(auxiliaryValues))}
 {}
 osc::SimulationReport::SimulationReport(const SimulationReport&) = default;
 osc::SimulationReport::SimulationReport(SimulationReport&&) noexcept = default;
@@ -89,3 +163,41 @@ std::optional<float> osc::SimulationReport::getAuxiliaryValue(UID id) const
 {
     return m_Impl->getAuxiliaryValue(id);
 }
+
+void osc::SimulationReport::forEachAuxiliaryValue(const std::function<void(UID, float)>& callback) const
+{
+    m_Impl->forEachAuxiliaryValue(callback);
+}
+
+std::span<const UID> osc::SimulationReport::getAuxiliaryValueIDs() const
+{
+    return m_Impl->getAuxiliaryValueIDs();
+}
+
+std::span<const float> osc::SimulationReport::getAuxiliaryValues() const
+{
+    return m_Impl->getAuxiliaryValues();
+}
+
+void osc::CopyAuxiliaryValues(
+    std::span<const SimulationReport> reports,
+    UID id,
+    std::span<float> out,
+    float fallback)
+{
+    OSC_ASSERT(reports.size() == out.size());
+
+    // reports from the same simulation usually have the same layout, so the
+    // index of the previous report's value is tried first
+    size_t hint = 0;
+    for (size_t i = 0; i < reports.size(); ++i) {
+        const std::span<const UID> ids = reports[i].getAuxiliaryValueIDs();
+        if (const auto index = FindAuxiliaryValueIndex(ids, id, hint)) {
+            out[i] = reports[i].getAuxiliaryValues()[*index];
+            hint = *index;
+        }
+        else {
+            out[i] = fallback;
+        }
+    }
+}
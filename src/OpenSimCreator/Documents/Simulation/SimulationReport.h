@@ -4,20 +4,35 @@
 
 #include <oscar/Utils/UID.h>
 
+#include <cstddef>
+#include <functional>
 #include <optional>
 #include <memory>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 namespace SimTK { class State; }
 
 namespace osc
 {
     // reference-counted, immutable, simulation report
+    //
+    // auxiliary values (e.g. integrator stats) are stored densely: as an array of values,
+    // plus a (usually, shared between reports) array of which `UID` each value is for
     class SimulationReport final {
     public:
         SimulationReport();
         explicit SimulationReport(SimTK::State&&);
         SimulationReport(SimTK::State&&, std::unordered_map<UID, float> auxiliaryValues);
+
+        // throws if `auxiliaryValueIDs` and `auxiliaryValues` have different sizes
+        SimulationReport(
+            SimTK::State&&,
+            std::shared_ptr<const std::vector<UID>> auxiliaryValueIDs,
+            std::vector<float> auxiliaryValues
+        );
+
         SimulationReport(const SimulationReport&);
         SimulationReport(SimulationReport&&) noexcept;
         SimulationReport& operator=(const SimulationReport&);
@@ -28,10 +43,27 @@ namespace osc
         const SimTK::State& getState() const;
         SimTK::State& updStateHACK();  // necessary because of a bug in OpenSim PathWrap
         std::optional<float> getAuxiliaryValue(UID) const;
+        void forEachAuxiliaryValue(const std::function<void(UID, float)>&) const;
+
+        // returns the report's auxiliary values, and the `UID` of each of them (same order)
+        std::span<const UID> getAuxiliaryValueIDs() const;
+        std::span<const float> getAuxiliaryValues() const;
 
         friend bool operator==(const SimulationReport&, const SimulationReport&) = default;
     private:
         class Impl;
         std::shared_ptr<Impl> m_Impl;
     };
+
+    // writes the auxiliary value with the given `UID` from each report into `out` (or
+    // `fallback`, if a report doesn't have the value)
+    //
+    // this is faster than calling `getAuxiliaryValue` per report, because it reuses the
+    // index of the value between reports that have the same auxiliary value layout
+    void CopyAuxiliaryValues(
+        std::span<const SimulationReport>,
+        UID,
+        std::span<float> out,
+        float fallback
+    );
 }
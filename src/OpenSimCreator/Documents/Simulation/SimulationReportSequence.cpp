@@ -0,0 +1,395 @@
+#include "SimulationReportSequence.h"
+
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+
+#include <SimTKcommon.h>
+#include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/UID.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+namespace rgs = std::ranges;
+
+namespace
+{
+    // the number of reports that each block of state variable columns holds
+    constexpr size_t c_NumReportsPerBlock = 256;
+
+    // a block of (up to) `c_NumReportsPerBlock` reports' continuous state variables, stored
+    // column-wise (i.e. all of variable 0's values, followed by all of variable 1's values,
+    // etc.)
+    class StateVariableBlock final {
+    public:
+        explicit StateVariableBlock(size_t numStateVariables) :
+            m_NumStateVariables{numStateVariables},
+            m_Values(numStateVariables * c_NumReportsPerBlock)
+        {}
+
+        size_t size() const { return m_NumReports; }
+        bool full() const { return m_NumReports >= c_NumReportsPerBlock; }
+        bool isCompacted() const { return m_IsCompacted; }
+
+        void push_back(const SimTK::Vector& y)
+        {
+            OSC_ASSERT(not full() and not isCompacted());
+            OSC_ASSERT(static_cast<size_t>(y.size()) == m_NumStateVariables);
+
+            for (size_t var = 0; var < m_NumStateVariables; ++var) {
+                m_Values[var*c_NumReportsPerBlock + m_NumReports] = y[static_cast<int>(var)];
+            }
+            ++m_NumReports;
+        }
+
+        void truncate(size_t newSize)
+        {
+            if (newSize >= m_NumReports) {
+                return;
+            }
+
+            m_NumReports = newSize;
+            if (isCompacted()) {
+                decompact();  // so that new reports can be appended to this block
+            }
+        }
+
+        void copyRowInto(size_t row, SimTK::Vector& y) const
+        {
+            OSC_ASSERT(row < m_NumReports);
+            OSC_ASSERT(static_cast<size_t>(y.size()) == m_NumStateVariables);
+
+            if (isCompacted()) {
+                for (size_t var = 0; var < m_NumStateVariables; ++var) {
+                    y[static_cast<int>(var)] = m_Bases[var] + static_cast<double>(m_Deltas[var*c_NumReportsPerBlock + row]);
+                }
+            }
+            else {
+                for (size_t var = 0; var < m_NumStateVariables; ++var) {
+                    y[static_cast<int>(var)] = m_Values[var*c_NumReportsPerBlock + row];
+                }
+            }
+        }
+
+        // lossily compacts each column into a double-precision base value (the column's
+        // first value) followed by single-precision deltas from that base
+        void compact()
+        {
+            if (isCompacted()) {
+                return;
+            }
+
+            m_Bases.resize(m_NumStateVariables);
+            m_Deltas.resize(m_NumStateVariables * c_NumReportsPerBlock);
+            for (size_t var = 0; var < m_NumStateVariables; ++var) {
+                const double* column = m_Values.data() + var*c_NumReportsPerBlock;
+                float* deltas = m_Deltas.data() + var*c_NumReportsPerBlock;
+
+                const double base = m_NumReports > 0 ? column[0] : 0.0;
+                m_Bases[var] = base;
+                for (size_t row = 0; row < m_NumReports; ++row) {
+                    deltas[row] = static_cast<float>(column[row] - base);
+                }
+            }
+            std::vector<double>{}.swap(m_Values);  // free the full-precision data
+            m_IsCompacted = true;
+        }
+
+        size_t getApproximateMemoryUsage() const
+        {
+            return
+                m_Values.capacity()*sizeof(decltype(m_Values)::value_type) +
+                m_Bases.capacity()*sizeof(decltype(m_Bases)::value_type) +
+                m_Deltas.capacity()*sizeof(decltype(m_Deltas)::value_type);
+        }
+
+    private:
+        void decompact()
+        {
+            m_Values.resize(m_NumStateVariables * c_NumReportsPerBlock);
+            for (size_t var = 0; var < m_NumStateVariables; ++var) {
+                for (size_t row = 0; row < m_NumReports; ++row) {
+                    m_Values[var*c_NumReportsPerBlock + row] = m_Bases[var] + static_cast<double>(m_Deltas[var*c_NumReportsPerBlock + row]);
+                }
+            }
+            std::vector<double>{}.swap(m_Bases);
+            std::vector<float>{}.swap(m_Deltas);
+            m_IsCompacted = false;
+        }
+
+        size_t m_NumStateVariables;
+        size_t m_NumReports = 0;
+        bool m_IsCompacted = false;
+        std::vector<double> m_Values;  // uncompacted: [var*c_NumReportsPerBlock + row]
+        std::vector<double> m_Bases;   // compacted: [var]
+        std::vector<float> m_Deltas;   // compacted: [var*c_NumReportsPerBlock + row]
+    };
+
+    // a single auxiliary value (e.g. "Wall time") for every report in the sequence
+    struct AuxiliaryValueColumn final {
+        explicit AuxiliaryValueColumn(UID id_, size_t numReports) :
+            id{id_},
+            values(numReports),
+            present(numReports, false)
+        {}
+
+        UID id;
+        std::vector<float> values;
+        std::vector<bool> present;  // because a report isn't required to have every auxiliary value
+    };
+}
+
+class osc::SimulationReportSequence::Impl final {
+public:
+    explicit Impl(size_t numFullPrecisionReports) :
+        m_NumFullPrecisionReports{numFullPrecisionReports}
+    {}
+
+    size_t size() const
+    {
+        return m_Times.size();
+    }
+
+    void push_back(const SimulationReport& report)
+    {
+        const SimTK::State& state = report.getState();
+
+        if (not m_TemplateState) {
+            m_TemplateState.emplace(state);
+            m_TemplateState->invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+        }
+        else if (state.getNY() != m_TemplateState->getNY()) {
+            throw std::runtime_error{"cannot add a report that has a different number of state variables to a simulation report sequence"};
+        }
+
+        const size_t reportIndex = size();
+
+        m_Times.push_back(state.getTime());
+
+        if (m_Blocks.empty() or m_Blocks.back().full()) {
+            m_Blocks.emplace_back(static_cast<size_t>(m_TemplateState->getNY()));
+        }
+        m_Blocks.back().push_back(state.getY());
+
+        for (AuxiliaryValueColumn& column : m_AuxiliaryColumns) {
+            column.values.push_back(0.0f);
+            column.present.push_back(false);
+        }
+        report.forEachAuxiliaryValue([this, reportIndex](UID id, float value)
+        {
+            AuxiliaryValueColumn& column = updOrCreateAuxiliaryColumn(id);
+            column.values[reportIndex] = value;
+            column.present[reportIndex] = true;
+        });
+
+        compactOldBlocks();
+    }
+
+    void truncate(size_t newSize)
+    {
+        if (newSize >= size()) {
+            return;
+        }
+
+        m_Generation.reset();
+        m_Times.resize(newSize);
+        for (AuxiliaryValueColumn& column : m_AuxiliaryColumns) {
+            column.values.resize(newSize);
+            column.present.resize(newSize);
+        }
+
+        const size_t numBlocks = (newSize + c_NumReportsPerBlock - 1) / c_NumReportsPerBlock;
+        m_Blocks.erase(m_Blocks.begin() + static_cast<ptrdiff_t>(numBlocks), m_Blocks.end());
+        if (not m_Blocks.empty()) {
+            m_Blocks.back().truncate(newSize - (numBlocks - 1)*c_NumReportsPerBlock);
+        }
+
+        m_NumCompactedBlocks = 0;
+        while (m_NumCompactedBlocks < m_Blocks.size() and m_Blocks[m_NumCompactedBlocks].isCompacted()) {
+            ++m_NumCompactedBlocks;
+        }
+
+        if (newSize == 0) {
+            m_TemplateState.reset();
+            m_AuxiliaryColumns.clear();
+            m_AuxiliaryColumnIDs = createAuxiliaryColumnIDs();
+        }
+    }
+
+    UID getGeneration() const
+    {
+        return m_Generation;
+    }
+
+    SimulationClock::time_point getTime(size_t reportIndex) const
+    {
+        return SimulationClock::start() + SimulationClock::duration{m_Times.at(reportIndex)};
+    }
+
+    std::optional<float> getAuxiliaryValue(size_t reportIndex, UID id) const
+    {
+        if (reportIndex >= size()) {
+            throw std::out_of_range{"invalid report index passed to a simulation report sequence"};
+        }
+
+        const auto it = rgs::find(m_AuxiliaryColumns, id, &AuxiliaryValueColumn::id);
+        if (it == m_AuxiliaryColumns.end() or not it->present[reportIndex]) {
+            return std::nullopt;
+        }
+        return it->values[reportIndex];
+    }
+
+    SimulationReport getReport(size_t reportIndex) const
+    {
+        if (reportIndex >= size()) {
+            throw std::out_of_range{"invalid report index passed to a simulation report sequence"};
+        }
+
+        SimTK::State state{*m_TemplateState};
+        state.setTime(m_Times[reportIndex]);
+        m_Blocks[reportIndex / c_NumReportsPerBlock].copyRowInto(reportIndex % c_NumReportsPerBlock, state.updY());
+        state.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+
+        // usually, every report has every auxiliary value, so the rebuilt report can share
+        // the sequence's auxiliary value IDs
+        const bool hasAllAuxiliaryValues = rgs::all_of(m_AuxiliaryColumns, [reportIndex](const AuxiliaryValueColumn& column)
+        {
+            return column.present[reportIndex];
+        });
+        std::shared_ptr<const std::vector<UID>> auxiliaryValueIDs = m_AuxiliaryColumnIDs;
+        if (not hasAllAuxiliaryValues) {
+            auto ids = std::make_shared<std::vector<UID>>();
+            for (const AuxiliaryValueColumn& column : m_AuxiliaryColumns) {
+                if (column.present[reportIndex]) {
+                    ids->push_back(column.id);
+                }
+            }
+            auxiliaryValueIDs = std::move(ids);
+        }
+
+        std::vector<float> auxiliaryValues;
+        auxiliaryValues.reserve(m_AuxiliaryColumns.size());
+        for (const AuxiliaryValueColumn& column : m_AuxiliaryColumns) {
+            if (column.present[reportIndex]) {
+                auxiliaryValues.push_back(column.values[reportIndex]);
+            }
+        }
+
+        return SimulationReport{std::move(state), std::move(auxiliaryValueIDs), std::move(auxiliaryValues)};
+    }
+
+    size_t getApproximateMemoryUsage() const
+    {
+        size_t rv = m_Times.capacity() * sizeof(decltype(m_Times)::value_type);
+        for (const StateVariableBlock& block : m_Blocks) {
+            rv += sizeof(StateVariableBlock) + block.getApproximateMemoryUsage();
+        }
+        for (const AuxiliaryValueColumn& column : m_AuxiliaryColumns) {
+            rv += sizeof(AuxiliaryValueColumn);
+            rv += column.values.capacity() * sizeof(float);
+            rv += column.present.capacity() / 8;
+        }
+        return rv;
+    }
+
+private:
+    AuxiliaryValueColumn& updOrCreateAuxiliaryColumn(UID id)
+    {
+        if (const auto it = rgs::find(m_AuxiliaryColumns, id, &AuxiliaryValueColumn::id); it != m_AuxiliaryColumns.end()) {
+            return *it;
+        }
+        AuxiliaryValueColumn& column = m_AuxiliaryColumns.emplace_back(id, size());
+        m_AuxiliaryColumnIDs = createAuxiliaryColumnIDs();
+        return column;
+    }
+
+    std::shared_ptr<const std::vector<UID>> createAuxiliaryColumnIDs() const
+    {
+        auto rv = std::make_shared<std::vector<UID>>();
+        rv->reserve(m_AuxiliaryColumns.size());
+        for (const AuxiliaryValueColumn& column : m_AuxiliaryColumns) {
+            rv->push_back(column.id);
+        }
+        return rv;
+    }
+
+    // compacts any blocks that only contain reports that are older than the
+    // most-recent `m_NumFullPrecisionReports`
+    void compactOldBlocks()
+    {
+        while (m_NumCompactedBlocks < m_Blocks.size()) {
+            StateVariableBlock& block = m_Blocks[m_NumCompactedBlocks];
+            const size_t blockEnd = (m_NumCompactedBlocks + 1) * c_NumReportsPerBlock;
+
+            if (not block.full() or size() - blockEnd < m_NumFullPrecisionReports) {
+                return;
+            }
+
+            block.compact();
+            ++m_NumCompactedBlocks;
+        }
+    }
+
+    size_t m_NumFullPrecisionReports;
+    UID m_Generation;
+    std::optional<SimTK::State> m_TemplateState;
+    std::vector<double> m_Times;
+    std::vector<StateVariableBlock> m_Blocks;
+    size_t m_NumCompactedBlocks = 0;
+    std::vector<AuxiliaryValueColumn> m_AuxiliaryColumns;
+    std::shared_ptr<const std::vector<UID>> m_AuxiliaryColumnIDs = createAuxiliaryColumnIDs();  // the `id` of each of `m_AuxiliaryColumns`
+};
+
+
+osc::SimulationReportSequence::SimulationReportSequence(size_t numFullPrecisionReports) :
+    m_Impl{std::make_unique<Impl>(numFullPrecisionReports)}
+{}
+osc::SimulationReportSequence::SimulationReportSequence(SimulationReportSequence&&) noexcept = default;
+osc::SimulationReportSequence& osc::SimulationReportSequence::operator=(SimulationReportSequence&&) noexcept = default;
+osc::SimulationReportSequence::~SimulationReportSequence() noexcept = default;
+
+size_t osc::SimulationReportSequence::size() const
+{
+    return m_Impl->size();
+}
+
+void osc::SimulationReportSequence::push_back(const SimulationReport& report)
+{
+    m_Impl->push_back(report);
+}
+
+void osc::SimulationReportSequence::truncate(size_t newSize)
+{
+    m_Impl->truncate(newSize);
+}
+
+UID osc::SimulationReportSequence::getGeneration() const
+{
+    return m_Impl->getGeneration();
+}
+
+SimulationClock::time_point osc::SimulationReportSequence::getTime(size_t reportIndex) const
+{
+    return m_Impl->getTime(reportIndex);
+}
+
+std::optional<float> osc::SimulationReportSequence::getAuxiliaryValue(size_t reportIndex, UID id) const
+{
+    return m_Impl->getAuxiliaryValue(reportIndex, id);
+}
+
+SimulationReport osc::SimulationReportSequence::getReport(size_t reportIndex) const
+{
+    return m_Impl->getReport(reportIndex);
+}
+
+size_t osc::SimulationReportSequence::getApproximateMemoryUsage() const
+{
+    return m_Impl->getApproximateMemoryUsage();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+
+#include <oscar/Utils/UID.h>
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+
+namespace osc { class SimulationReport; }
+namespace SimTK { class State; }
+
+namespace osc
+{
+    // a columnar (struct-of-arrays) store of `SimulationReport`s
+    //
+    // rather than holding a full `SimTK::State` (+ cache) per report, this only holds
+    // each report's time, continuous state variables (`y`), and auxiliary values in
+    // contiguous per-variable columns. A `SimulationReport` is only rebuilt when a
+    // caller asks for one, by writing a row's values into a copy of a template state
+    // (the first state that was pushed into the sequence)
+    //
+    // caveats:
+    //
+    // - anything that isn't a continuous state variable (e.g. discrete variables, modeling
+    //   options) is taken from the template state. This is fine for forward-dynamic
+    //   simulations, where those variables don't change over time
+    // - rebuilt reports are *not* realized: callers should realize them against the
+    //   model that produced them (e.g. `model.realizeReport(report.updStateHACK())`)
+    // - state variable values of reports that are older than the most-recent
+    //   `numFullPrecisionReports` are compacted into a lossy (per-block double-precision
+    //   base value + single-precision delta) representation, which roughly halves their
+    //   memory usage. Times and auxiliary values are always lossless
+    class SimulationReportSequence final {
+    public:
+        explicit SimulationReportSequence(
+            size_t numFullPrecisionReports = std::numeric_limits<size_t>::max()
+        );
+        SimulationReportSequence(const SimulationReportSequence&) = delete;
+        SimulationReportSequence(SimulationReportSequence&&) noexcept;
+        SimulationReportSequence& operator=(const SimulationReportSequence&) = delete;
+        SimulationReportSequence& operator=(SimulationReportSequence&&) noexcept;
+        ~SimulationReportSequence() noexcept;
+
+        size_t size() const;
+        bool empty() const { return size() == 0; }
+
+        // appends the given report to the end of the sequence
+        //
+        // throws if the report's state has a different number of continuous state
+        // variables from the reports that are already in the sequence
+        void push_back(const SimulationReport&);
+
+        // erases all reports at or after `newSize`
+        void truncate(size_t newSize);
+        void clear() { truncate(0); }
+
+        // returns an ID that changes whenever reports are erased from the sequence, but not
+        // when reports are appended to it
+        //
+        // IDs are unique across sequences, so callers that cache values that were extracted
+        // from the first N reports can key their cache on `(getGeneration(), N)`
+        UID getGeneration() const;
+
+        // cheap (i.e. doesn't rebuild a `SimTK::State`) accessors for a single report
+        SimulationClock::time_point getTime(size_t reportIndex) const;
+        std::optional<float> getAuxiliaryValue(size_t reportIndex, UID) const;
+
+        // returns a new (unrealized) `SimulationReport` that is rebuilt from the columnar data
+        SimulationReport getReport(size_t reportIndex) const;
+
+        // returns the approximate number of heap-allocated bytes used by the sequence
+        size_t getApproximateMemoryUsage() const;
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+}
@@ -41,3 +41,8 @@ std::span<const CStringView> osc::GetAllSimulationStatusStrings()
 {
     return c_SimulatorStatusStrings;
 }
+
+bool osc::IsActive(SimulationStatus status)
+{
+    return status == SimulationStatus::Initializing or status == SimulationStatus::Running;
+}
@@ -18,4 +18,8 @@ namespace osc
 
     std::span<const SimulationStatus> GetAllSimulationStatuses();
     std::span<const CStringView> GetAllSimulationStatusStrings();
+
+    // returns `true` if the status is one that a simulation has while it's still running
+    // (i.e. it's not a terminal status)
+    bool IsActive(SimulationStatus);
 }
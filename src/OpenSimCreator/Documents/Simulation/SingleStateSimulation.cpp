@@ -5,6 +5,7 @@
 #include <OpenSimCreator/Utils/ParamBlock.h>
 #include <oscar/Utils/SynchronizedValue.h>
 #include <oscar/Utils/SynchronizedValueGuard.h>
+#include <oscar/Utils/UID.h>
 
 using namespace osc;
 
@@ -24,11 +25,21 @@ public:
         return 0;
     }
 
+    UID getReportsGeneration() const
+    {
+        return m_ReportsGeneration;
+    }
+
     SimulationReport getSimulationReport(ptrdiff_t) const
     {
         throw std::runtime_error{"invalid method call on a SingleStateSimulation"};
     }
 
+    SimulationReport getUnrealizedSimulationReport(ptrdiff_t) const
+    {
+        throw std::runtime_error{"invalid method call on a SingleStateSimulation"};
+    }
+
     std::vector<SimulationReport> getAllSimulationReports() const
     {
         return {};
@@ -67,6 +78,7 @@ public:
 private:
     SynchronizedValue<BasicModelStatePair> m_ModelState;
     ParamBlock m_Params;
+    UID m_ReportsGeneration;
 };
 
 
@@ -87,11 +99,21 @@ ptrdiff_t osc::SingleStateSimulation::implGetNumReports() const
     return m_Impl->getNumReports();
 }
 
+UID osc::SingleStateSimulation::implGetReportsGeneration() const
+{
+    return m_Impl->getReportsGeneration();
+}
+
 SimulationReport osc::SingleStateSimulation::implGetSimulationReport(ptrdiff_t reportIndex) const
 {
     return m_Impl->getSimulationReport(reportIndex);
 }
 
+SimulationReport osc::SingleStateSimulation::implGetUnrealizedSimulationReport(ptrdiff_t reportIndex) const
+{
+    return m_Impl->getUnrealizedSimulationReport(reportIndex);
+}
+
 std::vector<SimulationReport> osc::SingleStateSimulation::implGetAllSimulationReports() const
 {
     return m_Impl->getAllSimulationReports();
@@ -7,6 +7,7 @@
 #include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
 
 #include <oscar/Utils/SynchronizedValueGuard.h>
+#include <oscar/Utils/UID.h>
 
 #include <cstddef>
 #include <memory>
@@ -30,7 +31,9 @@ namespace osc
         SynchronizedValueGuard<const OpenSim::Model> implGetModel() const final;
 
         ptrdiff_t implGetNumReports() const final;
+        UID implGetReportsGeneration() const final;
         SimulationReport implGetSimulationReport(ptrdiff_t) const final;
+        SimulationReport implGetUnrealizedSimulationReport(ptrdiff_t) const final;
         std::vector<SimulationReport> implGetAllSimulationReports() const final;
 
         SimulationStatus implGetStatus() const final;
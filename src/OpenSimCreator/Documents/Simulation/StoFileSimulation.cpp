@@ -17,25 +17,33 @@
 #include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
 #include <OpenSim/Simulation/SimbodyEngine/SimbodyEngine.h>
 #include <oscar/Platform/Log.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+#include <oscar/Shims/Cpp20/thread.h>
 #include <oscar/Utils/ScopeGuard.h>
 #include <oscar/Utils/StringHelpers.h>
+#include <oscar/Utils/UID.h>
 
 #include <algorithm>
+#include <atomic>
 #include <concepts>
 #include <cstddef>
 #include <filesystem>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 using namespace osc;
+namespace rgs = std::ranges;
 
 namespace
 {
@@ -155,7 +163,25 @@ namespace
         return rv;
     }
 
-    std::vector<SimulationReport> ExtractReports(
+    // the number of rows that an assembly worker assembles before publishing them
+    constexpr size_t c_NumRowsPerAssemblyChunk = 256;
+
+    // the maximum number of realized reports that are cached by the simulation
+    //
+    // this only needs to cover the reports that the UI is (roughly) showing: bulk consumers
+    // use `getSimulationReports` (which bypasses this cache) and the decoration prefetcher
+    // works with report indices
+    constexpr size_t c_MaxRealizedReportsCached = 32;
+
+    // the rows of an STO file, mapped onto a model's state variables, but not yet
+    // assembled (i.e. they may violate the model's constraints)
+    struct UnassembledRows final {
+        std::vector<double> times;
+        std::vector<SimTK::Vector> stateVariableValues;  // ordered the same as `model.getStateVariableNames()`
+    };
+
+    // parses the STO file and maps each of its rows onto the (initialized) model's state variables
+    UnassembledRows ParseRows(
         OpenSim::Model& model,
         const std::filesystem::path& stoFilePath)
     {
@@ -171,23 +197,17 @@ namespace
         std::unordered_map<int, int> lut =
             CreateStorageIndexToModelSvIndexLUT(model, storage);
 
-        // temporarily unlock coords
-        std::vector<OpenSim::Coordinate*> lockedCoords = GetLockedCoordinates(model);
-        SetCoordsDefaultLocked(lockedCoords, false);
-        const ScopeGuard g{[&lockedCoords]() { SetCoordsDefaultLocked(lockedCoords, true); }};
-
-        InitializeModel(model);
-        InitializeState(model);
-
-        std::vector<SimulationReport> rv;
-        rv.reserve(storage.getSize());
+        UnassembledRows rv;
+        rv.times.reserve(storage.getSize());
+        rv.stateVariableValues.reserve(storage.getSize());
 
+        const SimTK::Vector defaultStateVals = model.getStateVariableValues(model.getWorkingState());
         for (int row = 0; row < storage.getSize(); ++row)
         {
             OpenSim::StateVector* sv = storage.getStateVector(row);
             const OpenSim::Array<double>& cols = sv->getData();
 
-            SimTK::Vector stateValsBuf = model.getStateVariableValues(model.getWorkingState());
+            SimTK::Vector& stateValsBuf = rv.stateVariableValues.emplace_back(defaultStateVals);
             for (auto [valueIdx, modelIdx] : lut)
             {
                 if (0 <= valueIdx && valueIdx < cols.size() && 0 <= modelIdx && modelIdx < stateValsBuf.size())
@@ -199,19 +219,41 @@ namespace
                     throw std::runtime_error{"an index in the stroage lookup was invalid: this is probably a developer error that needs to be investigated (report it)"};
                 }
             }
-
-            SimulationReport& report = rv.emplace_back(SimTK::State{model.getWorkingState()});
-            SimTK::State& st = report.updStateHACK();
-            st.setTime(sv->getTime());
-            model.setStateVariableValues(st, stateValsBuf);
-            model.assemble(st);
-            model.realizeReport(st);
+            rv.times.push_back(sv->getTime());
         }
 
         return rv;
     }
+
+    // initializes the model (+ its working state) such that states can be assembled from
+    // STO data without locked coordinates preventing the assembler from moving them
+    void InitializeModelForAssembly(OpenSim::Model& model)
+    {
+        std::vector<OpenSim::Coordinate*> lockedCoords = GetLockedCoordinates(model);
+        SetCoordsDefaultLocked(lockedCoords, false);
+        const ScopeGuard g{[&lockedCoords]() { SetCoordsDefaultLocked(lockedCoords, true); }};
+
+        InitializeModel(model);
+        InitializeState(model);
+    }
+
+    size_t NumAssemblyWorkersFor(size_t numRows)
+    {
+        const size_t numChunks = (numRows + c_NumRowsPerAssemblyChunk - 1) / c_NumRowsPerAssemblyChunk;
+        return std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), numChunks);
+    }
 }
 
+// the rows of an STO file are assembled (i.e. made consistent with the model's
+// constraints) in chunks by background workers, which each own a copy of the model.
+// Assembled rows are made available as reports as soon as all rows before them are
+// also assembled, so that the UI can start showing the motion immediately. Reports
+// are only realized when they're requested, and a bounded number of realized reports
+// are cached
+//
+// reports are realized against a separate (internal) copy of the model, rather than
+// the model that's returned by `getModel`, so that callers can request reports while
+// holding the model's guard without deadlocking
 class osc::StoFileSimulation::Impl final {
 public:
     Impl(
@@ -220,9 +262,40 @@ public:
         float fixupScaleFactor) :
 
         m_Model{std::move(model)},
-        m_SimulationReports{ExtractReports(*m_Model, stoFilePath)},
+        m_Rows{[this, &stoFilePath]()
+        {
+            InitializeModelForAssembly(*m_Model);
+            return ParseRows(*m_Model, stoFilePath);
+        }()},
+        m_TemplateState{m_Model->getWorkingState()},
+        m_RealizationModel{[this]()
+        {
+            auto copy = std::make_unique<OpenSim::Model>(*m_Model);
+            InitializeModel(*copy);
+            InitializeState(*copy);
+            return copy;
+        }()},
+        m_AssembledStateValues(m_Rows.times.size()),
+        m_ChunkIsAssembled((m_Rows.times.size() + c_NumRowsPerAssemblyChunk - 1) / c_NumRowsPerAssemblyChunk, false),
         m_FixupScaleFactor{fixupScaleFactor}
-    {}
+    {
+        const size_t numWorkers = NumAssemblyWorkersFor(m_Rows.times.size());
+        m_AssemblyWorkers.reserve(numWorkers);
+        for (size_t i = 0; i < numWorkers; ++i) {
+            m_AssemblyWorkers.emplace_back([this](cpp20::stop_token stopToken)
+            {
+                assemblyWorkerMain(std::move(stopToken));
+            });
+        }
+    }
+    Impl(const Impl&) = delete;
+    Impl(Impl&&) noexcept = delete;
+    Impl& operator=(const Impl&) = delete;
+    Impl& operator=(Impl&&) noexcept = delete;
+    ~Impl() noexcept
+    {
+        stop();
+    }
 
     SynchronizedValueGuard<const OpenSim::Model> getModel() const
     {
@@ -231,27 +304,105 @@ public:
 
     size_t getNumReports() const
     {
-        return m_SimulationReports.size();
+        const std::scoped_lock lock{m_ProgressMutex};
+        return m_NumAssembledRows;
+    }
+
+    UID getReportsGeneration() const
+    {
+        return m_ReportsGeneration;  // rows are only ever appended (as they're assembled)
     }
 
     SimulationReport getSimulationReport(ptrdiff_t reportIndex) const
     {
-        return m_SimulationReports.at(reportIndex);
+        const size_t i = checkReportIndex(reportIndex);
+        const std::scoped_lock lock{m_RealizationMutex};
+
+        // if it's already cached, move it to the back (most-recently used) and return it
+        if (const auto it = rgs::find_if(m_RealizedReportCache, [i](const auto& p) { return p.first == i; }); it != m_RealizedReportCache.end()) {
+            std::rotate(it, std::next(it), m_RealizedReportCache.end());
+            return m_RealizedReportCache.back().second;
+        }
+
+        // else: realize it and cache it
+        SimulationReport report = realizeReport(i);
+        if (m_RealizedReportCache.size() >= c_MaxRealizedReportsCached) {
+            m_RealizedReportCache.erase(m_RealizedReportCache.begin());
+        }
+        m_RealizedReportCache.emplace_back(i, report);
+
+        return report;
+    }
+
+    SimulationReport getUnrealizedSimulationReport(ptrdiff_t reportIndex) const
+    {
+        return buildReport(checkReportIndex(reportIndex));
+    }
+
+    std::vector<SimulationReport> getSimulationReports(ptrdiff_t first, ptrdiff_t last) const
+    {
+        if (first < 0 or last < first or static_cast<size_t>(last) > getNumReports()) {
+            throw std::out_of_range{"attempted to access a range of reports that is out of bounds (or not yet loaded)"};
+        }
+
+        // care: this doesn't insert anything into the realized report cache, so that
+        // extracting values from many reports doesn't evict the reports that the UI is
+        // showing
+        const std::scoped_lock lock{m_RealizationMutex};
+        std::vector<SimulationReport> rv;
+        rv.reserve(static_cast<size_t>(last - first));
+        for (auto i = static_cast<size_t>(first); i < static_cast<size_t>(last); ++i) {
+            const auto cached = rgs::find_if(m_RealizedReportCache, [i](const auto& p) { return p.first == i; });
+            rv.push_back(cached != m_RealizedReportCache.end() ? cached->second : realizeReport(i));
+        }
+        return rv;
     }
 
     std::vector<SimulationReport> getAllSimulationReports() const
     {
-        return m_SimulationReports;
+        return getSimulationReports(0, static_cast<ptrdiff_t>(getNumReports()));
+    }
+
+    SimulationClock::time_point getSimulationReportTime(ptrdiff_t reportIndex) const
+    {
+        return SimulationClock::start() + SimulationClock::duration{m_Rows.times[checkReportIndex(reportIndex)]};
     }
 
     SimulationStatus getStatus() const
     {
-        return SimulationStatus::Completed;
+        const std::scoped_lock lock{m_ProgressMutex};
+        if (m_AssemblyFailed) {
+            return SimulationStatus::Error;
+        }
+        else if (m_NumAssembledRows == m_Rows.times.size()) {
+            return SimulationStatus::Completed;
+        }
+        else if (m_AssemblyCancelled) {
+            return SimulationStatus::Cancelled;
+        }
+        else {
+            return SimulationStatus::Running;
+        }
     }
 
     SimulationClocks getClocks() const
     {
-        return SimulationClocks{{m_Start, m_End}};
+        if (m_Rows.times.empty()) {
+            return SimulationClocks{{SimulationClock::start(), SimulationClock::start()}};
+        }
+
+        const SimulationClock::time_point start = SimulationClock::start() + SimulationClock::duration{m_Rows.times.front()};
+        const SimulationClock::time_point end = SimulationClock::start() + SimulationClock::duration{m_Rows.times.back()};
+        const size_t numReports = getNumReports();
+        if (numReports == m_Rows.times.size() or start == end) {
+            return SimulationClocks{{start, end}};
+        }
+        else if (numReports == 0) {
+            return SimulationClocks{{start, end}, start};
+        }
+        else {
+            return SimulationClocks{{start, end}, getSimulationReportTime(static_cast<ptrdiff_t>(numReports - 1))};
+        }
     }
 
     const ParamBlock& getParams() const
@@ -264,6 +415,23 @@ public:
         return {};
     }
 
+    void requestStop()
+    {
+        for (cpp20::jthread& worker : m_AssemblyWorkers) {
+            worker.request_stop();
+        }
+    }
+
+    void stop()
+    {
+        requestStop();
+        for (cpp20::jthread& worker : m_AssemblyWorkers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
     float getFixupScaleFactor() const
     {
         return m_FixupScaleFactor;
@@ -275,13 +443,114 @@ public:
     }
 
 private:
+    size_t checkReportIndex(ptrdiff_t reportIndex) const
+    {
+        if (reportIndex < 0 or static_cast<size_t>(reportIndex) >= getNumReports()) {
+            throw std::out_of_range{"attempted to access a report that is out of bounds (or not yet loaded)"};
+        }
+        return static_cast<size_t>(reportIndex);
+    }
+
+    // returns an (unrealized) report that's built from an assembled row
+    //
+    // care: the row must already be published (i.e. assembled)
+    SimulationReport buildReport(size_t row) const
+    {
+        SimTK::State st{m_TemplateState};
+        st.setTime(m_Rows.times[row]);
+        st.updY() = m_AssembledStateValues[row];
+        return SimulationReport{std::move(st)};
+    }
+
+    // returns a report that's built from an assembled row and realized against the
+    // realization model
+    //
+    // care: the caller must hold `m_RealizationMutex`
+    SimulationReport realizeReport(size_t row) const
+    {
+        SimulationReport rv = buildReport(row);
+        m_RealizationModel->realizeReport(rv.updStateHACK());
+        return rv;
+    }
+
+    void assemblyWorkerMain(cpp20::stop_token stopToken)
+    {
+        try {
+            // each worker assembles rows with its own copy of the model, because
+            // OpenSim models aren't safe to use from multiple threads concurrently
+            std::unique_ptr<OpenSim::Model> model;
+            {
+                const std::scoped_lock lock{m_ModelMutex};
+                model = std::make_unique<OpenSim::Model>(*m_Model);
+            }
+            InitializeModelForAssembly(*model);
+
+            const size_t numChunks = m_ChunkIsAssembled.size();
+            for (size_t chunk = m_NextChunk++; chunk < numChunks; chunk = m_NextChunk++) {
+                const size_t begin = chunk * c_NumRowsPerAssemblyChunk;
+                const size_t end = std::min(begin + c_NumRowsPerAssemblyChunk, m_Rows.times.size());
+                for (size_t row = begin; row < end; ++row) {
+                    if (stopToken.stop_requested() or m_AssemblyFailed) {
+                        const std::scoped_lock lock{m_ProgressMutex};
+                        m_AssemblyCancelled = true;
+                        return;
+                    }
+
+                    SimTK::State st{model->getWorkingState()};
+                    st.setTime(m_Rows.times[row]);
+                    model->setStateVariableValues(st, m_Rows.stateVariableValues[row]);
+                    model->assemble(st);
+                    m_AssembledStateValues[row] = st.getY();
+                }
+                publishAssembledChunk(chunk);
+            }
+        }
+        catch (const std::exception& ex) {
+            log_error("error assembling the states in the STO file: %s", ex.what());
+            const std::scoped_lock lock{m_ProgressMutex};
+            m_AssemblyFailed = true;
+        }
+    }
+
+    void publishAssembledChunk(size_t chunk)
+    {
+        const std::scoped_lock lock{m_ProgressMutex};
+        m_ChunkIsAssembled[chunk] = true;
+
+        // reports are only made available once all reports before them are available
+        size_t numContiguousChunks = m_NumAssembledRows / c_NumRowsPerAssemblyChunk;
+        while (numContiguousChunks < m_ChunkIsAssembled.size() and m_ChunkIsAssembled[numContiguousChunks]) {
+            ++numContiguousChunks;
+        }
+        m_NumAssembledRows = std::min(numContiguousChunks * c_NumRowsPerAssemblyChunk, m_Rows.times.size());
+    }
+
     mutable std::mutex m_ModelMutex;
     std::unique_ptr<OpenSim::Model> m_Model;
-    std::vector<SimulationReport> m_SimulationReports;
-    SimulationClock::time_point m_Start = m_SimulationReports.empty() ? SimulationClock::start() : m_SimulationReports.front().getTime();
-    SimulationClock::time_point m_End = m_SimulationReports.empty() ? SimulationClock::start() : m_SimulationReports.back().getTime();
+    UnassembledRows m_Rows;
+    SimTK::State m_TemplateState;
+
+    // guards the realization model and the realized report cache (never `m_ModelMutex`)
+    mutable std::mutex m_RealizationMutex;
+    std::unique_ptr<OpenSim::Model> m_RealizationModel;
+
+    // written by the assembly workers: a row may only be read once it has been published
+    std::vector<SimTK::Vector> m_AssembledStateValues;
+
+    mutable std::mutex m_ProgressMutex;
+    std::vector<bool> m_ChunkIsAssembled;  // guarded by `m_ProgressMutex`
+    size_t m_NumAssembledRows = 0;  // guarded by `m_ProgressMutex`
+    bool m_AssemblyCancelled = false;  // guarded by `m_ProgressMutex`
+    std::atomic<bool> m_AssemblyFailed = false;
+    std::atomic<size_t> m_NextChunk = 0;
+
+    mutable std::vector<std::pair<size_t, SimulationReport>> m_RealizedReportCache;  // guarded by `m_RealizationMutex`, back == most recently used
     ParamBlock m_ParamBlock;
     float m_FixupScaleFactor = 1.0f;
+    UID m_ReportsGeneration;
+
+    // care: declared last, so that the workers are stopped before anything they use is destroyed
+    std::vector<cpp20::jthread> m_AssemblyWorkers;
 };
 
 osc::StoFileSimulation::StoFileSimulation(std::unique_ptr<OpenSim::Model> model, const std::filesystem::path& stoFilePath, float fixupScaleFactor) :
@@ -301,16 +570,36 @@ ptrdiff_t osc::StoFileSimulation::implGetNumReports() const
     return m_Impl->getNumReports();
 }
 
+UID osc::StoFileSimulation::implGetReportsGeneration() const
+{
+    return m_Impl->getReportsGeneration();
+}
+
 SimulationReport osc::StoFileSimulation::implGetSimulationReport(ptrdiff_t reportIndex) const
 {
     return m_Impl->getSimulationReport(reportIndex);
 }
 
+SimulationReport osc::StoFileSimulation::implGetUnrealizedSimulationReport(ptrdiff_t reportIndex) const
+{
+    return m_Impl->getUnrealizedSimulationReport(reportIndex);
+}
+
+std::vector<SimulationReport> osc::StoFileSimulation::implGetSimulationReports(ptrdiff_t first, ptrdiff_t last) const
+{
+    return m_Impl->getSimulationReports(first, last);
+}
+
 std::vector<SimulationReport> osc::StoFileSimulation::implGetAllSimulationReports() const
 {
     return m_Impl->getAllSimulationReports();
 }
 
+SimulationClock::time_point osc::StoFileSimulation::implGetSimulationReportTime(ptrdiff_t reportIndex) const
+{
+    return m_Impl->getSimulationReportTime(reportIndex);
+}
+
 SimulationStatus osc::StoFileSimulation::implGetStatus() const
 {
     return m_Impl->getStatus();
@@ -331,6 +620,16 @@ std::span<const OutputExtractor> osc::StoFileSimulation::implGetOutputExtractors
     return m_Impl->getOutputExtractors();
 }
 
+void osc::StoFileSimulation::implRequestStop()
+{
+    m_Impl->requestStop();
+}
+
+void osc::StoFileSimulation::implStop()
+{
+    m_Impl->stop();
+}
+
 float osc::StoFileSimulation::implGetFixupScaleFactor() const
 {
     return m_Impl->getFixupScaleFactor();
@@ -6,6 +6,7 @@
 #include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
 
 #include <oscar/Utils/SynchronizedValueGuard.h>
+#include <oscar/Utils/UID.h>
 
 #include <cstddef>
 #include <filesystem>
@@ -38,14 +39,21 @@ namespace osc
         SynchronizedValueGuard<const OpenSim::Model> implGetModel() const final;
 
         ptrdiff_t implGetNumReports() const final;
+        UID implGetReportsGeneration() const final;
         SimulationReport implGetSimulationReport(ptrdiff_t) const final;
+        SimulationReport implGetUnrealizedSimulationReport(ptrdiff_t) const final;
+        std::vector<SimulationReport> implGetSimulationReports(ptrdiff_t, ptrdiff_t) const final;
         std::vector<SimulationReport> implGetAllSimulationReports() const final;
+        SimulationClock::time_point implGetSimulationReportTime(ptrdiff_t) const final;
 
         SimulationStatus implGetStatus() const final;
         SimulationClocks implGetClocks() const final;
         const ParamBlock& implGetParams() const final;
         std::span<const OutputExtractor> implGetOutputExtractors() const final;
 
+        void implRequestStop() final;
+        void implStop() final;
+
         float implGetFixupScaleFactor() const final;
         void implSetFixupScaleFactor(float) final;
 
@@ -2,12 +2,15 @@
 
 #include <OpenSimCreator/Documents/Model/IConstModelStatePair.h>
 #include <OpenSimCreator/Documents/Model/ModelStatePairInfo.h>
+#include <OpenSimCreator/Graphics/DecorationTimelineCache.h>
 #include <OpenSimCreator/Graphics/ModelRendererParams.h>
+#include <OpenSimCreator/Graphics/OpenSimDecorationOptions.h>
 #include <OpenSimCreator/Graphics/OpenSimGraphicsHelpers.h>
 #include <OpenSimCreator/Graphics/OverlayDecorationGenerator.h>
 
 #include <oscar/Graphics/AntiAliasingLevel.h>
 #include <oscar/Graphics/Scene/SceneCache.h>
+#include <oscar/Graphics/Scene/SceneCachePendingMeshes.h>
 #include <oscar/Graphics/Scene/SceneCollision.h>
 #include <oscar/Graphics/Scene/SceneDecoration.h>
 #include <oscar/Graphics/Scene/SceneHelpers.h>
@@ -45,25 +48,43 @@ namespace
             OSC_PERF("CachedModelRenderer/generateDecorationsCached");
 
             const ModelStatePairInfo info{modelState};
+
+            // mesh files are loaded in the background, so the decorations are also regenerated
+            // whenever one of the meshes that they're waiting on finishes loading (so that it pops
+            // into the scene), but not when meshes that only other renderers are waiting on load
             if (info != m_PrevModelStateInfo ||
                 params.decorationOptions != m_PrevDecorationOptions ||
-                params.overlayOptions != m_PrevOverlayOptions)
+                params.overlayOptions != m_PrevOverlayOptions ||
+                m_PendingMeshes->any_loaded())
             {
                 m_Drawlist.clear();
                 m_BVH.clear();
+                m_PendingMeshes->clear();  // (re-added by `GenerateDecorations` if still loading)
 
-                // regenerate
-                const auto onComponentDecoration = [this](const OpenSim::Component&, SceneDecoration&& dec)
-                {
-                    m_Drawlist.push_back(std::move(dec));
-                };
-                GenerateDecorations(
-                    *m_MeshCache,
+                // regenerate (or, if available, copy pre-generated decorations)
+                const bool wasPrefetched = m_TimelineCache and m_TimelineCache->tryGetDecorations(
                     modelState,
                     params.decorationOptions,
-                    onComponentDecoration
+                    m_Drawlist,
+                    m_BVH
                 );
-                update_scene_bvh(m_Drawlist, m_BVH);
+                if (not wasPrefetched) {
+                    const auto onComponentDecoration = [this](const OpenSim::Component&, SceneDecoration&& dec)
+                    {
+                        m_Drawlist.push_back(std::move(dec));
+                    };
+                    // (the timeline cache must be given the original options, because it
+                    // synchronously loads meshes when prefetching)
+                    OpenSimDecorationOptions decorationOptions = params.decorationOptions;
+                    decorationOptions.setPendingMeshes(m_PendingMeshes);
+                    GenerateDecorations(
+                        *m_MeshCache,
+                        modelState,
+                        decorationOptions,
+                        onComponentDecoration
+                    );
+                    update_scene_bvh(m_Drawlist, m_BVH);
+                }
 
                 const auto onOverlayDecoration = [this](SceneDecoration&& dec)
                 {
@@ -88,9 +109,15 @@ namespace
             }
         }
 
+        void setTimelineCache(std::shared_ptr<DecorationTimelineCache> timelineCache)
+        {
+            m_TimelineCache = std::move(timelineCache);
+        }
+
         std::span<const SceneDecoration> getDrawlist() const { return m_Drawlist; }
         const BVH& getBVH() const { return m_BVH; }
         std::optional<AABB> getAABB() const { return m_BVH.bounds(); }
+        bool isLoadingMeshes() const { return not m_PendingMeshes->empty(); }
         SceneCache& updSceneCache() const
         {
             // TODO: technically (imo) this breaks `const`
@@ -99,9 +126,11 @@ namespace
 
     private:
         std::shared_ptr<SceneCache> m_MeshCache;
+        std::shared_ptr<DecorationTimelineCache> m_TimelineCache;
         ModelStatePairInfo m_PrevModelStateInfo;
         OpenSimDecorationOptions m_PrevDecorationOptions;
         OverlayDecorationOptions m_PrevOverlayOptions;
+        std::shared_ptr<SceneCachePendingMeshes> m_PendingMeshes = std::make_shared<SceneCachePendingMeshes>();
         std::vector<SceneDecoration> m_Drawlist;
         BVH m_BVH;
     };
@@ -146,7 +175,7 @@ public:
             rendererParameters != m_PrevRendererParams)
         {
             OSC_PERF("CachedModelRenderer/on_draw/render");
-            m_Renderer.render(m_DecorationCache.getDrawlist(), rendererParameters);
+            m_Renderer.render(m_DecorationCache.getDrawlist(), rendererParameters, m_DecorationCache.getBVH());
             m_PrevRendererParams = rendererParameters;
         }
 
@@ -158,6 +187,11 @@ public:
         return m_Renderer.upd_render_texture();
     }
 
+    void setDecorationTimelineCache(std::shared_ptr<DecorationTimelineCache> timelineCache)
+    {
+        m_DecorationCache.setTimelineCache(std::move(timelineCache));
+    }
+
     std::span<const SceneDecoration> getDrawlist() const
     {
         return m_DecorationCache.getDrawlist();
@@ -168,6 +202,11 @@ public:
         return m_DecorationCache.getAABB();
     }
 
+    bool isLoadingMeshes() const
+    {
+        return m_DecorationCache.isLoadingMeshes();
+    }
+
     std::optional<SceneCollision> getClosestCollision(
         const ModelRendererParams& params,
         Vec2 mouseScreenPos,
@@ -224,6 +263,11 @@ RenderTexture& osc::CachedModelRenderer::updRenderTexture()
     return m_Impl->updRenderTexture();
 }
 
+void osc::CachedModelRenderer::setDecorationTimelineCache(std::shared_ptr<DecorationTimelineCache> timelineCache)
+{
+    m_Impl->setDecorationTimelineCache(std::move(timelineCache));
+}
+
 std::span<const SceneDecoration> osc::CachedModelRenderer::getDrawlist() const
 {
     return m_Impl->getDrawlist();
@@ -234,6 +278,11 @@ std::optional<AABB> osc::CachedModelRenderer::bounds() const
     return m_Impl->bounds();
 }
 
+bool osc::CachedModelRenderer::isLoadingMeshes() const
+{
+    return m_Impl->isLoadingMeshes();
+}
+
 std::optional<SceneCollision> osc::CachedModelRenderer::getClosestCollision(
     const ModelRendererParams& params,
     Vec2 mouseScreenPos,
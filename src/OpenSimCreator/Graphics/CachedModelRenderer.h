@@ -9,6 +9,7 @@
 #include <optional>
 #include <span>
 
+namespace osc { class DecorationTimelineCache; }
 namespace osc { struct Line; }
 namespace osc { struct ModelRendererParams; }
 namespace osc { struct Rect; }
@@ -42,8 +43,18 @@ namespace osc
         );
         RenderTexture& updRenderTexture();
 
+        // sets a cache that the renderer should try to copy decorations from before
+        // generating them itself (e.g. pre-generated decorations of simulation reports)
+        void setDecorationTimelineCache(std::shared_ptr<DecorationTimelineCache>);
+
         std::span<const SceneDecoration> getDrawlist() const;
         std::optional<AABB> bounds() const;
+
+        // returns `true` if mesh files of this renderer's scene are still being loaded in the
+        // background, which means that the scene is incomplete and callers should keep redrawing
+        // until they've loaded (meshes that only other renderers are waiting on don't count)
+        bool isLoadingMeshes() const;
+
         std::optional<SceneCollision> getClosestCollision(
             const ModelRendererParams&,
             Vec2 mouseScreenPos,
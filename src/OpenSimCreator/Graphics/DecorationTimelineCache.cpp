@@ -0,0 +1,562 @@
+#include "DecorationTimelineCache.h"
+
+#include <OpenSimCreator/Documents/Model/IConstModelStatePair.h>
+#include <OpenSimCreator/Documents/Simulation/Simulation.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Graphics/OpenSimDecorationOptions.h>
+#include <OpenSimCreator/Graphics/OpenSimGraphicsHelpers.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <OpenSim/Common/Component.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
+#include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Graphics/Scene/SceneDecorationFlags.h>
+#include <oscar/Graphics/Scene/SceneHelpers.h>
+#include <oscar/Maths/BVH.h>
+#include <oscar/Maths/BVHNode.h>
+#include <oscar/Maths/BVHPrim.h>
+#include <oscar/Platform/Log.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+#include <oscar/Shims/Cpp20/thread.h>
+#include <oscar/Utils/Perf.h>
+#include <Simbody.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+namespace rgs = std::ranges;
+
+namespace
+{
+    // everything (other than the state) that a cached entry's decorations depend on
+    //
+    // selection/hover isn't part of this, because cached decorations are generated without
+    // any selection/hover and tagged on lookup (see `TagSelectionAndHover`)
+    struct CacheParams final {
+        const OpenSim::Model* model = nullptr;
+        OpenSimDecorationOptions options;
+        float fixupScaleFactor = 1.0f;
+
+        friend bool operator==(const CacheParams&, const CacheParams&) = default;
+    };
+
+    // cache entries are keyed by their report's time (in seconds), rather than (e.g.) the address
+    // of the report's state, because the simulation may rebuild a report (with a new state) each
+    // time it's requested
+    using CacheKey = double;
+
+    struct UpcomingReport final {
+        ptrdiff_t index = 0;
+        CacheKey time = 0.0;
+
+        friend bool operator==(const UpcomingReport&, const UpcomingReport&) = default;
+    };
+
+    struct CacheEntry final {
+        std::vector<SceneDecoration> drawlist;
+        BVH bvh;
+        size_t numBytes = 0;
+        uint64_t lastAccess = 0;
+    };
+
+    struct PrefetchJob final {
+        std::shared_ptr<Simulation> simulation;
+        UpcomingReport report;
+        CacheParams params;
+        uint64_t generation = 0;
+    };
+
+    // an `IConstModelStatePair` that refers to the prefetch worker's model + the state that's
+    // being prefetched (with no selection/hover, so the decorations aren't rim highlighted)
+    class PrefetchModelStatePair final : public IConstModelStatePair {
+    public:
+        PrefetchModelStatePair(const OpenSim::Model& model, const SimTK::State& state, float fixupScaleFactor) :
+            m_Model{&model},
+            m_State{&state},
+            m_FixupScaleFactor{fixupScaleFactor}
+        {}
+
+    private:
+        const OpenSim::Model& implGetModel() const final { return *m_Model; }
+        const SimTK::State& implGetState() const final { return *m_State; }
+        float implGetFixupScaleFactor() const final { return m_FixupScaleFactor; }
+
+        const OpenSim::Model* m_Model;
+        const SimTK::State* m_State;
+        float m_FixupScaleFactor;
+    };
+
+    // the prefetch worker's own copy of a simulation's model, so that the worker never reads
+    // (or realizes states against) the simulation's model, which the UI thread uses
+    class PrefetchWorkerModel final {
+    public:
+        // returns the worker's copy of the simulation's model, copying (+ initializing) it first
+        // if the worker's copy is of a different simulation's model
+        OpenSim::Model& updModelOf(const std::shared_ptr<Simulation>& simulation)
+        {
+            if (simulation != m_Simulation or not m_Model) {
+                m_Model.reset();
+                m_Simulation = simulation;
+                {
+                    // only lock the simulation's model while copying it
+                    const auto guard = simulation->getModel();
+                    m_Model = std::make_unique<OpenSim::Model>(*guard);
+                }
+                InitializeModel(*m_Model);
+                InitializeState(*m_Model);
+            }
+            return *m_Model;
+        }
+
+    private:
+        std::shared_ptr<Simulation> m_Simulation;
+        std::unique_ptr<OpenSim::Model> m_Model;
+    };
+
+    // returns `true` if `path` is `ancestorPath`, or is the path of a descendant of it
+    bool IsSameOrDescendantPath(std::string_view path, std::string_view ancestorPath)
+    {
+        if (ancestorPath.empty() or not path.starts_with(ancestorPath)) {
+            return false;
+        }
+        return
+            path.size() == ancestorPath.size() or
+            ancestorPath.back() == '/' or
+            path[ancestorPath.size()] == '/';
+    }
+
+    // tags decorations with the same rim highlight flags that `ComponentSceneDecorationFlagsTagger`
+    // would've tagged them with, by comparing each decoration's ID (absolute path) to the paths of
+    // the selected/hovered components
+    void TagSelectionAndHover(
+        const IConstModelStatePair& modelState,
+        std::span<SceneDecoration> decorations)
+    {
+        const OpenSim::Component* selected = modelState.getSelected();
+        const OpenSim::Component* hovered = modelState.getHovered();
+        if (not selected and not hovered) {
+            return;
+        }
+
+        const std::string selectedPath = selected ? GetAbsolutePathString(*selected) : std::string{};
+        const std::string hoveredPath = hovered ? GetAbsolutePathString(*hovered) : std::string{};
+        for (SceneDecoration& decoration : decorations) {
+            const std::string_view id = decoration.id;
+            if (IsSameOrDescendantPath(id, selectedPath)) {
+                decoration.flags |= SceneDecorationFlag::RimHighlight0;
+            }
+            if (IsSameOrDescendantPath(id, hoveredPath)) {
+                decoration.flags |= SceneDecorationFlag::RimHighlight1;
+            }
+        }
+    }
+
+    // returns `std::nullopt` if the job's report no longer exists (e.g. because the simulation
+    // was truncated since the job was queued)
+    std::optional<CacheEntry> GenerateCacheEntry(
+        SceneCache& sceneCache,
+        PrefetchWorkerModel& workerModel,
+        const PrefetchJob& job)
+    {
+        OSC_PERF("DecorationTimelineCache/GenerateCacheEntry");
+
+        if (job.report.index < 0 or job.report.index >= static_cast<ptrdiff_t>(job.simulation->getNumReports())) {
+            return std::nullopt;
+        }
+
+        // rebuild the report from its index and realize it against the worker's own model
+        OpenSim::Model& model = workerModel.updModelOf(job.simulation);
+        SimulationReport report = job.simulation->getUnrealizedSimulationReport(job.report.index);
+        if (report.getState().getTime() != job.report.time) {
+            return std::nullopt;  // the simulation's reports changed since the job was queued
+        }
+        SimTK::State& state = report.updStateHACK();
+        state.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+        model.realizeReport(state);
+
+        const PrefetchModelStatePair modelState{model, state, job.params.fixupScaleFactor};
+
+        // generate on this (background) thread only, so that prefetching doesn't compete with
+        // the UI thread for the remaining cores (the output is the same, either way)
+        OpenSimDecorationOptions options = job.params.options;
+        options.setShouldGenerateInParallel(false);
+
+        CacheEntry rv;
+        GenerateDecorations(
+            sceneCache,
+            modelState,
+            options,
+            [&rv](const OpenSim::Component&, SceneDecoration&& decoration)
+            {
+                rv.drawlist.push_back(std::move(decoration));
+            }
+        );
+        rv.drawlist.shrink_to_fit();
+        update_scene_bvh(rv.drawlist, rv.bvh);
+
+        // roughly: a `BVH` of `n` prims has at most `2n - 1` nodes
+        rv.numBytes =
+            rv.drawlist.size() * sizeof(SceneDecoration) +
+            rv.bvh.num_prims() * (sizeof(BVHPrim) + 2*sizeof(BVHNode));
+        return rv;
+    }
+
+    // state that's shared between the UI thread and the background worker
+    class SharedState final {
+    public:
+        explicit SharedState(size_t memoryBudget) :
+            m_MemoryBudget{memoryBudget}
+        {}
+
+        bool isPrefetching() const
+        {
+            const std::lock_guard lock{m_Mutex};
+            return m_Params.has_value();
+        }
+
+        bool isIdle() const
+        {
+            const std::lock_guard lock{m_Mutex};
+            return not m_InFlight and not tryFindNextJob();
+        }
+
+        void setUpcomingReports(
+            std::shared_ptr<Simulation> simulation,
+            const OpenSim::Model* simulationModel,
+            float simulationFixupScaleFactor,
+            std::vector<UpcomingReport> reports)
+        {
+            const std::lock_guard lock{m_Mutex};
+
+            if (simulation != m_Simulation) {
+                clearEntries();
+                m_Simulation = std::move(simulation);
+            }
+            m_SimulationModel = simulationModel;
+            m_SimulationFixupScaleFactor = simulationFixupScaleFactor;
+
+            if (reports != m_UpcomingReports) {
+                m_UpcomingReports = std::move(reports);
+                m_ConditionVariable.notify_all();
+            }
+        }
+
+        bool tryGetDecorations(
+            const IConstModelStatePair& modelState,
+            const OpenSimDecorationOptions& options,
+            std::vector<SceneDecoration>& drawlistOut,
+            BVH& bvhOut)
+        {
+            std::unique_lock lock{m_Mutex};
+
+            if (not options.getShouldPrefetchSimulationDecorations()) {
+                // prefetching is disabled: drop everything, so that nothing's prefetched
+                clearEntries();
+                m_Params.reset();
+                return false;
+            }
+
+            CacheParams params{&modelState.getModel(), options, modelState.getFixupScaleFactor()};
+            if (params != m_Params) {
+                // the decorations of all cached (+ upcoming) reports need to be regenerated
+                clearEntries();
+                m_Params = std::move(params);
+                m_ConditionVariable.notify_all();
+                return false;
+            }
+
+            // if the worker is currently generating the requested state's decorations, wait
+            // for it, rather than generating them in parallel with it
+            const CacheKey key = modelState.getState().getTime();
+            m_ConditionVariable.wait(lock, [this, key]() { return m_InFlight != key; });
+
+            const auto it = m_Entries.find(key);
+            if (it == m_Entries.end()) {
+                // the caller will generate this one, so the worker shouldn't
+                m_Claimed = key;
+                return false;
+            }
+
+            CacheEntry& entry = it->second;
+            entry.lastAccess = ++m_AccessCounter;
+            drawlistOut.assign(entry.drawlist.begin(), entry.drawlist.end());
+            bvhOut = entry.bvh;
+            lock.unlock();
+
+            TagSelectionAndHover(modelState, drawlistOut);
+            return true;
+        }
+
+        size_t getNumBytesUsed() const
+        {
+            const std::lock_guard lock{m_Mutex};
+            return m_NumBytesUsed;
+        }
+
+        // blocks until there's a report to prefetch (returns it), or a stop is requested (returns `std::nullopt`)
+        std::optional<PrefetchJob> waitForNextJob(const cpp20::stop_token& stopToken)
+        {
+            std::unique_lock lock{m_Mutex};
+            while (not stopToken.stop_requested()) {
+                if (std::optional<PrefetchJob> job = tryFindNextJob()) {
+                    m_InFlight = job->report.time;
+                    return job;
+                }
+                m_ConditionVariable.wait(lock);
+            }
+            return std::nullopt;
+        }
+
+        void submitJobResult(const PrefetchJob& job, std::optional<CacheEntry> maybeEntry)
+        {
+            const std::lock_guard lock{m_Mutex};
+
+            const CacheKey key = job.report.time;
+            m_InFlight.reset();
+
+            if (not maybeEntry) {
+                // generation failed: don't retry it (until something else is claimed)
+                m_Claimed = key;
+            }
+            else if (job.generation == m_Generation) {
+                maybeEntry->lastAccess = ++m_AccessCounter;
+                const size_t numBytes = maybeEntry->numBytes;
+                if (m_Entries.try_emplace(key, std::move(*maybeEntry)).second) {
+                    m_NumBytesUsed += numBytes;
+                    evictUntilWithinBudget();
+                }
+            }
+            m_ConditionVariable.notify_all();
+        }
+
+        // wakes the worker, so that it can (e.g.) check its stop token
+        void notifyWorker()
+        {
+            const std::lock_guard lock{m_Mutex};
+            m_ConditionVariable.notify_all();
+        }
+
+    private:
+        // returns the first upcoming report that isn't cached, if the cached upcoming reports
+        // haven't already filled the memory budget
+        std::optional<PrefetchJob> tryFindNextJob() const
+        {
+            if (not m_Params or not m_Simulation) {
+                return std::nullopt;
+            }
+            if (m_Params->model != m_SimulationModel or m_Params->fixupScaleFactor != m_SimulationFixupScaleFactor) {
+                return std::nullopt;  // the viewer is showing something else
+            }
+
+            size_t numUpcomingBytes = 0;
+            for (const UpcomingReport& report : m_UpcomingReports) {
+                if (numUpcomingBytes >= m_MemoryBudget) {
+                    break;
+                }
+
+                const CacheKey key = report.time;
+                if (const auto it = m_Entries.find(key); it != m_Entries.end()) {
+                    numUpcomingBytes += it->second.numBytes;
+                }
+                else if (key != m_Claimed) {
+                    return PrefetchJob{m_Simulation, report, *m_Params, m_Generation};
+                }
+            }
+            return std::nullopt;
+        }
+
+        void clearEntries()
+        {
+            m_Entries.clear();
+            m_NumBytesUsed = 0;
+            m_Claimed.reset();
+            ++m_Generation;  // invalidates any in-flight job
+        }
+
+        // evicts least-recently-used entries until the entries fit in the memory budget, preferring
+        // to evict entries that aren't upcoming
+        void evictUntilWithinBudget()
+        {
+            if (m_NumBytesUsed <= m_MemoryBudget) {
+                return;
+            }
+
+            std::unordered_set<CacheKey> upcoming;
+            upcoming.reserve(m_UpcomingReports.size());
+            for (const UpcomingReport& report : m_UpcomingReports) {
+                upcoming.insert(report.time);
+            }
+
+            // non-upcoming entries sort before upcoming ones, then by least-recent access
+            const auto evictionOrder = [&upcoming](const auto& kv)
+            {
+                return std::pair{upcoming.contains(kv.first), kv.second.lastAccess};
+            };
+
+            while (m_NumBytesUsed > m_MemoryBudget and not m_Entries.empty()) {
+                const auto victim = rgs::min_element(m_Entries, rgs::less{}, evictionOrder);
+                m_NumBytesUsed -= victim->second.numBytes;
+                m_Entries.erase(victim);
+            }
+        }
+
+        mutable std::mutex m_Mutex;
+        std::condition_variable m_ConditionVariable;
+        size_t m_MemoryBudget;
+
+        // what the UI wants prefetched
+        std::optional<CacheParams> m_Params;
+        std::shared_ptr<Simulation> m_Simulation;
+        const OpenSim::Model* m_SimulationModel = nullptr;
+        float m_SimulationFixupScaleFactor = 1.0f;
+        std::vector<UpcomingReport> m_UpcomingReports;
+
+        // cached entries, keyed by their report's time
+        std::unordered_map<CacheKey, CacheEntry> m_Entries;
+        size_t m_NumBytesUsed = 0;
+        uint64_t m_AccessCounter = 0;
+        uint64_t m_Generation = 0;
+        std::optional<CacheKey> m_InFlight;  // being generated by the worker
+        std::optional<CacheKey> m_Claimed;   // being generated by the UI (or failed)
+    };
+
+    void PrefetchWorkerMain(
+        cpp20::stop_token stopToken,
+        std::shared_ptr<SharedState> shared,
+        std::shared_ptr<SceneCache> sceneCache)
+    {
+        PrefetchWorkerModel workerModel;
+        while (std::optional<PrefetchJob> job = shared->waitForNextJob(stopToken)) {
+            std::optional<CacheEntry> maybeEntry;
+            try {
+                maybeEntry = GenerateCacheEntry(*sceneCache, workerModel, *job);
+            }
+            catch (const std::exception& ex) {
+                log_warn("DecorationTimelineCache: error prefetching decorations (the UI will generate them instead): %s", ex.what());
+            }
+            shared->submitJobResult(*job, std::move(maybeEntry));
+        }
+    }
+}
+
+class osc::DecorationTimelineCache::Impl final {
+public:
+    Impl(std::shared_ptr<SceneCache> sceneCache, size_t memoryBudget) :
+        m_Shared{std::make_shared<SharedState>(memoryBudget)},
+        m_WorkerThread{PrefetchWorkerMain, m_Shared, std::move(sceneCache)}
+    {}
+    Impl(const Impl&) = delete;
+    Impl(Impl&&) noexcept = delete;
+    Impl& operator=(const Impl&) = delete;
+    Impl& operator=(Impl&&) noexcept = delete;
+    ~Impl() noexcept
+    {
+        // the worker might be waiting for work, so it has to be woken up to see the stop
+        // request (the `jthread` then joins it)
+        m_WorkerThread.request_stop();
+        m_Shared->notifyWorker();
+    }
+
+    bool isPrefetching() const
+    {
+        return m_Shared->isPrefetching();
+    }
+
+    bool isIdle() const
+    {
+        return m_Shared->isIdle();
+    }
+
+    void setUpcomingReports(std::shared_ptr<Simulation> simulation, std::vector<ptrdiff_t> reportIndices)
+    {
+        const OpenSim::Model* model = simulation ? &*simulation->getModel() : nullptr;
+        const float fixupScaleFactor = simulation ? simulation->getFixupScaleFactor() : 1.0f;
+
+        // the worker is only handed report indices (+ times, which key the cache): it rebuilds
+        // and realizes the reports itself
+        std::vector<UpcomingReport> reports;
+        if (simulation) {
+            reports.reserve(reportIndices.size());
+            for (ptrdiff_t i : reportIndices) {
+                reports.push_back({.index = i, .time = simulation->getSimulationReportTime(i).time_since_epoch().count()});
+            }
+        }
+        m_Shared->setUpcomingReports(std::move(simulation), model, fixupScaleFactor, std::move(reports));
+    }
+
+    bool tryGetDecorations(
+        const IConstModelStatePair& modelState,
+        const OpenSimDecorationOptions& options,
+        std::vector<SceneDecoration>& drawlistOut,
+        BVH& bvhOut)
+    {
+        return m_Shared->tryGetDecorations(modelState, options, drawlistOut, bvhOut);
+    }
+
+    size_t getNumBytesUsed() const
+    {
+        return m_Shared->getNumBytesUsed();
+    }
+
+private:
+    std::shared_ptr<SharedState> m_Shared;
+    cpp20::jthread m_WorkerThread;
+};
+
+
+osc::DecorationTimelineCache::DecorationTimelineCache(
+    std::shared_ptr<SceneCache> sceneCache,
+    size_t memoryBudgetInBytes) :
+
+    m_Impl{std::make_unique<Impl>(std::move(sceneCache), memoryBudgetInBytes)}
+{}
+osc::DecorationTimelineCache::DecorationTimelineCache(DecorationTimelineCache&&) noexcept = default;
+osc::DecorationTimelineCache& osc::DecorationTimelineCache::operator=(DecorationTimelineCache&&) noexcept = default;
+osc::DecorationTimelineCache::~DecorationTimelineCache() noexcept = default;
+
+bool osc::DecorationTimelineCache::isPrefetching() const
+{
+    return m_Impl->isPrefetching();
+}
+
+bool osc::DecorationTimelineCache::isIdle() const
+{
+    return m_Impl->isIdle();
+}
+
+void osc::DecorationTimelineCache::setUpcomingReports(
+    std::shared_ptr<Simulation> simulation,
+    std::vector<ptrdiff_t> reportIndices)
+{
+    m_Impl->setUpcomingReports(std::move(simulation), std::move(reportIndices));
+}
+
+bool osc::DecorationTimelineCache::tryGetDecorations(
+    const IConstModelStatePair& modelState,
+    const OpenSimDecorationOptions& options,
+    std::vector<SceneDecoration>& drawlistOut,
+    BVH& bvhOut)
+{
+    return m_Impl->tryGetDecorations(modelState, options, drawlistOut, bvhOut);
+}
+
+size_t osc::DecorationTimelineCache::getNumBytesUsed() const
+{
+    return m_Impl->getNumBytesUsed();
+}
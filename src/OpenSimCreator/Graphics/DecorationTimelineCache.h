@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace osc { class BVH; }
+namespace osc { class IConstModelStatePair; }
+namespace osc { class OpenSimDecorationOptions; }
+namespace osc { class SceneCache; }
+namespace osc { struct SceneDecoration; }
+namespace osc { class Simulation; }
+
+namespace osc
+{
+    // a background-populated cache of the decorations (+ scene `BVH`) of simulation reports
+    //
+    // a simulation UI tells the cache the indices of the reports it's likely to show next (e.g. the
+    // reports after the playhead, in playback order) and a background worker rebuilds those reports,
+    // realizes them against its own copy of the simulation's model, and caches their decorations
+    // while the UI thread is busy with other work, so that scrubbing or playing back the simulation
+    // can (mostly) skip generating decorations + rebuilding the scene `BVH` on the UI thread
+    //
+    // entries are keyed by their report's time, which (unlike the report's state) is stable when the
+    // simulation rebuilds the report, so cache lookups should only be made with states of the
+    // simulation's reports
+    //
+    // the cache is bounded by a memory budget: the worker stops prefetching once the cached upcoming
+    // reports fill the budget, and the least-recently-used entries are evicted (preferring ones that
+    // aren't upcoming) when it's exceeded
+    //
+    // reports are only prefetched when the decoration options have prefetching enabled (the default)
+    class DecorationTimelineCache final {
+    public:
+        static constexpr size_t c_DefaultMemoryBudget = 256*1024*1024;
+
+        explicit DecorationTimelineCache(
+            std::shared_ptr<SceneCache>,
+            size_t memoryBudgetInBytes = c_DefaultMemoryBudget
+        );
+        DecorationTimelineCache(const DecorationTimelineCache&) = delete;
+        DecorationTimelineCache(DecorationTimelineCache&&) noexcept;
+        DecorationTimelineCache& operator=(const DecorationTimelineCache&) = delete;
+        DecorationTimelineCache& operator=(DecorationTimelineCache&&) noexcept;
+        ~DecorationTimelineCache() noexcept;
+
+        // returns `true` if the cache is prefetching reports, which is only the case once a viewer
+        // has asked it for decorations that are generated with prefetching enabled
+        //
+        // callers can use this to skip collecting upcoming reports when they wouldn't be used
+        bool isPrefetching() const;
+
+        // returns `true` if the cache has nothing left to prefetch (e.g. because all upcoming reports
+        // are cached, or because the cached upcoming reports fill the memory budget)
+        bool isIdle() const;
+
+        // sets the indices of the simulation's reports that should be prefetched, highest-priority first
+        void setUpcomingReports(std::shared_ptr<Simulation>, std::vector<ptrdiff_t> reportIndices);
+
+        // if the cache contains the decorations of the given model+state, generated with the given
+        // options, then writes them (tagged with the pair's selection/hover) and their scene `BVH`
+        // into the outputs and returns `true`; otherwise, returns `false`, which means that the
+        // caller should generate the decorations itself
+        //
+        // the options are also the ones that subsequent reports are prefetched with
+        bool tryGetDecorations(
+            const IConstModelStatePair&,
+            const OpenSimDecorationOptions&,
+            std::vector<SceneDecoration>& drawlistOut,
+            BVH& bvhOut
+        );
+
+        // returns the number of bytes the cached decorations (roughly) occupy
+        size_t getNumBytesUsed() const;
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+}
@@ -38,6 +38,7 @@
 #include <oscar/Platform/Log.h>
 #include <oscar/Utils/Algorithms.h>
 #include <oscar/Utils/Perf.h>
+#include <oscar/Utils/ThreadPool.h>
 #include <oscar_simbody/SimTKDecorationGenerator.h>
 #include <oscar_simbody/SimTKHelpers.h>
 #include <SimTKcommon.h>
@@ -46,11 +47,14 @@
 
 #include <cmath>
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -281,7 +285,8 @@ namespace
                     getState(),
                     geom,
                     fixupScaleFactor,
-                    callback
+                    callback,
+                    getOptions().getPendingMeshes().get()
                 );
             }
 
@@ -300,7 +305,8 @@ namespace
                     getState(),
                     geom,
                     fixupScaleFactor,
-                    callback
+                    callback,
+                    getOptions().getPendingMeshes().get()
                 );
             }
         }
@@ -1175,50 +1181,9 @@ namespace
             rs.consume(hcf, std::move(d));
         });
     }
-}
-
-void osc::GenerateModelDecorations(
-    SceneCache& meshCache,
-    const OpenSim::Model& model,
-    const SimTK::State& state,
-    const OpenSimDecorationOptions& opts,
-    float fixupScaleFactor,
-    const std::function<void(const OpenSim::Component&, SceneDecoration&&)>& out)
-{
-    GenerateSubcomponentDecorations(
-        meshCache,
-        model,
-        state,
-        model,  // i.e. the subcomponent is the root
-        opts,
-        fixupScaleFactor,
-        out,
-        false
-    );
-}
 
-void osc::GenerateSubcomponentDecorations(
-    SceneCache& meshCache,
-    const OpenSim::Model& model,
-    const SimTK::State& state,
-    const OpenSim::Component& subcomponent,
-    const OpenSimDecorationOptions& opts,
-    float fixupScaleFactor,
-    const std::function<void(const OpenSim::Component&, SceneDecoration&&)>& out,
-    bool inclusiveOfProvidedSubcomponent)
-{
-    OSC_PERF("OpenSimRenderer/GenerateModelDecorations");
-
-    RendererState rendererState{
-        meshCache,
-        model,
-        state,
-        opts,
-        fixupScaleFactor,
-        out,
-    };
-
-    const auto emitDecorationsForComponent = [&](const OpenSim::Component& c)
+    // emits the decorations of one component (not including its subcomponents)
+    void EmitDecorationsForComponent(RendererState& rendererState, const OpenSim::Component& c)
     {
         // handle OSC-specific decoration specializations, or fallback to generic
         // component decoration handling
@@ -1242,7 +1207,7 @@ void osc::GenerateSubcomponentDecorations(
         else if (const auto* const fg = dynamic_cast<const OpenSim::FrameGeometry*>(&c)) {
             HandleFrameGeometry(rendererState, *fg);
         }
-        else if (const auto* const p2p = dynamic_cast<const OpenSim::PointToPointSpring*>(&c); p2p and opts.getShouldShowPointToPointSprings()) {
+        else if (const auto* const p2p = dynamic_cast<const OpenSim::PointToPointSpring*>(&c); p2p and rendererState.getOptions().getShouldShowPointToPointSprings()) {
             GenerateBodySpatialVectorArrowDecorationsForForcesThatOnlyHaveComputeForceMethod(rendererState, *p2p);
             HandlePointToPointSpring(rendererState, *p2p);
         }
@@ -1250,7 +1215,7 @@ void osc::GenerateSubcomponentDecorations(
             // CARE: it's a typeid comparison because OpenSim::Marker inherits from OpenSim::Station
             HandleStation(rendererState, dynamic_cast<const OpenSim::Station&>(c));
         }
-        else if (const auto* const sj = dynamic_cast<const OpenSim::ScapulothoracicJoint*>(&c); sj && opts.getShouldShowScapulo()) {
+        else if (const auto* const sj = dynamic_cast<const OpenSim::ScapulothoracicJoint*>(&c); sj && rendererState.getOptions().getShouldShowScapulo()) {
             HandleScapulothoracicJoint(rendererState, *sj);
         }
         else if (const auto* const hcf = dynamic_cast<const OpenSim::HuntCrossleyForce*>(&c)) {
@@ -1275,13 +1240,151 @@ void osc::GenerateSubcomponentDecorations(
         else {
             rendererState.emitGenericDecorations(c, c);
         }
+    }
+
+    // a decoration, tagged with the component that it was generated for
+    struct ComponentDecoration final {
+        const OpenSim::Component* component;
+        SceneDecoration decoration;
+    };
+
+    // the number of components in each unit of work that's handed to a worker thread
+    //
+    // workers pull chunks until there are none left, which balances the load when some
+    // components (e.g. muscles) are much more expensive to decorate than others
+    constexpr size_t c_NumComponentsPerDecorationChunk = 32;
+
+    // the minimum number of chunks that are required before decoration generation is
+    // parallelized (each worker has a fixed up-front cost, because it copies the state)
+    constexpr size_t c_MinDecorationChunksForParallelism = 4;
+
+    // generates decorations for each of the `components` on multiple threads and then emits
+    // them, in the same order as a serial generator would emit them, to `out`
+    //
+    // each worker reads from the (shared, read-only) model, but realizes its own copy of the
+    // state, because SimTK lazily writes cache entries into the state when they're read
+    void GenerateDecorationsInParallel(
+        SceneCache& meshCache,
+        const OpenSim::Model& model,
+        const SimTK::State& state,
+        std::span<const OpenSim::Component* const> components,
+        const OpenSimDecorationOptions& opts,
+        float fixupScaleFactor,
+        const std::function<void(const OpenSim::Component&, SceneDecoration&&)>& out)
+    {
+        const size_t numChunks = (components.size() + c_NumComponentsPerDecorationChunk - 1) / c_NumComponentsPerDecorationChunk;
+        const size_t numWorkers = std::min<size_t>(ThreadPool::global().num_workers() + 1, numChunks);
+
+        // each chunk is written into its own (worker-local) drawlist, so that they can be
+        // merged in component order afterwards, regardless of which worker handled it
+        std::vector<std::vector<ComponentDecoration>> chunkDecorations(numChunks);
+        std::atomic<size_t> nextChunk = 0;
+
+        // the states are copied up-front on this thread, so that workers never touch `state`
+        std::vector<std::unique_ptr<SimTK::State>> stateCopies;
+        stateCopies.reserve(numWorkers);
+        for (size_t i = 0; i < numWorkers; ++i) {
+            stateCopies.push_back(std::make_unique<SimTK::State>(state));
+        }
+
+        const auto work = [&](const SimTK::State& stateCopy)
+        {
+            std::vector<ComponentDecoration>* chunkOut = nullptr;
+            const std::function<void(const OpenSim::Component&, SceneDecoration&&)> consumer = [&chunkOut](const OpenSim::Component& c, SceneDecoration&& dec)
+            {
+                chunkOut->push_back({&c, std::move(dec)});
+            };
+            RendererState workerState{meshCache, model, stateCopy, opts, fixupScaleFactor, consumer};
+
+            for (size_t chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++) {
+                chunkOut = &chunkDecorations[chunk];
+                const size_t begin = chunk * c_NumComponentsPerDecorationChunk;
+                const size_t end = std::min(begin + c_NumComponentsPerDecorationChunk, components.size());
+                for (size_t i = begin; i < end; ++i) {
+                    EmitDecorationsForComponent(workerState, *components[i]);
+                }
+            }
+        };
+
+        // each worker slot (i.e. state copy) is run by the thread pool (or the calling thread)
+        ThreadPool::global().for_each_chunk(numWorkers, 1, [&](size_t first, size_t last)
+        {
+            for (size_t i = first; i < last; ++i) {
+                work(*stateCopies[i]);
+            }
+        });
+
+        // merge
+        for (std::vector<ComponentDecoration>& decorations : chunkDecorations) {
+            for (ComponentDecoration& d : decorations) {
+                out(*d.component, std::move(d.decoration));
+            }
+        }
+    }
+}
+
+void osc::GenerateModelDecorations(
+    SceneCache& meshCache,
+    const OpenSim::Model& model,
+    const SimTK::State& state,
+    const OpenSimDecorationOptions& opts,
+    float fixupScaleFactor,
+    const std::function<void(const OpenSim::Component&, SceneDecoration&&)>& out)
+{
+    GenerateSubcomponentDecorations(
+        meshCache,
+        model,
+        state,
+        model,  // i.e. the subcomponent is the root
+        opts,
+        fixupScaleFactor,
+        out,
+        false
+    );
+}
+
+void osc::GenerateSubcomponentDecorations(
+    SceneCache& meshCache,
+    const OpenSim::Model& model,
+    const SimTK::State& state,
+    const OpenSim::Component& subcomponent,
+    const OpenSimDecorationOptions& opts,
+    float fixupScaleFactor,
+    const std::function<void(const OpenSim::Component&, SceneDecoration&&)>& out,
+    bool inclusiveOfProvidedSubcomponent)
+{
+    OSC_PERF("OpenSimRenderer/GenerateModelDecorations");
+
+    if (opts.getShouldGenerateInParallel()) {
+        std::vector<const OpenSim::Component*> components;
+        if (inclusiveOfProvidedSubcomponent) {
+            components.push_back(&subcomponent);
+        }
+        for (const OpenSim::Component& c : subcomponent.getComponentList()) {
+            components.push_back(&c);
+        }
+
+        if (components.size() >= c_MinDecorationChunksForParallelism * c_NumComponentsPerDecorationChunk) {
+            GenerateDecorationsInParallel(meshCache, model, state, components, opts, fixupScaleFactor, out);
+            return;
+        }
+        // else: too few components to be worth parallelizing
+    }
+
+    RendererState rendererState{
+        meshCache,
+        model,
+        state,
+        opts,
+        fixupScaleFactor,
+        out,
     };
 
     if (inclusiveOfProvidedSubcomponent) {
-        emitDecorationsForComponent(subcomponent);
+        EmitDecorationsForComponent(rendererState, subcomponent);
     }
     for (const OpenSim::Component& c : subcomponent.getComponentList()) {
-        emitDecorationsForComponent(c);
+        EmitDecorationsForComponent(rendererState, c);
     }
 }
 
@@ -88,6 +88,18 @@ namespace
             OSC_ICON_MAGIC " Point Torques",
             "Tries to draw the an arrow to the point where point-based linear force component(s) are applied. This only applies to `OpenSim::Force`s that support applying forces to points.\n\nEXPERIMENTAL: for technical reasons, this implementation is ad-hoc: it currently only works for `ExternalForce`s",
         },
+        OpenSimDecorationOptionMetadata
+        {
+            "generate_in_parallel",
+            OSC_ICON_MAGIC " Parallel Generation",
+            "Generates the decorations of large models (e.g. models with hundreds of muscles) on multiple threads, which can make scrubbing through simulations of those models smoother. The generated decorations are identical to the ones that are generated on one thread.\n\nEXPERIMENTAL: this relies on the model's components being safe to read from multiple threads at once, which is true for typical OpenSim models, but might not be true for some (e.g. custom or plugin) components. Disable this if you see rendering glitches or crashes.",
+        },
+        OpenSimDecorationOptionMetadata
+        {
+            "prefetch_simulation_decorations",
+            "Prefetch Simulation Decorations",
+            "Generates the decorations of upcoming simulation reports in the background (on a separate copy of the model), so that scrubbing through, or playing back, a simulation doesn't have to wait on them. Disable this to save memory and CPU time.",
+        },
     });
 
     static_assert(c_CustomDecorationOptionLabels.size() == num_flags<OpenSimDecorationOptionFlags>());
@@ -23,9 +23,11 @@ namespace osc
         ShouldShowForceAngularComponent                     = 1<<9,
         ShouldShowPointForces                               = 1<<10,
         ShouldShowPointTorques                              = 1<<11,
-        NUM_FLAGS                                           = 12,
+        ShouldGenerateInParallel                            = 1<<12,
+        ShouldPrefetchSimulationDecorations                 = 1<<13,
+        NUM_FLAGS                                           = 14,
 
-        Default = ShouldShowPointToPointSprings,
+        Default = ShouldShowPointToPointSprings | ShouldPrefetchSimulationDecorations,
     };
 
     constexpr bool operator&(OpenSimDecorationOptionFlags lhs, OpenSimDecorationOptionFlags rhs)
@@ -7,8 +7,10 @@
 #include <oscar/Variant/Variant.h>
 #include <oscar/Variant/VariantType.h>
 
+#include <memory>
 #include <optional>
 #include <ranges>
+#include <utility>
 
 using namespace osc;
 namespace rgs = std::ranges;
@@ -195,6 +197,36 @@ void osc::OpenSimDecorationOptions::setShouldShowPointTorques(bool v)
     SetOption(m_Flags, OpenSimDecorationOptionFlags::ShouldShowPointTorques, v);
 }
 
+bool osc::OpenSimDecorationOptions::getShouldGenerateInParallel() const
+{
+    return m_Flags & OpenSimDecorationOptionFlags::ShouldGenerateInParallel;
+}
+
+void osc::OpenSimDecorationOptions::setShouldGenerateInParallel(bool v)
+{
+    SetOption(m_Flags, OpenSimDecorationOptionFlags::ShouldGenerateInParallel, v);
+}
+
+bool osc::OpenSimDecorationOptions::getShouldPrefetchSimulationDecorations() const
+{
+    return m_Flags & OpenSimDecorationOptionFlags::ShouldPrefetchSimulationDecorations;
+}
+
+void osc::OpenSimDecorationOptions::setShouldPrefetchSimulationDecorations(bool v)
+{
+    SetOption(m_Flags, OpenSimDecorationOptionFlags::ShouldPrefetchSimulationDecorations, v);
+}
+
+const std::shared_ptr<SceneCachePendingMeshes>& osc::OpenSimDecorationOptions::getPendingMeshes() const
+{
+    return m_PendingMeshes;
+}
+
+void osc::OpenSimDecorationOptions::setPendingMeshes(std::shared_ptr<SceneCachePendingMeshes> pendingMeshes)
+{
+    m_PendingMeshes = std::move(pendingMeshes);
+}
+
 void osc::OpenSimDecorationOptions::forEachOptionAsAppSettingValue(const std::function<void(std::string_view, const Variant&)>& callback) const
 {
     callback("muscle_decoration_style", GetMuscleDecorationStyleMetadata(m_MuscleDecorationStyle).id);
@@ -10,12 +10,14 @@
 
 #include <cstddef>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 
 namespace osc { class AppSettingValue; }
+namespace osc { class SceneCachePendingMeshes; }
 
 namespace osc
 {
@@ -75,6 +77,19 @@ namespace osc
         bool getShouldShowPointTorques() const;
         void setShouldShowPointTorques(bool);
 
+        bool getShouldGenerateInParallel() const;
+        void setShouldGenerateInParallel(bool);
+
+        bool getShouldPrefetchSimulationDecorations() const;
+        void setShouldPrefetchSimulationDecorations(bool);
+
+        // not a user-facing (or persisted) option: it's set by renderers that can show a
+        // partially-loaded scene and regenerate it as the meshes load. If set, mesh files that
+        // haven't loaded yet are loaded in the background (see `SceneCache::get_mesh_async`) and
+        // added to the given set, so that the renderer can tell when *its* meshes have loaded
+        const std::shared_ptr<SceneCachePendingMeshes>& getPendingMeshes() const;
+        void setPendingMeshes(std::shared_ptr<SceneCachePendingMeshes>);
+
         void forEachOptionAsAppSettingValue(const std::function<void(std::string_view, const Variant&)>&) const;
         void tryUpdFromValues(std::string_view keyPrefix, const std::unordered_map<std::string, Variant>&);
 
@@ -85,5 +100,6 @@ namespace osc
         MuscleColoringStyle m_MuscleColoringStyle;
         MuscleSizingStyle m_MuscleSizingStyle;
         OpenSimDecorationOptionFlags m_Flags;
+        std::shared_ptr<SceneCachePendingMeshes> m_PendingMeshes;
     };
 }
@@ -16,6 +16,8 @@
 #include <OpenSim/Simulation/Model/ModelVisualizer.h>
 #include <OpenSim/Tools/RegisterTypes_osimTools.h>
 #include <OpenSimThirdPartyPlugins/RegisterTypes_osimPlugin.h>
+#include <oscar/Graphics/Scene/MeshDiskCache.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Platform/App.h>
 #include <oscar/Platform/AppMetadata.h>
 #include <oscar/Platform/AppSettings.h>
@@ -219,6 +221,18 @@ namespace
         RegisterOscarSimbodyTabs(registry);
     }
 
+    // makes the app-wide `SceneCache` persist loaded mesh files (+ their BVHs) to the
+    // user's data directory, so that re-opening a model doesn't have to re-parse them
+    //
+    // the cache is pruned here, rather than while it's being used, so that entries that
+    // the current session might still reload aren't deleted from underneath it
+    void InitializeMeshDiskCache(SceneCache& sceneCache, const std::filesystem::path& userDataDirectory)
+    {
+        auto meshDiskCache = std::make_shared<MeshDiskCache>(userDataDirectory / "cache" / "meshes");
+        meshDiskCache->prune();
+        sceneCache.set_mesh_disk_cache(std::move(meshDiskCache));
+    }
+
     void InitializeOpenSimCreatorSpecificSettingDefaults(AppSettings& settings)
     {
         for (const auto& [setting_id, default_state] : c_default_panel_states) {
@@ -255,6 +269,7 @@ osc::OpenSimCreatorApp::OpenSimCreatorApp(const AppMetadata& metadata) :
     GloballyAddDirectoryToOpenSimGeometrySearchPath(resource_filepath("geometry"));
     InitializeTabRegistry(*singleton<TabRegistry>());
     InitializeOpenSimCreatorSpecificSettingDefaults(upd_settings());
+    InitializeMeshDiskCache(*singleton<SceneCache>(resource_loader()), user_data_directory());
     g_opensimcreator_app_global = this;
 }
 
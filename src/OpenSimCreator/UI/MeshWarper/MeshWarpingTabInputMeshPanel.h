@@ -17,6 +17,7 @@
 #include <oscar/Graphics/Scene/CachedSceneRenderer.h>
 #include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Graphics/Scene/SceneDecorationList.h>
 #include <oscar/Graphics/Scene/SceneHelpers.h>
 #include <oscar/Graphics/Scene/SceneRendererParams.h>
 #include <oscar/Maths/BVH.h>
@@ -212,16 +213,16 @@ namespace osc
                 dims
             );
             m_State->getCustomRenderingOptions().applyTo(params);
-            const std::vector<SceneDecoration> decorations = generateDecorations(maybeMeshCollision, maybeLandmarkCollision);
+            const SceneDecorationList decorations = generateDecorations(maybeMeshCollision, maybeLandmarkCollision);
             return m_CachedRenderer.render(decorations, params);
         }
 
         // returns a fresh list of 3D decorations for this panel's 3D render
-        std::vector<SceneDecoration> generateDecorations(
+        SceneDecorationList generateDecorations(
             const std::optional<RayCollision>& maybeMeshCollision,
             const std::optional<MeshWarpingTabHover>& maybeLandmarkCollision) const
         {
-            std::vector<SceneDecoration> decorations;
+            SceneDecorationList decorations;
             decorations.reserve(
                 6 +
                 CountNumLandmarksForInput(m_State->getScratch(), m_DocumentIdentifier) +
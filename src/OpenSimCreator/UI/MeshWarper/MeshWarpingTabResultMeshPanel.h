@@ -10,6 +10,7 @@
 #include <oscar/Graphics/Scene/CachedSceneRenderer.h>
 #include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Graphics/Scene/SceneDecorationList.h>
 #include <oscar/Graphics/Scene/SceneRendererParams.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/PolarPerspectiveCamera.h>
@@ -225,9 +226,9 @@ namespace osc
         }
 
         // returns 3D decorations for the given result panel
-        std::vector<SceneDecoration> generateDecorations() const
+        SceneDecorationList generateDecorations() const
         {
-            std::vector<SceneDecoration> decorations;
+            SceneDecorationList decorations;
             const std::function<void(SceneDecoration&&)> decorationConsumer =
                 [&decorations](SceneDecoration&& dec) { decorations.push_back(std::move(dec)); };
 
@@ -265,7 +266,7 @@ namespace osc
         // renders a panel to a texture via its renderer and returns a reference to the rendered texture
         RenderTexture& renderScene(Vec2 dims)
         {
-            const std::vector<SceneDecoration> decorations = generateDecorations();
+            const SceneDecorationList decorations = generateDecorations();
             SceneRendererParams params = calc_standard_dark_scene_render_params(
                 m_Camera,
                 App::get().anti_aliasing_level(),
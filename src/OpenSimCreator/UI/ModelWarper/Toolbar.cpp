@@ -64,6 +64,20 @@ void osc::mow::Toolbar::drawWarpModelButton()
         m_State->setWarpBlendingFactor(blend);
     }
 
+    ui::same_line();
+    ui::set_next_item_width(ui::calc_text_size("should be roughly this long").x);
+    double maxError = m_State->getMaxAbsoluteWarpError();
+    if (ui::draw_double_input("max error", &maxError, 0.0, 0.0, "%.2e")) {
+        m_State->setMaxAbsoluteWarpError(maxError);
+    }
+    if (ui::is_item_hovered()) {
+        ui::begin_tooltip();
+        ui::draw_tooltip_header_text("Max Absolute Warp Error");
+        ui::draw_tooltip_description_spacer();
+        ui::draw_tooltip_description_text("The maximum error (per component of each point) that warps may introduce in exchange for speed. E.g. TPS warps with many landmarks are approximated when this is nonzero. Zero means that points are warped exactly.");
+        ui::end_tooltip();
+    }
+
     ui::same_line();
     {
         bool v = m_State->isCameraLinked();
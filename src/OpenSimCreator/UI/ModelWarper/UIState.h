@@ -44,6 +44,9 @@ namespace osc::mow
         float getWarpBlendingFactor() const { return m_Document->getWarpBlendingFactor(); }
         void setWarpBlendingFactor(float v) { m_Document->setWarpBlendingFactor(v); }
 
+        double getMaxAbsoluteWarpError() const { return m_Document->getMaxAbsoluteWarpError(); }
+        void setMaxAbsoluteWarpError(double v) { m_Document->setMaxAbsoluteWarpError(v); }
+
         bool isCameraLinked() const { return m_LinkCameras; }
         void setCameraLinked(bool v) { m_LinkCameras = v; }
         bool isOnlyCameraRotationLinked() const { return m_OnlyLinkRotation; }
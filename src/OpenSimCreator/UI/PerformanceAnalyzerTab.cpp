@@ -2,11 +2,11 @@
 
 #include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
 #include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
-#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulation.h>
+#include <OpenSimCreator/Documents/Simulation/BatchSimulation.h>
 #include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulator.h>
 #include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
 #include <OpenSimCreator/Documents/Simulation/IntegratorMethod.h>
-#include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationHelpers.h>
 #include <OpenSimCreator/UI/Shared/ParamBlockEditorPopup.h>
 #include <OpenSimCreator/Utils/ParamBlock.h>
 #include <OpenSimCreator/Utils/ParamValue.h>
@@ -17,18 +17,17 @@
 #include <oscar/UI/oscimgui.h>
 #include <oscar/Utils/Algorithms.h>
 
-#include <algorithm>
+#include <cstddef>
 #include <filesystem>
+#include <fstream>
 #include <optional>
-#include <ostream>
-#include <ranges>
-#include <span>
+#include <stdexcept>
+#include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
 using namespace osc;
-namespace rgs = std::ranges;
 
 namespace
 {
@@ -76,7 +75,12 @@ public:
 
         ui::begin_panel("Inputs");
 
-        ui::draw_int_input("parallelism", &m_Parallelism);
+        if (ui::draw_int_input("parallelism", &m_Parallelism)) {
+            m_Parallelism = max(m_Parallelism, 1);
+            if (m_Batch) {
+                m_Batch->setMaxConcurrentSimulations(static_cast<size_t>(m_Parallelism));
+            }
+        }
         if (ui::draw_button("edit base params")) {
             m_ParamEditor.open();
         }
@@ -89,33 +93,28 @@ public:
 
         ui::begin_panel("Outputs");
 
-        if (!m_Sims.empty() && ui::begin_table("simulations", 4)) {
-            ui::table_setup_column("Integrator");
+        if (m_Batch and ui::begin_table("simulations", 2 + static_cast<int>(m_OutputColumnNames.size()))) {
+            ui::table_setup_column("Variant");
             ui::table_setup_column("Progress");
-            ui::table_setup_column("Wall Time (sec)");
-            ui::table_setup_column("NumStepsTaken");
+            for (const std::string& columnName : m_OutputColumnNames) {
+                ui::table_setup_column(columnName);
+            }
             ui::table_headers_row();
 
-            for (const ForwardDynamicSimulation& sim : m_Sims) {
-                auto reports = sim.getAllSimulationReports();
-                if (reports.empty()) {
-                    continue;
-                }
-
-                IntegratorMethod m = std::get<IntegratorMethod>(sim.getParams().findValue("Integrator Method").value());
-                float t = m_WalltimeExtractor.getValueFloat(*sim.getModel(), reports.back());
-                float steps = m_StepsTakenExtractor.getValueFloat(*sim.getModel(), reports.back());
-
+            for (size_t i = 0; i < m_Batch->getNumVariants(); ++i) {
                 ui::table_next_row();
                 int column = 0;
                 ui::table_set_column_index(column++);
-                ui::draw_text_unformatted(m.label());
-                ui::table_set_column_index(column++);
-                ui::draw_progress_bar(sim.getProgress());
-                ui::table_set_column_index(column++);
-                ui::draw_text("%f", t);
+                ui::draw_text_unformatted(m_Batch->getVariant(i).label);
                 ui::table_set_column_index(column++);
-                ui::draw_text("%i", static_cast<int>(steps));
+                ui::draw_progress_bar(m_Batch->getProgress(i));
+
+                if (const auto values = m_Batch->getLatestOutputValues(i)) {
+                    for (float value : *values) {
+                        ui::table_set_column_index(column++);
+                        ui::draw_text("%f", value);
+                    }
+                }
             }
 
             ui::end_table();
@@ -151,64 +150,45 @@ private:
             return;  // IO error (can't write to that location?)
         }
 
-        fout << "Integrator,Wall Time (sec),NumStepsTaken\n";
-
-        for (const ForwardDynamicSimulation& sim : m_Sims) {
-            auto reports = sim.getAllSimulationReports();
-            if (reports.empty()) {
-                continue;
-            }
-
-            IntegratorMethod m = std::get<IntegratorMethod>(sim.getParams().findValue("Integrator Method").value());
-            float t = m_WalltimeExtractor.getValueFloat(*sim.getModel(), reports.back());
-            float steps = m_StepsTakenExtractor.getValueFloat(*sim.getModel(), reports.back());
-
-            fout << m.label() << ',' << t << ',' << steps << '\n';
-        }
+        WriteBatchSummaryAsCSV(*m_Batch, fout);
     }
 
-    // populate the list of input parameters
+    // (re)populate the batch of simulations from the base parameters
     void populateParamsFromParamBlock()
     {
-        m_Params.clear();
-        m_Sims.clear();
-
         ForwardDynamicSimulatorParams params = FromParamBlock(m_BaseParams);
 
         // for now, just permute through integration methods
+        std::vector<BatchSimulationVariant> variants;
         for (IntegratorMethod m : IntegratorMethod::all()) {
             params.integratorMethodUsed = m;
-            m_Params.push_back(params);
+            variants.push_back({.label = std::string{m.label()}, .params = params, .modelEditor = {}});
         }
+
+        m_Batch.emplace(m_BaseModel, std::move(variants), m_SharedOutputs);
+        m_Batch->setMaxConcurrentSimulations(static_cast<size_t>(m_Parallelism));
     }
 
     // dequeue any queued sims
     void startSimsIfNecessary()
     {
-        int nAvail = static_cast<int>(m_Params.size()) - static_cast<int>(m_Sims.size());
-        int nActive = static_cast<int>(rgs::count_if(m_Sims, [](const auto& sim) { return sim.getStatus() == SimulationStatus::Running || sim.getStatus() == SimulationStatus::Initializing; }));
-        int nToStart = min(nAvail, m_Parallelism - nActive);
-
-        if (nToStart <= 0) {
-            return;  // nothing to start
-        }
-
-        // load model and enqueue sims
-        for (auto it = m_Params.end() - nAvail, end = it + nToStart; it != end; ++it) {
-            m_Sims.emplace_back(m_BaseModel, *it);
+        if (m_Batch) {
+            m_Batch->tick();
         }
     }
 
     UID m_TabID;
 
-    int m_Parallelism = 1;
+    int m_Parallelism = static_cast<int>(GetDefaultMaxConcurrentSimulations());
     BasicModelStatePair m_BaseModel;
     ParamBlock m_BaseParams;
-    std::vector<ForwardDynamicSimulatorParams> m_Params;
-    std::vector<ForwardDynamicSimulation> m_Sims;
+    std::optional<BatchSimulation> m_Batch;
 
-    OutputExtractor m_WalltimeExtractor = GetSimulatorOutputExtractor("Wall time");
-    OutputExtractor m_StepsTakenExtractor = GetSimulatorOutputExtractor("NumStepsTaken");
+    std::vector<OutputExtractor> m_SharedOutputs = {
+        GetSimulatorOutputExtractor("Wall time"),
+        GetSimulatorOutputExtractor("NumStepsTaken"),
+    };
+    std::vector<std::string> m_OutputColumnNames = GetOutputColumnNames(m_SharedOutputs);
     ParamBlockEditorPopup m_ParamEditor{"parameditor", &m_BaseParams};
 };
 
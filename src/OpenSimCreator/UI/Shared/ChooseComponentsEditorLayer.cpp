@@ -194,7 +194,7 @@ public:
         );
 
         // render to a texture (no caching)
-        m_Renderer.render(m_Decorations.decorations, rendererParameters);
+        m_Renderer.render(m_Decorations.decorations, rendererParameters, m_Decorations.bvh);
 
         // blit texture as ImGui image
         ui::draw_image(
@@ -155,6 +155,16 @@ void osc::MainMenuFileTab::onDraw(
         }
     }
 
+    if (ui::draw_menu_item(OSC_ICON_FOLDER_OPEN " Resume Simulation from Checkpoint", {}, false, maybeModel != nullptr))
+    {
+        std::optional<std::filesystem::path> maybePath = prompt_user_to_select_file({"oscckpt"});
+        if (maybePath && maybeModel)
+        {
+            ActionResumeSimulationFromCheckpoint(api, *maybeModel, *maybePath);
+        }
+    }
+    ui::draw_tooltip_if_item_hovered("Resume Simulation from Checkpoint", "Resumes a forward-dynamic simulation of the current model from a checkpoint file that was previously saved from a simulation tab (via the Actions menu).");
+
     ui::draw_separator();
 
     if (ui::draw_menu_item(OSC_ICON_SAVE " Save", "Ctrl+S", false, maybeModel != nullptr))
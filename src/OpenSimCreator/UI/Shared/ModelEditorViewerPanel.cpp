@@ -12,6 +12,7 @@
 
 #include <OpenSim/Simulation/Model/Model.h>
 #include <oscar/Maths/MathHelpers.h>
+#include <oscar/Maths/PolarPerspectiveCamera.h>
 #include <oscar/Maths/Rect.h>
 #include <oscar/Maths/Vec3.h>
 #include <oscar/Platform/App.h>
@@ -367,8 +368,9 @@ private:
         m_State.isLeftClickReleasedWithoutDragging = ui::is_mouse_released_without_dragging(ui::MouseButton::Left);
         m_State.isRightClickReleasedWithoutDragging = ui::is_mouse_released_without_dragging(ui::MouseButton::Right);
 
-        // if necessary, auto-focus the camera on the first frame
-        if (m_IsFirstFrame)
+        // if necessary, auto-focus the camera on the first frame (and keep re-focusing it while
+        // the model's meshes are loading, unless the user moves the camera in the meantime)
+        if (m_IsFirstFrame or m_CameraAutoFocusedWhileLoading == m_Parameters.getRenderParams().camera)
         {
             m_State.updRenderer().autoFocusCamera(
                 *m_Parameters.getModelSharedPtr(),
@@ -376,6 +378,14 @@ private:
                 aspect_ratio_of(m_State.viewportRect)
             );
             m_IsFirstFrame = false;
+            m_CameraAutoFocusedWhileLoading.reset();
+            if (m_State.getRenderer().isLoadingMeshes()) {
+                m_CameraAutoFocusedWhileLoading = m_Parameters.getRenderParams().camera;
+            }
+        }
+        else
+        {
+            m_CameraAutoFocusedWhileLoading.reset();
         }
 
         layersOnNewFrame();
@@ -404,6 +414,12 @@ private:
                 dimensions_of(m_State.viewportRect)
             );
 
+            // keep redrawing while meshes are loading in the background, so that they
+            // appear in the scene as soon as they have loaded
+            if (m_State.getRenderer().isLoadingMeshes()) {
+                App::upd().request_redraw();
+            }
+
             // care: hittesting is done here, rather than using ui::is_panel_hovered, because
             // we care about whether the _render_ is hovered, not any part of the window (which
             // may include things like the title bar, etc.
@@ -536,6 +552,7 @@ private:
     ModelEditorViewerPanelState m_State{name()};
     std::vector<std::unique_ptr<ModelEditorViewerPanelLayer>> m_Layers;
     bool m_IsFirstFrame = true;
+    std::optional<PolarPerspectiveCamera> m_CameraAutoFocusedWhileLoading;
     bool m_RenderIsHovered = false;
 };
 
@@ -1,12 +1,14 @@
 #include "Readonly3DModelViewer.h"
 
 #include <OpenSimCreator/Graphics/CachedModelRenderer.h>
+#include <OpenSimCreator/Graphics/DecorationTimelineCache.h>
 #include <OpenSimCreator/Graphics/ModelRendererParams.h>
 #include <OpenSimCreator/UI/Shared/BasicWidgets.h>
 
 #include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Graphics/Scene/SceneCollision.h>
 #include <oscar/Maths/MathHelpers.h>
+#include <oscar/Maths/PolarPerspectiveCamera.h>
 #include <oscar/Platform/App.h>
 #include <oscar/UI/IconCache.h>
 #include <oscar/UI/oscimgui.h>
@@ -62,14 +64,23 @@ public:
 
     std::optional<SceneCollision> onDraw(const IConstModelStatePair& rs)
     {
-        // if this is the first frame being rendered, auto-focus the scene
-        if (!m_MaybeLastHittest)
+        // if this is the first frame being rendered, auto-focus the scene (and keep re-focusing
+        // it while the model's meshes are loading, unless the user moves the camera in the meantime)
+        if (!m_MaybeLastHittest || m_CameraAutoFocusedWhileLoading == m_Params.camera)
         {
             m_CachedModelRenderer.autoFocusCamera(
                 rs,
                 m_Params,
                 aspect_ratio_of(ui::get_content_region_available())
             );
+            m_CameraAutoFocusedWhileLoading.reset();
+            if (m_CachedModelRenderer.isLoadingMeshes()) {
+                m_CameraAutoFocusedWhileLoading = m_Params.camera;
+            }
+        }
+        else
+        {
+            m_CameraAutoFocusedWhileLoading.reset();
         }
 
         // inputs: process inputs, if hovering
@@ -93,6 +104,12 @@ public:
         // blit texture as a ui::Image
         ui::draw_image(render);
 
+        // keep redrawing while meshes are loading in the background, so that they
+        // appear in the scene as soon as they have loaded
+        if (m_CachedModelRenderer.isLoadingMeshes()) {
+            App::upd().request_redraw();
+        }
+
         // update current+retained hittest
         const ui::HittestResult hittest = ui::hittest_last_drawn_item();
         m_MaybeLastHittest = hittest;
@@ -158,6 +175,11 @@ public:
         m_Params.camera = camera;
     }
 
+    void setDecorationTimelineCache(std::shared_ptr<DecorationTimelineCache> timelineCache)
+    {
+        m_CachedModelRenderer.setDecorationTimelineCache(std::move(timelineCache));
+    }
+
 private:
     bool drawRulerButton()
     {
@@ -192,6 +214,9 @@ private:
     // only available after rendering the first frame
     std::optional<ui::HittestResult> m_MaybeLastHittest;
 
+    // set if the camera was auto-focused while meshes were still loading
+    std::optional<PolarPerspectiveCamera> m_CameraAutoFocusedWhileLoading;
+
     // overlay-related data
     std::shared_ptr<IconCache> m_IconCache = App::singleton<IconCache>(
         App::resource_loader().with_prefix("icons/"),
@@ -242,3 +267,8 @@ void osc::Readonly3DModelViewer::setCamera(const PolarPerspectiveCamera& camera)
 {
     m_Impl->setCamera(camera);
 }
+
+void osc::Readonly3DModelViewer::setDecorationTimelineCache(std::shared_ptr<DecorationTimelineCache> timelineCache)
+{
+    m_Impl->setDecorationTimelineCache(std::move(timelineCache));
+}
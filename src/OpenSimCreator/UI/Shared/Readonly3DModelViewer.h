@@ -8,6 +8,7 @@
 #include <optional>
 #include <string_view>
 
+namespace osc { class DecorationTimelineCache; }
 namespace osc { class IConstModelStatePair; }
 namespace osc { struct PolarPerspectiveCamera; }
 
@@ -47,6 +48,7 @@ namespace osc
         std::optional<Rect> getScreenRect() const;
         const PolarPerspectiveCamera& getCamera() const;
         void setCamera(const PolarPerspectiveCamera&);
+        void setDecorationTimelineCache(std::shared_ptr<DecorationTimelineCache>);
 
     private:
         class Impl;
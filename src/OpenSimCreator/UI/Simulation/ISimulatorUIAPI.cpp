@@ -4,35 +4,47 @@
 #include <OpenSimCreator/Documents/Simulation/ISimulation.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationHelpers.h>
 
-#include <OpenSim/Simulation/Model/Model.h>
 #include <oscar/Platform/Log.h>
 #include <oscar/Platform/os.h>
 #include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/CStringView.h>
 
 #include <filesystem>
 #include <fstream>
+#include <ios>
+#include <ostream>
 #include <optional>
 #include <span>
 #include <string>
 #include <string_view>
+#include <vector>
 
 using namespace osc;
 
 namespace
 {
-    std::optional<std::filesystem::path> TryExportOutputsToCSV(
+    using OutputsWriter = void(*)(
+        const ISimulation&,
+        std::span<const OutputExtractor>,
+        std::ostream&
+    );
+
+    std::optional<std::filesystem::path> TryExportOutputs(
         const ISimulation& simulation,
-        std::span<const OutputExtractor> outputs)
+        std::span<const OutputExtractor> outputs,
+        CStringView extension,
+        std::ios_base::openmode openMode,
+        OutputsWriter writer)
     {
         // prompt user for save location
         std::optional<std::filesystem::path> path =
-            prompt_user_for_file_save_location_add_extension_if_necessary("csv");
+            prompt_user_for_file_save_location_add_extension_if_necessary(extension);
         if (not path) {
             return std::nullopt;  // user probably cancelled out
         }
 
         // open output file
-        std::ofstream fout{*path};
+        std::ofstream fout{*path, std::ios_base::out | openMode};
         if (not fout) {
             log_error("%s: error opening file for writing", path->string().c_str());
             return std::nullopt;  // error opening output file for writing
@@ -40,11 +52,27 @@ namespace
         fout.exceptions(std::ios_base::badbit | std::ios_base::failbit);
 
         // write output
-        const auto guard = simulation.getModel();
-        WriteOutputsAsCSV(*guard, outputs, simulation.getAllSimulationReports(), fout);
+        //
+        // the writer is handed the simulation (rather than its reports), so that the
+        // reports can be rebuilt + realized by worker threads, rather than this one
+        writer(simulation, outputs, fout);
 
         return path;
     }
+
+    std::optional<std::filesystem::path> TryExportOutputsToCSV(
+        const ISimulation& simulation,
+        std::span<const OutputExtractor> outputs)
+    {
+        return TryExportOutputs(simulation, outputs, "csv", {}, WriteOutputsAsCSV);
+    }
+
+    std::optional<std::filesystem::path> TryExportOutputsToBinary(
+        const ISimulation& simulation,
+        std::span<const OutputExtractor> outputs)
+    {
+        return TryExportOutputs(simulation, outputs, "oscouts", std::ios_base::binary, WriteOutputsAsBinary);
+    }
 }
 
 std::vector<OutputExtractor> osc::ISimulatorUIAPI::getAllUserOutputExtractors() const
@@ -68,3 +96,27 @@ std::optional<std::filesystem::path> osc::ISimulatorUIAPI::tryPromptToSaveAllOut
 {
     return TryExportOutputsToCSV(getSimulation(), getAllUserOutputExtractors());
 }
+
+std::optional<std::filesystem::path> osc::ISimulatorUIAPI::tryPromptToSaveOutputsAsBinary(std::span<const OutputExtractor> outputs) const
+{
+    return TryExportOutputsToBinary(getSimulation(), outputs);
+}
+
+std::optional<std::filesystem::path> osc::ISimulatorUIAPI::tryPromptToSaveAllOutputsAsBinary() const
+{
+    return TryExportOutputsToBinary(getSimulation(), getAllUserOutputExtractors());
+}
+
+std::optional<std::filesystem::path> osc::ISimulatorUIAPI::tryPromptToStreamAllOutputsAsBinary()
+{
+    std::optional<std::filesystem::path> path =
+        prompt_user_for_file_save_location_add_extension_if_necessary("oscouts");
+    if (not path) {
+        return std::nullopt;  // user probably cancelled out
+    }
+
+    if (not implStartStreamingOutputs(*path, getAllUserOutputExtractors())) {
+        return std::nullopt;
+    }
+    return path;
+}
@@ -66,6 +66,13 @@ namespace osc
             return tryPromptToSaveOutputsAsCSV(std::span<const OutputExtractor>{il});
         }
         std::optional<std::filesystem::path> tryPromptToSaveAllOutputsAsCSV() const;
+        std::optional<std::filesystem::path> tryPromptToSaveOutputsAsBinary(std::span<const OutputExtractor>) const;
+        std::optional<std::filesystem::path> tryPromptToSaveAllOutputsAsBinary() const;
+
+        // streams all outputs to a binary outputs file while the simulation runs (see `SimulationOutputsStreamer`)
+        std::optional<std::filesystem::path> tryPromptToStreamAllOutputsAsBinary();
+        bool isStreamingOutputs() const { return implIsStreamingOutputs(); }
+        void stopStreamingOutputs() { implStopStreamingOutputs(); }
 
         SimulationModelStatePair* tryGetCurrentSimulationState() { return implTryGetCurrentSimulationState(); }
 
@@ -94,5 +101,10 @@ namespace osc
         virtual bool implOverwriteOrAddNewUserOutputExtractor(const OutputExtractor&, const OutputExtractor&) = 0;
 
         virtual SimulationModelStatePair* implTryGetCurrentSimulationState() = 0;
+
+        // returns `false` if streaming couldn't be started (e.g. because the file couldn't be opened)
+        virtual bool implStartStreamingOutputs(const std::filesystem::path&, std::span<const OutputExtractor>) = 0;
+        virtual bool implIsStreamingOutputs() const = 0;
+        virtual void implStopStreamingOutputs() = 0;
     };
 }
@@ -6,6 +6,7 @@
 #include <OpenSimCreator/UI/Shared/BasicWidgets.h>
 #include <OpenSimCreator/UI/Simulation/ISimulatorUIAPI.h>
 #include <OpenSimCreator/UI/Simulation/SimulationOutputPlot.h>
+#include <OpenSimCreator/UI/Simulation/SimulationOutputPlotCache.h>
 
 #include <oscar/Platform/IconCodepoints.h>
 #include <oscar/Platform/os.h>
@@ -41,11 +42,14 @@ public:
 
         StandardPanelImpl{panelName_},
         m_API{mainUIStateAPI_},
-        m_SimulatorUIAPI{simulatorUIAPI_}
+        m_SimulatorUIAPI{simulatorUIAPI_},
+        m_Plots{simulatorUIAPI_}
     {}
 private:
     void impl_draw_content() final
     {
+        m_Plots.onBeginFrame();
+
         if (m_API->getNumUserOutputExtractors() <= 0)
         {
             ui::draw_text_disabled_and_panel_centered("No outputs being watched");
@@ -68,8 +72,28 @@ private:
                     }
                 }
 
+                if (ui::draw_menu_item("as binary")) {
+                    m_SimulatorUIAPI->tryPromptToSaveAllOutputsAsBinary();
+                }
+                ui::draw_tooltip_if_item_hovered("as binary", "Saves the outputs in a lossless, columnar, binary format (.oscouts), which is faster to write and read than CSV, and can be memory-mapped by external tools.");
+
+                if (not m_SimulatorUIAPI->isStreamingOutputs()) {
+                    if (ui::draw_menu_item("as binary (streaming)")) {
+                        m_SimulatorUIAPI->tryPromptToStreamAllOutputsAsBinary();
+                    }
+                    ui::draw_tooltip_if_item_hovered("as binary (streaming)", "Saves the outputs in the binary format (.oscouts) and then keeps appending new outputs to the file while the simulation runs, so that external tools can read them before the simulation finishes.\n\nThe file contains the outputs that were being watched when streaming started.");
+                }
+                else if (ui::draw_menu_item("stop streaming")) {
+                    m_SimulatorUIAPI->stopStreamingOutputs();
+                }
+
                 ui::end_popup();
             }
+
+            if (m_SimulatorUIAPI->isStreamingOutputs()) {
+                ui::same_line();
+                ui::draw_text_disabled("(streaming outputs to disk)");
+            }
         }
 
         ui::draw_separator();
@@ -80,8 +104,7 @@ private:
             OutputExtractor output = m_API->getUserOutputExtractor(i);
 
             ui::push_id(i);
-            SimulationOutputPlot plot{m_SimulatorUIAPI, output, 128.0f};
-            plot.onDraw();
+            m_Plots.updPlot(output, 128.0f).onDraw();
 
             DrawOutputNameColumn(output, true, m_SimulatorUIAPI->tryGetCurrentSimulationState());
             ui::same_line();
@@ -95,6 +118,7 @@ private:
 
     ParentPtr<IMainUIStateAPI> m_API;
     ISimulatorUIAPI* m_SimulatorUIAPI;
+    SimulationOutputPlotCache m_Plots;
 };
 
 osc::OutputPlotsPanel::OutputPlotsPanel(
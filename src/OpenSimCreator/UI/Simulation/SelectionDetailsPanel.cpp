@@ -4,6 +4,7 @@
 #include <OpenSimCreator/Documents/Simulation/SimulationModelStatePair.h>
 #include <OpenSimCreator/UI/Simulation/ISimulatorUIAPI.h>
 #include <OpenSimCreator/UI/Simulation/SimulationOutputPlot.h>
+#include <OpenSimCreator/UI/Simulation/SimulationOutputPlotCache.h>
 #include <OpenSimCreator/Utils/OpenSimHelpers.h>
 
 #include <OpenSim/Common/Component.h>
@@ -23,12 +24,15 @@ public:
         ISimulatorUIAPI* simulatorUIAPI) :
 
         StandardPanelImpl{panelName},
-        m_SimulatorUIAPI{simulatorUIAPI}
+        m_SimulatorUIAPI{simulatorUIAPI},
+        m_Plots{simulatorUIAPI}
     {}
 
 private:
     void impl_draw_content() final
     {
+        m_Plots.onBeginFrame();
+
         SimulationModelStatePair* maybeShownState = m_SimulatorUIAPI->tryGetCurrentSimulationState();
         if (not maybeShownState) {
             ui::draw_text_disabled("(no simulation selected)");
@@ -83,12 +87,10 @@ private:
 
                 ui::draw_text(outputName);
                 ui::next_column();
-                SimulationOutputPlot plot{
-                    m_SimulatorUIAPI,
+                m_Plots.updPlot(
                     OutputExtractor{ComponentOutputExtractor{*aoPtr}},
-                    ui::get_text_line_height(),
-                };
-                plot.onDraw();
+                    ui::get_text_line_height()
+                ).onDraw();
                 ui::next_column();
 
                 ui::pop_id();
@@ -191,6 +193,7 @@ private:
     }
 
     ISimulatorUIAPI* m_SimulatorUIAPI;
+    SimulationOutputPlotCache m_Plots;
 };
 
 osc::SelectionDetailsPanel::SelectionDetailsPanel(std::string_view panelName, ISimulatorUIAPI* simulatorUIAPI) :
@@ -5,6 +5,7 @@
 #include <OpenSimCreator/UI/Shared/BasicWidgets.h>
 #include <OpenSimCreator/UI/Simulation/ISimulatorUIAPI.h>
 #include <OpenSimCreator/UI/Simulation/SimulationOutputPlot.h>
+#include <OpenSimCreator/UI/Simulation/SimulationOutputPlotCache.h>
 
 #include <oscar/Platform/IconCodepoints.h>
 #include <oscar/Platform/os.h>
@@ -31,12 +32,15 @@ public:
 
         StandardPanelImpl{panelName},
         m_SimulatorUIAPI{simulatorUIAPI},
-        m_Simulation{std::move(simulation)}
+        m_Simulation{std::move(simulation)},
+        m_Plots{simulatorUIAPI}
     {}
 
 private:
     void impl_draw_content() final
     {
+        m_Plots.onBeginFrame();
+
         {
             ui::draw_dummy({0.0f, 1.0f});
             ui::draw_text_unformatted("info:");
@@ -99,6 +103,11 @@ private:
                     }
                 }
 
+                if (ui::draw_menu_item("as binary"))
+                {
+                    m_SimulatorUIAPI->tryPromptToSaveOutputsAsBinary(outputs);
+                }
+
                 ui::end_popup();
             }
         }
@@ -114,8 +123,7 @@ private:
             ui::push_id(imguiID++);
             DrawOutputNameColumn(output, false);
             ui::next_column();
-            SimulationOutputPlot plot{m_SimulatorUIAPI, output, 32.0f};
-            plot.onDraw();
+            m_Plots.updPlot(output, 32.0f).onDraw();
             ui::next_column();
             ui::pop_id();
         }
@@ -124,6 +132,7 @@ private:
 
     ISimulatorUIAPI* m_SimulatorUIAPI;
     std::shared_ptr<const Simulation> m_Simulation;
+    SimulationOutputPlotCache m_Plots;
 };
 
 
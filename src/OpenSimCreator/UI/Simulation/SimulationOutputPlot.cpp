@@ -5,6 +5,7 @@
 #include <OpenSimCreator/Documents/OutputExtractors/ConcatenatingOutputExtractor.h>
 #include <OpenSimCreator/Documents/OutputExtractors/IOutputExtractor.h>
 #include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/BinaryOutputs.h>
 #include <OpenSimCreator/Documents/Simulation/ISimulation.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
@@ -16,6 +17,7 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <oscar/Graphics/Color.h>
 #include <oscar/Maths/MathHelpers.h>
+#include <oscar/Maths/MinMaxPyramid.h>
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Platform/IconCodepoints.h>
 #include <oscar/Platform/Log.h>
@@ -25,11 +27,14 @@
 #include <oscar/Utils/Assertions.h>
 #include <oscar/Utils/EnumHelpers.h>
 #include <oscar/Utils/Perf.h>
+#include <oscar/Utils/UID.h>
 
 #include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <filesystem>
 #include <functional>
 #include <optional>
 #include <ostream>
@@ -44,6 +49,75 @@ namespace plot = osc::ui::plot;
 
 namespace
 {
+    // the maximum number of reports that are rebuilt + realized at once when a plot
+    // extracts values from a simulation's reports
+    constexpr size_t c_NumReportsPerExtractionBatch = 256;
+
+    // the maximum number of (min+max) buckets that an overlay is decimated to when it's loaded
+    constexpr size_t c_MaxOverlayBuckets = 2048;
+
+    // a column of a binary outputs file (e.g. the outputs of a previous simulation) that's
+    // drawn over a plot
+    struct OutputPlotOverlay final {
+        std::filesystem::path path;
+        std::vector<Vec2> points;  // `(time, value)`, decimated
+    };
+
+    // tries to load the column that has the same name as `output` from the given binary outputs file
+    std::optional<OutputPlotOverlay> TryLoadOverlay(
+        const std::filesystem::path& path,
+        const OutputExtractor& output)
+    {
+        try {
+            const BinaryOutputsFile file{path};
+            const std::optional<size_t> column = file.findOutputColumn(output.getName());
+            if (not column) {
+                log_error("%s: does not contain an output called '%s'", path.string().c_str(), std::string{output.getName()}.c_str());
+                return std::nullopt;
+            }
+
+            // decimate the values straight out of the (memory-mapped) file's blocks
+            MinMaxPyramid values;
+            std::vector<double> times;
+            times.reserve(file.getNumRows());
+            for (size_t block = 0; block < file.getNumBlocks(); ++block) {
+                values.append(file.getOutputColumnValues(block, *column));
+                const std::span<const double> blockTimes = file.getTimes(block);
+                times.insert(times.end(), blockTimes.begin(), blockTimes.end());
+            }
+
+            OutputPlotOverlay rv{.path = path, .points = {}};
+            values.decimate(c_MaxOverlayBuckets, rv.points);
+            for (Vec2& point : rv.points) {
+                point.x = static_cast<float>(times[static_cast<size_t>(point.x)]);  // index --> time
+            }
+            return rv;
+        }
+        catch (const std::exception& ex) {
+            log_error("%s: error loading overlay: %s", path.string().c_str(), ex.what());
+            return std::nullopt;
+        }
+    }
+
+    // draw menu items for overlaying an output from a binary outputs file over the plot
+    void DrawOverlayMenuItems(
+        const OutputExtractor& output,
+        std::optional<OutputPlotOverlay>& overlay)
+    {
+        if (ui::draw_menu_item(OSC_ICON_FILE_IMPORT " Import Overlay (.oscouts)")) {
+            if (const auto path = prompt_user_to_select_file({"oscouts"})) {
+                if (std::optional<OutputPlotOverlay> loaded = TryLoadOverlay(*path, output)) {
+                    overlay = std::move(loaded);
+                }
+            }
+        }
+        ui::draw_tooltip_if_item_hovered("Import Overlay (.oscouts)", "Draws the output with the same name from a binary outputs file (e.g. one that was saved from a previous simulation) over this plot, so that the simulations can be compared.");
+
+        if (overlay and ui::draw_menu_item(OSC_ICON_TIMES " Clear Overlay")) {
+            overlay.reset();
+        }
+    }
+
     // draw a menu item for toggling watching the output
     void DrawToggleWatchOutputMenuItem(
         ISimulatorUIAPI& api,
@@ -138,7 +212,8 @@ namespace
     void TryDrawOutputContextMenuForLastItem(
         ISimulatorUIAPI& api,
         ISimulation& sim,
-        const OutputExtractor& output)
+        const OutputExtractor& output,
+        std::optional<OutputPlotOverlay>* overlay = nullptr)
     {
         if (not ui::begin_popup_context_menu("outputplotmenu")) {
             return;  // menu not open
@@ -149,6 +224,9 @@ namespace
         if (dataType == OutputExtractorDataType::Float) {
             DrawExportToCSVMenuItems(api, output);
             DrawPlotAgainstOtherOutputMenuItem(api, sim, output);
+            if (overlay) {
+                DrawOverlayMenuItems(output, *overlay);
+            }
             DrawToggleWatchOutputMenuItem(api, output);
         }
         else if (dataType == OutputExtractorDataType::Vec2) {
@@ -197,6 +275,46 @@ public:
         }
     }
 
+    size_t syncNumCachedReports(const ISimulation& sim)
+    {
+        const size_t nReports = sim.getNumReports();
+        const UID reportsGeneration = sim.getReportsGeneration();
+        if (reportsGeneration != m_CachedReportsGeneration or nReports < m_NumCachedReports) {
+            // the simulation was swapped, or its reports were truncated/replaced: re-extract everything
+            m_CachedReportsGeneration = reportsGeneration;
+            m_NumCachedReports = 0;
+            m_CachedFloatValues.clear();
+            m_CachedVec2Values.clear();
+        }
+
+        static_assert(num_options<OutputExtractorDataType>() == 3);
+        if (m_OutputExtractor.getOutputType() == OutputExtractorDataType::String) {
+            m_NumCachedReports = nReports;  // nothing to cache: strings are extracted when drawn
+        }
+        return m_NumCachedReports;
+    }
+
+    void appendCachedValues(
+        const OpenSim::Model& model,
+        size_t firstReportIndex,
+        std::span<const SimulationReport> reports)
+    {
+        if (firstReportIndex > m_NumCachedReports or firstReportIndex + reports.size() <= m_NumCachedReports) {
+            return;  // the reports don't continue on from what's already cached
+        }
+        const std::span<const SimulationReport> newReports = reports.subspan(m_NumCachedReports - firstReportIndex);
+
+        static_assert(num_options<OutputExtractorDataType>() == 3);
+        if (m_OutputExtractor.getOutputType() == OutputExtractorDataType::Float) {
+            m_CachedFloatValues.append(m_OutputExtractor.slurpValuesFloat(model, newReports));
+        }
+        else if (m_OutputExtractor.getOutputType() == OutputExtractorDataType::Vec2) {
+            const std::vector<Vec2> values = m_OutputExtractor.slurpValuesVec2(model, newReports);
+            m_CachedVec2Values.insert(m_CachedVec2Values.end(), values.begin(), values.end());
+        }
+        m_NumCachedReports += newReports.size();
+    }
+
 private:
     void drawFloatOutputUI()
     {
@@ -211,18 +329,24 @@ private:
         }
 
         // collect output data from the `OutputExtractor`
-        std::vector<float> buf;
         {
             OSC_PERF("collect output data");
-            const std::vector<SimulationReport> reports = sim.getAllSimulationReports();
-            buf = m_OutputExtractor.slurpValuesFloat(*sim.getModel(), reports);
+            updateCachedValues(sim);
         }
+        const MinMaxPyramid& buf = m_CachedFloatValues;
 
         // setup drawing area for drawing
         ui::set_next_item_width(ui::get_content_region_available().x);
         const float plotWidth = ui::get_content_region_available().x;
         Rect plotRect{};
 
+        // decimate the series to (at most) one min+max pair per horizontal pixel, so that
+        // drawing the plot doesn't scale with the length of the simulation
+        {
+            OSC_PERF("decimate output data");
+            buf.decimate(static_cast<size_t>(std::max(plotWidth, 1.0f)), m_DecimatedFloatPoints);
+        }
+
         // draw the plot
         {
             OSC_PERF("draw output plot");
@@ -237,10 +361,14 @@ private:
                 plot::setup_axis(plot::Axis::Y1, std::nullopt, plot::AxisFlags::NoDecorations | plot::AxisFlags::NoMenus | plot::AxisFlags::AutoFit);
                 plot::push_style_color(plot::PlotColorVar::Line, Color::white().with_alpha(0.7f));
                 plot::push_style_color(plot::PlotColorVar::PlotBackground, Color::clear());
-                plot::plot_line("##", buf);
+                plot::plot_line("##", m_DecimatedFloatPoints);
                 plot::pop_style_color();
                 plot::pop_style_color();
 
+                if (m_Overlay) {
+                    drawOverlay(sim, nReports);
+                }
+
                 plotRect = plot::get_plot_screen_rect();
 
                 plot::end();
@@ -251,15 +379,15 @@ private:
         }
 
         // if the user right-clicks, draw a context menu
-        TryDrawOutputContextMenuForLastItem(*m_API, sim, m_OutputExtractor);
+        TryDrawOutputContextMenuForLastItem(*m_API, sim, m_OutputExtractor, &m_Overlay);
 
         // (the rest): handle scrubber overlay
         OSC_PERF("draw output plot overlay");
 
         // figure out mapping between screen space and plot space
 
-        SimulationClock::time_point simStartTime = sim.getSimulationReport(0).getTime();
-        SimulationClock::time_point simEndTime = sim.getSimulationReport(nReports-1).getTime();
+        SimulationClock::time_point simStartTime = sim.getSimulationReportTime(0);
+        SimulationClock::time_point simEndTime = sim.getSimulationReportTime(nReports-1);
         SimulationClock::duration simTimeStep = (simEndTime-simStartTime)/nReports;
         SimulationClock::time_point simScrubTime = m_API->getSimulationScrubTime();
 
@@ -311,6 +439,32 @@ private:
         }
     }
 
+    // draws the overlay in the plot's (report index) space, by mapping its times onto the
+    // simulation's (approximately evenly-spaced) reports
+    void drawOverlay(const ISimulation& sim, ptrdiff_t nReports)
+    {
+        if (nReports < 2) {
+            return;  // can't map times onto report indices
+        }
+        const double simStartTime = sim.getSimulationReportTime(0).time_since_epoch().count();
+        const double simEndTime = sim.getSimulationReportTime(nReports-1).time_since_epoch().count();
+        if (simEndTime <= simStartTime) {
+            return;
+        }
+        const double indicesPerSecond = static_cast<double>(nReports - 1) / (simEndTime - simStartTime);
+
+        m_OverlayPlotPoints.clear();
+        m_OverlayPlotPoints.reserve(m_Overlay->points.size());
+        for (const Vec2& point : m_Overlay->points) {
+            const double index = (static_cast<double>(point.x) - simStartTime) * indicesPerSecond;
+            m_OverlayPlotPoints.emplace_back(static_cast<float>(index), point.y);
+        }
+
+        plot::push_style_color(plot::PlotColorVar::Line, Color::orange().with_alpha(0.7f));
+        plot::plot_line("##overlay", m_OverlayPlotPoints);
+        plot::pop_style_color();
+    }
+
     void drawStringOutputUI()
     {
         ISimulation& sim = m_API->updSimulation();
@@ -334,12 +488,11 @@ private:
         }
 
         // collect output data from the `OutputExtractor`
-        std::vector<Vec2> buf;
         {
             OSC_PERF("collect output data");
-            std::vector<SimulationReport> reports = sim.getAllSimulationReports();
-            buf = m_OutputExtractor.slurpValuesVec2(*sim.getModel(), reports);
+            updateCachedValues(sim);
         }
+        const std::vector<Vec2>& buf = m_CachedVec2Values;
 
         // setup drawing area for drawing
         ui::set_next_item_width(ui::get_content_region_available().x);
@@ -389,9 +542,37 @@ private:
         TryDrawOutputContextMenuForLastItem(*m_API, sim, m_OutputExtractor);
     }
 
+    // incrementally extracts output values from any reports that the simulation has
+    // produced since the last call, so that each report is only rebuilt and extracted
+    // once, rather than once per frame
+    //
+    // usually, `SimulationOutputPlotCache` has already done this (for all of its plots
+    // at once) by the time the plot is drawn, so this only does anything the first time
+    // a plot is drawn
+    void updateCachedValues(ISimulation& sim)
+    {
+        const size_t nReports = sim.getNumReports();
+        for (size_t begin = syncNumCachedReports(sim); begin < nReports; begin += c_NumReportsPerExtractionBatch) {
+            const size_t end = std::min(begin + c_NumReportsPerExtractionBatch, nReports);
+
+            // care: the reports must be acquired *before* locking the model, because
+            // acquiring reports may require (briefly) locking the model
+            const std::vector<SimulationReport> reports = sim.getSimulationReports(static_cast<ptrdiff_t>(begin), static_cast<ptrdiff_t>(end));
+            appendCachedValues(*sim.getModel(), begin, reports);
+        }
+    }
+
     ISimulatorUIAPI* m_API;
     OutputExtractor m_OutputExtractor;
     float m_Height;
+
+    UID m_CachedReportsGeneration = UID::empty();  // the `ISimulation::getReportsGeneration` that the cached values were extracted from
+    size_t m_NumCachedReports = 0;
+    MinMaxPyramid m_CachedFloatValues;
+    std::vector<Vec2> m_CachedVec2Values;
+    std::vector<Vec2> m_DecimatedFloatPoints;  // reused between frames, to avoid reallocating
+    std::optional<OutputPlotOverlay> m_Overlay;
+    std::vector<Vec2> m_OverlayPlotPoints;  // reused between frames, to avoid reallocating
 };
 
 
@@ -411,3 +592,16 @@ void osc::SimulationOutputPlot::onDraw()
 {
     m_Impl->onDraw();
 }
+
+size_t osc::SimulationOutputPlot::syncNumCachedReports(const ISimulation& sim)
+{
+    return m_Impl->syncNumCachedReports(sim);
+}
+
+void osc::SimulationOutputPlot::appendCachedValues(
+    const OpenSim::Model& model,
+    size_t firstReportIndex,
+    std::span<const SimulationReport> reports)
+{
+    m_Impl->appendCachedValues(model, firstReportIndex, reports);
+}
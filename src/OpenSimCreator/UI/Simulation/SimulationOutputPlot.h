@@ -2,11 +2,15 @@
 
 #include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
 
+#include <cstddef>
 #include <filesystem>
 #include <memory>
 #include <span>
 
+namespace OpenSim { class Model; }
+namespace osc { class ISimulation; }
 namespace osc { class ISimulatorUIAPI; }
+namespace osc { class SimulationReport; }
 
 namespace osc
 {
@@ -25,6 +29,25 @@ namespace osc
 
         void onDraw();
 
+        // returns the number of the simulation's reports that the plot has already extracted
+        // values from (i.e. the index of the first report that it still needs)
+        //
+        // resets the plot's extracted values if the simulation was swapped, or its reports were
+        // truncated, since values were last extracted (see `ISimulation::getReportsGeneration`)
+        size_t syncNumCachedReports(const ISimulation&);
+
+        // extracts values from the given (realized) reports, which are the simulation's reports
+        // `[firstReportIndex, firstReportIndex + reports.size())`, skipping any reports that the
+        // plot already has values for
+        //
+        // this is how `SimulationOutputPlotCache` extracts values for many plots in one pass
+        // over the simulation's reports, rather than one pass per plot
+        void appendCachedValues(
+            const OpenSim::Model&,
+            size_t firstReportIndex,
+            std::span<const SimulationReport> reports
+        );
+
     private:
         class Impl;
         std::unique_ptr<Impl> m_Impl;
@@ -0,0 +1,70 @@
+#include "SimulationOutputPlotCache.h"
+
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/ISimulation.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/UI/Simulation/ISimulatorUIAPI.h>
+#include <OpenSimCreator/UI/Simulation/SimulationOutputPlot.h>
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // the maximum number of reports that are rebuilt + realized at once when the
+    // cache extracts values for its plots
+    constexpr size_t c_NumReportsPerExtractionBatch = 256;
+}
+
+osc::SimulationOutputPlotCache::SimulationOutputPlotCache(ISimulatorUIAPI* api) :
+    m_API{api}
+{}
+
+void osc::SimulationOutputPlotCache::onBeginFrame()
+{
+    // anything left in the previous frame's plots wasn't requested last frame
+    m_PreviousFramePlots = std::exchange(m_Plots, {});
+
+    if (m_PreviousFramePlots.empty()) {
+        return;
+    }
+
+    ISimulation& sim = m_API->updSimulation();
+    const size_t numReports = sim.getNumReports();
+
+    size_t firstMissingReport = numReports;
+    for (auto& [output, plot] : m_PreviousFramePlots) {
+        firstMissingReport = std::min(firstMissingReport, plot.syncNumCachedReports(sim));
+    }
+
+    for (size_t begin = firstMissingReport; begin < numReports; begin += c_NumReportsPerExtractionBatch) {
+        const size_t end = std::min(begin + c_NumReportsPerExtractionBatch, numReports);
+
+        // care: the reports must be acquired *before* locking the model, because
+        // acquiring reports may require (briefly) locking the model
+        const std::vector<SimulationReport> reports = sim.getSimulationReports(static_cast<ptrdiff_t>(begin), static_cast<ptrdiff_t>(end));
+        const auto model = sim.getModel();
+        for (auto& [output, plot] : m_PreviousFramePlots) {
+            plot.appendCachedValues(*model, begin, reports);
+        }
+    }
+}
+
+SimulationOutputPlot& osc::SimulationOutputPlotCache::updPlot(const OutputExtractor& output, float height)
+{
+    if (const auto it = m_Plots.find(output); it != m_Plots.end()) {
+        return it->second;
+    }
+
+    if (auto node = m_PreviousFramePlots.extract(output)) {
+        return m_Plots.insert(std::move(node)).position->second;
+    }
+
+    return m_Plots.try_emplace(output, m_API, output, height).first->second;
+}
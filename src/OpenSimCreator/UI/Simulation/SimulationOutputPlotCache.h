@@ -0,0 +1,38 @@
+#pragma once
+
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/UI/Simulation/SimulationOutputPlot.h>
+
+#include <unordered_map>
+
+namespace osc { class ISimulatorUIAPI; }
+
+namespace osc
+{
+    // a cache of `SimulationOutputPlot`s, keyed by the output they're plotting
+    //
+    // plots incrementally cache (and decimate) the values they extract from the simulation,
+    // so UI panels should keep them alive between frames, rather than creating new ones
+    // each frame. Plots that weren't requested in the previous frame are dropped when a
+    // new frame begins, so that the cache doesn't grow as the user changes what's shown
+    class SimulationOutputPlotCache final {
+    public:
+        explicit SimulationOutputPlotCache(ISimulatorUIAPI*);
+
+        // should be called once at the start of each frame, before any calls to `updPlot`
+        //
+        // extracts values from any new simulation reports for all of the previous frame's
+        // plots in one pass, so that each new report is only rebuilt + realized once per
+        // frame, rather than once per plot
+        void onBeginFrame();
+
+        // returns a plot for the given output, creating one (with the given height) if the
+        // output wasn't plotted in the previous frame
+        SimulationOutputPlot& updPlot(const OutputExtractor&, float height);
+
+    private:
+        ISimulatorUIAPI* m_API;
+        std::unordered_map<OutputExtractor, SimulationOutputPlot> m_Plots;
+        std::unordered_map<OutputExtractor, SimulationOutputPlot> m_PreviousFramePlots;
+    };
+}
@@ -5,8 +5,10 @@
 #include <OpenSimCreator/Documents/Simulation/ISimulation.h>
 #include <OpenSimCreator/Documents/Simulation/Simulation.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationHelpers.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationModelStatePair.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Graphics/DecorationTimelineCache.h>
 #include <OpenSimCreator/UI/IMainUIStateAPI.h>
 #include <OpenSimCreator/UI/Shared/BasicWidgets.h>
 #include <OpenSimCreator/UI/Shared/NavigatorPanel.h>
@@ -24,9 +26,11 @@
 
 #include <OpenSim/Common/Component.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Platform/App.h>
 #include <oscar/Platform/Event.h>
 #include <oscar/Platform/IconCodepoints.h>
+#include <oscar/Platform/Log.h>
 #include <oscar/Platform/os.h>
 #include <oscar/UI/oscimgui.h>
 #include <oscar/UI/Panels/LogViewerPanel.h>
@@ -40,8 +44,12 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <cstdio>
+#include <exception>
 #include <filesystem>
+#include <fstream>
+#include <ios>
 #include <memory>
 #include <optional>
 #include <span>
@@ -159,6 +167,7 @@ public:
                         popup->open();
                         m_PopupManager.push_back(std::move(popup));
                     },
+                    m_DecorationTimelineCache,
                 };
 
                 return std::make_shared<SimulationViewerPanel>(panelName, std::move(params));
@@ -192,6 +201,11 @@ public:
 
     void on_tick()
     {
+        // collect reports once per frame (even when the tab isn't shown) so that
+        // the simulator never has to wait on a full report queue for long
+        m_Simulation->pollNewReports();
+        writeNewReportsToOutputsStream();
+
         if (m_PlaybackState == SimulationUIPlaybackState::Playing) {
 
             const SimulationClock::time_point playbackPos = implGetSimulationScrubTime();
@@ -258,7 +272,9 @@ private:
         }
     }
 
-    std::optional<SimulationReport> tryFindNthReportAfter(SimulationClock::time_point t, int offset = 0)
+    // returns the index of the first report at or after `t` (or the last report, if there
+    // isn't one), or `std::nullopt` if there are no reports
+    std::optional<ptrdiff_t> tryFindReportIndexAfter(SimulationClock::time_point t)
     {
         const ptrdiff_t numSimulationReports = m_Simulation->getNumReports();
 
@@ -267,19 +283,25 @@ private:
             return std::nullopt;
         }
 
-        ptrdiff_t zeroethReportIndex = static_cast<ptrdiff_t>(numSimulationReports) - 1;
         for (ptrdiff_t i = 0; i < numSimulationReports; ++i)
         {
-            SimulationReport r = m_Simulation->getSimulationReport(i);
-            if (r.getTime() >= t)
+            if (m_Simulation->getSimulationReportTime(i) >= t)
             {
-                zeroethReportIndex = i;
-                break;
+                return i;
             }
         }
+        return numSimulationReports - 1;
+    }
 
-        const ptrdiff_t reportIndex = zeroethReportIndex + offset;
-        if (0 <= reportIndex && reportIndex < numSimulationReports) {
+    std::optional<SimulationReport> tryFindNthReportAfter(SimulationClock::time_point t, int offset = 0)
+    {
+        const std::optional<ptrdiff_t> zeroethReportIndex = tryFindReportIndexAfter(t);
+        if (not zeroethReportIndex) {
+            return std::nullopt;
+        }
+
+        const ptrdiff_t reportIndex = *zeroethReportIndex + offset;
+        if (0 <= reportIndex && reportIndex < static_cast<ptrdiff_t>(m_Simulation->getNumReports())) {
             return m_Simulation->getSimulationReport(reportIndex);
         }
         else {
@@ -287,6 +309,35 @@ private:
         }
     }
 
+    // tells the decoration cache which reports are likely to be shown next (i.e. the ones after
+    // the playhead, in the playback direction), so that it can pre-generate their decorations
+    //
+    // only the reports' indices are collected: the cache's worker rebuilds/realizes the reports
+    // itself (and only if prefetching is enabled)
+    void updateUpcomingReports()
+    {
+        if (not m_DecorationTimelineCache->isPrefetching()) {
+            return;
+        }
+
+        const std::optional<ptrdiff_t> currentReportIndex = tryFindReportIndexAfter(getSimulationScrubTime());
+        if (not currentReportIndex) {
+            return;
+        }
+
+        const ptrdiff_t numSimulationReports = m_Simulation->getNumReports();
+        const ptrdiff_t step = m_PlaybackSpeed < 0.0f ? -1 : 1;
+
+        std::vector<ptrdiff_t> upcoming;
+        upcoming.reserve(c_NumUpcomingReportsToPrefetch);
+        for (ptrdiff_t i = *currentReportIndex + step;
+             0 <= i and i < numSimulationReports and upcoming.size() < c_NumUpcomingReportsToPrefetch;
+             i += step) {
+            upcoming.push_back(i);
+        }
+        m_DecorationTimelineCache->setUpcomingReports(m_Simulation, std::move(upcoming));
+    }
+
     const ISimulation& implGetSimulation() const final
     {
         return *m_Simulation;
@@ -352,8 +403,8 @@ private:
 
             const SimulationClock::duration simDur = m_PlaybackSpeed * SimulationClock::duration{wallDur};
             const SimulationClock::time_point simNow = m_PlaybackStartSimtime + simDur;
-            const SimulationClock::time_point simEarliest = m_Simulation->getSimulationReport(0).getTime();
-            const SimulationClock::time_point simLatest = m_Simulation->getSimulationReport(nReports - 1).getTime();
+            const SimulationClock::time_point simEarliest = m_Simulation->getSimulationReportTime(0);
+            const SimulationClock::time_point simLatest = m_Simulation->getSimulationReportTime(nReports - 1);
 
             if (simNow < simEarliest) {
                 return simEarliest;
@@ -434,6 +485,59 @@ private:
         return m_ShownModelState.get();
     }
 
+    bool implStartStreamingOutputs(const std::filesystem::path& path, std::span<const OutputExtractor> outputs) final
+    {
+        implStopStreamingOutputs();
+
+        auto file = std::make_unique<std::ofstream>(path, std::ios_base::out | std::ios_base::binary);
+        if (not *file) {
+            log_error("%s: error opening file for writing", path.string().c_str());
+            return false;
+        }
+        file->exceptions(std::ios_base::badbit | std::ios_base::failbit);
+
+        try {
+            m_OutputsStreamer.emplace(*file, std::vector<OutputExtractor>(outputs.begin(), outputs.end()));
+        }
+        catch (const std::exception& ex) {
+            log_error("%s: error writing outputs: %s", path.string().c_str(), ex.what());
+            return false;
+        }
+        m_OutputsStreamFile = std::move(file);
+        m_OutputsStreamPath = path;
+
+        writeNewReportsToOutputsStream();  // i.e. catch up on the reports that were already collected
+        return true;
+    }
+
+    bool implIsStreamingOutputs() const final
+    {
+        return m_OutputsStreamer.has_value();
+    }
+
+    void implStopStreamingOutputs() final
+    {
+        m_OutputsStreamer.reset();
+        m_OutputsStreamFile.reset();
+        m_OutputsStreamPath.clear();
+    }
+
+    // appends any newly-collected reports to the outputs stream (if the outputs are being streamed)
+    void writeNewReportsToOutputsStream()
+    {
+        if (not m_OutputsStreamer) {
+            return;
+        }
+
+        try {
+            m_OutputsStreamer->writeNewReports(*m_Simulation);
+        }
+        catch (const std::exception& ex) {
+            log_error("%s: error streaming outputs (streaming has been stopped): %s", m_OutputsStreamPath.string().c_str(), ex.what());
+            implStopStreamingOutputs();
+        }
+    }
+
     void drawContent()
     {
         m_Toolbar.onDraw();
@@ -444,6 +548,7 @@ private:
         {
             m_ShownModelState->setSimulation(m_Simulation);
             m_ShownModelState->setSimulationReport(*maybeReport);
+            updateUpcomingReports();
 
             OSC_PERF("draw simulation screen");
             m_PanelManager->on_draw();
@@ -477,6 +582,12 @@ private:
     // if possible (i.e. there's a simulation report available), will be set each frame
     std::shared_ptr<SimulationModelStatePair> m_ShownModelState = std::make_shared<SimulationModelStatePair>();
 
+    // background-populated cache of the decorations of reports that are likely to be shown next
+    static constexpr size_t c_NumUpcomingReportsToPrefetch = 256;
+    std::shared_ptr<DecorationTimelineCache> m_DecorationTimelineCache = std::make_shared<DecorationTimelineCache>(
+        App::singleton<SceneCache>(App::resource_loader())
+    );
+
     // scrubbing state
     SimulationUIPlaybackState m_PlaybackState = SimulationUIPlaybackState::Playing;
     SimulationUILoopingState m_LoopingState = SimulationUILoopingState::PlayOnce;
@@ -493,6 +604,13 @@ private:
 
     // manager for popups that are open in this tab
     PopupManager m_PopupManager;
+
+    // (if the user is streaming outputs) the file that outputs are being streamed to
+    //
+    // care: the file must outlive the streamer, which writes into it
+    std::filesystem::path m_OutputsStreamPath;
+    std::unique_ptr<std::ofstream> m_OutputsStreamFile;
+    std::optional<SimulationOutputsStreamer> m_OutputsStreamer;
 };
 
 
@@ -1,18 +1,58 @@
 #include "SimulationTabMainMenu.h"
 
 #include <OpenSimCreator/Documents/Simulation/Simulation.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationCheckpoint.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
 #include <OpenSimCreator/UI/Shared/MainMenu.h>
 
+#include <oscar/Platform/Log.h>
+#include <oscar/Platform/os.h>
 #include <oscar/UI/Panels/PanelManager.h>
 #include <oscar/UI/Widgets/WindowMenu.h>
 #include <oscar/UI/oscimgui.h>
 #include <oscar/Utils/ParentPtr.h>
 
+#include <exception>
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <optional>
 #include <utility>
 
 using namespace osc;
 
+namespace
+{
+    // prompts the user for a save location and then writes the simulation's latest
+    // checkpoint to it
+    void TryPromptUserToSaveLatestCheckpoint(const Simulation& simulation)
+    {
+        const std::optional<SimulationCheckpoint> checkpoint = simulation.getLatestCheckpoint();
+        if (not checkpoint) {
+            return;
+        }
+
+        const std::optional<std::filesystem::path> path =
+            prompt_user_for_file_save_location_add_extension_if_necessary("oscckpt");
+        if (not path) {
+            return;  // user probably cancelled out
+        }
+
+        try {
+            std::ofstream fout{*path};
+            if (not fout) {
+                log_error("%s: error opening file for writing", path->string().c_str());
+                return;
+            }
+            WriteSimulationCheckpoint(fout, *checkpoint);
+            log_info("%s: saved simulation checkpoint", path->string().c_str());
+        }
+        catch (const std::exception& ex) {
+            log_error("%s: error writing simulation checkpoint: %s", path->string().c_str(), ex.what());
+        }
+    }
+}
+
 class osc::SimulationTabMainMenu::Impl final {
 public:
     Impl(
@@ -40,6 +80,23 @@ private:
             return;
         }
 
+        if (ui::draw_menu_item("Stop Simulation", {}, false, IsActive(m_Simulation->getStatus()))) {
+            m_Simulation->requestStop();
+        }
+
+        if (ui::draw_menu_item("Resume Simulation", {}, false, m_Simulation->canResume())) {
+            m_Simulation->resume();
+        }
+        ui::draw_tooltip_if_item_hovered("Resume Simulation", "Continues a stopped simulation from its latest report, rather than re-running it from the start");
+
+        // note: only "live" simulations (i.e. ones that can change their end time) can be checkpointed
+        if (ui::draw_menu_item("Save Checkpoint", {}, false, m_Simulation->canChangeEndTime() and m_Simulation->getNumReports() > 0)) {
+            TryPromptUserToSaveLatestCheckpoint(*m_Simulation);
+        }
+        ui::draw_tooltip_if_item_hovered("Save Checkpoint", "Saves the simulation's latest state, and its parameters, to a checkpoint file. The checkpoint can then be used to resume the simulation against the same model later (e.g. after restarting the application) via the File menu.");
+
+        ui::draw_separator();
+
         if (ui::begin_menu("Change End Time", m_Simulation->canChangeEndTime())) {
             if (ui::draw_menu_item("0.1x")) {
                 auto dur = m_Simulation->getEndTime() - m_Simulation->getStartTime();
@@ -40,6 +40,7 @@ public:
         m_Params{std::move(params_)},
         m_Viewer{panelName_}
     {
+        m_Viewer.setDecorationTimelineCache(m_Params.getDecorationTimelineCache());
     }
 
 private:
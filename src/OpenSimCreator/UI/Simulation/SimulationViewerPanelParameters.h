@@ -4,6 +4,7 @@
 #include <memory>
 #include <utility>
 
+namespace osc { class DecorationTimelineCache; }
 namespace osc { struct SimulationViewerRightClickEvent; }
 namespace osc { class IModelStatePair; }
 
@@ -13,18 +14,22 @@ namespace osc
     public:
         SimulationViewerPanelParameters(
             std::shared_ptr<IModelStatePair> model_,
-            const std::function<void(const SimulationViewerRightClickEvent&)>& onRightClickedAComponent_) :
+            const std::function<void(const SimulationViewerRightClickEvent&)>& onRightClickedAComponent_,
+            std::shared_ptr<DecorationTimelineCache> decorationTimelineCache_ = nullptr) :
 
             m_Model{std::move(model_)},
-            m_OnRightClickedAComponent{onRightClickedAComponent_}
+            m_OnRightClickedAComponent{onRightClickedAComponent_},
+            m_DecorationTimelineCache{std::move(decorationTimelineCache_)}
         {
         }
 
         IModelStatePair& updModelState() { return *m_Model; }
         void callOnRightClickHandler(const SimulationViewerRightClickEvent& e) const { m_OnRightClickedAComponent(e); }
+        const std::shared_ptr<DecorationTimelineCache>& getDecorationTimelineCache() const { return m_DecorationTimelineCache; }
 
     private:
         std::shared_ptr<IModelStatePair> m_Model;
         std::function<void(const SimulationViewerRightClickEvent&)> m_OnRightClickedAComponent;
+        std::shared_ptr<DecorationTimelineCache> m_DecorationTimelineCache;
     };
 }
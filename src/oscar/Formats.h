@@ -4,6 +4,9 @@
 #include <oscar/Formats/DAE.h>
 #include <oscar/Formats/Image.h>
 #include <oscar/Formats/ImageLoadingFlags.h>
+#include <oscar/Formats/MeshFile.h>
+#include <oscar/Formats/MeshLoadingFlags.h>
 #include <oscar/Formats/OBJ.h>
 #include <oscar/Formats/STL.h>
 #include <oscar/Formats/SVG.h>
+#include <oscar/Formats/VTP.h>
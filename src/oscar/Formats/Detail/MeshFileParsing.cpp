@@ -0,0 +1,307 @@
+#include "MeshFileParsing.h"
+
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/TriangleFunctions.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using namespace osc;
+
+namespace
+{
+    // powers of ten that are exactly representable as a `double`
+    constexpr auto c_exact_powers_of_ten = std::to_array<double>({
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    });
+
+    // the maximum number of significant digits that are accumulated into the mantissa
+    // (any more than this don't affect a `float`)
+    constexpr int c_max_mantissa_digits = 19;
+
+    // the smallest `double` that rounds to infinity when it's converted to a `float` (i.e. it's
+    // halfway between the largest `float` and 2^128)
+    constexpr double c_float_overflow_threshold = 0x1.ffffffp+127;
+
+    constexpr bool is_digit(char c)
+    {
+        return '0' <= c and c <= '9';
+    }
+
+    constexpr bool is_blank(char c)
+    {
+        return c == ' ' or c == '\t' or c == '\r' or c == '\v' or c == '\f';
+    }
+
+    constexpr bool is_whitespace(char c)
+    {
+        return is_blank(c) or c == '\n';
+    }
+
+    // the slow path for `parse_float`, which handles (e.g.) "nan", "inf", and hex floats
+    std::optional<float> parse_float_via_strtof(std::string_view token)
+    {
+        const std::string null_terminated{token};
+        char* end = nullptr;
+        errno = 0;
+        const float rv = std::strtof(null_terminated.c_str(), &end);
+        if (end != null_terminated.c_str() + null_terminated.size() or errno == ERANGE) {
+            return std::nullopt;
+        }
+        return rv;
+    }
+}
+
+std::optional<float> osc::detail::parse_float(std::string_view token)
+{
+    const char* it = token.data();
+    const char* const end = token.data() + token.size();
+
+    bool negative = false;
+    if (it != end and (*it == '-' or *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
+
+    uint64_t mantissa = 0;
+    int num_mantissa_digits = 0;
+    int64_t exponent = 0;
+    bool has_digits = false;
+
+    // integer part
+    for (; it != end and is_digit(*it); ++it) {
+        has_digits = true;
+        if (num_mantissa_digits < c_max_mantissa_digits) {
+            mantissa = 10*mantissa + static_cast<uint64_t>(*it - '0');
+            num_mantissa_digits += mantissa != 0 ? 1 : 0;  // (skip leading zeroes)
+        }
+        else {
+            ++exponent;
+        }
+    }
+
+    // fractional part
+    if (it != end and *it == '.') {
+        ++it;
+        for (; it != end and is_digit(*it); ++it) {
+            has_digits = true;
+            if (num_mantissa_digits < c_max_mantissa_digits) {
+                mantissa = 10*mantissa + static_cast<uint64_t>(*it - '0');
+                num_mantissa_digits += mantissa != 0 ? 1 : 0;
+                --exponent;
+            }
+        }
+    }
+
+    // exponent part
+    if (has_digits and it != end and (*it == 'e' or *it == 'E')) {
+        ++it;
+        bool negative_exponent = false;
+        if (it != end and (*it == '-' or *it == '+')) {
+            negative_exponent = *it == '-';
+            ++it;
+        }
+        if (it == end or not is_digit(*it)) {
+            return std::nullopt;
+        }
+        int64_t explicit_exponent = 0;
+        for (; it != end and is_digit(*it); ++it) {
+            explicit_exponent = std::min<int64_t>(10*explicit_exponent + (*it - '0'), 100000);  // (saturate: it's out of range anyway)
+        }
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+
+    if (not has_digits or it != end) {
+        return parse_float_via_strtof(token);  // not a plain decimal number (e.g. "nan", "inf", "0x1p3")
+    }
+
+    auto value = static_cast<double>(mantissa);
+    if (mantissa == 0) {
+        // (skip exponentiation)
+    }
+    else if (-22 <= exponent and exponent < 0) {
+        value /= c_exact_powers_of_ten[static_cast<size_t>(-exponent)];  // exact divisor, so it's correctly rounded
+    }
+    else if (0 <= exponent and exponent <= 22) {
+        value *= c_exact_powers_of_ten[static_cast<size_t>(exponent)];
+    }
+    else {
+        // (less precise than the above, but the error is far below a `float`'s precision)
+        value *= std::pow(10.0, static_cast<double>(exponent));
+    }
+
+    if (value >= c_float_overflow_threshold) {
+        return std::nullopt;  // out of range
+    }
+    const auto rv = static_cast<float>(value);
+    return negative ? -rv : rv;
+}
+
+std::optional<int64_t> osc::detail::parse_int(std::string_view token)
+{
+    const char* it = token.data();
+    const char* const end = token.data() + token.size();
+
+    bool negative = false;
+    if (it != end and (*it == '-' or *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
+    if (it == end) {
+        return std::nullopt;
+    }
+
+    uint64_t magnitude = 0;
+    for (; it != end; ++it) {
+        if (not is_digit(*it)) {
+            return std::nullopt;
+        }
+        magnitude = 10*magnitude + static_cast<uint64_t>(*it - '0');
+        if (magnitude > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            return std::nullopt;  // out of range
+        }
+    }
+    const auto rv = static_cast<int64_t>(magnitude);
+    return negative ? -rv : rv;
+}
+
+std::string_view osc::detail::MeshFileTokenizer::next_token_on_line()
+{
+    while (pos_ < text_.size() and is_blank(text_[pos_])) {
+        ++pos_;
+    }
+    const size_t first = pos_;
+    while (pos_ < text_.size() and not is_whitespace(text_[pos_])) {
+        ++pos_;
+    }
+    return text_.substr(first, pos_ - first);
+}
+
+std::string_view osc::detail::MeshFileTokenizer::next_token()
+{
+    while (pos_ < text_.size() and is_whitespace(text_[pos_])) {
+        ++pos_;
+    }
+    return next_token_on_line();
+}
+
+void osc::detail::MeshFileTokenizer::skip_line()
+{
+    const size_t newline = text_.find('\n', pos_);
+    pos_ = newline != std::string_view::npos ? newline + 1 : text_.size();
+}
+
+size_t osc::detail::MeshFileTokenizer::line_number() const
+{
+    const std::string_view consumed = text_.substr(0, pos_);
+    return 1 + static_cast<size_t>(std::count(consumed.begin(), consumed.end(), '\n'));
+}
+
+void osc::detail::PolygonMeshBuilder::reserve(size_t num_vertices, size_t num_indices)
+{
+    vertices_.reserve(num_vertices);
+    indices_.reserve(num_indices);
+    if (weld_vertices_) {
+        welded_vertex_indices_.reserve(num_vertices);
+    }
+}
+
+uint32_t osc::detail::PolygonMeshBuilder::push_vertex(const Vec3& vertex)
+{
+    if (vertices_.size() >= std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error{"too many vertices in the mesh"};
+    }
+    const auto index = static_cast<uint32_t>(vertices_.size());
+
+    if (weld_vertices_) {
+        const Vec3 key = vertex + 0.0f;  // (so that `-0.0f` and `0.0f` are welded)
+        const auto [it, inserted] = welded_vertex_indices_.try_emplace(key, index);
+        if (not inserted) {
+            return it->second;
+        }
+    }
+
+    vertices_.push_back(vertex);
+    return index;
+}
+
+void osc::detail::PolygonMeshBuilder::push_polygon(std::span<const uint32_t> indices)
+{
+    if (indices.size() < 3) {
+        return;  // point or line (ignore)
+    }
+    else if (indices.size() == 3) {
+        push_triangle_if_valid(indices[0], indices[1], indices[2]);
+    }
+    else if (indices.size() == 4) {
+        push_triangle_if_valid(indices[0], indices[1], indices[2]);
+        push_triangle_if_valid(indices[0], indices[2], indices[3]);
+    }
+    else {
+        // polygon: triangulate each edge with a centroid
+        const bool all_in_bounds = std::all_of(indices.begin(), indices.end(), [this](uint32_t i)
+        {
+            return i < vertices_.size();
+        });
+        if (not all_in_bounds) {
+            return;
+        }
+
+        Vec3 centroid{};
+        for (const uint32_t i : indices) {
+            centroid += vertices_[i];
+        }
+        centroid /= static_cast<float>(indices.size());
+        const uint32_t centroid_index = push_vertex(centroid);
+
+        for (size_t i = 0; i < indices.size(); ++i) {
+            push_triangle_if_valid(centroid_index, indices[i], indices[(i+1) % indices.size()]);
+        }
+    }
+}
+
+void osc::detail::PolygonMeshBuilder::push_polygon(std::span<const Vec3> vertices)
+{
+    if (vertices.size() == 3 and not can_form_triangle(vertices[0], vertices[1], vertices[2])) {
+        return;  // (skip pushing vertices that wouldn't be used by any triangle)
+    }
+
+    polygon_indices_buffer_.clear();
+    for (const Vec3& vertex : vertices) {
+        polygon_indices_buffer_.push_back(push_vertex(vertex));
+    }
+    push_polygon(std::span<const uint32_t>{polygon_indices_buffer_});
+}
+
+Mesh osc::detail::PolygonMeshBuilder::finish() const
+{
+    Mesh rv;
+    rv.set_vertices(vertices_);
+    rv.set_indices(indices_);
+    rv.recalculate_normals();
+    return rv;
+}
+
+void osc::detail::PolygonMeshBuilder::push_triangle_if_valid(uint32_t a, uint32_t b, uint32_t c)
+{
+    if (a >= vertices_.size() or b >= vertices_.size() or c >= vertices_.size()) {
+        return;  // index out-of-bounds
+    }
+    if (not can_form_triangle(vertices_[a], vertices_[b], vertices_[c])) {
+        return;  // vertex data doesn't form a triangle (NaNs, degenerate locations)
+    }
+    indices_.insert(indices_.end(), {a, b, c});
+}
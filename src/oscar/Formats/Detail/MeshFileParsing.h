@@ -0,0 +1,102 @@
+#pragma once
+
+#include <oscar/Formats/MeshLoadingFlags.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <ankerl/unordered_dense.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// internal helpers that are shared between oscar's mesh file readers (STL, OBJ, VTP)
+namespace osc::detail
+{
+    // returns the given bytes as a string (without copying them)
+    inline std::string_view as_string_view(std::span<const std::byte> bytes)
+    {
+        return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+    }
+
+    // parses the given token as a floating point number (e.g. "1", "-1.5", "1.2e-17")
+    //
+    // returns `std::nullopt` if the entire token isn't a (representable) number. The
+    // common cases are parsed without copying the token, or using the C locale
+    std::optional<float> parse_float(std::string_view token);
+
+    // parses the given token as a (base-10) integer
+    //
+    // returns `std::nullopt` if the entire token isn't a (representable) integer
+    std::optional<int64_t> parse_int(std::string_view token);
+
+    // splits (ASCII) text into whitespace-delimited tokens, without copying it
+    class MeshFileTokenizer final {
+    public:
+        explicit MeshFileTokenizer(std::string_view text) :
+            text_{text}
+        {}
+
+        bool at_end() const { return pos_ >= text_.size(); }
+
+        // returns the next token on the current line, or an empty string if there are
+        // no more tokens on the current line
+        std::string_view next_token_on_line();
+
+        // returns the next token (on any line), or an empty string if there are no more
+        // tokens in the text
+        std::string_view next_token();
+
+        // skips to the start of the next line
+        void skip_line();
+
+        // returns the (1-based) line number of the tokenizer's current position
+        //
+        // this is O(N), so it should only be used when (e.g.) reporting errors
+        size_t line_number() const;
+
+    private:
+        std::string_view text_;
+        size_t pos_ = 0;
+    };
+
+    // incrementally builds a triangle `Mesh` from polygons
+    //
+    // polygons are triangulated in the same way as SimTK does it: quads are split into two
+    // triangles and any other (N>4) polygon is fanned around an injected centroid vertex.
+    // Triangles that have out-of-bounds indices, or that are degenerate, are skipped
+    class PolygonMeshBuilder final {
+    public:
+        explicit PolygonMeshBuilder(MeshLoadingFlags flags) :
+            weld_vertices_{flags & MeshLoadingFlag::WeldVertices}
+        {}
+
+        void reserve(size_t num_vertices, size_t num_indices);
+
+        // adds a vertex and returns its index, which might be the index of an existing
+        // vertex if vertices are being welded
+        uint32_t push_vertex(const Vec3&);
+
+        // adds a polygon that's formed from previously-pushed vertices
+        void push_polygon(std::span<const uint32_t> indices);
+
+        // adds a polygon, and its vertices
+        void push_polygon(std::span<const Vec3> vertices);
+
+        // returns a `Mesh` that contains all of the pushed triangles, with normals that are
+        // calculated from the triangles
+        Mesh finish() const;
+
+    private:
+        void push_triangle_if_valid(uint32_t, uint32_t, uint32_t);
+
+        bool weld_vertices_;
+        std::vector<Vec3> vertices_;
+        std::vector<uint32_t> indices_;
+        ankerl::unordered_dense::map<Vec3, uint32_t> welded_vertex_indices_;
+        std::vector<uint32_t> polygon_indices_buffer_;
+    };
+}
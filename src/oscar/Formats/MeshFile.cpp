@@ -0,0 +1,91 @@
+#include "MeshFile.h"
+
+#include <oscar/Formats/MeshLoadingFlags.h>
+#include <oscar/Formats/OBJ.h>
+#include <oscar/Formats/STL.h>
+#include <oscar/Formats/VTP.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Platform/MemoryMappedFile.h>
+#include <oscar/Utils/StringHelpers.h>
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using namespace osc;
+using namespace std::literals;
+namespace rgs = std::ranges;
+
+namespace
+{
+    constexpr auto c_obj_file_extensions = std::to_array({"obj"sv});
+    constexpr auto c_vtp_file_extensions = std::to_array({"vtp"sv});
+    constexpr auto c_stl_file_extensions = std::to_array({"stl"sv, "stla"sv});
+
+    // all of the above, in the order that `supported_mesh_file_extensions` returns them
+    constexpr auto c_supported_mesh_file_extensions = []()
+    {
+        std::array<std::string_view, c_obj_file_extensions.size() + c_vtp_file_extensions.size() + c_stl_file_extensions.size()> rv{};
+        auto it = rgs::copy(c_obj_file_extensions, rv.begin()).out;
+        it = rgs::copy(c_vtp_file_extensions, it).out;
+        rgs::copy(c_stl_file_extensions, it);
+        return rv;
+    }();
+
+    // returns `true` if the path's extension (without the leading dot) case-insensitively
+    // matches any of the given extensions
+    bool has_any_extension_of(const std::filesystem::path& path, std::span<const std::string_view> extensions)
+    {
+        std::string extension = path.extension().string();
+        if (not extension.empty()) {
+            extension.erase(0, 1);
+        }
+        return rgs::any_of(extensions, [&extension](std::string_view e) { return is_equal_case_insensitive(extension, e); });
+    }
+}
+
+std::span<const std::string_view> osc::supported_mesh_file_extensions()
+{
+    return c_supported_mesh_file_extensions;
+}
+
+bool osc::is_supported_mesh_file(const std::filesystem::path& path)
+{
+    return has_any_extension_of(path, c_supported_mesh_file_extensions);
+}
+
+bool osc::is_stl_mesh_file(const std::filesystem::path& path)
+{
+    return has_any_extension_of(path, c_stl_file_extensions);
+}
+
+Mesh osc::load_mesh_file(const std::filesystem::path& path, MeshLoadingFlags flags)
+{
+    const bool is_obj = has_any_extension_of(path, c_obj_file_extensions);
+    const bool is_vtp = has_any_extension_of(path, c_vtp_file_extensions);
+    const bool is_stl = is_stl_mesh_file(path);
+    if (not (is_obj or is_vtp or is_stl)) {
+        throw std::runtime_error{path.string() + ": unsupported mesh file extension"};
+    }
+
+    const MemoryMappedFile file{path};
+    try {
+        if (is_obj) {
+            return load_mesh_from_obj(file.bytes(), flags);
+        }
+        else if (is_vtp) {
+            return load_mesh_from_vtp(file.bytes(), flags);
+        }
+        else {
+            return load_mesh_from_stl(file.bytes(), flags);
+        }
+    }
+    catch (const std::exception& ex) {
+        throw std::runtime_error{path.string() + ": error loading mesh file: " + ex.what()};
+    }
+}
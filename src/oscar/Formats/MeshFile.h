@@ -0,0 +1,28 @@
+#pragma once
+
+#include <oscar/Formats/MeshLoadingFlags.h>
+
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace osc { class Mesh; }
+
+namespace osc
+{
+    // returns the file extensions (e.g. `{"obj", "stl", "vtp"}`) that `load_mesh_file` supports
+    std::span<const std::string_view> supported_mesh_file_extensions();
+
+    // returns `true` if the given path has a (case-insensitive) file extension that
+    // `load_mesh_file` supports
+    bool is_supported_mesh_file(const std::filesystem::path&);
+
+    // returns `true` if the given path has a (case-insensitive) STL file extension (e.g. `.stl`, `.STLA`)
+    bool is_stl_mesh_file(const std::filesystem::path&);
+
+    // memory-maps the given mesh file and reads it with the reader (e.g. `load_mesh_from_stl`)
+    // that matches its (case-insensitive) file extension
+    //
+    // throws if the file's extension isn't supported, or if the file can't be read
+    Mesh load_mesh_file(const std::filesystem::path&, MeshLoadingFlags = {});
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <oscar/Utils/Flags.h>
+
+namespace osc
+{
+    enum class MeshLoadingFlag {
+        None = 0,
+
+        // merges vertices that have exactly the same position into one vertex
+        //
+        // this is mostly useful for formats that don't index their vertices (e.g. STL),
+        // because it means that triangles that touch each other share vertices (and,
+        // therefore, get smoothed normals). It's usually undesirable for indexed formats
+        // (e.g. OBJ, VTP), because they may have intentionally duplicated vertices (e.g.
+        // along a hard edge)
+        WeldVertices = 1<<0,
+    };
+    using MeshLoadingFlags = Flags<MeshLoadingFlag>;
+}
@@ -1,16 +1,26 @@
 #include "OBJ.h"
 
+#include <oscar/Formats/Detail/MeshFileParsing.h>
+#include <oscar/Formats/MeshLoadingFlags.h>
 #include <oscar/Graphics/Mesh.h>
 #include <oscar/Maths/Vec3.h>
 #include <oscar/Platform/os.h>
 #include <oscar/Strings.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <iomanip>
+#include <limits>
+#include <optional>
 #include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <string_view>
+#include <vector>
 
 using namespace osc;
+using namespace osc::detail;
 
 namespace
 {
@@ -70,6 +80,52 @@ namespace
             }
         }
     }
+
+    constexpr uint32_t c_invalid_vertex_index = std::numeric_limits<uint32_t>::max();
+
+    std::runtime_error make_obj_parse_error(const MeshFileTokenizer& tokenizer, std::string_view message)
+    {
+        return std::runtime_error{"line " + std::to_string(tokenizer.line_number()) + ": " + std::string{message}};
+    }
+
+    Vec3 read_obj_vertex(MeshFileTokenizer& tokenizer)
+    {
+        // `v x y z [w]` (any trailing `w`, or vertex colors, are ignored)
+        Vec3 rv{};
+        for (float& component : rv) {
+            const std::optional<float> value = parse_float(tokenizer.next_token_on_line());
+            if (not value) {
+                throw make_obj_parse_error(tokenizer, "invalid vertex (expected `v x y z`)");
+            }
+            component = *value;
+        }
+        return rv;
+    }
+
+    // reads the `v`, `v/vt`, `v/vt/vn`, or `v//vn` elements of a face into `out`, mapping
+    // each (1-based, or negative/relative) OBJ vertex index to its index in the mesh
+    void read_obj_face(
+        MeshFileTokenizer& tokenizer,
+        std::span<const uint32_t> mesh_indices_of_obj_vertices,
+        std::vector<uint32_t>& out)
+    {
+        out.clear();
+        for (std::string_view element = tokenizer.next_token_on_line(); not element.empty(); element = tokenizer.next_token_on_line()) {
+            const std::optional<int64_t> obj_index = parse_int(element.substr(0, element.find('/')));
+            if (not obj_index) {
+                throw make_obj_parse_error(tokenizer, "invalid face element (expected `v`, `v/vt`, `v/vt/vn`, or `v//vn`)");
+            }
+
+            const auto num_obj_vertices = static_cast<int64_t>(mesh_indices_of_obj_vertices.size());
+            const int64_t zero_based_index = *obj_index > 0 ? *obj_index - 1 : num_obj_vertices + *obj_index;
+            if (*obj_index == 0 or zero_based_index < 0 or zero_based_index >= num_obj_vertices) {
+                out.push_back(c_invalid_vertex_index);  // (the triangle(s) that use it are skipped)
+            }
+            else {
+                out.push_back(mesh_indices_of_obj_vertices[static_cast<size_t>(zero_based_index)]);
+            }
+        }
+    }
 }
 
 osc::ObjMetadata::ObjMetadata() :
@@ -94,3 +150,28 @@ void osc::write_as_obj(
     }
     write_faces(out, mesh, flags);
 }
+
+Mesh osc::load_mesh_from_obj(
+    std::span<const std::byte> data,
+    MeshLoadingFlags flags)
+{
+    MeshFileTokenizer tokenizer{as_string_view(data)};
+    PolygonMeshBuilder builder{flags};
+    std::vector<uint32_t> mesh_indices_of_obj_vertices;
+    std::vector<uint32_t> face;
+
+    while (not tokenizer.at_end()) {
+        const std::string_view keyword = tokenizer.next_token_on_line();
+        if (keyword == "v") {
+            mesh_indices_of_obj_vertices.push_back(builder.push_vertex(read_obj_vertex(tokenizer)));
+        }
+        else if (keyword == "f") {
+            read_obj_face(tokenizer, mesh_indices_of_obj_vertices, face);
+            builder.push_polygon(std::span<const uint32_t>{face});
+        }
+        // else: comments, normals, texture coordinates, groups, etc. (ignored)
+
+        tokenizer.skip_line();
+    }
+    return builder.finish();
+}
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <oscar/Formats/MeshLoadingFlags.h>
 #include <oscar/Utils/Flags.h>
 
+#include <cstddef>
 #include <ctime>
 #include <iosfwd>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -33,4 +36,14 @@ namespace osc
         const ObjMetadata& = ObjMetadata{},
         ObjWriterFlags = ObjWriterFlag::Default
     );
+
+    // returns a `Mesh` that's read from the given OBJ file content
+    //
+    // only the vertex positions (`v`) and faces (`f`) are read: normals are recalculated
+    // from the (triangulated) faces, and everything else (texture coordinates, groups,
+    // materials, etc.) is ignored. Throws if the content contains invalid vertices/faces
+    Mesh load_mesh_from_obj(
+        std::span<const std::byte>,
+        MeshLoadingFlags = {}
+    );
 }
@@ -1,5 +1,7 @@
 #include "STL.h"
 
+#include <oscar/Formats/Detail/MeshFileParsing.h>
+#include <oscar/Formats/MeshLoadingFlags.h>
 #include <oscar/Graphics/Mesh.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/Triangle.h>
@@ -12,18 +14,25 @@
 #include <oscar/Strings.h>
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <ostream>
 #include <limits>
+#include <optional>
 #include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <vector>
 
 using namespace osc;
+using namespace osc::detail;
 
 namespace
 {
@@ -98,6 +107,103 @@ namespace
     {
         mesh.for_each_indexed_triangle([&out](Triangle t) { write_triangle(out, t); });
     }
+
+    // a binary STL file is an 80-byte header, followed by a `uint32` triangle count, followed
+    // by 50-byte triangle records (normal, 3 vertices, `uint16` attribute byte count)
+    constexpr size_t c_num_bytes_in_binary_stl_preamble = 84;
+    constexpr size_t c_num_bytes_in_binary_stl_triangle = 50;
+
+    uint32_t read_u32_little_endian(std::span<const std::byte, 4> bytes)
+    {
+        return
+            (static_cast<uint32_t>(bytes[0])    ) |
+            (static_cast<uint32_t>(bytes[1])<<8 ) |
+            (static_cast<uint32_t>(bytes[2])<<16) |
+            (static_cast<uint32_t>(bytes[3])<<24);
+    }
+
+    Vec3 read_vec3_ieee754(std::span<const std::byte, 12> bytes)
+    {
+        static_assert(std::numeric_limits<float>::is_iec559, "STL files use IEE754 floats");
+        return {
+            std::bit_cast<float>(read_u32_little_endian(bytes.subspan<0, 4>())),
+            std::bit_cast<float>(read_u32_little_endian(bytes.subspan<4, 4>())),
+            std::bit_cast<float>(read_u32_little_endian(bytes.subspan<8, 4>())),
+        };
+    }
+
+    // returns the number of triangles in the binary STL content, or `std::nullopt` if the
+    // content's size doesn't match the triangle count in its preamble
+    std::optional<size_t> try_read_binary_stl_num_triangles(std::span<const std::byte> data)
+    {
+        if (data.size() < c_num_bytes_in_binary_stl_preamble) {
+            return std::nullopt;
+        }
+        const uint32_t num_triangles = read_u32_little_endian(data.subspan<80, 4>());
+        const size_t num_bytes_in_triangles = data.size() - c_num_bytes_in_binary_stl_preamble;
+        if (num_bytes_in_triangles / c_num_bytes_in_binary_stl_triangle != num_triangles or
+            num_bytes_in_triangles % c_num_bytes_in_binary_stl_triangle != 0) {
+            return std::nullopt;
+        }
+        return num_triangles;
+    }
+
+    // returns `true` if the content looks like an ASCII STL file
+    //
+    // (binary STL files can also start with "solid", so this should only be checked after
+    // checking whether the content is a binary STL file)
+    bool is_ascii_stl(std::string_view text)
+    {
+        const auto first = std::find_if_not(text.begin(), text.end(), [](char c) { return std::isspace(static_cast<unsigned char>(c)); });
+        return
+            text.substr(static_cast<size_t>(first - text.begin())).starts_with("solid") and
+            text.find('\0') == std::string_view::npos;  // (e.g. a truncated binary STL file that starts with "solid")
+    }
+
+    Mesh load_mesh_from_binary_stl(std::span<const std::byte> data, size_t num_triangles, MeshLoadingFlags flags)
+    {
+        PolygonMeshBuilder builder{flags};
+        builder.reserve(3*num_triangles, 3*num_triangles);
+
+        std::array<Vec3, 3> triangle{};
+        for (size_t i = 0; i < num_triangles; ++i) {
+            const auto record = data.subspan(c_num_bytes_in_binary_stl_preamble + i*c_num_bytes_in_binary_stl_triangle).first<c_num_bytes_in_binary_stl_triangle>();
+            // (the stored normal is ignored: it's recalculated from the triangles)
+            triangle[0] = read_vec3_ieee754(record.subspan<12, 12>());
+            triangle[1] = read_vec3_ieee754(record.subspan<24, 12>());
+            triangle[2] = read_vec3_ieee754(record.subspan<36, 12>());
+            builder.push_polygon(std::span<const Vec3>{triangle});
+        }
+        return builder.finish();
+    }
+
+    Mesh load_mesh_from_ascii_stl(std::string_view text, MeshLoadingFlags flags)
+    {
+        MeshFileTokenizer tokenizer{text};
+        tokenizer.skip_line();  // `solid [name]`
+
+        PolygonMeshBuilder builder{flags};
+        std::vector<Vec3> loop;
+        for (std::string_view token = tokenizer.next_token(); not token.empty(); token = tokenizer.next_token()) {
+            if (token == "vertex") {
+                Vec3 vertex{};
+                for (float& component : vertex) {
+                    const std::optional<float> value = parse_float(tokenizer.next_token());
+                    if (not value) {
+                        throw std::runtime_error{"line " + std::to_string(tokenizer.line_number()) + ": invalid STL vertex"};
+                    }
+                    component = *value;
+                }
+                loop.push_back(vertex);
+            }
+            else if (token == "endloop") {
+                builder.push_polygon(std::span<const Vec3>{loop});
+                loop.clear();
+            }
+            // else: `facet normal x y z`, `outer loop`, `endfacet`, `endsolid`, etc. (ignored)
+        }
+        return builder.finish();
+    }
 }
 
 osc::StlMetadata::StlMetadata() :
@@ -124,3 +230,21 @@ void osc::write_as_stl(
     write_num_triangles(output, mesh);
     write_triangles(output, mesh);
 }
+
+Mesh osc::load_mesh_from_stl(
+    std::span<const std::byte> data,
+    MeshLoadingFlags flags)
+{
+    if (const auto num_triangles = try_read_binary_stl_num_triangles(data)) {
+        return load_mesh_from_binary_stl(data, *num_triangles, flags);
+    }
+    else if (const std::string_view text = as_string_view(data); is_ascii_stl(text)) {
+        return load_mesh_from_ascii_stl(text, flags);
+    }
+    else if (data.size() >= c_num_bytes_in_binary_stl_preamble) {
+        throw std::runtime_error{"the size of the binary STL data doesn't match the number of triangles in its header (is it truncated?)"};
+    }
+    else {
+        throw std::runtime_error{"the data is too small to be an STL file"};
+    }
+}
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <oscar/Formats/MeshLoadingFlags.h>
+
+#include <cstddef>
 #include <ctime>
 #include <iosfwd>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -26,4 +30,13 @@ namespace osc
         const Mesh&,
         const StlMetadata&
     );
+
+    // returns a `Mesh` that's read from the given (binary or ASCII) STL file content
+    //
+    // the content is read in-place, so it's recommended to pass the bytes of a memory-mapped
+    // file (e.g. `MemoryMappedFile`) into this. Throws if the content isn't a valid STL file
+    Mesh load_mesh_from_stl(
+        std::span<const std::byte>,
+        MeshLoadingFlags = {}
+    );
 }
@@ -0,0 +1,255 @@
+#include "VTP.h"
+
+#include <oscar/Formats/Detail/MeshFileParsing.h>
+#include <oscar/Formats/MeshLoadingFlags.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace osc;
+using namespace osc::detail;
+
+// this isn't a general-purpose XML parser: it only scans for the (well-formed) subset of XML
+// that VTK writes into `.vtp` files (no comments/CDATA that contain tags, no nested elements
+// that have the same name as their parent, etc.), so that the (potentially, huge) data arrays
+// can be tokenized in-place
+namespace
+{
+    struct XMLElement final {
+        std::string_view attributes;
+        std::string_view content;
+    };
+
+    constexpr bool is_xml_whitespace(char c)
+    {
+        return c == ' ' or c == '\t' or c == '\r' or c == '\n';
+    }
+
+    // returns the next element with the given name in `xml`, starting from `pos`, and
+    // advances `pos` past it (or returns `std::nullopt` if there isn't one)
+    std::optional<XMLElement> find_next_element(std::string_view xml, std::string_view name, size_t& pos)
+    {
+        for (size_t open = xml.find('<', pos); open != std::string_view::npos; open = xml.find('<', open + 1)) {
+            const size_t name_end = open + 1 + name.size();
+            if (xml.substr(open + 1, name.size()) != name or name_end >= xml.size()) {
+                continue;
+            }
+            if (const char c = xml[name_end]; not (is_xml_whitespace(c) or c == '>' or c == '/')) {
+                continue;  // it's an element that has a name that starts with `name`
+            }
+
+            const size_t start_tag_end = xml.find('>', name_end);
+            if (start_tag_end == std::string_view::npos) {
+                throw std::runtime_error{"unterminated <" + std::string{name} + "> element"};
+            }
+
+            XMLElement rv;
+            rv.attributes = xml.substr(name_end, start_tag_end - name_end);
+            if (rv.attributes.ends_with('/')) {
+                // self-closing element (e.g. `<Polys/>`)
+                rv.attributes.remove_suffix(1);
+                pos = start_tag_end + 1;
+                return rv;
+            }
+
+            const std::string end_tag = "</" + std::string{name};
+            const size_t end_tag_start = xml.find(end_tag, start_tag_end + 1);
+            if (end_tag_start == std::string_view::npos) {
+                throw std::runtime_error{"missing </" + std::string{name} + "> end tag"};
+            }
+            rv.content = xml.substr(start_tag_end + 1, end_tag_start - (start_tag_end + 1));
+
+            const size_t end_tag_end = xml.find('>', end_tag_start);
+            pos = end_tag_end != std::string_view::npos ? end_tag_end + 1 : xml.size();
+            return rv;
+        }
+        pos = xml.size();
+        return std::nullopt;
+    }
+
+    std::optional<XMLElement> find_first_element(std::string_view xml, std::string_view name)
+    {
+        size_t pos = 0;
+        return find_next_element(xml, name, pos);
+    }
+
+    // returns the value of the given attribute (e.g. `Name="connectivity"`), if it exists
+    std::optional<std::string_view> find_attribute(std::string_view attributes, std::string_view name)
+    {
+        for (size_t pos = attributes.find(name); pos != std::string_view::npos; pos = attributes.find(name, pos + 1)) {
+            if (pos != 0 and not is_xml_whitespace(attributes[pos - 1])) {
+                continue;  // it's an attribute that has a name that ends with `name`
+            }
+            size_t it = pos + name.size();
+            while (it < attributes.size() and is_xml_whitespace(attributes[it])) {
+                ++it;
+            }
+            if (it >= attributes.size() or attributes[it] != '=') {
+                continue;
+            }
+            ++it;
+            while (it < attributes.size() and is_xml_whitespace(attributes[it])) {
+                ++it;
+            }
+            if (it >= attributes.size() or (attributes[it] != '"' and attributes[it] != '\'')) {
+                continue;
+            }
+            const size_t value_end = attributes.find(attributes[it], it + 1);
+            if (value_end == std::string_view::npos) {
+                continue;
+            }
+            return attributes.substr(it + 1, value_end - (it + 1));
+        }
+        return std::nullopt;
+    }
+
+    // throws if the given `DataArray` isn't `ascii`-formatted
+    void validate_data_array_format(const XMLElement& data_array)
+    {
+        const std::string_view format = find_attribute(data_array.attributes, "format").value_or("ascii");
+        if (format != "ascii") {
+            throw std::runtime_error{std::string{format} + ": unsupported VTP DataArray format (only ascii DataArrays are supported)"};
+        }
+    }
+
+    std::vector<Vec3> read_points(const XMLElement& piece)
+    {
+        const std::optional<XMLElement> points = find_first_element(piece.content, "Points");
+        if (not points) {
+            return {};
+        }
+        const std::optional<XMLElement> data_array = find_first_element(points->content, "DataArray");
+        if (not data_array) {
+            throw std::runtime_error{"a <Points> element does not contain a <DataArray>"};
+        }
+        validate_data_array_format(*data_array);
+        if (find_attribute(data_array->attributes, "NumberOfComponents") != "3") {
+            throw std::runtime_error{"a <Points> element's DataArray does not have three components"};
+        }
+
+        std::vector<Vec3> rv;
+        if (const auto num_points = find_attribute(piece.attributes, "NumberOfPoints")) {
+            rv.reserve(static_cast<size_t>(std::max<int64_t>(parse_int(*num_points).value_or(0), 0)));
+        }
+
+        MeshFileTokenizer tokenizer{data_array->content};
+        Vec3 point{};
+        size_t num_components = 0;
+        for (std::string_view token = tokenizer.next_token(); not token.empty(); token = tokenizer.next_token()) {
+            const std::optional<float> value = parse_float(token);
+            if (not value) {
+                throw std::runtime_error{std::string{token} + ": invalid point component"};
+            }
+            point[num_components++] = *value;
+            if (num_components == 3) {
+                rv.push_back(point);
+                num_components = 0;
+            }
+        }
+        if (num_components != 0) {
+            throw std::runtime_error{"a <Points> element's DataArray does not contain a multiple of three components"};
+        }
+        return rv;
+    }
+
+    std::vector<int64_t> read_integers(const XMLElement& data_array)
+    {
+        validate_data_array_format(data_array);
+
+        std::vector<int64_t> rv;
+        MeshFileTokenizer tokenizer{data_array.content};
+        for (std::string_view token = tokenizer.next_token(); not token.empty(); token = tokenizer.next_token()) {
+            const std::optional<int64_t> value = parse_int(token);
+            if (not value) {
+                throw std::runtime_error{std::string{token} + ": invalid integer"};
+            }
+            rv.push_back(*value);
+        }
+        return rv;
+    }
+
+    // pushes the points and (triangulated) polygons of one `<Piece>` into the builder
+    void read_piece(const XMLElement& piece, PolygonMeshBuilder& builder)
+    {
+        const std::vector<Vec3> points = read_points(piece);
+
+        std::vector<uint32_t> mesh_indices_of_points;
+        mesh_indices_of_points.reserve(points.size());
+        for (const Vec3& point : points) {
+            mesh_indices_of_points.push_back(builder.push_vertex(point));
+        }
+
+        const std::optional<XMLElement> polys = find_first_element(piece.content, "Polys");
+        if (not polys) {
+            return;
+        }
+
+        std::vector<int64_t> connectivity;
+        std::vector<int64_t> offsets;
+        size_t pos = 0;
+        while (const std::optional<XMLElement> data_array = find_next_element(polys->content, "DataArray", pos)) {
+            const std::optional<std::string_view> name = find_attribute(data_array->attributes, "Name");
+            if (name == "connectivity") {
+                connectivity = read_integers(*data_array);
+            }
+            else if (name == "offsets") {
+                offsets = read_integers(*data_array);
+            }
+        }
+
+        std::vector<uint32_t> polygon;
+        int64_t polygon_begin = 0;
+        for (const int64_t polygon_end : offsets) {
+            if (polygon_end < polygon_begin or polygon_end > static_cast<int64_t>(connectivity.size())) {
+                throw std::runtime_error{"a <Polys> element has invalid offsets"};
+            }
+
+            polygon.clear();
+            for (int64_t i = polygon_begin; i < polygon_end; ++i) {
+                const int64_t point_index = connectivity[static_cast<size_t>(i)];
+                if (0 <= point_index and point_index < static_cast<int64_t>(mesh_indices_of_points.size())) {
+                    polygon.push_back(mesh_indices_of_points[static_cast<size_t>(point_index)]);
+                }
+                else {
+                    polygon.push_back(std::numeric_limits<uint32_t>::max());  // (the triangle(s) that use it are skipped)
+                }
+            }
+            builder.push_polygon(std::span<const uint32_t>{polygon});
+
+            polygon_begin = polygon_end;
+        }
+    }
+}
+
+Mesh osc::load_mesh_from_vtp(
+    std::span<const std::byte> data,
+    MeshLoadingFlags flags)
+{
+    const std::string_view xml = as_string_view(data);
+
+    const std::optional<XMLElement> vtk_file = find_first_element(xml, "VTKFile");
+    if (not vtk_file or find_attribute(vtk_file->attributes, "type") != "PolyData") {
+        throw std::runtime_error{"the data isn't a VTK PolyData file (no <VTKFile type=\"PolyData\"> element)"};
+    }
+    const std::optional<XMLElement> poly_data = find_first_element(vtk_file->content, "PolyData");
+    if (not poly_data) {
+        throw std::runtime_error{"the VTK PolyData file has no <PolyData> element"};
+    }
+
+    PolygonMeshBuilder builder{flags};
+    size_t pos = 0;
+    while (const std::optional<XMLElement> piece = find_next_element(poly_data->content, "Piece", pos)) {
+        read_piece(*piece, builder);
+    }
+    return builder.finish();
+}
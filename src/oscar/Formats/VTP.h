@@ -0,0 +1,22 @@
+#pragma once
+
+#include <oscar/Formats/MeshLoadingFlags.h>
+
+#include <cstddef>
+#include <span>
+
+namespace osc { class Mesh; }
+
+namespace osc
+{
+    // returns a `Mesh` that's read from the given VTK PolyData (`.vtp`) file content
+    //
+    // only the points and polygons (`Polys`) of each piece are read: normals are recalculated
+    // from the (triangulated) polygons, and everything else (point data, lines, strips, etc.)
+    // is ignored. Only `ascii`-formatted data arrays are supported. Throws if the content
+    // isn't a valid (supported) VTP file
+    Mesh load_mesh_from_vtp(
+        std::span<const std::byte>,
+        MeshLoadingFlags = {}
+    );
+}
@@ -34,6 +34,7 @@
 #include <oscar/Graphics/MeshUpdateFlags.h>
 #include <oscar/Graphics/RenderBufferLoadAction.h>
 #include <oscar/Graphics/RenderBufferStoreAction.h>
+#include <oscar/Graphics/RenderStatistics.h>
 #include <oscar/Graphics/RenderTarget.h>
 #include <oscar/Graphics/RenderTargetColorAttachment.h>
 #include <oscar/Graphics/RenderTargetDepthStencilAttachment.h>
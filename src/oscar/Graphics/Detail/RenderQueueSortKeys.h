@@ -0,0 +1,135 @@
+#pragma once
+
+#include <oscar/Graphics/MaterialPropertyBlock.h>
+#include <oscar/Utils/HashHelpers.h>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace osc::detail
+{
+    // describes one field of a `RenderObject`'s 64-bit sort key
+    //
+    // a sort key packs per-render-queue IDs of the object's material, property block,
+    // mesh, and sub-mesh index into one integer (most significant first), so that sorting
+    // a render queue by its keys groups it into batches that can be drawn together. IDs
+    // are handed out in order of first appearance by a `RenderQueueSortKeyTable`. IDs that
+    // don't fit into their field (e.g. because a camera was given >65535 materials in one
+    // frame) saturate, so a saturated field is a grouping hint, rather than an identity
+    struct RenderObjectSortKeyField final {
+
+        constexpr uint64_t max_id() const { return (uint64_t{1} << num_bits) - 1; }
+        constexpr uint64_t pack(uint64_t id) const { return std::min(id, max_id()) << shift; }
+        constexpr uint64_t extract(uint64_t key) const { return (key >> shift) & max_id(); }
+
+        int shift;
+        int num_bits;
+    };
+    constexpr RenderObjectSortKeyField c_material_sort_key_field{.shift = 48, .num_bits = 16};
+    constexpr RenderObjectSortKeyField c_property_block_sort_key_field{.shift = 32, .num_bits = 16};
+    constexpr RenderObjectSortKeyField c_mesh_sort_key_field{.shift = 12, .num_bits = 20};
+    constexpr RenderObjectSortKeyField c_submesh_sort_key_field{.shift = 0, .num_bits = 12};
+
+    // returns a sort key that packs the given IDs (each of which saturates if it doesn't fit)
+    constexpr uint64_t pack_render_object_sort_key(
+        uint64_t material_id,
+        uint64_t property_block_id,
+        uint64_t mesh_id,
+        uint64_t submesh_id)
+    {
+        return
+            c_material_sort_key_field.pack(material_id) |
+            c_property_block_sort_key_field.pack(property_block_id) |
+            c_mesh_sort_key_field.pack(mesh_id) |
+            c_submesh_sort_key_field.pack(submesh_id);
+    }
+
+    // returns `true` if the given field identifies the same thing in both sort keys, falling
+    // back to `full_comparison` if the field's IDs are equal, but saturated
+    template<std::invocable FullComparison>
+    bool is_same_by_sort_key_field(
+        RenderObjectSortKeyField field,
+        uint64_t a,
+        uint64_t b,
+        FullComparison full_comparison)
+    {
+        const uint64_t id = field.extract(a);
+        if (id != field.extract(b)) {
+            return false;
+        }
+        return id != field.max_id() or full_comparison();
+    }
+
+    // hands out the per-render-queue IDs that are packed into `RenderObject` sort keys
+    //
+    // materials and meshes are identified by their (shared, copy-on-write) implementation,
+    // which is exactly how they compare for equality. Property blocks compare by value, so
+    // different property blocks that hold the same values are given the same ID (values
+    // that are sent to the GPU per-instance are ignored, so that they don't split batches).
+    //
+    // the table must be cleared whenever the render queue that it's assigning IDs for is
+    // cleared, because the queue's objects are what keep the implementations (i.e. keys) alive
+    class RenderQueueSortKeyTable final {
+    public:
+        void clear()
+        {
+            material_ids_.clear();
+            mesh_ids_.clear();
+            property_block_ids_.clear();
+            property_block_ids_by_hash_.clear();
+            num_property_block_ids_ = 0;
+        }
+
+        uint64_t material_id(const void* material_impl)
+        {
+            return material_ids_.try_emplace(material_impl, material_ids_.size()).first->second;
+        }
+
+        uint64_t mesh_id(const void* mesh_impl)
+        {
+            return mesh_ids_.try_emplace(mesh_impl, mesh_ids_.size()).first->second;
+        }
+
+        // returns the ID of a property block that's identified by its implementation and (optionally)
+        // a filter (e.g. a shader, which decides which values are ignored), where `get_values` returns
+        // the (filtered) property block that the ID should be derived from, plus its hash
+        template<std::invocable ValuesGetter>
+        uint64_t property_block_id(
+            const void* property_block_impl,
+            const void* filter,
+            ValuesGetter get_values)
+        {
+            // fast path: this exact property block has already been given an ID
+            const std::pair<const void*, const void*> identity{property_block_impl, filter};
+            if (const auto it = property_block_ids_.find(identity); it != property_block_ids_.end()) {
+                return it->second;
+            }
+
+            // slow path: find an existing property block with the same values, or make a new ID
+            const auto [values, hash] = get_values();
+            auto& candidates = property_block_ids_by_hash_[hash];
+            const auto it = std::ranges::find(candidates, values, [](const auto& candidate) -> const MaterialPropertyBlock& { return candidate.first; });
+            const uint64_t id = it != candidates.end() ? it->second : num_property_block_ids_++;
+            if (it == candidates.end()) {
+                candidates.emplace_back(values, id);
+            }
+            property_block_ids_.try_emplace(identity, id);
+            return id;
+        }
+
+        friend bool operator==(const RenderQueueSortKeyTable&, const RenderQueueSortKeyTable&) = default;
+
+    private:
+        std::unordered_map<const void*, uint64_t> material_ids_;
+        std::unordered_map<const void*, uint64_t> mesh_ids_;
+        std::unordered_map<std::pair<const void*, const void*>, uint64_t, Hasher<std::pair<const void*, const void*>>> property_block_ids_;
+        std::unordered_map<size_t, std::vector<std::pair<MaterialPropertyBlock, uint64_t>>> property_block_ids_by_hash_;
+        uint64_t num_property_block_ids_ = 0;
+    };
+}
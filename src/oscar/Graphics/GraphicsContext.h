@@ -2,6 +2,7 @@
 
 #include <oscar/Graphics/AntiAliasingLevel.h>
 #include <oscar/Graphics/Color.h>
+#include <oscar/Graphics/RenderStatistics.h>
 #include <oscar/Graphics/Texture2D.h>
 
 #include <future>
@@ -40,6 +41,10 @@ namespace osc
         // the frontbuffer the backbuffer
         void swap_buffers(SDL_Window&);
 
+        // returns statistics about what was rendered during the most recent complete frame
+        // (i.e. between the two most recent calls to `swap_buffers`)
+        RenderStatistics previous_frame_render_statistics() const;
+
         // human-readable identifier strings: useful for printouts/debugging
         std::string backend_vendor_string() const;
         std::string backend_renderer_string() const;
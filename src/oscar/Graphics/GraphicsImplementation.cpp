@@ -13,6 +13,7 @@
 #include <oscar/Graphics/Detail/CPUDataType.h>
 #include <oscar/Graphics/Detail/CPUImageFormat.h>
 #include <oscar/Graphics/Detail/DepthStencilRenderBufferFormatHelpers.h>
+#include <oscar/Graphics/Detail/RenderQueueSortKeys.h>
 #include <oscar/Graphics/Detail/ShaderPropertyTypeList.h>
 #include <oscar/Graphics/Detail/ShaderPropertyTypeTraits.h>
 #include <oscar/Graphics/Detail/TextureFormatList.h>
@@ -37,6 +38,7 @@
 #include <oscar/Graphics/ColorRenderBufferFormat.h>
 #include <oscar/Graphics/RenderBufferLoadAction.h>
 #include <oscar/Graphics/RenderBufferStoreAction.h>
+#include <oscar/Graphics/RenderStatistics.h>
 #include <oscar/Graphics/RenderTarget.h>
 #include <oscar/Graphics/RenderTargetColorAttachment.h>
 #include <oscar/Graphics/RenderTargetDepthStencilAttachment.h>
@@ -80,6 +82,7 @@
 #include <oscar/Utils/CStringView.h>
 #include <oscar/Utils/DefaultConstructOnCopy.h>
 #include <oscar/Utils/EnumHelpers.h>
+#include <oscar/Utils/HashHelpers.h>
 #include <oscar/Utils/ObjectRepresentation.h>
 #include <oscar/Utils/Perf.h>
 #include <oscar/Utils/StdVariantHelpers.h>
@@ -106,6 +109,7 @@
 #include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -505,6 +509,23 @@ namespace
             return ShaderPropertyType::Unknown;
         }
     }
+
+    // returns a hash of the material value
+    //
+    // values that aren't hashable (e.g. arrays, textures) only hash their type, so that
+    // equal values always have equal hashes
+    size_t hash_of_material_value(const MaterialValue& material_val)
+    {
+        return std::visit([&material_val]<typename T>(const T& value)
+        {
+            if constexpr (Hashable<T>) {
+                return hash_of(material_val.index(), value);
+            }
+            else {
+                return hash_of(material_val.index());
+            }
+        }, material_val);
+    }
 }
 
 // shader (backend stuff)
@@ -587,6 +608,57 @@ namespace
         o << "ShadeElement(name = " << name << ", location = " << se.location << ", shader_type = " << se.shader_type << ", size = " << se.size << ')';
     }
 
+    // returns `true` if `location` is the shader location of a mesh's vertex attribute (e.g. `aPos`)
+    bool is_vertex_attribute_location(int32_t location)
+    {
+        return []<VertexAttribute... Attrs>(int32_t loc, OptionList<VertexAttribute, Attrs...>)
+        {
+            return ((VertexAttributeTraits<Attrs>::shader_location == loc) or ...);
+        }(location, VertexAttributeList{});
+    }
+
+    // returns the number of floats that a per-instance property attribute of the given type occupies
+    // in the instance buffer, or `std::nullopt` if per-instance properties of that type aren't supported
+    std::optional<size_t> num_floats_in_instanced_property(ShaderPropertyType shader_type)
+    {
+        switch (shader_type) {
+        case ShaderPropertyType::Float: return 1;
+        case ShaderPropertyType::Vec2:  return 2;
+        case ShaderPropertyType::Vec3:  return 3;
+        case ShaderPropertyType::Vec4:  return 4;
+        default:                        return std::nullopt;
+        }
+    }
+
+    // writes a per-instance property value (or zeroes, if it's missing or has a mismatched type)
+    // into the instance buffer, returning the number of floats that were written
+    size_t write_instanced_property(
+        const ShaderElement& attribute,
+        const MaterialValue* maybe_value,
+        std::vector<float>& out)
+    {
+        const size_t num_floats = num_floats_in_instanced_property(attribute.shader_type).value_or(0);
+
+        std::array<float, 4> data{};
+        if (maybe_value and get_shader_type(*maybe_value) == attribute.shader_type) {
+            std::visit(Overload{
+                [&data](const Color& color)
+                {
+                    // colors are converted from sRGB to linear, like uniforms
+                    const Vec4 linear_color = to_linear_colorspace(color);
+                    rgs::copy(to_float_span(linear_color), data.begin());
+                },
+                [&data](float v) { data[0] = v; },
+                [&data](const Vec2& v) { rgs::copy(to_float_span(v), data.begin()); },
+                [&data](const Vec3& v) { rgs::copy(to_float_span(v), data.begin()); },
+                [&data](const Vec4& v) { rgs::copy(to_float_span(v), data.begin()); },
+                [](const auto&) {},
+            }, *maybe_value);
+        }
+        out.insert(out.end(), data.begin(), data.begin() + static_cast<ptrdiff_t>(num_floats));
+        return num_floats;
+    }
+
     template<typename Value>
     using FastStringHashtable = ankerl::unordered_dense::map<
         StringName,
@@ -663,6 +735,7 @@ namespace
             swap(a.transform, b.transform);
             swap(a.maybe_submesh_index, b.maybe_submesh_index);
             swap(a.world_centroid, b.world_centroid);
+            swap(a.sort_key, b.sort_key);
         }
 
         friend bool operator==(const RenderObject&, const RenderObject&) = default;
@@ -673,6 +746,7 @@ namespace
         MaybeIndex maybe_submesh_index;
         Mat4 transform;
         Vec3 world_centroid;
+        uint64_t sort_key = 0;  // see: `RenderObjectSortKeyField`, assigned when the object is enqueued
     };
 
     static_assert(std::is_nothrow_destructible_v<RenderObject>);
@@ -728,49 +802,53 @@ namespace
 
     class RenderObjectHasMaterial final {
     public:
-        explicit RenderObjectHasMaterial(const Material* material) :
-            material_{material}
-        {
-            OSC_ASSERT(material_ != nullptr);
-        }
+        explicit RenderObjectHasMaterial(const RenderObject& ro) :
+            ro_{&ro}
+        {}
 
         bool operator()(const RenderObject& ro) const
         {
-            return ro.material == *material_;
+            return is_same_by_sort_key_field(c_material_sort_key_field, ro.sort_key, ro_->sort_key, [&ro, this]()
+            {
+                return ro.material == ro_->material;
+            });
         }
     private:
-        const Material* material_;
+        const RenderObject* ro_;
     };
 
     class RenderObjectHasMaterialPropertyBlock final {
     public:
-        explicit RenderObjectHasMaterialPropertyBlock(const MaterialPropertyBlock& mpb) :
-            mpb_{&mpb}
+        explicit RenderObjectHasMaterialPropertyBlock(const RenderObject& ro) :
+            ro_{&ro}
         {}
 
         bool operator()(const RenderObject& ro) const
         {
-            return ro.property_block == *mpb_;
+            return is_same_by_sort_key_field(c_property_block_sort_key_field, ro.sort_key, ro_->sort_key, [&ro, this]()
+            {
+                return ro.property_block == ro_->property_block;
+            });
         }
-
     private:
-        const MaterialPropertyBlock* mpb_;
+        const RenderObject* ro_;
     };
 
     class RenderObjectHasMesh final {
     public:
-        explicit RenderObjectHasMesh(const Mesh* mesh) :
-            mesh_{mesh}
-        {
-            OSC_ASSERT(mesh_ != nullptr);
-        }
+        explicit RenderObjectHasMesh(const RenderObject& ro) :
+            ro_{&ro}
+        {}
 
         bool operator()(const RenderObject& ro) const
         {
-            return ro.mesh == *mesh_;
+            return is_same_by_sort_key_field(c_mesh_sort_key_field, ro.sort_key, ro_->sort_key, [&ro, this]()
+            {
+                return ro.mesh == ro_->mesh;
+            });
         }
     private:
-        const Mesh* mesh_;
+        const RenderObject* ro_;
     };
 
     class RenderObjectHasSubMeshIndex final {
@@ -796,59 +874,13 @@ namespace
         // partition the render queue into `[opaque_objs | transparent_objs]`
         const auto opaque_objs_end = std::partition(queue_begin, queue_end, is_opaque);
 
-        // optimize the `opaque_objs` partition (it can be reordered safely)
-        //
-        // first, batch `opaque_objs` into `RenderObject`s that have the same `Material`
-        auto material_batch_start = queue_begin;
-        while (material_batch_start != opaque_objs_end) {
-
-            const auto material_batch_end = std::partition(
-                material_batch_start,
-                opaque_objs_end,
-                RenderObjectHasMaterial{&material_batch_start->material}
-            );
-
-            // second, batch `RenderObject`s with the same `Material` into sub-batches
-            // with the same `MaterialPropertyBlock`
-            auto props_batch_start = material_batch_start;
-            while (props_batch_start != material_batch_end) {
-
-                const auto props_batch_end = std::partition(
-                    props_batch_start,
-                    material_batch_end,
-                    RenderObjectHasMaterialPropertyBlock{props_batch_start->property_block}
-                );
-
-                // third, batch `RenderObject`s with the same `Material` and `MaterialPropertyBlock`s
-                // into sub-batches with the same `Mesh`
-                auto mesh_batch_start = props_batch_start;
-                while (mesh_batch_start != props_batch_end) {
-
-                    const auto mesh_batch_end = std::partition(
-                        mesh_batch_start,
-                        props_batch_end,
-                        RenderObjectHasMesh{&mesh_batch_start->mesh}
-                    );
-
-                    // fourth, batch `RenderObject`s with the same `Material`, `MaterialPropertyBlock`,
-                    // and `Mesh` into sub-batches with the same sub-mesh index
-                    auto submesh_batch_start = mesh_batch_start;
-                    while (submesh_batch_start != mesh_batch_end) {
-
-                        const auto submesh_batch_end = std::partition(
-                            submesh_batch_start,
-                            mesh_batch_end,
-                            RenderObjectHasSubMeshIndex{submesh_batch_start->maybe_submesh_index}
-                        );
-
-                        submesh_batch_start = submesh_batch_end;
-                    }
-                    mesh_batch_start = mesh_batch_end;
-                }
-                props_batch_start = props_batch_end;
-            }
-            material_batch_start = material_batch_end;
-        }
+        // optimize the `opaque_objs` partition (it can be reordered safely) by sorting it
+        // by sort key, which groups it by material, then property block, then mesh, then
+        // sub-mesh index
+        std::sort(queue_begin, opaque_objs_end, [](const RenderObject& a, const RenderObject& b)
+        {
+            return a.sort_key < b.sort_key;
+        });
 
         // sort the transparent partition by distance from camera (back-to-front)
         std::sort(opaque_objs_end, queue_end, RenderObjectIsFartherFrom{camera_pos});
@@ -1013,6 +1045,11 @@ namespace osc
         );
 
 
+        static uint64_t calc_sort_key(
+            RenderQueueSortKeyTable&,
+            const RenderObject&
+        );
+
         // public (forwarded) API
 
         static void draw(
@@ -2933,6 +2970,13 @@ private:
         maybe_view_proj_mat_uniform_ = lookup_or_nullopt(uniforms_, "uViewProjMat");
         maybe_instanced_model_mat_attr_ = lookup_or_nullopt(attributes_, "aModelMat");
         maybe_instanced_normal_mat_attr_ = lookup_or_nullopt(attributes_, "aNormalMat");
+
+        // any other attribute that isn't a mesh vertex attribute is a per-instance property
+        for (const auto& [name, attribute] : attributes_) {
+            if (not is_vertex_attribute_location(attribute.location) and name != "aModelMat" and name != "aNormalMat") {
+                instanced_property_attrs_.emplace_back(name, attribute);
+            }
+        }
     }
 
     friend class GraphicsBackend;
@@ -2948,6 +2992,7 @@ private:
     std::optional<ShaderElement> maybe_view_proj_mat_uniform_;
     std::optional<ShaderElement> maybe_instanced_model_mat_attr_;
     std::optional<ShaderElement> maybe_instanced_normal_mat_attr_;
+    std::vector<std::pair<StringName, ShaderElement>> instanced_property_attrs_;
 };
 
 
@@ -3210,6 +3255,18 @@ class osc::MaterialPropertyBlock::Impl final {
 public:
     friend bool operator==(const Impl&, const Impl&) = default;
 
+    // returns a hash of the values in the property block, such that equal property blocks
+    // have equal hashes
+    size_t values_hash() const
+    {
+        // (summed, because equal property blocks may store their values in a different order)
+        size_t rv = 0;
+        for (const auto& [name, value] : values_) {
+            rv += hash_combine(hash_of(name), hash_of_material_value(value));
+        }
+        return rv;
+    }
+
     void clear()
     {
         values_.clear();
@@ -3744,6 +3801,11 @@ bool osc::operator==(const MaterialPropertyBlock& lhs, const MaterialPropertyBlo
     return lhs.impl_ == rhs.impl_ || *lhs.impl_ == *rhs.impl_;
 }
 
+size_t std::hash<osc::MaterialPropertyBlock>::operator()(const osc::MaterialPropertyBlock& block) const
+{
+    return block.impl_->values_hash();
+}
+
 std::ostream& osc::operator<<(std::ostream& o, const MaterialPropertyBlock&)
 {
     return o << "MaterialPropertyBlock()";
@@ -5617,6 +5679,7 @@ private:
     std::optional<Mat4> maybe_view_matrix_override_;
     std::optional<Mat4> maybe_projection_matrix_override_;
     std::vector<RenderObject> render_queue_;
+    RenderQueueSortKeyTable render_queue_sort_keys_;
 };
 
 
@@ -6210,6 +6273,18 @@ public:
         }
 
         SDL_GL_SwapWindow(&window);
+
+        previous_frame_render_statistics_ = std::exchange(current_frame_render_statistics_, RenderStatistics{});
+    }
+
+    RenderStatistics previous_frame_render_statistics() const
+    {
+        return previous_frame_render_statistics_;
+    }
+
+    RenderStatistics& upd_current_frame_render_statistics()
+    {
+        return current_frame_render_statistics_;
     }
 
     std::string backend_vendor_string() const
@@ -6280,6 +6355,10 @@ private:
     // storage for instance data
     std::vector<float> instance_cpu_buffer_;
     gl::ArrayBuffer<float, GL_STREAM_DRAW> instance_gpu_buffer_;
+
+    // counters for the frame that's currently being rendered, and the previous (complete) frame
+    RenderStatistics current_frame_render_statistics_;
+    RenderStatistics previous_frame_render_statistics_;
 };
 
 static std::unique_ptr<osc::GraphicsContext::Impl> g_graphics_context_impl = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -6333,6 +6412,11 @@ void osc::GraphicsContext::swap_buffers(SDL_Window& window)
     g_graphics_context_impl->swap_buffers(window);
 }
 
+RenderStatistics osc::GraphicsContext::previous_frame_render_statistics() const
+{
+    return g_graphics_context_impl->previous_frame_render_statistics();
+}
+
 std::future<Texture2D> osc::GraphicsContext::request_screenshot()
 {
     return g_graphics_context_impl->request_screenshot();
@@ -6470,15 +6554,31 @@ void osc::GraphicsBackend::bind_to_instanced_attributes(
             gl::vertex_attrib_pointer(mmtxAttr, false, instancing_state.stride, instancing_state.base_offset + byte_offset);
             gl::vertex_attrib_divisor(mmtxAttr, 1);
             gl::enable_vertex_attrib_array(mmtxAttr);
-            // unused: byteOffset += sizeof(float) * 16;
+            byte_offset += sizeof(float) * 16;
         }
         else if (shader_impl.maybe_instanced_normal_mat_attr_->shader_type == ShaderPropertyType::Mat3) {
             const gl::AttributeMat3 mmtxAttr{shader_impl.maybe_instanced_normal_mat_attr_->location};
             gl::vertex_attrib_pointer(mmtxAttr, false, instancing_state.stride, instancing_state.base_offset + byte_offset);
             gl::vertex_attrib_divisor(mmtxAttr, 1);
             gl::enable_vertex_attrib_array(mmtxAttr);
-            // unused: byteOffset += sizeof(float) * 9;
+            byte_offset += sizeof(float) * 9;
+        }
+    }
+    for (const auto& [name, attribute] : shader_impl.instanced_property_attrs_) {
+        const auto bind = [&instancing_state, byte_offset]<typename TGlsl>(const gl::Attribute<TGlsl>& attr)
+        {
+            gl::vertex_attrib_pointer(attr, false, instancing_state.stride, instancing_state.base_offset + byte_offset);
+            gl::vertex_attrib_divisor(attr, 1);
+            gl::enable_vertex_attrib_array(attr);
+        };
+        switch (attribute.shader_type) {
+        case ShaderPropertyType::Float: bind(gl::AttributeFloat{attribute.location}); break;
+        case ShaderPropertyType::Vec2:  bind(gl::AttributeVec2{attribute.location}); break;
+        case ShaderPropertyType::Vec3:  bind(gl::AttributeVec3{attribute.location}); break;
+        case ShaderPropertyType::Vec4:  bind(gl::AttributeVec4{attribute.location}); break;
+        default:                        break;  // unsupported: not in the instance buffer
         }
+        byte_offset += sizeof(float) * num_floats_in_instanced_property(attribute.shader_type).value_or(0);
     }
 }
 
@@ -6503,6 +6603,11 @@ void osc::GraphicsBackend::unbind_from_instanced_attributes(
             gl::disable_vertex_attrib_array(mmtxAttr);
         }
     }
+    for (const auto& [name, attribute] : shader_impl.instanced_property_attrs_) {
+        if (num_floats_in_instanced_property(attribute.shader_type)) {
+            gl::disable_vertex_attrib_array(gl::AttributeVec4{attribute.location});  // (one location, regardless of type)
+        }
+    }
 }
 
 // helper: upload instancing data for a batch
@@ -6513,7 +6618,7 @@ std::optional<InstancingState> osc::GraphicsBackend::upload_instance_data(
     // preemptively upload instancing data
     std::optional<InstancingState> maybeInstancingState;
 
-    if (shader_impl.maybe_instanced_model_mat_attr_ or shader_impl.maybe_instanced_normal_mat_attr_) {
+    if (shader_impl.maybe_instanced_model_mat_attr_ or shader_impl.maybe_instanced_normal_mat_attr_ or not shader_impl.instanced_property_attrs_.empty()) {
 
         // compute the stride between each instance
         size_t byte_stride = 0;
@@ -6530,6 +6635,9 @@ std::optional<InstancingState> osc::GraphicsBackend::upload_instance_data(
                 byte_stride += sizeof(float) * 9;
             }
         }
+        for (const auto& [name, attribute] : shader_impl.instanced_property_attrs_) {
+            byte_stride += sizeof(float) * num_floats_in_instanced_property(attribute.shader_type).value_or(0);
+        }
 
         // write the instance data into a CPU-side buffer
 
@@ -6562,6 +6670,9 @@ std::optional<InstancingState> osc::GraphicsBackend::upload_instance_data(
                     float_offset += els.size();
                 }
             }
+            for (const auto& [name, attribute] : shader_impl.instanced_property_attrs_) {
+                float_offset += write_instanced_property(attribute, lookup_or_nullptr(render_object.property_block.impl_->values_, name), buf);
+            }
         }
         OSC_ASSERT_ALWAYS(sizeof(float)*float_offset == render_queue.size() * byte_stride);
 
@@ -6876,6 +6987,8 @@ void osc::GraphicsBackend::handle_batch_with_same_submesh(
     auto& mesh_impl = const_cast<Mesh::Impl&>(*batch.front().mesh.impl_);
     const Shader::Impl& shader_impl = *batch.front().material.impl_->shader_.impl_;
     const MaybeIndex maybe_submesh_index = batch.front().maybe_submesh_index;
+    RenderStatistics& statistics = g_graphics_context_impl->upd_current_frame_render_statistics();
+    ++statistics.num_batches;
 
     gl::bind_vertex_array(mesh_impl.upd_vertex_array());
 
@@ -6909,6 +7022,7 @@ void osc::GraphicsBackend::handle_batch_with_same_submesh(
                 bind_to_instanced_attributes(shader_impl, *instancing_state);
             }
             mesh_impl.drawInstanced(1, maybe_submesh_index);
+            ++statistics.num_draw_calls;
             if (instancing_state) {
                 unbind_from_instanced_attributes(shader_impl, *instancing_state);
                 instancing_state->base_offset += 1 * instancing_state->stride;
@@ -6922,6 +7036,7 @@ void osc::GraphicsBackend::handle_batch_with_same_submesh(
             bind_to_instanced_attributes(shader_impl, *instancing_state);
         }
         mesh_impl.drawInstanced(batch.size(), maybe_submesh_index);
+        ++statistics.num_draw_calls;
         if (instancing_state) {
             unbind_from_instanced_attributes(shader_impl, *instancing_state);
             instancing_state->base_offset += batch.size() * instancing_state->stride;
@@ -6975,7 +7090,7 @@ void osc::GraphicsBackend::handle_batch_with_same_material_property_block(
     // batch by mesh
     auto subbatch_begin = batch.begin();
     while (subbatch_begin != batch.end()) {
-        const auto subbatch_end = find_if_not(subbatch_begin, batch.end(), RenderObjectHasMesh{&subbatch_begin->mesh});
+        const auto subbatch_end = find_if_not(subbatch_begin, batch.end(), RenderObjectHasMesh{*subbatch_begin});
         handle_batch_with_same_mesh({subbatch_begin, subbatch_end}, instancing_state);
         subbatch_begin = subbatch_end;
     }
@@ -7073,7 +7188,7 @@ void osc::GraphicsBackend::handle_batch_with_same_material(
     auto subbatch_begin = batch.begin();
     while (subbatch_begin != batch.end())
     {
-        const auto subbatch_end = find_if_not(subbatch_begin, batch.end(), RenderObjectHasMaterialPropertyBlock{subbatch_begin->property_block});
+        const auto subbatch_end = find_if_not(subbatch_begin, batch.end(), RenderObjectHasMaterialPropertyBlock{*subbatch_begin});
         handle_batch_with_same_material_property_block({subbatch_begin, subbatch_end}, texture_slot, maybe_instances);
         subbatch_begin = subbatch_end;
     }
@@ -7117,7 +7232,7 @@ void osc::GraphicsBackend::draw_render_objects(
     // batch by material
     auto subbatch_begin = batch.begin();
     while (subbatch_begin != batch.end()) {
-        const auto subbatch_end = find_if_not(subbatch_begin, batch.end(), RenderObjectHasMaterial{&subbatch_begin->material});
+        const auto subbatch_end = find_if_not(subbatch_begin, batch.end(), RenderObjectHasMaterial{*subbatch_begin});
         handle_batch_with_same_material(render_pass_state, {subbatch_begin, subbatch_end});
         subbatch_begin = subbatch_end;
     }
@@ -7170,6 +7285,7 @@ void osc::GraphicsBackend::flush_render_queue(Camera::Impl& camera, float aspect
     if (queue.empty()) {
         return;
     }
+    g_graphics_context_impl->upd_current_frame_render_statistics().num_render_objects += queue.size();
 
     // precompute any render pass state used by the rendering algs
     const RenderPassState renderPassState{
@@ -7210,6 +7326,7 @@ void osc::GraphicsBackend::flush_render_queue(Camera::Impl& camera, float aspect
 
     // queue flushed: clear it
     queue.clear();
+    camera.render_queue_sort_keys_.clear();
 }
 
 osc::GraphicsBackend::ViewportGeometry osc::GraphicsBackend::calc_viewport_geometry(
@@ -7584,6 +7701,43 @@ void osc::GraphicsBackend::render_camera_queue(
     );
 }
 
+uint64_t osc::GraphicsBackend::calc_sort_key(
+    RenderQueueSortKeyTable& table,
+    const RenderObject& render_object)
+{
+    const Shader::Impl& shader_impl = *render_object.material.impl_->shader_.impl_;
+    const MaterialPropertyBlock& property_block = render_object.property_block;
+
+    uint64_t property_block_id = 0;
+    if (shader_impl.instanced_property_attrs_.empty()) {
+        property_block_id = table.property_block_id(property_block.impl_.get(), nullptr, [&property_block]()
+        {
+            return std::pair{property_block, property_block.impl_->values_hash()};
+        });
+    }
+    else {
+        // per-instance properties are written into the instance buffer, so they shouldn't
+        // prevent objects from being batched: identify the block by its other values
+        property_block_id = table.property_block_id(property_block.impl_.get(), &shader_impl, [&property_block, &shader_impl]()
+        {
+            MaterialPropertyBlock shared_values = property_block;
+            for (const auto& [name, _] : shader_impl.instanced_property_attrs_) {
+                shared_values.unset(name);
+            }
+            const size_t hash = shared_values.impl_->values_hash();
+            return std::pair{std::move(shared_values), hash};
+        });
+    }
+    const uint64_t submesh_id = render_object.maybe_submesh_index ? *render_object.maybe_submesh_index + 1 : 0;
+
+    return pack_render_object_sort_key(
+        table.material_id(render_object.material.impl_.get()),
+        property_block_id,
+        table.mesh_id(render_object.mesh.impl_.get()),
+        submesh_id
+    );
+}
+
 void osc::GraphicsBackend::draw(
     const Mesh& mesh,
     const Transform& transform,
@@ -7596,13 +7750,15 @@ void osc::GraphicsBackend::draw(
         throw std::out_of_range{"the given sub-mesh index was out of range (i.e. the given mesh does not have that many sub-meshes)"};
     }
 
-    camera.impl_.upd()->render_queue_.emplace_back(
+    Camera::Impl& camera_impl = *camera.impl_.upd();
+    RenderObject& render_object = camera_impl.render_queue_.emplace_back(
         mesh,
         transform,
         material,
         maybe_material_property_block,
         maybe_submesh_index
     );
+    render_object.sort_key = calc_sort_key(camera_impl.render_queue_sort_keys_, render_object);
 }
 
 void osc::GraphicsBackend::draw(
@@ -7617,13 +7773,15 @@ void osc::GraphicsBackend::draw(
         throw std::out_of_range{"the given sub-mesh index was out of range (i.e. the given mesh does not have that many sub-meshes)"};
     }
 
-    camera.impl_.upd()->render_queue_.emplace_back(
+    Camera::Impl& camera_impl = *camera.impl_.upd();
+    RenderObject& render_object = camera_impl.render_queue_.emplace_back(
         mesh,
         transform,
         material,
         maybe_material_property_block,
         maybe_submesh_index
     );
+    render_object.sort_key = calc_sort_key(camera_impl.render_queue_sort_keys_, render_object);
 }
 
 void osc::GraphicsBackend::blit(
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+namespace osc
+{
+    // counters that describe how much work the graphics backend did when rendering
+    //
+    // handy for checking whether render queue batching is working (e.g. a scene
+    // containing many instances of the same mesh should only need a few draw calls)
+    struct RenderStatistics final {
+
+        friend bool operator==(const RenderStatistics&, const RenderStatistics&) = default;
+
+        // number of enqueued (i.e. `graphics::draw`n) objects that were rendered
+        size_t num_render_objects = 0;
+
+        // number of batches of render objects with the same material, property block,
+        // mesh, and sub-mesh that were rendered
+        size_t num_batches = 0;
+
+        // number of draw calls that were submitted to the GPU
+        size_t num_draw_calls = 0;
+    };
+}
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <oscar/Graphics/Scene/CachedSceneRenderer.h>
+#include <oscar/Graphics/Scene/MeshDiskCache.h>
 #include <oscar/Graphics/Scene/SceneCache.h>
+#include <oscar/Graphics/Scene/SceneCacheLoadingProgress.h>
+#include <oscar/Graphics/Scene/SceneCachePendingMeshes.h>
 #include <oscar/Graphics/Scene/SceneCollision.h>
 #include <oscar/Graphics/Scene/SceneDecoration.h>
 #include <oscar/Graphics/Scene/SceneDecorationFlags.h>
+#include <oscar/Graphics/Scene/SceneDecorationList.h>
 #include <oscar/Graphics/Scene/SceneDecorationShading.h>
 #include <oscar/Graphics/Scene/SceneHelpers.h>
 #include <oscar/Graphics/Scene/SceneRenderer.h>
@@ -1,18 +1,20 @@
 #include "CachedSceneRenderer.h"
 
 #include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Graphics/Scene/SceneDecorationList.h>
 #include <oscar/Graphics/Scene/SceneRenderer.h>
 #include <oscar/Graphics/Scene/SceneRendererParams.h>
-#include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/HashHelpers.h>
 
 #include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <memory>
-#include <ranges>
+#include <optional>
 #include <span>
 #include <vector>
 
 using namespace osc;
-namespace rgs = std::ranges;
 
 class osc::CachedSceneRenderer::Impl final {
 public:
@@ -24,11 +26,38 @@ public:
         std::span<const SceneDecoration> decorations,
         const SceneRendererParams& params)
     {
-        if (params != last_rendering_params_ or not rgs::equal(decorations, last_decoration_list_)) {
+        // hash the decorations the same way that `SceneDecorationList` does, which is cheaper
+        // than deep-comparing them against the previous ones
+        decoration_hashes_scratch_.clear();
+        decoration_hashes_scratch_.reserve(decorations.size());
+        size_t list_hash = 0;
+        for (const SceneDecoration& decoration : decorations) {
+            const size_t decoration_hash = std::hash<SceneDecoration>{}(decoration);
+            decoration_hashes_scratch_.push_back(decoration_hash);
+            list_hash = hash_combine(list_hash, decoration_hash);
+        }
+
+        return render(decorations, decoration_hashes_scratch_, list_hash, params);
+    }
+
+    RenderTexture& render(
+        std::span<const SceneDecoration> decorations,
+        std::span<const size_t> decoration_hashes,
+        size_t list_hash,
+        const SceneRendererParams& params)
+    {
+        const bool decorations_changed =
+            list_hash != last_decoration_list_hash_ or
+            decorations.size() != last_decoration_list_.size();
+
+        if (decorations_changed or params != last_rendering_params_) {
 
             // inputs have changed: cache the new ones and re-render
+            if (decorations_changed) {
+                update_last_decoration_list(decorations, decoration_hashes);
+                last_decoration_list_hash_ = list_hash;
+            }
             last_rendering_params_ = params;
-            last_decoration_list_.assign(decorations.begin(), decorations.end());
             scene_renderer_.render(last_decoration_list_, last_rendering_params_);
         }
 
@@ -36,8 +65,29 @@ public:
     }
 
 private:
+    // updates the cached decoration list by only copying the decorations that have changed
+    // (per their hashes), rather than copying every decoration
+    void update_last_decoration_list(
+        std::span<const SceneDecoration> decorations,
+        std::span<const size_t> decoration_hashes)
+    {
+        const size_t num_unchanged_candidates = std::min(decorations.size(), last_decoration_list_.size());
+
+        last_decoration_list_.resize(decorations.size());
+        last_decoration_hashes_.resize(decorations.size());
+        for (size_t i = 0; i < decorations.size(); ++i) {
+            if (i >= num_unchanged_candidates or decoration_hashes[i] != last_decoration_hashes_[i]) {
+                last_decoration_list_[i] = decorations[i];
+                last_decoration_hashes_[i] = decoration_hashes[i];
+            }
+        }
+    }
+
     SceneRendererParams last_rendering_params_;
     std::vector<SceneDecoration> last_decoration_list_;
+    std::vector<size_t> last_decoration_hashes_;
+    std::optional<size_t> last_decoration_list_hash_;  // `std::nullopt` forces the first render
+    std::vector<size_t> decoration_hashes_scratch_;
     SceneRenderer scene_renderer_;
 };
 
@@ -56,3 +106,10 @@ RenderTexture& osc::CachedSceneRenderer::render(
 {
     return impl_->render(decorations, params);
 }
+
+RenderTexture& osc::CachedSceneRenderer::render(
+    const SceneDecorationList& decorations,
+    const SceneRendererParams& params)
+{
+    return impl_->render(decorations, decorations.decoration_hashes(), decorations.hash(), params);
+}
@@ -5,6 +5,7 @@
 
 namespace osc { class RenderTexture; }
 namespace osc { struct SceneDecoration; }
+namespace osc { class SceneDecorationList; }
 namespace osc { class SceneCache; }
 namespace osc { struct SceneRendererParams; }
 
@@ -12,6 +13,9 @@ namespace osc
 {
     // a cached version of `SceneRenderer` that will re-render if either
     // the `SceneDecoration`s or the `SceneRendererParams` change
+    //
+    // changes are detected by hashing the decorations, rather than by deep-comparing
+    // them, and only the decorations that changed are copied into the cache
     class CachedSceneRenderer final {
     public:
         CachedSceneRenderer(SceneCache&);
@@ -23,6 +27,10 @@ namespace osc
 
         RenderTexture& render(std::span<const SceneDecoration>, const SceneRendererParams&);
 
+        // as above, but uses the hashes that the `SceneDecorationList` computed while it was
+        // populated, so that detecting an unchanged list is O(1)
+        RenderTexture& render(const SceneDecorationList&, const SceneRendererParams&);
+
     private:
         class Impl;
         std::unique_ptr<Impl> impl_;
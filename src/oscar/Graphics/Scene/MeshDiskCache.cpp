@@ -0,0 +1,573 @@
+#include "MeshDiskCache.h"
+
+#include <oscar/Graphics/Color.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshIndicesView.h>
+#include <oscar/Graphics/MeshTopology.h>
+#include <oscar/Graphics/SubMeshDescriptor.h>
+#include <oscar/Maths/AABB.h>
+#include <oscar/Maths/BVH.h>
+#include <oscar/Maths/BVHNode.h>
+#include <oscar/Maths/BVHPrim.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Maths/Vec4.h>
+#include <oscar/Platform/Log.h>
+#include <oscar/Platform/MemoryMappedFile.h>
+#include <oscar/Utils/EnumHelpers.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+namespace rgs = std::ranges;
+
+// on-disk mesh format (`.oscmesh`)
+//
+// all values are written in the machine's native byte order (little-endian on all supported
+// platforms) and each section starts on an 8-byte boundary, so that the sections can be read
+// straight out of the memory-mapped file:
+//
+//     EntryHeader
+//     char[]                   source file path (generic format, not null-terminated)
+//     Vec3[]                   vertices
+//     Vec3[]                   normals (none, or one per vertex)
+//     Vec2[]                   texture coordinates (none, or one per vertex)
+//     Color[]                  colors (none, or one per vertex)
+//     Vec4[]                   tangents (none, or one per vertex)
+//     uint16[] or uint32[]     indices
+//     DiskSubMeshDescriptor[]  submesh descriptors
+//     DiskBVHNode[]            triangle BVH nodes (depth-first)
+//     DiskBVHPrim[]            triangle BVH prims
+//
+// the mesh's bounds aren't stored, because `Mesh` recalculates them "for free" while it
+// range-checks the indices (which it must do anyway, because the file might be corrupt)
+namespace
+{
+    static_assert(std::endian::native == std::endian::little, "the on-disk mesh format is only supported on little-endian machines");
+
+    constexpr auto c_magic = std::to_array<char>({'O', 'S', 'C', 'M', 'E', 'S', 'H', '\0'});
+    constexpr uint32_t c_version = 1;
+    constexpr size_t c_alignment = 8;
+    constexpr std::string_view c_entry_extension = ".oscmesh";
+    constexpr uint64_t c_bvh_node_leaf_bit = uint64_t{1} << 63;
+
+    struct EntryHeader final {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t topology;
+        uint64_t source_size;
+        int64_t source_last_write_time;  // in ticks of `std::filesystem::file_time_type`
+        uint64_t source_content_hash;
+        uint64_t source_path_length;
+        uint64_t num_vertices;
+        uint64_t num_normals;
+        uint64_t num_tex_coords;
+        uint64_t num_colors;
+        uint64_t num_tangents;
+        uint64_t num_indices;
+        uint32_t index_size;  // in bytes (2 or 4)
+        uint32_t reserved;
+        uint64_t num_submesh_descriptors;
+        uint64_t num_bvh_nodes;
+        uint64_t num_bvh_prims;
+    };
+
+    struct DiskSubMeshDescriptor final {
+        uint64_t index_start;
+        uint64_t index_count;
+        uint64_t base_vertex;
+        uint32_t topology;
+        uint32_t reserved;
+    };
+
+    struct DiskBVHNode final {
+        AABB bounds;
+        uint64_t data;  // `c_bvh_node_leaf_bit` | first prim offset, or the number of left-hand nodes
+    };
+
+    struct DiskBVHPrim final {
+        int64_t id;
+        AABB bounds;
+    };
+
+    template<typename T>
+    constexpr bool c_is_writable_section_type = std::is_trivially_copyable_v<T> and alignof(T) <= c_alignment;
+
+    static_assert(c_is_writable_section_type<EntryHeader> and sizeof(EntryHeader) % c_alignment == 0);
+    static_assert(c_is_writable_section_type<DiskSubMeshDescriptor> and sizeof(DiskSubMeshDescriptor) == 32);
+    static_assert(c_is_writable_section_type<DiskBVHNode> and sizeof(DiskBVHNode) == 32);
+    static_assert(c_is_writable_section_type<DiskBVHPrim> and sizeof(DiskBVHPrim) == 32);
+    static_assert(c_is_writable_section_type<Vec3> and sizeof(Vec3) == 3*sizeof(float));
+    static_assert(c_is_writable_section_type<Color> and sizeof(Color) == 4*sizeof(float));
+
+    constexpr size_t round_up_to_alignment(size_t n)
+    {
+        return ((n + c_alignment - 1) / c_alignment) * c_alignment;
+    }
+
+    // returns a 64-bit FNV-1a hash of the given bytes (stable across runs/platforms, unlike `std::hash`)
+    uint64_t stable_hash_of(std::span<const std::byte> bytes)
+    {
+        uint64_t rv = 0xcbf29ce484222325;
+        for (const std::byte b : bytes) {
+            rv ^= static_cast<uint64_t>(b);
+            rv *= 0x100000001b3;
+        }
+        return rv;
+    }
+
+    uint64_t stable_hash_of(std::string_view str)
+    {
+        return stable_hash_of(std::as_bytes(std::span{str}));
+    }
+
+    uint64_t content_hash_of(const std::filesystem::path& path)
+    {
+        return stable_hash_of(MemoryMappedFile{path}.bytes());
+    }
+
+    // returns the canonical string form of a source path, which is what entries are keyed by
+    std::string source_key_of(const std::filesystem::path& source_path)
+    {
+        return std::filesystem::absolute(source_path).lexically_normal().generic_string();
+    }
+
+    std::filesystem::path entry_path_of(const std::filesystem::path& directory, std::string_view source_key)
+    {
+        std::stringstream ss;
+        ss << std::hex << stable_hash_of(source_key) << c_entry_extension;
+        return directory / std::move(ss).str();
+    }
+
+    int64_t last_write_time_of(const std::filesystem::path& path)
+    {
+        return static_cast<int64_t>(std::filesystem::last_write_time(path).time_since_epoch().count());
+    }
+
+    // writes the given values, followed by zero-padding to the next alignment boundary
+    template<typename T>
+    requires c_is_writable_section_type<T>
+    void write_section(std::ostream& out, std::span<const T> values)
+    {
+        constexpr std::array<char, c_alignment> c_zeroes{};
+        const std::span<const std::byte> bytes = std::as_bytes(values);
+        out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        out.write(c_zeroes.data(), static_cast<std::streamsize>(round_up_to_alignment(bytes.size()) - bytes.size()));
+    }
+
+    void write_entry(
+        std::ostream& out,
+        std::string_view source_key,
+        const std::filesystem::path& source_path,
+        const Mesh& mesh,
+        const BVH& bvh)
+    {
+        const std::vector<Vec3> vertices = mesh.vertices();
+        const std::vector<Vec3> normals = mesh.normals();
+        const std::vector<Vec2> tex_coords = mesh.tex_coords();
+        const std::vector<Color> colors = mesh.colors();
+        const std::vector<Vec4> tangents = mesh.tangents();
+        const MeshIndicesView indices = mesh.indices();
+
+        std::vector<DiskSubMeshDescriptor> submesh_descriptors;
+        submesh_descriptors.reserve(mesh.num_submesh_descriptors());
+        for (size_t i = 0; i < mesh.num_submesh_descriptors(); ++i) {
+            const SubMeshDescriptor& descriptor = mesh.submesh_descriptor_at(i);
+            submesh_descriptors.push_back({
+                .index_start = descriptor.index_start(),
+                .index_count = descriptor.index_count(),
+                .base_vertex = descriptor.base_vertex(),
+                .topology = static_cast<uint32_t>(descriptor.topology()),
+                .reserved = 0,
+            });
+        }
+
+        std::vector<DiskBVHNode> bvh_nodes;
+        bvh_nodes.reserve(bvh.nodes().size());
+        for (const BVHNode& node : bvh.nodes()) {
+            const uint64_t data = node.is_leaf() ?
+                (c_bvh_node_leaf_bit | node.first_prim_offset()) :
+                node.num_lhs_nodes();
+            bvh_nodes.push_back({node.bounds(), data});
+        }
+
+        std::vector<DiskBVHPrim> bvh_prims;
+        bvh_prims.reserve(bvh.prims().size());
+        for (const BVHPrim& prim : bvh.prims()) {
+            bvh_prims.push_back({prim.id(), prim.bounds()});
+        }
+
+        const EntryHeader header{
+            .magic = c_magic,
+            .version = c_version,
+            .topology = static_cast<uint32_t>(mesh.topology()),
+            .source_size = std::filesystem::file_size(source_path),
+            .source_last_write_time = last_write_time_of(source_path),
+            .source_content_hash = content_hash_of(source_path),
+            .source_path_length = source_key.size(),
+            .num_vertices = vertices.size(),
+            .num_normals = normals.size(),
+            .num_tex_coords = tex_coords.size(),
+            .num_colors = colors.size(),
+            .num_tangents = tangents.size(),
+            .num_indices = indices.size(),
+            .index_size = indices.is_uint16() ? uint32_t{sizeof(uint16_t)} : uint32_t{sizeof(uint32_t)},
+            .reserved = 0,
+            .num_submesh_descriptors = submesh_descriptors.size(),
+            .num_bvh_nodes = bvh_nodes.size(),
+            .num_bvh_prims = bvh_prims.size(),
+        };
+
+        write_section(out, std::span{&header, 1});
+        write_section(out, std::span{source_key});
+        write_section(out, std::span<const Vec3>{vertices});
+        write_section(out, std::span<const Vec3>{normals});
+        write_section(out, std::span<const Vec2>{tex_coords});
+        write_section(out, std::span<const Color>{colors});
+        write_section(out, std::span<const Vec4>{tangents});
+        if (indices.is_uint16()) {
+            write_section(out, indices.to_uint16_span());
+        }
+        else {
+            write_section(out, indices.to_uint32_span());
+        }
+        write_section(out, std::span<const DiskSubMeshDescriptor>{submesh_descriptors});
+        write_section(out, std::span<const DiskBVHNode>{bvh_nodes});
+        write_section(out, std::span<const DiskBVHPrim>{bvh_prims});
+    }
+
+    // a bounds-checked cursor for reading sections out of a (mapped) entry
+    class Cursor final {
+    public:
+        explicit Cursor(std::span<const std::byte> bytes) :
+            bytes_{bytes}
+        {}
+
+        template<typename T>
+        requires c_is_writable_section_type<T>
+        std::span<const T> read_section(uint64_t num_values)
+        {
+            const size_t remaining = bytes_.size() - offset_;
+            if (num_values > remaining / sizeof(T)) {
+                throw std::runtime_error{"unexpected end of file"};
+            }
+            const size_t num_bytes = static_cast<size_t>(num_values) * sizeof(T);
+            const auto* first = reinterpret_cast<const T*>(bytes_.data() + offset_);
+            offset_ = std::min(bytes_.size(), offset_ + round_up_to_alignment(num_bytes));
+            return {first, static_cast<size_t>(num_values)};
+        }
+
+        template<typename T>
+        requires c_is_writable_section_type<T>
+        T read_value()
+        {
+            T rv;
+            std::memcpy(&rv, read_section<T>(1).data(), sizeof(T));
+            return rv;
+        }
+
+    private:
+        std::span<const std::byte> bytes_;
+        size_t offset_ = 0;
+    };
+
+    MeshTopology read_topology(uint32_t value)
+    {
+        if (value >= num_options<MeshTopology>()) {
+            throw std::runtime_error{"invalid mesh topology"};
+        }
+        return static_cast<MeshTopology>(value);
+    }
+
+    template<typename T>
+    std::span<const T> read_vertex_attribute(Cursor& cursor, uint64_t num_values, uint64_t num_vertices)
+    {
+        if (num_values != 0 and num_values != num_vertices) {
+            throw std::runtime_error{"a vertex attribute has a different number of values from the number of vertices"};
+        }
+        return cursor.read_section<T>(num_values);
+    }
+
+    template<typename T>
+    uint64_t max_index_of(std::span<const T> indices)
+    {
+        return indices.empty() ? 0 : static_cast<uint64_t>(*rgs::max_element(indices));
+    }
+
+    // returns `std::nullopt` if the entry is for a different source file, or is stale; throws
+    // if the entry is corrupt
+    std::optional<MeshDiskCacheEntry> read_entry(
+        std::span<const std::byte> bytes,
+        std::string_view source_key,
+        const std::filesystem::path& source_path)
+    {
+        Cursor cursor{bytes};
+
+        const auto header = cursor.read_value<EntryHeader>();
+        if (header.magic != c_magic) {
+            throw std::runtime_error{"not a mesh cache entry (bad magic number)"};
+        }
+        if (header.version != c_version) {
+            return std::nullopt;  // written by a different version of the application
+        }
+
+        const std::span<const char> stored_source_key = cursor.read_section<char>(header.source_path_length);
+        if (std::string_view(stored_source_key.data(), stored_source_key.size()) != source_key) {
+            return std::nullopt;  // a different source file that has the same key hash
+        }
+
+        if (header.source_size != std::filesystem::file_size(source_path)) {
+            return std::nullopt;  // the source file has changed
+        }
+        if (header.source_last_write_time != last_write_time_of(source_path) and
+            header.source_content_hash != content_hash_of(source_path)) {
+
+            return std::nullopt;  // the source file has changed
+        }
+
+        const MeshTopology topology = read_topology(header.topology);
+        const auto vertices = cursor.read_section<Vec3>(header.num_vertices);
+        const auto normals = read_vertex_attribute<Vec3>(cursor, header.num_normals, header.num_vertices);
+        const auto tex_coords = read_vertex_attribute<Vec2>(cursor, header.num_tex_coords, header.num_vertices);
+        const auto colors = read_vertex_attribute<Color>(cursor, header.num_colors, header.num_vertices);
+        const auto tangents = read_vertex_attribute<Vec4>(cursor, header.num_tangents, header.num_vertices);
+
+        MeshDiskCacheEntry rv;
+        rv.mesh.set_topology(topology);
+        rv.mesh.set_vertices(vertices);
+        rv.mesh.set_normals(normals);
+        rv.mesh.set_tex_coords(tex_coords);
+        rv.mesh.set_colors(colors);
+        rv.mesh.set_tangents(tangents);
+
+        // (`Mesh` range-checks the indices, but not their submeshes' base vertices)
+        std::span<const uint16_t> uint16_indices;
+        std::span<const uint32_t> uint32_indices;
+        if (header.index_size == sizeof(uint16_t)) {
+            uint16_indices = cursor.read_section<uint16_t>(header.num_indices);
+            rv.mesh.set_indices(uint16_indices);
+        }
+        else if (header.index_size == sizeof(uint32_t)) {
+            uint32_indices = cursor.read_section<uint32_t>(header.num_indices);
+            rv.mesh.set_indices(uint32_indices);
+        }
+        else {
+            throw std::runtime_error{"invalid index size"};
+        }
+
+        for (const DiskSubMeshDescriptor& descriptor : cursor.read_section<DiskSubMeshDescriptor>(header.num_submesh_descriptors)) {
+            if (descriptor.index_start > header.num_indices or descriptor.index_count > header.num_indices - descriptor.index_start) {
+                throw std::runtime_error{"a submesh descriptor references out-of-bounds indices"};
+            }
+            if (descriptor.index_count > 0) {
+                const auto first = static_cast<size_t>(descriptor.index_start);
+                const auto count = static_cast<size_t>(descriptor.index_count);
+                const uint64_t max_index = header.index_size == sizeof(uint16_t) ?
+                    max_index_of(uint16_indices.subspan(first, count)) :
+                    max_index_of(uint32_indices.subspan(first, count));
+                if (descriptor.base_vertex >= header.num_vertices or max_index >= header.num_vertices - descriptor.base_vertex) {
+                    throw std::runtime_error{"a submesh descriptor references out-of-bounds vertices"};
+                }
+            }
+            rv.mesh.push_submesh_descriptor(SubMeshDescriptor{
+                static_cast<size_t>(descriptor.index_start),
+                static_cast<size_t>(descriptor.index_count),
+                read_topology(descriptor.topology),
+                static_cast<size_t>(descriptor.base_vertex),
+            });
+        }
+
+        std::vector<BVHNode> bvh_nodes;
+        bvh_nodes.reserve(static_cast<size_t>(header.num_bvh_nodes));
+        for (const DiskBVHNode& node : cursor.read_section<DiskBVHNode>(header.num_bvh_nodes)) {
+            const auto value = static_cast<size_t>(node.data & ~c_bvh_node_leaf_bit);
+            bvh_nodes.push_back((node.data & c_bvh_node_leaf_bit) ?
+                BVHNode::leaf(node.bounds, value) :
+                BVHNode::node(node.bounds, value)
+            );
+        }
+
+        // triangle BVH prims reference the first index of each triangle
+        std::vector<BVHPrim> bvh_prims;
+        bvh_prims.reserve(static_cast<size_t>(header.num_bvh_prims));
+        for (const DiskBVHPrim& prim : cursor.read_section<DiskBVHPrim>(header.num_bvh_prims)) {
+            if (prim.id < 0 or static_cast<uint64_t>(prim.id) + 3 > header.num_indices) {
+                throw std::runtime_error{"a BVH primitive references an out-of-bounds triangle"};
+            }
+            bvh_prims.emplace_back(static_cast<ptrdiff_t>(prim.id), prim.bounds);
+        }
+        rv.bvh.assign(std::move(bvh_nodes), std::move(bvh_prims));  // (validates the tree)
+
+        return rv;
+    }
+
+    // entries' last-modification times are used as their last-used times when pruning
+    void mark_as_recently_used(const std::filesystem::path& entry_path)
+    {
+        std::error_code ec;
+        std::filesystem::last_write_time(entry_path, std::filesystem::file_time_type::clock::now(), ec);
+    }
+
+    bool is_temporary_file(const std::filesystem::path& path)
+    {
+        return path.filename().string().find(std::string{c_entry_extension} + ".tmp") != std::string::npos;
+    }
+
+    // returns a path for a temporary file that an entry can be written to before it's
+    // (atomically) renamed into place
+    std::filesystem::path temporary_path_for(const std::filesystem::path& entry_path)
+    {
+        static std::atomic<uint64_t> s_counter = 0;
+        std::stringstream ss;
+        ss << ".tmp" << std::hash<std::thread::id>{}(std::this_thread::get_id()) << '_' << s_counter++;
+        std::filesystem::path rv = entry_path;
+        rv += std::move(ss).str();
+        return rv;
+    }
+}
+
+osc::MeshDiskCache::MeshDiskCache(std::filesystem::path directory, uint64_t max_size_in_bytes) :
+    directory_{std::move(directory)},
+    max_size_in_bytes_{max_size_in_bytes}
+{}
+
+std::optional<MeshDiskCacheEntry> osc::MeshDiskCache::try_load(const std::filesystem::path& source_path) const
+{
+    try {
+        const std::string source_key = source_key_of(source_path);
+        const std::filesystem::path entry_path = entry_path_of(directory_, source_key);
+        if (not std::filesystem::exists(entry_path) or not std::filesystem::exists(source_path)) {
+            return std::nullopt;
+        }
+
+        const MemoryMappedFile entry{entry_path};
+        try {
+            std::optional<MeshDiskCacheEntry> rv = read_entry(entry.bytes(), source_key, source_path);
+            if (rv) {
+                mark_as_recently_used(entry_path);
+            }
+            return rv;
+        }
+        catch (const std::exception& ex) {
+            log_warn("%s: ignoring corrupt mesh cache entry (for %s): %s", entry_path.string().c_str(), source_key.c_str(), ex.what());
+            return std::nullopt;
+        }
+    }
+    catch (const std::exception& ex) {
+        log_warn("%s: error reading mesh cache entry: %s", source_path.string().c_str(), ex.what());
+        return std::nullopt;
+    }
+}
+
+void osc::MeshDiskCache::store(const std::filesystem::path& source_path, const Mesh& mesh, const BVH& bvh) const
+{
+    std::filesystem::path temporary_path;
+    try {
+        const std::string source_key = source_key_of(source_path);
+        const std::filesystem::path entry_path = entry_path_of(directory_, source_key);
+        std::filesystem::create_directories(directory_);
+
+        temporary_path = temporary_path_for(entry_path);
+        {
+            std::ofstream out{temporary_path, std::ios::binary | std::ios::trunc};
+            out.exceptions(std::ios::failbit | std::ios::badbit);
+            write_entry(out, source_key, source_path, mesh, bvh);
+        }
+        std::filesystem::rename(temporary_path, entry_path);
+    }
+    catch (const std::exception& ex) {
+        log_warn("%s: error writing mesh cache entry: %s", source_path.string().c_str(), ex.what());
+        if (not temporary_path.empty()) {
+            std::error_code ec;
+            std::filesystem::remove(temporary_path, ec);
+        }
+    }
+}
+
+void osc::MeshDiskCache::prune() const
+{
+    // temporary files that are younger than this might still be being written (e.g. by
+    // another process), so they're left alone
+    constexpr auto c_min_temporary_file_age = std::chrono::hours{1};
+
+    struct PrunableEntry final {
+        std::filesystem::path path;
+        std::filesystem::file_time_type last_used;
+        uint64_t size;
+    };
+
+    try {
+        if (not std::filesystem::exists(directory_)) {
+            return;
+        }
+
+        const auto now = std::filesystem::file_time_type::clock::now();
+        std::vector<PrunableEntry> entries;
+        uint64_t total_size = 0;
+        for (const std::filesystem::directory_entry& dir_entry : std::filesystem::directory_iterator{directory_}) {
+            std::error_code ec;
+            if (not dir_entry.is_regular_file(ec)) {
+                continue;
+            }
+            const std::filesystem::path& path = dir_entry.path();
+            const auto last_write_time = dir_entry.last_write_time(ec);
+            if (ec) {
+                continue;
+            }
+
+            if (is_temporary_file(path)) {
+                if (now - last_write_time > c_min_temporary_file_age) {
+                    std::filesystem::remove(path, ec);
+                }
+            }
+            else if (path.extension() == c_entry_extension) {
+                const uint64_t size = dir_entry.file_size(ec);
+                if (not ec) {
+                    entries.push_back({path, last_write_time, size});
+                    total_size += size;
+                }
+            }
+        }
+
+        // delete the least-recently-used entries first
+        rgs::sort(entries, rgs::less{}, &PrunableEntry::last_used);
+        for (const PrunableEntry& entry : entries) {
+            if (total_size <= max_size_in_bytes_) {
+                break;
+            }
+            std::error_code ec;
+            if (std::filesystem::remove(entry.path, ec)) {
+                total_size -= entry.size;
+            }
+            else if (ec) {
+                log_warn("%s: error deleting mesh cache entry: %s", entry.path.string().c_str(), ec.message().c_str());
+            }
+        }
+    }
+    catch (const std::exception& ex) {
+        log_warn("%s: error pruning mesh cache: %s", directory_.string().c_str(), ex.what());
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/BVH.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+namespace osc
+{
+    // a mesh, plus its triangle `BVH`, that was loaded from a `MeshDiskCache`
+    struct MeshDiskCacheEntry final {
+        Mesh mesh;
+        BVH bvh;
+    };
+
+    // a persistent, on-disk, cache of meshes that were loaded from source files (e.g. OBJ, STL,
+    // VTP), plus their triangle `BVH`s
+    //
+    // each entry is a file in a versioned binary format (`.oscmesh`, described in the
+    // implementation) that is memory-mapped back in, so that a mesh that was loaded by a
+    // previous run of the application can be reloaded without re-parsing its source file,
+    // or rebuilding its `BVH`
+    //
+    // entries are keyed by the source file's path, and are only used if the source file's
+    // size and last-modification time match the ones that were recorded when the entry was
+    // written (or, if only the modification time differs, if its contents hash to the same
+    // value, e.g. because the file was copied)
+    //
+    // the cache doesn't evict entries while it's being used. Instead, `prune` should be called
+    // (e.g. at startup) to delete the least-recently-used entries until the cache fits within
+    // its size cap
+    //
+    // all member functions are threadsafe. Entries are written to a temporary file that is
+    // then renamed, so that readers (incl. other processes) never see partially-written entries
+    class MeshDiskCache final {
+    public:
+        static constexpr uint64_t c_default_max_size_in_bytes = uint64_t{1} << 30;
+
+        explicit MeshDiskCache(
+            std::filesystem::path directory,
+            uint64_t max_size_in_bytes = c_default_max_size_in_bytes
+        );
+
+        // returns the directory that the cache's entries are written to
+        const std::filesystem::path& directory() const { return directory_; }
+
+        // returns the maximum total size of the cache's entries after it has been pruned
+        uint64_t max_size_in_bytes() const { return max_size_in_bytes_; }
+
+        // returns the cached mesh (+ `BVH`) of the given source file, or `std::nullopt` if
+        // there isn't a valid entry for it (e.g. because the source file has changed since
+        // the entry was written)
+        //
+        // doesn't throw: unreadable/corrupt entries are logged and treated as missing. Loading
+        // an entry marks it as recently-used (see `prune`)
+        std::optional<MeshDiskCacheEntry> try_load(const std::filesystem::path& source_path) const;
+
+        // writes an entry for the given source file (overwriting any existing entry), where
+        // `bvh` should be the triangle `BVH` of `mesh` (e.g. from `create_triangle_bvh`)
+        //
+        // doesn't throw: the cache is only an optimization, so failures are logged
+        void store(const std::filesystem::path& source_path, const Mesh& mesh, const BVH& bvh) const;
+
+        // deletes the least-recently-used entries until the total size of the remaining
+        // entries is no greater than `max_size_in_bytes()`, along with any temporary files
+        // that were left behind (e.g. because the application crashed while writing them)
+        //
+        // doesn't throw: failures are logged
+        void prune() const;
+
+    private:
+        std::filesystem::path directory_;
+        uint64_t max_size_in_bytes_;
+    };
+}
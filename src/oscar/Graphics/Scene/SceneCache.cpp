@@ -3,6 +3,8 @@
 #include <oscar/Graphics/Geometries.h>
 #include <oscar/Graphics/Materials/MeshBasicMaterial.h>
 #include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/Scene/MeshDiskCache.h>
+#include <oscar/Graphics/Scene/SceneCachePendingMeshes.h>
 #include <oscar/Graphics/Scene/SceneHelpers.h>
 #include <oscar/Graphics/Shader.h>
 #include <oscar/Maths/BVH.h>
@@ -12,12 +14,20 @@
 #include <oscar/Platform/ResourcePath.h>
 #include <oscar/Utils/HashHelpers.h>
 #include <oscar/Utils/SynchronizedValue.h>
+#include <oscar/Utils/ThreadPool.h>
 
 #include <ankerl/unordered_dense.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstddef>
+#include <exception>
+#include <filesystem>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -73,6 +83,143 @@ namespace
         size_t hash = hash_of(vertex_shader_path, geometry_shader_path, fragment_shader_path);
     };
 
+    // an entry in the mesh cache, which may not have been loaded yet
+    class MeshCacheEntry final {
+    public:
+        // returns the entry's mesh, loading it with `getter` on the calling thread if
+        // nothing has loaded it yet (blocks if another thread is currently loading it)
+        const Mesh& load(
+            const std::string& key,
+            const std::function<Mesh()>& getter,
+            const Mesh& fallback)
+        {
+            std::call_once(once_flag_, [&]()
+            {
+                try {
+                    mesh_ = getter();
+                }
+                catch (const std::exception& ex) {
+                    log_error("%s: error loading mesh (using a placeholder instead): %s", key.c_str(), ex.what());
+                    mesh_ = fallback;
+                }
+                is_loaded_.store(true, std::memory_order_release);
+            });
+            return mesh_;
+        }
+
+        // returns the entry's mesh if it's loaded, or `std::nullopt` otherwise (never blocks)
+        std::optional<Mesh> try_get() const
+        {
+            if (is_loaded_.load(std::memory_order_acquire)) {
+                return mesh_;
+            }
+            return std::nullopt;
+        }
+
+        // marks the entry as requiring a background load, returns `true` if it wasn't already marked
+        bool try_mark_as_async_requested()
+        {
+            return not is_async_requested_.exchange(true);
+        }
+
+        // marks the entry's background load (i.e. loading the mesh and building its `BVH`) as completed
+        void mark_as_async_completed()
+        {
+            is_async_completed_.store(true, std::memory_order_release);
+        }
+
+        // returns a flag that's set once the entry's background load has completed, which
+        // keeps the entry alive (so that it can outlive the cache's reference to the entry)
+        static std::shared_ptr<const std::atomic<bool>> async_completion_flag(const std::shared_ptr<MeshCacheEntry>& entry)
+        {
+            return {entry, &entry->is_async_completed_};
+        }
+
+    private:
+        std::once_flag once_flag_;
+        std::atomic<bool> is_loaded_ = false;
+        std::atomic<bool> is_async_requested_ = false;
+        std::atomic<bool> is_async_completed_ = false;
+        Mesh mesh_;
+    };
+
+    // an entry in the `BVH` cache, which may not have been built yet
+    class BVHCacheEntry final {
+    public:
+        BVHCacheEntry() = default;
+
+        // constructs an entry from an already-built `BVH` (e.g. from a `MeshDiskCache`)
+        explicit BVHCacheEntry(BVH bvh)
+        {
+            std::call_once(once_flag_, [this, &bvh]() { bvh_ = std::move(bvh); });
+        }
+
+        const BVH& get(const Mesh& mesh)
+        {
+            std::call_once(once_flag_, [this, &mesh]() { bvh_ = create_triangle_bvh(mesh); });
+            return bvh_;
+        }
+    private:
+        std::once_flag once_flag_;
+        BVH bvh_;
+    };
+
+    // runs a `SceneCache`'s background jobs on the global `ThreadPool`
+    //
+    // the jobs use the cache, so destroying this skips jobs that haven't started yet and waits
+    // for running ones to finish
+    class SceneCacheBackgroundJobs final {
+    public:
+        SceneCacheBackgroundJobs() = default;
+        SceneCacheBackgroundJobs(const SceneCacheBackgroundJobs&) = delete;
+        SceneCacheBackgroundJobs(SceneCacheBackgroundJobs&&) noexcept = delete;
+        SceneCacheBackgroundJobs& operator=(const SceneCacheBackgroundJobs&) = delete;
+        SceneCacheBackgroundJobs& operator=(SceneCacheBackgroundJobs&&) noexcept = delete;
+        ~SceneCacheBackgroundJobs() noexcept
+        {
+            std::unique_lock lock{state_->mutex};
+            state_->cancelled = true;
+            state_->condition_variable.wait(lock, [this]() { return state_->num_running == 0; });
+        }
+
+        void submit(std::function<void()> job)
+        {
+            ThreadPool::global().submit([state = state_, job = std::move(job)]()
+            {
+                {
+                    const std::lock_guard lock{state->mutex};
+                    if (state->cancelled) {
+                        return;
+                    }
+                    ++state->num_running;
+                }
+
+                try {
+                    job();
+                }
+                catch (...) {
+                    // (jobs log their own errors: this only ensures that the job is marked as finished)
+                }
+
+                {
+                    const std::lock_guard lock{state->mutex};
+                    --state->num_running;
+                }
+                state->condition_variable.notify_all();
+            });
+        }
+
+    private:
+        // shared with the submitted jobs, because they can outlive this
+        struct State final {
+            std::mutex mutex;
+            std::condition_variable condition_variable;
+            size_t num_running = 0;
+            bool cancelled = false;
+        };
+        std::shared_ptr<State> state_ = std::make_shared<State>();
+    };
+
     Mesh generate_y_to_y_line_mesh()
     {
         Mesh rv;
@@ -122,14 +269,74 @@ public:
         const std::string& key,
         const std::function<Mesh()>& getter)
     {
-        auto guard = mesh_cache.lock();
+        // the getter is called outside of the cache's lock, so that loading one mesh doesn't
+        // block other threads from using (or loading) other meshes
+        return lookup_or_insert_mesh_entry(key)->load(key, getter, cube);
+    }
 
-        auto [it, inserted] = guard->try_emplace(key, cube);
-        if (inserted) {
-            it->second = getter();
+    Mesh get_mesh_async(
+        const std::string& key,
+        std::function<Mesh()> getter,
+        SceneCachePendingMeshes* pending)
+    {
+        std::shared_ptr<MeshCacheEntry> entry = lookup_or_insert_mesh_entry(key);
+        if (std::optional<Mesh> mesh = entry->try_get()) {
+            return *std::move(mesh);
         }
 
-        return it->second;
+        if (pending) {
+            pending->add(MeshCacheEntry::async_completion_flag(entry));
+        }
+
+        if (entry->try_mark_as_async_requested()) {
+            // note: the entry might already be being loaded synchronously by another thread,
+            // in which case the job waits for that load, so that progress is still reported
+            ++num_async_requested_;
+            background_jobs_.submit([this, key, entry, getter = std::move(getter)]()
+            {
+                const Mesh& mesh = entry->load(key, getter, cube);
+                try {
+                    get_bvh(mesh);  // so that (e.g.) hit-testing the mesh doesn't stall the caller
+                }
+                catch (const std::exception& ex) {
+                    log_error("%s: error building BVH: %s", key.c_str(), ex.what());
+                }
+                entry->mark_as_async_completed();
+                ++num_async_completed_;
+            });
+        }
+        return async_placeholder_;
+    }
+
+    void set_mesh_disk_cache(std::shared_ptr<MeshDiskCache> mesh_disk_cache)
+    {
+        auto guard = mesh_disk_cache_.lock();
+        *guard = std::move(mesh_disk_cache);
+    }
+
+    Mesh get_mesh_file(
+        const std::filesystem::path& path,
+        std::function<Mesh(const std::filesystem::path&)> loader)
+    {
+        return get_mesh(path.string(), make_mesh_file_getter(path, std::move(loader)));
+    }
+
+    Mesh get_mesh_file_async(
+        const std::filesystem::path& path,
+        std::function<Mesh(const std::filesystem::path&)> loader,
+        SceneCachePendingMeshes* pending)
+    {
+        return get_mesh_async(path.string(), make_mesh_file_getter(path, std::move(loader)), pending);
+    }
+
+    SceneCacheLoadingProgress async_loading_progress() const
+    {
+        // read `completed` first, so that it's never observed to be ahead of `requested`
+        const size_t num_completed = num_async_completed_.load();
+        return SceneCacheLoadingProgress{
+            .num_requested = num_async_requested_.load(),
+            .num_completed = num_completed,
+        };
     }
 
     Mesh sphere_mesh() { return sphere; }
@@ -164,12 +371,16 @@ public:
 
     const BVH& get_bvh(const Mesh& mesh)
     {
-        auto guard = bvh_cache.lock();
-        auto [it, inserted] = guard->try_emplace(mesh, nullptr);
-        if (inserted) {
-            it->second = std::make_unique<BVH>(create_triangle_bvh(mesh));
+        std::shared_ptr<BVHCacheEntry> entry;
+        {
+            auto guard = bvh_cache.lock();
+            auto [it, inserted] = guard->try_emplace(mesh, nullptr);
+            if (inserted) {
+                it->second = std::make_shared<BVHCacheEntry>();
+            }
+            entry = it->second;
         }
-        return *it->second;
+        return entry->get(mesh);  // built outside of the cache's lock
     }
 
     const Shader& load(
@@ -226,6 +437,53 @@ public:
     }
 
 private:
+    // returns a mesh getter that tries the on-disk cache before calling `loader` (the getter
+    // may run on a background worker, which is why it reads the disk cache when it's called)
+    // and, on a miss, writes the loaded mesh to the on-disk cache on a background worker
+    std::function<Mesh()> make_mesh_file_getter(
+        std::filesystem::path path,
+        std::function<Mesh(const std::filesystem::path&)> loader)
+    {
+        return [this, path = std::move(path), loader = std::move(loader)]()
+        {
+            const std::shared_ptr<MeshDiskCache> disk_cache = *mesh_disk_cache_.lock();
+            if (not disk_cache) {
+                return loader(path);
+            }
+
+            if (std::optional<MeshDiskCacheEntry> entry = disk_cache->try_load(path)) {
+                bvh_cache.lock()->try_emplace(entry->mesh, std::make_shared<BVHCacheEntry>(std::move(entry->bvh)));
+                return entry->mesh;
+            }
+
+            Mesh mesh = loader(path);
+
+            // hashing the source file, building the `BVH`, and writing the entry are slow, and
+            // the getter might be running on the UI thread, so the entry is written in the
+            // background (it's skipped if the cache is destroyed before the job runs)
+            background_jobs_.submit([this, disk_cache, path, mesh]()
+            {
+                try {
+                    disk_cache->store(path, mesh, get_bvh(mesh));
+                }
+                catch (const std::exception& ex) {
+                    log_error("%s: error writing mesh disk cache entry: %s", path.string().c_str(), ex.what());
+                }
+            });
+            return mesh;
+        };
+    }
+
+    std::shared_ptr<MeshCacheEntry> lookup_or_insert_mesh_entry(const std::string& key)
+    {
+        auto guard = mesh_cache.lock();
+        auto [it, inserted] = guard->try_emplace(key, nullptr);
+        if (inserted) {
+            it->second = std::make_shared<MeshCacheEntry>();
+        }
+        return it->second;
+    }
+
     Mesh sphere = SphereGeometry{{.num_width_segments = 16, .num_height_segments = 16}};
     Mesh circle = CircleGeometry{{.radius = 1.0f, .num_segments = 16}};
     Mesh cylinder = CylinderGeometry{{.height = 2.0f, .num_radial_segments = 16}};
@@ -239,14 +497,21 @@ private:
     Mesh textured_quad = floor;
 
     SynchronizedValue<ankerl::unordered_dense::map<TorusParameters, Mesh>> torus_cache;
-    SynchronizedValue<ankerl::unordered_dense::map<std::string, Mesh>> mesh_cache;
-    SynchronizedValue<ankerl::unordered_dense::map<Mesh, std::unique_ptr<BVH>>> bvh_cache;
+    SynchronizedValue<ankerl::unordered_dense::map<std::string, std::shared_ptr<MeshCacheEntry>>> mesh_cache;
+    SynchronizedValue<ankerl::unordered_dense::map<Mesh, std::shared_ptr<BVHCacheEntry>>> bvh_cache;
+    Mesh async_placeholder_;
+    SynchronizedValue<std::shared_ptr<MeshDiskCache>> mesh_disk_cache_;
+    std::atomic<size_t> num_async_requested_ = 0;
+    std::atomic<size_t> num_async_completed_ = 0;
 
     // shader stuff
     ResourceLoader resource_loader_;
     SynchronizedValue<ankerl::unordered_dense::map<ShaderLookupKey, Shader>> shader_cache_;
     std::optional<MeshBasicMaterial> basic_material_;
     std::optional<MeshBasicMaterial> wireframe_material_;
+
+    // declared last, so that running jobs finish before anything they use is destroyed
+    SceneCacheBackgroundJobs background_jobs_;
 };
 
 osc::SceneCache::SceneCache() :
@@ -271,6 +536,53 @@ Mesh osc::SceneCache::get_mesh(
     return impl_->get_mesh(key, getter);
 }
 
+Mesh osc::SceneCache::get_mesh_async(
+    const std::string& key,
+    std::function<Mesh()> getter)
+{
+    return impl_->get_mesh_async(key, std::move(getter), nullptr);
+}
+
+Mesh osc::SceneCache::get_mesh_async(
+    const std::string& key,
+    std::function<Mesh()> getter,
+    SceneCachePendingMeshes& pending)
+{
+    return impl_->get_mesh_async(key, std::move(getter), &pending);
+}
+
+SceneCacheLoadingProgress osc::SceneCache::async_loading_progress() const
+{
+    return impl_->async_loading_progress();
+}
+
+void osc::SceneCache::set_mesh_disk_cache(std::shared_ptr<MeshDiskCache> mesh_disk_cache)
+{
+    impl_->set_mesh_disk_cache(std::move(mesh_disk_cache));
+}
+
+Mesh osc::SceneCache::get_mesh_file(
+    const std::filesystem::path& path,
+    std::function<Mesh(const std::filesystem::path&)> loader)
+{
+    return impl_->get_mesh_file(path, std::move(loader));
+}
+
+Mesh osc::SceneCache::get_mesh_file_async(
+    const std::filesystem::path& path,
+    std::function<Mesh(const std::filesystem::path&)> loader)
+{
+    return impl_->get_mesh_file_async(path, std::move(loader), nullptr);
+}
+
+Mesh osc::SceneCache::get_mesh_file_async(
+    const std::filesystem::path& path,
+    std::function<Mesh(const std::filesystem::path&)> loader,
+    SceneCachePendingMeshes& pending)
+{
+    return impl_->get_mesh_file_async(path, std::move(loader), &pending);
+}
+
 Mesh osc::SceneCache::sphere_mesh() { return impl_->sphere_mesh(); }
 Mesh osc::SceneCache::circle_mesh() { return impl_->circle_mesh(); }
 Mesh osc::SceneCache::cylinder_mesh() { return impl_->cylinder_mesh(); }
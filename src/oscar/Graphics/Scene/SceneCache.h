@@ -1,15 +1,19 @@
 #pragma once
 
 #include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/Scene/SceneCacheLoadingProgress.h>
 #include <oscar/Platform/ResourcePath.h>
 
+#include <filesystem>
 #include <functional>
 #include <memory>
 #include <string>
 
 namespace osc { class BVH; }
 namespace osc { class MeshBasicMaterial; }
+namespace osc { class MeshDiskCache; }
 namespace osc { class ResourceLoader; }
+namespace osc { class SceneCachePendingMeshes; }
 namespace osc { class Shader; }
 
 namespace osc
@@ -39,8 +43,59 @@ namespace osc
         void clear_meshes();
 
         // always returns (it will use a dummy cube and print a log error if something fails)
+        //
+        // `getter` is called at most once per key: concurrent callers that request the same
+        // key block until the first caller (or a background worker) has loaded the mesh
         Mesh get_mesh(const std::string& key, const std::function<Mesh()>& getter);
 
+        // returns the mesh associated with `key`, if it's already loaded; otherwise, schedules
+        // `getter` to be called on a background worker (at most once per key) and returns an
+        // empty placeholder mesh
+        //
+        // once the mesh has loaded (and its `BVH` has been built in the background), subsequent
+        // calls return it. Callers can use `async_loading_progress` to detect when to call this
+        // again (e.g. to regenerate a scene with the real meshes swapped in)
+        Mesh get_mesh_async(const std::string& key, std::function<Mesh()> getter);
+
+        // as above, but also adds the mesh to `pending` if a placeholder is returned, so that
+        // the caller can detect when *its* meshes have loaded (see `SceneCachePendingMeshes`)
+        Mesh get_mesh_async(
+            const std::string& key,
+            std::function<Mesh()> getter,
+            SceneCachePendingMeshes& pending
+        );
+
+        // returns the progress of the meshes that were requested via `get_mesh_async`
+        SceneCacheLoadingProgress async_loading_progress() const;
+
+        // sets (or, if `nullptr`, unsets) a persistent on-disk cache that `get_mesh_file` and
+        // `get_mesh_file_async` use to skip parsing mesh files (and building their `BVH`s)
+        // that were already loaded by a previous run of the application
+        void set_mesh_disk_cache(std::shared_ptr<MeshDiskCache>);
+
+        // equivalent to `get_mesh(path, ...)`, but loads the mesh (+ its `BVH`) from the
+        // on-disk cache if possible, and otherwise uses `loader` to load the mesh and then
+        // writes it (+ its `BVH`) to the on-disk cache
+        Mesh get_mesh_file(
+            const std::filesystem::path&,
+            std::function<Mesh(const std::filesystem::path&)> loader
+        );
+
+        // equivalent to `get_mesh_async(path, ...)`, but with the on-disk caching behavior
+        // of `get_mesh_file`
+        Mesh get_mesh_file_async(
+            const std::filesystem::path&,
+            std::function<Mesh(const std::filesystem::path&)> loader
+        );
+
+        // equivalent to `get_mesh_async(path, ..., pending)`, but with the on-disk caching
+        // behavior of `get_mesh_file`
+        Mesh get_mesh_file_async(
+            const std::filesystem::path&,
+            std::function<Mesh(const std::filesystem::path&)> loader,
+            SceneCachePendingMeshes& pending
+        );
+
         Mesh sphere_mesh();
         Mesh circle_mesh();
         Mesh cylinder_mesh();
@@ -54,6 +109,8 @@ namespace osc
         Mesh quad_mesh();
         Mesh torus_mesh(float tube_center_radius, float tube_radius);
 
+        // returns a triangle `BVH` of the given mesh (concurrent callers that request the same
+        // mesh block until the first caller has built it)
         const BVH& get_bvh(const Mesh&);
 
         // returns a `Shader` loaded via the `ResourceLoader` that was provided to the constructor
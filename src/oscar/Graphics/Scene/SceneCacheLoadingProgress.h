@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+namespace osc
+{
+    // describes how far a `SceneCache` is through loading the meshes that were
+    // requested asynchronously (e.g. so that a UI can show a progress indicator, or
+    // regenerate a scene whenever a requested mesh finishes loading)
+    struct SceneCacheLoadingProgress final {
+
+        // returns `true` if some of the requested meshes haven't finished loading yet
+        bool is_loading() const { return num_completed < num_requested; }
+
+        friend bool operator==(const SceneCacheLoadingProgress&, const SceneCacheLoadingProgress&) = default;
+
+        size_t num_requested = 0;
+        size_t num_completed = 0;
+    };
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <oscar/Utils/SynchronizedValue.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace osc { class SceneCache; }
+
+namespace osc
+{
+    // the meshes that one requester (e.g. one renderer's scene) was given placeholders for by
+    // `SceneCache::get_mesh_async`, because they hadn't loaded yet
+    //
+    // unlike `SceneCache::async_loading_progress`, which covers every asynchronous request that
+    // was made via the cache, this only covers the requester's meshes, so that (e.g.) a renderer
+    // only regenerates its scene when one of *its* meshes has loaded. Meshes may be added to it
+    // concurrently (e.g. by decoration generators that run in parallel)
+    class SceneCachePendingMeshes final {
+    public:
+        // returns `true` if there are no pending meshes
+        bool empty() const
+        {
+            return pending_.lock()->empty();
+        }
+
+        // returns the number of pending meshes
+        size_t size() const
+        {
+            return pending_.lock()->size();
+        }
+
+        // returns `true` if any of the pending meshes have finished loading (incl. their `BVH`s)
+        bool any_loaded() const
+        {
+            const auto pending = pending_.lock();
+            return std::ranges::any_of(*pending, [](const auto& is_loaded) { return is_loaded->load(std::memory_order_acquire); });
+        }
+
+        // forgets all pending meshes (e.g. before regenerating a scene, which re-requests them)
+        void clear()
+        {
+            pending_.lock()->clear();
+        }
+
+    private:
+        friend class SceneCache;
+
+        void add(std::shared_ptr<const std::atomic<bool>> is_loaded)
+        {
+            pending_.lock()->push_back(std::move(is_loaded));
+        }
+
+        SynchronizedValue<std::vector<std::shared_ptr<const std::atomic<bool>>>> pending_;
+    };
+}
@@ -8,10 +8,15 @@
 #include <oscar/Graphics/Scene/SceneDecorationShading.h>
 #include <oscar/Maths/Transform.h>
 #include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/HashHelpers.h>
 #include <oscar/Utils/StringName.h>
 
+#include <cstddef>
+#include <functional>
 #include <optional>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <variant>
 
 namespace osc
@@ -58,3 +63,32 @@ namespace osc
         SceneDecorationFlags flags = SceneDecorationFlag::Default;
     };
 }
+
+// hashes a `SceneDecoration` (consistent with `operator==`)
+template<>
+struct std::hash<osc::SceneDecoration> final {
+    size_t operator()(const osc::SceneDecoration& decoration) const
+    {
+        const osc::Transform& t = decoration.transform;
+        const size_t transform_hash = osc::hash_of(t.scale, t.rotation.w, t.rotation.x, t.rotation.y, t.rotation.z, t.position);
+        const size_t shading_hash = std::visit([](const auto& shading)
+        {
+            using T = std::remove_cvref_t<decltype(shading)>;
+            if constexpr (std::is_same_v<T, std::pair<osc::Material, osc::MaterialPropertyBlock>>) {
+                return osc::hash_of(shading.first, shading.second);
+            }
+            else {
+                return osc::hash_of(shading);
+            }
+        }, decoration.shading);
+
+        return osc::hash_of(
+            decoration.mesh,
+            transform_hash,
+            decoration.shading.index(),
+            shading_hash,
+            decoration.id,
+            decoration.flags.underlying_value()
+        );
+    }
+};
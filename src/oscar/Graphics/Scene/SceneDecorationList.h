@@ -0,0 +1,71 @@
+#pragma once
+
+#include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Utils/HashHelpers.h>
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace osc
+{
+    // an append-only list of `SceneDecoration`s that hashes each decoration as it's added
+    //
+    // the list also maintains a rolling hash of all of its decorations, so that downstream
+    // caches (e.g. `CachedSceneRenderer`) can detect an unchanged list in O(1) and, if it has
+    // changed, can find which decorations changed without having to deep-compare them
+    class SceneDecorationList final {
+    public:
+        using value_type = SceneDecoration;
+        using size_type = size_t;
+        using const_reference = const SceneDecoration&;
+        using const_iterator = std::vector<SceneDecoration>::const_iterator;
+
+        size_t size() const { return decorations_.size(); }
+        [[nodiscard]] bool empty() const { return decorations_.empty(); }
+        const_iterator begin() const { return decorations_.begin(); }
+        const_iterator end() const { return decorations_.end(); }
+        const SceneDecoration& operator[](size_t pos) const { return decorations_[pos]; }
+
+        operator std::span<const SceneDecoration> () const { return decorations_; }
+
+        // returns the hash of each decoration (ordered the same as the decorations)
+        std::span<const size_t> decoration_hashes() const { return decoration_hashes_; }
+
+        // returns a rolling hash of all decorations in the list (order-dependent)
+        size_t hash() const { return hash_; }
+
+        void reserve(size_t n)
+        {
+            decorations_.reserve(n);
+            decoration_hashes_.reserve(n);
+        }
+
+        void clear()
+        {
+            decorations_.clear();
+            decoration_hashes_.clear();
+            hash_ = 0;
+        }
+
+        void push_back(SceneDecoration&& decoration)
+        {
+            const size_t decoration_hash = std::hash<SceneDecoration>{}(decoration);
+            decorations_.push_back(std::move(decoration));
+            decoration_hashes_.push_back(decoration_hash);
+            hash_ = hash_combine(hash_, decoration_hash);
+        }
+
+        void push_back(const SceneDecoration& decoration)
+        {
+            push_back(SceneDecoration{decoration});
+        }
+
+    private:
+        std::vector<SceneDecoration> decorations_;
+        std::vector<size_t> decoration_hashes_;
+        size_t hash_ = 0;
+    };
+}
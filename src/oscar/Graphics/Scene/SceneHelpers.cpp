@@ -294,6 +294,40 @@ std::optional<RayCollision> osc::get_closest_worldspace_ray_triangle_collision(
     return rv;
 }
 
+std::vector<std::optional<RayCollision>> osc::get_closest_worldspace_ray_triangle_collisions(
+    const Mesh& mesh,
+    const BVH& triangle_bvh,
+    const Transform& transform,
+    std::span<const Line> worldspace_rays)
+{
+    std::vector<std::optional<RayCollision>> rv(worldspace_rays.size());
+    if (mesh.topology() != MeshTopology::Triangles) {
+        return rv;
+    }
+
+    // map the rays into the mesh's modelspace, so that they can be tested against the triangle BVH
+    std::vector<Line> modelspace_rays;
+    modelspace_rays.reserve(worldspace_rays.size());
+    for (const Line& worldspace_ray : worldspace_rays) {
+        modelspace_rays.push_back(inverse_transform_line(worldspace_ray, transform));
+    }
+
+    const std::vector<Vec3> vertices = mesh.vertices();
+    const MeshIndicesView indices = mesh.indices();
+    const std::vector<std::optional<BVHCollision>> modelspace_collisions = indices.is_uint32() ?
+        triangle_bvh.closest_ray_indexed_triangle_collisions(vertices, indices.to_uint32_span(), modelspace_rays) :
+        triangle_bvh.closest_ray_indexed_triangle_collisions(vertices, indices.to_uint16_span(), modelspace_rays);
+
+    // map the collisions back into worldspace
+    for (size_t i = 0; i < modelspace_collisions.size(); ++i) {
+        if (modelspace_collisions[i]) {
+            const Vec3 worldspace_location = transform * modelspace_collisions[i]->position;
+            rv[i] = RayCollision{length(worldspace_location - worldspace_rays[i].origin), worldspace_location};
+        }
+    }
+    return rv;
+}
+
 std::optional<RayCollision> osc::get_closest_worldspace_ray_triangle_collision(
     const PolarPerspectiveCamera& camera,
     const Mesh& mesh,
@@ -17,6 +17,7 @@
 #include <functional>
 #include <optional>
 #include <span>
+#include <vector>
 
 namespace osc { struct AABB; }
 namespace osc { class BVH; }
@@ -122,6 +123,17 @@ namespace osc
         const Line& worldspace_ray
     );
 
+    // returns the closest ray-triangle collision along each of `worldspace_rays`
+    //
+    // equivalent to calling `get_closest_worldspace_ray_triangle_collision` with each ray, but
+    // faster for large batches of rays (e.g. when projecting many points onto a mesh)
+    std::vector<std::optional<RayCollision>> get_closest_worldspace_ray_triangle_collisions(
+        const Mesh&,
+        const BVH& triangle_bvh,
+        const Transform&,
+        std::span<const Line> worldspace_rays
+    );
+
     // returns closest ray-triangle collision in worldspace for a given mouse position
     // within the given render rectangle
     std::optional<RayCollision> get_closest_worldspace_ray_triangle_collision(
@@ -19,32 +19,48 @@
 #include <oscar/Graphics/Scene/SceneDecoration.h>
 #include <oscar/Graphics/Scene/SceneDecorationFlags.h>
 #include <oscar/Graphics/Scene/SceneRendererParams.h>
+#include <oscar/Maths/AnalyticPlane.h>
 #include <oscar/Maths/Angle.h>
+#include <oscar/Maths/BVH.h>
+#include <oscar/Maths/CollisionTests.h>
+#include <oscar/Maths/FrustumPlanes.h>
 #include <oscar/Maths/Mat4.h>
 #include <oscar/Maths/MatFunctions.h>
 #include <oscar/Maths/MathHelpers.h>
+#include <oscar/Maths/PlaneFunctions.h>
 #include <oscar/Maths/PolarPerspectiveCamera.h>
 #include <oscar/Maths/QuaternionFunctions.h>
 #include <oscar/Maths/Rect.h>
 #include <oscar/Maths/Transform.h>
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Maths/Vec3.h>
+#include <oscar/Maths/VecFunctions.h>
 #include <oscar/Platform/ResourcePath.h>
 #include <oscar/Utils/Perf.h>
 #include <oscar/Utils/StdVariantHelpers.h>
 
 #include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <memory>
 #include <span>
+#include <tuple>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 using namespace osc::literals;
 using namespace osc;
+namespace rgs = std::ranges;
 
 namespace
 {
     const StringName c_diffuse_color_propname{"uDiffuseColor"};
 
+    // the main scene shader reads each decoration's color per-instance (so that decorations that
+    // only differ by color can be drawn with one instanced draw call)
+    const StringName c_instanced_diffuse_color_propname{"aDiffuseColor"};
+
     Transform calc_floor_transform(Vec3 floor_origin, float fixup_scale_factor)
     {
         return {
@@ -71,6 +87,19 @@ namespace
         Material material;
     };
 
+    // a rim-highlighted `SceneDecoration`, plus the information used to group it into batches
+    struct RimDrawable final {
+        Color color;
+        size_t mesh_hash;
+        const SceneDecoration* decoration;
+    };
+
+    // per-decoration visibility flags, computed once per render and then used by each pass
+    struct DecorationVisibility final {
+        bool is_in_view_frustum = false;
+        bool may_cast_visible_shadow = false;
+    };
+
     struct Shadows final {
         SharedDepthStencilRenderBuffer shadow_map;
         Mat4 lightspace_mat;
@@ -208,8 +237,12 @@ public:
 
     void render(
         std::span<const SceneDecoration> decorations,
-        const SceneRendererParams& params)
+        const SceneRendererParams& params,
+        const BVH* decorations_bvh)
     {
+        // figure out which decorations can actually affect the output
+        calc_decoration_visibility(decorations, params, decorations_bvh);
+
         // render any other perspectives on the scene (shadows, rim highlights, etc.)
         const std::optional<RimHighlights> maybe_rims = try_generate_rims(decorations, params);
         const std::optional<Shadows> maybe_shadowmap = try_generate_shadowmap(decorations, params);
@@ -250,17 +283,21 @@ public:
             MaterialPropertyBlock prop_block;
             MaterialPropertyBlock wireframe_prop_block;
             Color previous_color = {-1.0f, -1.0f, -1.0f, 0.0f};
-            for (const SceneDecoration& dec : decorations) {
+            for (size_t i = 0; i < decorations.size(); ++i) {
+                const SceneDecoration& dec = decorations[i];
                 if (dec.flags & SceneDecorationFlag::NoDrawInScene) {
                     continue;  // skip this
                 }
+                if (not decoration_visibility_[i].is_in_view_frustum) {
+                    continue;  // it's off-screen
+                }
 
                 Color color_guess = Color::white();
                 std::visit(Overload{
                     [this, &transparent_material, &dec, &previous_color, &prop_block, &color_guess](const Color& color)
                     {
                         if (color != previous_color) {
-                            prop_block.set(c_diffuse_color_propname, color);
+                            prop_block.set(c_instanced_diffuse_color_propname, color);
                             previous_color = color;
                         }
 
@@ -347,6 +384,65 @@ public:
     }
 
 private:
+    // populates `decoration_visibility_` with one entry per decoration
+    //
+    // if provided, `decorations_bvh` must have been built from the worldspace bounds of (a prefix
+    // of) `decorations`, with IDs that are indices into `decorations` (e.g. via `update_scene_bvh`).
+    // Decorations that aren't in the BVH are tested individually
+    void calc_decoration_visibility(
+        std::span<const SceneDecoration> decorations,
+        const SceneRendererParams& params,
+        const BVH* decorations_bvh)
+    {
+        OSC_PERF("SceneRenderer/calc_decoration_visibility");
+
+        // the view frustum is extracted from the caller's matrices, rather than from the camera,
+        // because the caller is free to provide any (e.g. orthographic) projection matrix
+        const FrustumPlanes view_frustum = extract_frustum_planes(params.projection_matrix * params.view_matrix);
+
+        // a shadow caster can only cast a shadow into the view frustum if its bounds, when swept
+        // along the light direction, intersect the frustum. The sweep can only move the bounds
+        // out from in front of a frustum plane if the light travels towards the back of that
+        // plane, so only the planes that face along the light direction can reject a caster
+        shadow_volume_planes_.clear();
+        for (const AnalyticPlane& plane : view_frustum) {
+            if (dot(params.light_direction, plane.normal) >= 0.0f) {
+                shadow_volume_planes_.push_back(plane);
+            }
+        }
+
+        decoration_visibility_.assign(decorations.size(), DecorationVisibility{});
+
+        size_t num_tested_via_bvh = 0;
+        if (decorations_bvh) {
+            const auto num_decorations = static_cast<ptrdiff_t>(decorations.size());
+            decorations_bvh->for_each_aabb_in_convex_volume(view_frustum, [this, num_decorations](ptrdiff_t id)
+            {
+                if (id < num_decorations) {
+                    decoration_visibility_[id].is_in_view_frustum = true;
+                }
+            });
+            if (params.draw_shadows) {
+                decorations_bvh->for_each_aabb_in_convex_volume(shadow_volume_planes_, [this, num_decorations](ptrdiff_t id)
+                {
+                    if (id < num_decorations) {
+                        decoration_visibility_[id].may_cast_visible_shadow = true;
+                    }
+                });
+            }
+            num_tested_via_bvh = std::min(decorations_bvh->num_prims(), decorations.size());
+        }
+
+        for (size_t i = num_tested_via_bvh; i < decorations.size(); ++i) {
+            const AABB aabb = worldspace_bounds_of(decorations[i]);
+            decoration_visibility_[i].is_in_view_frustum = is_intersecting(view_frustum, aabb);
+            decoration_visibility_[i].may_cast_visible_shadow = rgs::none_of(shadow_volume_planes_, [&aabb](const AnalyticPlane& plane)
+            {
+                return is_in_front_of(plane, aabb);
+            });
+        }
+    }
+
     std::optional<RimHighlights> try_generate_rims(
         std::span<const SceneDecoration> decorations,
         const SceneRendererParams& params)
@@ -355,16 +451,13 @@ private:
             return std::nullopt;
         }
 
-        // compute the worldspace bounds union of all rim-highlighted geometry
-        const auto rim_aabb_of = [](const SceneDecoration& decoration) -> std::optional<AABB>
-        {
-            if (decoration.is_rim_highlighted()) {
-                return worldspace_bounds_of(decoration);
+        // compute the worldspace bounds union of all on-screen rim-highlighted geometry
+        std::optional<AABB> maybe_rim_worldspace_aabb;
+        for (size_t i = 0; i < decorations.size(); ++i) {
+            if (decorations[i].is_rim_highlighted() and decoration_visibility_[i].is_in_view_frustum) {
+                maybe_rim_worldspace_aabb = bounding_aabb_of(maybe_rim_worldspace_aabb, worldspace_bounds_of(decorations[i]));
             }
-            return std::nullopt;
-        };
-
-        const std::optional<AABB> maybe_rim_worldspace_aabb = maybe_bounding_aabb_of(decorations, rim_aabb_of);
+        }
         if (not maybe_rim_worldspace_aabb) {
             return std::nullopt;  // the scene does not contain any rim-highlighted geometry
         }
@@ -417,13 +510,20 @@ private:
         camera_.set_projection_matrix_override(params.projection_matrix);
         camera_.set_background_color(Color::clear());
 
-        // draw all selected geometry in a solid color
-        std::unordered_map<Color, MeshBasicMaterial::PropertyBlock> block_cache;
-        block_cache.reserve(3);  // guess
-        for (const SceneDecoration& decoration : decorations) {
-            Color color = Color::black();
+        // gather all rim-highlighted geometry, grouped by rim color and mesh
+        //
+        // the rim filler material isn't depth-tested, so the backend won't reorder it into
+        // instanced batches. It's safe to reorder it here, though, because it's blended with
+        // `BlendingEquation::Max`, which doesn't depend on draw order
+        rim_drawables_.clear();
+        for (size_t i = 0; i < decorations.size(); ++i) {
+            const SceneDecoration& decoration = decorations[i];
+            if (not decoration_visibility_[i].is_in_view_frustum) {
+                continue;  // it's off-screen, so it can't contribute a rim
+            }
 
             static_assert(SceneRendererParams::num_rim_groups() == 2);
+            Color color = Color::black();
             if (decoration.flags & SceneDecorationFlag::RimHighlight0) {
                 color.r = 1.0f;
             }
@@ -432,10 +532,21 @@ private:
             }
 
             if (color != Color::black()) {
-                const auto& prop_block = block_cache.try_emplace(color, color).first->second;
-                graphics::draw(decoration.mesh, decoration.transform, rim_filler_material_, camera_, prop_block);
+                rim_drawables_.push_back({color, std::hash<Mesh>{}(decoration.mesh), &decoration});
             }
         }
+        rgs::sort(rim_drawables_, [](const RimDrawable& a, const RimDrawable& b)
+        {
+            return std::tie(a.color.r, a.color.g, a.mesh_hash) < std::tie(b.color.r, b.color.g, b.mesh_hash);
+        });
+
+        // draw all selected geometry in a solid color
+        std::unordered_map<Color, MeshBasicMaterial::PropertyBlock> block_cache;
+        block_cache.reserve(3);  // guess
+        for (const RimDrawable& drawable : rim_drawables_) {
+            const auto& prop_block = block_cache.try_emplace(drawable.color, drawable.color).first->second;
+            graphics::draw(drawable.decoration->mesh, drawable.decoration->transform, rim_filler_material_, camera_, prop_block);
+        }
 
         // configure the off-screen solid-colored texture
         rims_rendertexture_.reformat({
@@ -481,14 +592,21 @@ private:
         // setup scene camera
         camera_.reset();
 
-        // compute the bounds of everything that casts a shadow
+        // compute the bounds of everything that casts a shadow that might be visible
         //
         // (also, while doing that, draw each mesh - to prevent multipass)
+        //
+        // fitting the shadow camera to only the retained casters means that culled casters
+        // don't dilute the resolution of the shadow map
         std::optional<AABB> shadowcaster_aabbs;
-        for (const SceneDecoration& decoration : decorations) {
+        for (size_t i = 0; i < decorations.size(); ++i) {
+            const SceneDecoration& decoration = decorations[i];
             if (decoration.flags & SceneDecorationFlag::NoCastsShadows) {
                 continue;  // this decoration shouldn't cast shadows
             }
+            if (not decoration_visibility_[i].may_cast_visible_shadow) {
+                continue;  // its shadow can't fall within the view frustum
+            }
             shadowcaster_aabbs = bounding_aabb_of(shadowcaster_aabbs, worldspace_bounds_of(decoration));
             graphics::draw(decoration.mesh, decoration.transform, depth_writer_material_, camera_);
         }
@@ -523,6 +641,9 @@ private:
 
     Mesh quad_mesh_;
     Camera camera_;
+    std::vector<DecorationVisibility> decoration_visibility_;
+    std::vector<AnalyticPlane> shadow_volume_planes_;
+    std::vector<RimDrawable> rim_drawables_;
     RenderTexture rims_rendertexture_;
     SharedDepthStencilRenderBuffer shadowmap_render_buffer_{{
         .dimensions = {1024, 1024},
@@ -545,7 +666,15 @@ void osc::SceneRenderer::render(
     std::span<const SceneDecoration> decorations,
     const SceneRendererParams& params)
 {
-    impl_->render(decorations, params);
+    impl_->render(decorations, params, nullptr);
+}
+
+void osc::SceneRenderer::render(
+    std::span<const SceneDecoration> decorations,
+    const SceneRendererParams& params,
+    const BVH& decorations_bvh)
+{
+    impl_->render(decorations, params, &decorations_bvh);
 }
 
 RenderTexture& osc::SceneRenderer::upd_render_texture()
@@ -6,6 +6,7 @@
 #include <memory>
 #include <span>
 
+namespace osc { class BVH; }
 namespace osc { struct SceneDecoration; }
 namespace osc { class SceneCache; }
 namespace osc { struct SceneRendererParams; }
@@ -25,6 +26,12 @@ namespace osc
         ~SceneRenderer() noexcept;
 
         void render(std::span<const SceneDecoration>, const SceneRendererParams&);
+
+        // as above, but uses `decorations_bvh` to accelerate culling off-screen decorations
+        //
+        // `decorations_bvh` must have been built from the worldspace bounds of (a prefix of) the
+        // decorations, with IDs that are indices into the decorations (e.g. via `update_scene_bvh`)
+        void render(std::span<const SceneDecoration>, const SceneRendererParams&, const BVH& decorations_bvh);
         RenderTexture& upd_render_texture();
 
     private:
@@ -30,6 +30,7 @@
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/Mat3.h>
 #include <oscar/Maths/Mat4.h>
+#include <oscar/Maths/MinMaxPyramid.h>
 #include <oscar/Maths/Negative.h>
 #include <oscar/Maths/Normalized.h>
 #include <oscar/Maths/Plane.h>
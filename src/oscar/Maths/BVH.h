@@ -1,27 +1,58 @@
 #pragma once
 
 #include <oscar/Maths/AABB.h>
+#include <oscar/Maths/AnalyticPlane.h>
 #include <oscar/Maths/BVHCollision.h>
 #include <oscar/Maths/BVHNode.h>
 #include <oscar/Maths/BVHPrim.h>
+#include <oscar/Maths/CollisionTests.h>
+#include <oscar/Maths/Line.h>
+#include <oscar/Maths/PlaneFunctions.h>
+#include <oscar/Maths/RayCollision.h>
 #include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/Assertions.h>
 
+#include <algorithm>
+#include <array>
+#include <concepts>
 #include <cstdint>
 #include <cstddef>
 #include <functional>
 #include <optional>
 #include <span>
+#include <utility>
 #include <vector>
 
-namespace osc { struct Line; }
-
 namespace osc
 {
+    // the algorithm that a `BVH` uses to split its nodes while it's being built
+    enum class BVHBuildStrategy {
+        // splits nodes with a (binned) surface area heuristic (SAH), which takes longer to
+        // build than `LongestAxisMidpoint`, but produces trees that are faster to query. Large
+        // trees are built on multiple threads
+        SurfaceAreaHeuristic,
+
+        // splits nodes at the midpoint of their longest axis (single-threaded)
+        LongestAxisMidpoint,
+
+        NUM_OPTIONS,
+
+        Default = SurfaceAreaHeuristic,
+    };
+
     // a bounding volume hierarchy (BVH) of numerically IDed `AABB`s
     //
     // the `AABB`s may be computed from triangles, commonly called a "triangle BVH"
+    //
+    // the nodes are stored flattened, in depth-first order (a node's left-hand child
+    // immediately follows it), and each leaf node references one primitive. The depth of
+    // the tree is bounded (by `max_traversal_depth()`), so that queries can traverse it
+    // iteratively with a small, fixed-size, stack
     class BVH final {
     public:
+        // returns the maximum depth of any `BVH`
+        static constexpr size_t max_traversal_depth() { return c_max_traversal_depth; }
+
         void clear();
 
         // triangle `BVH`es
@@ -29,11 +60,13 @@ namespace osc
         // `prim.id()` will refer to the index of the first vertex in the triangle
         void build_from_indexed_triangles(
             std::span<const Vec3> vertices,
-            std::span<const uint16_t> indices
+            std::span<const uint16_t> indices,
+            BVHBuildStrategy = BVHBuildStrategy::Default
         );
         void build_from_indexed_triangles(
             std::span<const Vec3> vertices,
-            std::span<const uint32_t> indices
+            std::span<const uint32_t> indices,
+            BVHBuildStrategy = BVHBuildStrategy::Default
         );
 
         // returns the location of the closest ray-triangle collision along the ray, if any
@@ -48,18 +81,109 @@ namespace osc
             const Line&
         ) const;
 
+        // returns the location of the closest ray-triangle collision along each of the rays, if any
+        //
+        // equivalent to calling `closest_ray_indexed_triangle_collision` with each ray, but faster
+        // for large batches of rays, because neighbouring rays traverse the tree together in
+        // (vectorized) packets and large batches are split across multiple threads. Packets are
+        // most effective when neighbouring rays are coherent (i.e. have similar origins and directions)
+        std::vector<std::optional<BVHCollision>> closest_ray_indexed_triangle_collisions(
+            std::span<const Vec3> vertices,
+            std::span<const uint16_t> indices,
+            std::span<const Line> rays
+        ) const;
+        std::vector<std::optional<BVHCollision>> closest_ray_indexed_triangle_collisions(
+            std::span<const Vec3> vertices,
+            std::span<const uint32_t> indices,
+            std::span<const Line> rays
+        ) const;
+
         // `AABB` `BVH`es
         //
         // `prim.id()` will refer to the index of the `AABB`
-        void build_from_aabbs(std::span<const AABB>);
+        void build_from_aabbs(
+            std::span<const AABB>,
+            BVHBuildStrategy = BVHBuildStrategy::Default
+        );
 
         // calls the callback with each collision between the line and an `AABB` in
-        // the `BVH`
-        void for_each_ray_aabb_collision(const Line&, const std::function<void(BVHCollision)>&) const;
+        // the `BVH` (in depth-first order)
+        template<std::invocable<BVHCollision> Callback>
+        void for_each_ray_aabb_collision(const Line& ray, Callback&& callback) const
+        {
+            if (nodes_.empty() or prims_.empty()) {
+                return;
+            }
+
+            TraversalStack<size_t> stack;
+            stack.push(0);
+            while (not stack.empty()) {
+                const size_t node_index = stack.pop();
+                const BVHNode& node = nodes_[node_index];
+
+                const std::optional<RayCollision> collision = find_collision(ray, node.bounds());
+                if (not collision) {
+                    continue;  // no intersection with this node (or its children) at all
+                }
+
+                if (node.is_leaf()) {
+                    callback(BVHCollision{
+                        collision->distance,
+                        collision->position,
+                        prims_[node.first_prim_offset()].id(),
+                    });
+                }
+                else {
+                    // push the right-hand child first, so that the left-hand one is visited first
+                    stack.push(node_index + node.num_lhs_nodes() + 1);
+                    stack.push(node_index + 1);
+                }
+            }
+        }
+
+        // calls the callback with the ID of each `AABB` in the `BVH` that isn't entirely in front
+        // of any of the given (outward-facing) planes, i.e. each `AABB` that's inside, or
+        // intersects, the convex volume that the planes bound (e.g. a `FrustumPlanes`)
+        //
+        // subtrees are tested hierarchically: a subtree that's outside of the volume is skipped
+        // and a subtree that's entirely inside the volume is emitted without further tests
+        template<std::invocable<ptrdiff_t> Callback>
+        void for_each_aabb_in_convex_volume(std::span<const AnalyticPlane> outward_planes, Callback&& callback) const
+        {
+            if (nodes_.empty() or prims_.empty()) {
+                return;
+            }
+
+            // (node index, `true` if an ancestor node is entirely inside the volume)
+            TraversalStack<std::pair<size_t, bool>> stack;
+            stack.push({0, false});
+            while (not stack.empty()) {
+                auto [node_index, is_entirely_inside] = stack.pop();
+                const BVHNode& node = nodes_[node_index];
+
+                if (not is_entirely_inside) {
+                    if (std::ranges::any_of(outward_planes, [&node](const AnalyticPlane& plane) { return is_in_front_of(plane, node.bounds()); })) {
+                        continue;  // the node is entirely outside of the volume
+                    }
+                    is_entirely_inside = std::ranges::all_of(outward_planes, [&node](const AnalyticPlane& plane) { return is_behind(plane, node.bounds()); });
+                }
+
+                if (node.is_leaf()) {
+                    callback(prims_[node.first_prim_offset()].id());
+                }
+                else {
+                    stack.push({node_index + node.num_lhs_nodes() + 1, is_entirely_inside});
+                    stack.push({node_index + 1, is_entirely_inside});
+                }
+            }
+        }
 
         // returns `true` if the `BVH` contains no `BVHNode`s
         [[nodiscard]] bool empty() const;
 
+        // returns the number of primitives (triangles, `AABB`s) in the `BVH`
+        size_t num_prims() const;
+
         // returns the maximum depth of the `BVH` tree
         size_t max_depth() const;
 
@@ -73,7 +197,46 @@ namespace osc
         // calls the given function with each leaf or inner node in the tree
         void for_each_leaf_or_inner_node(const std::function<void(const BVHNode&)>&) const;
 
+        // returns the nodes of the tree, in depth-first order (e.g. for serializing it)
+        std::span<const BVHNode> nodes() const { return nodes_; }
+
+        // returns the primitives that the tree's leaf nodes reference (e.g. for serializing it)
+        std::span<const BVHPrim> prims() const { return prims_; }
+
+        // assigns the tree from nodes + primitives that were previously returned by `nodes()`
+        // and `prims()` (e.g. after deserializing them)
+        //
+        // throws if they don't form a valid tree (e.g. because a node references an
+        // out-of-bounds node or primitive, or the tree is deeper than `max_traversal_depth()`)
+        void assign(std::vector<BVHNode>, std::vector<BVHPrim>);
+
     private:
+        static constexpr size_t c_max_traversal_depth = 64;
+
+        // a fixed-capacity stack of to-be-visited nodes
+        //
+        // it never has to hold more than one pending (right-hand) node per level of the tree
+        template<typename T>
+        class TraversalStack final {
+        public:
+            bool empty() const { return size_ == 0; }
+
+            void push(T value)
+            {
+                OSC_ASSERT(size_ < data_.size() && "the BVH is deeper than its maximum traversal depth");
+                data_[size_++] = std::move(value);
+            }
+
+            T pop()
+            {
+                return std::move(data_[--size_]);
+            }
+
+        private:
+            std::array<T, c_max_traversal_depth+1> data_{};
+            size_t size_ = 0;
+        };
+
         // nodes in the hierarchy
         std::vector<BVHNode> nodes_;
 
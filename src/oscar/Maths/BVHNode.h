@@ -8,7 +8,8 @@ namespace osc
 {
     // an inner/leaf node of a BVH
     //
-    // has a spatial and hierarchical bounds, plus an index to a `BVHPrim`
+    // has a spatial and hierarchical bounds, plus an index to a `BVHPrim`, bit-packed
+    // into 32 bytes (on 64-bit platforms), so that two nodes fit into one cache line
     class BVHNode final {
     public:
         static BVHNode leaf(const AABB& bounds, size_t first_prim_offset)
@@ -66,4 +67,6 @@ namespace osc
         // bit-packed node data
         size_t data_{};
     };
+
+    static_assert(sizeof(BVHNode) == sizeof(AABB) + sizeof(size_t), "BVHNode shouldn't contain any padding");
 }
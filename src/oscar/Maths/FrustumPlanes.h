@@ -1,6 +1,7 @@
 #pragma once
 
 #include <oscar/Maths/AnalyticPlane.h>
+#include <oscar/Maths/Mat4.h>
 
 #include <cstddef>
 
@@ -37,4 +38,10 @@ namespace osc
         AnalyticPlane p4 = {.distance = 1.0f, .normal = { 0.0f,  1.0f,  0.0f}};
         AnalyticPlane p5 = {.distance = 1.0f, .normal = { 0.0f, -1.0f,  0.0f}};
     };
+
+    // returns the (normalized, outward-pointing) clipping planes of the frustum that the given
+    // view-projection matrix projects into OpenGL's clip space
+    //
+    // works for both perspective and orthographic projections
+    FrustumPlanes extract_frustum_planes(const Mat4& view_projection_matrix);
 }
@@ -1,10 +1,12 @@
 #include <oscar/Maths.h>
 
 #include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/ThreadPool.h>
 
 #include <cmath>
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <concepts>
 #include <cstddef>
 #include <functional>
@@ -12,6 +14,7 @@
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <ranges>
@@ -19,9 +22,9 @@
 #include <sstream>
 #include <string>
 #include <string_view>
-#include <stack>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 using namespace osc::literals;
 using namespace osc;
@@ -44,67 +47,266 @@ namespace
         return not (t.p0 == t.p1 or t.p0 == t.p2 or t.p1 == t.p2);
     }
 
-    // recursively build the BVH
+    // the number of buckets that prims are binned into when evaluating SAH splits
+    constexpr size_t c_bvh_num_sah_bins = 16;
+
+    // nodes that are deeper than this are split at their object median, which bounds the depth
+    // of the tree (to `c_bvh_max_split_depth + log2(num_prims)`) for any input distribution
+    constexpr size_t c_bvh_max_split_depth = BVH::max_traversal_depth()/2;
+
+    // ranges of prims that are larger than these are processed on multiple threads
+    constexpr ptrdiff_t c_bvh_min_prims_per_parallel_subtree = 1<<14;
+    constexpr ptrdiff_t c_bvh_min_prims_per_parallel_bin_chunk = 1<<15;
+
+    // returns half of the surface area of `aabb` (the SAH only compares relative areas)
+    float half_surface_area_of(const AABB& aabb)
+    {
+        const Vec3 d = dimensions_of(aabb);
+        return d.x*d.y + d.y*d.z + d.z*d.x;
+    }
+
+    // returns the (doubled, to save a multiplication) centroid of the prim along `axis`
+    float centroid_x2_along(const BVHPrim& prim, Vec3::size_type axis)
+    {
+        return prim.bounds().min[axis] + prim.bounds().max[axis];
+    }
+
+    // the union of the bounds of some prims, and the union of their centroids
+    struct BVHPrimBounds final {
+        AABB bounds;
+        AABB centroid_bounds;
+    };
+
+    BVHPrimBounds calc_prim_bounds(std::span<const BVHPrim> prims)
+    {
+        BVHPrimBounds rv{prims.front().bounds(), bounding_aabb_of(centroid_of(prims.front().bounds()))};
+        for (const BVHPrim& prim : prims.subspan(1)) {
+            rv.bounds = bounding_aabb_of(rv.bounds, prim.bounds());
+            rv.centroid_bounds = bounding_aabb_of(rv.centroid_bounds, centroid_of(prim.bounds()));
+        }
+        return rv;
+    }
+
+    // a bucket of prims (by centroid) along the split axis
+    struct BVHSAHBin final {
+        std::optional<AABB> bounds;
+        size_t count = 0;
+    };
+    using BVHSAHBins = std::array<BVHSAHBin, c_bvh_num_sah_bins>;
+
+    // maps a prim's centroid onto a bin index along the split axis
+    class BVHSAHBinMapper final {
+    public:
+        BVHSAHBinMapper(const AABB& centroid_bounds, Vec3::size_type axis) :
+            axis_{axis},
+            min_x2_{2.0f * centroid_bounds.min[axis]},
+            scale_{static_cast<float>(c_bvh_num_sah_bins) / (2.0f * (centroid_bounds.max[axis] - centroid_bounds.min[axis]))}
+        {}
+
+        size_t operator()(const BVHPrim& prim) const
+        {
+            const auto bin = static_cast<size_t>((centroid_x2_along(prim, axis_) - min_x2_) * scale_);
+            return std::min(bin, c_bvh_num_sah_bins - 1);
+        }
+
+    private:
+        Vec3::size_type axis_;
+        float min_x2_;
+        float scale_;
+    };
+
+    BVHSAHBins calc_sah_bins(std::span<const BVHPrim> prims, const BVHSAHBinMapper& to_bin)
+    {
+        BVHSAHBins rv;
+        for (const BVHPrim& prim : prims) {
+            BVHSAHBin& bin = rv[to_bin(prim)];
+            bin.bounds = bounding_aabb_of(bin.bounds, prim.bounds());
+            ++bin.count;
+        }
+        return rv;
+    }
+
+    // bins the prims, splitting large inputs into chunks that are binned in parallel
+    BVHSAHBins calc_sah_bins_in_parallel(std::span<const BVHPrim> prims, const BVHSAHBinMapper& to_bin)
+    {
+        // (merging is order-independent, so chunks are merged as they finish)
+        BVHSAHBins rv;
+        std::mutex rv_mutex;
+        ThreadPool::global().for_each_chunk(prims.size(), static_cast<size_t>(c_bvh_min_prims_per_parallel_bin_chunk), [&](size_t first, size_t last)
+        {
+            const BVHSAHBins bins = calc_sah_bins(prims.subspan(first, last - first), to_bin);
+
+            const std::lock_guard lock{rv_mutex};
+            for (size_t i = 0; i < c_bvh_num_sah_bins; ++i) {
+                if (bins[i].bounds) {
+                    rv[i].bounds = bounding_aabb_of(rv[i].bounds, *bins[i].bounds);
+                }
+                rv[i].count += bins[i].count;
+            }
+        });
+        return rv;
+    }
+
+    // partitions the prims at their object median along `axis` and returns the (relative) partition point
+    ptrdiff_t bvh_partition_at_median(std::span<BVHPrim> prims, Vec3::size_type axis)
+    {
+        const auto midpoint = std::ssize(prims)/2;
+        std::nth_element(prims.begin(), prims.begin() + midpoint, prims.end(), [axis](const BVHPrim& a, const BVHPrim& b)
+        {
+            return centroid_x2_along(a, axis) < centroid_x2_along(b, axis);
+        });
+        return midpoint;
+    }
+
+    // partitions the prims at the midpoint of the longest axis of `bounds` and returns the (relative) partition point
+    ptrdiff_t bvh_partition_at_longest_axis_midpoint(std::span<BVHPrim> prims, const AABB& bounds)
+    {
+        // compute slicing position along the longest dimension
+        const auto longest_dim_index = max_element_index(dimensions_of(bounds));
+        const float midpoint_x2 = bounds.min[longest_dim_index] + bounds.max[longest_dim_index];
+
+        // returns `true` if a given primitive is below the midpoint along the dim
+        const auto is_below_midpoint = [longest_dim_index, midpoint_x2](const BVHPrim& p)
+        {
+            return centroid_x2_along(p, longest_dim_index) <= midpoint_x2;
+        };
+
+        // partition prims into above/below the midpoint
+        const auto it = std::partition(prims.begin(), prims.end(), is_below_midpoint);
+        return std::distance(prims.begin(), it);
+    }
+
+    // partitions the prims at the bin boundary that has the lowest SAH cost and returns the (relative) partition point
+    ptrdiff_t bvh_partition_at_sah_split(std::span<BVHPrim> prims, const AABB& centroid_bounds)
+    {
+        const auto axis = max_element_index(dimensions_of(centroid_bounds));
+        if (centroid_bounds.min[axis] == centroid_bounds.max[axis]) {
+            return bvh_partition_at_median(prims, axis);  // all centroids are coincident: binning can't separate them
+        }
+
+        const BVHSAHBinMapper to_bin{centroid_bounds, axis};
+        const BVHSAHBins bins = prims.size() >= 2*c_bvh_min_prims_per_parallel_bin_chunk ?
+            calc_sah_bins_in_parallel(prims, to_bin) :
+            calc_sah_bins(prims, to_bin);
+
+        // sweep from the right to compute the area+count of everything above each split
+        std::array<float, c_bvh_num_sah_bins> rhs_costs{};
+        {
+            std::optional<AABB> rhs_bounds;
+            size_t rhs_count = 0;
+            for (size_t i = c_bvh_num_sah_bins - 1; i > 0; --i) {
+                if (bins[i].bounds) {
+                    rhs_bounds = bounding_aabb_of(rhs_bounds, *bins[i].bounds);
+                }
+                rhs_count += bins[i].count;
+                rhs_costs[i] = rhs_bounds ? half_surface_area_of(*rhs_bounds) * static_cast<float>(rhs_count) : 0.0f;
+            }
+        }
+
+        // then sweep from the left to find the split with the lowest `area(lhs)*n(lhs) + area(rhs)*n(rhs)`
+        size_t best_split = 0;  // i.e. "bins < best_split are on the left"
+        float best_cost = std::numeric_limits<float>::max();
+        {
+            std::optional<AABB> lhs_bounds;
+            size_t lhs_count = 0;
+            for (size_t split = 1; split < c_bvh_num_sah_bins; ++split) {
+                if (bins[split-1].bounds) {
+                    lhs_bounds = bounding_aabb_of(lhs_bounds, *bins[split-1].bounds);
+                }
+                lhs_count += bins[split-1].count;
+                if (lhs_count == 0 or lhs_count == prims.size()) {
+                    continue;  // not a split
+                }
+                const float cost = half_surface_area_of(*lhs_bounds) * static_cast<float>(lhs_count) + rhs_costs[split];
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_split = split;
+                }
+            }
+        }
+        if (best_split == 0) {
+            return bvh_partition_at_median(prims, axis);
+        }
+
+        const auto it = std::partition(prims.begin(), prims.end(), [&to_bin, best_split](const BVHPrim& prim)
+        {
+            return to_bin(prim) < best_split;
+        });
+        return std::distance(prims.begin(), it);
+    }
+
+    // recursively builds the (sub)tree of the prims in `[begin, begin+n)` into `nodes`
     void bvh_recursive_build(
         std::vector<BVHNode>& nodes,
-        std::vector<BVHPrim>& prims,
+        std::span<BVHPrim> all_prims,
         const ptrdiff_t begin,
-        const ptrdiff_t n)
+        const ptrdiff_t n,
+        BVHBuildStrategy strategy,
+        size_t depth,
+        size_t parallel_depth)
     {
+        const std::span<BVHPrim> prims = all_prims.subspan(static_cast<size_t>(begin), static_cast<size_t>(n));
+
         if (n == 1) {
             // recursion bottomed out: create a leaf node
             nodes.push_back(BVHNode::leaf(
-                prims.at(begin).bounds(),
-                begin
+                prims.front().bounds(),
+                static_cast<size_t>(begin)
             ));
             return;
         }
 
         // else: `n >= 2`, so partition the data appropriately and allocate an internal node
+        const BVHPrimBounds bounds = calc_prim_bounds(prims);
 
-        ptrdiff_t midpoint = -1;
-        ptrdiff_t internal_node_loc = -1;
-        {
-            // allocate an appropriate internal node
-
-            // compute bounding box of remaining (children) prims
-            const AABB aabb = bounding_aabb_of(
-                std::span<const BVHPrim>{prims.begin() + begin, static_cast<size_t>(n)},
-                &BVHPrim::bounds
-            );
-
-            // compute slicing position along the longest dimension
-            const auto longest_dim_index = max_element_index(dimensions_of(aabb));
-            const float midpoint_x2 = aabb.min[longest_dim_index] + aabb.max[longest_dim_index];
-
-            // returns `true` if a given primitive is below the midpoint along the dim
-            const auto is_below_midpoint = [longest_dim_index, midpoint_x2](const BVHPrim& p)
+        ptrdiff_t num_lhs_prims = 0;
+        if (depth >= c_bvh_max_split_depth) {
+            num_lhs_prims = bvh_partition_at_median(prims, max_element_index(dimensions_of(bounds.centroid_bounds)));
+        }
+        else if (strategy == BVHBuildStrategy::SurfaceAreaHeuristic) {
+            num_lhs_prims = bvh_partition_at_sah_split(prims, bounds.centroid_bounds);
+        }
+        else {
+            num_lhs_prims = bvh_partition_at_longest_axis_midpoint(prims, bounds.bounds);
+        }
+        if (num_lhs_prims == 0 or num_lhs_prims == n) {
+            // edge-case: failed to spacially partition: just naievely partition
+            num_lhs_prims = n/2;
+        }
+        const ptrdiff_t midpoint = begin + num_lhs_prims;
+
+        // push the internal node (the number of left-hand nodes is set later)
+        const ptrdiff_t internal_node_loc = std::ssize(nodes);
+        nodes.push_back(BVHNode::node(bounds.bounds, 0));
+
+        if (depth < parallel_depth and n >= c_bvh_min_prims_per_parallel_subtree) {
+            // build the subtrees concurrently (on the thread pool and this thread), and then append
+            // them: the subtrees only contain relative node offsets and absolute prim offsets, so
+            // they can be built separately and then concatenated
+            std::vector<BVHNode> lhs_nodes;
+            std::vector<BVHNode> rhs_nodes;
+            ThreadPool::global().for_each_chunk(2, 1, [&](size_t first, size_t last)
             {
-                const float prim_midpoint_x2 = p.bounds().min[longest_dim_index] + p.bounds().max[longest_dim_index];
-                return prim_midpoint_x2 <= midpoint_x2;
-            };
-
-            // partition prims into above/below the midpoint
-            const ptrdiff_t end = begin + n;
-            const auto it = std::partition(prims.begin() + begin, prims.begin() + end, is_below_midpoint);
-
-            midpoint = std::distance(prims.begin(), it);
-            if (midpoint == begin or midpoint == end) {
-                // edge-case: failed to spacially partition: just naievely partition
-                midpoint = begin + n/2;
-            }
-
-            internal_node_loc = std::ssize(nodes);
+                for (size_t side = first; side < last; ++side) {
+                    if (side == 0) {
+                        lhs_nodes.reserve(2*static_cast<size_t>(num_lhs_prims));
+                        bvh_recursive_build(lhs_nodes, all_prims, begin, num_lhs_prims, strategy, depth+1, parallel_depth);
+                    }
+                    else {
+                        rhs_nodes.reserve(2*static_cast<size_t>(n - num_lhs_prims));
+                        bvh_recursive_build(rhs_nodes, all_prims, midpoint, n - num_lhs_prims, strategy, depth+1, parallel_depth);
+                    }
+                }
+            });
 
-            // push the internal node
-            nodes.push_back(BVHNode::node(
-                aabb,
-                0  // the number of left-hand nodes is set later
-            ));
+            nodes[internal_node_loc].set_num_lhs_nodes(lhs_nodes.size());
+            nodes.insert(nodes.end(), lhs_nodes.begin(), lhs_nodes.end());
+            nodes.insert(nodes.end(), rhs_nodes.begin(), rhs_nodes.end());
+            return;
         }
 
         // build left-hand subtree
-        bvh_recursive_build(nodes, prims, begin, midpoint-begin);
+        bvh_recursive_build(nodes, all_prims, begin, num_lhs_prims, strategy, depth+1, parallel_depth);
 
         // the left-hand build allocated nodes for the left hand side contiguously in memory
         const ptrdiff_t num_lhs_nodes = (std::ssize(nodes) - 1) - internal_node_loc;
@@ -112,108 +314,381 @@ namespace
         nodes[internal_node_loc].set_num_lhs_nodes(num_lhs_nodes);
 
         // build right node
-        bvh_recursive_build(nodes, prims, midpoint, (begin + n) - midpoint);
+        bvh_recursive_build(nodes, all_prims, midpoint, n - num_lhs_prims, strategy, depth+1, parallel_depth);
         OSC_ASSERT(internal_node_loc+num_lhs_nodes < std::ssize(nodes));
     }
 
-    // returns `true` if something hit (recursively)
-    //
-    // populates outparam with all `AABB` hits in depth-first order
-    bool bvh_for_each_ray_aabb_collisions_recursive(
+    // (re)builds `nodes` from `prims`, reordering `prims` such that each leaf node references
+    // one of them
+    void bvh_build(
+        std::vector<BVHNode>& nodes,
+        std::vector<BVHPrim>& prims,
+        BVHBuildStrategy strategy)
+    {
+        nodes.clear();
+        nodes.reserve(2 * prims.size());
+        if (not prims.empty()) {
+            // only the SAH builder is multi-threaded, and only down to the level of the tree
+            // that has (roughly) twice as many subtrees as there are threads in the thread pool
+            const size_t parallel_depth = strategy == BVHBuildStrategy::SurfaceAreaHeuristic ?
+                static_cast<size_t>(std::bit_width(ThreadPool::global().num_workers() + 1)) :
+                0;
+            bvh_recursive_build(nodes, prims, 0, std::ssize(prims), strategy, 0, parallel_depth);
+        }
+        prims.shrink_to_fit();
+        nodes.shrink_to_fit();
+    }
+
+    // traverses the subtree rooted at `root_index` front-to-back with a single ray, and updates
+    // `closest` (+ `closest_id`) with any ray-triangle collision that's closer than `closest`
+    template<std::unsigned_integral TIndex>
+    void bvh_update_closest_ray_indexed_triangle_collision_in_subtree(
         std::span<const BVHNode> nodes,
         std::span<const BVHPrim> prims,
+        std::span<const Vec3> vertices,
+        std::span<const TIndex> indices,
         const Line& ray,
-        ptrdiff_t node_index,
-        const std::function<void(BVHCollision)>& callback)
+        size_t root_index,
+        float& closest,
+        ptrdiff_t& closest_id)
     {
-        const BVHNode& node = nodes[node_index];
-
-        // check ray-AABB intersection with the BVH node
-        const std::optional<RayCollision> maybe_collision = find_collision(ray, node.bounds());
-        if (not maybe_collision) {
-            return false;  // no intersection with this node at all
+        // (node index, distance along the ray to the node's `AABB`)
+        std::array<std::pair<size_t, float>, BVH::max_traversal_depth()+1> stack;
+        size_t stack_size = 0;
+        if (const auto root_collision = find_collision(ray, nodes[root_index].bounds())) {
+            stack[stack_size++] = {root_index, root_collision->distance};
         }
 
-        if (node.is_leaf()) {
-            // it's a leaf node, so we've sucessfully found the `AABB` that intersected
-            callback(BVHCollision{
-                maybe_collision->distance,
-                maybe_collision->position,
-                prims[node.first_prim_offset()].id(),
-            });
-            return true;
-        }
+        while (stack_size > 0) {
+            const auto [node_index, node_distance] = stack[--stack_size];
+            if (node_distance > closest) {
+                continue;  // this AABB can't contain something closer
+            }
+
+            const BVHNode& node = nodes[node_index];
+            if (node.is_leaf()) {
+                // leaf node: check ray-triangle intersection
+                const BVHPrim& prim = prims[node.first_prim_offset()];
+                const Triangle triangle = {
+                    at(vertices, at(indices, prim.id())),
+                    at(vertices, at(indices, prim.id()+1)),
+                    at(vertices, at(indices, prim.id()+2)),
+                };
+
+                const std::optional<RayCollision> triangle_collision = find_collision(ray, triangle);
+                if (triangle_collision and triangle_collision->distance < closest) {
+                    closest = triangle_collision->distance;
+                    closest_id = prim.id();
+                }
+                continue;
+            }
 
-        // else: we've "hit" an internal node and need to recurse to find the leaf
-        const bool lhs_hit = bvh_for_each_ray_aabb_collisions_recursive(nodes, prims, ray, node_index+1, callback);
-        const bool rhs_hit = bvh_for_each_ray_aabb_collisions_recursive(nodes, prims, ray, node_index+node.num_lhs_nodes()+1, callback);
-        return lhs_hit or rhs_hit;
+            // else: `is_node`, so test both children and visit the nearer one first (i.e. push it
+            // last), so that `closest` shrinks as early as possible
+            const size_t lhs_index = node_index + 1;
+            const size_t rhs_index = node_index + node.num_lhs_nodes() + 1;
+            const std::optional<RayCollision> lhs = find_collision(ray, nodes[lhs_index].bounds());
+            const std::optional<RayCollision> rhs = find_collision(ray, nodes[rhs_index].bounds());
+
+            if (lhs and rhs) {
+                OSC_ASSERT(stack_size + 2 <= stack.size() && "the BVH is deeper than its maximum traversal depth");
+                if (lhs->distance <= rhs->distance) {
+                    stack[stack_size++] = {rhs_index, rhs->distance};
+                    stack[stack_size++] = {lhs_index, lhs->distance};
+                }
+                else {
+                    stack[stack_size++] = {lhs_index, lhs->distance};
+                    stack[stack_size++] = {rhs_index, rhs->distance};
+                }
+            }
+            else if (lhs or rhs) {
+                OSC_ASSERT(stack_size + 1 <= stack.size() && "the BVH is deeper than its maximum traversal depth");
+                stack[stack_size++] = lhs ? std::pair{lhs_index, lhs->distance} : std::pair{rhs_index, rhs->distance};
+            }
+        }
     }
 
     template<std::unsigned_integral TIndex>
-    std::optional<BVHCollision> bvh_get_closest_ray_indexed_triangle_collision_recursive(
+    std::optional<BVHCollision> bvh_get_closest_ray_indexed_triangle_collision(
         std::span<const BVHNode> nodes,
         std::span<const BVHPrim> prims,
         std::span<const Vec3> vertices,
         std::span<const TIndex> indices,
-        const Line& ray,
-        float& closest,
-        ptrdiff_t node_index)
+        const Line& ray)
     {
-        const BVHNode& node = nodes[node_index];
-        const std::optional<RayCollision> node_collision = find_collision(ray, node.bounds());
+        if (nodes.empty() or prims.empty() or indices.empty()) {
+            return std::nullopt;
+        }
 
-        if (not node_collision) {
-            return std::nullopt;  // didn't hit this node at all
+        float closest = std::numeric_limits<float>::max();
+        ptrdiff_t closest_id = -1;
+        bvh_update_closest_ray_indexed_triangle_collision_in_subtree(nodes, prims, vertices, indices, ray, 0, closest, closest_id);
+        if (closest_id == -1) {
+            return std::nullopt;
         }
+        return BVHCollision{closest, ray.origin + closest*ray.direction, closest_id};
+    }
+
+    // the number of rays that a batched ray-triangle query traverses a `BVH` with at once
+    //
+    // packets are stored as structures-of-arrays, and their per-ray (per-"lane") tests are
+    // written as branch-free loops over the lanes, so that compilers can vectorize them for
+    // whichever SIMD instruction set (SSE, AVX, NEON) is being targeted
+    constexpr size_t c_bvh_ray_packet_width = 8;
+    static_assert(c_bvh_ray_packet_width <= 32, "packet hit masks are stored in a `uint32_t`");
+
+    // if this many (or fewer) rays in a packet hit a node, then the rays are traversed through the
+    // rest of the node's subtree one-by-one, because packet tests mostly test inactive rays from then on
+    constexpr int c_bvh_max_rays_per_diverged_packet = 2;
 
-        if (node_collision->distance > closest) {
-            return std::nullopt;  // this AABB can't contain something closer
+    // the minimum number of rays that a batched ray-triangle query hands to each thread
+    constexpr size_t c_bvh_min_rays_per_parallel_chunk = 1<<12;
+
+    using BVHRayPacketLanes = std::array<float, c_bvh_ray_packet_width>;
+
+    // a packet of (up to `c_bvh_ray_packet_width`) rays, plus the closest triangle hit by each
+    struct BVHRayPacket final {
+
+        explicit BVHRayPacket(std::span<const Line> rays)
+        {
+            OSC_ASSERT(not rays.empty() and rays.size() <= c_bvh_ray_packet_width);
+
+            // unused lanes have a negative `closest`, so that they can't hit anything
+            for (auto& lanes : inverse_direction) {
+                lanes.fill(1.0f);
+            }
+            closest.fill(-1.0f);
+
+            for (size_t lane = 0; lane < rays.size(); ++lane) {
+                for (Vec3::size_type axis = 0; axis < 3; ++axis) {
+                    origin[axis][lane] = rays[lane].origin[axis];
+                    direction[axis][lane] = rays[lane].direction[axis];
+                    inverse_direction[axis][lane] = 1.0f / rays[lane].direction[axis];
+                }
+                closest[lane] = std::numeric_limits<float>::max();
+            }
         }
 
-        if (node.is_leaf()) {
-            // leaf node: check ray-triangle intersection
+        std::array<BVHRayPacketLanes, 3> origin{};
+        std::array<BVHRayPacketLanes, 3> direction{};
+        std::array<BVHRayPacketLanes, 3> inverse_direction{};
+        BVHRayPacketLanes closest{};
+        std::array<ptrdiff_t, c_bvh_ray_packet_width> closest_id{};
+    };
 
-            const BVHPrim& prim = at(prims, node.first_prim_offset());
+    // returns a bitmask of the rays in the packet that hit the `AABB` before they hit their
+    // closest triangle
+    uint32_t rays_that_hit_before_closest(const BVHRayPacket& packet, const AABB& aabb)
+    {
+        // slab test (see `find_collision(const Line&, const AABB&)`), clamped to [0, closest]
+        //
+        // the near/far selection is written in the same way as the single-ray test, so that
+        // NaNs (e.g. from a ray that's parallel to, and on, a slab's plane) are handled identically
+        BVHRayPacketLanes t0{};
+        BVHRayPacketLanes t1 = packet.closest;
+        for (Vec3::size_type axis = 0; axis < 3; ++axis) {
+            const float min = aabb.min[axis];
+            const float max = aabb.max[axis];
+            const BVHRayPacketLanes& origin = packet.origin[axis];
+            const BVHRayPacketLanes& inverse_direction = packet.inverse_direction[axis];
+            for (size_t lane = 0; lane < c_bvh_ray_packet_width; ++lane) {
+                const float t_a = (min - origin[lane]) * inverse_direction[lane];
+                const float t_b = (max - origin[lane]) * inverse_direction[lane];
+                const bool is_reversed = t_a > t_b;
+                const float t_near = is_reversed ? t_b : t_a;
+                const float t_far = is_reversed ? t_a : t_b;
+                t0[lane] = t0[lane] < t_near ? t_near : t0[lane];  // i.e. `std::max(t0, t_near)`
+                t1[lane] = t_far < t1[lane] ? t_far : t1[lane];    // i.e. `std::min(t1, t_far)`
+            }
+        }
 
-            const Triangle triangle = {
-                at(vertices, at(indices, prim.id())),
-                at(vertices, at(indices, prim.id()+1)),
-                at(vertices, at(indices, prim.id()+2)),
-            };
+        uint32_t mask = 0;
+        for (size_t lane = 0; lane < c_bvh_ray_packet_width; ++lane) {
+            mask |= static_cast<uint32_t>(t0[lane] <= t1[lane]) << lane;
+        }
+        return mask;
+    }
 
-            const std::optional<RayCollision> triangle_collision = find_collision(ray, triangle);
+    // updates each lane of the packet that hits `triangle` closer than its current closest hit
+    //
+    // this performs the same (geometric) test as `find_collision(const Line&, const Triangle&)`,
+    // so that batched queries return the same collisions as single-ray ones
+    void update_closest_ray_triangle_collisions(
+        BVHRayPacket& packet,
+        const Triangle& triangle,
+        ptrdiff_t id)
+    {
+        // (copied, so that the compiler knows that they don't alias the packet)
+        const Vec3 p0 = triangle.p0;
+        const Vec3 p1 = triangle.p1;
+        const Vec3 p2 = triangle.p2;
+        const Vec3 N = triangle_normal(triangle);
+        const float D = dot(N, p0);
+        const std::array<Vec3, 3> edges = {p1 - p0, p2 - p1, p0 - p2};
+
+        // returns `true` if `p` is on the inner side of the given edge (see the single-ray test)
+        const auto is_inside_edge = [&N](const Vec3& start, const Vec3& e, float px, float py, float pz)
+        {
+            const float cx = px - start.x;
+            const float cy = py - start.y;
+            const float cz = pz - start.z;
+            const float ax = e.y * cz - cy * e.z;
+            const float ay = e.z * cx - cz * e.x;
+            const float az = e.x * cy - cx * e.y;
+            return (ax*N.x + ay*N.y + az*N.z) >= 0.0f;
+        };
+
+        // (`&`, rather than `and`, so that the loop is branch-free and can be vectorized)
+        std::array<int32_t, c_bvh_ray_packet_width> is_closer_hit{};
+        for (size_t lane = 0; lane < c_bvh_ray_packet_width; ++lane) {
+            const float ox = packet.origin[0][lane];
+            const float oy = packet.origin[1][lane];
+            const float oz = packet.origin[2][lane];
+            const float dx = packet.direction[0][lane];
+            const float dy = packet.direction[1][lane];
+            const float dz = packet.direction[2][lane];
+
+            const float NdotR = N.x*dx + N.y*dy + N.z*dz;
+            const float t = -((N.x*ox + N.y*oy + N.z*oz) - D) / NdotR;
+            const float px = ox + t*dx;
+            const float py = oy + t*dy;
+            const float pz = oz + t*dz;
+
+            int32_t is_hit = std::abs(NdotR) >= epsilon_v<float> ? 1 : 0;
+            is_hit &= t >= 0.0f ? 1 : 0;
+            is_hit &= t < packet.closest[lane] ? 1 : 0;
+            is_hit &= is_inside_edge(p0, edges[0], px, py, pz) ? 1 : 0;
+            is_hit &= is_inside_edge(p1, edges[1], px, py, pz) ? 1 : 0;
+            is_hit &= is_inside_edge(p2, edges[2], px, py, pz) ? 1 : 0;
+            is_closer_hit[lane] = is_hit;
+            packet.closest[lane] = is_hit != 0 ? t : packet.closest[lane];
+        }
 
-            if (triangle_collision and triangle_collision->distance < closest) {
-                closest = triangle_collision->distance;
-                return BVHCollision{triangle_collision->distance, triangle_collision->position, prim.id()};
+        for (size_t lane = 0; lane < c_bvh_ray_packet_width; ++lane) {
+            if (is_closer_hit[lane]) {
+                packet.closest_id[lane] = id;
             }
-            else {
-                return std::nullopt;  // it didn't collide with the triangle
+        }
+    }
+
+    // writes the closest ray-triangle collision of each of the (up to `c_bvh_ray_packet_width`)
+    // rays into `out`
+    template<std::unsigned_integral TIndex>
+    void bvh_get_closest_ray_indexed_triangle_collisions_in_packet(
+        std::span<const BVHNode> nodes,
+        std::span<const BVHPrim> prims,
+        std::span<const Vec3> vertices,
+        std::span<const TIndex> indices,
+        std::span<const Line> rays,
+        std::span<std::optional<BVHCollision>> out)
+    {
+        BVHRayPacket packet{rays};
+
+        std::array<size_t, BVH::max_traversal_depth()+1> stack;
+        size_t stack_size = 0;
+        stack[stack_size++] = 0;
+
+        while (stack_size > 0) {
+            const size_t node_index = stack[--stack_size];
+            const BVHNode& node = nodes[node_index];
+            const uint32_t mask = rays_that_hit_before_closest(packet, node.bounds());
+            if (mask == 0) {
+                continue;  // no ray in the packet can hit something closer in this node
+            }
+
+            if (std::popcount(mask) <= c_bvh_max_rays_per_diverged_packet) {
+                // the rays have diverged, so it's cheaper to traverse the rest of the subtree ray-by-ray
+                for (size_t lane = 0; lane < rays.size(); ++lane) {
+                    if (mask & (1u << lane)) {
+                        bvh_update_closest_ray_indexed_triangle_collision_in_subtree(
+                            nodes,
+                            prims,
+                            vertices,
+                            indices,
+                            rays[lane],
+                            node_index,
+                            packet.closest[lane],
+                            packet.closest_id[lane]
+                        );
+                    }
+                }
+                continue;
             }
+
+            if (node.is_leaf()) {
+                const BVHPrim& prim = prims[node.first_prim_offset()];
+                const Triangle triangle = {
+                    at(vertices, at(indices, prim.id())),
+                    at(vertices, at(indices, prim.id()+1)),
+                    at(vertices, at(indices, prim.id()+2)),
+                };
+                update_closest_ray_triangle_collisions(packet, triangle, prim.id());
+                continue;
+            }
+
+            // else: `is_node`, so visit the child that's nearer along the first ray's direction
+            // first (i.e. push it last), so that each ray's `closest` shrinks as early as possible
+            const size_t lhs_index = node_index + 1;
+            const size_t rhs_index = node_index + node.num_lhs_nodes() + 1;
+            const Vec3 lhs_to_rhs = centroid_of(nodes[rhs_index].bounds()) - centroid_of(nodes[lhs_index].bounds());
+            Vec3::size_type axis = 0;
+            for (Vec3::size_type i = 1; i < 3; ++i) {
+                if (abs(lhs_to_rhs[i]) > abs(lhs_to_rhs[axis])) {
+                    axis = i;
+                }
+            }
+            const bool lhs_is_nearer = lhs_to_rhs[axis] * packet.direction[axis][0] >= 0.0f;
+
+            OSC_ASSERT(stack_size + 2 <= stack.size() && "the BVH is deeper than its maximum traversal depth");
+            stack[stack_size++] = lhs_is_nearer ? rhs_index : lhs_index;
+            stack[stack_size++] = lhs_is_nearer ? lhs_index : rhs_index;
         }
 
-        // else: `is_node`, so recurse
-        const std::optional<BVHCollision> lhs = bvh_get_closest_ray_indexed_triangle_collision_recursive(
-            nodes,
-            prims,
-            vertices,
-            indices,
-            ray,
-            closest,
-            node_index+1
-        );
-        const std::optional<BVHCollision> rhs = bvh_get_closest_ray_indexed_triangle_collision_recursive(
-            nodes,
-            prims,
-            vertices,
-            indices,
-            ray,
-            closest,
-            node_index+node.num_lhs_nodes()+1
-        );
-
-        return rhs ? rhs : lhs;
+        for (size_t lane = 0; lane < rays.size(); ++lane) {
+            if (packet.closest[lane] < std::numeric_limits<float>::max()) {
+                const float t = packet.closest[lane];
+                out[lane] = BVHCollision{t, rays[lane].origin + t*rays[lane].direction, packet.closest_id[lane]};
+            }
+        }
+    }
+
+    template<std::unsigned_integral TIndex>
+    std::vector<std::optional<BVHCollision>> bvh_get_closest_ray_indexed_triangle_collisions(
+        std::span<const BVHNode> nodes,
+        std::span<const BVHPrim> prims,
+        std::span<const Vec3> vertices,
+        std::span<const TIndex> indices,
+        std::span<const Line> rays)
+    {
+        std::vector<std::optional<BVHCollision>> rv(rays.size());
+        if (nodes.empty() or prims.empty() or indices.empty()) {
+            return rv;
+        }
+
+        // processes the rays in `[first, last)` packet-by-packet
+        const auto process_rays = [&](size_t first, size_t last)
+        {
+            for (size_t i = first; i < last; i += c_bvh_ray_packet_width) {
+                const size_t n = std::min(c_bvh_ray_packet_width, last - i);
+                bvh_get_closest_ray_indexed_triangle_collisions_in_packet<TIndex>(
+                    nodes,
+                    prims,
+                    vertices,
+                    indices,
+                    rays.subspan(i, n),
+                    std::span{rv}.subspan(i, n)
+                );
+            }
+        };
+
+        // large batches are split into packet-aligned chunks that are processed concurrently
+        const size_t num_packets = (rays.size() + c_bvh_ray_packet_width - 1) / c_bvh_ray_packet_width;
+        const size_t min_packets_per_chunk = std::max<size_t>(c_bvh_min_rays_per_parallel_chunk / c_bvh_ray_packet_width, 1);
+        ThreadPool::global().for_each_chunk(num_packets, min_packets_per_chunk, [&](size_t first_packet, size_t last_packet)
+        {
+            process_rays(first_packet * c_bvh_ray_packet_width, std::min(last_packet * c_bvh_ray_packet_width, rays.size()));
+        });
+        return rv;
     }
 
     template<std::unsigned_integral TIndex>
@@ -221,7 +696,8 @@ namespace
         std::vector<BVHNode>& nodes,
         std::vector<BVHPrim>& prims,
         std::span<const Vec3> vertices,
-        std::span<const TIndex> indices)
+        std::span<const TIndex> indices,
+        BVHBuildStrategy strategy)
     {
         // clear out any old data
         nodes.clear();
@@ -241,29 +717,7 @@ namespace
             }
         }
 
-        nodes.reserve(2 * prims.size());  // guess
-        if (not prims.empty()) {
-            bvh_recursive_build(nodes, prims, 0, std::ssize(prims));
-        }
-
-        prims.shrink_to_fit();
-        nodes.shrink_to_fit();
-    }
-
-    template<std::unsigned_integral TIndex>
-    std::optional<BVHCollision> bvh_get_closest_ray_indexed_triangle_collision(
-        std::span<const BVHNode> nodes,
-        std::span<const BVHPrim> prims,
-        std::span<const Vec3> vertices,
-        std::span<const TIndex> indices,
-        const Line& ray)
-    {
-        if (nodes.empty() or prims.empty() or indices.empty()) {
-            return std::nullopt;
-        }
-
-        float closest = std::numeric_limits<float>::max();
-        return bvh_get_closest_ray_indexed_triangle_collision_recursive(nodes, prims, vertices, indices, ray, closest, 0);
+        bvh_build(nodes, prims, strategy);
     }
 
     // describes the direction of each cube face and which direction is "up"
@@ -293,23 +747,31 @@ void osc::BVH::clear()
     prims_.clear();
 }
 
-void osc::BVH::build_from_indexed_triangles(std::span<const Vec3> vertices, std::span<const uint16_t> indices)
+void osc::BVH::build_from_indexed_triangles(
+    std::span<const Vec3> vertices,
+    std::span<const uint16_t> indices,
+    BVHBuildStrategy strategy)
 {
     bvh_build_from_indexed_triangles<uint16_t>(
         nodes_,
         prims_,
         vertices,
-        indices
+        indices,
+        strategy
     );
 }
 
-void osc::BVH::build_from_indexed_triangles(std::span<const Vec3> vertices, std::span<const uint32_t> indices)
+void osc::BVH::build_from_indexed_triangles(
+    std::span<const Vec3> vertices,
+    std::span<const uint32_t> indices,
+    BVHBuildStrategy strategy)
 {
     bvh_build_from_indexed_triangles<uint32_t>(
         nodes_,
         prims_,
         vertices,
-        indices
+        indices,
+        strategy
     );
 }
 
@@ -341,7 +803,35 @@ std::optional<BVHCollision> osc::BVH::closest_ray_indexed_triangle_collision(
     );
 }
 
-void osc::BVH::build_from_aabbs(std::span<const AABB> aabbs)
+std::vector<std::optional<BVHCollision>> osc::BVH::closest_ray_indexed_triangle_collisions(
+    std::span<const Vec3> vertices,
+    std::span<const uint16_t> indices,
+    std::span<const Line> rays) const
+{
+    return bvh_get_closest_ray_indexed_triangle_collisions<uint16_t>(
+        nodes_,
+        prims_,
+        vertices,
+        indices,
+        rays
+    );
+}
+
+std::vector<std::optional<BVHCollision>> osc::BVH::closest_ray_indexed_triangle_collisions(
+    std::span<const Vec3> vertices,
+    std::span<const uint32_t> indices,
+    std::span<const Line> rays) const
+{
+    return bvh_get_closest_ray_indexed_triangle_collisions<uint32_t>(
+        nodes_,
+        prims_,
+        vertices,
+        indices,
+        rays
+    );
+}
+
+void osc::BVH::build_from_aabbs(std::span<const AABB> aabbs, BVHBuildStrategy strategy)
 {
     // clear out any old data
     clear();
@@ -354,68 +844,38 @@ void osc::BVH::build_from_aabbs(std::span<const AABB> aabbs)
         }
     }
 
-    nodes_.reserve(2 * prims_.size());
-    if (not prims_.empty()) {
-        bvh_recursive_build(nodes_, prims_, 0, ssize(prims_));
-    }
-
-    prims_.shrink_to_fit();
-    nodes_.shrink_to_fit();
+    bvh_build(nodes_, prims_, strategy);
 }
 
-void osc::BVH::for_each_ray_aabb_collision(
-    const Line& ray,
-    const std::function<void(BVHCollision)>& callback) const
+bool osc::BVH::empty() const
 {
-    if (nodes_.empty() or prims_.empty()) {
-        return;
-    }
-
-    bvh_for_each_ray_aabb_collisions_recursive(
-        nodes_,
-        prims_,
-        ray,
-        0,
-        callback
-    );
+    return nodes_.empty();
 }
 
-bool osc::BVH::empty() const
+size_t osc::BVH::num_prims() const
 {
-    return nodes_.empty();
+    return prims_.size();
 }
 
 size_t osc::BVH::max_depth() const
 {
-    size_t cur = 0;
-    size_t maxdepth = 0;
-    std::stack<size_t> stack;
-
-    while (cur < nodes_.size()) {
-        if (nodes_[cur].is_leaf()) {
-            // leaf node: compute its depth and continue traversal (if applicable)
-
-            maxdepth = max(maxdepth, stack.size() + 1);
-
-            if (stack.empty()) {
-                break;  // nowhere to traverse to: exit
-            }
-            else {
-                // traverse up to a parent node and try the right-hand side
-                const size_t next = stack.top();
-                stack.pop();
-                cur = next + nodes_[next].num_lhs_nodes() + 1;
-            }
-        }
-        else {
-            // internal node: push into the (right-hand) history stack and then
-            //                traverse to the left-hand side
+    if (nodes_.empty()) {
+        return 0;
+    }
 
-            stack.push(cur);
-            cur += 1;
+    // (node index, depth of node)
+    size_t maxdepth = 0;
+    std::vector<std::pair<size_t, size_t>> stack = {{0, 1}};
+    while (not stack.empty()) {
+        const auto [node_index, depth] = stack.back();
+        stack.pop_back();
+
+        maxdepth = max(maxdepth, depth);
+        if (nodes_[node_index].is_node()) {
+            stack.emplace_back(node_index + 1, depth + 1);
+            stack.emplace_back(node_index + nodes_[node_index].num_lhs_nodes() + 1, depth + 1);
         }
     }
-
     return maxdepth;
 }
 
@@ -443,6 +903,50 @@ void osc::BVH::for_each_leaf_or_inner_node(const std::function<void(const BVHNod
     }
 }
 
+void osc::BVH::assign(std::vector<BVHNode> nodes, std::vector<BVHPrim> prims)
+{
+    // check that each node's subtree exactly fills its (depth-first) range of nodes, so that
+    // traversals can never index out of bounds
+    if (not nodes.empty()) {
+        struct PendingSubtree final {
+            size_t first_node;
+            size_t end_node;
+            size_t depth;
+        };
+        std::vector<PendingSubtree> stack = {{0, nodes.size(), 1}};
+        while (not stack.empty()) {
+            const auto [first, end, depth] = stack.back();
+            stack.pop_back();
+
+            if (depth > c_max_traversal_depth) {
+                throw std::invalid_argument{"cannot assign BVH nodes: the tree is deeper than the maximum traversal depth"};
+            }
+
+            const BVHNode& node = nodes[first];
+            if (node.is_leaf()) {
+                if (end != first + 1) {
+                    throw std::invalid_argument{"cannot assign BVH nodes: a leaf node has children"};
+                }
+                if (node.first_prim_offset() >= prims.size()) {
+                    throw std::invalid_argument{"cannot assign BVH nodes: a leaf node references an out-of-bounds primitive"};
+                }
+            }
+            else {
+                const size_t num_lhs_nodes = node.num_lhs_nodes();
+                if (num_lhs_nodes == 0 or num_lhs_nodes >= end - first - 1) {
+                    throw std::invalid_argument{"cannot assign BVH nodes: an inner node does not have two children"};
+                }
+                const size_t rhs_first = first + 1 + num_lhs_nodes;
+                stack.push_back({first + 1, rhs_first, depth + 1});
+                stack.push_back({rhs_first, end, depth + 1});
+            }
+        }
+    }
+
+    nodes_ = std::move(nodes);
+    prims_ = std::move(prims);
+}
+
 // `CoordinateAxis` implementation
 
 std::optional<CoordinateAxis> osc::CoordinateAxis::try_parse(std::string_view str)
@@ -1385,6 +1889,32 @@ bool osc::is_intersecting(const Rect& rect, const Vec2& point)
         (0.0f <= relative_pos.y and relative_pos.y <= rect_dims.y);
 }
 
+FrustumPlanes osc::extract_frustum_planes(const Mat4& view_projection_matrix)
+{
+    // Gribb-Hartmann method: each clipping plane is a sum/difference of the matrix's fourth
+    // row and one of its other rows (e.g. a point is to the right of the left plane if
+    // `-w <= x`, i.e. `(row3 + row0) * p >= 0`)
+    const Mat4& m = view_projection_matrix;
+    const auto row = [&m](Mat4::size_type i) { return Vec4{m[0][i], m[1][i], m[2][i], m[3][i]}; };
+
+    // converts an inward-facing plane, in general form, into a normalized outward-facing plane
+    const auto to_outward_plane = [](const Vec4& inward)
+    {
+        const Vec3 normal{inward};
+        const float len = length(normal);
+        return AnalyticPlane{.distance = inward.w / len, .normal = -normal / len};
+    };
+
+    return {
+        to_outward_plane(row(3) + row(2)),  // near
+        to_outward_plane(row(3) - row(2)),  // far
+        to_outward_plane(row(3) - row(0)),  // right
+        to_outward_plane(row(3) + row(0)),  // left
+        to_outward_plane(row(3) - row(1)),  // top
+        to_outward_plane(row(3) + row(1)),  // bottom
+    };
+}
+
 bool osc::is_intersecting(const FrustumPlanes& frustum, const AABB& aabb)
 {
     return not rgs::any_of(frustum, [&aabb](const auto& plane) { return is_in_front_of(plane, aabb); });
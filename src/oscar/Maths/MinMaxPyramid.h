@@ -0,0 +1,148 @@
+#pragma once
+
+#include <oscar/Maths/Vec2.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace osc
+{
+    // an append-only series of values plus a min/max "level of detail" pyramid over them
+    //
+    // each level of the pyramid holds the min+max of consecutive blocks of the series, where
+    // level `k` has a block size of `2^(k+1)` values. Appending a value updates the pyramid
+    // incrementally (in O(log(n))), which makes it possible to draw a decimated, but
+    // outlier-preserving, version of a very long series (e.g. a plot with one min+max pair
+    // per horizontal pixel) without having to visit every value in it each frame
+    class MinMaxPyramid final {
+    public:
+        struct MinMax final {
+            float min;
+            float max;
+        };
+
+        // returns the number of values in the series
+        size_t size() const { return values_.size(); }
+        bool empty() const { return values_.empty(); }
+
+        // returns the (full-resolution) values in the series
+        std::span<const float> values() const { return values_; }
+        float operator[](size_t i) const { return values_[i]; }
+
+        void clear()
+        {
+            values_.clear();
+            levels_.clear();
+        }
+
+        void push_back(float value)
+        {
+            values_.push_back(value);
+            const size_t i = values_.size() - 1;
+
+            // update existing levels
+            for (size_t level = 0; level < levels_.size(); ++level) {
+                std::vector<MinMax>& blocks = levels_[level];
+                const size_t block = i >> (level + 1);
+                if (block == blocks.size()) {
+                    blocks.push_back({value, value});
+                }
+                else {
+                    blocks[block].min = std::min(blocks[block].min, value);
+                    blocks[block].max = std::max(blocks[block].max, value);
+                }
+            }
+
+            // add new levels until the top level covers the whole series in one block
+            while (block_size(levels_.size()) < 2*values_.size()) {
+                levels_.push_back(build_next_level());
+            }
+        }
+
+        void append(std::span<const float> values)
+        {
+            values_.reserve(values_.size() + values.size());
+            for (float value : values) {
+                push_back(value);
+            }
+        }
+
+        // writes a decimated version of the series into `out` (clearing it first)
+        //
+        // the decimated series has at most `max_buckets` buckets (i.e. `2*max_buckets` points),
+        // regardless of the length of the series, where each bucket is written as two
+        // `(index, value)` points: one for the minimum value in the bucket (x: the first
+        // index in the bucket) and one for the maximum (x: the last index in the bucket).
+        // If the series has `max_buckets` or fewer values, then every value is written
+        // exactly (i.e. one `(index, value)` point per value)
+        void decimate(size_t max_buckets, std::vector<Vec2>& out) const
+        {
+            out.clear();
+
+            const size_t n = values_.size();
+            if (n == 0) {
+                return;
+            }
+
+            if (n <= std::max<size_t>(max_buckets, 1)) {
+                out.reserve(n);
+                for (size_t i = 0; i < n; ++i) {
+                    out.emplace_back(static_cast<float>(i), values_[i]);
+                }
+                return;
+            }
+
+            // pick the finest level that has at most `max_buckets` blocks
+            size_t level = 0;
+            while (level + 1 < levels_.size() and levels_[level].size() > max_buckets) {
+                ++level;
+            }
+
+            const size_t bs = block_size(level);
+            const std::vector<MinMax>& blocks = levels_[level];
+            out.reserve(2*blocks.size());
+            for (size_t block = 0; block < blocks.size(); ++block) {
+                const size_t first = block * bs;
+                const size_t last = std::min(first + bs, n) - 1;
+                out.emplace_back(static_cast<float>(first), blocks[block].min);
+                out.emplace_back(static_cast<float>(last), blocks[block].max);
+            }
+        }
+
+    private:
+        static constexpr size_t block_size(size_t level)
+        {
+            return size_t{2} << level;
+        }
+
+        // returns a new level that is built by merging pairs of blocks from the current top
+        // level (or values, if there are no levels yet)
+        std::vector<MinMax> build_next_level() const
+        {
+            std::vector<MinMax> rv;
+            if (levels_.empty()) {
+                rv.reserve((values_.size() + 1)/2);
+                for (size_t i = 0; i < values_.size(); i += 2) {
+                    const float a = values_[i];
+                    const float b = i + 1 < values_.size() ? values_[i + 1] : a;
+                    rv.push_back({std::min(a, b), std::max(a, b)});
+                }
+            }
+            else {
+                const std::vector<MinMax>& previous = levels_.back();
+                rv.reserve((previous.size() + 1)/2);
+                for (size_t i = 0; i < previous.size(); i += 2) {
+                    const MinMax a = previous[i];
+                    const MinMax b = i + 1 < previous.size() ? previous[i + 1] : a;
+                    rv.push_back({std::min(a.min, b.min), std::max(a.max, b.max)});
+                }
+            }
+            return rv;
+        }
+
+        std::vector<float> values_;
+        std::vector<std::vector<MinMax>> levels_;  // levels_[k] has a block size of `2^(k+1)`
+    };
+}
@@ -48,4 +48,11 @@ namespace osc
     {
         return is_in_front_of(to_analytic_plane(plane), aabb);
     }
+
+    // tests if `aabb` is entirely behind `plane`
+    inline bool is_behind(const AnalyticPlane& plane, const AABB& aabb)
+    {
+        const float r = dot(half_widths_of(aabb), abs(plane.normal));
+        return signed_distance_between(plane, centroid_of(aabb)) < -r;
+    }
 }
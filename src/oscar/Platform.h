@@ -19,6 +19,7 @@
 #include <oscar/Platform/LogMessage.h>
 #include <oscar/Platform/LogMessageView.h>
 #include <oscar/Platform/LogSink.h>
+#include <oscar/Platform/MemoryMappedFile.h>
 #include <oscar/Platform/os.h>
 #include <oscar/Platform/ResourceDirectoryEntry.h>
 #include <oscar/Platform/ResourceLoader.h>
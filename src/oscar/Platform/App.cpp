@@ -496,6 +496,11 @@ public:
         return graphics_context_.backend_shading_language_version_string();
     }
 
+    RenderStatistics graphics_backend_previous_frame_render_statistics() const
+    {
+        return graphics_context_.previous_frame_render_statistics();
+    }
+
     size_t num_frames_drawn() const
     {
         return frame_counter_;
@@ -983,6 +988,11 @@ std::string osc::App::graphics_backend_shading_language_version_string() const
     return impl_->graphics_backend_shading_language_version_string();
 }
 
+RenderStatistics osc::App::graphics_backend_previous_frame_render_statistics() const
+{
+    return impl_->graphics_backend_previous_frame_render_statistics();
+}
+
 size_t osc::App::num_frames_drawn() const
 {
     return impl_->num_frames_drawn();
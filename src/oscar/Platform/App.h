@@ -2,6 +2,7 @@
 
 #include <oscar/Graphics/AntiAliasingLevel.h>
 #include <oscar/Graphics/Color.h>
+#include <oscar/Graphics/RenderStatistics.h>
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Platform/AppClock.h>
 #include <oscar/Platform/AppMainLoopStatus.h>
@@ -221,6 +222,9 @@ namespace osc
         std::string graphics_backend_version_string() const;
         std::string graphics_backend_shading_language_version_string() const;
 
+        // returns statistics about what the graphics backend rendered during the previous frame
+        RenderStatistics graphics_backend_previous_frame_render_statistics() const;
+
         // returns the number of times this `App` has drawn a frame to the screen
         size_t num_frames_drawn() const;
 
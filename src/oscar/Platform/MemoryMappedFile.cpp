@@ -0,0 +1,180 @@
+#include "MemoryMappedFile.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+using namespace osc;
+
+namespace
+{
+    [[noreturn]] void throw_mapping_error(const std::filesystem::path& path, std::string_view reason)
+    {
+        std::stringstream ss;
+        ss << path.string() << ": cannot memory-map file: " << reason;
+        throw std::runtime_error{std::move(ss).str()};
+    }
+}
+
+#if defined(EMSCRIPTEN)
+
+#include <fstream>
+#include <vector>
+
+// emscripten: there's no memory-mapping, so read the whole file into memory
+class osc::MemoryMappedFile::Impl final {
+public:
+    explicit Impl(const std::filesystem::path& path)
+    {
+        std::ifstream in{path, std::ios::binary};
+        if (not in) {
+            throw_mapping_error(path, "cannot open file");
+        }
+        in.seekg(0, std::ios::end);
+        data_.resize(static_cast<size_t>(in.tellg()));
+        in.seekg(0, std::ios::beg);
+        in.read(reinterpret_cast<char*>(data_.data()), static_cast<std::streamsize>(data_.size()));
+    }
+
+    std::span<const std::byte> bytes() const { return data_; }
+
+private:
+    std::vector<std::byte> data_;
+};
+
+#elif defined(WIN32)
+
+#include <Windows.h>  // CreateFileW, GetFileSizeEx, CreateFileMappingW, MapViewOfFile, UnmapViewOfFile, CloseHandle
+
+class osc::MemoryMappedFile::Impl final {
+public:
+    explicit Impl(const std::filesystem::path& path)
+    {
+        file_handle_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_handle_ == INVALID_HANDLE_VALUE) {
+            throw_mapping_error(path, "cannot open file");
+        }
+
+        LARGE_INTEGER size;
+        if (not GetFileSizeEx(file_handle_, &size)) {
+            CloseHandle(file_handle_);
+            throw_mapping_error(path, "cannot get file size");
+        }
+        size_ = static_cast<size_t>(size.QuadPart);
+
+        if (size_ == 0) {
+            return;  // windows can't map empty files, and there's nothing to map anyway
+        }
+
+        mapping_handle_ = CreateFileMappingW(file_handle_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_handle_ == nullptr) {
+            CloseHandle(file_handle_);
+            throw_mapping_error(path, "CreateFileMappingW failed");
+        }
+
+        data_ = MapViewOfFile(mapping_handle_, FILE_MAP_READ, 0, 0, 0);
+        if (data_ == nullptr) {
+            CloseHandle(mapping_handle_);
+            CloseHandle(file_handle_);
+            throw_mapping_error(path, "MapViewOfFile failed");
+        }
+    }
+    Impl(const Impl&) = delete;
+    Impl(Impl&&) noexcept = delete;
+    Impl& operator=(const Impl&) = delete;
+    Impl& operator=(Impl&&) noexcept = delete;
+    ~Impl() noexcept
+    {
+        if (data_) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_handle_) {
+            CloseHandle(mapping_handle_);
+        }
+        CloseHandle(file_handle_);
+    }
+
+    std::span<const std::byte> bytes() const { return {static_cast<const std::byte*>(data_), size_}; }
+
+private:
+    HANDLE file_handle_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_handle_ = nullptr;
+    void* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class osc::MemoryMappedFile::Impl final {
+public:
+    explicit Impl(const std::filesystem::path& path)
+    {
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw_mapping_error(path, "cannot open file");
+        }
+
+        struct stat st{};
+        if (fstat(fd, &st) == -1) {
+            close(fd);
+            throw_mapping_error(path, "cannot stat file");
+        }
+        size_ = static_cast<size_t>(st.st_size);
+
+        if (size_ > 0) {  // `mmap`ing zero bytes is an error
+            data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);  // the mapping (if any) keeps the file alive
+
+        if (data_ == MAP_FAILED) {
+            throw_mapping_error(path, "mmap failed");
+        }
+    }
+    Impl(const Impl&) = delete;
+    Impl(Impl&&) noexcept = delete;
+    Impl& operator=(const Impl&) = delete;
+    Impl& operator=(Impl&&) noexcept = delete;
+    ~Impl() noexcept
+    {
+        if (data_ != nullptr and data_ != MAP_FAILED) {
+            munmap(data_, size_);
+        }
+    }
+
+    std::span<const std::byte> bytes() const
+    {
+        if (data_ == nullptr) {
+            return {};
+        }
+        return {static_cast<const std::byte*>(data_), size_};
+    }
+
+private:
+    void* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+#endif
+
+osc::MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& path) :
+    impl_{std::make_unique<Impl>(path)}
+{}
+osc::MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&&) noexcept = default;
+osc::MemoryMappedFile& osc::MemoryMappedFile::operator=(MemoryMappedFile&&) noexcept = default;
+osc::MemoryMappedFile::~MemoryMappedFile() noexcept = default;
+
+std::span<const std::byte> osc::MemoryMappedFile::bytes() const
+{
+    return impl_->bytes();
+}
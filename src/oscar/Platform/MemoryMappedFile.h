@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+namespace osc
+{
+    // a read-only view of a file's contents that is memory-mapped by the operating
+    // system, so that the contents are only paged into memory when they're accessed
+    //
+    // on platforms that don't support memory-mapping (e.g. emscripten), the file's
+    // contents are read into memory by the constructor
+    class MemoryMappedFile final {
+    public:
+        // throws if the file cannot be opened or mapped into memory
+        explicit MemoryMappedFile(const std::filesystem::path&);
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile(MemoryMappedFile&&) noexcept;
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator=(MemoryMappedFile&&) noexcept;
+        ~MemoryMappedFile() noexcept;
+
+        // returns the (mapped) contents of the file
+        //
+        // the returned span is valid for the lifetime of the `MemoryMappedFile`
+        std::span<const std::byte> bytes() const;
+
+        size_t size() const { return bytes().size(); }
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> impl_;
+    };
+}
@@ -1,5 +1,6 @@
 #include "PerfPanel.h"
 
+#include <oscar/Graphics/RenderStatistics.h>
 #include <oscar/Platform/App.h>
 #include <oscar/UI/oscimgui.h>
 #include <oscar/UI/Panels/StandardPanelImpl.h>
@@ -31,6 +32,21 @@ private:
         ui::next_column();
         ui::draw_text("%.0f", static_cast<double>(ui::get_framerate()));
         ui::next_column();
+        {
+            const RenderStatistics statistics = App::get().graphics_backend_previous_frame_render_statistics();
+            ui::draw_text_unformatted("render objects");
+            ui::next_column();
+            ui::draw_text("%zu", statistics.num_render_objects);
+            ui::next_column();
+            ui::draw_text_unformatted("batches");
+            ui::next_column();
+            ui::draw_text("%zu", statistics.num_batches);
+            ui::next_column();
+            ui::draw_text_unformatted("draw calls");
+            ui::next_column();
+            ui::draw_text("%zu", statistics.num_draw_calls);
+            ui::next_column();
+        }
         ui::set_num_columns();
 
         {
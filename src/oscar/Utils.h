@@ -33,6 +33,7 @@
 #include <oscar/Utils/SharedLifetimeBlock.h>
 #include <oscar/Utils/SharedPreHashedString.h>
 #include <oscar/Utils/Spsc.h>
+#include <oscar/Utils/SpscRingBuffer.h>
 #include <oscar/Utils/StdVariantHelpers.h>
 #include <oscar/Utils/StringHelpers.h>
 #include <oscar/Utils/StringName.h>
@@ -40,6 +41,7 @@
 #include <oscar/Utils/SynchronizedValueGuard.h>
 #include <oscar/Utils/TemporaryFile.h>
 #include <oscar/Utils/TemporaryFileParameters.h>
+#include <oscar/Utils/ThreadPool.h>
 #include <oscar/Utils/TransparentStringHasher.h>
 #include <oscar/Utils/Typelist.h>
 #include <oscar/Utils/UID.h>
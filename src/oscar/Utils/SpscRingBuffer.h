@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace osc
+{
+    // a bounded, lock-free, single-producer single-consumer (sp-sc) ring buffer
+    //
+    // - exactly one thread may call the producer-side methods (`try_push`)
+    // - exactly one (other) thread may call the consumer-side methods (`try_pop`, `drain`)
+    // - `size_approx`, `capacity`, and `empty_approx` may be called from any thread
+    //
+    // the ring never allocates after construction, so it's suitable for handing data
+    // from (e.g.) a simulator thread to a UI thread without either side blocking the
+    // other. It's up to the producer to decide what to do when the ring is full (e.g.
+    // apply backpressure by retrying, or drop the element)
+    template<std::movable T>
+    class SpscRingBuffer final {
+    public:
+        explicit SpscRingBuffer(size_t capacity) :
+            slots_(capacity + 1)  // +1, so that `head == tail` unambiguously means "empty"
+        {
+            if (capacity == 0) {
+                throw std::invalid_argument{"an SpscRingBuffer must have a capacity of at least one element"};
+            }
+        }
+        SpscRingBuffer(const SpscRingBuffer&) = delete;
+        SpscRingBuffer(SpscRingBuffer&&) noexcept = delete;
+        SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+        SpscRingBuffer& operator=(SpscRingBuffer&&) noexcept = delete;
+        ~SpscRingBuffer() noexcept = default;
+
+        size_t capacity() const { return slots_.size() - 1; }
+
+        // returns the number of elements in the ring at some point during the call
+        size_t size_approx() const
+        {
+            const size_t tail = tail_.load(std::memory_order_acquire);
+            const size_t head = head_.load(std::memory_order_acquire);
+            return tail >= head ? tail - head : slots_.size() - (head - tail);
+        }
+
+        bool empty_approx() const { return size_approx() == 0; }
+
+        // (producer) tries to push `value` into the ring
+        //
+        // returns `false`, and leaves `value` untouched, if the ring is full
+        bool try_push(T&& value)
+        {
+            const size_t tail = tail_.load(std::memory_order_relaxed);
+            const size_t next = increment(tail);
+            if (next == head_.load(std::memory_order_acquire)) {
+                return false;  // full
+            }
+            slots_[tail].emplace(std::move(value));
+            tail_.store(next, std::memory_order_release);
+            return true;
+        }
+
+        // (consumer) tries to pop the oldest element from the ring
+        std::optional<T> try_pop()
+        {
+            const size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) {
+                return std::nullopt;  // empty
+            }
+            std::optional<T> rv = std::move(slots_[head]);
+            slots_[head].reset();
+            head_.store(increment(head), std::memory_order_release);
+            return rv;
+        }
+
+        // (consumer) pops every element that's currently in the ring, oldest first, into `consumer`
+        //
+        // elements that are pushed while draining aren't guaranteed to be popped by the
+        // same call. Returns the number of elements that were popped
+        template<std::invocable<T&&> Consumer>
+        size_t drain(Consumer&& consumer)
+        {
+            size_t head = head_.load(std::memory_order_relaxed);
+            const size_t tail = tail_.load(std::memory_order_acquire);
+
+            size_t n = 0;
+            while (head != tail) {
+                consumer(std::move(*slots_[head]));
+                slots_[head].reset();
+                head = increment(head);
+                head_.store(head, std::memory_order_release);  // release each slot ASAP, so the producer can make progress
+                ++n;
+            }
+            return n;
+        }
+
+    private:
+        size_t increment(size_t i) const
+        {
+            return i + 1 == slots_.size() ? 0 : i + 1;
+        }
+
+        std::vector<std::optional<T>> slots_;
+        alignas(64) std::atomic<size_t> head_ = 0;  // next slot the consumer reads
+        alignas(64) std::atomic<size_t> tail_ = 0;  // next slot the producer writes
+    };
+}
@@ -0,0 +1,239 @@
+#include "ThreadPool.h"
+
+#include <oscar/Shims/Cpp20/stop_token.h>
+#include <oscar/Shims/Cpp20/thread.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // the maximum number of chunks per thread in `for_each_chunk`, so that threads that finish
+    // their chunks early can pick up some of the remaining work
+    constexpr size_t c_max_chunks_per_thread = 4;
+
+    // the shared state of one `for_each_chunk` call
+    //
+    // chunks are claimed via an atomic counter, so that the calling thread can execute all of
+    // them if the workers are busy (e.g. because `for_each_chunk` was called from a worker)
+    //
+    // `[0, n)` is split into `num_chunks` chunks whose sizes differ by at most one element
+    // (the first `n % num_chunks` chunks are one element larger), so that every chunk is
+    // non-empty and at least `n / num_chunks` elements long. Rounding the chunk size up
+    // instead (i.e. `ceil(n / num_chunks)`) can leave the trailing chunks empty, or even
+    // past the end of the range (e.g. `n = 29` in 7 chunks of 5)
+    class ChunkedLoop final {
+    public:
+        ChunkedLoop(size_t n, size_t num_chunks, const std::function<void(size_t, size_t)>& f) :
+            num_chunks_{num_chunks},
+            min_chunk_size_{n / num_chunks},
+            num_larger_chunks_{n % num_chunks},
+            f_{&f}
+        {}
+
+        // executes the next unclaimed chunk, returns `false` if all chunks were already claimed
+        bool try_execute_next_chunk()
+        {
+            const size_t chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= num_chunks_) {
+                return false;
+            }
+
+            std::exception_ptr exception;
+            try {
+                const size_t first = chunk * min_chunk_size_ + std::min(chunk, num_larger_chunks_);
+                const size_t size = min_chunk_size_ + (chunk < num_larger_chunks_ ? 1 : 0);
+                (*f_)(first, first + size);
+            }
+            catch (...) {
+                exception = std::current_exception();
+            }
+
+            bool all_completed = false;
+            {
+                const std::lock_guard lock{mutex_};
+                if (exception and not first_exception_) {
+                    first_exception_ = std::move(exception);
+                }
+                all_completed = ++num_completed_ == num_chunks_;
+            }
+            if (all_completed) {
+                condition_variable_.notify_all();
+            }
+            return true;
+        }
+
+        // blocks until all chunks have been executed, and then rethrows the first exception (if any)
+        void wait()
+        {
+            std::unique_lock lock{mutex_};
+            condition_variable_.wait(lock, [this]() { return num_completed_ == num_chunks_; });
+            if (first_exception_) {
+                std::rethrow_exception(first_exception_);
+            }
+        }
+
+    private:
+        size_t num_chunks_;
+        size_t min_chunk_size_;
+        size_t num_larger_chunks_;
+        const std::function<void(size_t, size_t)>* f_;  // only dereferenced while a chunk is unfinished
+        std::atomic<size_t> next_chunk_ = 0;
+        std::mutex mutex_;
+        std::condition_variable condition_variable_;
+        size_t num_completed_ = 0;
+        std::exception_ptr first_exception_;
+    };
+}
+
+class osc::ThreadPool::Impl final {
+public:
+    explicit Impl(size_t num_workers)
+    {
+        threads_.reserve(num_workers);
+        for (size_t i = 0; i < num_workers; ++i) {
+            threads_.emplace_back([this](cpp20::stop_token stop_token) { worker_main(stop_token); });
+        }
+    }
+    Impl(const Impl&) = delete;
+    Impl(Impl&&) noexcept = delete;
+    Impl& operator=(const Impl&) = delete;
+    Impl& operator=(Impl&&) noexcept = delete;
+    ~Impl() noexcept
+    {
+        // the workers might be waiting for work, so they have to be woken up to see
+        // the stop request (the `jthread`s then join them)
+        for (cpp20::jthread& thread : threads_) {
+            thread.request_stop();
+        }
+        {
+            const std::lock_guard lock{mutex_};
+        }
+        condition_variable_.notify_all();
+        threads_.clear();
+    }
+
+    size_t num_workers() const { return threads_.size(); }
+
+    void for_each_chunk(size_t n, size_t min_chunk_size, const std::function<void(size_t, size_t)>& f)
+    {
+        if (n == 0) {
+            return;
+        }
+
+        const size_t max_chunks = c_max_chunks_per_thread * (threads_.size() + 1);
+        const size_t num_chunks = std::clamp<size_t>(n / std::max<size_t>(min_chunk_size, 1), 1, max_chunks);
+        if (num_chunks == 1) {
+            f(0, n);  // (not worth parallelizing)
+            return;
+        }
+
+        const auto loop = std::make_shared<ChunkedLoop>(n, num_chunks, f);
+        {
+            const std::lock_guard lock{mutex_};
+            const size_t num_helpers = std::min(num_chunks - 1, threads_.size());
+            for (size_t i = 0; i < num_helpers; ++i) {
+                jobs_.emplace_back([loop]() { while (loop->try_execute_next_chunk()) {} });
+            }
+        }
+        condition_variable_.notify_all();
+
+        while (loop->try_execute_next_chunk()) {}
+        loop->wait();
+    }
+
+    void submit(std::function<void()> f)
+    {
+        if (threads_.empty()) {
+            run_job(f);
+            return;
+        }
+
+        {
+            const std::lock_guard lock{mutex_};
+            jobs_.push_back(std::move(f));
+        }
+        condition_variable_.notify_one();
+    }
+
+private:
+    static void run_job(const std::function<void()>& job)
+    {
+        try {
+            job();
+        }
+        catch (...) {
+            // ignored: see `ThreadPool::submit` (`for_each_chunk`'s jobs don't throw)
+        }
+    }
+
+    void worker_main(const cpp20::stop_token& stop_token)
+    {
+        while (std::optional<std::function<void()>> job = wait_for_next_job(stop_token)) {
+            run_job(*job);
+        }
+    }
+
+    // blocks until there's a job to run (returns it), or a stop is requested (returns `std::nullopt`)
+    std::optional<std::function<void()>> wait_for_next_job(const cpp20::stop_token& stop_token)
+    {
+        std::unique_lock lock{mutex_};
+        while (not stop_token.stop_requested()) {
+            if (not jobs_.empty()) {
+                std::function<void()> job = std::move(jobs_.front());
+                jobs_.pop_front();
+                return job;
+            }
+            condition_variable_.wait(lock);
+        }
+        return std::nullopt;
+    }
+
+    std::mutex mutex_;
+    std::condition_variable condition_variable_;
+    std::deque<std::function<void()>> jobs_;
+    std::vector<cpp20::jthread> threads_;
+};
+
+ThreadPool& osc::ThreadPool::global()
+{
+    static ThreadPool s_global_pool{std::max(std::thread::hardware_concurrency(), 1u) - 1};
+    return s_global_pool;
+}
+
+osc::ThreadPool::ThreadPool(size_t num_workers) :
+    impl_{std::make_unique<Impl>(num_workers)}
+{}
+
+osc::ThreadPool::~ThreadPool() noexcept = default;
+
+size_t osc::ThreadPool::num_workers() const
+{
+    return impl_->num_workers();
+}
+
+void osc::ThreadPool::for_each_chunk(
+    size_t n,
+    size_t min_chunk_size,
+    const std::function<void(size_t, size_t)>& f)
+{
+    impl_->for_each_chunk(n, min_chunk_size, f);
+}
+
+void osc::ThreadPool::submit(std::function<void()> f)
+{
+    impl_->submit(std::move(f));
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace osc
+{
+    // a fixed-size pool of persistent worker threads
+    //
+    // this is for hot, data-parallel, loops that are called repeatedly (e.g. per frame), where
+    // spawning new threads for each call (e.g. via `for_each_parallel_unsequenced`) costs more
+    // than the work that's being parallelized
+    class ThreadPool final {
+    public:
+        // returns a process-wide pool that has one worker per hardware thread, minus one,
+        // because the calling thread also executes chunks in `for_each_chunk`
+        static ThreadPool& global();
+
+        explicit ThreadPool(size_t num_workers);
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) noexcept = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool& operator=(ThreadPool&&) noexcept = delete;
+        ~ThreadPool() noexcept;
+
+        size_t num_workers() const;
+
+        // calls `f(first, last)` for non-overlapping, contiguous, chunks of `[0, n)` that each
+        // contain at least `min_chunk_size` elements (unless `n` is smaller than that)
+        //
+        // the chunks are executed by the pool's workers and the calling thread. Blocks until all
+        // chunks have been executed, and then rethrows the first exception that `f` threw (if any)
+        void for_each_chunk(
+            size_t n,
+            size_t min_chunk_size,
+            const std::function<void(size_t, size_t)>& f
+        );
+
+        // enqueues `f` to be called on one of the pool's workers, without waiting for it
+        //
+        // jobs are started in submission order. Jobs that haven't started when the pool is
+        // destroyed are dropped, so `f` shouldn't own anything that must be released by it
+        // running. Exceptions that escape `f` are ignored, so `f` should handle its own errors.
+        // If the pool has no workers, `f` is called on the calling thread.
+        //
+        // long-running jobs occupy workers that `for_each_chunk` could otherwise use (its
+        // calling thread still executes any chunks that the workers don't pick up)
+        void submit(std::function<void()> f);
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> impl_;
+    };
+}
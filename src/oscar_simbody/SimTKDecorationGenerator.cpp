@@ -4,6 +4,7 @@
 #include <oscar_simbody/SimTKHelpers.h>
 
 #include <oscar/Graphics/Color.h>
+#include <oscar/Graphics/Mesh.h>
 #include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Graphics/Scene/SceneDecoration.h>
 #include <oscar/Graphics/Scene/SceneHelpers.h>
@@ -21,6 +22,8 @@
 
 #include <cstddef>
 #include <filesystem>
+#include <string>
+#include <utility>
 
 using namespace osc;
 
@@ -120,13 +123,15 @@ namespace
             const SimTK::SimbodyMatterSubsystem& matter,
             const SimTK::State& st,
             float fixupScaleFactor,
-            const std::function<void(SceneDecoration&&)>& out) :
+            const std::function<void(SceneDecoration&&)>& out,
+            SceneCachePendingMeshes* pendingMeshes) :
 
             m_MeshCache{meshCache},
             m_Matter{matter},
             m_State{st},
             m_FixupScaleFactor{fixupScaleFactor},
-            m_Consumer{out}
+            m_Consumer{out},
+            m_PendingMeshes{pendingMeshes}
         {
         }
 
@@ -318,10 +323,20 @@ namespace
         void implementMeshFileGeometry(const SimTK::DecorativeMeshFile& d) final
         {
             const std::string& path = d.getMeshFile();
-            const auto meshLoader = [&d](){ return ToOscMesh(d.getMesh()); };
+
+            Mesh mesh;
+            if (m_PendingMeshes) {
+                mesh = m_MeshCache.get_mesh_file_async(path, LoadMeshFile, *m_PendingMeshes);
+                if (mesh.num_vertices() == 0) {
+                    return;  // still loading: emit it once it has loaded
+                }
+            }
+            else {
+                mesh = m_MeshCache.get_mesh_file(path, LoadMeshFile);
+            }
 
             m_Consumer(SceneDecoration{
-                .mesh = m_MeshCache.get_mesh(path, meshLoader),
+                .mesh = std::move(mesh),
                 .transform = ToOscTransform(d),
                 .shading = GetColor(d),
                 .flags = GetFlags(d),
@@ -385,6 +400,7 @@ namespace
         const SimTK::State& m_State;
         float m_FixupScaleFactor;
         const std::function<void(SceneDecoration&&)>& m_Consumer;
+        SceneCachePendingMeshes* m_PendingMeshes;
     };
 }
 
@@ -394,8 +410,9 @@ void osc::GenerateDecorations(
     const SimTK::State& state,
     const SimTK::DecorativeGeometry& geom,
     float fixupScaleFactor,
-    const std::function<void(SceneDecoration&&)>& out)
+    const std::function<void(SceneDecoration&&)>& out,
+    SceneCachePendingMeshes* pendingMeshes)
 {
-    GeometryImpl impl{meshCache, matter, state, fixupScaleFactor, out};
+    GeometryImpl impl{meshCache, matter, state, fixupScaleFactor, out, pendingMeshes};
     geom.implementGeometry(impl);
 }
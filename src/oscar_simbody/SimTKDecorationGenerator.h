@@ -3,6 +3,7 @@
 #include <functional>
 
 namespace osc { class SceneCache; }
+namespace osc { class SceneCachePendingMeshes; }
 namespace osc { struct SceneDecoration; }
 namespace SimTK { class DecorativeGeometry; }
 namespace SimTK { class SimbodyMatterSubsystem; }
@@ -12,12 +13,17 @@ namespace osc
 {
     // generates `SceneDecoration`s for the given `SimTK::DecorativeGeometry`
     // and passes them to the output consumer
+    //
+    // if `pendingMeshes` isn't `nullptr`, mesh files that aren't already in the `SceneCache`
+    // are loaded in the background (see `SceneCache::get_mesh_async`), added to `pendingMeshes`,
+    // and aren't emitted until they have loaded
     void GenerateDecorations(
         SceneCache&,
         const SimTK::SimbodyMatterSubsystem&,
         const SimTK::State&,
         const SimTK::DecorativeGeometry&,
         float fixupScaleFactor,
-        const std::function<void(SceneDecoration&&)>& out
+        const std::function<void(SceneDecoration&&)>& out,
+        SceneCachePendingMeshes* pendingMeshes = nullptr
     );
 }
@@ -4,6 +4,8 @@
 
 #include <SimTKcommon/internal/DecorativeGeometry.h>
 #include <SimTKcommon/internal/PolygonalMesh.h>
+#include <oscar/Formats/MeshFile.h>
+#include <oscar/Formats/MeshLoadingFlags.h>
 #include <oscar/Graphics/Mesh.h>
 #include <oscar/Graphics/MeshTopology.h>
 #include <oscar/Graphics/VertexAttribute.h>
@@ -13,23 +15,22 @@
 #include <oscar/Maths/Triangle.h>
 #include <oscar/Maths/TriangleFunctions.h>
 #include <oscar/Maths/Vec3.h>
+#include <oscar/Platform/Log.h>
 #include <oscar/Utils/Assertions.h>
 
-#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <filesystem>
 #include <ranges>
 #include <string_view>
 #include <vector>
 
 using namespace osc;
-using namespace std::literals;
 namespace rgs = std::ranges;
 
 namespace
 {
-    constexpr auto c_supported_mesh_extensions = std::to_array({"obj"sv, "vtp"sv, "stl"sv, "stla"sv});
-
     struct OutputMeshMetrics {
         size_t numVertices = 0;
         size_t numIndices = 0;
@@ -156,7 +157,7 @@ Mesh osc::ToOscMesh(const SimTK::PolygonalMesh& mesh)
 
 std::span<const std::string_view> osc::GetSupportedSimTKMeshFormats()
 {
-    return c_supported_mesh_extensions;
+    return supported_mesh_file_extensions();
 }
 
 Mesh osc::LoadMeshViaSimTK(const std::filesystem::path& p)
@@ -166,6 +167,25 @@ Mesh osc::LoadMeshViaSimTK(const std::filesystem::path& p)
     return ToOscMesh(mesh);
 }
 
+Mesh osc::LoadMeshFile(const std::filesystem::path& p)
+{
+    if (not is_supported_mesh_file(p)) {
+        return LoadMeshViaSimTK(p);
+    }
+
+    // SimTK merges the (unindexed) vertices of STL files, so do the same, so that the
+    // resulting normals are smoothed in the same way
+    const MeshLoadingFlags flags = is_stl_mesh_file(p) ? MeshLoadingFlag::WeldVertices : MeshLoadingFlag::None;
+
+    try {
+        return load_mesh_file(p, flags);
+    }
+    catch (const std::exception& ex) {
+        log_warn("%s: falling back to loading the mesh via SimTK", ex.what());
+        return LoadMeshViaSimTK(p);
+    }
+}
+
 void osc::AssignIndexedVerts(SimTK::PolygonalMesh& mesh, std::span<const Vec3> vertices, MeshIndicesView indices)
 {
     mesh.clear();
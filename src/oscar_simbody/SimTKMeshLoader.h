@@ -22,6 +22,13 @@ namespace osc
     // returns an `Mesh` loaded from disk via SimTK's APIs
     Mesh LoadMeshViaSimTK(const std::filesystem::path&);
 
+    // returns an `Mesh` loaded from disk via oscar's (faster) native mesh readers, falling
+    // back to `LoadMeshViaSimTK` if the native readers can't read the file
+    //
+    // the returned mesh is equivalent to the one that `LoadMeshViaSimTK` returns (e.g. STL
+    // vertices are welded, normals are calculated from the triangles)
+    Mesh LoadMeshFile(const std::filesystem::path&);
+
     // populate the `SimTK::PolygonalMesh` from the given indexed mesh data
     void AssignIndexedVerts(SimTK::PolygonalMesh&, std::span<const Vec3>, MeshIndicesView);
 }
@@ -3,16 +3,30 @@
 #include <oscar_simbody/SimTKHelpers.h>
 
 #include <Simbody.h>
+#include <oscar/Maths/CommonFunctions.h>
+#include <oscar/Maths/GeometricFunctions.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/VecFunctions.h>
 #include <oscar/Maths/Vec3.h>
+#include <oscar/Platform/Log.h>
 #include <oscar/Utils/Algorithms.h>
-#include <oscar/Utils/ParalellizationHelpers.h>
+#include <oscar/Utils/Assertions.h>
 #include <oscar/Utils/Perf.h>
+#include <oscar/Utils/ThreadPool.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <ranges>
 #include <span>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 using namespace osc;
@@ -35,6 +49,1015 @@ namespace
 
         return length(controlPoint - p);
     }
+
+    // the number of points that `EvaluateTPSEquationLanes` evaluates at once
+    //
+    // the kernel is written as plain loops over fixed-size arrays of lanes (rather than with
+    // intrinsics) so that the compiler can vectorize it for whichever instruction set is being
+    // targeted (SSE, AVX2, NEON, etc.): 8 lanes fill an AVX2 register with `float`s
+    constexpr size_t c_NumTPSLanes = 8;
+
+    // the minimum number of points that a thread evaluates in `ApplyThinPlateWarpToPointsInPlace`
+    constexpr size_t c_MinPointsPerThread = 512;
+
+    using TPSLanes = std::array<float, c_NumTPSLanes>;
+    using TPSAccumulatorLanes = std::array<double, c_NumTPSLanes>;
+
+    // loads up to `c_NumTPSLanes` points into lanes (unused lanes duplicate the last point)
+    void LoadTPSLanes(std::span<const Vec3> points, TPSLanes& px, TPSLanes& py, TPSLanes& pz)
+    {
+        for (size_t lane = 0; lane < c_NumTPSLanes; ++lane) {
+            const Vec3& p = points[std::min(lane, points.size() - 1)];
+            px[lane] = p.x;
+            py[lane] = p.y;
+            pz[lane] = p.z;
+        }
+    }
+
+    // accumulates `wi * U(||controlPoint_i - p||)` for each term `i` into each lane's accumulators
+    //
+    // `Weight` is `float` when evaluating a warp, and `double` when the solver is multiplying a
+    // vector by the TPS system's kernel matrix (`K`)
+    template<typename Weight>
+    void AccumulateNonAffineTermsLanes(
+        const TPSLanes& px,
+        const TPSLanes& py,
+        const TPSLanes& pz,
+        std::span<const float> controlPointsX,
+        std::span<const float> controlPointsY,
+        std::span<const float> controlPointsZ,
+        std::span<const Weight> weightsX,
+        std::span<const Weight> weightsY,
+        std::span<const Weight> weightsZ,
+        TPSAccumulatorLanes& rx,
+        TPSAccumulatorLanes& ry,
+        TPSAccumulatorLanes& rz)
+    {
+        const size_t numTerms = controlPointsX.size();
+        const float* const cxs = controlPointsX.data();
+        const float* const cys = controlPointsY.data();
+        const float* const czs = controlPointsZ.data();
+        const Weight* const wxs = weightsX.data();
+        const Weight* const wys = weightsY.data();
+        const Weight* const wzs = weightsZ.data();
+        for (size_t i = 0; i < numTerms; ++i) {
+            const float cx = cxs[i];
+            const float cy = cys[i];
+            const float cz = czs[i];
+            const Weight wx = wxs[i];
+            const Weight wy = wys[i];
+            const Weight wz = wzs[i];
+            for (size_t lane = 0; lane < c_NumTPSLanes; ++lane) {
+                const float dx = cx - px[lane];
+                const float dy = cy - py[lane];
+                const float dz = cz - pz[lane];
+                const float u = std::sqrt(dx*dx + dy*dy + dz*dz);  // RadialBasisFunction3D
+                rx[lane] += wx*u;
+                ry[lane] += wy*u;
+                rz[lane] += wz*u;
+            }
+        }
+    }
+
+    // evaluates the TPS equation for up to `c_NumTPSLanes` points at once
+    //
+    // this performs the same arithmetic, in the same order, as the single-point
+    // `EvaluateTPSEquation`, but with each point in its own lane
+    void EvaluateTPSEquationLanes(
+        const TPSCoefficientsSoA3D& coefs,
+        std::span<const Vec3> points,
+        std::span<Vec3> out)
+    {
+        TPSLanes px{};
+        TPSLanes py{};
+        TPSLanes pz{};
+        LoadTPSLanes(points, px, py, pz);
+
+        // compute affine terms (a1 + a2*x + a3*y + a4*z)
+        TPSAccumulatorLanes rx{};
+        TPSAccumulatorLanes ry{};
+        TPSAccumulatorLanes rz{};
+        for (size_t lane = 0; lane < c_NumTPSLanes; ++lane) {
+            rx[lane] = static_cast<double>(coefs.a1.x) + static_cast<double>(coefs.a2.x*px[lane]) + static_cast<double>(coefs.a3.x*py[lane]) + static_cast<double>(coefs.a4.x*pz[lane]);
+            ry[lane] = static_cast<double>(coefs.a1.y) + static_cast<double>(coefs.a2.y*px[lane]) + static_cast<double>(coefs.a3.y*py[lane]) + static_cast<double>(coefs.a4.y*pz[lane]);
+            rz[lane] = static_cast<double>(coefs.a1.z) + static_cast<double>(coefs.a2.z*px[lane]) + static_cast<double>(coefs.a3.z*py[lane]) + static_cast<double>(coefs.a4.z*pz[lane]);
+        }
+
+        // accumulate non-affine terms (effectively: wi * U(||controlPoint - p||))
+        AccumulateNonAffineTermsLanes<float>(
+            px, py, pz,
+            coefs.controlPointsX, coefs.controlPointsY, coefs.controlPointsZ,
+            coefs.weightsX, coefs.weightsY, coefs.weightsZ,
+            rx, ry, rz
+        );
+
+        for (size_t lane = 0; lane < points.size(); ++lane) {
+            out[lane] = Vec3{static_cast<float>(rx[lane]), static_cast<float>(ry[lane]), static_cast<float>(rz[lane])};
+        }
+    }
+
+    // returns the dot product of `a` and `b`
+    //
+    // (this uses independent accumulators, so that the compiler can vectorize it without
+    // having to reassociate floating-point additions)
+    double DotProduct(std::span<const double> a, std::span<const double> b)
+    {
+        constexpr size_t c_NumAccumulators = 4;
+        std::array<double, c_NumAccumulators> accumulators{};
+        const size_t n = a.size();
+        size_t i = 0;
+        for (; i + c_NumAccumulators <= n; i += c_NumAccumulators) {
+            for (size_t lane = 0; lane < c_NumAccumulators; ++lane) {
+                accumulators[lane] += a[i + lane] * b[i + lane];
+            }
+        }
+        double rv = (accumulators[0] + accumulators[1]) + (accumulators[2] + accumulators[3]);
+        for (; i < n; ++i) {
+            rv += a[i] * b[i];
+        }
+        return rv;
+    }
+
+    // the QR decomposition of the `P` part of matrix `L` (see `CalcCoefficients`), which is an
+    // Nx4 matrix that has one `[1 x y z]` row per landmark source
+    //
+    // the orthogonal `Q` is stored as 4 Householder reflectors, so that it can be applied in O(N)
+    // time. The last N-4 columns of `Q` are a basis for the null space of `PT`, which is what the
+    // `Symmetric` and `Iterative` solvers project the TPS system onto
+    class AffineConstraintsQR final {
+    public:
+        explicit AffineConstraintsQR(std::span<const LandmarkPair3D> landmarks) :
+            m_NumRows{landmarks.size()}
+        {
+            OSC_ASSERT(m_NumRows >= 4 && "the QR decomposition requires at least as many rows as columns");
+
+            std::array<std::vector<double>, 4> columns;
+            for (std::vector<double>& column : columns) {
+                column.reserve(m_NumRows);
+            }
+            for (const LandmarkPair3D& landmark : landmarks) {
+                columns[0].push_back(1.0);
+                columns[1].push_back(landmark.source.x);
+                columns[2].push_back(landmark.source.y);
+                columns[3].push_back(landmark.source.z);
+            }
+            for (size_t col = 0; col < 4; ++col) {
+                m_ColumnNorms[col] = std::sqrt(DotProduct(columns[col], columns[col]));
+            }
+
+            for (size_t k = 0; k < 4; ++k) {
+                // compute the reflector that zeroes everything below the diagonal in column `k`
+                const std::span<const double> belowDiagonal = std::span{columns[k]}.subspan(k);
+                const double norm = std::sqrt(DotProduct(belowDiagonal, belowDiagonal));
+                const double alpha = belowDiagonal.front() >= 0.0 ? -norm : norm;
+
+                std::vector<double>& reflector = m_Reflectors[k];
+                reflector.assign(m_NumRows, 0.0);
+                std::copy(belowDiagonal.begin(), belowDiagonal.end(), reflector.begin() + static_cast<ptrdiff_t>(k));
+                reflector[k] -= alpha;
+                const double reflectorNorm2 = DotProduct(reflector, reflector);
+                m_ReflectorScales[k] = reflectorNorm2 > 0.0 ? 2.0/reflectorNorm2 : 0.0;
+
+                for (size_t col = k; col < 4; ++col) {
+                    ApplyReflector<double>(k, columns[col]);
+                    m_R[k][col] = columns[col][k];
+                }
+            }
+        }
+
+        // returns `true` if `P` has full (column) rank, which is required by the projection
+        //
+        // it doesn't if (e.g.) there are fewer than 4 landmarks, or all landmarks are coplanar
+        bool HasFullRank() const
+        {
+            constexpr double c_RelativeTolerance = 1e-9;
+            for (size_t k = 0; k < 4; ++k) {
+                if (not (std::abs(m_R[k][k]) > c_RelativeTolerance * m_ColumnNorms[k])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // `x = QT * x`
+        template<typename T>
+        void ApplyQT(std::span<T> x) const
+        {
+            for (size_t k = 0; k < 4; ++k) {
+                ApplyReflector(k, x);
+            }
+        }
+
+        // `x = Q * x`
+        template<typename T>
+        void ApplyQ(std::span<T> x) const
+        {
+            for (size_t k = 4; k-- > 0;) {
+                ApplyReflector(k, x);
+            }
+        }
+
+        // returns `x` such that `R * x = b`
+        std::array<Vec3d, 4> SolveR(const std::array<Vec3d, 4>& b) const
+        {
+            std::array<Vec3d, 4> x{};
+            for (size_t row = 4; row-- > 0;) {
+                Vec3d sum = b[row];
+                for (size_t col = row + 1; col < 4; ++col) {
+                    sum -= m_R[row][col] * x[col];
+                }
+                x[row] = sum / m_R[row][row];
+            }
+            return x;
+        }
+
+    private:
+        // `x = H_k * x`, where `H_k = I - scale * v * vT` (i.e. the `k`th reflector)
+        template<typename T>
+        void ApplyReflector(size_t k, std::span<T> x) const
+        {
+            const std::vector<double>& v = m_Reflectors[k];
+            T dot{};
+            for (size_t i = k; i < m_NumRows; ++i) {
+                dot += v[i] * x[i];
+            }
+            const T scaledDot = m_ReflectorScales[k] * dot;
+            for (size_t i = k; i < m_NumRows; ++i) {
+                x[i] -= v[i] * scaledDot;
+            }
+        }
+
+        size_t m_NumRows;
+        std::array<std::vector<double>, 4> m_Reflectors;
+        std::array<double, 4> m_ReflectorScales{};
+        std::array<std::array<double, 4>, 4> m_R{};
+        std::array<double, 4> m_ColumnNorms{};
+    };
+
+    // the kernel matrix, `K`, of the TPS system (see `CalcCoefficients`), which can be multiplied
+    // with vectors without storing it (i.e. each element is evaluated on-the-fly)
+    class KernelMatrixOperator final {
+    public:
+        explicit KernelMatrixOperator(std::span<const LandmarkPair3D> landmarks)
+        {
+            for (std::vector<float>* v : {&m_SourcesX, &m_SourcesY, &m_SourcesZ}) {
+                v->reserve(landmarks.size());
+            }
+            m_Sources.reserve(landmarks.size());
+            for (const LandmarkPair3D& landmark : landmarks) {
+                m_SourcesX.push_back(landmark.source.x);
+                m_SourcesY.push_back(landmark.source.y);
+                m_SourcesZ.push_back(landmark.source.z);
+                m_Sources.push_back(landmark.source);
+            }
+        }
+
+        size_t size() const { return m_Sources.size(); }
+
+        // `out = K * z`, for each dimension of `z` (i.e. for 3 right-hand sides at once)
+        void Multiply(std::span<const Vec3d> z, std::span<Vec3d> out) const
+        {
+            const size_t n = size();
+            std::vector<double> zx(n);
+            std::vector<double> zy(n);
+            std::vector<double> zz(n);
+            for (size_t i = 0; i < n; ++i) {
+                zx[i] = z[i].x;
+                zy[i] = z[i].y;
+                zz[i] = z[i].z;
+            }
+
+            ThreadPool::global().for_each_chunk(n, c_NumTPSLanes * 8, [this, &zx, &zy, &zz, out](size_t first, size_t last)
+            {
+                for (size_t i = first; i < last; i += c_NumTPSLanes) {
+                    const size_t numRows = std::min(c_NumTPSLanes, last - i);
+
+                    TPSLanes px{};
+                    TPSLanes py{};
+                    TPSLanes pz{};
+                    LoadTPSLanes(std::span{m_Sources}.subspan(i, numRows), px, py, pz);
+
+                    TPSAccumulatorLanes rx{};
+                    TPSAccumulatorLanes ry{};
+                    TPSAccumulatorLanes rz{};
+                    AccumulateNonAffineTermsLanes<double>(
+                        px, py, pz,
+                        m_SourcesX, m_SourcesY, m_SourcesZ,
+                        zx, zy, zz,
+                        rx, ry, rz
+                    );
+
+                    for (size_t lane = 0; lane < numRows; ++lane) {
+                        out[i + lane] = {rx[lane], ry[lane], rz[lane]};
+                    }
+                }
+            });
+        }
+
+    private:
+        std::vector<float> m_SourcesX;
+        std::vector<float> m_SourcesY;
+        std::vector<float> m_SourcesZ;
+        std::vector<Vec3> m_Sources;
+    };
+
+    // returns the TPS coefficients, given the solution of the projected system (`y`), where
+    // `projectedKernelTimesSolution` is `QT * K * Q * [0 y]`
+    TPSCoefficients3D ExtractCoefficientsFromProjectedSolution(
+        std::span<const LandmarkPair3D> landmarks,
+        const AffineConstraintsQR& qr,
+        std::span<const Vec3d> projectedDestinations,
+        std::span<const Vec3d> y,
+        std::span<const Vec3d> projectedKernelTimesSolution)
+    {
+        // the first 4 rows of the projected system are `(QT*K*Q*[0 y])[0:4] + R*a = (QT*v)[0:4]`
+        std::array<Vec3d, 4> affineRhs{};
+        for (size_t k = 0; k < 4; ++k) {
+            affineRhs[k] = projectedDestinations[k] - projectedKernelTimesSolution[k];
+        }
+        const std::array<Vec3d, 4> a = qr.SolveR(affineRhs);
+
+        // the weights are `w = Q * [0 y]`
+        std::vector<Vec3d> w(landmarks.size());
+        std::copy(y.begin(), y.end(), w.begin() + 4);
+        qr.ApplyQ<Vec3d>(w);
+
+        TPSCoefficients3D rv;
+        rv.a1 = a[0];
+        rv.a2 = a[1];
+        rv.a3 = a[2];
+        rv.a4 = a[3];
+        rv.nonAffineTerms.reserve(landmarks.size());
+        for (size_t i = 0; i < landmarks.size(); ++i) {
+            rv.nonAffineTerms.emplace_back(w[i], landmarks[i].source);
+        }
+        return rv;
+    }
+
+    // returns `QT * v`, where `v` contains the landmark destinations
+    std::vector<Vec3d> CalcProjectedDestinations(
+        std::span<const LandmarkPair3D> landmarks,
+        const AffineConstraintsQR& qr)
+    {
+        std::vector<Vec3d> rv;
+        rv.reserve(landmarks.size());
+        for (const LandmarkPair3D& landmark : landmarks) {
+            rv.emplace_back(landmark.destination);
+        }
+        qr.ApplyQT<Vec3d>(rv);
+        return rv;
+    }
+
+    // solves the TPS system by factorizing all of `L` with a general-purpose (QTZ) factorization
+    TPSCoefficients3D SolveGeneral(const TPSCoefficientSolverInputs3D& inputs)
+    {
+        const int numPairs = static_cast<int>(inputs.landmarks.size());
+
+        // construct matrix L
+        SimTK::Matrix L(numPairs + 4, numPairs + 4);
+
+        // populate the K part of matrix L (upper-left)
+        for (int row = 0; row < numPairs; ++row) {
+            for (int col = 0; col < numPairs; ++col) {
+                const Vec3& pis = inputs.landmarks[row].source;
+                const Vec3& pj = inputs.landmarks[col].source;
+
+                L(row, col) = RadialBasisFunction3D(pis, pj);
+            }
+        }
+
+        // populate the P part of matrix L (upper-right)
+        {
+            const int pStartColumn = numPairs;
+
+            for (int row = 0; row < numPairs; ++row) {
+                L(row, pStartColumn)     = 1.0;
+                L(row, pStartColumn + 1) = inputs.landmarks[row].source.x;
+                L(row, pStartColumn + 2) = inputs.landmarks[row].source.y;
+                L(row, pStartColumn + 3) = inputs.landmarks[row].source.z;
+            }
+        }
+
+        // populate the PT part of matrix L (bottom-left)
+        {
+            const int ptStartRow = numPairs;
+
+            for (int col = 0; col < numPairs; ++col) {
+                L(ptStartRow, col)     = 1.0;
+                L(ptStartRow + 1, col) = inputs.landmarks[col].source.x;
+                L(ptStartRow + 2, col) = inputs.landmarks[col].source.y;
+                L(ptStartRow + 3, col) = inputs.landmarks[col].source.z;
+            }
+        }
+
+        // populate the 0 part of matrix L (bottom-right)
+        {
+            const int zeroStartRow = numPairs;
+            const int zeroStartCol = numPairs;
+
+            for (int row = 0; row < 4; ++row) {
+                for (int col = 0; col < 4; ++col) {
+                    L(zeroStartRow + row, zeroStartCol + col) = 0.0;
+                }
+            }
+        }
+
+        // construct "result" vectors Vx and Vy (these hold the landmark destinations)
+        SimTK::Vector Vx(numPairs + 4, 0.0);
+        SimTK::Vector Vy(numPairs + 4, 0.0);
+        SimTK::Vector Vz(numPairs + 4, 0.0);
+        for (int row = 0; row < numPairs; ++row) {
+            Vx[row] = inputs.landmarks[row].destination.x;
+            Vy[row] = inputs.landmarks[row].destination.y;
+            Vz[row] = inputs.landmarks[row].destination.z;
+        }
+
+        // create a linear solver that can be used to solve `L*Cn = Vn` for `Cn` (where `n` is a dimension)
+        const SimTK::FactorQTZ F{L};
+
+        // solve for each dimension
+        SimTK::Vector Cx(numPairs + 4, 0.0);
+        F.solve(Vx, Cx);
+        SimTK::Vector Cy(numPairs + 4, 0.0);
+        F.solve(Vy, Cy);
+        SimTK::Vector Cz(numPairs + 4, 0.0);
+        F.solve(Vz, Cz);
+
+        // `Cx/Cy/Cz` now contain the solved coefficients (e.g. for X): [w1, w2, ... wx, a0, a1x, a1y a1z]
+        //
+        // extract the coefficients into the return value
+
+        TPSCoefficients3D rv;
+
+        // populate affine a1, a2, a3, and a4 terms
+        rv.a1 = {Cx[numPairs],   Cy[numPairs]  , Cz[numPairs]  };
+        rv.a2 = {Cx[numPairs+1], Cy[numPairs+1], Cz[numPairs+1]};
+        rv.a3 = {Cx[numPairs+2], Cy[numPairs+2], Cz[numPairs+2]};
+        rv.a4 = {Cx[numPairs+3], Cy[numPairs+3], Cz[numPairs+3]};
+
+        // populate `wi` coefficients (+ control points, needed at evaluation-time)
+        rv.nonAffineTerms.reserve(numPairs);
+        for (int i = 0; i < numPairs; ++i) {
+            const Vec3 weight = {Cx[i], Cy[i], Cz[i]};
+            const Vec3& controlPoint = inputs.landmarks[i].source;
+            rv.nonAffineTerms.emplace_back(weight, controlPoint);
+        }
+
+        return rv;
+    }
+
+    // returns `true` if any landmarks have the same source location, which makes the TPS system singular
+    bool HasDuplicateSources(std::span<const LandmarkPair3D> landmarks)
+    {
+        std::vector<Vec3> sources;
+        sources.reserve(landmarks.size());
+        for (const LandmarkPair3D& landmark : landmarks) {
+            sources.push_back(landmark.source);
+        }
+        const auto lexicographicallyLess = [](const Vec3& a, const Vec3& b)
+        {
+            return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+        };
+        std::sort(sources.begin(), sources.end(), lexicographicallyLess);
+        return std::adjacent_find(sources.begin(), sources.end()) != sources.end();
+    }
+
+    // returns the QR decomposition of `P` if the landmarks can be solved via the projected system, or
+    // `std::nullopt` if they're degenerate (e.g. too few, coplanar, duplicated)
+    std::optional<AffineConstraintsQR> TryCalcAffineConstraintsQR(std::span<const LandmarkPair3D> landmarks)
+    {
+        if (landmarks.size() < 4 or HasDuplicateSources(landmarks)) {
+            return std::nullopt;
+        }
+        AffineConstraintsQR rv{landmarks};
+        if (not rv.HasFullRank()) {
+            return std::nullopt;
+        }
+        return rv;
+    }
+
+    // the number of columns that `CholeskyFactorizeInPlace` computes per pass over the matrix
+    constexpr size_t c_CholeskyBlockSize = 32;
+
+    // the smallest pivot, relative to the corresponding diagonal element of the input matrix, that
+    // `CholeskyFactorizeInPlace` accepts (the inputs are `float`s, so anything smaller is noise)
+    constexpr double c_CholeskyRelativePivotTolerance = 1e-9;
+
+    // in-place Cholesky factorization (`A = L * LT`) of the lower triangle of the `n`x`n` matrix
+    // that starts at `data` and has rows that are `stride` elements apart
+    //
+    // returns `false` if the matrix isn't (numerically) positive-definite
+    bool CholeskyFactorizeInPlace(double* data, size_t n, size_t stride)
+    {
+        const auto row = [data, stride](size_t i, size_t length)
+        {
+            return std::span<double>{data + i*stride, length};
+        };
+
+        // `L(i, j) = (A(i, j) - dot(L(i, 0:j), L(j, 0:j))) / L(j, j)` for each row `i` in `[first, last)`
+        // and column `j` in `[firstColumn, lastColumn)`
+        const auto calcSubDiagonalElements = [&row](size_t first, size_t last, size_t firstColumn, size_t lastColumn)
+        {
+            for (size_t i = first; i < last; ++i) {
+                const std::span<double> rowI = row(i, lastColumn);
+                for (size_t j = firstColumn; j < std::min(i, lastColumn); ++j) {
+                    const std::span<const double> rowJ = row(j, j + 1);
+                    rowI[j] = (rowI[j] - DotProduct(rowI.first(j), rowJ.first(j))) / rowJ[j];
+                }
+            }
+        };
+
+        // left-looking, blocked, algorithm: each pass computes a block of columns, so that each row
+        // is reused (while it's in the cache) for `c_CholeskyBlockSize` dot products
+        for (size_t blockBegin = 0; blockBegin < n; blockBegin += c_CholeskyBlockSize) {
+            const size_t blockEnd = std::min(n, blockBegin + c_CholeskyBlockSize);
+
+            // factorize the diagonal block
+            for (size_t j = blockBegin; j < blockEnd; ++j) {
+                calcSubDiagonalElements(j, j + 1, blockBegin, j);
+                const std::span<double> rowJ = row(j, j + 1);
+                const double diagonal = rowJ[j] - DotProduct(rowJ.first(j), rowJ.first(j));
+                if (not (diagonal > c_CholeskyRelativePivotTolerance * rowJ[j])) {
+                    return false;  // (numerically) singular
+                }
+                rowJ[j] = std::sqrt(diagonal);
+            }
+
+            // compute the block's columns in all subsequent rows (each row is independent)
+            const size_t minRowsPerThread = std::max<size_t>(4, 8192/(blockEnd + 1));
+            ThreadPool::global().for_each_chunk(n - blockEnd, minRowsPerThread, [&calcSubDiagonalElements, blockBegin, blockEnd](size_t first, size_t last)
+            {
+                calcSubDiagonalElements(blockEnd + first, blockEnd + last, blockBegin, blockEnd);
+            });
+        }
+        return true;
+    }
+
+    // solves the TPS system by factorizing the (negated) projected kernel matrix `-(QT*K*Q)[4:,4:]`,
+    // which is symmetric positive-definite, with a Cholesky factorization
+    //
+    // returns `std::nullopt` if the landmarks are degenerate (see `TryCalcAffineConstraintsQR`)
+    std::optional<TPSCoefficients3D> TrySolveSymmetric(std::span<const LandmarkPair3D> landmarks)
+    {
+        const std::optional<AffineConstraintsQR> maybeQR = TryCalcAffineConstraintsQR(landmarks);
+        if (not maybeQR) {
+            return std::nullopt;
+        }
+        const AffineConstraintsQR& qr = *maybeQR;
+        const size_t numLandmarks = landmarks.size();
+
+        // compute `M = QT * K * Q` as `M = ((K * Q)T * Q)` (`K` is symmetric), so that `Q` is
+        // only ever applied to contiguous rows
+        std::vector<double> m(numLandmarks * numLandmarks);
+        const auto row = [&m, numLandmarks](size_t i)
+        {
+            return std::span<double>{m.data() + i*numLandmarks, numLandmarks};
+        };
+        const auto multiplyRowsByQ = [&qr, &row](size_t first, size_t last)
+        {
+            for (size_t i = first; i < last; ++i) {
+                qr.ApplyQT<double>(row(i));  // (row i of `X * Q` is `QT * (row i of X)`)
+            }
+        };
+        ThreadPool::global().for_each_chunk(numLandmarks, 64, [&landmarks, &row, &multiplyRowsByQ](size_t first, size_t last)
+        {
+            for (size_t i = first; i < last; ++i) {
+                const std::span<double> rowI = row(i);
+                for (size_t j = 0; j < rowI.size(); ++j) {
+                    rowI[j] = RadialBasisFunction3D(landmarks[i].source, landmarks[j].source);
+                }
+            }
+            multiplyRowsByQ(first, last);
+        });
+        for (size_t i = 0; i < numLandmarks; ++i) {
+            for (size_t j = i + 1; j < numLandmarks; ++j) {
+                std::swap(m[i*numLandmarks + j], m[j*numLandmarks + i]);
+            }
+        }
+        ThreadPool::global().for_each_chunk(numLandmarks, 64, multiplyRowsByQ);
+
+        // factorize `-M22` (i.e. the lower-right (N-4)x(N-4) block of `-M`) in-place
+        const size_t n = numLandmarks - 4;
+        double* const m22 = m.data() + 4*numLandmarks + 4;
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j <= i; ++j) {
+                m22[i*numLandmarks + j] = -m22[i*numLandmarks + j];
+            }
+        }
+        if (not CholeskyFactorizeInPlace(m22, n, numLandmarks)) {
+            return std::nullopt;
+        }
+
+        // solve `-M22 * y = -(QT*v)[4:]` with forward + back substitution, for all dimensions at once
+        const std::vector<Vec3d> projectedDestinations = CalcProjectedDestinations(landmarks, qr);
+        std::vector<Vec3d> y(n);
+        for (size_t i = 0; i < n; ++i) {
+            Vec3d sum = -projectedDestinations[4 + i];
+            for (size_t j = 0; j < i; ++j) {
+                sum -= m22[i*numLandmarks + j] * y[j];
+            }
+            y[i] = sum / m22[i*numLandmarks + i];
+        }
+        for (size_t i = n; i-- > 0;) {
+            y[i] /= m22[i*numLandmarks + i];
+            for (size_t j = 0; j < i; ++j) {
+                y[j] -= m22[i*numLandmarks + j] * y[i];
+            }
+        }
+
+        // compute the first 4 rows of `M * [0 y]` (`M12` is unmodified by the factorization)
+        std::vector<Vec3d> projectedKernelTimesSolution(4);
+        for (size_t k = 0; k < 4; ++k) {
+            for (size_t j = 0; j < n; ++j) {
+                projectedKernelTimesSolution[k] += m[k*numLandmarks + 4 + j] * y[j];
+            }
+        }
+
+        return ExtractCoefficientsFromProjectedSolution(landmarks, qr, projectedDestinations, y, projectedKernelTimesSolution);
+    }
+
+    // solves the TPS system by solving `-M22 * y = -(QT*v)[4:]` (see `TrySolveSymmetric`) with the
+    // conjugate gradient method, where `M22` is evaluated on-the-fly in each iteration
+    //
+    // returns `std::nullopt` if the landmarks are degenerate (see `TryCalcAffineConstraintsQR`), or
+    // if the method doesn't converge within `options.iterativeSolverMaxIterations` iterations and
+    // there are few enough landmarks that the caller can fall back to `TrySolveSymmetric`
+    std::optional<TPSCoefficients3D> TrySolveIterative(
+        std::span<const LandmarkPair3D> landmarks,
+        const TPSCoefficientSolverOptions3D& options)
+    {
+        const std::optional<AffineConstraintsQR> maybeQR = TryCalcAffineConstraintsQR(landmarks);
+        if (not maybeQR) {
+            return std::nullopt;
+        }
+        const AffineConstraintsQR& qr = *maybeQR;
+        const size_t numLandmarks = landmarks.size();
+        const KernelMatrixOperator kernel{landmarks};
+        const size_t n = numLandmarks - 4;
+
+        // `out = QT * K * Q * [0 y]` (all N rows)
+        std::vector<Vec3d> buffer(numLandmarks);
+        const auto multiplyByProjectedKernel = [&qr, &kernel, &buffer](std::span<const Vec3d> y, std::span<Vec3d> out)
+        {
+            std::fill(buffer.begin(), buffer.begin() + 4, Vec3d{});
+            std::copy(y.begin(), y.end(), buffer.begin() + 4);
+            qr.ApplyQ<Vec3d>(buffer);
+            kernel.Multiply(buffer, out);
+            qr.ApplyQT<Vec3d>(out);
+        };
+
+        const std::vector<Vec3d> projectedDestinations = CalcProjectedDestinations(landmarks, qr);
+        std::vector<Vec3d> y(n);
+        std::vector<Vec3d> residual(n);
+        std::vector<Vec3d> direction(n);
+        std::vector<Vec3d> product(numLandmarks);
+        Vec3d residualNorm2{};
+        Vec3d targetResidualNorm2{};
+        for (size_t i = 0; i < n; ++i) {
+            residual[i] = -projectedDestinations[4 + i];
+            direction[i] = residual[i];
+            residualNorm2 += residual[i] * residual[i];
+        }
+        targetResidualNorm2 = (options.iterativeSolverTolerance * options.iterativeSolverTolerance) * residualNorm2;
+
+        // run the conjugate gradient method for each dimension simultaneously, so that each
+        // dimension shares the (expensive) matrix-vector product
+        const auto isConverged = [&residualNorm2, &targetResidualNorm2]()
+        {
+            return residualNorm2.x <= targetResidualNorm2.x and residualNorm2.y <= targetResidualNorm2.y and residualNorm2.z <= targetResidualNorm2.z;
+        };
+        size_t iteration = 0;
+        for (; iteration < options.iterativeSolverMaxIterations and not isConverged(); ++iteration) {
+            multiplyByProjectedKernel(direction, product);
+            const std::span<Vec3d> negatedProduct = std::span{product}.subspan(4);  // i.e. `-M22 * direction`, after negation
+            Vec3d curvature{};
+            for (size_t i = 0; i < n; ++i) {
+                negatedProduct[i] = -negatedProduct[i];
+                curvature += direction[i] * negatedProduct[i];
+            }
+
+            Vec3d stepSize{};
+            for (size_t dim = 0; dim < 3; ++dim) {
+                if (residualNorm2[dim] <= targetResidualNorm2[dim]) {
+                    continue;  // this dimension has already converged
+                }
+                if (not (curvature[dim] > 0.0)) {
+                    return std::nullopt;  // not (numerically) positive-definite
+                }
+                stepSize[dim] = residualNorm2[dim] / curvature[dim];
+            }
+
+            Vec3d newResidualNorm2{};
+            for (size_t i = 0; i < n; ++i) {
+                y[i] += stepSize * direction[i];
+                residual[i] -= stepSize * negatedProduct[i];
+                newResidualNorm2 += residual[i] * residual[i];
+            }
+
+            Vec3d directionScale{};
+            for (size_t dim = 0; dim < 3; ++dim) {
+                directionScale[dim] = residualNorm2[dim] > 0.0 ? newResidualNorm2[dim] / residualNorm2[dim] : 0.0;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                direction[i] = residual[i] + directionScale * direction[i];
+            }
+            residualNorm2 = newResidualNorm2;
+        }
+
+        if (not isConverged()) {
+            if (numLandmarks <= options.maxLandmarksForSymmetricSolver) {
+                log_warn("CalcCoefficients: the iterative TPS solver did not converge after %zu iterations: falling back to a direct solver", iteration);
+                return std::nullopt;
+            }
+            // the direct solvers use O(N^2) memory, which may not be available for this many
+            // landmarks, so use the (approximate) solution from the last iteration instead
+            log_warn("CalcCoefficients: the iterative TPS solver did not converge after %zu iterations: using its approximate solution, because there are too many landmarks (%zu) for a direct solver", iteration, numLandmarks);
+        }
+
+        multiplyByProjectedKernel(y, product);
+        return ExtractCoefficientsFromProjectedSolution(landmarks, qr, projectedDestinations, y, product);
+    }
+
+    // the maximum depth of a `TPSApproximateEvaluator3D`'s octree (coincident control points
+    // can't be separated by subdividing, so they would otherwise recurse forever)
+    constexpr size_t c_MaxTPSOctreeDepth = 24;
+
+    // the order (maximum total degree) of the far-field expansion of each octree node
+    //
+    // the far-field expansion of a node is the Taylor expansion of its terms, `sum_i(w_i * |p - c_i|)`,
+    // around the node's center. Higher orders are accurate closer to the node, but are more
+    // expensive to evaluate
+    constexpr size_t c_TPSExpansionOrder = 4;
+    constexpr size_t c_NumTPSExpansionTerms = (c_TPSExpansionOrder+1)*(c_TPSExpansionOrder+2)*(c_TPSExpansionOrder+3)/6;
+
+    // bounds the truncation error of an order-`c_TPSExpansionOrder` expansion
+    //
+    // `|r - d| = |r| * sum_n(C_n(cos(theta)) * t^n)`, where `t = |d|/|r|` and `C_n` are Gegenbauer
+    // polynomials (alpha = -1/2), which are bounded by `2/(2n - 1)` on [-1, 1]. So, the error of
+    // truncating after order `P` is, at most, `(2/(2P + 1)) * |r| * t^(P+1)/(1 - t)`
+    constexpr double c_TPSExpansionErrorFactor = 2.0/(2.0*c_TPSExpansionOrder + 1.0);
+
+    // nodes that have fewer terms than this are evaluated exactly (rather than being expanded),
+    // because summing their terms is cheaper than evaluating an expansion
+    constexpr size_t c_MinTermsPerTPSExpansion = 2*c_NumTPSExpansionTerms;
+
+    // a multi-index `k = (kx, ky, kz)` of a far-field expansion, which multiplies the moment
+    // `sum_i(w_i * d_i^k)` (where `d_i = c_i - center`) with the Taylor coefficient of `|p - c|`
+    // (w.r.t. `c`, at `center`) for `k`
+    //
+    // the multi-indices are ordered by total degree, so that each one is preceded by the indices
+    // that it's calculated from (a missing predecessor is `c_NumTPSExpansionTerms`)
+    struct TPSExpansionMultiIndex final {
+        size_t degree = 0;
+        std::array<size_t, 3> minusOne{};  // indices of `k - e_l`
+        std::array<size_t, 3> minusTwo{};  // indices of `k - 2*e_l`
+        size_t parent = 0;  // the first (valid) `minusOne` index
+        size_t parentAxis = 0;  // the `l` of `parent`
+    };
+
+    constexpr auto c_TPSExpansionMultiIndices = []()
+    {
+        std::array<std::array<size_t, 3>, c_NumTPSExpansionTerms> ks{};
+        size_t numKs = 0;
+        for (size_t degree = 0; degree <= c_TPSExpansionOrder; ++degree) {
+            for (size_t kx = degree + 1; kx-- > 0;) {
+                for (size_t ky = degree - kx + 1; ky-- > 0;) {
+                    ks[numKs++] = {kx, ky, degree - kx - ky};
+                }
+            }
+        }
+
+        const auto indexOf = [&ks](std::array<size_t, 3> k, size_t axis, size_t n)
+        {
+            if (k[axis] < n) {
+                return c_NumTPSExpansionTerms;
+            }
+            k[axis] -= n;
+            for (size_t i = 0; i < ks.size(); ++i) {
+                if (ks[i] == k) {
+                    return i;
+                }
+            }
+            return c_NumTPSExpansionTerms;
+        };
+
+        std::array<TPSExpansionMultiIndex, c_NumTPSExpansionTerms> rv{};
+        for (size_t i = 0; i < ks.size(); ++i) {
+            rv[i].degree = ks[i][0] + ks[i][1] + ks[i][2];
+            for (size_t axis = 0; axis < 3; ++axis) {
+                rv[i].minusOne[axis] = indexOf(ks[i], axis, 1);
+                rv[i].minusTwo[axis] = indexOf(ks[i], axis, 2);
+            }
+            for (size_t axis = 3; axis-- > 0;) {
+                if (rv[i].minusOne[axis] != c_NumTPSExpansionTerms) {
+                    rv[i].parent = rv[i].minusOne[axis];
+                    rv[i].parentAxis = axis;
+                }
+            }
+        }
+        return rv;
+    }();
+
+    // a cluster of non-affine terms in a `TPSApproximateEvaluator3D`'s octree
+    struct TPSOctreeNode final {
+        Vec3d center{};
+        double radius = 0.0;  // distance from `center` to the furthest control point in the cluster
+        double absoluteWeight = 0.0;  // the maximum (over output dimensions) of `sum_i(|w_i|)`
+        uint32_t firstTerm = 0;
+        uint32_t lastTerm = 0;
+        uint32_t firstChild = 0;
+        uint32_t numChildren = 0;  // (0 == leaf)
+        bool hasExpandableChildren = false;  // (otherwise, descending into the children can't save any work)
+
+        // `sum_i(w_i * d_i^k)`, for each output dimension, for each multi-index `k`
+        std::array<std::array<double, c_NumTPSExpansionTerms>, 3> moments{};
+
+        size_t numTerms() const { return lastTerm - firstTerm; }
+    };
+
+    // returns the index of the octant of `center` that `p` is in
+    size_t CalcOctantIndex(const Vec3& center, const Vec3& p)
+    {
+        return (p.x >= center.x ? 1 : 0) | (p.y >= center.y ? 2 : 0) | (p.z >= center.z ? 4 : 0);
+    }
+
+    // computes the center, radius, and moments of the terms in `node`
+    void CalcTPSOctreeNodeMoments(TPSOctreeNode& node, std::span<const TPSNonAffineTerm3D> terms)
+    {
+        Vec3 minCorner = terms.front().controlPoint;
+        Vec3 maxCorner = terms.front().controlPoint;
+        for (const TPSNonAffineTerm3D& term : terms) {
+            minCorner = elementwise_min(minCorner, term.controlPoint);
+            maxCorner = elementwise_max(maxCorner, term.controlPoint);
+        }
+        node.center = 0.5*(Vec3d{minCorner} + Vec3d{maxCorner});
+
+        Vec3d absoluteWeights{};
+        std::array<double, c_NumTPSExpansionTerms> monomials{};
+        for (const TPSNonAffineTerm3D& term : terms) {
+            const Vec3d d = Vec3d{term.controlPoint} - node.center;
+            const Vec3d w{term.weight};
+            node.radius = std::max(node.radius, std::sqrt(dot(d, d)));
+            absoluteWeights += abs(w);
+
+            monomials[0] = 1.0;
+            for (size_t k = 1; k < c_NumTPSExpansionTerms; ++k) {
+                monomials[k] = monomials[c_TPSExpansionMultiIndices[k].parent] * d[c_TPSExpansionMultiIndices[k].parentAxis];
+            }
+            for (size_t dim = 0; dim < 3; ++dim) {
+                for (size_t k = 0; k < c_NumTPSExpansionTerms; ++k) {
+                    node.moments[dim][k] += w[dim] * monomials[k];
+                }
+            }
+        }
+        node.absoluteWeight = std::max({absoluteWeights.x, absoluteWeights.y, absoluteWeights.z});
+    }
+
+    // recursively builds the octree rooted at `nodes[nodeIndex]` by (re)ordering `terms`, such that
+    // each node's terms are contiguous
+    void BuildTPSOctree(
+        std::vector<TPSOctreeNode>& nodes,
+        size_t nodeIndex,
+        std::span<TPSNonAffineTerm3D> terms,
+        size_t maxTermsPerLeaf,
+        size_t depth)
+    {
+        const std::span<TPSNonAffineTerm3D> nodeTerms = terms.subspan(nodes[nodeIndex].firstTerm, nodes[nodeIndex].numTerms());
+        CalcTPSOctreeNodeMoments(nodes[nodeIndex], nodeTerms);
+
+        if (nodeTerms.size() <= maxTermsPerLeaf or depth >= c_MaxTPSOctreeDepth or nodes[nodeIndex].radius == 0.0) {
+            return;  // leaf
+        }
+
+        // partition the terms by octant (stable, so that the octree is deterministic)
+        const Vec3 center{nodes[nodeIndex].center};
+        std::array<size_t, 8> octantSizes{};
+        for (const TPSNonAffineTerm3D& term : nodeTerms) {
+            ++octantSizes[CalcOctantIndex(center, term.controlPoint)];
+        }
+        std::array<size_t, 8> octantOffsets{};
+        for (size_t octant = 1; octant < 8; ++octant) {
+            octantOffsets[octant] = octantOffsets[octant-1] + octantSizes[octant-1];
+        }
+        const std::vector<TPSNonAffineTerm3D> unpartitioned(nodeTerms.begin(), nodeTerms.end());
+        for (const TPSNonAffineTerm3D& term : unpartitioned) {
+            nodeTerms[octantOffsets[CalcOctantIndex(center, term.controlPoint)]++] = term;
+        }
+
+        // allocate the (non-empty) children contiguously, then recurse into them
+        const auto firstChild = static_cast<uint32_t>(nodes.size());
+        uint32_t firstTerm = nodes[nodeIndex].firstTerm;
+        for (const size_t octantSize : octantSizes) {
+            if (octantSize > 0) {
+                TPSOctreeNode& child = nodes.emplace_back();
+                child.firstTerm = firstTerm;
+                child.lastTerm = firstTerm + static_cast<uint32_t>(octantSize);
+                firstTerm = child.lastTerm;
+            }
+        }
+        const auto numChildren = static_cast<uint32_t>(nodes.size() - firstChild);
+        if (numChildren == 1) {
+            // (rounding: the center couldn't separate the terms)
+            nodes.pop_back();
+            return;
+        }
+        nodes[nodeIndex].firstChild = firstChild;
+        nodes[nodeIndex].numChildren = numChildren;
+        nodes[nodeIndex].hasExpandableChildren = std::any_of(octantSizes.begin(), octantSizes.end(), [](size_t octantSize)
+        {
+            return octantSize >= c_MinTermsPerTPSExpansion;
+        });
+
+        for (uint32_t child = firstChild; child < firstChild + numChildren; ++child) {
+            BuildTPSOctree(nodes, child, terms, maxTermsPerLeaf, depth + 1);
+        }
+    }
+
+    // returns the upper bound of the error of evaluating `node`'s expansion at `distance` from its center
+    double CalcTPSOctreeNodeExpansionErrorBound(const TPSOctreeNode& node, double distance)
+    {
+        const double t = node.radius / distance;
+        double tPow = t;
+        for (size_t i = 0; i < c_TPSExpansionOrder; ++i) {
+            tPow *= t;
+        }
+        return c_TPSExpansionErrorFactor * node.absoluteWeight * distance * tPow / (1.0 - t);
+    }
+
+    // returns the far-field expansion of `node`'s terms at `r` (relative to the node's center)
+    Vec3d EvaluateTPSOctreeNodeExpansion(const TPSOctreeNode& node, const Vec3d& r, double distance)
+    {
+        // calculate the Taylor coefficients of `|r - d|` (w.r.t. `d`, at zero) via the recurrence
+        //
+        //     |k| * |r|^2 * f_k = (2|k| - 3) * sum_l(r_l * f_{k - e_l}) - (|k| - 3) * sum_l(f_{k - 2e_l})
+        //
+        // which is derived from `|r - d|^2 * grad(|r - d|) = |r - d| * grad(|r - d|^2)/2`
+        std::array<double, c_NumTPSExpansionTerms + 1> coefficients{};  // (the last element is a zero for missing predecessors)
+        coefficients[0] = distance;
+        const double inverseDistance2 = 1.0 / (distance*distance);
+        for (size_t k = 1; k < c_NumTPSExpansionTerms; ++k) {
+            const TPSExpansionMultiIndex& index = c_TPSExpansionMultiIndices[k];
+            const auto degree = static_cast<double>(index.degree);
+            const double firstOrderSum =
+                r.x*coefficients[index.minusOne[0]] + r.y*coefficients[index.minusOne[1]] + r.z*coefficients[index.minusOne[2]];
+            const double secondOrderSum =
+                coefficients[index.minusTwo[0]] + coefficients[index.minusTwo[1]] + coefficients[index.minusTwo[2]];
+            coefficients[k] = ((2.0*degree - 3.0)*firstOrderSum - (degree - 3.0)*secondOrderSum) * inverseDistance2 / degree;
+        }
+
+        Vec3d rv{};
+        for (size_t dim = 0; dim < 3; ++dim) {
+            for (size_t k = 0; k < c_NumTPSExpansionTerms; ++k) {
+                rv[dim] += coefficients[k] * node.moments[dim][k];
+            }
+        }
+        return rv;
+    }
+
+    // returns the sum of `wi * U(||controlPoint_i - p||)` for terms `[first, last)` of `coefs`
+    //
+    // unlike `AccumulateNonAffineTermsLanes`, this evaluates one point, with each lane evaluating
+    // a different term (a leaf of a `TPSApproximateEvaluator3D`'s octree is evaluated per-point)
+    Vec3d AccumulateNonAffineTermsAcrossLanes(const TPSCoefficientsSoA3D& coefs, Vec3 p, size_t first, size_t last)
+    {
+        const float* const cxs = coefs.controlPointsX.data();
+        const float* const cys = coefs.controlPointsY.data();
+        const float* const czs = coefs.controlPointsZ.data();
+        const float* const wxs = coefs.weightsX.data();
+        const float* const wys = coefs.weightsY.data();
+        const float* const wzs = coefs.weightsZ.data();
+
+        TPSAccumulatorLanes rx{};
+        TPSAccumulatorLanes ry{};
+        TPSAccumulatorLanes rz{};
+        size_t i = first;
+        for (; i + c_NumTPSLanes <= last; i += c_NumTPSLanes) {
+            for (size_t lane = 0; lane < c_NumTPSLanes; ++lane) {
+                const float dx = cxs[i+lane] - p.x;
+                const float dy = cys[i+lane] - p.y;
+                const float dz = czs[i+lane] - p.z;
+                const float u = std::sqrt(dx*dx + dy*dy + dz*dz);  // RadialBasisFunction3D
+                rx[lane] += wxs[i+lane]*u;
+                ry[lane] += wys[i+lane]*u;
+                rz[lane] += wzs[i+lane]*u;
+            }
+        }
+        for (size_t lane = 0; i < last; ++i, ++lane) {
+            const float dx = cxs[i] - p.x;
+            const float dy = cys[i] - p.y;
+            const float dz = czs[i] - p.z;
+            const float u = std::sqrt(dx*dx + dy*dy + dz*dz);
+            rx[lane] += wxs[i]*u;
+            ry[lane] += wys[i]*u;
+            rz[lane] += wzs[i]*u;
+        }
+
+        Vec3d rv{};
+        for (size_t lane = 0; lane < c_NumTPSLanes; ++lane) {
+            rv += Vec3d{rx[lane], ry[lane], rz[lane]};
+        }
+        return rv;
+    }
 }
 
 std::ostream& osc::operator<<(std::ostream& o, const TPSCoefficientSolverInputs3D& inputs)
@@ -64,8 +1087,30 @@ std::ostream& osc::operator<<(std::ostream& o, const TPSCoefficients3D& coefs)
     return o;
 }
 
+osc::TPSCoefficientsSoA3D::TPSCoefficientsSoA3D(const TPSCoefficients3D& coefs) :
+    a1{coefs.a1},
+    a2{coefs.a2},
+    a3{coefs.a3},
+    a4{coefs.a4}
+{
+    const size_t numTerms = coefs.nonAffineTerms.size();
+    for (std::vector<float>* v : {&controlPointsX, &controlPointsY, &controlPointsZ, &weightsX, &weightsY, &weightsZ}) {
+        v->reserve(numTerms);
+    }
+    for (const TPSNonAffineTerm3D& term : coefs.nonAffineTerms) {
+        controlPointsX.push_back(term.controlPoint.x);
+        controlPointsY.push_back(term.controlPoint.y);
+        controlPointsZ.push_back(term.controlPoint.z);
+        weightsX.push_back(term.weight.x);
+        weightsY.push_back(term.weight.y);
+        weightsZ.push_back(term.weight.z);
+    }
+}
+
 // computes all coefficients of the 3D TPS equation (a1, a2, a3, a4, and all the w's)
-TPSCoefficients3D osc::CalcCoefficients(const TPSCoefficientSolverInputs3D& inputs)
+TPSCoefficients3D osc::CalcCoefficients(
+    const TPSCoefficientSolverInputs3D& inputs,
+    const TPSCoefficientSolverOptions3D& options)
 {
     // this is based on the Bookstein Thin Plate Sline (TPS) warping algorithm
     //
@@ -111,108 +1156,45 @@ TPSCoefficients3D osc::CalcCoefficients(const TPSCoefficientSolverInputs3D& inpu
     //     - 0 is a 4x4 zero matrix (padding)
     //
     // 6. Use a linear solver to solve L * [w a] = [v o] to yield [w a]
+    //
+    //    L is symmetric, but indefinite. The `Symmetric` and `Iterative` strategies use the
+    //    QR decomposition P = Q * |R 0| to project it onto the null space of PT (`w` must be
+    //    in that null space, because PT * w = 0), which yields a (N-4)x(N-4) system that is
+    //    symmetric positive-definite (because -U(r) = -|r| is conditionally positive-definite)
+    //
     // 8. Return the coefficients, [w a]
 
     OSC_PERF("CalcCoefficients");
 
-    const int numPairs = static_cast<int>(inputs.landmarks.size());
-
-    if (numPairs == 0) {
+    if (inputs.landmarks.empty()) {
         // edge-case: there are no pairs, so return an identity-like transform
         return TPSCoefficients3D{};
     }
 
-    // construct matrix L
-    SimTK::Matrix L(numPairs + 4, numPairs + 4);
-
-    // populate the K part of matrix L (upper-left)
-    for (int row = 0; row < numPairs; ++row) {
-        for (int col = 0; col < numPairs; ++col) {
-            const Vec3& pis = inputs.landmarks[row].source;
-            const Vec3& pj = inputs.landmarks[col].source;
-
-            L(row, col) = RadialBasisFunction3D(pis, pj);
-        }
-    }
-
-    // populate the P part of matrix L (upper-right)
-    {
-        const int pStartColumn = numPairs;
-
-        for (int row = 0; row < numPairs; ++row) {
-            L(row, pStartColumn)     = 1.0;
-            L(row, pStartColumn + 1) = inputs.landmarks[row].source.x;
-            L(row, pStartColumn + 2) = inputs.landmarks[row].source.y;
-            L(row, pStartColumn + 3) = inputs.landmarks[row].source.z;
-        }
+    TPSCoefficientSolverStrategy strategy = options.strategy;
+    if (strategy == TPSCoefficientSolverStrategy::Automatic) {
+        strategy = inputs.landmarks.size() <= options.maxLandmarksForSymmetricSolver ?
+            TPSCoefficientSolverStrategy::Symmetric :
+            TPSCoefficientSolverStrategy::Iterative;
     }
 
-    // populate the PT part of matrix L (bottom-left)
-    {
-        const int ptStartRow = numPairs;
-
-        for (int col = 0; col < numPairs; ++col) {
-            L(ptStartRow, col)     = 1.0;
-            L(ptStartRow + 1, col) = inputs.landmarks[col].source.x;
-            L(ptStartRow + 2, col) = inputs.landmarks[col].source.y;
-            L(ptStartRow + 3, col) = inputs.landmarks[col].source.z;
-        }
+    std::optional<TPSCoefficients3D> rv;
+    if (strategy == TPSCoefficientSolverStrategy::Symmetric) {
+        rv = TrySolveSymmetric(inputs.landmarks);
     }
-
-    // populate the 0 part of matrix L (bottom-right)
-    {
-        const int zeroStartRow = numPairs;
-        const int zeroStartCol = numPairs;
-
-        for (int row = 0; row < 4; ++row) {
-            for (int col = 0; col < 4; ++col) {
-                L(zeroStartRow + row, zeroStartCol + col) = 0.0;
-            }
+    else if (strategy == TPSCoefficientSolverStrategy::Iterative) {
+        rv = TrySolveIterative(inputs.landmarks, options);
+        if (not rv) {
+            // the iterative solver didn't converge with few enough landmarks for a direct
+            // solver (or the inputs are degenerate, in which case this also fails, quickly):
+            // use the exact (but O(N^2) memory) solver
+            rv = TrySolveSymmetric(inputs.landmarks);
         }
     }
 
-    // construct "result" vectors Vx and Vy (these hold the landmark destinations)
-    SimTK::Vector Vx(numPairs + 4, 0.0);
-    SimTK::Vector Vy(numPairs + 4, 0.0);
-    SimTK::Vector Vz(numPairs + 4, 0.0);
-    for (int row = 0; row < numPairs; ++row) {
-        Vx[row] = inputs.landmarks[row].destination.x;
-        Vy[row] = inputs.landmarks[row].destination.y;
-        Vz[row] = inputs.landmarks[row].destination.z;
-    }
-
-    // create a linear solver that can be used to solve `L*Cn = Vn` for `Cn` (where `n` is a dimension)
-    const SimTK::FactorQTZ F{L};
-
-    // solve for each dimension
-    SimTK::Vector Cx(numPairs + 4, 0.0);
-    F.solve(Vx, Cx);
-    SimTK::Vector Cy(numPairs + 4, 0.0);
-    F.solve(Vy, Cy);
-    SimTK::Vector Cz(numPairs + 4, 0.0);
-    F.solve(Vz, Cz);
-
-    // `Cx/Cy/Cz` now contain the solved coefficients (e.g. for X): [w1, w2, ... wx, a0, a1x, a1y a1z]
-    //
-    // extract the coefficients into the return value
-
-    TPSCoefficients3D rv;
-
-    // populate affine a1, a2, a3, and a4 terms
-    rv.a1 = {Cx[numPairs],   Cy[numPairs]  , Cz[numPairs]  };
-    rv.a2 = {Cx[numPairs+1], Cy[numPairs+1], Cz[numPairs+1]};
-    rv.a3 = {Cx[numPairs+2], Cy[numPairs+2], Cz[numPairs+2]};
-    rv.a4 = {Cx[numPairs+3], Cy[numPairs+3], Cz[numPairs+3]};
-
-    // populate `wi` coefficients (+ control points, needed at evaluation-time)
-    rv.nonAffineTerms.reserve(numPairs);
-    for (int i = 0; i < numPairs; ++i) {
-        const Vec3 weight = {Cx[i], Cy[i], Cz[i]};
-        const Vec3& controlPoint = inputs.landmarks[i].source;
-        rv.nonAffineTerms.emplace_back(weight, controlPoint);
-    }
-
-    return rv;
+    // degenerate inputs (or `General`) are solved with the general-purpose solver, which finds
+    // a least-squares solution
+    return rv ? *std::move(rv) : SolveGeneral(inputs);
 }
 
 // evaluates the TPS equation with the given coefficients and input point
@@ -233,6 +1215,19 @@ Vec3 osc::EvaluateTPSEquation(const TPSCoefficients3D& coefs, Vec3 p)
     return rv;
 }
 
+void osc::EvaluateTPSEquation(
+    const TPSCoefficientsSoA3D& coefs,
+    std::span<const Vec3> points,
+    std::span<Vec3> out)
+{
+    OSC_ASSERT_ALWAYS(points.size() == out.size() && "the output span must be the same size as the input span");
+
+    for (size_t i = 0; i < points.size(); i += c_NumTPSLanes) {
+        const size_t numPoints = std::min(c_NumTPSLanes, points.size() - i);
+        EvaluateTPSEquationLanes(coefs, points.subspan(i, numPoints), out.subspan(i, numPoints));
+    }
+}
+
 // returns a mesh that is the equivalent of applying the 3D TPS warp to each vertex of the mesh
 Mesh osc::ApplyThinPlateWarpToMeshVertices(const TPSCoefficients3D& coefs, const Mesh& mesh, float blendingFactor)
 {
@@ -267,8 +1262,160 @@ void osc::ApplyThinPlateWarpToPointsInPlace(
     float blendingFactor)
 {
     OSC_PERF("ApplyThinPlateWarpToPointsInPlace");
-    for_each_parallel_unsequenced(8192, points, [&coefs, blendingFactor](Vec3& vert)
+    ApplyThinPlateWarpToPointsInPlace(TPSCoefficientsSoA3D{coefs}, points, blendingFactor);
+}
+
+void osc::ApplyThinPlateWarpToPointsInPlace(
+    const TPSCoefficientsSoA3D& soaCoefs,
+    std::span<Vec3> points,
+    float blendingFactor)
+{
+    // this is called on every warp (e.g. whenever a user moves a landmark), so it uses the
+    // persistent thread pool and the multi-point (SoA) evaluation kernel
+    ThreadPool::global().for_each_chunk(points.size(), c_MinPointsPerThread, [&soaCoefs, points, blendingFactor](size_t first, size_t last)
+    {
+        std::array<Vec3, c_NumTPSLanes> warped{};
+        for (size_t i = first; i < last; i += c_NumTPSLanes) {
+            const std::span<Vec3> lanePoints = points.subspan(i, std::min(c_NumTPSLanes, last - i));
+            EvaluateTPSEquationLanes(soaCoefs, lanePoints, std::span{warped}.first(lanePoints.size()));
+            for (size_t lane = 0; lane < lanePoints.size(); ++lane) {
+                lanePoints[lane] = lerp(lanePoints[lane], warped[lane], blendingFactor);
+            }
+        }
+    });
+}
+
+class osc::TPSApproximateEvaluator3D::Impl final {
+public:
+    Impl(const TPSCoefficients3D& coefs, const TPSApproximationParameters3D& params) :
+        m_Parameters{params}
+    {
+        OSC_ASSERT_ALWAYS(m_Parameters.maxAbsoluteError >= 0.0 && "the maximum absolute error cannot be negative");
+        OSC_ASSERT_ALWAYS(coefs.nonAffineTerms.size() < std::numeric_limits<uint32_t>::max() && "too many non-affine terms");
+
+        // (reorder the terms, so that each node's terms are contiguous)
+        TPSCoefficients3D reordered = coefs;
+        if (not reordered.nonAffineTerms.empty()) {
+            TPSOctreeNode& root = m_Nodes.emplace_back();
+            root.lastTerm = static_cast<uint32_t>(reordered.nonAffineTerms.size());
+            BuildTPSOctree(m_Nodes, 0, reordered.nonAffineTerms, std::max<size_t>(m_Parameters.maxControlPointsPerLeaf, 1), 0);
+        }
+        m_Coefficients = TPSCoefficientsSoA3D{reordered};
+    }
+
+    const TPSApproximationParameters3D& getParameters() const { return m_Parameters; }
+
+    Vec3 evaluate(Vec3 p) const
     {
-        vert = lerp(vert, EvaluateTPSEquation(coefs, vert), blendingFactor);
+        // compute affine terms (a1 + a2*x + a3*y + a4*z), as in `EvaluateTPSEquation`
+        const TPSCoefficientsSoA3D& c = m_Coefficients;
+        Vec3d rv = Vec3d{c.a1} + Vec3d{c.a2*p.x} + Vec3d{c.a3*p.y} + Vec3d{c.a4*p.z};
+        if (not m_Nodes.empty()) {
+            accumulateNonAffineTerms(m_Nodes.front(), p, m_Parameters.maxAbsoluteError, rv);
+        }
+        return rv;
+    }
+
+private:
+    // accumulates the non-affine terms of `node` into `rv`, with an error of, at most, `errorBudget`,
+    // and returns the part of `errorBudget` that wasn't used
+    //
+    // a node is expanded if the error bound of its expansion fits in the budget. Otherwise, the
+    // budget is shared between its children in proportion to their (absolute) weights. Children
+    // that don't use all of their share (e.g. because they're evaluated exactly, or are far away)
+    // pass the rest on to their siblings, so that nearby clusters can use the error budget that
+    // distant clusters didn't need
+    double accumulateNonAffineTerms(const TPSOctreeNode& node, Vec3 p, double errorBudget, Vec3d& rv) const
+    {
+        if (node.numTerms() >= c_MinTermsPerTPSExpansion) {
+            const Vec3d r = Vec3d{p} - node.center;
+            const double distance = std::sqrt(dot(r, r));
+            if (distance > node.radius) {
+                const double errorBound = CalcTPSOctreeNodeExpansionErrorBound(node, distance);
+                if (errorBound <= errorBudget) {
+                    rv += EvaluateTPSOctreeNodeExpansion(node, r, distance);
+                    return errorBudget - errorBound;
+                }
+            }
+        }
+
+        if (not node.hasExpandableChildren) {
+            // (its terms are contiguous, so they're evaluated exactly in one pass)
+            rv += AccumulateNonAffineTermsAcrossLanes(m_Coefficients, p, node.firstTerm, node.lastTerm);
+            return errorBudget;
+        }
+
+        const std::span<const TPSOctreeNode> children{m_Nodes.data() + node.firstChild, node.numChildren};
+        double remainingWeight = 0.0;
+        for (const TPSOctreeNode& child : children) {
+            remainingWeight += child.absoluteWeight;
+        }
+        for (const TPSOctreeNode& child : children) {
+            const double share = remainingWeight > 0.0 ?
+                std::min(errorBudget, errorBudget * (child.absoluteWeight / remainingWeight)) :
+                errorBudget;
+            errorBudget += accumulateNonAffineTerms(child, p, share, rv) - share;
+            remainingWeight -= child.absoluteWeight;
+        }
+        return errorBudget;
+    }
+
+    TPSApproximationParameters3D m_Parameters;
+    TPSCoefficientsSoA3D m_Coefficients;
+    std::vector<TPSOctreeNode> m_Nodes;  // (the root is the first node)
+};
+
+osc::TPSApproximateEvaluator3D::TPSApproximateEvaluator3D(
+    const TPSCoefficients3D& coefs,
+    const TPSApproximationParameters3D& params) :
+
+    m_Impl{std::make_shared<Impl>(coefs, params)}
+{}
+
+const TPSApproximationParameters3D& osc::TPSApproximateEvaluator3D::getParameters() const
+{
+    return m_Impl->getParameters();
+}
+
+Vec3 osc::TPSApproximateEvaluator3D::evaluate(Vec3 p) const
+{
+    return m_Impl->evaluate(p);
+}
+
+void osc::TPSApproximateEvaluator3D::evaluate(std::span<const Vec3> points, std::span<Vec3> out) const
+{
+    OSC_ASSERT_ALWAYS(points.size() == out.size() && "the output span must be the same size as the input span");
+
+    ThreadPool::global().for_each_chunk(points.size(), c_MinPointsPerThread, [this, points, out](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i) {
+            out[i] = m_Impl->evaluate(points[i]);
+        }
+    });
+}
+
+Mesh osc::ApplyThinPlateWarpToMeshVertices(const TPSApproximateEvaluator3D& evaluator, const Mesh& mesh, float blendingFactor)
+{
+    OSC_PERF("ApplyThinPlateWarpToMeshVertices (approximate)");
+
+    Mesh rv = mesh;
+    auto vertices = rv.vertices();
+    ApplyThinPlateWarpToPointsInPlace(evaluator, vertices, blendingFactor);
+    rv.set_vertices(vertices);
+    return rv;
+}
+
+void osc::ApplyThinPlateWarpToPointsInPlace(
+    const TPSApproximateEvaluator3D& evaluator,
+    std::span<Vec3> points,
+    float blendingFactor)
+{
+    OSC_PERF("ApplyThinPlateWarpToPointsInPlace (approximate)");
+
+    ThreadPool::global().for_each_chunk(points.size(), c_MinPointsPerThread, [&evaluator, points, blendingFactor](size_t first, size_t last)
+    {
+        for (Vec3& point : points.subspan(first, last - first)) {
+            point = lerp(point, evaluator.evaluate(point), blendingFactor);
+        }
     });
 }
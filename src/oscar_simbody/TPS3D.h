@@ -5,7 +5,9 @@
 #include <oscar/Graphics/Mesh.h>
 #include <oscar/Maths/Vec3.h>
 
+#include <cstddef>
 #include <iosfwd>
+#include <memory>
 #include <span>
 #include <utility>
 #include <vector>
@@ -76,12 +78,97 @@ namespace osc
 
     std::ostream& operator<<(std::ostream&, const TPSCoefficients3D&);
 
+    // all coefficients in the 3D TPS equation, stored in a structure-of-arrays (SoA) layout
+    //
+    // i.e. this contains the same information as `TPSCoefficients3D`, but each component of the
+    //      non-affine terms is stored contiguously, so that the (vectorized) evaluation kernel can
+    //      load the same component of multiple terms with one contiguous load
+    struct TPSCoefficientsSoA3D final {
+
+        TPSCoefficientsSoA3D() = default;
+
+        explicit TPSCoefficientsSoA3D(const TPSCoefficients3D&);
+
+        friend bool operator==(const TPSCoefficientsSoA3D&, const TPSCoefficientsSoA3D&) = default;
+
+        size_t getNumNonAffineTerms() const { return controlPointsX.size(); }
+
+        // default the coefficients to an "identity" warp
+        Vec3 a1 = {0.0f, 0.0f, 0.0f};
+        Vec3 a2 = {1.0f, 0.0f, 0.0f};
+        Vec3 a3 = {0.0f, 1.0f, 0.0f};
+        Vec3 a4 = {0.0f, 0.0f, 1.0f};
+        std::vector<float> controlPointsX;
+        std::vector<float> controlPointsY;
+        std::vector<float> controlPointsZ;
+        std::vector<float> weightsX;
+        std::vector<float> weightsY;
+        std::vector<float> weightsZ;
+    };
+
+    // the method that `CalcCoefficients` uses to solve the TPS system of equations
+    enum class TPSCoefficientSolverStrategy {
+        // uses `Symmetric` if there are at most `TPSCoefficientSolverOptions3D::maxLandmarksForSymmetricSolver`
+        // landmarks, and `Iterative` otherwise
+        Automatic,
+
+        // factorizes the entire (N+4)x(N+4) system with a general-purpose (QTZ) factorization,
+        // which is O(N^3) time and O(N^2) memory. Slowest, but yields a least-squares solution
+        // for degenerate inputs (e.g. duplicate or coplanar landmarks)
+        General,
+
+        // projects the system onto the null space of the affine constraints and factorizes the
+        // resulting (symmetric positive-definite) (N-4)x(N-4) matrix with a (multithreaded) Cholesky
+        // factorization. Still O(N^3) time and O(N^2) memory, but with a much smaller constant
+        Symmetric,
+
+        // solves the projected system with the conjugate gradient method, which evaluates the
+        // (N-4)x(N-4) matrix on-the-fly, so that it only uses O(N) memory and O(N^2) time per
+        // iteration (typically, a few hundred iterations for thousands of landmarks). If it doesn't
+        // converge within `iterativeSolverMaxIterations` iterations, it falls back to `Symmetric` if
+        // there are at most `maxLandmarksForSymmetricSolver` landmarks, or uses the approximate
+        // solution from its last iteration otherwise (so that it never uses O(N^2) memory)
+        Iterative,
+
+        NUM_OPTIONS,
+
+        Default = Automatic,
+    };
+
+    // options that affect how `CalcCoefficients` solves for the coefficients
+    //
+    // all strategies solve the same system of equations, and fall back to `General` for
+    // degenerate inputs, so the resulting coefficients only differ by numerical error
+    struct TPSCoefficientSolverOptions3D final {
+        TPSCoefficientSolverStrategy strategy = TPSCoefficientSolverStrategy::Default;
+
+        // the maximum number of landmarks that the `Automatic` strategy solves with `Symmetric`, and
+        // that the `Iterative` strategy falls back to `Symmetric` for
+        size_t maxLandmarksForSymmetricSolver = 5000;
+
+        // the `Iterative` solver stops once the residual is this fraction of the right-hand side
+        double iterativeSolverTolerance = 1e-7;
+
+        // the `Iterative` solver gives up (see `TPSCoefficientSolverStrategy::Iterative`) after this many iterations
+        size_t iterativeSolverMaxIterations = 2000;
+    };
+
     // computes all coefficients of the 3D TPS equation (a1, a2, a3, a4, and all the w's)
-    TPSCoefficients3D CalcCoefficients(const TPSCoefficientSolverInputs3D&);
+    TPSCoefficients3D CalcCoefficients(
+        const TPSCoefficientSolverInputs3D&,
+        const TPSCoefficientSolverOptions3D& = {}
+    );
 
     // evaluates the TPS equation with the given coefficients and input point
     Vec3 EvaluateTPSEquation(const TPSCoefficients3D&, Vec3);
 
+    // evaluates the TPS equation with the given coefficients for each input point, writing the
+    // results to the corresponding element of `out` (`points` and `out` may be the same span)
+    //
+    // this evaluates multiple points at once, so it's faster than evaluating each point with the
+    // single-point overload, but produces the same results
+    void EvaluateTPSEquation(const TPSCoefficientsSoA3D&, std::span<const Vec3> points, std::span<Vec3> out);
+
     // returns a mesh that is the equivalent of applying the 3D TPS warp to the mesh
     Mesh ApplyThinPlateWarpToMeshVertices(const TPSCoefficients3D&, const Mesh&, float blendingFactor);
 
@@ -90,4 +177,54 @@ namespace osc
 
     // applies the 3D TPS warp in-place to each SimTK::Vec3 in the provided span
     void ApplyThinPlateWarpToPointsInPlace(const TPSCoefficients3D&, std::span<Vec3>, float blendingFactor);
+
+    // applies the 3D TPS warp in-place to each point in the provided span, using coefficients that
+    // are already in a SoA layout (e.g. because the caller warps many spans with the same coefficients)
+    void ApplyThinPlateWarpToPointsInPlace(const TPSCoefficientsSoA3D&, std::span<Vec3>, float blendingFactor);
+
+    // parameters for approximately evaluating the 3D TPS equation (see `TPSApproximateEvaluator3D`)
+    struct TPSApproximationParameters3D final {
+        friend bool operator==(const TPSApproximationParameters3D&, const TPSApproximationParameters3D&) = default;
+
+        // the maximum absolute error of each component of each evaluated point, relative to
+        // `EvaluateTPSEquation` (excluding floating-point rounding errors)
+        double maxAbsoluteError = 1e-5;
+
+        // the maximum number of control points in each leaf of the octree
+        size_t maxControlPointsPerLeaf = 32;
+    };
+
+    // approximately evaluates the 3D TPS equation, which is much faster than evaluating it exactly
+    // (O(log(N)) vs. O(N) per point) when the equation has many (e.g. thousands of) non-affine terms
+    //
+    // the control points are clustered in an octree. Each cluster that's sufficiently far away from
+    // the evaluated point is evaluated via a far-field (Taylor) expansion of its terms, rather than
+    // term-by-term. How far away "sufficiently far" is depends on `maxAbsoluteError`: the (worst-case)
+    // error bound is conservative, so the actual error is usually much smaller than it
+    class TPSApproximateEvaluator3D final {
+    public:
+        explicit TPSApproximateEvaluator3D(
+            const TPSCoefficients3D&,
+            const TPSApproximationParameters3D& = {}
+        );
+
+        const TPSApproximationParameters3D& getParameters() const;
+
+        // approximately evaluates the TPS equation for the given point
+        Vec3 evaluate(Vec3) const;
+
+        // approximately evaluates the TPS equation for each input point, writing the results to the
+        // corresponding element of `out` (`points` and `out` may be the same span)
+        void evaluate(std::span<const Vec3> points, std::span<Vec3> out) const;
+
+    private:
+        class Impl;
+        std::shared_ptr<const Impl> m_Impl;
+    };
+
+    // returns a mesh that is the equivalent of applying the (approximated) 3D TPS warp to the mesh
+    Mesh ApplyThinPlateWarpToMeshVertices(const TPSApproximateEvaluator3D&, const Mesh&, float blendingFactor);
+
+    // applies the (approximated) 3D TPS warp in-place to each point in the provided span
+    void ApplyThinPlateWarpToPointsInPlace(const TPSApproximateEvaluator3D&, std::span<Vec3>, float blendingFactor);
 }
@@ -0,0 +1,204 @@
+#include "Benchmarks.h"
+
+#include <BenchOpenSimCreator/BenchOpenSimCreatorConfig.h>
+
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshIndicesView.h>
+#include <oscar/Maths/AABB.h>
+#include <oscar/Maths/AABBFunctions.h>
+#include <oscar/Maths/BVH.h>
+#include <oscar/Maths/Line.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Maths/VecFunctions.h>
+#include <oscar/Utils/EnumHelpers.h>
+#include <oscar_simbody/SimTKMeshLoader.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // the number of rays that are cast against each mesh when measuring query times
+    constexpr size_t c_NumQueryRays = 1000;
+    constexpr size_t c_SmokeNumMeshes = 3;
+
+    std::string_view GetStrategyName(BVHBuildStrategy strategy)
+    {
+        static_assert(num_options<BVHBuildStrategy>() == 2);
+        switch (strategy) {
+        case BVHBuildStrategy::SurfaceAreaHeuristic: return "SurfaceAreaHeuristic";
+        case BVHBuildStrategy::LongestAxisMidpoint:  return "LongestAxisMidpoint";
+        default:                                     return "Unknown";
+        }
+    }
+
+    struct BenchmarkedMesh final {
+        std::string name;
+        std::vector<Vec3> vertices;
+        std::vector<uint32_t> indices;
+    };
+
+    // loads all (SimTK-loadable) meshes from the bundled geometry directory, ordered by name
+    std::vector<BenchmarkedMesh> LoadBundledGeometry(bool smoke)
+    {
+        std::vector<std::filesystem::path> paths;
+        for (const auto& entry : std::filesystem::directory_iterator{std::filesystem::path{OSC_RESOURCES_DIR} / "geometry"}) {
+            std::string extension = entry.path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+            const auto formats = GetSupportedSimTKMeshFormats();
+            if (entry.is_regular_file() and not extension.empty() and std::find(formats.begin(), formats.end(), extension.substr(1)) != formats.end()) {
+                paths.push_back(entry.path());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+        if (smoke and paths.size() > c_SmokeNumMeshes) {
+            paths.resize(c_SmokeNumMeshes);
+        }
+
+        std::vector<BenchmarkedMesh> rv;
+        rv.reserve(paths.size());
+        for (const std::filesystem::path& path : paths) {
+            try {
+                const Mesh mesh = LoadMeshViaSimTK(path);
+                const MeshIndicesView indices = mesh.indices();
+                rv.push_back({path.filename().string(), mesh.vertices(), std::vector<uint32_t>(indices.begin(), indices.end())});
+            }
+            catch (const std::exception& ex) {
+                std::cerr << path.string() << ": skipped: " << ex.what() << '\n';
+            }
+        }
+        return rv;
+    }
+
+    // returns rays that start outside of the mesh's bounds and point at a random point within them
+    std::vector<Line> GenerateQueryRays(const BenchmarkedMesh& mesh)
+    {
+        if (mesh.vertices.empty()) {
+            return {};
+        }
+
+        const AABB bounds = bounding_aabb_of(mesh.vertices);
+        const Vec3 dims = dimensions_of(bounds);
+        const float outsideDistance = 2.0f * std::max({dims.x, dims.y, dims.z, 1e-3f});
+
+        std::default_random_engine rng{static_cast<std::default_random_engine::result_type>(mesh.vertices.size())};
+        std::uniform_real_distribution<float> dist{0.0f, 1.0f};
+        const auto randomVec = [&rng, &dist]() { return Vec3{dist(rng), dist(rng), dist(rng)}; };
+
+        std::vector<Line> rv;
+        rv.reserve(c_NumQueryRays);
+        for (size_t i = 0; i < c_NumQueryRays; ++i) {
+            const Vec3 target = bounds.min + dims * randomVec();
+            const Vec3 direction = normalize(randomVec() - 0.5f);
+            rv.push_back(Line{target - outsideDistance*direction, direction});
+        }
+        return rv;
+    }
+
+    BenchmarkResult RunBenchmark(
+        std::string name,
+        std::span<const BenchmarkedMesh> meshes,
+        BVHBuildStrategy strategy)
+    {
+        using Clock = std::chrono::high_resolution_clock;
+
+        std::chrono::duration<double> buildTime{};
+        std::chrono::duration<double> queryTime{};
+        std::chrono::duration<double> batchedQueryTime{};
+        size_t numTriangles = 0;
+        size_t maxDepth = 0;
+        size_t numQueries = 0;
+        size_t numHits = 0;
+        size_t numBatchedHits = 0;
+
+        for (const BenchmarkedMesh& mesh : meshes) {
+            BVH bvh;
+            const auto buildStart = Clock::now();
+            bvh.build_from_indexed_triangles(mesh.vertices, mesh.indices, strategy);
+            buildTime += Clock::now() - buildStart;
+
+            numTriangles += bvh.num_prims();
+            maxDepth = std::max(maxDepth, bvh.max_depth());
+
+            const std::vector<Line> rays = GenerateQueryRays(mesh);
+            const auto queryStart = Clock::now();
+            for (const Line& ray : rays) {
+                if (bvh.closest_ray_indexed_triangle_collision(mesh.vertices, mesh.indices, ray)) {
+                    ++numHits;
+                }
+            }
+            queryTime += Clock::now() - queryStart;
+            numQueries += rays.size();
+
+            const auto batchedQueryStart = Clock::now();
+            const auto batchedCollisions = bvh.closest_ray_indexed_triangle_collisions(mesh.vertices, mesh.indices, rays);
+            batchedQueryTime += Clock::now() - batchedQueryStart;
+            numBatchedHits += static_cast<size_t>(std::count_if(batchedCollisions.begin(), batchedCollisions.end(), [](const auto& c) { return c.has_value(); }));
+        }
+
+        BenchmarkResult rv{std::move(name), {}};
+        rv.metrics.emplace_back("num_meshes", static_cast<double>(meshes.size()));
+        rv.metrics.emplace_back("num_triangles", static_cast<double>(numTriangles));
+        rv.metrics.emplace_back("build_time_ms", 1e3 * buildTime.count());
+        rv.metrics.emplace_back("build_time_per_million_triangles_ms", 1e9 * buildTime.count() / static_cast<double>(std::max<size_t>(numTriangles, 1)));
+        rv.metrics.emplace_back("max_depth", static_cast<double>(maxDepth));
+        rv.metrics.emplace_back("num_ray_queries", static_cast<double>(numQueries));
+        rv.metrics.emplace_back("num_ray_hits", static_cast<double>(numHits));  // should be the same for each strategy
+        rv.metrics.emplace_back("ray_query_time_us", 1e6 * queryTime.count() / static_cast<double>(std::max<size_t>(numQueries, 1)));
+        rv.metrics.emplace_back("num_batched_ray_hits", static_cast<double>(numBatchedHits));  // should be the same as `num_ray_hits`
+        rv.metrics.emplace_back("batched_ray_query_time_us", 1e6 * batchedQueryTime.count() / static_cast<double>(std::max<size_t>(numQueries, 1)));
+        return rv;
+    }
+}
+
+std::vector<BenchmarkResult> osc::RunBVHBenchmarks(const BenchmarkOptions& options)
+{
+    std::vector<BenchmarkResult> rv;
+    std::optional<std::vector<BenchmarkedMesh>> meshes;  // lazily loaded, in case everything is filtered out
+
+    for (const BVHBuildStrategy strategy : make_option_iterable<BVHBuildStrategy>()) {
+        const std::string allName = "BVH/BundledGeometry/" + std::string{GetStrategyName(strategy)};
+        const std::string largestName = "BVH/LargestBundledMesh/" + std::string{GetStrategyName(strategy)};
+        const bool runAll = ShouldRun(options, allName);
+        const bool runLargest = ShouldRun(options, largestName);
+        if (not runAll and not runLargest) {
+            continue;
+        }
+
+        if (not meshes) {
+            meshes = LoadBundledGeometry(options.smoke);
+        }
+        if (meshes->empty()) {
+            break;
+        }
+
+        if (runAll) {
+            std::cerr << allName << '\n';  // progress (stdout may be used for the results)
+            rv.push_back(RunBenchmark(allName, *meshes, strategy));
+        }
+        if (runLargest) {
+            const auto largest = std::max_element(meshes->begin(), meshes->end(), [](const BenchmarkedMesh& a, const BenchmarkedMesh& b)
+            {
+                return a.indices.size() < b.indices.size();
+            });
+            std::cerr << largestName << " (" << largest->name << ")\n";
+            rv.push_back(RunBenchmark(largestName, {&*largest, 1}, strategy));
+        }
+    }
+    return rv;
+}
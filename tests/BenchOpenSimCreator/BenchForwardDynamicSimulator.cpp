@@ -0,0 +1,227 @@
+#include "Benchmarks.h"
+
+#include <BenchOpenSimCreator/BenchOpenSimCreatorConfig.h>
+
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulator.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/IntegratorMethod.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReportSequence.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
+#include <Simbody.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    struct BenchmarkedModel final {
+        std::string_view name;
+        std::string_view pathWithinModelsDir;
+    };
+
+    // bundled example models, ordered (roughly) from cheapest to most expensive to simulate
+    constexpr auto c_BenchmarkedModels = std::to_array<BenchmarkedModel>({
+        {"DoublePendulum", "DoublePendulum/double_pendulum.osim"},
+        {"Arm26", "Arm26/arm26.osim"},
+        {"ToyLanding", "ToyLanding/ToyLandingModel.osim"},
+    });
+
+    // how long (in simulated seconds) each simulation runs for, unless overridden by the caller
+    constexpr double c_DefaultFinalTime = 0.5;
+    constexpr double c_SmokeFinalTime = 0.01;
+
+    // the capacity of the report queue between the simulator and the benchmark thread
+    constexpr size_t c_ReportQueueCapacity = 1024;
+
+    // the maximum number of reports that are sampled when measuring per-stage realization times
+    constexpr size_t c_MaxRealizationSamples = 100;
+
+    // the stages that per-stage realization times are measured for (in realization order)
+    constexpr auto c_RealizationStages = std::to_array<std::pair<SimTK::Stage::Level, std::string_view>>({
+        {SimTK::Stage::Time, "time"},
+        {SimTK::Stage::Position, "position"},
+        {SimTK::Stage::Velocity, "velocity"},
+        {SimTK::Stage::Dynamics, "dynamics"},
+        {SimTK::Stage::Acceleration, "acceleration"},
+        {SimTK::Stage::Report, "report"},
+    });
+
+    OutputExtractor GetSimulatorOutputExtractor(std::string_view name)
+    {
+        for (int i = 0, len = GetNumFdSimulatorOutputExtractors(); i < len; ++i) {
+            OutputExtractor o = GetFdSimulatorOutputExtractor(i);
+            if (o.getName() == name) {
+                return o;
+            }
+        }
+        std::stringstream msg;
+        msg << "cannot find a simulator output called '" << name << "'";
+        throw std::runtime_error{std::move(msg).str()};
+    }
+
+    struct SimulationRun final {
+        SimulationStatus status = SimulationStatus::Error;
+        std::vector<SimulationReport> reports;
+    };
+
+    // runs a forward-dynamic simulation to completion on a background thread, while this
+    // thread collects its reports (as the UI would)
+    SimulationRun RunSimulation(const BasicModelStatePair& modelState, const ForwardDynamicSimulatorParams& params)
+    {
+        using namespace std::literals;
+
+        auto queue = std::make_shared<SimulationReportQueue>(c_ReportQueueCapacity);
+        ForwardDynamicSimulator simulator{modelState, params, queue};
+
+        SimulationRun rv;
+        const auto collect = [&rv](SimulationReport&& report) { rv.reports.push_back(std::move(report)); };
+        while (IsActive(simulator.getStatus())) {
+            if (queue->drain(collect) == 0) {
+                std::this_thread::sleep_for(1ms);
+            }
+        }
+        simulator.join();
+        queue->drain(collect);  // i.e. reports that were emitted after the last drain
+
+        rv.status = simulator.getStatus();
+        return rv;
+    }
+
+    // returns the (approximate) number of bytes that a simulation spends storing each report
+    double CalcMemoryPerReport(std::span<const SimulationReport> reports, size_t numFullPrecisionReports)
+    {
+        SimulationReportSequence sequence{numFullPrecisionReports};
+        for (const SimulationReport& report : reports) {
+            sequence.push_back(report);
+        }
+        return static_cast<double>(sequence.getApproximateMemoryUsage()) / static_cast<double>(reports.size());
+    }
+
+    // adds the average time that it takes to realize (a sample of) the reports' states to each
+    // stage as metrics
+    void AddRealizationTimeMetrics(
+        const OpenSim::Model& model,
+        std::span<const SimulationReport> reports,
+        BenchmarkResult& result)
+    {
+        const SimTK::MultibodySystem& system = model.getMultibodySystem();
+        const size_t stride = std::max<size_t>(1, reports.size() / c_MaxRealizationSamples);
+
+        std::array<std::chrono::duration<double>, c_RealizationStages.size()> totals{};
+        size_t numSamples = 0;
+        for (size_t i = 0; i < reports.size(); i += stride) {
+            SimTK::State state{reports[i].getState()};
+            state.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+            system.realize(state, SimTK::Stage::Instance);
+
+            for (size_t stage = 0; stage < c_RealizationStages.size(); ++stage) {
+                const auto tStart = std::chrono::high_resolution_clock::now();
+                system.realize(state, c_RealizationStages[stage].first);
+                totals[stage] += std::chrono::high_resolution_clock::now() - tStart;
+            }
+            ++numSamples;
+        }
+
+        for (size_t stage = 0; stage < c_RealizationStages.size(); ++stage) {
+            const double meanMicroseconds = 1e6 * totals[stage].count() / static_cast<double>(numSamples);
+            result.metrics.emplace_back("realize_" + std::string{c_RealizationStages[stage].second} + "_us", meanMicroseconds);
+        }
+    }
+
+    BenchmarkResult RunBenchmark(
+        std::string name,
+        const BasicModelStatePair& modelState,
+        const ForwardDynamicSimulatorParams& params)
+    {
+        BenchmarkResult rv{std::move(name), {}};
+
+        const SimulationRun run = RunSimulation(modelState, params);
+        const bool completed = run.status == SimulationStatus::Completed and not run.reports.empty();
+        rv.metrics.emplace_back("completed", completed ? 1.0 : 0.0);
+        if (not completed) {
+            return rv;  // the other metrics would be misleading
+        }
+
+        const OpenSim::Model& model = modelState.getModel();
+        const SimulationReport& lastReport = run.reports.back();
+        const auto simulatorOutput = [&model, &lastReport](std::string_view outputName)
+        {
+            return static_cast<double>(GetSimulatorOutputExtractor(outputName).getValueFloat(model, lastReport));
+        };
+
+        const double wallTime = simulatorOutput("Wall time");
+        const double numStepsTaken = simulatorOutput("NumStepsTaken");
+        const double reportCreationTime = simulatorOutput("Report Creation Time");
+        const auto numReports = static_cast<double>(run.reports.size());
+
+        rv.metrics.emplace_back("simulated_time_s", lastReport.getState().getTime());
+        rv.metrics.emplace_back("wall_time_s", wallTime);
+        rv.metrics.emplace_back("num_steps_taken", numStepsTaken);
+        rv.metrics.emplace_back("steps_per_second", numStepsTaken / wallTime);
+        rv.metrics.emplace_back("num_realizations", simulatorOutput("NumRealizations"));
+        rv.metrics.emplace_back("num_reports", numReports);
+        rv.metrics.emplace_back("num_state_variables", static_cast<double>(lastReport.getState().getNY()));
+        rv.metrics.emplace_back("report_creation_time_s", reportCreationTime);
+        rv.metrics.emplace_back("report_creation_time_per_report_us", 1e6 * reportCreationTime / numReports);
+        rv.metrics.emplace_back("report_queue_stall_time_s", simulatorOutput("Report Queue Stall Time"));
+        rv.metrics.emplace_back("memory_per_report_bytes", CalcMemoryPerReport(run.reports, run.reports.size()));
+        rv.metrics.emplace_back("compacted_memory_per_report_bytes", CalcMemoryPerReport(run.reports, 0));
+        AddRealizationTimeMetrics(model, run.reports, rv);
+
+        return rv;
+    }
+}
+
+std::vector<BenchmarkResult> osc::RunForwardDynamicSimulatorBenchmarks(const BenchmarkOptions& options)
+{
+    const double finalTime = options.finalTime.value_or(options.smoke ? c_SmokeFinalTime : c_DefaultFinalTime);
+    const std::span<const BenchmarkedModel> models = options.smoke ?
+        std::span<const BenchmarkedModel>{c_BenchmarkedModels}.first(1) :
+        std::span<const BenchmarkedModel>{c_BenchmarkedModels};
+
+    std::vector<BenchmarkResult> rv;
+    for (const BenchmarkedModel& benchmarkedModel : models) {
+        std::optional<BasicModelStatePair> modelState;  // lazily loaded, in case everything is filtered out
+
+        for (const IntegratorMethod method : IntegratorMethod::all()) {
+            std::stringstream name;
+            name << "ForwardDynamicSimulator/" << benchmarkedModel.name << '/' << method.label();
+            if (not ShouldRun(options, name.str())) {
+                continue;
+            }
+
+            if (not modelState) {
+                modelState.emplace(std::filesystem::path{OSC_RESOURCES_DIR} / "models" / benchmarkedModel.pathWithinModelsDir);
+            }
+
+            ForwardDynamicSimulatorParams params;
+            params.finalTime = SimulationClock::start() + SimulationClock::duration{finalTime};
+            params.integratorMethodUsed = method;
+
+            std::cerr << name.str() << '\n';  // progress (stdout may be used for the results)
+            rv.push_back(RunBenchmark(std::move(name).str(), *modelState, params));
+        }
+    }
+    return rv;
+}
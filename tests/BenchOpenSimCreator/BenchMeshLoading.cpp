@@ -0,0 +1,96 @@
+#include "Benchmarks.h"
+
+#include <BenchOpenSimCreator/BenchOpenSimCreatorConfig.h>
+
+#include <oscar/Formats/MeshFile.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar_simbody/SimTKMeshLoader.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    constexpr size_t c_SmokeNumMeshFiles = 3;
+
+    // returns the paths of all (loadable) mesh files in the bundled geometry directory, ordered by name
+    std::vector<std::filesystem::path> FindBundledMeshFiles(bool smoke)
+    {
+        std::vector<std::filesystem::path> rv;
+        for (const auto& entry : std::filesystem::directory_iterator{std::filesystem::path{OSC_RESOURCES_DIR} / "geometry"}) {
+            if (entry.is_regular_file() and is_supported_mesh_file(entry.path())) {
+                rv.push_back(entry.path());
+            }
+        }
+        std::sort(rv.begin(), rv.end());
+        if (smoke and rv.size() > c_SmokeNumMeshFiles) {
+            rv.resize(c_SmokeNumMeshFiles);
+        }
+        return rv;
+    }
+
+    BenchmarkResult RunBenchmark(
+        std::string name,
+        std::span<const std::filesystem::path> paths,
+        const std::function<Mesh(const std::filesystem::path&)>& loader)
+    {
+        using Clock = std::chrono::high_resolution_clock;
+
+        std::chrono::duration<double> loadTime{};
+        size_t numLoaded = 0;
+        size_t numTriangles = 0;
+        for (const std::filesystem::path& path : paths) {
+            try {
+                const auto loadStart = Clock::now();
+                const Mesh mesh = loader(path);
+                loadTime += Clock::now() - loadStart;
+
+                ++numLoaded;
+                numTriangles += mesh.num_indices() / 3;
+            }
+            catch (const std::exception& ex) {
+                std::cerr << path.string() << ": skipped: " << ex.what() << '\n';
+            }
+        }
+
+        BenchmarkResult rv{std::move(name), {}};
+        rv.metrics.emplace_back("num_mesh_files", static_cast<double>(numLoaded));
+        rv.metrics.emplace_back("num_triangles", static_cast<double>(numTriangles));  // should be the same for each loader
+        rv.metrics.emplace_back("load_time_ms", 1e3 * loadTime.count());
+        rv.metrics.emplace_back("load_time_per_mesh_file_ms", 1e3 * loadTime.count() / static_cast<double>(std::max<size_t>(numLoaded, 1)));
+        return rv;
+    }
+}
+
+std::vector<BenchmarkResult> osc::RunMeshLoadingBenchmarks(const BenchmarkOptions& options)
+{
+    const std::vector<std::pair<std::string, std::function<Mesh(const std::filesystem::path&)>>> loaders = {
+        {"MeshLoading/BundledGeometry/SimTK", [](const std::filesystem::path& p) { return LoadMeshViaSimTK(p); }},
+        {"MeshLoading/BundledGeometry/Native", [](const std::filesystem::path& p) { return LoadMeshFile(p); }},
+    };
+
+    std::vector<BenchmarkResult> rv;
+    std::vector<std::filesystem::path> paths;
+    for (const auto& [name, loader] : loaders) {
+        if (not ShouldRun(options, name)) {
+            continue;
+        }
+        if (paths.empty()) {
+            paths = FindBundledMeshFiles(options.smoke);
+        }
+        std::cerr << name << '\n';  // progress (stdout may be used for the results)
+        rv.push_back(RunBenchmark(name, paths, loader));
+    }
+    return rv;
+}
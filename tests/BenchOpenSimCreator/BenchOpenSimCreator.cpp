@@ -0,0 +1,105 @@
+#include "Benchmarks.h"
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    constexpr std::string_view c_Usage = R"(usage: BenchOpenSimCreator [OPTIONS]
+
+Runs OpenSim Creator's (headless) benchmarks and writes the results, as a JSON
+document, to the standard output (or to a file).
+
+options:
+    --filter STRING      only run benchmarks that have a name that contains STRING
+    --final-time SECS    simulate each benchmarked simulation for SECS simulated seconds
+    --output PATH        write the JSON results to PATH, rather than the standard output
+    --smoke              run a tiny workload (e.g. to check that the benchmarks still work)
+    --help               print this message and exit
+)";
+
+    struct CommandLineArgs final {
+        BenchmarkOptions options;
+        std::optional<std::string> outputPath;
+        bool help = false;
+    };
+
+    std::optional<CommandLineArgs> TryParseCommandLineArgs(int argc, char** argv)
+    {
+        CommandLineArgs rv;
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+
+            if (arg == "--help") {
+                rv.help = true;
+            }
+            else if (arg == "--smoke") {
+                rv.options.smoke = true;
+            }
+            else if (arg == "--filter" and hasValue) {
+                rv.options.filter = argv[++i];
+            }
+            else if (arg == "--final-time" and hasValue) {
+                rv.options.finalTime = std::stod(argv[++i]);
+            }
+            else if (arg == "--output" and hasValue) {
+                rv.outputPath = argv[++i];
+            }
+            else {
+                std::cerr << "BenchOpenSimCreator: unrecognized (or incomplete) argument: " << arg << '\n';
+                return std::nullopt;
+            }
+        }
+        return rv;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::optional<CommandLineArgs> args = TryParseCommandLineArgs(argc, argv);
+    if (not args) {
+        std::cerr << c_Usage;
+        return EXIT_FAILURE;
+    }
+    if (args->help) {
+        std::cout << c_Usage;
+        return EXIT_SUCCESS;
+    }
+
+    try {
+        std::vector<BenchmarkResult> results = RunForwardDynamicSimulatorBenchmarks(args->options);
+        for (BenchmarkResult& result : RunBVHBenchmarks(args->options)) {
+            results.push_back(std::move(result));
+        }
+        for (BenchmarkResult& result : RunMeshLoadingBenchmarks(args->options)) {
+            results.push_back(std::move(result));
+        }
+        for (BenchmarkResult& result : RunTPSBenchmarks(args->options)) {
+            results.push_back(std::move(result));
+        }
+
+        if (args->outputPath) {
+            std::ofstream out{*args->outputPath};
+            WriteBenchmarkResultsAsJSON(out, "BenchOpenSimCreator", results);
+        }
+        else {
+            WriteBenchmarkResultsAsJSON(std::cout, "BenchOpenSimCreator", results);
+        }
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "BenchOpenSimCreator: error running benchmarks: " << ex.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,317 @@
+#include "Benchmarks.h"
+
+#include <oscar/Maths/CommonFunctions.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/EnumHelpers.h>
+#include <oscar/Utils/ParalellizationHelpers.h>
+#include <oscar_simbody/LandmarkPair3D.h>
+#include <oscar_simbody/TPS3D.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // the number of times each warp is repeated (the fastest/mean times are reported)
+    constexpr size_t c_NumRepetitions = 5;
+    constexpr float c_BlendingFactor = 1.0f;
+
+    // (`ApplyThinPlateWarpToPointsInPlace` is overloaded, so its exact overload has to be selected)
+    using TPSWarpFunction = void(const TPSCoefficients3D&, std::span<Vec3>, float);
+    constexpr auto c_ExactWarp = static_cast<TPSWarpFunction*>(ApplyThinPlateWarpToPointsInPlace);
+
+    struct TPSWorkload final {
+        size_t numPoints;
+        size_t numLandmarks;
+    };
+
+    constexpr auto c_Workloads = std::to_array<TPSWorkload>({
+        {.numPoints = 10000,  .numLandmarks = 50},
+        {.numPoints = 100000, .numLandmarks = 500},
+        {.numPoints = 100000, .numLandmarks = 1000},
+    });
+    constexpr TPSWorkload c_SmokeWorkload = {.numPoints = 1000, .numLandmarks = 10};
+
+    // workloads for comparing `TPSApproximateEvaluator3D` with exact evaluation (coefficients for
+    // more than a few thousand landmarks are too expensive to solve for, so they're synthesized)
+    constexpr auto c_ApproximationWorkloads = std::to_array<TPSWorkload>({
+        {.numPoints = 100000, .numLandmarks = 2000},
+        {.numPoints = 20000,  .numLandmarks = 50000},
+    });
+    constexpr TPSWorkload c_SmokeApproximationWorkload = {.numPoints = 1000, .numLandmarks = 100};
+    constexpr size_t c_MaxLandmarksToSolveFor = 2000;
+    constexpr auto c_ApproximationMaxAbsoluteErrors = std::to_array({1e-2, 1e-4, 1e-6});
+
+    // the numbers of landmarks that each coefficient solver strategy is benchmarked with
+    constexpr auto c_SolverNumLandmarks = std::to_array<size_t>({500, 2000});
+    constexpr size_t c_SmokeSolverNumLandmarks = 20;
+
+    // the numbers of landmarks that only the `Iterative` strategy is benchmarked with (the others use
+    // O(N^2) memory), where it isn't allowed to fall back to `Symmetric`, so that `max_landmark_error`
+    // shows whether it converged
+    constexpr auto c_IterativeSolverNumLandmarks = std::to_array<size_t>({5000, 10000});
+    constexpr size_t c_SmokeIterativeSolverNumLandmarks = 50;
+
+    // the way that `ApplyThinPlateWarpToPointsInPlace` used to be implemented: each point is
+    // evaluated separately (with `for_each_parallel_unsequenced` spawning new threads per call)
+    void ApplyThinPlateWarpToPointsInPlacePerPoint(const TPSCoefficients3D& coefs, std::span<Vec3> points, float blendingFactor)
+    {
+        for_each_parallel_unsequenced(8192, points, [&coefs, blendingFactor](Vec3& vert)
+        {
+            vert = lerp(vert, EvaluateTPSEquation(coefs, vert), blendingFactor);
+        });
+    }
+
+    std::vector<Vec3> GenerateRandomPoints(std::default_random_engine& rng, size_t n)
+    {
+        std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+        std::vector<Vec3> rv;
+        rv.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            rv.emplace_back(dist(rng), dist(rng), dist(rng));
+        }
+        return rv;
+    }
+
+    TPSCoefficientSolverInputs3D GenerateInputs(std::default_random_engine& rng, size_t numLandmarks)
+    {
+        std::normal_distribution<float> noise{0.0f, 0.05f};
+        TPSCoefficientSolverInputs3D rv;
+        for (const Vec3& source : GenerateRandomPoints(rng, numLandmarks)) {
+            rv.landmarks.push_back({source, 1.2f*source + Vec3{noise(rng), noise(rng), noise(rng)}});
+        }
+        return rv;
+    }
+
+    TPSCoefficients3D GenerateCoefficients(std::default_random_engine& rng, size_t numLandmarks)
+    {
+        return CalcCoefficients(GenerateInputs(rng, numLandmarks));
+    }
+
+    // returns coefficients that have a similar structure to solved ones (zero-sum weights that are
+    // small compared to the affine terms), but without the (expensive) solve
+    TPSCoefficients3D GenerateSyntheticCoefficients(std::default_random_engine& rng, size_t numLandmarks)
+    {
+        std::normal_distribution<float> noise{0.0f, 1.0f / static_cast<float>(numLandmarks)};
+        TPSCoefficients3D rv;
+        rv.a2 = {1.2f, 0.0f, 0.0f};
+        rv.a3 = {0.0f, 1.2f, 0.0f};
+        rv.a4 = {0.0f, 0.0f, 1.2f};
+        Vec3 weightSum{};
+        for (const Vec3& controlPoint : GenerateRandomPoints(rng, numLandmarks)) {
+            const Vec3 weight{noise(rng), noise(rng), noise(rng)};
+            rv.nonAffineTerms.emplace_back(weight, controlPoint);
+            weightSum += weight;
+        }
+        for (TPSNonAffineTerm3D& term : rv.nonAffineTerms) {
+            term.weight -= weightSum / static_cast<float>(numLandmarks);
+        }
+        return rv;
+    }
+
+    std::string GetMaxAbsoluteErrorName(double maxAbsoluteError)
+    {
+        std::ostringstream ss;
+        ss << "MaxAbsoluteError" << maxAbsoluteError;
+        return std::move(ss).str();
+    }
+
+    std::string_view GetStrategyName(TPSCoefficientSolverStrategy strategy)
+    {
+        static_assert(num_options<TPSCoefficientSolverStrategy>() == 4);
+        switch (strategy) {
+        case TPSCoefficientSolverStrategy::Automatic: return "Automatic";
+        case TPSCoefficientSolverStrategy::General:   return "General";
+        case TPSCoefficientSolverStrategy::Symmetric: return "Symmetric";
+        case TPSCoefficientSolverStrategy::Iterative: return "Iterative";
+        default:                                      return "Unknown";
+        }
+    }
+
+    BenchmarkResult RunSolverBenchmark(
+        std::string name,
+        const TPSCoefficientSolverInputs3D& inputs,
+        const TPSCoefficientSolverOptions3D& solverOptions)
+    {
+        using Clock = std::chrono::high_resolution_clock;
+
+        const auto solveStart = Clock::now();
+        const TPSCoefficients3D coefs = CalcCoefficients(inputs, solverOptions);
+        const std::chrono::duration<double> solveTime = Clock::now() - solveStart;
+
+        // (sanity check: each strategy should warp the sources onto the destinations)
+        float maxError = 0.0f;
+        for (const LandmarkPair3D& landmark : inputs.landmarks) {
+            const Vec3 warped = EvaluateTPSEquation(coefs, landmark.source);
+            for (size_t dim = 0; dim < 3; ++dim) {
+                maxError = std::max(maxError, std::abs(warped[dim] - landmark.destination[dim]));
+            }
+        }
+
+        BenchmarkResult rv{std::move(name), {}};
+        rv.metrics.emplace_back("num_landmarks", static_cast<double>(inputs.landmarks.size()));
+        rv.metrics.emplace_back("solve_time_ms", 1e3 * solveTime.count());
+        rv.metrics.emplace_back("max_landmark_error", static_cast<double>(maxError));
+        return rv;
+    }
+
+    BenchmarkResult RunBenchmark(
+        std::string name,
+        const TPSCoefficients3D& coefs,
+        std::span<const Vec3> points,
+        std::span<const Vec3> expected,
+        const std::function<void(const TPSCoefficients3D&, std::span<Vec3>, float)>& warper)
+    {
+        using Clock = std::chrono::high_resolution_clock;
+
+        std::chrono::duration<double> fastestTime{std::numeric_limits<double>::max()};
+        std::chrono::duration<double> totalTime{};
+        std::vector<Vec3> warped;
+        for (size_t i = 0; i < c_NumRepetitions; ++i) {
+            warped.assign(points.begin(), points.end());
+
+            const auto warpStart = Clock::now();
+            warper(coefs, warped, c_BlendingFactor);
+            const std::chrono::duration<double> warpTime = Clock::now() - warpStart;
+
+            fastestTime = std::min(fastestTime, warpTime);
+            totalTime += warpTime;
+        }
+
+        // (sanity check: each implementation should produce the same warp)
+        float maxDifference = 0.0f;
+        for (size_t i = 0; i < warped.size(); ++i) {
+            for (size_t dim = 0; dim < 3; ++dim) {
+                maxDifference = std::max(maxDifference, std::abs(warped[i][dim] - expected[i][dim]));
+            }
+        }
+
+        BenchmarkResult rv{std::move(name), {}};
+        rv.metrics.emplace_back("num_points", static_cast<double>(points.size()));
+        rv.metrics.emplace_back("num_landmarks", static_cast<double>(coefs.nonAffineTerms.size()));
+        rv.metrics.emplace_back("fastest_warp_time_ms", 1e3 * fastestTime.count());
+        rv.metrics.emplace_back("mean_warp_time_ms", 1e3 * totalTime.count() / static_cast<double>(c_NumRepetitions));
+        rv.metrics.emplace_back("max_difference_from_per_point", static_cast<double>(maxDifference));
+        return rv;
+    }
+}
+
+std::vector<BenchmarkResult> osc::RunTPSBenchmarks(const BenchmarkOptions& options)
+{
+    const std::vector<std::pair<std::string, std::function<void(const TPSCoefficients3D&, std::span<Vec3>, float)>>> warpers = {
+        {"PerPoint", ApplyThinPlateWarpToPointsInPlacePerPoint},
+        {"Batched", c_ExactWarp},
+    };
+
+    std::vector<BenchmarkResult> rv;
+    for (const TPSWorkload& workload : options.smoke ? std::span<const TPSWorkload>{&c_SmokeWorkload, 1} : std::span<const TPSWorkload>{c_Workloads}) {
+        const std::string prefix = "TPS/" + std::to_string(workload.numPoints) + "Points" + std::to_string(workload.numLandmarks) + "Landmarks/";
+
+        // (lazily generated, because it's expensive to solve for coefficients)
+        std::default_random_engine rng{static_cast<std::default_random_engine::result_type>(workload.numLandmarks)};
+        TPSCoefficients3D coefs;
+        std::vector<Vec3> points;
+        std::vector<Vec3> expected;
+
+        for (const auto& [warperName, warper] : warpers) {
+            const std::string name = prefix + warperName;
+            if (not ShouldRun(options, name)) {
+                continue;
+            }
+            if (points.empty()) {
+                coefs = GenerateCoefficients(rng, workload.numLandmarks);
+                points = GenerateRandomPoints(rng, workload.numPoints);
+                expected = points;
+                ApplyThinPlateWarpToPointsInPlacePerPoint(coefs, expected, c_BlendingFactor);
+            }
+            std::cerr << name << '\n';  // progress (stdout may be used for the results)
+            rv.push_back(RunBenchmark(name, coefs, points, expected, warper));
+        }
+    }
+
+    for (const TPSWorkload& workload : options.smoke ? std::span<const TPSWorkload>{&c_SmokeApproximationWorkload, 1} : std::span<const TPSWorkload>{c_ApproximationWorkloads}) {
+        const std::string prefix = "TPS/Approximate/" + std::to_string(workload.numPoints) + "Points" + std::to_string(workload.numLandmarks) + "Landmarks/";
+
+        std::default_random_engine rng{static_cast<std::default_random_engine::result_type>(workload.numLandmarks)};
+        TPSCoefficients3D coefs;
+        std::vector<Vec3> points;
+        std::vector<Vec3> expected;
+        const auto lazilyGenerateWorkload = [&]()
+        {
+            if (not points.empty()) {
+                return;
+            }
+            coefs = workload.numLandmarks <= c_MaxLandmarksToSolveFor ?
+                GenerateCoefficients(rng, workload.numLandmarks) :
+                GenerateSyntheticCoefficients(rng, workload.numLandmarks);
+            points = GenerateRandomPoints(rng, workload.numPoints);
+            expected = points;
+            ApplyThinPlateWarpToPointsInPlacePerPoint(coefs, expected, c_BlendingFactor);
+        };
+
+        if (const std::string name = prefix + "Exact"; ShouldRun(options, name)) {
+            lazilyGenerateWorkload();
+            std::cerr << name << '\n';
+            rv.push_back(RunBenchmark(name, coefs, points, expected, c_ExactWarp));
+        }
+
+        for (const double maxAbsoluteError : c_ApproximationMaxAbsoluteErrors) {
+            const std::string name = prefix + GetMaxAbsoluteErrorName(maxAbsoluteError);
+            if (not ShouldRun(options, name)) {
+                continue;
+            }
+            lazilyGenerateWorkload();
+            std::cerr << name << '\n';
+            rv.push_back(RunBenchmark(name, coefs, points, expected, [maxAbsoluteError](const TPSCoefficients3D& warpCoefs, std::span<Vec3> warped, float blendingFactor)
+            {
+                // (includes building the evaluator, because it's rebuilt whenever the coefficients change)
+                const TPSApproximateEvaluator3D evaluator{warpCoefs, {.maxAbsoluteError = maxAbsoluteError}};
+                ApplyThinPlateWarpToPointsInPlace(evaluator, warped, blendingFactor);
+            }));
+        }
+    }
+
+    for (const size_t numLandmarks : options.smoke ? std::span<const size_t>{&c_SmokeSolverNumLandmarks, 1} : std::span<const size_t>{c_SolverNumLandmarks}) {
+        std::default_random_engine rng{static_cast<std::default_random_engine::result_type>(numLandmarks)};
+        const TPSCoefficientSolverInputs3D inputs = GenerateInputs(rng, numLandmarks);
+
+        for (size_t i = 0; i < num_options<TPSCoefficientSolverStrategy>(); ++i) {
+            const auto strategy = static_cast<TPSCoefficientSolverStrategy>(i);
+            const std::string name = "TPS/Solve/" + std::to_string(numLandmarks) + "Landmarks/" + std::string{GetStrategyName(strategy)};
+            if (not ShouldRun(options, name)) {
+                continue;
+            }
+            std::cerr << name << '\n';
+            rv.push_back(RunSolverBenchmark(name, inputs, {.strategy = strategy}));
+        }
+    }
+
+    for (const size_t numLandmarks : options.smoke ? std::span<const size_t>{&c_SmokeIterativeSolverNumLandmarks, 1} : std::span<const size_t>{c_IterativeSolverNumLandmarks}) {
+        const std::string name = "TPS/Solve/" + std::to_string(numLandmarks) + "Landmarks/Iterative";
+        if (not ShouldRun(options, name)) {
+            continue;
+        }
+        std::default_random_engine rng{static_cast<std::default_random_engine::result_type>(numLandmarks)};
+        std::cerr << name << '\n';
+        rv.push_back(RunSolverBenchmark(name, GenerateInputs(rng, numLandmarks), {
+            .strategy = TPSCoefficientSolverStrategy::Iterative,
+            .maxLandmarksForSymmetricSolver = 0,
+        }));
+    }
+    return rv;
+}
@@ -0,0 +1,85 @@
+#include "Benchmarks.h"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <locale>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <string_view>
+
+using namespace osc;
+
+namespace
+{
+    void WriteJSONString(std::ostream& out, std::string_view str)
+    {
+        out << '"';
+        for (const char c : str) {
+            switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:   out << c; break;
+            }
+        }
+        out << '"';
+    }
+
+    void WriteJSONNumber(std::ostream& out, double v)
+    {
+        if (std::isfinite(v)) {
+            out << v;
+        }
+        else {
+            out << "null";  // JSON has no representation for NaN/inf
+        }
+    }
+}
+
+bool osc::ShouldRun(const BenchmarkOptions& options, std::string_view benchmarkName)
+{
+    return benchmarkName.find(options.filter) != std::string_view::npos;
+}
+
+void osc::WriteBenchmarkResultsAsJSON(
+    std::ostream& out,
+    std::string_view suiteName,
+    std::span<const BenchmarkResult> results)
+{
+    // write into a (locale-independent, full-precision) buffer first, so that the
+    // caller's stream settings aren't affected
+    std::ostringstream ss;
+    ss.imbue(std::locale::classic());
+    ss.precision(std::numeric_limits<double>::max_digits10);
+
+    ss << "{\n";
+    ss << "  \"suite\": ";
+    WriteJSONString(ss, suiteName);
+    ss << ",\n";
+    ss << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& result = results[i];
+        ss << (i == 0 ? "\n" : ",\n");
+        ss << "    {\n";
+        ss << "      \"name\": ";
+        WriteJSONString(ss, result.name);
+        ss << ",\n";
+        ss << "      \"metrics\": {";
+        for (size_t j = 0; j < result.metrics.size(); ++j) {
+            ss << (j == 0 ? "\n" : ",\n");
+            ss << "        ";
+            WriteJSONString(ss, result.metrics[j].first);
+            ss << ": ";
+            WriteJSONNumber(ss, result.metrics[j].second);
+        }
+        ss << "\n      }\n";
+        ss << "    }";
+    }
+    ss << "\n  ]\n";
+    ss << "}\n";
+
+    out << std::move(ss).str();
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <iosfwd>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace osc
+{
+    // options that are passed to every benchmark suite
+    struct BenchmarkOptions final {
+
+        // only run benchmarks that have a name that contains this string
+        std::string filter;
+
+        // run a tiny workload, so that the benchmarks can be quickly smoke-tested (e.g. in CI)
+        bool smoke = false;
+
+        // if provided, overrides how long (in simulated seconds) simulation benchmarks run for
+        std::optional<double> finalTime;
+    };
+
+    // the measurements from running one benchmark (e.g. one model + integrator combination)
+    struct BenchmarkResult final {
+        std::string name;
+        std::vector<std::pair<std::string, double>> metrics;  // (name, value), in the order they were measured
+    };
+
+    // returns `true` if the benchmark with the given name should be ran
+    bool ShouldRun(const BenchmarkOptions&, std::string_view benchmarkName);
+
+    // writes the results to the output stream as a (machine-readable) JSON document
+    void WriteBenchmarkResultsAsJSON(
+        std::ostream&,
+        std::string_view suiteName,
+        std::span<const BenchmarkResult>
+    );
+
+    // benchmark suites
+    std::vector<BenchmarkResult> RunForwardDynamicSimulatorBenchmarks(const BenchmarkOptions&);
+    std::vector<BenchmarkResult> RunBVHBenchmarks(const BenchmarkOptions&);
+    std::vector<BenchmarkResult> RunMeshLoadingBenchmarks(const BenchmarkOptions&);
+    std::vector<BenchmarkResult> RunTPSBenchmarks(const BenchmarkOptions&);
+}
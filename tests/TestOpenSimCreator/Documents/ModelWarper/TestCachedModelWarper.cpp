@@ -1,13 +1,117 @@
 #include <OpenSimCreator/Documents/ModelWarper/CachedModelWarper.h>
 
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
 #include <gtest/gtest.h>
+#include <OpenSim/Simulation/Model/Geometry.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/Station.h>
+#include <OpenSim/Simulation/SimbodyEngine/Body.h>
+#include <OpenSim/Simulation/SimbodyEngine/WeldJoint.h>
+#include <OpenSimCreator/Documents/CustomComponents/InMemoryMesh.h>
 #include <OpenSimCreator/Documents/ModelWarper/WarpableModel.h>
 #include <OpenSimCreator/Utils/OpenSimHelpers.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
 
 using namespace osc;
 using namespace osc::mow;
 
+namespace
+{
+    std::filesystem::path GetFixturesDir()
+    {
+        auto p = std::filesystem::path{OSC_TESTING_RESOURCES_DIR} / "Document/ModelWarper";
+        p = std::filesystem::weakly_canonical(p);
+        return p;
+    }
+
+    // a temporary copy of the `Paired` fixture with a second (identically-paired) body+mesh and
+    // a station on each body, so that tests can edit one mesh's landmarks without affecting the other
+    class TwoMeshFixture final {
+    public:
+        TwoMeshFixture() :
+            m_Dir{std::filesystem::temp_directory_path() / ("osc_TestCachedModelWarper_" + std::to_string(std::random_device{}()))}
+        {
+            std::filesystem::copy(GetFixturesDir() / "Paired", m_Dir, std::filesystem::copy_options::recursive);
+            for (const char* dir : {"Geometry", "DestinationGeometry"}) {
+                std::filesystem::copy_file(m_Dir / dir / "sphere.obj", m_Dir / dir / "other.obj");
+                std::filesystem::copy_file(m_Dir / dir / "sphere.landmarks.csv", m_Dir / dir / "other.landmarks.csv");
+            }
+
+            OpenSim::Model model{(m_Dir / "model.osim").string()};
+            auto& otherBody = AddBody(model, std::make_unique<OpenSim::Body>("other_body", 1.0, SimTK::Vec3{0.0}, SimTK::Inertia{1.0}));
+            AttachGeometry(otherBody, std::make_unique<OpenSim::Mesh>("other.obj"));
+            AddJoint<OpenSim::WeldJoint>(model, "other_weldjoint", model.getGround(), otherBody);
+            const auto& body = model.getComponent<OpenSim::Body>("/bodyset/new_body");
+            AddModelComponent<OpenSim::Station>(model, body, SimTK::Vec3{0.1, 0.2, 0.3}).setName("station");
+            AddModelComponent<OpenSim::Station>(model, otherBody, SimTK::Vec3{0.1, 0.2, 0.3}).setName("other_station");
+            FinalizeConnections(model);
+            model.print((m_Dir / "model.osim").string());
+        }
+        TwoMeshFixture(const TwoMeshFixture&) = delete;
+        TwoMeshFixture(TwoMeshFixture&&) noexcept = delete;
+        TwoMeshFixture& operator=(const TwoMeshFixture&) = delete;
+        TwoMeshFixture& operator=(TwoMeshFixture&&) noexcept = delete;
+        ~TwoMeshFixture() noexcept
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(m_Dir, ec);
+        }
+
+        // (re)loads the fixture, which re-reads its landmark files
+        WarpableModel load(bool writeWarpedMeshesToDisk = false) const
+        {
+            WarpableModel rv{m_Dir / "model.osim"};
+            rv.setShouldWriteWarpedMeshesToDisk(writeWarpedMeshesToDisk);
+            return rv;
+        }
+
+        // changes the destination landmarks of the second (`other`) mesh
+        void editOtherMeshDestinationLandmarks() const
+        {
+            std::ofstream out{m_Dir / "DestinationGeometry" / "other.landmarks.csv", std::ios::trunc};
+            out << "name,x,y,z\n";
+            out << "landmark_0,-0.061925,1.500000,-0.102330\n";
+            out << "landmark_1,0.061730,1.000000,0.544677\n";
+            out << "landmark_2,0.300334,0.819465,0.940260\n";
+            out << "landmark_3,0.216009,0.202049,1.457034\n";
+            out << "landmark_4,0.630927,0.587238,0.758009\n";
+            out << "landmark_5,1.311265,0.881088,0.551223\n";
+            out << "landmark_6,0.805500,0.356062,0.559851\n";
+        }
+
+        std::filesystem::path warpedMeshFile(std::string_view meshFileName) const
+        {
+            return m_Dir / "WarpedGeometry" / meshFileName;
+        }
+
+    private:
+        std::filesystem::path m_Dir;
+    };
+
+    const Mesh& GetWarpedMesh(const IConstModelStatePair& warped, const std::string& geometryAbsPath)
+    {
+        return warped.getModel().getComponent<InMemoryMesh>(geometryAbsPath).getMesh();
+    }
+
+    SimTK::Vec3 GetWarpedStationLocation(const IConstModelStatePair& warped, const std::string& stationAbsPath)
+    {
+        return warped.getModel().getComponent<OpenSim::Station>(stationAbsPath).get_location();
+    }
+}
+
 TEST(CachedModelWarper, CanBeDefaultConstructed)
 {
     ASSERT_NO_THROW({ CachedModelWarper{}; });
@@ -26,3 +130,151 @@ TEST(CachedModelWarper, CanWarpDefaultConstructedModelWarpingDocument)
     InitializeModel(copy);
     InitializeState(copy);
 }
+
+TEST(CachedModelWarper, ReturnsSameResultWhenGivenSameDocument)
+{
+    const WarpableModel document{GetFixturesDir() / "Paired" / "model.osim"};
+    CachedModelWarper warper;
+
+    const auto first = warper.warp(document);
+    ASSERT_NE(first, nullptr);
+    ASSERT_EQ(warper.warp(document), first);
+}
+
+TEST(CachedModelWarper, ReplacesEachWarpedMeshWithAnInMemoryMesh)
+{
+    const WarpableModel document{GetFixturesDir() / "Paired" / "model.osim"};
+    CachedModelWarper warper;
+
+    const auto rv = warper.warp(document);
+    ASSERT_NE(rv, nullptr);
+    ASSERT_EQ(GetNumChildren<InMemoryMesh>(rv->getModel()), 1);
+
+    // ... and the warped mesh is still attached to the same frame as the source mesh
+    OpenSim::Model copy{rv->getModel()};
+    InitializeModel(copy);
+    InitializeState(copy);
+    ASSERT_EQ(GetNumChildren<InMemoryMesh>(copy), 1);
+    for (const auto& mesh : copy.getComponentList<InMemoryMesh>()) {
+        ASSERT_EQ(mesh.getFrame().getAbsolutePathString(), "/bodyset/new_body");
+    }
+}
+
+TEST(CachedModelWarper, ChangingTheBlendingFactorRewarpsTheModel)
+{
+    WarpableModel document{GetFixturesDir() / "Paired" / "model.osim"};
+    CachedModelWarper warper;
+
+    const auto first = warper.warp(document);
+    document.setWarpBlendingFactor(0.5f);
+    const auto second = warper.warp(document);
+
+    ASSERT_NE(second, nullptr);
+    ASSERT_NE(second, first);
+    ASSERT_EQ(GetNumChildren<InMemoryMesh>(second->getModel()), 1);
+}
+
+TEST(CachedModelWarper, ChangingTheMaxAbsoluteWarpErrorRewarpsTheModelWithinThatError)
+{
+    WarpableModel document{GetFixturesDir() / "Paired" / "model.osim"};
+    CachedModelWarper warper;
+
+    const auto exact = warper.warp(document);
+    ASSERT_NE(exact, nullptr);
+    constexpr double c_MaxAbsoluteError = 1e-3;
+    document.setMaxAbsoluteWarpError(c_MaxAbsoluteError);
+    const auto approximate = warper.warp(document);
+    ASSERT_NE(approximate, nullptr);
+    ASSERT_NE(approximate, exact);
+
+    const Mesh& exactMesh = GetWarpedMesh(*exact, "/bodyset/new_body/new_body_geom_1");
+    const Mesh& approximateMesh = GetWarpedMesh(*approximate, "/bodyset/new_body/new_body_geom_1");
+    const std::vector<Vec3> exactVertices = exactMesh.vertices();
+    const std::vector<Vec3> approximateVertices = approximateMesh.vertices();
+    ASSERT_EQ(approximateVertices.size(), exactVertices.size());
+    for (size_t i = 0; i < exactVertices.size(); ++i) {
+        for (size_t dim = 0; dim < 3; ++dim) {
+            ASSERT_NEAR(approximateVertices[i][dim], exactVertices[i][dim], c_MaxAbsoluteError + 1e-5);
+        }
+    }
+}
+
+TEST(CachedModelWarper, ChangingOneMeshsLandmarksOnlyRewarpsThatMesh)
+{
+    const TwoMeshFixture fixture;
+    CachedModelWarper warper;
+
+    const auto first = warper.warp(fixture.load());
+    ASSERT_NE(first, nullptr);
+    ASSERT_EQ(GetNumChildren<InMemoryMesh>(first->getModel()), 2);
+    const Mesh firstMesh = GetWarpedMesh(*first, "/bodyset/new_body/new_body_geom_1");
+    const Mesh firstOtherMesh = GetWarpedMesh(*first, "/bodyset/other_body/other_body_geom_1");
+
+    fixture.editOtherMeshDestinationLandmarks();
+    const auto second = warper.warp(fixture.load());
+    ASSERT_NE(second, nullptr);
+    ASSERT_NE(second, first);
+
+    // (`Mesh`es compare by identity, so equality means that the previous warped mesh was reused)
+    ASSERT_EQ(GetWarpedMesh(*second, "/bodyset/new_body/new_body_geom_1"), firstMesh) << "the unchanged mesh should keep its previously-warped mesh";
+    ASSERT_NE(GetWarpedMesh(*second, "/bodyset/other_body/other_body_geom_1"), firstOtherMesh) << "the mesh with changed landmarks should be re-warped";
+    ASSERT_NE(GetWarpedMesh(*second, "/bodyset/other_body/other_body_geom_1").vertices(), firstOtherMesh.vertices());
+}
+
+TEST(CachedModelWarper, ReloadingAnUnchangedDocumentKeepsThePreviouslyWarpedMeshes)
+{
+    const TwoMeshFixture fixture;
+    CachedModelWarper warper;
+
+    const auto first = warper.warp(fixture.load());
+    ASSERT_NE(first, nullptr);
+    const auto second = warper.warp(fixture.load());  // i.e. a different (but identical) document
+    ASSERT_NE(second, nullptr);
+
+    ASSERT_EQ(GetWarpedMesh(*second, "/bodyset/new_body/new_body_geom_1"), GetWarpedMesh(*first, "/bodyset/new_body/new_body_geom_1"));
+    ASSERT_EQ(GetWarpedMesh(*second, "/bodyset/other_body/other_body_geom_1"), GetWarpedMesh(*first, "/bodyset/other_body/other_body_geom_1"));
+}
+
+TEST(CachedModelWarper, UnchangedPointsKeepTheirWarpedLocation)
+{
+    const TwoMeshFixture fixture;
+    CachedModelWarper warper;
+
+    const auto first = warper.warp(fixture.load());
+    ASSERT_NE(first, nullptr);
+    const SimTK::Vec3 firstLocation = GetWarpedStationLocation(*first, "/station");
+    const SimTK::Vec3 firstOtherLocation = GetWarpedStationLocation(*first, "/other_station");
+    ASSERT_NE(firstLocation, SimTK::Vec3(0.1, 0.2, 0.3)) << "the station should be warped";
+    ASSERT_EQ(firstLocation, firstOtherLocation) << "both meshes have the same landmarks, so the stations should warp identically";
+
+    fixture.editOtherMeshDestinationLandmarks();
+    const auto second = warper.warp(fixture.load());
+    ASSERT_NE(second, nullptr);
+    ASSERT_EQ(GetWarpedStationLocation(*second, "/station"), firstLocation);
+    ASSERT_NE(GetWarpedStationLocation(*second, "/other_station"), firstOtherLocation);
+}
+
+TEST(CachedModelWarper, DoesNotRewriteUnchangedWarpedMeshFiles)
+{
+    using namespace std::literals;
+
+    const TwoMeshFixture fixture;
+    CachedModelWarper warper;
+
+    ASSERT_NE(warper.warp(fixture.load(true)), nullptr);
+    const std::filesystem::path meshFile = fixture.warpedMeshFile("sphere.obj");
+    const std::filesystem::path otherMeshFile = fixture.warpedMeshFile("other.obj");
+    ASSERT_TRUE(std::filesystem::exists(meshFile));
+    ASSERT_TRUE(std::filesystem::exists(otherMeshFile));
+
+    // backdate the written files, so that (re)writing them is detectable, regardless of the
+    // filesystem's timestamp resolution
+    const auto backdated = std::filesystem::last_write_time(meshFile) - 1h;
+    std::filesystem::last_write_time(meshFile, backdated);
+    std::filesystem::last_write_time(otherMeshFile, backdated);
+
+    fixture.editOtherMeshDestinationLandmarks();
+    ASSERT_NE(warper.warp(fixture.load(true)), nullptr);
+    ASSERT_EQ(std::filesystem::last_write_time(meshFile), backdated) << "the unchanged mesh's file shouldn't be rewritten";
+    ASSERT_NE(std::filesystem::last_write_time(otherMeshFile), backdated) << "the re-warped mesh's file should be rewritten";
+}
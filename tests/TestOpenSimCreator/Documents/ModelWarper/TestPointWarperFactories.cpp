@@ -382,3 +382,14 @@ TEST(ModelWarpingDocument, CorrectlyLoadsSparselyNamedPairedCase)
         ASSERT_TRUE(p->isFullyPaired());
     }
 }
+
+TEST(TPSLandmarkPairWarperFactory, IsEquivalentToFactoriesThatWereLoadedFromTheSameLandmarks)
+{
+    const std::filesystem::path modelDir = ModelWarperFixturesDir() / "Paired";
+    const TPSLandmarkPairWarperFactory factory{modelDir / "model.osim", modelDir / "Geometry" / "sphere.obj"};
+    const TPSLandmarkPairWarperFactory reloaded{modelDir / "model.osim", modelDir / "Geometry" / "sphere.obj"};
+
+    ASSERT_TRUE(factory.isEquivalentTo(factory));
+    ASSERT_TRUE(factory.isEquivalentTo(*factory.clone()));
+    ASSERT_TRUE(factory.isEquivalentTo(reloaded));
+}
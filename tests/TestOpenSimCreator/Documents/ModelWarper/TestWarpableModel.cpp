@@ -141,6 +141,30 @@ TEST(WarpableModel, WarpBlendingFactorClampedBetweenZeroAndOne)
     ASSERT_EQ(doc.getWarpBlendingFactor(), 1.0f);
 }
 
+TEST(WarpableModel, getMaxAbsoluteWarpError_InitiallyZero)
+{
+    // i.e. points are warped exactly, unless the caller opts into approximation
+    ASSERT_EQ(WarpableModel{}.getMaxAbsoluteWarpError(), 0.0);
+}
+
+TEST(WarpableModel, setMaxAbsoluteWarpError_ClampsNegativeValuesToZero)
+{
+    WarpableModel doc;
+    doc.setMaxAbsoluteWarpError(1e-4);
+    ASSERT_EQ(doc.getMaxAbsoluteWarpError(), 1e-4);
+    doc.setMaxAbsoluteWarpError(-1.0);
+    ASSERT_EQ(doc.getMaxAbsoluteWarpError(), 0.0);
+}
+
+TEST(WarpableModel, setMaxAbsoluteWarpError_ChangesEquality)
+{
+    WarpableModel a;
+    WarpableModel b = a;
+    ASSERT_EQ(a, b);
+    b.setMaxAbsoluteWarpError(1e-4);
+    ASSERT_NE(a, b);
+}
+
 TEST(WarpableModel, getShouldWriteWarpedMeshesToDisk_InitiallyFalse)
 {
     // this might be important, because the UI performs _much_ better if it doesn't
@@ -0,0 +1,59 @@
+#include <OpenSimCreator/Documents/OutputExtractors/ConcatenatingOutputExtractor.h>
+
+#include <OpenSimCreator/Documents/OutputExtractors/ConstantOutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSim/Simulation/Model/Station.h>
+#include <gtest/gtest.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Utils/Conversion.h>
+
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    ConcatenatingOutputExtractor MakeConcatenationOf(float first, float second)
+    {
+        return ConcatenatingOutputExtractor{
+            OutputExtractor{ConstantOutputExtractor{"first", first}},
+            OutputExtractor{ConstantOutputExtractor{"second", second}},
+        };
+    }
+}
+
+TEST(ConcatenatingOutputExtractor, HasTypeVec2WhenConcatenatingTwoFloats)
+{
+    ASSERT_EQ(MakeConcatenationOf(1.0f, 2.0f).getOutputType(), OutputExtractorDataType::Vec2);
+}
+
+TEST(ConcatenatingOutputExtractor, GetValueVec2ReturnsFirstAndSecondValues)
+{
+    const ConcatenatingOutputExtractor extractor = MakeConcatenationOf(1.0f, 2.0f);
+    const SimulationReport report;
+    const OpenSim::Station component;  // it doesn't matter which type of component it is for constant extractors
+
+    ASSERT_EQ(extractor.getValueVec2(component, report), Vec2(1.0f, 2.0f));
+}
+
+TEST(ConcatenatingOutputExtractor, OutputValueExtractorReturnsFirstAndSecondValues)
+{
+    // this is the (slower) type-erased path, which should match the typed one
+    const ConcatenatingOutputExtractor extractor = MakeConcatenationOf(1.0f, 2.0f);
+    const SimulationReport report;
+    const OpenSim::Station component;
+
+    ASSERT_EQ(to<Vec2>(extractor.getOutputValueExtractor(component)(report)), Vec2(1.0f, 2.0f));
+}
+
+TEST(ConcatenatingOutputExtractor, SlurpValuesVec2ReturnsOneValuePerReport)
+{
+    const ConcatenatingOutputExtractor extractor = MakeConcatenationOf(3.0f, 4.0f);
+    const std::vector<SimulationReport> reports(100);  // i.e. more than one extraction chunk
+    const OpenSim::Station component;
+
+    const std::vector<Vec2> values = extractor.slurpValuesVec2(component, reports);
+
+    ASSERT_EQ(values, std::vector<Vec2>(reports.size(), Vec2(3.0f, 4.0f)));
+}
@@ -0,0 +1,140 @@
+#include <OpenSimCreator/Documents/Simulation/BatchSimulation.h>
+
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulator.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/Simulation.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
+#include <gtest/gtest.h>
+#include <oscar/Formats/CSV.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::vector<BatchSimulationVariant> GenerateShortVariants(size_t n)
+    {
+        ForwardDynamicSimulatorParams params;
+        params.finalTime = SimulationClock::start() + SimulationClock::duration{0.1};
+
+        std::vector<BatchSimulationVariant> rv;
+        for (size_t i = 0; i < n; ++i) {
+            rv.push_back({.label = "variant" + std::to_string(i), .params = params, .modelEditor = {}});
+        }
+        return rv;
+    }
+
+    void TickUntilDone(BatchSimulation& batch)
+    {
+        for (int i = 0; i < 6000 and not batch.isDone(); ++i) {
+            batch.tick();
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+    }
+}
+
+TEST(BatchSimulation, DoesNotStartAnySimulationsUntilTicked)
+{
+    const BatchSimulation batch{BasicModelStatePair{}, GenerateShortVariants(3)};
+
+    ASSERT_EQ(batch.getNumVariants(), 3);
+    for (size_t i = 0; i < batch.getNumVariants(); ++i) {
+        ASSERT_EQ(batch.getSimulation(i), nullptr);
+        ASSERT_EQ(batch.getStatus(i), SimulationStatus::Initializing);
+    }
+    ASSERT_FALSE(batch.isDone());
+}
+
+TEST(BatchSimulation, TickNeverStartsMoreThanTheMaximumNumberOfConcurrentSimulations)
+{
+    BatchSimulation batch{BasicModelStatePair{}, GenerateShortVariants(4)};
+    batch.setMaxConcurrentSimulations(1);
+    batch.tick();
+
+    ASSERT_LE(batch.getNumActiveSimulations(), 1);
+    ASSERT_NE(batch.getSimulation(0), nullptr);
+    for (size_t i = 1; i < batch.getNumVariants(); ++i) {
+        ASSERT_EQ(batch.getSimulation(i), nullptr);
+    }
+    batch.stop();
+}
+
+TEST(BatchSimulation, RunsAllVariantsToCompletion)
+{
+    BatchSimulation batch{BasicModelStatePair{}, GenerateShortVariants(3), {GetFdSimulatorOutputExtractor(0)}};
+    batch.setMaxConcurrentSimulations(2);
+    TickUntilDone(batch);
+
+    ASSERT_TRUE(batch.isDone());
+    for (size_t i = 0; i < batch.getNumVariants(); ++i) {
+        ASSERT_EQ(batch.getStatus(i), SimulationStatus::Completed);
+        ASSERT_TRUE(batch.getLatestOutputValues(i).has_value());
+        ASSERT_EQ(batch.getLatestOutputValues(i)->size(), 1);
+    }
+}
+
+TEST(BatchSimulation, AppliesModelEditorToEachVariantsModel)
+{
+    std::atomic<int> numEdits = 0;
+    std::vector<BatchSimulationVariant> variants = GenerateShortVariants(2);
+    for (BatchSimulationVariant& variant : variants) {
+        variant.modelEditor = [&numEdits](OpenSim::Model& model)
+        {
+            model.setName("edited");
+            ++numEdits;
+        };
+    }
+
+    BatchSimulation batch{BasicModelStatePair{}, std::move(variants)};
+    TickUntilDone(batch);
+
+    ASSERT_EQ(numEdits, 2);
+    for (size_t i = 0; i < batch.getNumVariants(); ++i) {
+        ASSERT_EQ(batch.getSimulation(i)->getModel()->getName(), "edited");
+    }
+}
+
+TEST(BatchSimulation, WriteBatchSummaryAsCSVWritesOneRowPerVariant)
+{
+    BatchSimulation batch{BasicModelStatePair{}, GenerateShortVariants(3)};
+    TickUntilDone(batch);
+
+    std::stringstream out;
+    WriteBatchSummaryAsCSV(batch, out);
+
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(out, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 1 + batch.getNumVariants());
+    ASSERT_EQ(lines.front(), "label,status");
+}
+
+TEST(BatchSimulation, WriteBatchSummaryAsCSVEscapesLabels)
+{
+    std::vector<BatchSimulationVariant> variants = GenerateShortVariants(1);
+    variants.front().label = R"(max_isometric_force = 500, "fast")";
+
+    BatchSimulation batch{BasicModelStatePair{}, std::move(variants)};
+    TickUntilDone(batch);
+
+    std::stringstream out;
+    WriteBatchSummaryAsCSV(batch, out);
+
+    std::vector<std::string> header;
+    ASSERT_TRUE(read_csv_row_into_vector(out, header));
+    std::vector<std::string> row;
+    ASSERT_TRUE(read_csv_row_into_vector(out, row));
+    ASSERT_EQ(row.size(), header.size());
+    ASSERT_EQ(row.front(), R"(max_isometric_force = 500, "fast")");
+}
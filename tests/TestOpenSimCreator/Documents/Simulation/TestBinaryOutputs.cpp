@@ -0,0 +1,131 @@
+#include <OpenSimCreator/Documents/Simulation/BinaryOutputs.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Utils/TemporaryFile.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // returns a temporary file that contains the data written by `writer`
+    template<typename Writer>
+    TemporaryFile WriteToTemporaryFile(Writer writer)
+    {
+        TemporaryFile rv;
+        rv.close();
+        std::ofstream out{rv.absolute_path(), std::ios::binary};
+        writer(out);
+        return rv;
+    }
+}
+
+TEST(BinaryOutputs, WrittenBlocksCanBeReadBack)
+{
+    const std::vector<std::string> names = {"a", "b/0", "b/1"};
+    const std::vector<double> times1 = {0.0, 0.5, 1.0};
+    const std::vector<std::vector<float>> columns1 = {{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}, {7.0f, 8.0f, 9.0f}};
+    const std::vector<double> times2 = {1.5};
+    const std::vector<std::vector<float>> columns2 = {{10.0f}, {11.0f}, {12.0f}};
+
+    const TemporaryFile file = WriteToTemporaryFile([&](std::ostream& out)
+    {
+        BinaryOutputsWriter writer{out, names};
+        writer.writeBlock(times1, columns1);
+        writer.writeBlock(times2, columns2);
+        ASSERT_EQ(writer.getNumRowsWritten(), 4);
+    });
+
+    const BinaryOutputsFile read{file.absolute_path()};
+    ASSERT_EQ(read.getNumOutputColumns(), names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        ASSERT_EQ(read.getOutputColumnName(i), names[i]);
+    }
+    ASSERT_EQ(read.getNumBlocks(), 2);
+    ASSERT_EQ(read.getNumRows(), 4);
+    ASSERT_EQ(read.copyTimes(), (std::vector<double>{0.0, 0.5, 1.0, 1.5}));
+    ASSERT_EQ(read.copyOutputColumnValues(2), (std::vector<float>{7.0f, 8.0f, 9.0f, 12.0f}));
+    ASSERT_EQ(read.getOutputColumnValues(1, 1)[0], 11.0f);
+}
+
+TEST(BinaryOutputs, WriteBlockThrowsIfColumnsDoNotMatchHeader)
+{
+    const std::vector<std::string> names = {"a"};
+    std::ofstream out;
+    BinaryOutputsWriter writer{out, names};
+    const std::vector<double> times = {0.0};
+    ASSERT_THROW({ writer.writeBlock(times, std::vector<std::vector<float>>{}); }, std::runtime_error);
+    ASSERT_THROW({ writer.writeBlock(times, std::vector<std::vector<float>>{{1.0f, 2.0f}}); }, std::runtime_error);
+}
+
+TEST(BinaryOutputsFile, IgnoresTruncatedTrailingBlock)
+{
+    const std::vector<std::string> names = {"a"};
+    const TemporaryFile file = WriteToTemporaryFile([&](std::ostream& out)
+    {
+        BinaryOutputsWriter writer{out, names};
+        writer.writeBlock(std::vector<double>{0.0}, std::vector<std::vector<float>>{{1.0f}});
+
+        // emulate a partially-written block (e.g. because a simulation is still writing it)
+        const uint64_t numRows = 1000;
+        out.write(reinterpret_cast<const char*>(&numRows), sizeof(numRows));
+        out << "partial";
+    });
+
+    const BinaryOutputsFile read{file.absolute_path()};
+    ASSERT_EQ(read.getNumBlocks(), 1);
+    ASSERT_EQ(read.getNumRows(), 1);
+}
+
+TEST(BinaryOutputsFile, ThrowsIfFileIsNotABinaryOutputsFile)
+{
+    const TemporaryFile file = WriteToTemporaryFile([](std::ostream& out)
+    {
+        out << "time,a\n0,1\n";
+    });
+    ASSERT_THROW({ BinaryOutputsFile{file.absolute_path()}; }, std::runtime_error);
+}
+
+TEST(BinaryOutputsFile, IgnoresBlocksWithCorruptRowCounts)
+{
+    const std::vector<std::string> names = {"a", "b"};
+    for (const uint64_t numRows : {uint64_t{1} << 61, uint64_t{1} << 62, ~uint64_t{0}}) {
+        const TemporaryFile file = WriteToTemporaryFile([&](std::ostream& out)
+        {
+            BinaryOutputsWriter writer{out, names};
+            writer.writeBlock(std::vector<double>{0.0}, std::vector<std::vector<float>>{{1.0f}, {2.0f}});
+
+            // e.g. `(1 << 61) * sizeof(double)` overflows to zero, which would be a (wrong) zero-sized block
+            out.write(reinterpret_cast<const char*>(&numRows), sizeof(numRows));
+            const std::vector<char> junk(64, 'x');
+            out.write(junk.data(), static_cast<std::streamsize>(junk.size()));
+        });
+
+        const BinaryOutputsFile read{file.absolute_path()};
+        ASSERT_EQ(read.getNumBlocks(), 1);
+        ASSERT_EQ(read.getNumRows(), 1);
+        ASSERT_EQ(read.copyOutputColumnValues(1), std::vector<float>{2.0f});
+    }
+}
+
+TEST(BinaryOutputsFile, FindOutputColumnReturnsIndexOfColumnWithGivenName)
+{
+    const std::vector<std::string> names = {"a", "b/0", "b/1"};
+    const TemporaryFile file = WriteToTemporaryFile([&](std::ostream& out)
+    {
+        BinaryOutputsWriter writer{out, names};
+    });
+
+    const BinaryOutputsFile read{file.absolute_path()};
+    ASSERT_EQ(read.findOutputColumn("a"), 0);
+    ASSERT_EQ(read.findOutputColumn("b/1"), 2);
+    ASSERT_EQ(read.findOutputColumn("b"), std::nullopt);
+    ASSERT_EQ(read.findOutputColumn("c"), std::nullopt);
+}
@@ -2,10 +2,18 @@
 
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
 #include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationCheckpoint.h>
 #include <gtest/gtest.h>
+#include <oscar/Utils/UID.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
 
 using namespace osc;
 TEST(ForwardDynamicSimulation, CanInitFromBasicModel)
@@ -116,9 +124,11 @@ TEST(ForwardDynamicSimulation, DecreasingEndTimeWorksAsExpected)
     }
 
     // then decrease the end time, which shouldn't require waiting
+    const UID generationBeforeTruncation = sim.getReportsGeneration();
     sim.requestNewEndTime(SimulationClock::start() + 1s);
     ASSERT_EQ(sim.getStatus(), SimulationStatus::Completed);  // should be immediately true: in-memory truncation
     ASSERT_EQ(sim.getEndTime(), SimulationClock::start() + 1s);
+    ASSERT_NE(sim.getReportsGeneration(), generationBeforeTruncation) << "truncating the reports should invalidate anything that was extracted from them";
 
 
     // ensure the shrunk simulation is as-expected
@@ -129,3 +139,112 @@ TEST(ForwardDynamicSimulation, DecreasingEndTimeWorksAsExpected)
         ASSERT_EQ(reports.at(1).getTime(), SimulationClock::start() + 1s);
     }
 }
+
+TEST(ForwardDynamicSimulation, GetSimulationReportsReturnsTheRequestedRangeOfReports)
+{
+    using namespace std::literals;
+
+    BasicModelStatePair modelState;
+    ForwardDynamicSimulatorParams params;
+    params.finalTime = SimulationClock::start() + 1s;
+    params.reportingInterval = 100ms;
+
+    ForwardDynamicSimulation sim{modelState, params};
+    sim.join();
+    ASSERT_EQ(sim.getNumReports(), 11);
+
+    const auto reports = sim.getSimulationReports(3, 7);
+    ASSERT_EQ(reports.size(), 4);
+    for (size_t i = 0; i < reports.size(); ++i) {
+        ASSERT_EQ(reports[i].getTime(), sim.getSimulationReportTime(static_cast<ptrdiff_t>(3 + i)));
+    }
+    ASSERT_TRUE(sim.getSimulationReports(5, 5).empty());
+    ASSERT_THROW({ sim.getSimulationReports(5, 12); }, std::out_of_range);
+}
+
+TEST(ForwardDynamicSimulation, JoinCollectsAllReportsEvenIfThereAreMoreReportsThanFitInTheReportQueue)
+{
+    using namespace std::literals;
+
+    BasicModelStatePair modelState;
+
+    // set up the simulation to produce many more reports than the report queue
+    // between the simulator thread and the caller can hold at once
+    ForwardDynamicSimulatorParams params;
+    params.finalTime = SimulationClock::start() + 5s;
+    params.reportingInterval = 1ms;
+
+    // `join` shouldn't deadlock, even though the simulator thread has to wait for
+    // the report queue to be drained
+    ForwardDynamicSimulation sim{modelState, params};
+    sim.join();
+    ASSERT_EQ(sim.getStatus(), SimulationStatus::Completed);
+    ASSERT_EQ(sim.getNumReports(), 5001);
+    ASSERT_EQ(sim.pollNewReports(), 0) << "everything should have already been collected by `join`";
+}
+
+TEST(ForwardDynamicSimulation, OutputExtractorsIncludeReportQueueInstrumentation)
+{
+    BasicModelStatePair modelState;
+    ForwardDynamicSimulatorParams params;
+    params.finalTime = SimulationClock::start();
+
+    ForwardDynamicSimulation sim{modelState, params};
+    const auto outputs = sim.getOutputExtractors();
+    const auto hasOutputNamed = [&outputs](std::string_view name)
+    {
+        return std::any_of(outputs.begin(), outputs.end(), [name](const OutputExtractor& o) { return std::string_view{o.getName()} == name; });
+    };
+    ASSERT_TRUE(hasOutputNamed("Report Queue Depth"));
+    ASSERT_TRUE(hasOutputNamed("Report Queue Stall Time"));
+    ASSERT_TRUE(hasOutputNamed("Report Creation Time"));
+}
+
+TEST(ForwardDynamicSimulation, CancelledSimulationCanBeResumedFromItsLatestReport)
+{
+    using namespace std::literals;
+
+    BasicModelStatePair modelState;
+    ForwardDynamicSimulatorParams params;
+    params.finalTime = SimulationClock::start() + 10s;
+    params.reportingInterval = 1ms;
+
+    ForwardDynamicSimulation sim{modelState, params};
+    sim.stop();
+    if (sim.getStatus() != SimulationStatus::Cancelled) {
+        GTEST_SKIP() << "the simulation completed before it could be stopped";
+    }
+    ASSERT_TRUE(sim.canResume());
+    const size_t numReportsBeforeResuming = sim.getNumReports();
+
+    sim.resume();
+    sim.join();
+    ASSERT_EQ(sim.getStatus(), SimulationStatus::Completed);
+    ASSERT_FALSE(sim.canResume());
+    ASSERT_GT(sim.getNumReports(), numReportsBeforeResuming);
+
+    // the resumed simulation should continue from where the cancelled one stopped (i.e.
+    // it shouldn't start from the beginning, or emit any duplicate reports)
+    for (size_t i = 1; i < sim.getNumReports(); ++i) {
+        ASSERT_LT(sim.getSimulationReportTime(static_cast<ptrdiff_t>(i - 1)), sim.getSimulationReportTime(static_cast<ptrdiff_t>(i)));
+    }
+    ASSERT_NEAR((sim.getCurTime() - params.finalTime).count(), 0.0, 1e-9);
+}
+
+TEST(ForwardDynamicSimulation, LatestCheckpointIsTakenFromTheLatestReport)
+{
+    using namespace std::literals;
+
+    BasicModelStatePair modelState;
+    ForwardDynamicSimulatorParams params;
+    params.finalTime = SimulationClock::start() + 1s;
+    params.reportingInterval = 100ms;
+
+    ForwardDynamicSimulation sim{modelState, params};
+    sim.join();
+
+    const std::optional<SimulationCheckpoint> checkpoint = sim.getLatestCheckpoint();
+    ASSERT_TRUE(checkpoint.has_value());
+    ASSERT_EQ(checkpoint->time, sim.getCurTime());
+    ASSERT_EQ(checkpoint->params, params);
+}
@@ -0,0 +1,145 @@
+#include <OpenSimCreator/Documents/Simulation/SimulationCheckpoint.h>
+
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/IntegratorMethod.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+#include <SimTKcommon.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace osc;
+
+namespace
+{
+    SimulationCheckpoint GenerateCheckpoint()
+    {
+        using namespace std::literals;
+
+        SimulationCheckpoint rv;
+        rv.time = SimulationClock::start() + SimulationClock::duration{1.0/3.0};
+        rv.params.finalTime = SimulationClock::start() + 7s;
+        for (const IntegratorMethod method : IntegratorMethod::all()) {
+            rv.params.integratorMethodUsed = method;  // i.e. the last one (not the default)
+        }
+        rv.params.reportingInterval = SimulationClock::duration{0.001};
+        rv.params.integratorStepLimit = 1234;
+        rv.params.integratorAccuracy = 1.0e-7;
+        rv.params.numFullPrecisionReports = -1;
+        rv.stateVariableNames = {"/jointset/a/q/value", "/jointset/a/q/speed", "/forceset/muscle with spaces/activation"};
+        rv.stateVariableValues = {0.1, -std::numeric_limits<double>::min(), 1.0e300};
+        return rv;
+    }
+}
+
+TEST(SimulationCheckpoint, WrittenCheckpointCanBeReadBackLosslessly)
+{
+    const SimulationCheckpoint checkpoint = GenerateCheckpoint();
+
+    std::stringstream ss;
+    WriteSimulationCheckpoint(ss, checkpoint);
+
+    ASSERT_EQ(ReadSimulationCheckpoint(ss), checkpoint);
+}
+
+TEST(SimulationCheckpoint, NonFiniteValuesCanBeWrittenAndReadBack)
+{
+    SimulationCheckpoint checkpoint = GenerateCheckpoint();
+    checkpoint.params.integratorMaximumStepSize = SimulationClock::duration{std::numeric_limits<double>::infinity()};
+    checkpoint.stateVariableValues = {
+        std::numeric_limits<double>::quiet_NaN(),
+        std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity(),
+    };
+
+    std::stringstream ss;
+    WriteSimulationCheckpoint(ss, checkpoint);
+    const SimulationCheckpoint parsed = ReadSimulationCheckpoint(ss);
+
+    ASSERT_EQ(parsed.params, checkpoint.params);
+    ASSERT_EQ(parsed.stateVariableNames, checkpoint.stateVariableNames);
+    ASSERT_EQ(parsed.stateVariableValues.size(), 3);
+    ASSERT_TRUE(std::isnan(parsed.stateVariableValues[0]));
+    ASSERT_EQ(parsed.stateVariableValues[1], std::numeric_limits<double>::infinity());
+    ASSERT_EQ(parsed.stateVariableValues[2], -std::numeric_limits<double>::infinity());
+}
+
+TEST(SimulationCheckpoint, ReadThrowsIfInputIsNotACheckpoint)
+{
+    std::stringstream ss{"time,q,u\n0,1,2\n"};
+    ASSERT_THROW({ ReadSimulationCheckpoint(ss); }, std::runtime_error);
+}
+
+TEST(SimulationCheckpoint, ReadThrowsIfCheckpointIsTruncated)
+{
+    std::stringstream written;
+    WriteSimulationCheckpoint(written, GenerateCheckpoint());
+    std::string content = std::move(written).str();
+    content.resize(content.size() - 10);
+
+    std::stringstream truncated{content};
+    ASSERT_THROW({ ReadSimulationCheckpoint(truncated); }, std::runtime_error);
+}
+
+TEST(SimulationCheckpoint, ReadThrowsIfNumberOfStateVariablesIsLargerThanTheInput)
+{
+    std::stringstream written;
+    WriteSimulationCheckpoint(written, GenerateCheckpoint());
+    std::string content = std::move(written).str();
+
+    // a corrupt count shouldn't be reserved up-front (which would throw `std::bad_alloc`, or worse)
+    const std::string stateVariablesLine = "stateVariables 3\n";
+    const size_t pos = content.find(stateVariablesLine);
+    ASSERT_NE(pos, std::string::npos);
+    content.replace(pos, stateVariablesLine.size(), "stateVariables 18446744073709551615\n");
+
+    std::stringstream corrupt{content};
+    ASSERT_THROW({ ReadSimulationCheckpoint(corrupt); }, std::runtime_error);
+}
+
+TEST(SimulationCheckpoint, ApplyingACheckpointRestoresTheStateItWasCreatedFrom)
+{
+    OpenSim::Model model{(std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "DoublePendulum" / "double_pendulum.osim").string()};
+    InitializeModel(model);
+    SimTK::State& state = InitializeState(model);
+
+    // create a checkpoint from a state that differs from the model's initial state
+    SimTK::State modified{state};
+    modified.setTime(0.5);
+    for (int i = 0; i < modified.getNY(); ++i) {
+        modified.updY()[i] = 0.25 * static_cast<double>(i + 1);
+    }
+    const SimulationCheckpoint checkpoint = CreateSimulationCheckpoint(model, modified, ForwardDynamicSimulatorParams{});
+    ASSERT_EQ(checkpoint.time, SimulationClock::start() + SimulationClock::duration{0.5});
+    ASSERT_EQ(checkpoint.stateVariableNames.size(), static_cast<size_t>(model.getNumStateVariables()));
+
+    ApplySimulationCheckpoint(checkpoint, model, state);
+
+    ASSERT_EQ(state.getTime(), 0.5);
+    for (int i = 0; i < state.getNY(); ++i) {
+        ASSERT_EQ(state.getY()[i], modified.getY()[i]);
+    }
+}
+
+TEST(SimulationCheckpoint, ApplyingACheckpointThrowsIfModelDoesNotHaveOneOfItsStateVariables)
+{
+    OpenSim::Model model{(std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "DoublePendulum" / "double_pendulum.osim").string()};
+    InitializeModel(model);
+    SimTK::State& state = InitializeState(model);
+
+    SimulationCheckpoint checkpoint = CreateSimulationCheckpoint(model, state, ForwardDynamicSimulatorParams{});
+    checkpoint.stateVariableNames.push_back("/not/in/the/model");
+    checkpoint.stateVariableValues.push_back(1.0);
+
+    ASSERT_THROW({ ApplySimulationCheckpoint(checkpoint, model, state); }, std::runtime_error);
+}
@@ -4,17 +4,28 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSimCreator/Documents/OutputExtractors/ConstantOutputExtractor.h>
 #include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/Simulation/BinaryOutputs.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulation.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 #include <OpenSimCreator/Utils/OpenSimHelpers.h>
 
 #include <oscar/Formats/CSV.h>
 #include <oscar/Utils/Algorithms.h>
 #include <oscar/Utils/StringHelpers.h>
+#include <oscar/Utils/TemporaryFile.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
 #include <sstream>
+#include <vector>
 
 using namespace osc;
+namespace rgs = std::ranges;
 
 TEST(SimulationHelpers, WriteOutputsAsCSVWritesFloatDataCorrectly)
 {
@@ -71,3 +82,144 @@ TEST(SimulationHelpers, WriteOutputsAsCSVWritesVec2DataCorrectly)
     const std::vector<std::string> row1Expected = { stream_to_string(0.0), stream_to_string(3.0f), stream_to_string(2.0f) };
     ASSERT_EQ(row1, row1Expected);
 }
+
+TEST(SimulationHelpers, ExtractOutputColumnsReturnsOneColumnPerFloatOutputAndTwoPerVec2Output)
+{
+    OpenSim::Model model;
+    InitializeModel(model);
+    InitializeState(model);
+
+    const auto extractors = std::to_array({
+        make_output_extractor<ConstantOutputExtractor>("float", 1337.0f),
+        make_output_extractor<ConstantOutputExtractor>("vec2", Vec2{3.0f, 2.0f}),
+    });
+
+    // use enough reports that the extraction is (potentially) split across workers
+    std::vector<SimulationReport> reports;
+    for (size_t i = 0; i < 2048; ++i) {
+        reports.emplace_back(SimTK::State{model.getWorkingState()});
+    }
+
+    const std::vector<std::vector<float>> columns = ExtractOutputColumns(model, extractors, reports);
+
+    ASSERT_EQ(columns.size(), 3);
+    for (const std::vector<float>& column : columns) {
+        ASSERT_EQ(column.size(), reports.size());
+    }
+    ASSERT_TRUE(rgs::all_of(columns[0], [](float v) { return v == 1337.0f; }));
+    ASSERT_TRUE(rgs::all_of(columns[1], [](float v) { return v == 3.0f; }));
+    ASSERT_TRUE(rgs::all_of(columns[2], [](float v) { return v == 2.0f; }));
+}
+
+TEST(SimulationHelpers, ExtractOutputColumnsFromSimulationMatchesExtractingFromItsReports)
+{
+    using namespace std::literals;
+
+    // enough reports that the extraction is split across worker threads
+    ForwardDynamicSimulatorParams params;
+    params.finalTime = SimulationClock::start() + 1s;
+    params.reportingInterval = 1ms;
+    ForwardDynamicSimulation sim{BasicModelStatePair{}, params};
+    sim.join();
+    ASSERT_EQ(sim.getNumReports(), 1001);
+
+    const std::vector<OutputExtractor> outputs(sim.getOutputExtractors().begin(), sim.getOutputExtractors().end());
+    const std::vector<std::vector<float>> columns = ExtractOutputColumns(sim, outputs);
+
+    const std::vector<SimulationReport> reports = sim.getAllSimulationReports();
+    const std::vector<std::vector<float>> expected = ExtractOutputColumns(*sim.getModel(), outputs, reports);
+    ASSERT_EQ(columns, expected);
+}
+
+TEST(SimulationHelpers, WriteOutputsAsBinaryWritesDataThatCanBeReadBackByBinaryOutputsFile)
+{
+    OpenSim::Model model;
+    InitializeModel(model);
+    InitializeState(model);
+
+    const auto extractors = std::to_array({
+        make_output_extractor<ConstantOutputExtractor>("float", 1337.0f),
+        make_output_extractor<ConstantOutputExtractor>("vec2", Vec2{3.0f, 2.0f}),
+    });
+
+    const auto reports = std::to_array({
+        SimulationReport{SimTK::State{model.getWorkingState()}}
+    });
+
+    TemporaryFile file;
+    file.close();
+    {
+        std::ofstream out{file.absolute_path(), std::ios::binary};
+        WriteOutputsAsBinary(model, extractors, reports, out);
+    }
+
+    const BinaryOutputsFile read{file.absolute_path()};
+    ASSERT_EQ(read.getNumOutputColumns(), 3);
+    ASSERT_EQ(read.getOutputColumnName(0), "float");
+    ASSERT_EQ(read.getOutputColumnName(1), "vec2/0");
+    ASSERT_EQ(read.getOutputColumnName(2), "vec2/1");
+    ASSERT_EQ(read.copyTimes(), std::vector<double>{0.0});
+    ASSERT_EQ(read.copyOutputColumnValues(0), std::vector<float>{1337.0f});
+    ASSERT_EQ(read.copyOutputColumnValues(2), std::vector<float>{2.0f});
+}
+
+TEST(SimulationHelpers, SimulationOutputsStreamerOnlyWritesNewReports)
+{
+    using namespace std::literals;
+
+    ForwardDynamicSimulatorParams params;
+    params.finalTime = SimulationClock::start() + 100ms;
+    params.reportingInterval = 10ms;
+    ForwardDynamicSimulation sim{BasicModelStatePair{}, params};
+    sim.join();
+    ASSERT_EQ(sim.getNumReports(), 11);
+
+    const std::vector<OutputExtractor> outputs(sim.getOutputExtractors().begin(), sim.getOutputExtractors().end());
+
+    TemporaryFile file;
+    file.close();
+    {
+        std::ofstream out{file.absolute_path(), std::ios::binary};
+        SimulationOutputsStreamer streamer{out, outputs};
+        ASSERT_EQ(streamer.writeNewReports(sim), 11);
+        ASSERT_EQ(streamer.writeNewReports(sim), 0) << "already-written reports shouldn't be re-written";
+        ASSERT_EQ(streamer.getNumRowsWritten(), 11);
+    }
+
+    const BinaryOutputsFile read{file.absolute_path()};
+    ASSERT_EQ(read.getNumRows(), 11);
+    std::vector<double> expectedTimes;
+    for (ptrdiff_t i = 0; i < sim.getNumReports(); ++i) {
+        expectedTimes.push_back(sim.getSimulationReportTime(i).time_since_epoch().count());
+    }
+    ASSERT_EQ(read.copyTimes(), expectedTimes);
+
+    const std::vector<std::vector<float>> expectedColumns = ExtractOutputColumns(sim, outputs);
+    ASSERT_EQ(read.getNumOutputColumns(), expectedColumns.size());
+    for (size_t column = 0; column < expectedColumns.size(); ++column) {
+        ASSERT_EQ(read.copyOutputColumnValues(column), expectedColumns[column]);
+    }
+}
+
+TEST(SimulationHelpers, SimulationOutputsStreamerDoesNotRewriteReportsAfterTruncation)
+{
+    using namespace std::literals;
+
+    ForwardDynamicSimulatorParams params;
+    params.finalTime = SimulationClock::start() + 100ms;
+    params.reportingInterval = 10ms;
+    ForwardDynamicSimulation sim{BasicModelStatePair{}, params};
+    sim.join();
+
+    const std::vector<OutputExtractor> outputs(sim.getOutputExtractors().begin(), sim.getOutputExtractors().end());
+    std::stringstream out;
+    SimulationOutputsStreamer streamer{out, outputs};
+    ASSERT_EQ(streamer.writeNewReports(sim), 11);
+
+    // truncating the simulation's reports changes their generation, but the (already
+    // written) reports that remain shouldn't be written again
+    sim.requestNewEndTime(SimulationClock::start() + 50ms);
+    ASSERT_LT(sim.getNumReports(), 11);
+    ASSERT_EQ(streamer.writeNewReports(sim), 0);
+    ASSERT_EQ(streamer.getNumRowsWritten(), 11);
+}
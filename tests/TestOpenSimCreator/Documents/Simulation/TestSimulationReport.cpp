@@ -0,0 +1,72 @@
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+
+#include <SimTKcommon.h>
+#include <gtest/gtest.h>
+#include <oscar/Utils/UID.h>
+
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+using namespace osc;
+
+TEST(SimulationReport, DefaultConstructedHasNoAuxiliaryValues)
+{
+    const SimulationReport report;
+    ASSERT_TRUE(report.getAuxiliaryValueIDs().empty());
+    ASSERT_TRUE(report.getAuxiliaryValues().empty());
+    ASSERT_FALSE(report.getAuxiliaryValue(UID{}).has_value());
+}
+
+TEST(SimulationReport, GetAuxiliaryValueReturnsValuesProvidedViaMap)
+{
+    const UID a;
+    const UID b;
+    const SimulationReport report{SimTK::State{}, std::unordered_map<UID, float>{{a, 1.0f}, {b, 2.0f}}};
+
+    ASSERT_EQ(report.getAuxiliaryValue(a), 1.0f);
+    ASSERT_EQ(report.getAuxiliaryValue(b), 2.0f);
+    ASSERT_FALSE(report.getAuxiliaryValue(UID{}).has_value());
+}
+
+TEST(SimulationReport, GetAuxiliaryValueReturnsValuesProvidedViaDenseArrays)
+{
+    const UID a;
+    const UID b;
+    const auto ids = std::make_shared<const std::vector<UID>>(std::vector<UID>{a, b});
+    const SimulationReport report{SimTK::State{}, ids, std::vector<float>{1.0f, 2.0f}};
+
+    ASSERT_EQ(report.getAuxiliaryValue(a), 1.0f);
+    ASSERT_EQ(report.getAuxiliaryValue(b), 2.0f);
+    ASSERT_EQ(report.getAuxiliaryValueIDs().size(), 2);
+    ASSERT_EQ(report.getAuxiliaryValues()[1], 2.0f);
+}
+
+TEST(SimulationReport, ThrowsIfDenseAuxiliaryValuesHaveDifferentSizes)
+{
+    const auto ids = std::make_shared<const std::vector<UID>>(std::vector<UID>{UID{}});
+    ASSERT_THROW({ SimulationReport(SimTK::State{}, ids, std::vector<float>{1.0f, 2.0f}); }, std::invalid_argument);
+}
+
+TEST(SimulationReport, CopyAuxiliaryValuesHandlesReportsWithDifferentLayouts)
+{
+    const UID a;
+    const UID b;
+    const auto abLayout = std::make_shared<const std::vector<UID>>(std::vector<UID>{a, b});
+    const auto baLayout = std::make_shared<const std::vector<UID>>(std::vector<UID>{b, a});
+    const auto aLayout = std::make_shared<const std::vector<UID>>(std::vector<UID>{a});
+
+    const std::vector<SimulationReport> reports = {
+        SimulationReport{SimTK::State{}, abLayout, {1.0f, 10.0f}},
+        SimulationReport{SimTK::State{}, abLayout, {2.0f, 20.0f}},
+        SimulationReport{SimTK::State{}, baLayout, {30.0f, 3.0f}},
+        SimulationReport{SimTK::State{}, aLayout, {4.0f}},
+        SimulationReport{},
+    };
+
+    std::vector<float> out(reports.size());
+    CopyAuxiliaryValues(reports, b, out, -1.0f);
+
+    ASSERT_EQ(out, std::vector<float>({10.0f, 20.0f, 30.0f, -1.0f, -1.0f}));
+}
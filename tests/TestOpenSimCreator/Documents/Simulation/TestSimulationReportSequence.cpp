@@ -0,0 +1,182 @@
+#include <OpenSimCreator/Documents/Simulation/SimulationReportSequence.h>
+
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <SimTKcommon.h>
+#include <gtest/gtest.h>
+#include <oscar/Utils/UID.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace osc;
+
+namespace
+{
+    BasicModelStatePair LoadDoublePendulum()
+    {
+        return BasicModelStatePair{std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "DoublePendulum" / "double_pendulum.osim"};
+    }
+
+    // returns a report that has a (deterministically) different time + state
+    // variable values from the provided base state
+    SimulationReport GenerateReport(const SimTK::State& base, size_t i, UID auxID)
+    {
+        SimTK::State st{base};
+        st.setTime(0.01 * static_cast<double>(i));
+        for (int var = 0; var < st.getNY(); ++var) {
+            st.updY()[var] = 0.001 * static_cast<double>(i) + static_cast<double>(var);
+        }
+        return SimulationReport{std::move(st), std::unordered_map<UID, float>{{auxID, static_cast<float>(i)}}};
+    }
+
+    bool StateVariablesEqual(const SimulationReport& a, const SimulationReport& b)
+    {
+        const SimTK::Vector& ya = a.getState().getY();
+        const SimTK::Vector& yb = b.getState().getY();
+        if (ya.size() != yb.size()) {
+            return false;
+        }
+        for (int i = 0; i < ya.size(); ++i) {
+            if (ya[i] != yb[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST(SimulationReportSequence, CanDefaultConstruct)
+{
+    ASSERT_NO_THROW({ SimulationReportSequence{}; });
+}
+
+TEST(SimulationReportSequence, DefaultConstructedIsEmpty)
+{
+    SimulationReportSequence seq;
+    ASSERT_TRUE(seq.empty());
+    ASSERT_EQ(seq.size(), 0);
+}
+
+TEST(SimulationReportSequence, GetReportThrowsIfOutOfBounds)
+{
+    SimulationReportSequence seq;
+    ASSERT_THROW({ seq.getReport(0); }, std::out_of_range);
+}
+
+TEST(SimulationReportSequence, RebuiltReportsHaveSameTimeStateAndAuxiliaryValuesAsPushedReports)
+{
+    const BasicModelStatePair modelState = LoadDoublePendulum();
+    const UID auxID;
+
+    SimulationReportSequence seq;
+    for (size_t i = 0; i < 600; ++i) {
+        seq.push_back(GenerateReport(modelState.getState(), i, auxID));
+    }
+    ASSERT_EQ(seq.size(), 600);
+
+    for (size_t i = 0; i < seq.size(); ++i) {
+        const SimulationReport expected = GenerateReport(modelState.getState(), i, auxID);
+        const SimulationReport rebuilt = seq.getReport(i);
+
+        ASSERT_EQ(seq.getTime(i), expected.getTime());
+        ASSERT_EQ(rebuilt.getTime(), expected.getTime());
+        ASSERT_TRUE(StateVariablesEqual(rebuilt, expected));
+        ASSERT_EQ(seq.getAuxiliaryValue(i, auxID), expected.getAuxiliaryValue(auxID));
+        ASSERT_EQ(rebuilt.getAuxiliaryValue(auxID), expected.getAuxiliaryValue(auxID));
+    }
+}
+
+TEST(SimulationReportSequence, GetAuxiliaryValueReturnsNulloptForUnknownID)
+{
+    const BasicModelStatePair modelState = LoadDoublePendulum();
+
+    SimulationReportSequence seq;
+    seq.push_back(GenerateReport(modelState.getState(), 0, UID{}));
+
+    ASSERT_FALSE(seq.getAuxiliaryValue(0, UID{}).has_value());
+}
+
+TEST(SimulationReportSequence, TruncateRemovesTrailingReports)
+{
+    const BasicModelStatePair modelState = LoadDoublePendulum();
+    const UID auxID;
+
+    SimulationReportSequence seq;
+    for (size_t i = 0; i < 300; ++i) {
+        seq.push_back(GenerateReport(modelState.getState(), i, auxID));
+    }
+    seq.truncate(100);
+    ASSERT_EQ(seq.size(), 100);
+
+    // and it should be possible to continue pushing reports afterwards
+    seq.push_back(GenerateReport(modelState.getState(), 100, auxID));
+    ASSERT_EQ(seq.size(), 101);
+    ASSERT_TRUE(StateVariablesEqual(seq.getReport(100), GenerateReport(modelState.getState(), 100, auxID)));
+}
+
+TEST(SimulationReportSequence, GenerationOnlyChangesWhenReportsAreErased)
+{
+    const BasicModelStatePair modelState = LoadDoublePendulum();
+    const UID auxID;
+
+    SimulationReportSequence seq;
+    const UID initialGeneration = seq.getGeneration();
+    for (size_t i = 0; i < 10; ++i) {
+        seq.push_back(GenerateReport(modelState.getState(), i, auxID));
+    }
+    ASSERT_EQ(seq.getGeneration(), initialGeneration) << "appending reports shouldn't change the generation";
+
+    seq.truncate(seq.size());
+    ASSERT_EQ(seq.getGeneration(), initialGeneration) << "a no-op truncation shouldn't change the generation";
+
+    seq.truncate(5);
+    const UID truncatedGeneration = seq.getGeneration();
+    ASSERT_NE(truncatedGeneration, initialGeneration);
+
+    // growing the sequence back past its original size shouldn't restore the original generation
+    for (size_t i = 5; i < 20; ++i) {
+        seq.push_back(GenerateReport(modelState.getState(), i, auxID));
+    }
+    ASSERT_EQ(seq.getGeneration(), truncatedGeneration);
+}
+
+TEST(SimulationReportSequence, GenerationIsUniqueAcrossSequences)
+{
+    const SimulationReportSequence a;
+    const SimulationReportSequence b;
+    ASSERT_NE(a.getGeneration(), b.getGeneration());
+}
+
+TEST(SimulationReportSequence, CompactedReportsAreApproximatelyEqualAndUseLessMemory)
+{
+    const BasicModelStatePair modelState = LoadDoublePendulum();
+    const UID auxID;
+    constexpr size_t c_NumReports = 2048;
+
+    SimulationReportSequence lossless;
+    SimulationReportSequence compacted{0};
+    for (size_t i = 0; i < c_NumReports; ++i) {
+        lossless.push_back(GenerateReport(modelState.getState(), i, auxID));
+        compacted.push_back(GenerateReport(modelState.getState(), i, auxID));
+    }
+
+    ASSERT_LT(compacted.getApproximateMemoryUsage(), lossless.getApproximateMemoryUsage());
+
+    for (size_t i = 0; i < c_NumReports; ++i) {
+        const SimulationReport expectedReport = lossless.getReport(i);
+        const SimulationReport compactedReport = compacted.getReport(i);
+        const SimTK::Vector& expected = expectedReport.getState().getY();
+        const SimTK::Vector& got = compactedReport.getState().getY();
+        ASSERT_EQ(compacted.getTime(i), lossless.getTime(i)) << "times should always be lossless";
+        ASSERT_EQ(compacted.getAuxiliaryValue(i, auxID), lossless.getAuxiliaryValue(i, auxID)) << "auxiliary values should always be lossless";
+        for (int var = 0; var < expected.size(); ++var) {
+            ASSERT_NEAR(got[var], expected[var], 1e-6);
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#include <OpenSimCreator/Documents/Simulation/StoFileSimulation.h>
+
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
+#include <gtest/gtest.h>
+#include <oscar/Utils/TemporaryFile.h>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+using namespace osc;
+
+namespace
+{
+    std::unique_ptr<OpenSim::Model> LoadDoublePendulum()
+    {
+        const std::filesystem::path path = std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "DoublePendulum" / "double_pendulum.osim";
+        return std::make_unique<OpenSim::Model>(path.string());
+    }
+
+    // writes a (linearly-varying) STO file for the double pendulum model's state variables
+    void WriteDoublePendulumSto(const std::filesystem::path& path)
+    {
+        std::ofstream out{path};
+        out << "double_pendulum_states\n";
+        out << "version=1\n";
+        out << "nRows=2\n";
+        out << "nColumns=5\n";
+        out << "inDegrees=no\n";
+        out << "endheader\n";
+        out << "time\t/jointset/pin1/q1/value\t/jointset/pin1/q1/speed\t/jointset/pin2/q2/value\t/jointset/pin2/q2/speed\n";
+        out << "0\t0\t0.1\t0\t0.2\n";
+        out << "10\t1\t0.1\t2\t0.2\n";
+    }
+
+    void WaitUntilLoaded(const StoFileSimulation& sim)
+    {
+        for (int i = 0; i < 6000 and sim.getStatus() == SimulationStatus::Running; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+    }
+}
+
+TEST(StoFileSimulation, LoadsAllRowsOfTheStoFileInTheBackground)
+{
+    TemporaryFile stoFile{{.suffix = ".sto"}};
+    stoFile.close();
+    WriteDoublePendulumSto(stoFile.absolute_path());
+
+    StoFileSimulation sim{LoadDoublePendulum(), stoFile.absolute_path(), 1.0f};
+    WaitUntilLoaded(sim);
+
+    ASSERT_EQ(sim.getStatus(), SimulationStatus::Completed);
+    ASSERT_EQ(sim.getNumReports(), 1001) << "the STO file should be resampled at 100 Hz";
+    ASSERT_EQ(sim.getProgress(), 1.0f);
+    ASSERT_EQ(sim.getEndTime(), SimulationClock::start() + SimulationClock::duration{10.0});
+}
+
+TEST(StoFileSimulation, ReportsContainTheStateVariablesFromTheStoFile)
+{
+    TemporaryFile stoFile{{.suffix = ".sto"}};
+    stoFile.close();
+    WriteDoublePendulumSto(stoFile.absolute_path());
+
+    StoFileSimulation sim{LoadDoublePendulum(), stoFile.absolute_path(), 1.0f};
+    WaitUntilLoaded(sim);
+
+    for (ptrdiff_t i : {ptrdiff_t{0}, ptrdiff_t{257}, ptrdiff_t{1000}}) {
+        // care: the report must be acquired before locking the model
+        const SimulationReport report = sim.getSimulationReport(i);
+        ASSERT_EQ(report.getTime(), sim.getSimulationReportTime(i));
+
+        const double t = report.getState().getTime();
+        const auto model = sim.getModel();
+        const auto& q1 = model->getComponent<OpenSim::Coordinate>("/jointset/pin1/q1");
+        const auto& q2 = model->getComponent<OpenSim::Coordinate>("/jointset/pin2/q2");
+        ASSERT_NEAR(q1.getValue(report.getState()), 0.1*t, 1e-9);
+        ASSERT_NEAR(q2.getValue(report.getState()), 0.2*t, 1e-9);
+    }
+}
+
+TEST(StoFileSimulation, GetSimulationReportThrowsIfOutOfBounds)
+{
+    TemporaryFile stoFile{{.suffix = ".sto"}};
+    stoFile.close();
+    WriteDoublePendulumSto(stoFile.absolute_path());
+
+    StoFileSimulation sim{LoadDoublePendulum(), stoFile.absolute_path(), 1.0f};
+    WaitUntilLoaded(sim);
+
+    ASSERT_THROW({ sim.getSimulationReport(static_cast<ptrdiff_t>(sim.getNumReports())); }, std::out_of_range);
+}
+
+TEST(StoFileSimulation, CanGetReportsWhileHoldingTheModelGuard)
+{
+    TemporaryFile stoFile{{.suffix = ".sto"}};
+    stoFile.close();
+    WriteDoublePendulumSto(stoFile.absolute_path());
+
+    StoFileSimulation sim{LoadDoublePendulum(), stoFile.absolute_path(), 1.0f};
+    WaitUntilLoaded(sim);
+
+    // reports are realized against an internal copy of the model, so this shouldn't deadlock
+    const auto model = sim.getModel();
+    const SimulationReport report = sim.getSimulationReport(500);
+    ASSERT_EQ(report.getTime(), sim.getSimulationReportTime(500));
+    ASSERT_EQ(sim.getSimulationReports(0, 10).size(), 10);
+}
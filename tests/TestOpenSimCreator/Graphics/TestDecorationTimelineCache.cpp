@@ -0,0 +1,313 @@
+#include <OpenSimCreator/Graphics/DecorationTimelineCache.h>
+
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulation.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/Simulation.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationModelStatePair.h>
+#include <OpenSimCreator/Graphics/OpenSimDecorationOptions.h>
+#include <OpenSimCreator/Graphics/OpenSimGraphicsHelpers.h>
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
+#include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Maths/BVH.h>
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // returns a (completed) simulation of a block that falls onto, and bounces off, the ground
+    std::shared_ptr<Simulation> RunBouncingBlockSimulation(SimulationClock::duration reportingInterval)
+    {
+        using namespace std::literals;
+
+        const std::filesystem::path path = std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "BouncingBlock" / "bouncing_block.osim";
+        ForwardDynamicSimulatorParams params;
+        params.finalTime = SimulationClock::start() + 1s;
+        params.reportingInterval = reportingInterval;
+        ForwardDynamicSimulation sim{BasicModelStatePair{path}, params};
+        sim.join();
+        return std::make_shared<Simulation>(std::move(sim));
+    }
+
+    std::vector<ptrdiff_t> AllReportIndices(const Simulation& sim)
+    {
+        std::vector<ptrdiff_t> rv;
+        for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(sim.getNumReports()); ++i) {
+            rv.push_back(i);
+        }
+        return rv;
+    }
+
+    // returns `true` if `predicate` returns `true` before a (generous) timeout
+    template<std::invocable Predicate>
+    bool WaitUntil(Predicate predicate)
+    {
+        using namespace std::literals;
+
+        const auto deadline = std::chrono::steady_clock::now() + 60s;
+        while (not predicate()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+
+    bool WaitUntilIdle(const DecorationTimelineCache& cache)
+    {
+        return WaitUntil([&cache]() { return cache.isIdle(); });
+    }
+
+    struct LookupResult final {
+        bool hit = false;
+        std::vector<SceneDecoration> drawlist;
+        BVH bvh;
+    };
+
+    // looks up the decorations of the simulation's `i`th report in the cache
+    //
+    // care: a miss tells the cache that the caller is generating the report itself, so the
+    //       cache won't prefetch it
+    LookupResult Lookup(
+        DecorationTimelineCache& cache,
+        const std::shared_ptr<Simulation>& sim,
+        ptrdiff_t i,
+        const OpenSimDecorationOptions& options)
+    {
+        const SimulationModelStatePair modelState{sim, sim->getSimulationReport(i)};
+        LookupResult rv;
+        rv.hit = cache.tryGetDecorations(modelState, options, rv.drawlist, rv.bvh);
+        return rv;
+    }
+
+    // returns the number of bytes that one (prefetched) report of the simulation uses in the cache
+    size_t MeasureNumBytesPerReport(
+        const std::shared_ptr<Simulation>& sim,
+        const std::shared_ptr<SceneCache>& sceneCache,
+        const OpenSimDecorationOptions& options)
+    {
+        DecorationTimelineCache cache{sceneCache};
+        Lookup(cache, sim, 0, options);  // sets the cache's options (a miss, but doesn't claim the report)
+        cache.setUpcomingReports(sim, {1});
+        return WaitUntilIdle(cache) ? cache.getNumBytesUsed() : 0;
+    }
+}
+
+TEST(DecorationTimelineCache, PrefetchesUpcomingReportsWithTheLookedUpOptions)
+{
+    using namespace std::literals;
+
+    const auto sim = RunBouncingBlockSimulation(100ms);
+    DecorationTimelineCache cache{std::make_shared<SceneCache>()};
+    const OpenSimDecorationOptions options;
+
+    ASSERT_FALSE(cache.isPrefetching()) << "nothing should be prefetched until the cache knows which options to use";
+    ASSERT_FALSE(Lookup(cache, sim, 0, options).hit);
+    ASSERT_TRUE(cache.isPrefetching());
+
+    cache.setUpcomingReports(sim, {1, 2});
+    ASSERT_TRUE(WaitUntilIdle(cache));
+    ASSERT_GT(cache.getNumBytesUsed(), 0);
+    ASSERT_TRUE(Lookup(cache, sim, 1, options).hit);
+    ASSERT_TRUE(Lookup(cache, sim, 2, options).hit);
+}
+
+TEST(DecorationTimelineCache, LookupsReturnTheDecorationsOfTheLookedUpReport)
+{
+    using namespace std::literals;
+
+    const auto sim = RunBouncingBlockSimulation(100ms);
+    const auto sceneCache = std::make_shared<SceneCache>();
+    DecorationTimelineCache cache{sceneCache};
+    const OpenSimDecorationOptions options;
+
+    Lookup(cache, sim, 0, options);
+    cache.setUpcomingReports(sim, {2, 7});
+    ASSERT_TRUE(WaitUntilIdle(cache));
+
+    // the cache is keyed by report time, so it should be hit by lookups with freshly-rebuilt
+    // reports (states) of the same index, and return the decorations of that index
+    std::vector<std::vector<SceneDecoration>> hits;
+    for (ptrdiff_t i : {2, 7}) {
+        const LookupResult result = Lookup(cache, sim, i, options);
+        ASSERT_TRUE(result.hit);
+        ASSERT_FALSE(result.bvh.empty());
+
+        std::vector<SceneDecoration> expected;
+        const SimulationModelStatePair modelState{sim, sim->getSimulationReport(i)};
+        GenerateDecorations(*sceneCache, modelState, options, [&expected](const OpenSim::Component&, SceneDecoration&& decoration)
+        {
+            expected.push_back(std::move(decoration));
+        });
+        ASSERT_EQ(result.drawlist, expected) << "report " << i << ": prefetched decorations should match generating them on the UI thread";
+
+        hits.push_back(result.drawlist);
+    }
+    ASSERT_NE(hits.at(0), hits.at(1)) << "the block moves between the reports, so the decorations of each report should differ";
+}
+
+TEST(DecorationTimelineCache, EvictsLeastRecentlyUsedReportsWhenOverBudget)
+{
+    using namespace std::literals;
+
+    const auto sim = RunBouncingBlockSimulation(100ms);
+    const auto sceneCache = std::make_shared<SceneCache>();
+    const OpenSimDecorationOptions options;
+
+    // the block's decorations are the same size in every report
+    const size_t numBytesPerReport = MeasureNumBytesPerReport(sim, sceneCache, options);
+    ASSERT_GT(numBytesPerReport, 0);
+
+    DecorationTimelineCache cache{sceneCache, 4*numBytesPerReport};
+    Lookup(cache, sim, 0, options);
+    cache.setUpcomingReports(sim, {0, 1, 2});
+    ASSERT_TRUE(WaitUntilIdle(cache));
+    ASSERT_EQ(cache.getNumBytesUsed(), 3*numBytesPerReport);
+
+    // use report 0, so that reports 1 and 2 are the least-recently-used ones
+    ASSERT_TRUE(Lookup(cache, sim, 0, options).hit);
+
+    // prefetching three more reports exceeds the budget, which should evict the (not upcoming)
+    // least-recently-used reports
+    cache.setUpcomingReports(sim, {3, 4, 5});
+    ASSERT_TRUE(WaitUntilIdle(cache));
+    ASSERT_EQ(cache.getNumBytesUsed(), 4*numBytesPerReport);
+
+    ASSERT_TRUE(Lookup(cache, sim, 0, options).hit) << "was recently used, so shouldn't be evicted";
+    ASSERT_TRUE(Lookup(cache, sim, 3, options).hit);
+    ASSERT_TRUE(Lookup(cache, sim, 4, options).hit);
+    ASSERT_TRUE(Lookup(cache, sim, 5, options).hit);
+    ASSERT_FALSE(Lookup(cache, sim, 1, options).hit) << "was the least-recently-used report, so should be evicted";
+    ASSERT_FALSE(Lookup(cache, sim, 2, options).hit) << "was the second least-recently-used report, so should be evicted";
+}
+
+TEST(DecorationTimelineCache, StopsPrefetchingWhenUpcomingReportsFillTheBudget)
+{
+    using namespace std::literals;
+
+    const auto sim = RunBouncingBlockSimulation(100ms);
+    const auto sceneCache = std::make_shared<SceneCache>();
+    const OpenSimDecorationOptions options;
+    const size_t numBytesPerReport = MeasureNumBytesPerReport(sim, sceneCache, options);
+    ASSERT_GT(numBytesPerReport, 0);
+
+    DecorationTimelineCache cache{sceneCache, 2*numBytesPerReport};
+    Lookup(cache, sim, 0, options);
+    cache.setUpcomingReports(sim, AllReportIndices(*sim));
+    ASSERT_TRUE(WaitUntilIdle(cache));
+    ASSERT_EQ(cache.getNumBytesUsed(), 2*numBytesPerReport);
+    ASSERT_TRUE(Lookup(cache, sim, 0, options).hit) << "should prefetch reports in the given (priority) order";
+    ASSERT_TRUE(Lookup(cache, sim, 1, options).hit);
+}
+
+TEST(DecorationTimelineCache, ChangingTheOptionsInvalidatesTheCache)
+{
+    using namespace std::literals;
+
+    const auto sim = RunBouncingBlockSimulation(100ms);
+    DecorationTimelineCache cache{std::make_shared<SceneCache>()};
+    const OpenSimDecorationOptions options;
+
+    Lookup(cache, sim, 0, options);
+    cache.setUpcomingReports(sim, {1, 2});
+    ASSERT_TRUE(WaitUntilIdle(cache));
+    ASSERT_GT(cache.getNumBytesUsed(), 0);
+
+    OpenSimDecorationOptions otherOptions = options;
+    otherOptions.setShouldShowCentersOfMass(not otherOptions.getShouldShowCentersOfMass());
+    ASSERT_FALSE(Lookup(cache, sim, 1, otherOptions).hit);
+    ASSERT_EQ(cache.getNumBytesUsed(), 0);
+
+    // the upcoming reports are then prefetched with the new options
+    ASSERT_TRUE(WaitUntilIdle(cache));
+    ASSERT_GT(cache.getNumBytesUsed(), 0);
+    ASSERT_TRUE(Lookup(cache, sim, 1, otherOptions).hit);
+    ASSERT_FALSE(Lookup(cache, sim, 2, options).hit);
+    ASSERT_EQ(cache.getNumBytesUsed(), 0);
+}
+
+TEST(DecorationTimelineCache, ChangingTheModelInvalidatesTheCache)
+{
+    using namespace std::literals;
+
+    const auto sim = RunBouncingBlockSimulation(100ms);
+    const auto otherSim = RunBouncingBlockSimulation(100ms);
+    DecorationTimelineCache cache{std::make_shared<SceneCache>()};
+    const OpenSimDecorationOptions options;
+
+    Lookup(cache, sim, 0, options);
+    cache.setUpcomingReports(sim, {1, 2});
+    ASSERT_TRUE(WaitUntilIdle(cache));
+    ASSERT_GT(cache.getNumBytesUsed(), 0);
+
+    // looking up a state of another model (even an identical one) invalidates the cache
+    ASSERT_FALSE(Lookup(cache, otherSim, 1, options).hit);
+    ASSERT_EQ(cache.getNumBytesUsed(), 0);
+
+    // as does changing which simulation the upcoming reports are from
+    Lookup(cache, sim, 0, options);
+    ASSERT_TRUE(WaitUntilIdle(cache));
+    ASSERT_GT(cache.getNumBytesUsed(), 0);
+    cache.setUpcomingReports(otherSim, {1, 2});
+    ASSERT_EQ(cache.getNumBytesUsed(), 0);
+}
+
+TEST(DecorationTimelineCache, DisablingPrefetchingInTheOptionsClearsTheCache)
+{
+    using namespace std::literals;
+
+    const auto sim = RunBouncingBlockSimulation(100ms);
+    DecorationTimelineCache cache{std::make_shared<SceneCache>()};
+    OpenSimDecorationOptions options;
+    ASSERT_TRUE(options.getShouldPrefetchSimulationDecorations()) << "should be enabled by default";
+
+    Lookup(cache, sim, 0, options);
+    cache.setUpcomingReports(sim, {1, 2});
+    ASSERT_TRUE(WaitUntilIdle(cache));
+    ASSERT_GT(cache.getNumBytesUsed(), 0);
+
+    options.setShouldPrefetchSimulationDecorations(false);
+    ASSERT_FALSE(Lookup(cache, sim, 1, options).hit);
+    ASSERT_FALSE(cache.isPrefetching());
+    ASSERT_EQ(cache.getNumBytesUsed(), 0);
+    ASSERT_TRUE(cache.isIdle());
+}
+
+TEST(DecorationTimelineCache, DestroyingTheCacheWhilePrefetchingStopsTheWorker)
+{
+    using namespace std::literals;
+
+    const auto sim = RunBouncingBlockSimulation(10ms);
+    const auto sceneCache = std::make_shared<SceneCache>();
+    auto cache = std::make_unique<DecorationTimelineCache>(sceneCache);
+    const OpenSimDecorationOptions options;
+
+    Lookup(*cache, sim, 0, options);
+    cache->setUpcomingReports(sim, AllReportIndices(*sim));
+    ASSERT_TRUE(WaitUntil([&cache]() { return cache->getNumBytesUsed() > 0; }));  // i.e. the worker is (very likely) mid-prefetch
+
+    // shouldn't hang (waiting on the worker) or crash (the worker using the destroyed cache)
+    cache.reset();
+
+    // and the worker shouldn't have left the simulation/scene cache in a bad state
+    ASSERT_EQ(sim->getNumReports(), 101);
+    DecorationTimelineCache newCache{sceneCache};
+    Lookup(newCache, sim, 0, options);
+    newCache.setUpcomingReports(sim, {1});
+    ASSERT_TRUE(WaitUntilIdle(newCache));
+    ASSERT_TRUE(Lookup(newCache, sim, 1, options).hit);
+}
@@ -293,3 +293,42 @@ TEST(OpenSimDecorationGenerator, GenerateDecorationsForLigamentGeneratesLigament
     );
     ASSERT_EQ(numDecorationsTaggedWithLigament, 1);
 }
+
+TEST(OpenSimDecorationGenerator, GenerateDecorationsInParallelProducesSameDecorationsAsSerialGeneration)
+{
+    // (a large model, so that the implementation actually uses multiple workers)
+    const std::filesystem::path rajagopalPath = std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "RajagopalModel" / "Rajagopal2015.osim";
+    OpenSim::Model model{rajagopalPath.string()};
+    InitializeModel(model);
+    InitializeState(model);
+    model.realizeReport(model.getWorkingState());
+
+    SceneCache meshCache;
+    const auto generate = [&model, &meshCache](const OpenSimDecorationOptions& opts)
+    {
+        std::vector<std::pair<const OpenSim::Component*, SceneDecoration>> rv;
+        GenerateModelDecorations(
+            meshCache,
+            model,
+            model.getWorkingState(),
+            opts,
+            1.0f,
+            [&rv](const OpenSim::Component& c, SceneDecoration&& dec)
+            {
+                rv.emplace_back(&c, std::move(dec));
+            }
+        );
+        return rv;
+    };
+
+    OpenSimDecorationOptions serialOpts;
+    serialOpts.setShouldGenerateInParallel(false);
+    OpenSimDecorationOptions parallelOpts;
+    parallelOpts.setShouldGenerateInParallel(true);
+
+    const auto serial = generate(serialOpts);
+    const auto parallel = generate(parallelOpts);
+
+    ASSERT_FALSE(serial.empty());
+    ASSERT_EQ(serial, parallel) << "the parallel implementation should emit exactly the same decorations, in exactly the same order, as the serial implementation";
+}
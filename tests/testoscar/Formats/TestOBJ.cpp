@@ -0,0 +1,89 @@
+#include <oscar/Formats/OBJ.h>
+
+#include <testoscar/testoscarconfig.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Formats/MeshLoadingFlags.h>
+#include <oscar/Graphics/Geometries/BoxGeometry.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::span<const std::byte> bytes_of(std::string_view str)
+    {
+        return std::as_bytes(std::span{str});
+    }
+}
+
+TEST(load_mesh_from_obj, can_load_the_output_of_write_as_obj)
+{
+    const Mesh box = BoxGeometry{};
+    std::stringstream ss;
+    write_as_obj(ss, box, ObjMetadata{TESTOSCAR_APPNAME_STRING});
+    const std::string obj = std::move(ss).str();
+
+    const Mesh loaded = load_mesh_from_obj(bytes_of(obj));
+
+    ASSERT_EQ(loaded.vertices(), box.vertices());
+    ASSERT_TRUE(std::ranges::equal(loaded.indices(), box.indices()));
+    ASSERT_EQ(loaded.normals().size(), loaded.num_vertices());
+}
+
+TEST(load_mesh_from_obj, triangulates_quads_and_polygons)
+{
+    constexpr std::string_view obj = R"(# a quad and a pentagon
+v 0 0 0
+v 1 0 0
+v 1 1 0
+v 0 1 0
+v 0.5 2 0
+f 1 2 3 4
+f 1/1 2/2/2 3//3 5 4
+)";
+    const Mesh loaded = load_mesh_from_obj(bytes_of(obj));
+
+    ASSERT_EQ(loaded.num_vertices(), 6) << "the pentagon should have an injected centroid vertex";
+    ASSERT_EQ(loaded.num_indices(), 3*(2 + 5));
+}
+
+TEST(load_mesh_from_obj, handles_negative_relative_indices)
+{
+    constexpr std::string_view obj = "v 0 0 0\nv 1 0 0\nv 1 1 0\nf -3 -2 -1\n";
+    const Mesh loaded = load_mesh_from_obj(bytes_of(obj));
+
+    ASSERT_TRUE(std::ranges::equal(loaded.indices(), std::vector<uint32_t>{0, 1, 2}));
+}
+
+TEST(load_mesh_from_obj, skips_triangles_that_have_out_of_bounds_indices)
+{
+    constexpr std::string_view obj = "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3\nf 1 2 4\n";
+    const Mesh loaded = load_mesh_from_obj(bytes_of(obj));
+
+    ASSERT_EQ(loaded.num_indices(), 3);
+}
+
+TEST(load_mesh_from_obj, welds_vertices_that_have_the_same_position_if_given_WeldVertices_flag)
+{
+    constexpr std::string_view obj = "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 0 0\nv 1 1 0\nv 0 1 0\nf 1 2 3\nf 4 5 6\n";
+
+    ASSERT_EQ(load_mesh_from_obj(bytes_of(obj)).num_vertices(), 6);
+    ASSERT_EQ(load_mesh_from_obj(bytes_of(obj), MeshLoadingFlag::WeldVertices).num_vertices(), 4);
+}
+
+TEST(load_mesh_from_obj, throws_if_given_an_invalid_vertex)
+{
+    constexpr std::string_view obj = "v 0 0 0\nv 1 zero 0\n";
+    ASSERT_THROW({ load_mesh_from_obj(bytes_of(obj)); }, std::runtime_error);
+}
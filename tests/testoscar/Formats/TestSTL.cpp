@@ -0,0 +1,113 @@
+#include <oscar/Formats/STL.h>
+
+#include <testoscar/testoscarconfig.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Formats/MeshLoadingFlags.h>
+#include <oscar/Graphics/Geometries/BoxGeometry.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <cstddef>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::span<const std::byte> bytes_of(std::string_view str)
+    {
+        return std::as_bytes(std::span{str});
+    }
+
+    std::string write_as_stl_string(const Mesh& mesh)
+    {
+        std::stringstream ss;
+        write_as_stl(ss, mesh, StlMetadata{TESTOSCAR_APPNAME_STRING});
+        return std::move(ss).str();
+    }
+
+    constexpr std::string_view c_ascii_stl_with_two_triangles = R"(solid two_triangles
+  facet normal 0 0 1
+    outer loop
+      vertex 0 0 0
+      vertex 1 0 0
+      vertex 1 1 0
+    endloop
+  endfacet
+  facet normal 0 0 1
+    outer loop
+      vertex 0 0 0
+      vertex 1 1 0
+      vertex 0 1 0
+    endloop
+  endfacet
+endsolid two_triangles
+)";
+}
+
+TEST(load_mesh_from_stl, can_load_the_output_of_write_as_stl)
+{
+    const Mesh box = BoxGeometry{};
+    const std::string stl = write_as_stl_string(box);
+
+    const Mesh loaded = load_mesh_from_stl(bytes_of(stl));
+
+    ASSERT_EQ(loaded.num_indices(), box.num_indices());
+    std::vector<Vec3> expected_triangle_vertices;
+    box.for_each_indexed_vertex([&expected_triangle_vertices](Vec3 v) { expected_triangle_vertices.push_back(v); });
+    std::vector<Vec3> loaded_triangle_vertices;
+    loaded.for_each_indexed_vertex([&loaded_triangle_vertices](Vec3 v) { loaded_triangle_vertices.push_back(v); });
+    ASSERT_EQ(loaded_triangle_vertices, expected_triangle_vertices);
+}
+
+TEST(load_mesh_from_stl, calculates_normals_for_the_loaded_mesh)
+{
+    const std::string stl = write_as_stl_string(BoxGeometry{});
+    const Mesh loaded = load_mesh_from_stl(bytes_of(stl));
+
+    ASSERT_EQ(loaded.normals().size(), loaded.num_vertices());
+}
+
+TEST(load_mesh_from_stl, doesnt_weld_vertices_by_default)
+{
+    const Mesh loaded = load_mesh_from_stl(bytes_of(c_ascii_stl_with_two_triangles));
+
+    ASSERT_EQ(loaded.num_vertices(), 6);
+    ASSERT_EQ(loaded.num_indices(), 6);
+}
+
+TEST(load_mesh_from_stl, welds_vertices_that_have_the_same_position_if_given_WeldVertices_flag)
+{
+    const Mesh loaded = load_mesh_from_stl(bytes_of(c_ascii_stl_with_two_triangles), MeshLoadingFlag::WeldVertices);
+
+    ASSERT_EQ(loaded.num_vertices(), 4);
+    ASSERT_EQ(loaded.num_indices(), 6);
+}
+
+TEST(load_mesh_from_stl, can_load_binary_STL_that_has_a_header_that_starts_with_solid)
+{
+    std::string stl = write_as_stl_string(BoxGeometry{});
+    stl.replace(0, 5, "solid");  // some exporters do this, even for binary files
+
+    ASSERT_EQ(load_mesh_from_stl(bytes_of(stl)).num_indices(), Mesh{BoxGeometry{}}.num_indices());
+}
+
+TEST(load_mesh_from_stl, throws_if_given_truncated_binary_STL)
+{
+    std::string stl = write_as_stl_string(BoxGeometry{});
+    stl.resize(stl.size() - 10);
+
+    ASSERT_THROW({ load_mesh_from_stl(bytes_of(stl)); }, std::runtime_error);
+}
+
+TEST(load_mesh_from_stl, throws_if_given_ASCII_STL_that_has_an_invalid_vertex)
+{
+    constexpr std::string_view stl = "solid bad\nfacet normal 0 0 1\nouter loop\nvertex 0 0 zero\n";
+    ASSERT_THROW({ load_mesh_from_stl(bytes_of(stl)); }, std::runtime_error);
+}
@@ -0,0 +1,107 @@
+#include <oscar/Formats/VTP.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::span<const std::byte> bytes_of(std::string_view str)
+    {
+        return std::as_bytes(std::span{str});
+    }
+
+    // (in the same layout as the `.vtp` files that OpenSim ships with)
+    constexpr std::string_view c_vtp_with_a_triangle_and_a_quad = R"(<?xml version="1.0"?>
+<VTKFile type="PolyData" version="0.1" byte_order="LittleEndian" header_type="UInt32" compressor="vtkZLibDataCompressor">
+  <PolyData>
+    <Piece NumberOfPoints="5" NumberOfVerts="0" NumberOfLines="0" NumberOfStrips="0" NumberOfPolys="2">
+      <PointData Normals="Normals">
+        <DataArray type="Float32" Name="Normals" NumberOfComponents="3" format="ascii">
+          0 0 1 0 0 1 0 0 1 0 0 1 0 0 1
+        </DataArray>
+      </PointData>
+      <CellData>
+      </CellData>
+      <Points>
+        <DataArray type="Float32" Name="Points" NumberOfComponents="3" format="ascii">
+          0 0 0 1 0 0
+          1 1 0 0 1 0
+          -1.5e-1 2.5E+0 0
+        </DataArray>
+      </Points>
+      <Verts>
+        <DataArray type="Int32" Name="connectivity" format="ascii">
+        </DataArray>
+        <DataArray type="Int32" Name="offsets" format="ascii">
+        </DataArray>
+      </Verts>
+      <Polys>
+        <DataArray type="Int32" Name="connectivity" format="ascii">
+          0 1 2 0 2 4 3
+        </DataArray>
+        <DataArray type="Int32" Name="offsets" format="ascii">
+          3 7
+        </DataArray>
+      </Polys>
+    </Piece>
+  </PolyData>
+</VTKFile>
+)";
+}
+
+TEST(load_mesh_from_vtp, loads_points_and_triangulated_polygons)
+{
+    const Mesh loaded = load_mesh_from_vtp(bytes_of(c_vtp_with_a_triangle_and_a_quad));
+
+    const std::vector<Vec3> expected_vertices = {
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {-0.15f, 2.5f, 0.0f},
+    };
+    ASSERT_EQ(loaded.vertices(), expected_vertices);
+    ASSERT_TRUE(std::ranges::equal(loaded.indices(), std::vector<uint32_t>{0, 1, 2, 0, 2, 4, 0, 4, 3}));
+    ASSERT_EQ(loaded.normals().size(), loaded.num_vertices());
+}
+
+TEST(load_mesh_from_vtp, loads_each_piece_of_the_file)
+{
+    std::string vtp{c_vtp_with_a_triangle_and_a_quad};
+    const size_t piece_begin = vtp.find("<Piece");
+    const size_t piece_end = vtp.find("</Piece>") + std::string_view{"</Piece>"}.size();
+    vtp.insert(piece_end, vtp.substr(piece_begin, piece_end - piece_begin));
+
+    const Mesh loaded = load_mesh_from_vtp(bytes_of(vtp));
+
+    ASSERT_EQ(loaded.num_vertices(), 10);
+    ASSERT_EQ(loaded.num_indices(), 18);
+    ASSERT_EQ(loaded.indices()[9], 5) << "the second piece's indices should be offset by the first piece's points";
+}
+
+TEST(load_mesh_from_vtp, throws_if_given_binary_data_arrays)
+{
+    std::string vtp{c_vtp_with_a_triangle_and_a_quad};
+    for (size_t pos = vtp.find("format=\"ascii\""); pos != std::string::npos; pos = vtp.find("format=\"ascii\"")) {
+        vtp.replace(pos, std::string_view{"format=\"ascii\""}.size(), "format=\"binary\"");
+    }
+
+    ASSERT_THROW({ load_mesh_from_vtp(bytes_of(vtp)); }, std::runtime_error);
+}
+
+TEST(load_mesh_from_vtp, throws_if_given_something_that_isnt_a_VTP_file)
+{
+    ASSERT_THROW({ load_mesh_from_vtp(bytes_of("v 0 0 0\n")); }, std::runtime_error);
+}
@@ -0,0 +1,198 @@
+#include <oscar/Graphics/Detail/RenderQueueSortKeys.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Graphics/MaterialPropertyBlock.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+using namespace osc::detail;
+
+namespace
+{
+    // a stand-in for a `RenderObject` that identifies its material, mesh, and sub-mesh
+    struct FakeRenderObject final {
+        const void* material = nullptr;
+        const void* mesh = nullptr;
+        uint64_t submesh_id = 0;
+        uint64_t sort_key = 0;
+    };
+}
+
+TEST(RenderObjectSortKeyField, FieldsAre16And16And20And12BitsWide)
+{
+    static_assert(c_material_sort_key_field.max_id() == 0xffff);
+    static_assert(c_property_block_sort_key_field.max_id() == 0xffff);
+    static_assert(c_mesh_sort_key_field.max_id() == 0xfffff);
+    static_assert(c_submesh_sort_key_field.max_id() == 0xfff);
+}
+
+TEST(RenderObjectSortKeyField, FieldsCoverAll64BitsWithoutOverlapping)
+{
+    const uint64_t all_saturated = pack_render_object_sort_key(0xffff, 0xffff, 0xfffff, 0xfff);
+    ASSERT_EQ(all_saturated, ~uint64_t{0});
+
+    for (const RenderObjectSortKeyField field : {c_material_sort_key_field, c_property_block_sort_key_field, c_mesh_sort_key_field, c_submesh_sort_key_field}) {
+        ASSERT_EQ(field.extract(field.pack(field.max_id())), field.max_id());
+        ASSERT_EQ(field.pack(field.max_id()) & ~(field.max_id() << field.shift), 0) << "a field shouldn't write outside of its own bits";
+    }
+}
+
+TEST(RenderObjectSortKeyField, PackRoundTripsIDsThatFit)
+{
+    const uint64_t key = pack_render_object_sort_key(12, 34, 56789, 1011);
+    ASSERT_EQ(c_material_sort_key_field.extract(key), 12);
+    ASSERT_EQ(c_property_block_sort_key_field.extract(key), 34);
+    ASSERT_EQ(c_mesh_sort_key_field.extract(key), 56789);
+    ASSERT_EQ(c_submesh_sort_key_field.extract(key), 1011);
+}
+
+TEST(RenderObjectSortKeyField, PackSaturatesIDsThatDoNotFitWithoutAffectingOtherFields)
+{
+    const uint64_t key = pack_render_object_sort_key(uint64_t{1} << 16, 1, uint64_t{1} << 40, 0x1000);
+    ASSERT_EQ(c_material_sort_key_field.extract(key), c_material_sort_key_field.max_id());
+    ASSERT_EQ(c_property_block_sort_key_field.extract(key), 1);
+    ASSERT_EQ(c_mesh_sort_key_field.extract(key), c_mesh_sort_key_field.max_id());
+    ASSERT_EQ(c_submesh_sort_key_field.extract(key), c_submesh_sort_key_field.max_id());
+
+    const uint64_t property_block_saturated = pack_render_object_sort_key(3, 0x12345, 4, 5);
+    ASSERT_EQ(c_material_sort_key_field.extract(property_block_saturated), 3);
+    ASSERT_EQ(c_property_block_sort_key_field.extract(property_block_saturated), c_property_block_sort_key_field.max_id());
+    ASSERT_EQ(c_mesh_sort_key_field.extract(property_block_saturated), 4);
+    ASSERT_EQ(c_submesh_sort_key_field.extract(property_block_saturated), 5);
+}
+
+TEST(RenderObjectSortKeyField, KeysOrderByMaterialThenPropertyBlockThenMeshThenSubMesh)
+{
+    ASSERT_LT(pack_render_object_sort_key(0, 0xffff, 0xfffff, 0xfff), pack_render_object_sort_key(1, 0, 0, 0));
+    ASSERT_LT(pack_render_object_sort_key(1, 0, 0xfffff, 0xfff), pack_render_object_sort_key(1, 1, 0, 0));
+    ASSERT_LT(pack_render_object_sort_key(1, 1, 0, 0xfff), pack_render_object_sort_key(1, 1, 1, 0));
+    ASSERT_LT(pack_render_object_sort_key(1, 1, 1, 0), pack_render_object_sort_key(1, 1, 1, 1));
+}
+
+TEST(is_same_by_sort_key_field, ReturnsFalseWithoutFullComparisonIfIDsDiffer)
+{
+    size_t num_full_comparisons = 0;
+    const auto full_comparison = [&num_full_comparisons]() { ++num_full_comparisons; return true; };
+
+    const uint64_t a = pack_render_object_sort_key(1, 0, 0, 0);
+    const uint64_t b = pack_render_object_sort_key(2, 0, 0, 0);
+    ASSERT_FALSE(is_same_by_sort_key_field(c_material_sort_key_field, a, b, full_comparison));
+    ASSERT_EQ(num_full_comparisons, 0);
+}
+
+TEST(is_same_by_sort_key_field, ReturnsTrueWithoutFullComparisonIfIDsAreEqualAndUnsaturated)
+{
+    size_t num_full_comparisons = 0;
+    const auto full_comparison = [&num_full_comparisons]() { ++num_full_comparisons; return false; };
+
+    const uint64_t a = pack_render_object_sort_key(7, 1, 2, 3);
+    const uint64_t b = pack_render_object_sort_key(7, 4, 5, 6);
+    ASSERT_TRUE(is_same_by_sort_key_field(c_material_sort_key_field, a, b, full_comparison));
+    ASSERT_EQ(num_full_comparisons, 0);
+}
+
+TEST(is_same_by_sort_key_field, FallsBackToFullComparisonIfIDsAreEqualButSaturated)
+{
+    // e.g. two different meshes that were both given IDs that don't fit into the mesh field
+    const uint64_t a = pack_render_object_sort_key(0, 0, uint64_t{1} << 20, 0);
+    const uint64_t b = pack_render_object_sort_key(0, 0, (uint64_t{1} << 20) + 1, 0);
+    ASSERT_EQ(a, b);
+
+    for (const bool full_comparison_result : {false, true}) {
+        size_t num_full_comparisons = 0;
+        const auto full_comparison = [&num_full_comparisons, full_comparison_result]() { ++num_full_comparisons; return full_comparison_result; };
+        ASSERT_EQ(is_same_by_sort_key_field(c_mesh_sort_key_field, a, b, full_comparison), full_comparison_result);
+        ASSERT_EQ(num_full_comparisons, 1);
+    }
+}
+
+TEST(RenderQueueSortKeyTable, HandsOutMaterialAndMeshIDsInOrderOfFirstAppearance)
+{
+    const std::array<int, 3> materials{};
+    const std::array<int, 2> meshes{};
+
+    RenderQueueSortKeyTable table;
+    ASSERT_EQ(table.material_id(&materials[2]), 0);
+    ASSERT_EQ(table.material_id(&materials[0]), 1);
+    ASSERT_EQ(table.material_id(&materials[2]), 0);
+    ASSERT_EQ(table.material_id(&materials[1]), 2);
+    ASSERT_EQ(table.mesh_id(&meshes[1]), 0) << "meshes should be given IDs independently of materials";
+    ASSERT_EQ(table.mesh_id(&meshes[0]), 1);
+
+    table.clear();
+    ASSERT_EQ(table.material_id(&materials[0]), 0);
+    ASSERT_EQ(table, [&materials]() { RenderQueueSortKeyTable t; t.material_id(&materials[0]); return t; }());
+}
+
+TEST(RenderQueueSortKeyTable, GivesPropertyBlocksWithTheSameValuesTheSameID)
+{
+    MaterialPropertyBlock a;
+    a.set("uValue", 1.0f);
+    MaterialPropertyBlock same_values_as_a;
+    same_values_as_a.set("uValue", 1.0f);
+    MaterialPropertyBlock different;
+    different.set("uValue", 2.0f);
+
+    // (the hashes are deliberately equal, so that the values have to be compared)
+    size_t num_calls = 0;
+    const auto values_of = [&num_calls](const MaterialPropertyBlock& block)
+    {
+        return [&num_calls, &block]() { ++num_calls; return std::pair{block, size_t{42}}; };
+    };
+
+    RenderQueueSortKeyTable table;
+    const uint64_t a_id = table.property_block_id(&a, nullptr, values_of(a));
+    ASSERT_EQ(table.property_block_id(&same_values_as_a, nullptr, values_of(same_values_as_a)), a_id);
+    ASSERT_NE(table.property_block_id(&different, nullptr, values_of(different)), a_id);
+    ASSERT_EQ(num_calls, 3);
+
+    ASSERT_EQ(table.property_block_id(&a, nullptr, values_of(a)), a_id);
+    ASSERT_EQ(num_calls, 3) << "an already-seen property block shouldn't be compared by value again";
+}
+
+TEST(RenderQueueSortKeyTable, SortingByPackedKeysGroupsObjectsIntoContiguousBatches)
+{
+    const std::array<int, 5> materials{};
+    const std::array<int, 7> meshes{};
+
+    std::default_random_engine rng{1};
+    std::uniform_int_distribution<size_t> material_dist{0, materials.size() - 1};
+    std::uniform_int_distribution<size_t> mesh_dist{0, meshes.size() - 1};
+    std::uniform_int_distribution<uint64_t> submesh_dist{0, 2};
+
+    RenderQueueSortKeyTable table;
+    std::vector<FakeRenderObject> queue;
+    for (size_t i = 0; i < 1000; ++i) {
+        FakeRenderObject& ro = queue.emplace_back();
+        ro.material = &materials[material_dist(rng)];
+        ro.mesh = &meshes[mesh_dist(rng)];
+        ro.submesh_id = submesh_dist(rng);
+        ro.sort_key = pack_render_object_sort_key(table.material_id(ro.material), 0, table.mesh_id(ro.mesh), ro.submesh_id);
+    }
+    std::sort(queue.begin(), queue.end(), [](const FakeRenderObject& a, const FakeRenderObject& b) { return a.sort_key < b.sort_key; });
+
+    // each material, and each (material, mesh, sub-mesh) batch, should appear as one contiguous run
+    std::set<const void*> seen_materials;
+    std::set<std::tuple<const void*, const void*, uint64_t>> seen_batches;
+    for (size_t i = 0; i < queue.size(); ++i) {
+        const FakeRenderObject& ro = queue[i];
+        const bool starts_new_material = i == 0 or queue[i-1].material != ro.material;
+        const bool starts_new_batch = starts_new_material or queue[i-1].mesh != ro.mesh or queue[i-1].submesh_id != ro.submesh_id;
+        if (starts_new_material) {
+            ASSERT_TRUE(seen_materials.insert(ro.material).second) << "a material's objects were split into multiple runs";
+        }
+        if (starts_new_batch) {
+            ASSERT_TRUE(seen_batches.emplace(ro.material, ro.mesh, ro.submesh_id).second) << "a batch's objects were split into multiple runs";
+        }
+    }
+    ASSERT_EQ(seen_materials.size(), materials.size());
+}
@@ -0,0 +1,232 @@
+#include <oscar/Graphics/Scene/MeshDiskCache.h>
+
+#include <oscar/Graphics/Geometries/SphereGeometry.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshTopology.h>
+#include <oscar/Graphics/Scene/SceneHelpers.h>
+#include <oscar/Graphics/SubMeshDescriptor.h>
+#include <oscar/Maths/BVH.h>
+#include <oscar/Utils/TemporaryFile.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string_view>
+
+using namespace osc;
+
+namespace
+{
+    // a uniquely-named directory that's deleted (recursively) on destruction
+    class ScopedTemporaryDirectory final {
+    public:
+        ScopedTemporaryDirectory()
+        {
+            TemporaryFile reserved_name;
+            path_ = reserved_name.absolute_path();
+            path_ += "_dir";
+            std::filesystem::create_directories(path_);
+        }
+        ScopedTemporaryDirectory(const ScopedTemporaryDirectory&) = delete;
+        ScopedTemporaryDirectory& operator=(const ScopedTemporaryDirectory&) = delete;
+        ~ScopedTemporaryDirectory() noexcept
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(path_, ec);
+        }
+
+        const std::filesystem::path& path() const { return path_; }
+
+    private:
+        std::filesystem::path path_;
+    };
+
+    void write_file(const std::filesystem::path& path, std::string_view content)
+    {
+        std::ofstream out{path, std::ios::binary | std::ios::trunc};
+        out << content;
+    }
+
+    Mesh generate_mesh_with_submeshes()
+    {
+        Mesh rv = SphereGeometry{{.num_width_segments = 8, .num_height_segments = 8}};
+        rv.push_submesh_descriptor({0, 6, MeshTopology::Triangles});
+        rv.push_submesh_descriptor({6, rv.num_indices() - 6, MeshTopology::Triangles});
+        return rv;
+    }
+}
+
+TEST(MeshDiskCache, try_load_returns_nullopt_if_nothing_was_stored_for_the_source_file)
+{
+    const ScopedTemporaryDirectory directory;
+    const std::filesystem::path source = directory.path() / "mesh.obj";
+    write_file(source, "some source data");
+
+    const MeshDiskCache cache{directory.path() / "cache"};
+    ASSERT_FALSE(cache.try_load(source).has_value());
+}
+
+TEST(MeshDiskCache, try_load_returns_the_stored_mesh_and_bvh)
+{
+    const ScopedTemporaryDirectory directory;
+    const std::filesystem::path source = directory.path() / "mesh.obj";
+    write_file(source, "some source data");
+
+    const Mesh mesh = generate_mesh_with_submeshes();
+    const BVH bvh = create_triangle_bvh(mesh);
+
+    const MeshDiskCache cache{directory.path() / "cache"};
+    cache.store(source, mesh, bvh);
+    const std::optional<MeshDiskCacheEntry> entry = cache.try_load(source);
+
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_EQ(entry->mesh.topology(), mesh.topology());
+    ASSERT_EQ(entry->mesh.vertices(), mesh.vertices());
+    ASSERT_EQ(entry->mesh.normals(), mesh.normals());
+    ASSERT_EQ(entry->mesh.tex_coords(), mesh.tex_coords());
+    ASSERT_EQ(entry->mesh.colors(), mesh.colors());
+    ASSERT_TRUE(std::ranges::equal(entry->mesh.indices(), mesh.indices()));
+    ASSERT_EQ(entry->mesh.bounds(), mesh.bounds());
+    ASSERT_EQ(entry->mesh.num_submesh_descriptors(), mesh.num_submesh_descriptors());
+    for (size_t i = 0; i < mesh.num_submesh_descriptors(); ++i) {
+        ASSERT_EQ(entry->mesh.submesh_descriptor_at(i), mesh.submesh_descriptor_at(i));
+    }
+
+    ASSERT_EQ(entry->bvh.num_prims(), bvh.num_prims());
+    ASSERT_EQ(entry->bvh.nodes().size(), bvh.nodes().size());
+    ASSERT_EQ(entry->bvh.bounds(), bvh.bounds());
+    ASSERT_EQ(entry->bvh.max_depth(), bvh.max_depth());
+}
+
+TEST(MeshDiskCache, try_load_returns_nullopt_if_the_source_file_has_changed)
+{
+    const ScopedTemporaryDirectory directory;
+    const std::filesystem::path source = directory.path() / "mesh.obj";
+    write_file(source, "some source data");
+
+    const Mesh mesh = generate_mesh_with_submeshes();
+    const MeshDiskCache cache{directory.path() / "cache"};
+    cache.store(source, mesh, create_triangle_bvh(mesh));
+    ASSERT_TRUE(cache.try_load(source).has_value());
+
+    write_file(source, "some different source data");
+    ASSERT_FALSE(cache.try_load(source).has_value());
+}
+
+TEST(MeshDiskCache, try_load_returns_the_stored_mesh_if_only_the_source_files_modification_time_has_changed)
+{
+    const ScopedTemporaryDirectory directory;
+    const std::filesystem::path source = directory.path() / "mesh.obj";
+    write_file(source, "some source data");
+
+    const Mesh mesh = generate_mesh_with_submeshes();
+    const MeshDiskCache cache{directory.path() / "cache"};
+    cache.store(source, mesh, create_triangle_bvh(mesh));
+
+    std::filesystem::last_write_time(source, std::filesystem::last_write_time(source) + std::chrono::hours{1});
+    ASSERT_TRUE(cache.try_load(source).has_value()) << "the content hash should still match";
+}
+
+TEST(MeshDiskCache, try_load_returns_nullopt_if_the_entry_is_corrupt)
+{
+    const ScopedTemporaryDirectory directory;
+    const std::filesystem::path source = directory.path() / "mesh.obj";
+    write_file(source, "some source data");
+
+    const Mesh mesh = generate_mesh_with_submeshes();
+    const MeshDiskCache cache{directory.path() / "cache"};
+    cache.store(source, mesh, create_triangle_bvh(mesh));
+
+    for (const auto& entry : std::filesystem::directory_iterator{cache.directory()}) {
+        const auto size = std::filesystem::file_size(entry.path());
+        std::filesystem::resize_file(entry.path(), size/2);  // i.e. truncated
+    }
+    ASSERT_FALSE(cache.try_load(source).has_value());
+
+    for (const auto& entry : std::filesystem::directory_iterator{cache.directory()}) {
+        write_file(entry.path(), "not a mesh cache entry");
+    }
+    ASSERT_FALSE(cache.try_load(source).has_value());
+}
+
+TEST(MeshDiskCache, try_load_returns_nullopt_if_a_submesh_references_out_of_bounds_vertices)
+{
+    const ScopedTemporaryDirectory directory;
+    const std::filesystem::path source = directory.path() / "mesh.obj";
+    write_file(source, "some source data");
+
+    Mesh mesh = SphereGeometry{{.num_width_segments = 8, .num_height_segments = 8}};
+    mesh.push_submesh_descriptor({0, 6, MeshTopology::Triangles, mesh.num_vertices()});  // i.e. the indices are offset past the last vertex
+
+    const MeshDiskCache cache{directory.path() / "cache"};
+    cache.store(source, mesh, create_triangle_bvh(mesh));
+    ASSERT_FALSE(cache.try_load(source).has_value());
+}
+
+TEST(MeshDiskCache, prune_deletes_the_least_recently_used_entries_until_the_cache_fits_within_its_size_cap)
+{
+    const ScopedTemporaryDirectory directory;
+    const Mesh mesh = generate_mesh_with_submeshes();
+    const BVH bvh = create_triangle_bvh(mesh);
+
+    // measure how large one entry is, so that the cap can be set to fit two of them
+    uint64_t entry_size = 0;
+    {
+        const std::filesystem::path source = directory.path() / "m.obj";  // (the same length as the other sources)
+        write_file(source, "some source data");
+        const MeshDiskCache measuring_cache{directory.path() / "measuring_cache"};
+        measuring_cache.store(source, mesh, bvh);
+        for (const auto& entry : std::filesystem::directory_iterator{measuring_cache.directory()}) {
+            entry_size = std::filesystem::file_size(entry.path());
+        }
+    }
+    ASSERT_GT(entry_size, 0);
+
+    const MeshDiskCache cache{directory.path() / "cache", 2*entry_size};
+    const auto backdate_all_entries = [&cache]()
+    {
+        for (const auto& entry : std::filesystem::directory_iterator{cache.directory()}) {
+            std::filesystem::last_write_time(entry.path(), std::filesystem::last_write_time(entry.path()) - std::chrono::hours{1});
+        }
+    };
+
+    const std::filesystem::path a = directory.path() / "a.obj";
+    const std::filesystem::path b = directory.path() / "b.obj";
+    const std::filesystem::path c = directory.path() / "c.obj";
+    for (const auto& source : {a, b, c}) {
+        write_file(source, "some source data");
+        cache.store(source, mesh, bvh);
+        backdate_all_entries();
+    }
+    ASSERT_TRUE(cache.try_load(a).has_value());  // should make `a` the most-recently-used entry
+
+    cache.prune();
+
+    ASSERT_TRUE(cache.try_load(a).has_value());
+    ASSERT_FALSE(cache.try_load(b).has_value()) << "should've been deleted, because it was the least-recently-used entry";
+    ASSERT_TRUE(cache.try_load(c).has_value());
+}
+
+TEST(MeshDiskCache, prune_deletes_old_temporary_files)
+{
+    const ScopedTemporaryDirectory directory;
+    const MeshDiskCache cache{directory.path() / "cache"};
+    std::filesystem::create_directories(cache.directory());
+
+    const std::filesystem::path old_temporary_file = cache.directory() / "0123.oscmesh.tmp1_0";
+    write_file(old_temporary_file, "partially-written entry");
+    std::filesystem::last_write_time(old_temporary_file, std::filesystem::last_write_time(old_temporary_file) - std::chrono::hours{2});
+
+    const std::filesystem::path new_temporary_file = cache.directory() / "4567.oscmesh.tmp1_1";
+    write_file(new_temporary_file, "entry that might still be being written");
+
+    cache.prune();
+
+    ASSERT_FALSE(std::filesystem::exists(old_temporary_file));
+    ASSERT_TRUE(std::filesystem::exists(new_temporary_file));
+}
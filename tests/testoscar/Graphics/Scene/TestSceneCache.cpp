@@ -1,5 +1,6 @@
 #include <oscar/Graphics/Scene/SceneCache.h>
 
+#include <oscar/Graphics/Scene/SceneCachePendingMeshes.h>
 #include <oscar/Maths/AABB.h>
 #include <oscar/Maths/BVH.h>
 #include <oscar/Maths/MathHelpers.h>
@@ -8,10 +9,36 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 using namespace osc;
 
+namespace
+{
+    Mesh generate_triangle_mesh()
+    {
+        Mesh rv;
+        rv.set_vertices({{-1.0f, -1.0f, 0.0f}, {1.0f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}});
+        rv.set_indices({0, 1, 2});
+        return rv;
+    }
+
+    // blocks until the cache has finished loading all asynchronously-requested meshes
+    void wait_for_async_loading(const SceneCache& cache)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+        while (cache.async_loading_progress().is_loading() and std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+    }
+}
+
 TEST(SceneCache, get_bvh_on_empty_mesh_returns_empty_bvh)
 {
     SceneCache c;
@@ -42,3 +69,100 @@ TEST(SceneCache, get_bvh_on_nonempty_mesh_returns_expected_root_node)
     ASSERT_FALSE(bvh.empty());
     ASSERT_EQ(expected_root, bvh.bounds());
 }
+
+TEST(SceneCache, get_mesh_only_calls_getter_once_when_the_same_key_is_concurrently_requested)
+{
+    SceneCache cache;
+    std::atomic<int> num_calls = 0;
+    const auto getter = [&num_calls]()
+    {
+        ++num_calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});  // so that the requests overlap
+        return generate_triangle_mesh();
+    };
+
+    std::vector<std::future<Mesh>> results;
+    for (int i = 0; i < 8; ++i) {
+        results.push_back(std::async(std::launch::async, [&cache, &getter]() { return cache.get_mesh("key", getter); }));
+    }
+    const Mesh first = results.front().get();
+    for (auto it = results.begin() + 1; it != results.end(); ++it) {
+        ASSERT_EQ(it->get(), first);
+    }
+    ASSERT_EQ(num_calls, 1);
+}
+
+TEST(SceneCache, get_mesh_returns_a_nonempty_fallback_if_the_getter_throws)
+{
+    SceneCache cache;
+    const Mesh mesh = cache.get_mesh("key", []() -> Mesh { throw std::runtime_error{"this should be caught"}; });
+    ASSERT_FALSE(mesh.vertices().empty());
+}
+
+TEST(SceneCache, get_mesh_async_returns_placeholder_until_the_mesh_has_loaded)
+{
+    SceneCache cache;
+    std::promise<void> unblock;
+    std::shared_future<void> unblocked = unblock.get_future().share();
+    const auto getter = [unblocked]()
+    {
+        unblocked.wait();
+        return generate_triangle_mesh();
+    };
+
+    ASSERT_TRUE(cache.get_mesh_async("key", getter).vertices().empty());
+    ASSERT_TRUE(cache.get_mesh_async("key", getter).vertices().empty()) << "should still be loading";
+    ASSERT_EQ(cache.async_loading_progress(), (SceneCacheLoadingProgress{.num_requested = 1, .num_completed = 0}));
+
+    unblock.set_value();
+    wait_for_async_loading(cache);
+
+    ASSERT_EQ(cache.async_loading_progress(), (SceneCacheLoadingProgress{.num_requested = 1, .num_completed = 1}));
+    const Mesh mesh = cache.get_mesh_async("key", getter);
+    ASSERT_EQ(mesh.num_vertices(), 3);
+    ASSERT_EQ(cache.get_mesh("key", []() -> Mesh { throw std::runtime_error{"shouldn't be called"}; }), mesh);
+}
+
+TEST(SceneCache, get_mesh_async_only_adds_the_requesters_unloaded_meshes_to_its_pending_meshes)
+{
+    SceneCache cache;
+    std::promise<void> unblock;
+    std::shared_future<void> unblocked = unblock.get_future().share();
+    const auto blocked_getter = [unblocked]()
+    {
+        unblocked.wait();
+        return generate_triangle_mesh();
+    };
+
+    // another requester's mesh finishing shouldn't look like progress for this requester
+    SceneCachePendingMeshes pending;
+    SceneCachePendingMeshes other_pending;
+    cache.get_mesh_async("mine", blocked_getter, pending);
+    cache.get_mesh_async("theirs", generate_triangle_mesh, other_pending);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (not other_pending.any_loaded() and std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    ASSERT_TRUE(other_pending.any_loaded());
+    ASSERT_EQ(pending.size(), 1);
+    ASSERT_FALSE(pending.any_loaded());
+
+    unblock.set_value();
+    wait_for_async_loading(cache);
+    ASSERT_TRUE(pending.any_loaded());
+
+    // already-loaded meshes aren't pending
+    pending.clear();
+    ASSERT_EQ(cache.get_mesh_async("mine", blocked_getter, pending).num_vertices(), 3);
+    ASSERT_TRUE(pending.empty());
+}
+
+TEST(SceneCache, get_mesh_async_builds_the_loaded_meshs_bvh)
+{
+    SceneCache cache;
+    cache.get_mesh_async("key", generate_triangle_mesh);
+    wait_for_async_loading(cache);
+
+    const Mesh mesh = cache.get_mesh_async("key", generate_triangle_mesh);
+    ASSERT_FALSE(cache.get_bvh(mesh).empty());
+}
@@ -0,0 +1,103 @@
+#include <oscar/Graphics/Scene/SceneDecorationList.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Color.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <span>
+
+using namespace osc;
+
+namespace
+{
+    SceneDecorationList generate_list(const Mesh& mesh, size_t n)
+    {
+        SceneDecorationList rv;
+        for (size_t i = 0; i < n; ++i) {
+            rv.push_back(SceneDecoration{
+                .mesh = mesh,
+                .transform = {.position = Vec3{static_cast<float>(i)}},
+                .shading = Color::red(),
+            });
+        }
+        return rv;
+    }
+}
+
+TEST(SceneDecorationList, is_empty_when_default_constructed)
+{
+    const SceneDecorationList list;
+    ASSERT_TRUE(list.empty());
+    ASSERT_EQ(list.size(), 0);
+    ASSERT_TRUE(list.decoration_hashes().empty());
+}
+
+TEST(SceneDecorationList, push_back_stores_decoration_and_its_hash)
+{
+    const SceneDecoration decoration{.shading = Color::blue()};
+
+    SceneDecorationList list;
+    list.push_back(decoration);
+
+    ASSERT_EQ(list.size(), 1);
+    ASSERT_EQ(list[0], decoration);
+    ASSERT_EQ(list.decoration_hashes().size(), 1);
+    ASSERT_EQ(list.decoration_hashes()[0], std::hash<SceneDecoration>{}(decoration));
+}
+
+TEST(SceneDecorationList, can_be_implicitly_converted_to_a_span_of_its_decorations)
+{
+    const SceneDecorationList list = generate_list(Mesh{}, 5);
+    const std::span<const SceneDecoration> span = list;
+
+    ASSERT_TRUE(std::ranges::equal(span, list));
+}
+
+TEST(SceneDecorationList, hash_is_equal_for_lists_that_contain_equal_decorations)
+{
+    const Mesh mesh;
+    ASSERT_EQ(generate_list(mesh, 10).hash(), generate_list(mesh, 10).hash());
+}
+
+TEST(SceneDecorationList, hash_changes_if_any_decoration_changes)
+{
+    const Mesh mesh;
+    const SceneDecorationList original = generate_list(mesh, 10);
+
+    for (size_t i = 0; i < original.size(); ++i) {
+        SceneDecorationList modified;
+        for (size_t j = 0; j < original.size(); ++j) {
+            modified.push_back(j == i ? original[j].with_color(Color::green()) : original[j]);
+        }
+
+        ASSERT_NE(modified.hash(), original.hash());
+        ASSERT_NE(modified.decoration_hashes()[i], original.decoration_hashes()[i]);
+    }
+}
+
+TEST(SceneDecorationList, hash_depends_on_decoration_order)
+{
+    const Mesh mesh;
+    const SceneDecorationList original = generate_list(mesh, 2);
+
+    SceneDecorationList reversed;
+    reversed.push_back(original[1]);
+    reversed.push_back(original[0]);
+
+    ASSERT_NE(reversed.hash(), original.hash());
+}
+
+TEST(SceneDecorationList, clear_resets_the_list)
+{
+    SceneDecorationList list = generate_list(Mesh{}, 3);
+    list.clear();
+
+    ASSERT_TRUE(list.empty());
+    ASSERT_TRUE(list.decoration_hashes().empty());
+    ASSERT_EQ(list.hash(), SceneDecorationList{}.hash());
+}
@@ -1,10 +1,20 @@
 #include <oscar/Graphics/Scene/SceneHelpers.h>
 
+#include <oscar/Graphics/Geometries/SphereGeometry.h>
+#include <oscar/Graphics/Mesh.h>
 #include <oscar/Graphics/Scene/SceneCache.h>
+#include <oscar/Maths/BVH.h>
+#include <oscar/Maths/Line.h>
+#include <oscar/Maths/RayCollision.h>
+#include <oscar/Maths/Transform.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Maths/VecFunctions.h>
 
 #include <gtest/gtest.h>
 
 #include <cstddef>
+#include <optional>
+#include <vector>
 
 using namespace osc;
 
@@ -26,3 +36,34 @@ TEST(draw_arrow, generates_nothing_if_length_between_start_and_end_is_zero)
 
     ASSERT_EQ(num_decorations_generated, 0);
 }
+
+TEST(get_closest_worldspace_ray_triangle_collisions, returns_same_collisions_as_single_ray_version)
+{
+    const Mesh mesh = SphereGeometry{};
+    const BVH bvh = create_triangle_bvh(mesh);
+    const Transform transform = {.scale = {2.0f, 1.0f, 0.5f}, .position = {1.0f, 2.0f, 3.0f}};
+
+    // a grid of rays that point at the (transformed) sphere, some of which miss it
+    std::vector<Line> rays;
+    for (int x = -10; x <= 10; ++x) {
+        for (int y = -10; y <= 10; ++y) {
+            const Vec3 origin = transform.position + Vec3{0.25f*static_cast<float>(x), 0.15f*static_cast<float>(y), 10.0f};
+            rays.push_back(Line{origin, normalize(Vec3{0.1f, 0.0f, -1.0f})});
+        }
+    }
+
+    const std::vector<std::optional<RayCollision>> got = get_closest_worldspace_ray_triangle_collisions(mesh, bvh, transform, rays);
+    ASSERT_EQ(got.size(), rays.size());
+
+    size_t num_hits = 0;
+    for (size_t i = 0; i < rays.size(); ++i) {
+        const std::optional<RayCollision> expected = get_closest_worldspace_ray_triangle_collision(mesh, bvh, transform, rays[i]);
+        ASSERT_EQ(got[i].has_value(), expected.has_value()) << "ray = " << i;
+        if (got[i]) {
+            ASSERT_NEAR(got[i]->distance, expected->distance, 1e-4f);
+            ++num_hits;
+        }
+    }
+    ASSERT_GT(num_hits, 0);
+    ASSERT_LT(num_hits, rays.size());
+}
@@ -16,11 +16,13 @@
 #include <oscar/Graphics/Cubemap.h>
 #include <oscar/Graphics/CullMode.h>
 #include <oscar/Graphics/DepthStencilRenderBufferFormat.h>
+#include <oscar/Graphics/Geometries/PlaneGeometry.h>
 #include <oscar/Graphics/Graphics.h>
 #include <oscar/Graphics/Material.h>
 #include <oscar/Graphics/MaterialPropertyBlock.h>
 #include <oscar/Graphics/Mesh.h>
 #include <oscar/Graphics/MeshTopology.h>
+#include <oscar/Graphics/RenderStatistics.h>
 #include <oscar/Graphics/RenderTexture.h>
 #include <oscar/Graphics/Shader.h>
 #include <oscar/Graphics/ShaderPropertyType.h>
@@ -31,24 +33,30 @@
 #include <oscar/Maths/Mat4.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/Quat.h>
+#include <oscar/Maths/Transform.h>
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Maths/Vec3.h>
 #include <oscar/Maths/Vec4.h>
 #include <oscar/Platform/App.h>
 #include <oscar/Platform/AppMetadata.h>
+#include <oscar/Platform/IScreen.h>
 #include <oscar/Utils/CStringView.h>
 #include <oscar/Utils/EnumHelpers.h>
 #include <oscar/Utils/StringHelpers.h>
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <random>
 #include <span>
 #include <sstream>
 #include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace graphics = osc::graphics;
 using namespace osc::testing;
@@ -378,6 +386,50 @@ namespace
         }
     )";
 
+    // same per-instance color attribute layout as `SceneRenderer`'s `DrawColoredObjects.vert`
+    constexpr CStringView c_instanced_color_vertex_shader_src = R"(
+        #version 330 core
+
+        uniform mat4 uViewProjMat;
+
+        layout (location = 0) in vec3 aPos;
+        layout (location = 6) in mat4 aModelMat;
+        layout (location = 13) in vec4 aDiffuseColor;
+
+        out vec4 DiffuseColor;
+
+        void main()
+        {
+            DiffuseColor = aDiffuseColor;
+            gl_Position = uViewProjMat * aModelMat * vec4(aPos, 1.0);
+        }
+    )";
+
+    constexpr CStringView c_instanced_color_fragment_shader_src = R"(
+        #version 330 core
+
+        in vec4 DiffuseColor;
+        out vec4 FragColor;
+
+        void main()
+        {
+            FragColor = DiffuseColor;
+        }
+    )";
+
+    // a screen that calls the given function whenever it's drawn, so that tests can
+    // step one frame of the application and inspect its `RenderStatistics`
+    class DrawCallbackScreen final : public IScreen {
+    public:
+        explicit DrawCallbackScreen(std::function<void()> on_draw) :
+            on_draw_{std::move(on_draw)}
+        {}
+    private:
+        void impl_on_draw() final { on_draw_(); }
+
+        std::function<void()> on_draw_;
+    };
+
     Texture2D GenerateTexture()
     {
         Texture2D rv{Vec2i{2, 2}};
@@ -1536,6 +1588,30 @@ TEST_F(Renderer, MaterialPropertyBlockPrintingToOutputStreamMentionsMaterialProp
     ASSERT_TRUE(contains(ss.str(), "MaterialPropertyBlock"));
 }
 
+TEST_F(Renderer, MaterialPropertyBlockHashIsIndependentOfTheOrderThatValuesWereSetIn)
+{
+    MaterialPropertyBlock m1;
+    m1.set("a", 1.0f);
+    m1.set("b", Color::red());
+
+    MaterialPropertyBlock m2;
+    m2.set("b", Color::red());
+    m2.set("a", 1.0f);
+
+    ASSERT_EQ(m1, m2);
+    ASSERT_EQ(std::hash<MaterialPropertyBlock>{}(m1), std::hash<MaterialPropertyBlock>{}(m2));
+}
+
+TEST_F(Renderer, MaterialPropertyBlockHashChangesWhenAValueChanges)
+{
+    MaterialPropertyBlock m;
+    m.set("a", 1.0f);
+    const size_t hash_before = std::hash<MaterialPropertyBlock>{}(m);
+    m.set("a", 2.0f);
+
+    ASSERT_NE(std::hash<MaterialPropertyBlock>{}(m), hash_before);
+}
+
 TEST_F(Renderer, MeshTopologyAllCanBeWrittenToStream)
 {
     for (size_t i = 0; i < num_options<MeshTopology>(); ++i) {
@@ -1627,3 +1703,47 @@ TEST_F(Renderer, MeshNormalVectorsMaterial_can_default_construct)
 {
     [[maybe_unused]] MeshNormalVectorsMaterial default_constructed;  // should compile, run, etc.
 }
+
+TEST_F(Renderer, ObjectsThatOnlyDifferByAnInstancedColorAreDrawnAsOneInstancedBatch)
+{
+    // this is what `SceneRenderer` relies on to draw decorations that only differ
+    // by color in one draw call
+    const Material material{Shader{c_instanced_color_vertex_shader_src, c_instanced_color_fragment_shader_src}};
+    const Mesh quad = PlaneGeometry{};
+
+    MaterialPropertyBlock red_props;
+    red_props.set("aDiffuseColor", Color::red());
+    MaterialPropertyBlock blue_props;
+    blue_props.set("aDiffuseColor", Color::blue());
+
+    RenderTexture render_texture{{.dimensions = {4, 4}}};
+
+    // draw a red quad over the left half of the output and a blue one over the right half
+    g_App->setup_main_loop<DrawCallbackScreen>([&]()
+    {
+        Camera camera;
+        camera.set_view_matrix_override(identity<Mat4>());
+        camera.set_projection_matrix_override(identity<Mat4>());
+        camera.set_background_color(Color::black());
+        graphics::draw(quad, {.scale = {1.0f, 2.0f, 1.0f}, .position = {-0.5f, 0.0f, 0.0f}}, material, camera, red_props);
+        graphics::draw(quad, {.scale = {1.0f, 2.0f, 1.0f}, .position = { 0.5f, 0.0f, 0.0f}}, material, camera, blue_props);
+        camera.render_to(render_texture);
+    });
+    g_App->do_main_loop_step();
+    g_App->teardown_main_loop();
+
+    const RenderStatistics statistics = g_App->graphics_backend_previous_frame_render_statistics();
+    ASSERT_EQ(statistics.num_render_objects, 2);
+    ASSERT_EQ(statistics.num_batches, 1);
+    ASSERT_EQ(statistics.num_draw_calls, 1);
+
+    // each instance should've been drawn with its own color
+    Texture2D output{render_texture.dimensions()};
+    graphics::copy_texture(render_texture, output);
+    const std::vector<Color> pixels = output.pixels();
+    ASSERT_EQ(pixels.size(), 16);
+    for (size_t row = 0; row < 4; ++row) {
+        ASSERT_EQ(pixels[4*row + 0], Color::red());
+        ASSERT_EQ(pixels[4*row + 3], Color::blue());
+    }
+}
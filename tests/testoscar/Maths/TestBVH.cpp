@@ -1,8 +1,66 @@
 #include <oscar/Maths/BVH.h>
 
+#include <testoscar/TestingHelpers.h>
+
 #include <gtest/gtest.h>
+#include <oscar/Maths/AABB.h>
+#include <oscar/Maths/CollisionTests.h>
+#include <oscar/Maths/FrustumPlanes.h>
+#include <oscar/Maths/Line.h>
+#include <oscar/Maths/MatFunctions.h>
+#include <oscar/Maths/Triangle.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Maths/VecFunctions.h>
+#include <oscar/Utils/EnumHelpers.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <vector>
 
 using namespace osc;
+using namespace osc::testing;
+
+namespace
+{
+    // returns a "soup" of (indexed) triangles that are scattered in a unit-ish cube
+    std::vector<Vec3> generate_triangle_soup(size_t num_triangles)
+    {
+        std::vector<Vec3> rv;
+        rv.reserve(3*num_triangles);
+        for (size_t i = 0; i < num_triangles; ++i) {
+            const Vec3 origin = generate<Vec3>();
+            for (size_t vert = 0; vert < 3; ++vert) {
+                rv.push_back(origin + 0.1f*generate<Vec3>());
+            }
+        }
+        return rv;
+    }
+
+    // returns a ray that starts outside of the unit cube and points (roughly) through it
+    Line generate_ray_through_unit_cube()
+    {
+        const Vec3 origin = Vec3{-1.0f} + 0.5f*generate<Vec3>();
+        const Vec3 target = generate<Vec3>();
+        return Line{origin, normalize(target - origin)};
+    }
+
+    std::optional<RayCollision> find_closest_collision_brute_force(std::span<const Vec3> vertices, const Line& ray)
+    {
+        std::optional<RayCollision> rv;
+        for (size_t i = 0; i+2 < vertices.size(); i += 3) {
+            const auto collision = find_collision(ray, Triangle{vertices[i], vertices[i+1], vertices[i+2]});
+            if (collision and (not rv or collision->distance < rv->distance)) {
+                rv = collision;
+            }
+        }
+        return rv;
+    }
+}
 
 TEST(BVH, GetMaxDepthReturns0OnDefaultConstruction)
 {
@@ -10,3 +68,262 @@ TEST(BVH, GetMaxDepthReturns0OnDefaultConstruction)
 
     ASSERT_EQ(bvh.max_depth(), 0);
 }
+
+TEST(BVH, ForEachAABBInConvexVolumeEmitsSameAABBsAsBruteForceTesting)
+{
+    // a grid of AABBs, some of which are inside a (clip-space) frustum
+    std::vector<AABB> aabbs;
+    for (int x = -5; x <= 5; ++x) {
+        for (int y = -5; y <= 5; ++y) {
+            for (int z = -5; z <= 5; ++z) {
+                const Vec3 origin = 0.3f * Vec3{static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)};
+                aabbs.push_back(AABB{origin - 0.1f, origin + 0.1f});
+            }
+        }
+    }
+    BVH bvh;
+    bvh.build_from_aabbs(aabbs);
+    ASSERT_EQ(bvh.num_prims(), aabbs.size());
+
+    const FrustumPlanes frustum = extract_frustum_planes(identity<Mat4>());
+
+    std::vector<ptrdiff_t> expected;
+    for (size_t i = 0; i < aabbs.size(); ++i) {
+        if (is_intersecting(frustum, aabbs[i])) {
+            expected.push_back(static_cast<ptrdiff_t>(i));
+        }
+    }
+    ASSERT_FALSE(expected.empty());
+    ASSERT_LT(expected.size(), aabbs.size());
+
+    std::vector<ptrdiff_t> got;
+    bvh.for_each_aabb_in_convex_volume(frustum, [&got](ptrdiff_t id) { got.push_back(id); });
+    std::sort(got.begin(), got.end());
+
+    ASSERT_EQ(got, expected);
+}
+
+TEST(BVH, ClosestRayIndexedTriangleCollisionReturnsSameDistanceAsBruteForceTesting)
+{
+    const std::vector<Vec3> vertices = generate_triangle_soup(500);
+    std::vector<uint32_t> indices(vertices.size());
+    std::iota(indices.begin(), indices.end(), uint32_t{0});
+
+    for (BVHBuildStrategy strategy : make_option_iterable<BVHBuildStrategy>()) {
+        BVH bvh;
+        bvh.build_from_indexed_triangles(vertices, indices, strategy);
+
+        size_t num_hits = 0;
+        for (size_t i = 0; i < 200; ++i) {
+            const Line ray = generate_ray_through_unit_cube();
+            const std::optional<RayCollision> expected = find_closest_collision_brute_force(vertices, ray);
+            const std::optional<BVHCollision> got = bvh.closest_ray_indexed_triangle_collision(vertices, indices, ray);
+
+            ASSERT_EQ(got.has_value(), expected.has_value());
+            if (got) {
+                ASSERT_EQ(got->distance, expected->distance);
+                ++num_hits;
+            }
+        }
+        ASSERT_GT(num_hits, 0);
+    }
+}
+
+TEST(BVH, ClosestRayIndexedTriangleCollisionsReturnsSameCollisionsAsSingleRayQueries)
+{
+    const std::vector<Vec3> vertices = generate_triangle_soup(500);
+    std::vector<uint16_t> indices(vertices.size());
+    std::iota(indices.begin(), indices.end(), uint16_t{0});
+
+    // (not a multiple of the packet size, so that partially-filled packets are also tested)
+    std::vector<Line> rays;
+    for (size_t i = 0; i < 1003; ++i) {
+        rays.push_back(generate_ray_through_unit_cube());
+    }
+
+    for (BVHBuildStrategy strategy : make_option_iterable<BVHBuildStrategy>()) {
+        BVH bvh;
+        bvh.build_from_indexed_triangles(vertices, indices, strategy);
+
+        const std::vector<std::optional<BVHCollision>> got = bvh.closest_ray_indexed_triangle_collisions(vertices, indices, rays);
+        ASSERT_EQ(got.size(), rays.size());
+
+        size_t num_hits = 0;
+        for (size_t i = 0; i < rays.size(); ++i) {
+            const std::optional<BVHCollision> expected = bvh.closest_ray_indexed_triangle_collision(vertices, indices, rays[i]);
+            ASSERT_EQ(got[i].has_value(), expected.has_value()) << "ray = " << i;
+            if (got[i]) {
+                ASSERT_FLOAT_EQ(got[i]->distance, expected->distance);
+                ++num_hits;
+            }
+        }
+        ASSERT_GT(num_hits, 0);
+    }
+}
+
+TEST(BVH, ClosestRayIndexedTriangleCollisionsWorksWithLargeBatchesOfCoherentRays)
+{
+    const std::vector<Vec3> vertices = generate_triangle_soup(500);
+    std::vector<uint32_t> indices(vertices.size());
+    std::iota(indices.begin(), indices.end(), uint32_t{0});
+
+    BVH bvh;
+    bvh.build_from_indexed_triangles(vertices, indices);
+
+    // a grid of parallel rays (e.g. like when projecting points onto a mesh), which is large
+    // enough to be split across threads
+    std::vector<Line> rays;
+    for (size_t x = 0; x < 100; ++x) {
+        for (size_t y = 0; y < 100; ++y) {
+            const Vec3 origin = {0.01f * static_cast<float>(x), 0.01f * static_cast<float>(y), -1.0f};
+            rays.push_back(Line{origin, Vec3{0.0f, 0.0f, 1.0f}});
+        }
+    }
+
+    const std::vector<std::optional<BVHCollision>> got = bvh.closest_ray_indexed_triangle_collisions(vertices, indices, rays);
+    ASSERT_EQ(got.size(), rays.size());
+    for (size_t i = 0; i < rays.size(); ++i) {
+        const std::optional<RayCollision> expected = find_closest_collision_brute_force(vertices, rays[i]);
+        ASSERT_EQ(got[i].has_value(), expected.has_value()) << "ray = " << i;
+        if (got[i]) {
+            ASSERT_FLOAT_EQ(got[i]->distance, expected->distance);
+        }
+    }
+}
+
+TEST(BVH, ClosestRayIndexedTriangleCollisionsReturnsNoCollisionsForEmptyBVH)
+{
+    const std::vector<Vec3> vertices = generate_triangle_soup(10);
+    std::vector<uint32_t> indices(vertices.size());
+    std::iota(indices.begin(), indices.end(), uint32_t{0});
+    const std::vector<Line> rays(10, generate_ray_through_unit_cube());
+
+    const std::vector<std::optional<BVHCollision>> got = BVH{}.closest_ray_indexed_triangle_collisions(vertices, indices, rays);
+    ASSERT_EQ(got.size(), rays.size());
+    ASSERT_TRUE(std::all_of(got.begin(), got.end(), [](const auto& collision) { return not collision.has_value(); }));
+}
+
+TEST(BVH, ForEachRayAABBCollisionEmitsSameAABBsAsBruteForceTesting)
+{
+    std::vector<AABB> aabbs;
+    for (size_t i = 0; i < 1000; ++i) {
+        const Vec3 origin = generate<Vec3>();
+        aabbs.push_back(AABB{origin, origin + 0.05f + 0.1f*generate<Vec3>()});
+    }
+
+    for (BVHBuildStrategy strategy : make_option_iterable<BVHBuildStrategy>()) {
+        BVH bvh;
+        bvh.build_from_aabbs(aabbs, strategy);
+
+        for (size_t i = 0; i < 50; ++i) {
+            const Line ray = generate_ray_through_unit_cube();
+
+            std::vector<ptrdiff_t> expected;
+            for (size_t id = 0; id < aabbs.size(); ++id) {
+                if (find_collision(ray, aabbs[id])) {
+                    expected.push_back(static_cast<ptrdiff_t>(id));
+                }
+            }
+
+            std::vector<ptrdiff_t> got;
+            bvh.for_each_ray_aabb_collision(ray, [&got](const BVHCollision& collision) { got.push_back(collision.id); });
+            std::sort(got.begin(), got.end());
+
+            ASSERT_EQ(got, expected);
+        }
+    }
+}
+
+TEST(BVH, MaxDepthIsBoundedForHighlySkewedInputs)
+{
+    // exponentially-spaced AABBs produce maximally unbalanced midpoint/SAH splits
+    std::vector<AABB> aabbs;
+    for (int i = 0; i < 2000; ++i) {
+        const float x = std::pow(1.01f, static_cast<float>(i));
+        aabbs.push_back(AABB{Vec3{x, 0.0f, 0.0f}, Vec3{x + 0.001f, 1.0f, 1.0f}});
+    }
+
+    for (BVHBuildStrategy strategy : make_option_iterable<BVHBuildStrategy>()) {
+        BVH bvh;
+        bvh.build_from_aabbs(aabbs, strategy);
+        ASSERT_EQ(bvh.num_prims(), aabbs.size());
+        ASSERT_LE(bvh.max_depth(), BVH::max_traversal_depth());
+    }
+}
+
+TEST(BVH, LargeBuildsThatUseMultipleThreadsReferenceEveryPrimOnce)
+{
+    // large enough that the SAH builder builds subtrees (and bins prims) on multiple threads
+    std::vector<AABB> aabbs;
+    for (size_t i = 0; i < 200000; ++i) {
+        const Vec3 origin = 2.0f*generate<Vec3>() - 1.0f;
+        aabbs.push_back(AABB{origin, origin + 0.001f});
+    }
+
+    BVH bvh;
+    bvh.build_from_aabbs(aabbs, BVHBuildStrategy::SurfaceAreaHeuristic);
+    ASSERT_EQ(bvh.num_prims(), aabbs.size());
+    ASSERT_LE(bvh.max_depth(), BVH::max_traversal_depth());
+
+    // a convex volume that contains everything should emit every prim exactly once
+    const FrustumPlanes everything = extract_frustum_planes(identity<Mat4>());
+    std::vector<ptrdiff_t> got;
+    bvh.for_each_aabb_in_convex_volume(everything, [&got](ptrdiff_t id) { got.push_back(id); });
+    std::sort(got.begin(), got.end());
+
+    std::vector<ptrdiff_t> expected(aabbs.size());
+    std::iota(expected.begin(), expected.end(), ptrdiff_t{0});
+    ASSERT_EQ(got, expected);
+}
+
+TEST(BVH, AssignFromNodesAndPrimsProducesAnEquivalentBVH)
+{
+    const std::vector<Vec3> vertices = generate_triangle_soup(500);
+    std::vector<uint32_t> indices(vertices.size());
+    std::iota(indices.begin(), indices.end(), uint32_t{0});
+
+    BVH original;
+    original.build_from_indexed_triangles(vertices, indices);
+
+    BVH copy;
+    copy.assign({original.nodes().begin(), original.nodes().end()}, {original.prims().begin(), original.prims().end()});
+
+    ASSERT_EQ(copy.num_prims(), original.num_prims());
+    ASSERT_EQ(copy.max_depth(), original.max_depth());
+    ASSERT_EQ(copy.bounds(), original.bounds());
+    for (size_t i = 0; i < 100; ++i) {
+        const Line ray = generate_ray_through_unit_cube();
+        const auto expected = original.closest_ray_indexed_triangle_collision(vertices, indices, ray);
+        const auto got = copy.closest_ray_indexed_triangle_collision(vertices, indices, ray);
+        ASSERT_EQ(got.has_value(), expected.has_value());
+        if (got) {
+            ASSERT_EQ(got->id, expected->id);
+        }
+    }
+}
+
+TEST(BVH, AssignThrowsIfTheNodesDoNotFormAValidTree)
+{
+    const AABB bounds{Vec3{0.0f}, Vec3{1.0f}};
+    const std::vector<BVHPrim> prims = {BVHPrim{0, bounds}};
+
+    BVH bvh;
+    ASSERT_NO_THROW(bvh.assign({BVHNode::leaf(bounds, 0)}, prims));
+    ASSERT_ANY_THROW(bvh.assign({BVHNode::leaf(bounds, 1)}, prims)) << "references an out-of-bounds prim";
+    ASSERT_ANY_THROW(bvh.assign({BVHNode::node(bounds, 1), BVHNode::leaf(bounds, 0)}, prims)) << "inner node is missing its right-hand child";
+    ASSERT_ANY_THROW(bvh.assign({BVHNode::node(bounds, 5), BVHNode::leaf(bounds, 0), BVHNode::leaf(bounds, 0)}, prims)) << "inner node references out-of-bounds nodes";
+    ASSERT_ANY_THROW(bvh.assign({BVHNode::leaf(bounds, 0), BVHNode::leaf(bounds, 0)}, prims)) << "leaf node has trailing nodes";
+
+    // a (maximally skewed) tree that's deeper than the maximum traversal depth: each inner
+    // node's left-hand child is a leaf and its right-hand child is the next inner node
+    std::vector<BVHNode> deep_nodes;
+    for (size_t depth = 0; depth < BVH::max_traversal_depth(); ++depth) {
+        deep_nodes.push_back(BVHNode::node(bounds, 1));
+        deep_nodes.push_back(BVHNode::leaf(bounds, 0));
+    }
+    deep_nodes.push_back(BVHNode::leaf(bounds, 0));
+    ASSERT_ANY_THROW(bvh.assign(deep_nodes, prims));
+    ASSERT_NO_THROW(bvh.assign({deep_nodes.begin() + 2, deep_nodes.end()}, prims)) << "one level shallower should be fine";
+    ASSERT_ANY_THROW(bvh.assign(deep_nodes, {}));
+    ASSERT_EQ(bvh.max_depth(), BVH::max_traversal_depth()) << "a failed assignment shouldn't modify the BVH";
+}
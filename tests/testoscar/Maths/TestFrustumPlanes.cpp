@@ -1,12 +1,46 @@
 #include <oscar/Maths/FrustumPlanes.h>
 
 #include <gtest/gtest.h>
+#include <oscar/Maths/AABB.h>
+#include <oscar/Maths/Angle.h>
+#include <oscar/Maths/CollisionTests.h>
+#include <oscar/Maths/MatFunctions.h>
+#include <oscar/Maths/PlaneFunctions.h>
+#include <oscar/Maths/Vec3.h>
 
+#include <algorithm>
 #include <concepts>
+#include <ranges>
 
 using namespace osc;
+using namespace osc::literals;
+namespace rgs = std::ranges;
 
 TEST(FrustumPlanes, IsRegular)
 {
     static_assert(std::regular<FrustumPlanes>);
 }
+
+TEST(extract_frustum_planes, ReturnsPlanesOfClipSpaceCubeWhenGivenIdentityMatrix)
+{
+    const FrustumPlanes planes = extract_frustum_planes(identity<Mat4>());
+
+    for (const Vec3& inside : {Vec3{}, Vec3{0.9f, -0.9f, 0.5f}}) {
+        ASSERT_TRUE(rgs::all_of(planes, [&inside](const auto& plane) { return signed_distance_between(plane, inside) < 0.0f; }));
+    }
+    for (const Vec3& outside : {Vec3{1.1f, 0.0f, 0.0f}, Vec3{0.0f, -1.1f, 0.0f}, Vec3{0.0f, 0.0f, 1.1f}}) {
+        ASSERT_TRUE(rgs::any_of(planes, [&outside](const auto& plane) { return signed_distance_between(plane, outside) > 0.0f; }));
+    }
+}
+
+TEST(extract_frustum_planes, PlanesOfPerspectiveCameraContainOnlyPointsInFrontOfCamera)
+{
+    // camera at origin, looking down -Z (OpenGL convention)
+    const Mat4 projection = perspective(90_deg, 1.0f, 0.1f, 10.0f);
+    const FrustumPlanes planes = extract_frustum_planes(projection);
+
+    ASSERT_TRUE(is_intersecting(planes, AABB{{-0.1f, -0.1f, -5.1f}, {0.1f, 0.1f, -4.9f}}));  // in front
+    ASSERT_FALSE(is_intersecting(planes, AABB{{-0.1f, -0.1f, 4.9f}, {0.1f, 0.1f, 5.1f}}));   // behind
+    ASSERT_FALSE(is_intersecting(planes, AABB{{-0.1f, -0.1f, -20.1f}, {0.1f, 0.1f, -19.9f}}));  // beyond the far plane
+    ASSERT_FALSE(is_intersecting(planes, AABB{{5.9f, -0.1f, -5.1f}, {6.1f, 0.1f, -4.9f}}));  // to the right (90 deg FOV)
+}
@@ -0,0 +1,108 @@
+#include <oscar/Maths/MinMaxPyramid.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Maths/Vec2.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::vector<float> generate_series(size_t n)
+    {
+        std::vector<float> rv;
+        rv.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            rv.push_back(std::sin(0.01f * static_cast<float>(i)) + static_cast<float>(i % 7));
+        }
+        return rv;
+    }
+}
+
+TEST(MinMaxPyramid, is_empty_when_default_constructed)
+{
+    const MinMaxPyramid pyramid;
+    ASSERT_TRUE(pyramid.empty());
+    ASSERT_EQ(pyramid.size(), 0);
+
+    std::vector<Vec2> out = {Vec2{1.0f}};
+    pyramid.decimate(10, out);
+    ASSERT_TRUE(out.empty());
+}
+
+TEST(MinMaxPyramid, values_returns_pushed_values)
+{
+    const std::vector<float> series = generate_series(100);
+    MinMaxPyramid pyramid;
+    pyramid.append(series);
+
+    ASSERT_EQ(pyramid.size(), series.size());
+    ASSERT_TRUE(std::ranges::equal(pyramid.values(), series));
+}
+
+TEST(MinMaxPyramid, decimate_writes_every_value_if_there_are_fewer_values_than_buckets)
+{
+    const std::vector<float> series = generate_series(50);
+    MinMaxPyramid pyramid;
+    pyramid.append(series);
+
+    std::vector<Vec2> out;
+    pyramid.decimate(64, out);
+
+    ASSERT_EQ(out.size(), series.size());
+    for (size_t i = 0; i < series.size(); ++i) {
+        ASSERT_EQ(out[i], Vec2(static_cast<float>(i), series[i]));
+    }
+}
+
+TEST(MinMaxPyramid, decimate_writes_at_most_two_points_per_bucket_that_preserve_the_min_and_max_of_each_bucket)
+{
+    // test a variety of sizes, so that partially-filled trailing blocks are also tested
+    for (size_t n : std::to_array<size_t>({2, 3, 100, 1000, 1023, 1024, 1025, 100000})) {
+        const std::vector<float> series = generate_series(n);
+        MinMaxPyramid pyramid;
+        for (float v : series) {
+            pyramid.push_back(v);  // i.e. incrementally
+        }
+
+        for (size_t buckets : std::to_array<size_t>({1, 7, 300})) {
+            if (buckets >= n) {
+                continue;
+            }
+
+            std::vector<Vec2> out;
+            pyramid.decimate(buckets, out);
+            ASSERT_LE(out.size(), 2*buckets) << "n = " << n;
+            ASSERT_EQ(out.size() % 2, 0);
+            ASSERT_EQ(out.front().x, 0.0f);
+            ASSERT_EQ(out.back().x, static_cast<float>(n - 1));
+
+            // each (min, max) point pair should match a brute-force min/max over the bucket
+            for (size_t i = 0; i < out.size(); i += 2) {
+                const auto first = static_cast<size_t>(out[i].x);
+                const auto last = static_cast<size_t>(out[i+1].x);
+                const auto [min, max] = std::minmax_element(series.begin() + static_cast<ptrdiff_t>(first), series.begin() + static_cast<ptrdiff_t>(last) + 1);
+                ASSERT_EQ(out[i].y, *min);
+                ASSERT_EQ(out[i+1].y, *max);
+            }
+        }
+    }
+}
+
+TEST(MinMaxPyramid, clear_removes_all_values)
+{
+    MinMaxPyramid pyramid;
+    pyramid.append(generate_series(100));
+    pyramid.clear();
+    ASSERT_TRUE(pyramid.empty());
+
+    pyramid.push_back(1.0f);
+    std::vector<Vec2> out;
+    pyramid.decimate(1, out);
+    ASSERT_EQ(out, std::vector<Vec2>({Vec2{0.0f, 1.0f}}));
+}
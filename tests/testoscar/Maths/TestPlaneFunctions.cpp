@@ -59,3 +59,25 @@ TEST(is_in_front_of, ProducesExpectedAnswersInExampleCases)
         ASSERT_EQ(is_in_front_of(plane, aabb), expected) << "plane = " << plane << ", aabb = " << aabb << " (dimensions_of = " << dimensions_of(aabb) << ", half_widths . normal = " << dot(half_widths_of(aabb), abs(plane.normal)) << ", signed distance = " << signed_distance_between(plane, centroid_of(aabb)) << ')';
     }
 }
+
+TEST(is_behind, ProducesExpectedAnswersInExampleCases)
+{
+    struct TestCase final {
+        Plane plane;
+        AABB aabb;
+        bool expected;
+    };
+
+    const auto cases = std::to_array<TestCase>({
+          // origin                   // normal                  // min                 // max                  // is behind plane?
+        {{Vec3{},                     Vec3{ 0.0f, 1.0f, 0.0f}}, {{ 1.0f,  1.0f,  1.0f}, { 2.0f,  2.0f,  2.0f}}, false},
+        {{Vec3{},                     Vec3{ 0.0f, 1.0f, 0.0f}}, {{-2.0f, -2.0f, -2.0f}, {-1.0f, -1.0f, -1.0f}}, true},
+        {{Vec3{},                     Vec3{ 0.0f, 1.0f, 0.0f}}, {{-1.0f, -1.0f, -1.0f}, { 1.0f,  1.0f,  1.0f}}, false},  // intersecting
+        {{Vec3{-1.5f, 0.0f, 0.0f},    Vec3{ 1.0f, 0.0f, 0.0f}}, {{-2.0f, -2.0f, -2.0f}, {-1.0f, -1.0f, -1.0f}}, false},  // intersecting
+        {{Vec3{-0.9f, 0.0f, 0.0f},    Vec3{ 1.0f, 0.0f, 0.0f}}, {{-2.0f, -2.0f, -2.0f}, {-1.0f, -1.0f, -1.0f}}, true},
+    });
+
+    for (const auto& [plane, aabb, expected] : cases) {
+        ASSERT_EQ(is_behind(to_analytic_plane(plane), aabb), expected) << "plane = " << plane << ", aabb = " << aabb;
+    }
+}
@@ -0,0 +1,43 @@
+#include <oscar/Platform/MemoryMappedFile.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Utils/TemporaryFile.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+using namespace osc;
+
+TEST(MemoryMappedFile, constructor_throws_if_file_does_not_exist)
+{
+    std::filesystem::path path;
+    {
+        TemporaryFile temporary_file;
+        path = temporary_file.absolute_path();
+    }
+    ASSERT_THROW({ MemoryMappedFile{path}; }, std::runtime_error);
+}
+
+TEST(MemoryMappedFile, bytes_is_empty_when_mapping_an_empty_file)
+{
+    TemporaryFile temporary_file;
+    temporary_file.close();
+    ASSERT_TRUE(MemoryMappedFile{temporary_file.absolute_path()}.bytes().empty());
+}
+
+TEST(MemoryMappedFile, bytes_returns_contents_of_file)
+{
+    TemporaryFile temporary_file;
+    temporary_file.close();
+    {
+        std::ofstream out{temporary_file.absolute_path(), std::ios::binary};
+        out << "hello";
+    }
+
+    const MemoryMappedFile mapped_file{temporary_file.absolute_path()};
+    ASSERT_EQ(mapped_file.size(), 5);
+    ASSERT_EQ(mapped_file.bytes()[0], std::byte{'h'});
+    ASSERT_EQ(mapped_file.bytes()[4], std::byte{'o'});
+}
@@ -0,0 +1,109 @@
+#include <oscar/Utils/SpscRingBuffer.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace osc;
+
+TEST(SpscRingBuffer, throws_if_constructed_with_zero_capacity)
+{
+    ASSERT_THROW({ SpscRingBuffer<int>{0}; }, std::invalid_argument);
+}
+
+TEST(SpscRingBuffer, capacity_returns_capacity_provided_via_constructor)
+{
+    SpscRingBuffer<int> ring{7};
+    ASSERT_EQ(ring.capacity(), 7);
+}
+
+TEST(SpscRingBuffer, is_initially_empty)
+{
+    SpscRingBuffer<int> ring{4};
+    ASSERT_TRUE(ring.empty_approx());
+    ASSERT_EQ(ring.size_approx(), 0);
+    ASSERT_FALSE(ring.try_pop().has_value());
+}
+
+TEST(SpscRingBuffer, try_push_returns_false_when_full)
+{
+    SpscRingBuffer<int> ring{2};
+    ASSERT_TRUE(ring.try_push(1));
+    ASSERT_TRUE(ring.try_push(2));
+    ASSERT_FALSE(ring.try_push(3));
+    ASSERT_EQ(ring.size_approx(), 2);
+}
+
+TEST(SpscRingBuffer, try_push_does_not_move_from_value_when_full)
+{
+    SpscRingBuffer<std::unique_ptr<int>> ring{1};
+    ASSERT_TRUE(ring.try_push(std::make_unique<int>(1)));
+
+    auto value = std::make_unique<int>(2);
+    ASSERT_FALSE(ring.try_push(std::move(value)));
+    ASSERT_NE(value, nullptr);  // NOLINT(bugprone-use-after-move)
+}
+
+TEST(SpscRingBuffer, try_pop_returns_elements_in_fifo_order_across_wraparound)
+{
+    SpscRingBuffer<int> ring{3};
+    int next_pushed = 0;
+    int next_popped = 0;
+    for (int round = 0; round < 10; ++round) {
+        while (ring.try_push(int{next_pushed})) {
+            ++next_pushed;
+        }
+        ASSERT_EQ(ring.try_pop(), next_popped++);
+        ASSERT_EQ(ring.try_pop(), next_popped++);
+    }
+}
+
+TEST(SpscRingBuffer, drain_pops_all_elements_and_returns_how_many_were_popped)
+{
+    SpscRingBuffer<int> ring{8};
+    for (int i = 0; i < 5; ++i) {
+        ring.try_push(int{i});
+    }
+
+    std::vector<int> popped;
+    ASSERT_EQ(ring.drain([&popped](int&& v) { popped.push_back(v); }), 5);
+    ASSERT_EQ(popped, (std::vector<int>{0, 1, 2, 3, 4}));
+    ASSERT_TRUE(ring.empty_approx());
+    ASSERT_EQ(ring.drain([](int&&) {}), 0);
+}
+
+TEST(SpscRingBuffer, transfers_all_elements_in_order_between_two_threads)
+{
+    constexpr int num_elements = 10000;
+    SpscRingBuffer<int> ring{16};
+
+    std::thread producer{[&ring]()
+    {
+        for (int i = 0; i < num_elements; ++i) {
+            while (not ring.try_push(int{i})) {
+                std::this_thread::yield();
+            }
+        }
+    }};
+
+    int expected = 0;
+    bool in_order = true;
+    while (expected < num_elements) {
+        const size_t num_drained = ring.drain([&](int&& v)
+        {
+            in_order = in_order and v == expected;
+            ++expected;
+        });
+        if (num_drained == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    ASSERT_TRUE(in_order);
+    ASSERT_TRUE(ring.empty_approx());
+}
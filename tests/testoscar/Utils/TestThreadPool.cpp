@@ -0,0 +1,172 @@
+#include <oscar/Utils/ThreadPool.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+TEST(ThreadPool, num_workers_returns_the_number_of_workers_the_pool_was_constructed_with)
+{
+    ASSERT_EQ(ThreadPool{3}.num_workers(), 3);
+}
+
+TEST(ThreadPool, for_each_chunk_calls_the_function_with_chunks_that_cover_the_entire_range_exactly_once)
+{
+    ThreadPool pool{4};
+    std::vector<std::atomic<int>> num_visits(10007);
+
+    pool.for_each_chunk(num_visits.size(), 64, [&num_visits](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i) {
+            ++num_visits[i];
+        }
+    });
+
+    for (const std::atomic<int>& n : num_visits) {
+        ASSERT_EQ(n, 1);
+    }
+}
+
+TEST(ThreadPool, for_each_chunk_respects_the_minimum_chunk_size)
+{
+    ThreadPool pool{4};
+    std::mutex mutex;
+    std::vector<std::pair<size_t, size_t>> chunks;
+
+    pool.for_each_chunk(1000, 300, [&](size_t first, size_t last)
+    {
+        const std::lock_guard lock{mutex};
+        chunks.emplace_back(first, last);
+    });
+
+    ASSERT_FALSE(chunks.empty());
+    for (const auto& [first, last] : chunks) {
+        ASSERT_GE(last - first, 300);
+    }
+}
+
+TEST(ThreadPool, for_each_chunk_only_calls_the_function_with_nonempty_in_bounds_chunks)
+{
+    ThreadPool pool{4};
+
+    // e.g. `n = 29`, `min_chunk_size = 4` yields 7 chunks, which can't all be 5 elements long
+    for (const auto& [n, min_chunk_size] : {std::pair<size_t, size_t>{29, 4}, {10, 3}, {21, 1}, {1001, 50}}) {
+        std::mutex mutex;
+        std::vector<std::pair<size_t, size_t>> chunks;
+
+        pool.for_each_chunk(n, min_chunk_size, [&](size_t first, size_t last)
+        {
+            const std::lock_guard lock{mutex};
+            chunks.emplace_back(first, last);
+        });
+
+        size_t total = 0;
+        for (const auto& [first, last] : chunks) {
+            ASSERT_LT(first, last) << "n = " << n << ", min_chunk_size = " << min_chunk_size;
+            ASSERT_LE(last, n) << "n = " << n << ", min_chunk_size = " << min_chunk_size;
+            ASSERT_GE(last - first, min_chunk_size) << "n = " << n << ", min_chunk_size = " << min_chunk_size;
+            total += last - first;
+        }
+        ASSERT_EQ(total, n);
+    }
+}
+
+TEST(ThreadPool, for_each_chunk_does_nothing_if_given_an_empty_range)
+{
+    ThreadPool pool{2};
+    bool called = false;
+    pool.for_each_chunk(0, 1, [&called](size_t, size_t) { called = true; });
+    ASSERT_FALSE(called);
+}
+
+TEST(ThreadPool, for_each_chunk_works_with_no_workers)
+{
+    ThreadPool pool{0};
+    std::atomic<size_t> total = 0;
+    pool.for_each_chunk(1000, 1, [&total](size_t first, size_t last) { total += last - first; });
+    ASSERT_EQ(total, 1000);
+}
+
+TEST(ThreadPool, for_each_chunk_can_be_called_from_within_a_chunk)
+{
+    ThreadPool pool{2};
+    std::atomic<size_t> total = 0;
+
+    pool.for_each_chunk(8, 1, [&pool, &total](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i) {
+            pool.for_each_chunk(100, 1, [&total](size_t inner_first, size_t inner_last) { total += inner_last - inner_first; });
+        }
+    });
+
+    ASSERT_EQ(total, 800);
+}
+
+TEST(ThreadPool, for_each_chunk_rethrows_exceptions_thrown_by_the_function)
+{
+    ThreadPool pool{4};
+    const auto f = [](size_t first, size_t)
+    {
+        if (first == 0) {
+            throw std::runtime_error{"from the first chunk"};
+        }
+    };
+    ASSERT_THROW({ pool.for_each_chunk(1000, 1, f); }, std::runtime_error);
+}
+
+TEST(ThreadPool, submit_eventually_runs_the_job_on_a_worker)
+{
+    ThreadPool pool{2};
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool ran = false;
+    pool.submit([&]()
+    {
+        {
+            const std::scoped_lock lock{mutex};
+            ran = true;
+        }
+        cv.notify_all();
+    });
+
+    std::unique_lock lock{mutex};
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds{10}, [&]{ return ran; }));
+}
+
+TEST(ThreadPool, submit_runs_the_job_inline_if_the_pool_has_no_workers)
+{
+    ThreadPool pool{0};
+    bool ran = false;
+    pool.submit([&ran]() { ran = true; });
+    ASSERT_TRUE(ran);
+}
+
+TEST(ThreadPool, submit_ignores_exceptions_thrown_by_the_job)
+{
+    ThreadPool pool{1};
+    pool.submit([]() { throw std::runtime_error{"from a submitted job"}; });
+
+    // the (only) worker should still be alive and able to run subsequent work
+    int count = 0;
+    std::mutex mutex;
+    std::condition_variable cv;
+    pool.submit([&]()
+    {
+        {
+            const std::scoped_lock lock{mutex};
+            ++count;
+        }
+        cv.notify_all();
+    });
+
+    std::unique_lock lock{mutex};
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds{10}, [&]{ return count == 1; }));
+}
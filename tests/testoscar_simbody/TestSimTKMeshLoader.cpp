@@ -0,0 +1,48 @@
+#include <oscar_simbody/SimTKMeshLoader.h>
+
+#include <testoscar_simbody/testoscar_simbody_config.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/CommonFunctions.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::vector<Vec3> indexed_vertices_of(const Mesh& mesh)
+    {
+        std::vector<Vec3> rv;
+        mesh.for_each_indexed_vertex([&rv](Vec3 v) { rv.push_back(v); });
+        return rv;
+    }
+}
+
+TEST(LoadMeshFile, ReturnsTheSameTrianglesAsLoadMeshViaSimTKForBundledIndexedMeshFiles)
+{
+    for (const std::string_view filename : {"hat_ribs.vtp", "blockMesh.obj", "soccer_ball.obj"}) {
+        const auto path = std::filesystem::path{OSC_RESOURCES_DIR} / "geometry" / filename;
+
+        const std::vector<Vec3> expected = indexed_vertices_of(LoadMeshViaSimTK(path));
+        const std::vector<Vec3> actual = indexed_vertices_of(LoadMeshFile(path));
+
+        ASSERT_EQ(actual.size(), expected.size()) << filename;
+        for (size_t i = 0; i < actual.size(); ++i) {
+            ASSERT_TRUE(all_of(equal_within_reldiff(actual[i], expected[i], 1e-6f))) << filename << ": vertex " << i;
+        }
+    }
+}
+
+TEST(LoadMeshFile, ReturnsTheSameNumberOfTrianglesAsLoadMeshViaSimTKForBundledSTLFiles)
+{
+    for (const std::string_view filename : {"ellipsoid.stl", "afoCuff.STL"}) {
+        const auto path = std::filesystem::path{OSC_RESOURCES_DIR} / "geometry" / filename;
+        ASSERT_EQ(LoadMeshFile(path).num_indices(), LoadMeshViaSimTK(path).num_indices()) << filename;
+    }
+}
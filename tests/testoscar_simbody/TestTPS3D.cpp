@@ -0,0 +1,421 @@
+#include <oscar_simbody/TPS3D.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/EnumHelpers.h>
+#include <oscar_simbody/LandmarkPair3D.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::vector<Vec3> GenerateRandomPoints(std::default_random_engine& rng, size_t n)
+    {
+        std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+        std::vector<Vec3> rv;
+        rv.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            rv.emplace_back(dist(rng), dist(rng), dist(rng));
+        }
+        return rv;
+    }
+
+
+    void AssertNear(const Vec3& a, const Vec3& b, float tolerance)
+    {
+        ASSERT_NEAR(a.x, b.x, tolerance) << a << " != " << b;
+        ASSERT_NEAR(a.y, b.y, tolerance) << a << " != " << b;
+        ASSERT_NEAR(a.z, b.z, tolerance) << a << " != " << b;
+    }
+
+    void AssertNear(const TPSCoefficients3D& a, const TPSCoefficients3D& b, float tolerance)
+    {
+        AssertNear(a.a1, b.a1, tolerance);
+        AssertNear(a.a2, b.a2, tolerance);
+        AssertNear(a.a3, b.a3, tolerance);
+        AssertNear(a.a4, b.a4, tolerance);
+        ASSERT_EQ(a.nonAffineTerms.size(), b.nonAffineTerms.size());
+        for (size_t i = 0; i < a.nonAffineTerms.size(); ++i) {
+            ASSERT_EQ(a.nonAffineTerms[i].controlPoint, b.nonAffineTerms[i].controlPoint);
+            AssertNear(a.nonAffineTerms[i].weight, b.nonAffineTerms[i].weight, tolerance);
+        }
+    }
+
+    TPSCoefficientSolverInputs3D GenerateRandomInputs(std::default_random_engine& rng, size_t numLandmarks)
+    {
+        std::normal_distribution<float> noise{0.0f, 0.05f};
+        TPSCoefficientSolverInputs3D rv;
+        for (const Vec3& source : GenerateRandomPoints(rng, numLandmarks)) {
+            rv.landmarks.push_back({source, 1.5f*source + Vec3{noise(rng), noise(rng), noise(rng)}});
+        }
+        return rv;
+    }
+
+    // returns coefficients for a random (but smooth) warp of the given number of landmarks
+    TPSCoefficients3D GenerateRandomCoefficients(std::default_random_engine& rng, size_t numLandmarks)
+    {
+        return CalcCoefficients(GenerateRandomInputs(rng, numLandmarks));
+    }
+
+    constexpr auto c_NonGeneralSolverStrategies = std::to_array({
+        TPSCoefficientSolverStrategy::Automatic,
+        TPSCoefficientSolverStrategy::Symmetric,
+        TPSCoefficientSolverStrategy::Iterative,
+    });
+}
+
+TEST(CalcCoefficients, ReturnsIdentityCoefficientsWhenGivenNoLandmarks)
+{
+    for (size_t i = 0; i < num_options<TPSCoefficientSolverStrategy>(); ++i) {
+        const auto strategy = static_cast<TPSCoefficientSolverStrategy>(i);
+        ASSERT_EQ(CalcCoefficients({}, {.strategy = strategy}), TPSCoefficients3D{});
+    }
+}
+
+TEST(CalcCoefficients, EachStrategyProducesCoefficientsThatWarpSourcesOntoDestinations)
+{
+    std::default_random_engine rng{7};
+    const TPSCoefficientSolverInputs3D inputs = GenerateRandomInputs(rng, 100);
+
+    for (size_t i = 0; i < num_options<TPSCoefficientSolverStrategy>(); ++i) {
+        const TPSCoefficients3D coefs = CalcCoefficients(inputs, {.strategy = static_cast<TPSCoefficientSolverStrategy>(i)});
+        for (const LandmarkPair3D& landmark : inputs.landmarks) {
+            AssertNear(EvaluateTPSEquation(coefs, landmark.source), landmark.destination, 1e-4f);
+        }
+    }
+}
+
+TEST(CalcCoefficients, EachStrategyProducesTheSameCoefficientsAsTheGeneralStrategy)
+{
+    std::default_random_engine rng{8};
+    for (const size_t numLandmarks : std::to_array<size_t>({4, 5, 37, 250})) {
+        const TPSCoefficientSolverInputs3D inputs = GenerateRandomInputs(rng, numLandmarks);
+        const TPSCoefficients3D expected = CalcCoefficients(inputs, {.strategy = TPSCoefficientSolverStrategy::General});
+        for (const TPSCoefficientSolverStrategy strategy : c_NonGeneralSolverStrategies) {
+            AssertNear(CalcCoefficients(inputs, {.strategy = strategy}), expected, 1e-3f);
+        }
+    }
+}
+
+TEST(CalcCoefficients, AutomaticStrategyProducesTheSameCoefficientsAsTheIterativeStrategyAboveTheThreshold)
+{
+    std::default_random_engine rng{9};
+    const TPSCoefficientSolverInputs3D inputs = GenerateRandomInputs(rng, 50);
+
+    const TPSCoefficients3D iterative = CalcCoefficients(inputs, {.strategy = TPSCoefficientSolverStrategy::Iterative});
+    const TPSCoefficients3D automatic = CalcCoefficients(inputs, {.strategy = TPSCoefficientSolverStrategy::Automatic, .maxLandmarksForSymmetricSolver = 10});
+    ASSERT_EQ(automatic, iterative);
+}
+
+TEST(CalcCoefficients, IterativeStrategyFallsBackToTheSymmetricStrategyIfItDoesNotConverge)
+{
+    std::default_random_engine rng{11};
+    const TPSCoefficientSolverInputs3D inputs = GenerateRandomInputs(rng, 200);
+
+    const TPSCoefficients3D symmetric = CalcCoefficients(inputs, {.strategy = TPSCoefficientSolverStrategy::Symmetric});
+    const TPSCoefficientSolverOptions3D options = {
+        .strategy = TPSCoefficientSolverStrategy::Iterative,
+        .maxLandmarksForSymmetricSolver = 200,
+        .iterativeSolverTolerance = 1e-12,
+        .iterativeSolverMaxIterations = 2,  // i.e. can't converge
+    };
+    ASSERT_EQ(CalcCoefficients(inputs, options), symmetric);
+}
+
+TEST(CalcCoefficients, IterativeStrategyDoesNotFallBackToTheSymmetricStrategyAboveTheThreshold)
+{
+    std::default_random_engine rng{11};
+    const TPSCoefficientSolverInputs3D inputs = GenerateRandomInputs(rng, 200);
+
+    const TPSCoefficients3D symmetric = CalcCoefficients(inputs, {.strategy = TPSCoefficientSolverStrategy::Symmetric});
+    for (const TPSCoefficientSolverStrategy strategy : {TPSCoefficientSolverStrategy::Iterative, TPSCoefficientSolverStrategy::Automatic}) {
+        const TPSCoefficientSolverOptions3D options = {
+            .strategy = strategy,
+            .maxLandmarksForSymmetricSolver = 10,
+            .iterativeSolverTolerance = 1e-12,
+            .iterativeSolverMaxIterations = 2,  // i.e. can't converge
+        };
+        const TPSCoefficients3D approximate = CalcCoefficients(inputs, options);
+        ASSERT_NE(approximate, symmetric) << "should've used the (unconverged) iterative solution";
+        ASSERT_EQ(approximate.nonAffineTerms.size(), inputs.landmarks.size());
+    }
+}
+
+TEST(CalcCoefficients, IterativeStrategyConvergesForThousandsOfLandmarksWithoutFallingBack)
+{
+    // (see `BenchOpenSimCreator`'s `TPS/Solve/*Landmarks/Iterative` for larger inputs)
+    std::default_random_engine rng{12};
+    const TPSCoefficientSolverInputs3D inputs = GenerateRandomInputs(rng, 1000);
+
+    const TPSCoefficientSolverOptions3D options = {
+        .strategy = TPSCoefficientSolverStrategy::Iterative,
+        .maxLandmarksForSymmetricSolver = 0,  // i.e. can't fall back
+    };
+    const TPSCoefficients3D coefs = CalcCoefficients(inputs, options);
+    for (const LandmarkPair3D& landmark : inputs.landmarks) {
+        AssertNear(EvaluateTPSEquation(coefs, landmark.source), landmark.destination, 1e-4f);
+    }
+}
+
+TEST(CalcCoefficients, EachStrategyFallsBackToTheGeneralStrategyForDegenerateLandmarks)
+{
+    // coplanar (the affine part is underdetermined) and duplicate (the kernel matrix is singular) landmarks
+    TPSCoefficientSolverInputs3D coplanar;
+    for (const Vec3& source : {Vec3{0.0f, 0.0f, 0.0f}, Vec3{1.0f, 0.0f, 0.0f}, Vec3{0.0f, 1.0f, 0.0f}, Vec3{1.0f, 1.0f, 0.0f}, Vec3{0.5f, 0.25f, 0.0f}}) {
+        coplanar.landmarks.push_back({source, 2.0f*source});
+    }
+    std::default_random_engine rng{10};
+    TPSCoefficientSolverInputs3D duplicated = GenerateRandomInputs(rng, 10);
+    duplicated.landmarks.push_back(duplicated.landmarks.front());
+
+    for (const TPSCoefficientSolverInputs3D& inputs : {coplanar, duplicated}) {
+        const TPSCoefficients3D expected = CalcCoefficients(inputs, {.strategy = TPSCoefficientSolverStrategy::General});
+        for (const TPSCoefficientSolverStrategy strategy : c_NonGeneralSolverStrategies) {
+            ASSERT_EQ(CalcCoefficients(inputs, {.strategy = strategy}), expected);
+        }
+    }
+}
+
+TEST(CalcCoefficients, EachStrategyHandlesFewerThanFourLandmarks)
+{
+    const TPSCoefficientSolverInputs3D inputs{{
+        {.source = {0.0f, 0.0f, 0.0f}, .destination = {1.0f, 0.0f, 0.0f}},
+        {.source = {1.0f, 0.0f, 0.0f}, .destination = {2.0f, 0.0f, 0.0f}},
+    }};
+    const TPSCoefficients3D expected = CalcCoefficients(inputs, {.strategy = TPSCoefficientSolverStrategy::General});
+    for (const TPSCoefficientSolverStrategy strategy : c_NonGeneralSolverStrategies) {
+        ASSERT_EQ(CalcCoefficients(inputs, {.strategy = strategy}), expected);
+    }
+}
+
+TEST(TPSCoefficientsSoA3D, DefaultConstructedIsEquivalentToDefaultConstructedTPSCoefficients3D)
+{
+    ASSERT_EQ(TPSCoefficientsSoA3D{}, TPSCoefficientsSoA3D{TPSCoefficients3D{}});
+}
+
+TEST(TPSCoefficientsSoA3D, ConstructorCopiesEachComponentOfEachNonAffineTermInOrder)
+{
+    TPSCoefficients3D coefs;
+    coefs.a1 = {1.0f, 2.0f, 3.0f};
+    coefs.nonAffineTerms.emplace_back(Vec3{1.0f, 2.0f, 3.0f}, Vec3{4.0f, 5.0f, 6.0f});
+    coefs.nonAffineTerms.emplace_back(Vec3{7.0f, 8.0f, 9.0f}, Vec3{10.0f, 11.0f, 12.0f});
+
+    const TPSCoefficientsSoA3D soa{coefs};
+
+    ASSERT_EQ(soa.a1, coefs.a1);
+    ASSERT_EQ(soa.a2, coefs.a2);
+    ASSERT_EQ(soa.a3, coefs.a3);
+    ASSERT_EQ(soa.a4, coefs.a4);
+    ASSERT_EQ(soa.getNumNonAffineTerms(), 2);
+    ASSERT_EQ(soa.weightsX, std::vector<float>({1.0f, 7.0f}));
+    ASSERT_EQ(soa.weightsY, std::vector<float>({2.0f, 8.0f}));
+    ASSERT_EQ(soa.weightsZ, std::vector<float>({3.0f, 9.0f}));
+    ASSERT_EQ(soa.controlPointsX, std::vector<float>({4.0f, 10.0f}));
+    ASSERT_EQ(soa.controlPointsY, std::vector<float>({5.0f, 11.0f}));
+    ASSERT_EQ(soa.controlPointsZ, std::vector<float>({6.0f, 12.0f}));
+}
+
+TEST(EvaluateTPSEquation, MultiPointOverloadProducesSameResultsAsSinglePointOverload)
+{
+    std::default_random_engine rng{1};
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 37);
+    const std::vector<Vec3> points = GenerateRandomPoints(rng, 1001);  // (not a multiple of the lane count)
+
+    std::vector<Vec3> results(points.size());
+    EvaluateTPSEquation(TPSCoefficientsSoA3D{coefs}, points, results);
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        AssertNear(results[i], EvaluateTPSEquation(coefs, points[i]), 1e-5f);
+    }
+}
+
+TEST(EvaluateTPSEquation, MultiPointOverloadCanEvaluatePointsInPlace)
+{
+    std::default_random_engine rng{2};
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 12);
+    const std::vector<Vec3> points = GenerateRandomPoints(rng, 77);
+
+    std::vector<Vec3> results = points;
+    EvaluateTPSEquation(TPSCoefficientsSoA3D{coefs}, results, results);
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        AssertNear(results[i], EvaluateTPSEquation(coefs, points[i]), 1e-5f);
+    }
+}
+
+TEST(EvaluateTPSEquation, MultiPointOverloadWithDefaultCoefficientsReturnsInputPoints)
+{
+    std::default_random_engine rng{3};
+    const std::vector<Vec3> points = GenerateRandomPoints(rng, 20);
+
+    std::vector<Vec3> results(points.size());
+    EvaluateTPSEquation(TPSCoefficientsSoA3D{}, points, results);
+
+    ASSERT_EQ(results, points);
+}
+
+TEST(ApplyThinPlateWarpToPointsInPlace, ProducesSameResultsAsEvaluatingEachPoint)
+{
+    std::default_random_engine rng{4};
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 50);
+    const std::vector<Vec3> points = GenerateRandomPoints(rng, 20000);  // (enough to be multithreaded)
+
+    std::vector<Vec3> results = points;
+    ApplyThinPlateWarpToPointsInPlace(coefs, results, 1.0f);
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        AssertNear(results[i], EvaluateTPSEquation(coefs, points[i]), 1e-5f);
+    }
+}
+
+TEST(ApplyThinPlateWarpToPointsInPlace, LeavesPointsUnchangedIfBlendingFactorIsZero)
+{
+    std::default_random_engine rng{5};
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 10);
+    const std::vector<Vec3> points = GenerateRandomPoints(rng, 1000);
+
+    std::vector<Vec3> results = points;
+    ApplyThinPlateWarpToPointsInPlace(coefs, results, 0.0f);
+
+    ASSERT_EQ(results, points);
+}
+
+TEST(ApplyThinPlateWarpToPointsInPlace, WarpsLandmarkSourcesOntoTheirDestinations)
+{
+    std::default_random_engine rng{6};
+    TPSCoefficientSolverInputs3D inputs;
+    for (const Vec3& source : GenerateRandomPoints(rng, 25)) {
+        inputs.landmarks.push_back({source, source + Vec3{0.1f, -0.2f, 0.05f}*source.x});
+    }
+
+    std::vector<Vec3> points;
+    for (const LandmarkPair3D& landmark : inputs.landmarks) {
+        points.push_back(landmark.source);
+    }
+    ApplyThinPlateWarpToPointsInPlace(CalcCoefficients(inputs), points, 1.0f);
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        AssertNear(points[i], inputs.landmarks[i].destination, 1e-4f);
+    }
+}
+
+TEST(ApplyThinPlateWarpToPointsInPlace, SoAOverloadProducesSameResultsAsNonSoAOverload)
+{
+    std::default_random_engine rng{13};
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 40);
+    const std::vector<Vec3> points = GenerateRandomPoints(rng, 3000);
+
+    std::vector<Vec3> expected = points;
+    ApplyThinPlateWarpToPointsInPlace(coefs, expected, 0.5f);
+
+    std::vector<Vec3> results = points;
+    ApplyThinPlateWarpToPointsInPlace(TPSCoefficientsSoA3D{coefs}, results, 0.5f);
+
+    ASSERT_EQ(results, expected);
+}
+
+TEST(TPSApproximateEvaluator3D, ProducesSameResultsAsEvaluateTPSEquationWhenMaxAbsoluteErrorIsZero)
+{
+    std::default_random_engine rng{7};
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 300);
+    const TPSApproximateEvaluator3D evaluator{coefs, {.maxAbsoluteError = 0.0, .maxControlPointsPerLeaf = 4}};
+
+    for (const Vec3& point : GenerateRandomPoints(rng, 500)) {
+        AssertNear(evaluator.evaluate(point), EvaluateTPSEquation(coefs, point), 1e-5f);
+    }
+}
+
+TEST(TPSApproximateEvaluator3D, ErrorIsWithinMaxAbsoluteErrorAndDecreasesAsItIsTightened)
+{
+    std::default_random_engine rng{8};
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 1000);
+    std::vector<Vec3> points = GenerateRandomPoints(rng, 2000);
+    for (size_t i = 0; i < points.size(); i += 2) {
+        points[i] *= 3.0f;  // (also evaluate points that are outside of the landmarks' bounds)
+    }
+
+    double previousMaxError = std::numeric_limits<double>::infinity();
+    for (const double maxAbsoluteError : {1e-1, 1e-2, 1e-3, 1e-4}) {
+        const TPSApproximateEvaluator3D evaluator{coefs, {.maxAbsoluteError = maxAbsoluteError}};
+
+        std::vector<Vec3> results(points.size());
+        evaluator.evaluate(points, results);
+
+        double maxError = 0.0;
+        for (size_t i = 0; i < points.size(); ++i) {
+            const Vec3 expected = EvaluateTPSEquation(coefs, points[i]);
+            for (size_t dim = 0; dim < 3; ++dim) {
+                maxError = std::max(maxError, static_cast<double>(std::abs(results[i][dim] - expected[dim])));
+            }
+        }
+        ASSERT_LE(maxError, maxAbsoluteError + 1e-5);  // (+ `float` rounding)
+        ASSERT_LE(maxError, previousMaxError);
+        previousMaxError = maxError;
+    }
+}
+
+TEST(TPSApproximateEvaluator3D, ErrorIsWithinMaxAbsoluteErrorForPointsThatAreFarAwayFromTheControlPoints)
+{
+    std::default_random_engine rng{12};
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 500);
+    const TPSApproximateEvaluator3D evaluator{coefs, {.maxAbsoluteError = 1e-3}};
+
+    // (far-away points are evaluated almost entirely from the far-field expansions)
+    for (const Vec3& point : GenerateRandomPoints(rng, 200)) {
+        const Vec3 farAwayPoint = 50.0f * point;
+        AssertNear(evaluator.evaluate(farAwayPoint), EvaluateTPSEquation(coefs, farAwayPoint), 1e-3f + 1e-4f);
+    }
+}
+
+TEST(TPSApproximateEvaluator3D, ProducesSameResultsAsEvaluateTPSEquationForAffineOnlyCoefficients)
+{
+    std::default_random_engine rng{9};
+    TPSCoefficients3D coefs;
+    coefs.a1 = {1.0f, 2.0f, 3.0f};
+    coefs.a2 = {0.5f, 0.0f, 0.25f};
+    const TPSApproximateEvaluator3D evaluator{coefs};
+
+    for (const Vec3& point : GenerateRandomPoints(rng, 20)) {
+        ASSERT_EQ(evaluator.evaluate(point), EvaluateTPSEquation(coefs, point));
+    }
+}
+
+TEST(TPSApproximateEvaluator3D, HandlesCoincidentControlPoints)
+{
+    std::default_random_engine rng{10};
+    TPSCoefficients3D coefs;
+    for (size_t i = 0; i < 100; ++i) {
+        coefs.nonAffineTerms.emplace_back(Vec3{0.5f, -0.25f, 1.0f}, Vec3{0.1f*static_cast<float>(i % 2)});  // (two clusters of identical points)
+    }
+    const TPSApproximateEvaluator3D evaluator{coefs, {.maxAbsoluteError = 0.0, .maxControlPointsPerLeaf = 1}};
+
+    for (const Vec3& point : GenerateRandomPoints(rng, 100)) {
+        AssertNear(evaluator.evaluate(point), EvaluateTPSEquation(coefs, point), 1e-4f);
+    }
+}
+
+TEST(ApplyThinPlateWarpToPointsInPlace, ApproximateOverloadProducesSameResultsAsEvaluator)
+{
+    std::default_random_engine rng{11};
+    const TPSApproximateEvaluator3D evaluator{GenerateRandomCoefficients(rng, 200), {.maxAbsoluteError = 1e-3}};
+    const std::vector<Vec3> points = GenerateRandomPoints(rng, 5000);
+
+    std::vector<Vec3> results = points;
+    ApplyThinPlateWarpToPointsInPlace(evaluator, results, 1.0f);
+    for (size_t i = 0; i < points.size(); ++i) {
+        ASSERT_EQ(results[i], evaluator.evaluate(points[i]));
+    }
+
+    results = points;
+    ApplyThinPlateWarpToPointsInPlace(evaluator, results, 0.0f);
+    ASSERT_EQ(results, points);
+}